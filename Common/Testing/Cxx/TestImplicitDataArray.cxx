@@ -0,0 +1,255 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the backends of vtkImplicitDoubleArray, that copying from it does
+// not materialize it, and that writing to it does.
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImplicitDoubleArray.h"
+#include "vtkImplicitFloatArray.h"
+#include "vtkMultiThreader.h"
+
+#define NUM_TUPLES 1000
+#define NUM_THREADS 4
+
+struct vtkTestImplicitMaterialize
+{
+  vtkImplicitDoubleArray *Array;
+  void *Pointers[NUM_THREADS];
+};
+
+static VTK_THREAD_RETURN_TYPE MaterializeThread(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkTestImplicitMaterialize *data =
+    static_cast<vtkTestImplicitMaterialize *>(info->UserData);
+  data->Pointers[info->ThreadID] = data->Array->GetVoidPointer(0);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+static int CheckValues(vtkDataArray *a, vtkDataArray *b, const char *what)
+{
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    cerr << what << ": sizes differ\n";
+    return 1;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    for (int j = 0; j < a->GetNumberOfComponents(); j++)
+      {
+      if (a->GetComponent(i, j) != b->GetComponent(i, j))
+        {
+        cerr << what << ": tuple " << i << " component " << j << " is "
+             << a->GetComponent(i, j) << " instead of "
+             << b->GetComponent(i, j) << "\n";
+        return 1;
+        }
+      }
+    }
+  return 0;
+}
+
+static int CheckImplicit(vtkDataArray *a, const char *what)
+{
+  if (a->HasStandardMemoryLayout() || a->GetActualMemorySize() != 0)
+    {
+    cerr << what << ": the array was materialized\n";
+    return 1;
+    }
+  return 0;
+}
+
+int TestImplicitDataArray(int,char *[])
+{
+  int errors = 0;
+  vtkIdType i;
+
+  // Constant backend.
+  vtkImplicitDoubleArray *constant = vtkImplicitDoubleArray::New();
+  constant->SetNumberOfComponents(3);
+  constant->SetConstantValue(2.5, NUM_TUPLES);
+  vtkDoubleArray *ref = vtkDoubleArray::New();
+  ref->SetNumberOfComponents(3);
+  for (i = 0; i < NUM_TUPLES; i++)
+    {
+    ref->InsertNextTuple3(2.5, 2.5, 2.5);
+    }
+  errors += CheckValues(constant, ref, "Constant");
+  double range[2];
+  constant->GetRange(range, 1);
+  if (range[0] != 2.5 || range[1] != 2.5)
+    {
+    cerr << "Wrong constant range\n";
+    errors++;
+    }
+
+  // Affine backend: coordinates of a uniform axis.
+  vtkImplicitFloatArray *axis = vtkImplicitFloatArray::New();
+  axis->SetAffineValues(0.5, -1.0, NUM_TUPLES);
+  if (axis->GetValue(10) != 4.0f || axis->GetNumberOfTuples() != NUM_TUPLES)
+    {
+    cerr << "Wrong affine value " << axis->GetValue(10) << "\n";
+    errors++;
+    }
+
+  // Affine transform of another array.
+  vtkImplicitDoubleArray *scaled = vtkImplicitDoubleArray::New();
+  scaled->SetAffineTransform(constant, 2.0, 1.0);
+  if (scaled->GetNumberOfComponents() != 3 ||
+      scaled->GetComponent(NUM_TUPLES-1, 2) != 6.0)
+    {
+    cerr << "Wrong affine transform\n";
+    errors++;
+    }
+
+  // Indexed view of the axis, every other value backwards.
+  vtkIdTypeArray *indices = vtkIdTypeArray::New();
+  for (i = NUM_TUPLES-1; i >= 0; i -= 2)
+    {
+    indices->InsertNextValue(i);
+    }
+  vtkImplicitDoubleArray *view = vtkImplicitDoubleArray::New();
+  view->SetIndexedView(axis, indices);
+  if (view->GetNumberOfTuples() != NUM_TUPLES/2 ||
+      view->GetComponent(1, 0) != axis->GetComponent(NUM_TUPLES-3, 0))
+    {
+    cerr << "Wrong indexed view\n";
+    errors++;
+    }
+
+  // Copying tuples from implicit arrays does not materialize them.
+  vtkDoubleArray *copy = vtkDoubleArray::New();
+  copy->SetNumberOfComponents(3);
+  vtkIdList *ids = vtkIdList::New();
+  ids->InsertNextId(7);
+  ids->InsertNextId(3);
+  double weights[2] = {0.5, 0.5};
+  for (i = 0; i < NUM_TUPLES; i++)
+    {
+    copy->InsertTuple(i, i, scaled);
+    }
+  copy->InterpolateTuple(0, ids, scaled, weights);
+  copy->InterpolateTuple(1, 7, scaled, 3, scaled, 0.25);
+  scaled->GetTuples(ids, ref);
+  if (copy->GetComponent(0, 0) != 6.0 || copy->GetComponent(1, 1) != 6.0 ||
+      copy->GetComponent(NUM_TUPLES-1, 2) != 6.0 ||
+      ref->GetComponent(1, 0) != 6.0)
+    {
+    cerr << "Wrong copies of implicit tuples\n";
+    errors++;
+    }
+  vtkDoubleArray *deep = vtkDoubleArray::New();
+  deep->DeepCopy(view);
+  errors += CheckValues(deep, view, "DeepCopy");
+  errors += CheckImplicit(constant, "Constant");
+  errors += CheckImplicit(axis, "Affine");
+  errors += CheckImplicit(scaled, "Affine transform");
+  errors += CheckImplicit(view, "Indexed view");
+
+  // Iterating does not materialize the array either.
+  vtkArrayIteratorTemplate<float> *iter =
+    static_cast<vtkArrayIteratorTemplate<float> *>(axis->NewIterator());
+  if (iter->GetNumberOfValues() != NUM_TUPLES ||
+      iter->GetValue(10) != 4.0f || iter->GetTuple(11)[0] != 4.5f)
+    {
+    cerr << "Wrong iterator values\n";
+    errors++;
+    }
+  iter->Delete();
+  errors += CheckImplicit(axis, "Iterator");
+
+  // An empty array has no backend and no storage.
+  vtkImplicitDoubleArray *empty = vtkImplicitDoubleArray::New();
+  double emptyTuple[1] = {1.0};
+  empty->GetTuple(0, emptyTuple);
+  if (empty->GetValue(0) != 0.0 || emptyTuple[0] != 1.0)
+    {
+    cerr << "Wrong values of an empty array\n";
+    errors++;
+    }
+  empty->Delete();
+
+  // Threads asking for the pointer at the same time share one copy.
+  vtkTestImplicitMaterialize materialize;
+  materialize.Array = vtkImplicitDoubleArray::New();
+  materialize.Array->SetAffineTransform(constant, 2.0, 1.0);
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(NUM_THREADS);
+  threader->SetSingleMethod(MaterializeThread, &materialize);
+  threader->SingleMethodExecute();
+  for (i = 1; i < NUM_THREADS; i++)
+    {
+    if (materialize.Pointers[i] != materialize.Pointers[0])
+      {
+      cerr << "Concurrent materializations returned different pointers\n";
+      errors++;
+      break;
+      }
+    }
+  errors += CheckValues(materialize.Array, scaled, "Concurrent materialize");
+  threader->Delete();
+  materialize.Array->Delete();
+
+  // Writing materializes the array and keeps the values.
+  view->SetComponent(0, 0, -5.0);
+  if (!view->HasStandardMemoryLayout() || view->GetValue(0) != -5.0 ||
+      view->GetValue(1) != axis->GetValue(NUM_TUPLES-3))
+    {
+    cerr << "Materialization failed\n";
+    errors++;
+    }
+  view->InsertNextTuple1(12.0);
+  double *values = static_cast<double *>(view->GetVoidPointer(0));
+  if (view->GetNumberOfTuples() != NUM_TUPLES/2 + 1 ||
+      values[NUM_TUPLES/2] != 12.0)
+    {
+    cerr << "Insertion after materialization failed\n";
+    errors++;
+    }
+
+  // An instance of an implicit array, as made by CopyAllocate(), can be
+  // filled like an ordinary array.
+  vtkDataArray *output = constant->NewInstance();
+  output->SetNumberOfComponents(3);
+  output->Allocate(30);
+  for (i = 0; i < 10; i++)
+    {
+    output->InsertNextTuple(i, constant);
+    }
+  if (output->GetNumberOfTuples() != 10 || output->GetComponent(9, 2) != 2.5)
+    {
+    cerr << "Filling a new instance failed\n";
+    errors++;
+    }
+
+  output->Delete();
+  deep->Delete();
+  ids->Delete();
+  copy->Delete();
+  view->Delete();
+  indices->Delete();
+  scaled->Delete();
+  axis->Delete();
+  ref->Delete();
+  constant->Delete();
+
+  return errors;
+}
@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Advance particles with the batched ComputeNextSteps() of the Runge-Kutta
+// solvers, with and without a batched function set, and compare with
+// ComputeNextStep() called for each particle.
+
+#include "vtkFunctionSet.h"
+#include "vtkInitialValueProblemSolver.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkRungeKutta2.h"
+#include "vtkRungeKutta4.h"
+#include "vtkRungeKutta45.h"
+#include "vtkSmartPointer.h"
+
+#include <vtkstd/vector>
+
+#include <math.h>
+
+// A swirl in the unit disk of the xy plane, with an upward drift that
+// grows with time. Outside of the disk, the field is not defined.
+class vtkTestSwirl : public vtkFunctionSet
+{
+public:
+  static vtkTestSwirl *New();
+  vtkTypeRevisionMacro(vtkTestSwirl,vtkFunctionSet);
+
+  virtual int FunctionValues(double* x, double* f)
+    {
+    if (x[0]*x[0] + x[1]*x[1] > 1.0)
+      {
+      return 0;
+      }
+    f[0] = -x[1];
+    f[1] = x[0] + 0.1*x[2];
+    f[2] = 0.3*x[3];
+    return 1;
+    }
+
+  int Batched;
+
+protected:
+  vtkTestSwirl()
+    {
+    this->NumFuncs = 3;
+    this->NumIndepVars = 4;
+    this->Batched = 0;
+    }
+
+private:
+  vtkTestSwirl(const vtkTestSwirl&);  // Not implemented.
+  void operator=(const vtkTestSwirl&);  // Not implemented.
+};
+
+vtkCxxRevisionMacro(vtkTestSwirl, "$Revision$");
+vtkStandardNewMacro(vtkTestSwirl);
+
+// The same field, evaluated for all the points together.
+class vtkTestBatchSwirl : public vtkTestSwirl
+{
+public:
+  static vtkTestBatchSwirl *New();
+  vtkTypeRevisionMacro(vtkTestBatchSwirl,vtkTestSwirl);
+
+  virtual vtkIdType BatchFunctionValues(vtkIdType n, double** x,
+                                        double** f, int* valid)
+    {
+    vtkIdType p, numValid = 0;
+    for (p = 0; p < n; p++)
+      {
+      valid[p] = (x[0][p]*x[0][p] + x[1][p]*x[1][p] <= 1.0);
+      numValid += valid[p];
+      }
+    for (p = 0; p < n; p++)
+      {
+      double v = valid[p];
+      f[0][p] = -x[1][p]*v;
+      f[1][p] = (x[0][p] + 0.1*x[2][p])*v;
+      f[2][p] = 0.3*x[3][p]*v;
+      }
+    this->Batched = 1;
+    return numValid;
+    }
+
+protected:
+  vtkTestBatchSwirl() {}
+
+private:
+  vtkTestBatchSwirl(const vtkTestBatchSwirl&);  // Not implemented.
+  void operator=(const vtkTestBatchSwirl&);  // Not implemented.
+};
+
+vtkCxxRevisionMacro(vtkTestBatchSwirl, "$Revision$");
+vtkStandardNewMacro(vtkTestBatchSwirl);
+
+static int TestSolver(vtkInitialValueProblemSolver *solver,
+                      vtkTestSwirl *swirl)
+{
+  const vtkIdType n = 301;
+  const double t = 0.7, delT = 0.05;
+  vtkstd::vector<double> prev(3*n), next(3*n), error(n);
+  vtkstd::vector<int> status(n);
+  double* xprev[3];
+  double* xnext[3];
+  vtkIdType p;
+  int i;
+  for (i = 0; i < 3; i++)
+    {
+    xprev[i] = &prev[i*n];
+    xnext[i] = &next[i*n];
+    }
+  // Some particles start outside of the disk, or leave it during the step.
+  for (p = 0; p < n; p++)
+    {
+    double r = vtkMath::Random(0.0, 1.02);
+    double theta = vtkMath::Random(0.0, 2.0*vtkMath::Pi());
+    xprev[0][p] = r*cos(theta);
+    xprev[1][p] = r*sin(theta);
+    xprev[2][p] = vtkMath::Random(-1.0, 1.0);
+    }
+
+  solver->SetFunctionSet(swirl);
+  if (solver->ComputeNextSteps(n, xprev, xnext, t, delT, &error[0],
+                               &status[0]) != 0)
+    {
+    cerr << solver->GetClassName() << " failed\n";
+    return 0;
+    }
+
+  int numOut = 0;
+  for (p = 0; p < n; p++)
+    {
+    double x[3], y[3], delTActual, err = 0.0, step = delT;
+    for (i = 0; i < 3; i++)
+      {
+      x[i] = xprev[i][p];
+      }
+    int ret = solver->ComputeNextStep(x, y, t, step, delTActual, delT, delT,
+                                      0.0, err);
+    numOut += (ret == vtkInitialValueProblemSolver::OUT_OF_DOMAIN);
+    if (ret != status[p] ||
+        (ret == 0 && (y[0] != xnext[0][p] || y[1] != xnext[1][p] ||
+                      y[2] != xnext[2][p] || err != error[p])))
+      {
+      cerr << solver->GetClassName() << " differs for particle " << p
+           << "\n";
+      return 0;
+      }
+    }
+  if (numOut == 0 || numOut == n)
+    {
+    cerr << numOut << " particles left the domain\n";
+    return 0;
+    }
+  return 1;
+}
+
+int TestRungeKuttaBatch(int, char *[])
+{
+  vtkMath::RandomSeed(3141);
+  vtkSmartPointer<vtkTestSwirl> swirl = vtkSmartPointer<vtkTestSwirl>::New();
+  vtkSmartPointer<vtkTestBatchSwirl> batchSwirl =
+    vtkSmartPointer<vtkTestBatchSwirl>::New();
+  vtkSmartPointer<vtkInitialValueProblemSolver> solvers[3];
+  solvers[0] = vtkSmartPointer<vtkRungeKutta2>::New();
+  solvers[1] = vtkSmartPointer<vtkRungeKutta4>::New();
+  solvers[2] = vtkSmartPointer<vtkRungeKutta45>::New();
+  for (int i = 0; i < 3; i++)
+    {
+    if (!TestSolver(solvers[i], swirl) || !TestSolver(solvers[i], batchSwirl))
+      {
+      return 1;
+      }
+    }
+  if (!batchSwirl->Batched)
+    {
+    cerr << "BatchFunctionValues() was not called\n";
+    return 1;
+    }
+  return 0;
+}
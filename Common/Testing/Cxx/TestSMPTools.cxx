@@ -0,0 +1,267 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPTools.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkMultiThreader.h"
+#include "vtkPoints.h"
+#include "vtkThreadPool.h"
+#include "vtkTransform.h"
+
+#include <vtkstd/vector>
+
+// Mark every id of the range once.
+class vtkTestSMPToolsMark
+{
+public:
+  int *Marks;
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      ++this->Marks[i];
+      }
+    }
+};
+
+// Sum the ids of the range in thread-local storage.
+class vtkTestSMPToolsSum
+{
+public:
+  vtkSMPThreadLocal<vtkIdType> LocalSum;
+  vtkIdType Sum;
+
+  vtkTestSMPToolsSum() : LocalSum(-1), Sum(0) {}
+
+  void Initialize()
+    {
+    this->LocalSum.Local() = 0;
+    }
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType& sum = this->LocalSum.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      sum += i;
+      }
+    }
+  void Reduce()
+    {
+    this->Sum = 0;
+    for (vtkSMPThreadLocal<vtkIdType>::iterator it = this->LocalSum.begin();
+         it != this->LocalSum.end(); ++it)
+      {
+      this->Sum += *it;
+      }
+    }
+};
+
+// Count the ids of the range in thread-local storage without Initialize(),
+// from loops submitted by several threads at the same time.
+class vtkTestSMPToolsCount
+{
+public:
+  vtkSMPThreadLocal<vtkIdType> LocalCount;
+  vtkIdType Size;
+
+  vtkTestSMPToolsCount() : LocalCount(0), Size(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    this->LocalCount.Local() += end - begin;
+    }
+  vtkIdType Total()
+    {
+    vtkIdType total = 0;
+    for (vtkSMPThreadLocal<vtkIdType>::iterator it = this->LocalCount.begin();
+         it != this->LocalCount.end(); ++it)
+      {
+      total += *it;
+      }
+    return total;
+    }
+};
+
+static VTK_THREAD_RETURN_TYPE vtkTestSMPToolsSubmit(void *arg)
+{
+  vtkTestSMPToolsCount *count = static_cast<vtkTestSMPToolsCount *>(
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
+  for (int i = 0; i < 50; ++i)
+    {
+    vtkSMPTools::For(0, count->Size, 100, *count);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Key compared on Key only, to check that Sort() is stable.
+struct vtkTestSMPToolsRecord
+{
+  int Key;
+  vtkIdType Position;
+  bool operator<(const vtkTestSMPToolsRecord& other) const
+    {
+    return this->Key < other.Key;
+    }
+};
+
+int TestSMPTools(int, char *[])
+{
+  int ok = 1;
+  const vtkIdType num = 100003;
+
+  // Use several workers even on single processor machines.
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+
+  if (vtkSMPTools::GetNumberOfThreads() < 1)
+    {
+    cerr << "Bad number of threads" << endl;
+    ok = 0;
+    }
+
+  // For() must visit every id once, whatever the grain.
+  vtkIdType grains[3] = { 0, 1000, 2*num };
+  for (int g = 0; g < 3; ++g)
+    {
+    vtkstd::vector<int> marks(num, 0);
+    vtkTestSMPToolsMark mark;
+    mark.Marks = &marks[0];
+    vtkSMPTools::For(0, num, grains[g], mark);
+    for (vtkIdType i = 0; i < num; ++i)
+      {
+      if (marks[i] != 1)
+        {
+        cerr << "For() with grain " << grains[g] << " visited id " << i
+             << " " << marks[i] << " times" << endl;
+        ok = 0;
+        break;
+        }
+      }
+    }
+
+  // Reduce() must initialize every used slot and combine them all.
+  vtkTestSMPToolsSum sum;
+  vtkSMPTools::Reduce(0, num, 100, sum);
+  if (sum.Sum != num * (num - 1) / 2)
+    {
+    cerr << "Reduce() computed " << sum.Sum << " instead of "
+         << num * (num - 1) / 2 << endl;
+    ok = 0;
+    }
+  if (sum.LocalSum.GetNumberOfUsedSlots() < 1)
+    {
+    cerr << "Reduce() used no thread local slot" << endl;
+    ok = 0;
+    }
+
+  // The slots follow a change of the number of threads.
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(7);
+  vtkTestSMPToolsSum moreSum;
+  vtkSMPTools::Reduce(0, num, 100, moreSum);
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+  if (moreSum.Sum != num * (num - 1) / 2)
+    {
+    cerr << "Reduce() with more threads computed " << moreSum.Sum << endl;
+    ok = 0;
+    }
+
+  // Two threads outside the pool run loops sharing the thread-local
+  // storage: each of them must have its own copy.
+  vtkTestSMPToolsCount count;
+  count.Size = 10000;
+  vtkMultiThreader *submitters = vtkMultiThreader::New();
+  submitters->UseThreadPoolOff();
+  submitters->SetNumberOfThreads(2);
+  submitters->SetSingleMethod(vtkTestSMPToolsSubmit, &count);
+  submitters->SingleMethodExecute();
+  submitters->Delete();
+  if (count.Total() != 2 * 50 * count.Size)
+    {
+    cerr << "Concurrent loops counted " << count.Total() << " ids instead of "
+         << 2 * 50 * count.Size << endl;
+    ok = 0;
+    }
+
+  // Sort() must order the keys and keep equal keys in input order.
+  vtkstd::vector<vtkTestSMPToolsRecord> records(num);
+  for (vtkIdType i = 0; i < num; ++i)
+    {
+    records[i].Key = static_cast<int>((i * 7919) % 1009);
+    records[i].Position = i;
+    }
+  vtkSMPTools::Sort(&records[0], &records[0] + num);
+  for (vtkIdType i = 1; i < num; ++i)
+    {
+    if (records[i].Key < records[i-1].Key ||
+        (records[i].Key == records[i-1].Key &&
+         records[i].Position < records[i-1].Position))
+      {
+      cerr << "Sort() misplaced element " << i << endl;
+      ok = 0;
+      break;
+      }
+    }
+
+  // vtkLinearTransform transforms large point sets in parallel. The
+  // result must match the point-by-point transformation, and points
+  // already in the output must be kept.
+  vtkTransform *transform = vtkTransform::New();
+  transform->RotateZ(30.0);
+  transform->Translate(1.0, 2.0, 3.0);
+  transform->Scale(2.0, 1.0, 0.5);
+  vtkPoints *inPts = vtkPoints::New();
+  inPts->SetNumberOfPoints(num);
+  for (vtkIdType i = 0; i < num; ++i)
+    {
+    inPts->SetPoint(i, i, 0.5 * i, -0.25 * i);
+    }
+  vtkPoints *outPts = vtkPoints::New();
+  outPts->InsertNextPoint(7.0, 8.0, 9.0);
+  transform->TransformPoints(inPts, outPts);
+  if (outPts->GetNumberOfPoints() != num + 1)
+    {
+    cerr << "TransformPoints() produced " << outPts->GetNumberOfPoints()
+         << " points instead of " << num + 1 << endl;
+    ok = 0;
+    }
+  else
+    {
+    double x[3], y[3];
+    outPts->GetPoint(0, y);
+    if (y[0] != 7.0 || y[1] != 8.0 || y[2] != 9.0)
+      {
+      cerr << "TransformPoints() overwrote the existing output" << endl;
+      ok = 0;
+      }
+    for (vtkIdType i = 0; i < num; ++i)
+      {
+      inPts->GetPoint(i, x);
+      transform->TransformPoint(x, x);
+      outPts->GetPoint(i + 1, y);
+      // the output stores floats
+      if (static_cast<float>(x[0]) != y[0] ||
+          static_cast<float>(x[1]) != y[1] ||
+          static_cast<float>(x[2]) != y[2])
+        {
+        cerr << "TransformPoints() mismatch at point " << i << endl;
+        ok = 0;
+        break;
+        }
+      }
+    }
+  outPts->Delete();
+  inPts->Delete();
+  transform->Delete();
+
+  return ok ? 0 : 1;
+}
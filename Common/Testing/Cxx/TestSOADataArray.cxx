@@ -0,0 +1,314 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check vtkSOAFloatArray/vtkSOADoubleArray against the interleaved arrays.
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkSOADoubleArray.h"
+#include "vtkSOAFloatArray.h"
+
+#define NUM_TUPLES 100
+
+struct vtkTestSOARecord
+{
+  float X;
+  float Y;
+  float Z;
+  int Id;
+};
+
+static int CompareArrays(vtkDataArray *a, vtkDataArray *b, const char *what)
+{
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    cerr << what << ": sizes differ\n";
+    return 1;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    for (int j = 0; j < a->GetNumberOfComponents(); j++)
+      {
+      if (a->GetComponent(i, j) != b->GetComponent(i, j))
+        {
+        cerr << what << ": tuple " << i << " component " << j << " is "
+             << a->GetComponent(i, j) << " instead of "
+             << b->GetComponent(i, j) << "\n";
+        return 1;
+        }
+      }
+    }
+  return 0;
+}
+
+int TestSOADataArray(int,char *[])
+{
+  int errors = 0;
+  vtkIdType i;
+
+  // Three user buffers, used without copying.
+  double *x = new double[NUM_TUPLES];
+  double *y = new double[NUM_TUPLES];
+  double *z = new double[NUM_TUPLES];
+  vtkDoubleArray *ref = vtkDoubleArray::New();
+  ref->SetNumberOfComponents(3);
+  for (i = 0; i < NUM_TUPLES; i++)
+    {
+    x[i] = i;
+    y[i] = -2.0*i;
+    z[i] = 0.5*i;
+    ref->InsertNextTuple3(x[i], y[i], z[i]);
+    }
+  vtkSOADoubleArray *soa = vtkSOADoubleArray::New();
+  soa->SetNumberOfComponents(3);
+  soa->SetArray(0, x, NUM_TUPLES, 0, vtkSOADoubleArray::VTK_DATA_ARRAY_DELETE);
+  soa->SetArray(1, y, NUM_TUPLES, 0, vtkSOADoubleArray::VTK_DATA_ARRAY_DELETE);
+  soa->SetArray(2, z, NUM_TUPLES, 0, vtkSOADoubleArray::VTK_DATA_ARRAY_DELETE);
+  if (soa->GetComponentPointer(1) != y || soa->HasStandardMemoryLayout())
+    {
+    cerr << "SetArray copied the buffer\n";
+    errors++;
+    }
+  errors += CompareArrays(soa, ref, "SetArray");
+
+  // The buffers are used in place.
+  y[7] = 42.0;
+  soa->DataChanged();
+  if (soa->GetTuple(7)[1] != 42.0)
+    {
+    cerr << "GetTuple does not read the user buffer\n";
+    errors++;
+    }
+  y[7] = -14.0;
+  soa->DataChanged();
+
+  // Ranges.
+  double range[2];
+  soa->Modified();
+  soa->GetRange(range, 1);
+  if (range[0] != -2.0*(NUM_TUPLES-1) || range[1] != 0.0)
+    {
+    cerr << "Wrong range " << range[0] << " " << range[1] << "\n";
+    errors++;
+    }
+
+  // Growing the array keeps the values and replaces the user buffers.
+  soa->InsertNextTuple3(1.0, 2.0, 3.0);
+  ref->InsertNextTuple3(1.0, 2.0, 3.0);
+  soa->InsertComponent(NUM_TUPLES+1, 2, 5.0);
+  ref->InsertComponent(NUM_TUPLES+1, 2, 5.0);
+  errors += CompareArrays(soa, ref, "InsertNextTuple");
+
+  // Copies between interleaved and structure-of-arrays layouts.
+  vtkDoubleArray *aos = vtkDoubleArray::New();
+  aos->SetNumberOfComponents(3);
+  vtkSOADoubleArray *soa2 = vtkSOADoubleArray::New();
+  soa2->SetNumberOfComponents(3);
+  for (i = 0; i < soa->GetNumberOfTuples(); i++)
+    {
+    aos->InsertTuple(i, i, soa);
+    soa2->InsertNextTuple(i, ref);
+    }
+  errors += CompareArrays(aos, ref, "InsertTuple from SOA");
+  errors += CompareArrays(soa2, ref, "InsertNextTuple from AOS");
+
+  vtkIdList *ids = vtkIdList::New();
+  ids->InsertNextId(3);
+  ids->InsertNextId(1);
+  ids->InsertNextId(4);
+  double weights[3] = {0.25, 0.25, 0.5};
+  aos->InterpolateTuple(0, ids, soa, weights);
+  soa2->InterpolateTuple(0, ids, ref, weights);
+  ref->InterpolateTuple(0, ids, ref, weights);
+  aos->InterpolateTuple(1, 3, soa, 4, soa, 0.75);
+  soa2->InterpolateTuple(1, 3, ref, 4, ref, 0.75);
+  ref->InterpolateTuple(1, 3, ref, 4, ref, 0.75);
+  errors += CompareArrays(aos, ref, "InterpolateTuple from SOA");
+  errors += CompareArrays(soa2, ref, "InterpolateTuple from AOS");
+
+  vtkDoubleArray *some = vtkDoubleArray::New();
+  some->SetNumberOfComponents(3);
+  some->SetNumberOfTuples(3);
+  soa2->GetTuples(ids, some);
+  for (i = 0; i < 3; i++)
+    {
+    if (some->GetComponent(i, 2) != ref->GetComponent(ids->GetId(i), 2))
+      {
+      cerr << "GetTuples from SOA failed\n";
+      errors++;
+      }
+    }
+
+  // The iterator reads and writes the component buffers.
+  vtkArrayIteratorTemplate<double> *iter =
+    static_cast<vtkArrayIteratorTemplate<double> *>(soa2->NewIterator());
+  for (i = 0; i < iter->GetNumberOfValues(); i++)
+    {
+    if (iter->GetValue(i) != ref->GetValue(i))
+      {
+      cerr << "Iterator value " << i << " is wrong\n";
+      errors++;
+      break;
+      }
+    }
+  if (iter->GetTuple(5)[2] != ref->GetComponent(5, 2))
+    {
+    cerr << "Iterator tuple is wrong\n";
+    errors++;
+    }
+  iter->SetValue(3*5+1, 7.0);
+  if (soa2->GetComponent(5, 1) != 7.0)
+    {
+    cerr << "Iterator SetValue did not write to the array\n";
+    errors++;
+    }
+  iter->SetValue(3*5+1, ref->GetComponent(5, 1));
+  iter->Delete();
+
+  // Interpolating into preallocated tuples does not grow the array.
+  vtkSOADoubleArray *pre = vtkSOADoubleArray::New();
+  pre->SetNumberOfComponents(3);
+  pre->SetNumberOfTuples(2);
+  double *px = pre->GetComponentPointer(0);
+  vtkDoubleArray *expected = vtkDoubleArray::New();
+  expected->SetNumberOfComponents(3);
+  expected->SetNumberOfTuples(2);
+  pre->InterpolateTuple(1, ids, ref, weights);
+  expected->InterpolateTuple(1, ids, ref, weights);
+  pre->InterpolateTuple(0, 3, ref, 4, ref, 0.75);
+  expected->InterpolateTuple(0, 3, ref, 4, ref, 0.75);
+  if (pre->GetComponentPointer(0) != px)
+    {
+    cerr << "InterpolateTuple reallocated preallocated tuples\n";
+    errors++;
+    }
+  errors += CompareArrays(pre, expected, "InterpolateTuple into SOA");
+  expected->Delete();
+  pre->Delete();
+
+  // GetVoidPointer() interleaves the values once, and writes through the
+  // pointer are seen by the other methods.
+  double *values = static_cast<double *>(soa2->GetVoidPointer(0));
+  if (!values || !soa2->HasStandardMemoryLayout() ||
+      soa2->GetVoidPointer(0) != values ||
+      soa2->GetComponentPointer(2) != values + 2 ||
+      soa2->GetComponentStride(2) != 3)
+    {
+    cerr << "GetVoidPointer did not interleave the array\n";
+    errors++;
+    }
+  for (i = 0; values && i <= soa2->GetMaxId(); i++)
+    {
+    if (values[i] != ref->GetValue(i))
+      {
+      cerr << "Interleaved value " << i << " is wrong\n";
+      errors++;
+      break;
+      }
+    }
+  if (values)
+    {
+    values[3*6+2] = 11.0;
+    if (soa2->GetComponent(6, 2) != 11.0)
+      {
+      cerr << "Writes through GetVoidPointer are lost\n";
+      errors++;
+      }
+    values[3*6+2] = ref->GetComponent(6, 2);
+    }
+
+  vtkDoubleArray *deep = vtkDoubleArray::New();
+  deep->DeepCopy(soa2);
+  errors += CompareArrays(deep, ref, "DeepCopy to AOS");
+  soa2->DeepCopy(aos);
+  errors += CompareArrays(soa2, ref, "DeepCopy from AOS");
+
+  // Strided components of an array of records.
+  vtkTestSOARecord records[NUM_TUPLES];
+  for (i = 0; i < NUM_TUPLES; i++)
+    {
+    records[i].X = static_cast<float>(i);
+    records[i].Y = static_cast<float>(2*i);
+    records[i].Z = static_cast<float>(3*i);
+    records[i].Id = static_cast<int>(i);
+    }
+  vtkSOAFloatArray *strided = vtkSOAFloatArray::New();
+  strided->SetNumberOfComponents(3);
+  vtkIdType stride = sizeof(vtkTestSOARecord) / sizeof(float);
+  strided->SetStridedArray(0, &records[0].X, NUM_TUPLES, stride);
+  strided->SetStridedArray(1, &records[0].Y, NUM_TUPLES, stride);
+  strided->SetStridedArray(2, &records[0].Z, NUM_TUPLES, stride);
+  float tuple[3];
+  strided->GetTupleValue(17, tuple);
+  if (tuple[0] != 17.0f || tuple[1] != 34.0f || tuple[2] != 51.0f)
+    {
+    cerr << "Wrong strided tuple\n";
+    errors++;
+    }
+  strided->SetComponent(17, 1, -1.0);
+  if (records[17].Y != -1.0f || records[17].Id != 17)
+    {
+    cerr << "SetComponent did not write to the record\n";
+    errors++;
+    }
+  strided->GetRange(range, 2);
+  if (range[0] != 0.0 || range[1] != 3.0*(NUM_TUPLES-1))
+    {
+    cerr << "Wrong strided range " << range[0] << " " << range[1] << "\n";
+    errors++;
+    }
+  vtkFloatArray *floats = vtkFloatArray::New();
+  floats->DeepCopy(strided);
+  errors += CompareArrays(floats, strided, "DeepCopy of strided");
+
+  // Changing the number of components regroups the values, as it does for
+  // the interleaved arrays.
+  floats->SetNumberOfComponents(2);
+  strided->SetNumberOfComponents(2);
+  errors += CompareArrays(strided, floats, "SetNumberOfComponents");
+  strided->InsertNextTuple2(1.0, 2.0);
+  floats->InsertNextTuple2(1.0, 2.0);
+  errors += CompareArrays(strided, floats, "InsertNextTuple2");
+
+  // WriteVoidPointer() grows and interleaves the array.
+  float *written = static_cast<float *>(
+    strided->WriteVoidPointer(2*strided->GetNumberOfTuples(), 2));
+  floats->InsertNextTuple2(3.0, 4.0);
+  if (!written || !strided->HasStandardMemoryLayout())
+    {
+    cerr << "WriteVoidPointer did not interleave the array\n";
+    errors++;
+    }
+  else
+    {
+    written[0] = 3.0f;
+    written[1] = 4.0f;
+    errors += CompareArrays(strided, floats, "WriteVoidPointer");
+    }
+
+  floats->Delete();
+  strided->Delete();
+  deep->Delete();
+  some->Delete();
+  ids->Delete();
+  soa2->Delete();
+  aos->Delete();
+  soa->Delete();
+  ref->Delete();
+
+  return errors;
+}
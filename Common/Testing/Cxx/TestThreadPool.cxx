@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkThreadPool.h"
+#include "vtkMultiThreader.h"
+
+#include <vtkstd/vector>
+
+// Each piece marks the ids it was given. Every id must be marked once.
+static void vtkTestThreadPoolMark(void *data, vtkIdType begin,
+                                  vtkIdType end, int)
+{
+  int *marks = static_cast<int *>(data);
+  for (vtkIdType i = begin; i < end; ++i)
+    {
+    ++marks[i];
+    }
+}
+
+// Every piece of the outer range runs a nested ParallelFor on its own
+// row of a table.
+struct vtkTestThreadPoolNested
+{
+  vtkThreadPool *Pool;
+  int *Marks;
+  vtkIdType RowSize;
+};
+
+static void vtkTestThreadPoolOuter(void *data, vtkIdType begin,
+                                   vtkIdType end, int)
+{
+  vtkTestThreadPoolNested *nested =
+    static_cast<vtkTestThreadPoolNested *>(data);
+  for (vtkIdType row = begin; row < end; ++row)
+    {
+    nested->Pool->ParallelFor(0, nested->RowSize, 7, vtkTestThreadPoolMark,
+                              nested->Marks + row * nested->RowSize);
+    }
+}
+
+static VTK_THREAD_RETURN_TYPE vtkTestThreadPoolMethod(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  int *marks = static_cast<int *>(info->UserData);
+  ++marks[info->ThreadID];
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Threads that are not workers submit work concurrently. Every piece
+// checks that the index it is given is the index of the executing thread,
+// which is a worker index or an index of its own above them.
+struct vtkTestThreadPoolGuests
+{
+  vtkThreadPool *Pool;
+  int *Marks[2];
+  int *Errors;
+};
+
+static void vtkTestThreadPoolCheckIndex(void *data, vtkIdType begin,
+                                        vtkIdType end, int threadId)
+{
+  vtkTestThreadPoolGuests *guests =
+    static_cast<vtkTestThreadPoolGuests *>(data);
+  if (threadId != guests->Pool->GetThreadIndex() || threadId < 0 ||
+      threadId == guests->Pool->GetNumberOfThreads())
+    {
+    ++guests->Errors[begin];
+    }
+}
+
+static VTK_THREAD_RETURN_TYPE vtkTestThreadPoolGuest(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkTestThreadPoolGuests *guests =
+    static_cast<vtkTestThreadPoolGuests *>(info->UserData);
+  for (int i = 0; i < 200; ++i)
+    {
+    guests->Pool->ParallelFor(0, 1000, 10, vtkTestThreadPoolMark,
+                              guests->Marks[info->ThreadID]);
+    guests->Pool->ParallelFor(0, 1000, 10, vtkTestThreadPoolCheckIndex,
+                              guests);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+static int CheckMarks(const char *name, vtkstd::vector<int>& marks,
+                      int expected)
+{
+  for (size_t i = 0; i < marks.size(); ++i)
+    {
+    if (marks[i] != expected)
+      {
+      cerr << name << ": id " << i << " visited " << marks[i]
+           << " times instead of " << expected << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+int TestThreadPool(int, char *[])
+{
+  int ok = 1;
+
+  vtkThreadPool *pool = vtkThreadPool::New();
+  pool->SetNumberOfThreads(4);
+
+  // Plain range with an explicit and an automatic grain.
+  vtkstd::vector<int> marks(100003, 0);
+  pool->ParallelFor(0, static_cast<vtkIdType>(marks.size()), 100,
+                    vtkTestThreadPoolMark, &marks[0]);
+  ok &= CheckMarks("ParallelFor", marks, 1);
+  pool->ParallelFor(0, static_cast<vtkIdType>(marks.size()), 0,
+                    vtkTestThreadPoolMark, &marks[0]);
+  ok &= CheckMarks("ParallelFor (automatic grain)", marks, 2);
+
+  // Repeated small executions reuse the same workers.
+  vtkstd::vector<int> small(16, 0);
+  for (int i = 0; i < 1000; ++i)
+    {
+    pool->ParallelFor(0, 16, 1, vtkTestThreadPoolMark, &small[0]);
+    }
+  ok &= CheckMarks("Repeated ParallelFor", small, 1000);
+
+  // Nested executions must not dead-lock.
+  vtkstd::vector<int> table(64 * 100, 0);
+  vtkTestThreadPoolNested nested;
+  nested.Pool = pool;
+  nested.Marks = &table[0];
+  nested.RowSize = 100;
+  pool->ParallelFor(0, 64, 1, vtkTestThreadPoolOuter, &nested);
+  ok &= CheckMarks("Nested ParallelFor", table, 1);
+
+  // Changing the number of threads restarts the workers.
+  pool->SetNumberOfThreads(2);
+  pool->ParallelFor(0, static_cast<vtkIdType>(marks.size()), 10,
+                    vtkTestThreadPoolMark, &marks[0]);
+  ok &= CheckMarks("ParallelFor after SetNumberOfThreads", marks, 3);
+
+  // Two threads outside the pool submit at the same time.
+  vtkstd::vector<int> guestMarks0(1000, 0);
+  vtkstd::vector<int> guestMarks1(1000, 0);
+  vtkstd::vector<int> errors(1000, 0);
+  vtkTestThreadPoolGuests guests;
+  guests.Pool = pool;
+  guests.Marks[0] = &guestMarks0[0];
+  guests.Marks[1] = &guestMarks1[0];
+  guests.Errors = &errors[0];
+  vtkMultiThreader *submitters = vtkMultiThreader::New();
+  submitters->UseThreadPoolOff();
+  submitters->SetNumberOfThreads(2);
+  submitters->SetSingleMethod(vtkTestThreadPoolGuest, &guests);
+  submitters->SingleMethodExecute();
+  submitters->Delete();
+  ok &= CheckMarks("Concurrent submissions (first)", guestMarks0, 200);
+  ok &= CheckMarks("Concurrent submissions (second)", guestMarks1, 200);
+  ok &= CheckMarks("Thread indices", errors, 0);
+  if (pool->GetThreadIndex() != -1)
+    {
+    cerr << "The main thread keeps an index after the execution" << endl;
+    ok = 0;
+    }
+  pool->Delete();
+
+  // vtkMultiThreader running on the process-wide pool.
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->UseThreadPoolOn();
+  vtkstd::vector<int> ids(threader->GetNumberOfThreads(), 0);
+  threader->SetSingleMethod(vtkTestThreadPoolMethod, &ids[0]);
+  threader->SingleMethodExecute();
+  threader->SingleMethodExecute();
+  ok &= CheckMarks("vtkMultiThreader::SingleMethodExecute", ids, 2);
+  threader->Delete();
+
+  return ok ? 0 : 1;
+}
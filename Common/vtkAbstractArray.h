@@ -245,6 +245,14 @@ public:
   // must return true if and only if an array contains numeric data.
   virtual int IsNumeric() = 0;
 
+  // Description:
+  // Return 1 if the values are stored contiguously in memory, tuple after
+  // tuple with the components of each tuple interleaved, so that
+  // GetVoidPointer() gives direct access to them. Arrays with a different
+  // layout (e.g. vtkSOADataArrayTemplate) return 0; code working on raw
+  // pointers should then fall back to the tuple or component API.
+  virtual int HasStandardMemoryLayout() { return 1; }
+
   // Description:
   // Subclasses must override this method and provide the right 
   // kind of templated vtkArrayIteratorTemplate.
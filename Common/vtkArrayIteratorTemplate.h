@@ -14,9 +14,11 @@
 =========================================================================*/
 // .NAME vtkArrayIteratorTemplate - Implementation template for a array iterator.
 // .SECTION Description
-// This is implementation template for a array iterator. It only works with
+// This is implementation template for a array iterator. It works with
 // arrays that have a contiguous internal storage of values (as in vtkDataArray,
-// vtkStringArray).
+// vtkStringArray) and, through InitializeComponents(), with arrays that keep
+// each component in a buffer of its own (as in vtkSOADataArrayTemplate) or
+// that compute their values (as in vtkImplicitDataArrayTemplate).
 
 #ifndef __vtkArrayIteratorTemplate_h
 #define __vtkArrayIteratorTemplate_h
@@ -46,6 +48,22 @@ public:
   // If the array is modified, the iterator must be re-intialized.
   virtual void Initialize(vtkAbstractArray* array);
 
+  // Description:
+  // Iterate over an array that keeps each component in a buffer of its
+  // own: component c of tuple i is arrays[c][i*strides[c]]. GetValue() and
+  // SetValue() then work on these buffers, while GetTuple() returns a copy
+  // of the tuple; writing to that copy does not change the array.
+  void InitializeComponents(vtkAbstractArray* array, T** arrays,
+                            vtkIdType* strides);
+
+  // Description:
+  // Iterate over an array whose values are computed: value id is
+  // valueFunction(array, id). GetValue() and GetTuple() then return a
+  // copy of the values, and SetValue() does not change the array.
+  typedef T (*ValueFunctionType)(vtkAbstractArray* array, vtkIdType id);
+  void InitializeValueFunction(vtkAbstractArray* array,
+                               ValueFunctionType valueFunction);
+
   // Description:
   // Get the array.
   vtkAbstractArray* GetArray(){ return this->Array; }
@@ -58,14 +76,27 @@ public:
   // Description:
   // Must be called only after Initialize.
   T& GetValue(vtkIdType id)
-    { return this->Pointer[id]; }
+    {
+    if (!this->Components)
+      {
+      if (this->ValueFunction)
+        {
+        this->Value = this->ValueFunction(this->Array, id);
+        return this->Value;
+        }
+      return this->Pointer[id];
+      }
+    int comp = static_cast<int>(id % this->NumberOfComponentBuffers);
+    return this->Components[comp][(id / this->NumberOfComponentBuffers) *
+                                  this->ComponentStrides[comp]];
+    }
 
   // Description:
   // Sets the value at the index. This does not verify if the index is valid.
   // The caller must ensure that id is less than the maximum number of values.
   void SetValue(vtkIdType id, T value)
     {
-    this->Pointer[id] = value;
+    this->GetValue(id) = value;
     }
 
   // Description:
@@ -96,6 +127,18 @@ protected:
   ~vtkArrayIteratorTemplate();
 
   T* Pointer;
+
+  // Per-component buffers set by InitializeComponents().
+  T** Components;
+  vtkIdType* ComponentStrides;
+  int NumberOfComponentBuffers;
+  T* Tuple;
+
+  // Value function set by InitializeValueFunction().
+  ValueFunctionType ValueFunction;
+  T Value;
+
+  void ReleaseComponents();
 private:
   vtkArrayIteratorTemplate(const vtkArrayIteratorTemplate&); // Not implemented.
   void operator=(const vtkArrayIteratorTemplate&); // Not implemented.
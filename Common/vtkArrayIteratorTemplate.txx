@@ -42,6 +42,11 @@ vtkArrayIteratorTemplate<T>::vtkArrayIteratorTemplate()
 {
   this->Array = 0;
   this->Pointer = 0;
+  this->Components = 0;
+  this->ComponentStrides = 0;
+  this->NumberOfComponentBuffers = 0;
+  this->Tuple = 0;
+  this->ValueFunction = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -50,6 +55,21 @@ vtkArrayIteratorTemplate<T>::~vtkArrayIteratorTemplate()
 {
   this->SetArray(0);
   this->Pointer = 0;
+  this->ReleaseComponents();
+}
+
+//-----------------------------------------------------------------------------
+template <class T>
+void vtkArrayIteratorTemplate<T>::ReleaseComponents()
+{
+  delete [] this->Components;
+  delete [] this->ComponentStrides;
+  delete [] this->Tuple;
+  this->Components = 0;
+  this->ComponentStrides = 0;
+  this->NumberOfComponentBuffers = 0;
+  this->Tuple = 0;
+  this->ValueFunction = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -58,12 +78,55 @@ void vtkArrayIteratorTemplate<T>::Initialize(vtkAbstractArray* a)
 {
   this->SetArray(a);
   this->Pointer = 0;
+  this->ReleaseComponents();
   if (this->Array)
     {
     this->Pointer = static_cast<T*>(this->Array->GetVoidPointer(0));
     }
 }
 
+//-----------------------------------------------------------------------------
+template <class T>
+void vtkArrayIteratorTemplate<T>::InitializeComponents(vtkAbstractArray* a,
+                                                       T** arrays,
+                                                       vtkIdType* strides)
+{
+  this->SetArray(a);
+  this->Pointer = 0;
+  this->ReleaseComponents();
+  if (!this->Array || !arrays)
+    {
+    return;
+    }
+  int numComp = this->Array->GetNumberOfComponents();
+  this->Components = new T*[numComp];
+  this->ComponentStrides = new vtkIdType[numComp];
+  this->Tuple = new T[numComp];
+  this->NumberOfComponentBuffers = numComp;
+  for (int comp = 0; comp < numComp; comp++)
+    {
+    this->Components[comp] = arrays[comp];
+    this->ComponentStrides[comp] = strides[comp];
+    }
+}
+
+//-----------------------------------------------------------------------------
+template <class T>
+void vtkArrayIteratorTemplate<T>::InitializeValueFunction(
+  vtkAbstractArray* a, ValueFunctionType valueFunction)
+{
+  this->SetArray(a);
+  this->Pointer = 0;
+  this->ReleaseComponents();
+  if (!this->Array)
+    {
+    return;
+    }
+  this->NumberOfComponentBuffers = this->Array->GetNumberOfComponents();
+  this->Tuple = new T[this->NumberOfComponentBuffers];
+  this->ValueFunction = valueFunction;
+}
+
 //-----------------------------------------------------------------------------
 template <class T>
 vtkIdType vtkArrayIteratorTemplate<T>::GetNumberOfTuples()
@@ -101,7 +164,25 @@ int vtkArrayIteratorTemplate<T>::GetNumberOfComponents()
 template <class T>
 T* vtkArrayIteratorTemplate<T>::GetTuple(vtkIdType id)
 {
-  return &this->Pointer[id * this->Array->GetNumberOfComponents()];
+  if (this->ValueFunction)
+    {
+    vtkIdType first = id * this->NumberOfComponentBuffers;
+    for (int comp = 0; comp < this->NumberOfComponentBuffers; comp++)
+      {
+      this->Tuple[comp] = this->ValueFunction(this->Array, first + comp);
+      }
+    return this->Tuple;
+    }
+  if (!this->Components)
+    {
+    return &this->Pointer[id * this->Array->GetNumberOfComponents()];
+    }
+  for (int comp = 0; comp < this->NumberOfComponentBuffers; comp++)
+    {
+    this->Tuple[comp] =
+      this->Components[comp][id * this->ComponentStrides[comp]];
+    }
+  return this->Tuple;
 }
 
 //-----------------------------------------------------------------------------
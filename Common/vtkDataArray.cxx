@@ -141,27 +141,42 @@ void vtkDataArray::DeepCopy(vtkDataArray *da)
     vtkIdType numTuples = da->GetNumberOfTuples();
     this->NumberOfComponents = da->NumberOfComponents;
     this->SetNumberOfTuples(numTuples);
-    void *input=da->GetVoidPointer(0);
 
-    switch (da->GetDataType())
+    // Go through the tuples when the values are not interleaved.
+    if (!this->HasStandardMemoryLayout() || !da->HasStandardMemoryLayout())
       {
-      vtkTemplateMacro(
-        vtkDeepCopySwitchOnOutput(static_cast<VTK_TT*>(input),
-                                  this,
-                                  numTuples,
-                                  this->NumberOfComponents));
-
-      case VTK_BIT:
-        {//bit not supported, using generic double API
-        for (vtkIdType i=0; i < numTuples; i++)
-          {
-          this->SetTuple(i, da->GetTuple(i));
-          }
-        break;
+      double *tuple = new double[this->NumberOfComponents];
+      for (vtkIdType i=0; i < numTuples; i++)
+        {
+        da->GetTuple(i, tuple);
+        this->SetTuple(i, tuple);
         }
+      delete [] tuple;
+      }
+    else
+      {
+      void *input=da->GetVoidPointer(0);
+
+      switch (da->GetDataType())
+        {
+        vtkTemplateMacro(
+          vtkDeepCopySwitchOnOutput(static_cast<VTK_TT*>(input),
+                                    this,
+                                    numTuples,
+                                    this->NumberOfComponents));
+
+        case VTK_BIT:
+          {//bit not supported, using generic double API
+          for (vtkIdType i=0; i < numTuples; i++)
+            {
+            this->SetTuple(i, da->GetTuple(i));
+            }
+          break;
+          }
 
-      default:
-        vtkErrorMacro("Unsupported data type " << da->GetDataType() << "!");
+        default:
+          vtkErrorMacro("Unsupported data type " << da->GetDataType() << "!");
+        }
       }
 
     this->SetLookupTable(0);
@@ -314,6 +329,33 @@ void vtkDataArray::InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
     vtkIdType idx= i*numComp;
     double c;
 
+    // Go through the components when the values are not interleaved.
+    // Grow the array once if needed, then only write into the tuple so
+    // that threads filling preallocated tuples do not reallocate.
+    if (!this->HasStandardMemoryLayout() ||
+        !fromData->HasStandardMemoryLayout())
+      {
+      int isReal = (this->GetDataType() == VTK_FLOAT ||
+                    this->GetDataType() == VTK_DOUBLE);
+      if (i >= this->GetNumberOfTuples())
+        {
+        this->InsertComponent(i, numComp-1, 0.0);
+        }
+      for (int k=0; k<numComp; k++)
+        {
+        for (c=0, j=0; j<numIds; j++)
+          {
+          c += weights[j]*fromData->GetComponent(ids[j], k);
+          }
+        if (!isReal)
+          {
+          c = (c >= 0.0 ? c + 0.5 : c - 0.5);
+          }
+        this->SetComponent(i, k, c);
+        }
+      return;
+      }
+
     switch (fromData->GetDataType())
       {
     case VTK_BIT:
@@ -388,6 +430,30 @@ void vtkDataArray::InterpolateTuple(vtkIdType i,
   double c;
   vtkIdType loc = i * numComp;
 
+  // Go through the components when the values are not interleaved,
+  // rounding integer types as the interpolation of several tuples does.
+  if (!this->HasStandardMemoryLayout() ||
+      !fromData1->HasStandardMemoryLayout() ||
+      !fromData2->HasStandardMemoryLayout())
+    {
+    int isReal = (type == VTK_FLOAT || type == VTK_DOUBLE);
+    if (i >= this->GetNumberOfTuples())
+      {
+      this->InsertComponent(i, numComp-1, 0.0);
+      }
+    for (k=0; k<numComp; k++)
+      {
+      c = (1.0 - t) * fromData1->GetComponent(id1, k) +
+        t * fromData2->GetComponent(id2, k);
+      if (!isReal)
+        {
+        c = (c >= 0.0 ? c + 0.5 : c - 0.5);
+        }
+      this->SetComponent(i, k, c);
+      }
+    return;
+    }
+
   switch (fromData1->GetDataType())
     {
     case VTK_BIT:
@@ -818,6 +884,20 @@ void vtkDataArray::GetTuples(vtkIdList *ptIds, vtkAbstractArray *aa)
     }
 
   
+  // Go through the tuples when the values are not interleaved.
+  if (!this->HasStandardMemoryLayout() || !da->HasStandardMemoryLayout())
+    {
+    double *tuple = new double[this->NumberOfComponents];
+    vtkIdType num=ptIds->GetNumberOfIds();
+    for (vtkIdType i=0; i<num; i++)
+      {
+      this->GetTuple(ptIds->GetId(i), tuple);
+      da->SetTuple(i, tuple);
+      }
+    delete [] tuple;
+    return;
+    }
+
   switch (this->GetDataType())
     {
     vtkTemplateMacro(vtkCopyTuples1 (static_cast<VTK_TT *>(this->GetVoidPointer(0)), da,
@@ -892,6 +972,20 @@ void vtkDataArray::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *aa)
     return;
     }
 
+  // Go through the tuples when the values are not interleaved.
+  if (!this->HasStandardMemoryLayout() || !da->HasStandardMemoryLayout())
+    {
+    double *tuple = new double[this->NumberOfComponents];
+    vtkIdType num=p2-p1+1;
+    for (vtkIdType i=0; i<num; i++)
+      {
+      this->GetTuple(p1+i, tuple);
+      da->SetTuple(i, tuple);
+      }
+    delete [] tuple;
+    return;
+    }
+
   switch (this->GetDataType())
     {
     vtkTemplateMacro(vtkCopyTuples1( static_cast<VTK_TT *>(this->GetVoidPointer(0)), da,
@@ -187,8 +187,9 @@ void vtkDataArrayTemplate<T>::DeepCopy(vtkDataArray* fa)
     return;
     }
 
-  // If data type does not match, do copy with conversion.
-  if(fa->GetDataType() != this->GetDataType())
+  // If data type or layout does not match, do copy with conversion.
+  if(fa->GetDataType() != this->GetDataType() ||
+     !fa->HasStandardMemoryLayout())
     {
     this->Superclass::DeepCopy(fa);
     this->DataChanged();
@@ -429,6 +430,20 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
   vtkIdType loci = i * this->NumberOfComponents;
   vtkIdType locj = j * source->GetNumberOfComponents();
 
+  // A source of the same numeric type is a vtkDataArray. Do not ask it
+  // for a pointer unless its values are interleaved.
+  if (!source->HasStandardMemoryLayout())
+    {
+    vtkDataArray* da = static_cast<vtkDataArray*>(source);
+    for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
+      {
+      this->Array[loci + cur] =
+        static_cast<T>(da->GetComponent(j, static_cast<int>(cur)));
+      }
+    this->DataChanged();
+    return;
+    }
+
   T* data = static_cast<T*>(source->GetVoidPointer(0));
   
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
@@ -470,10 +485,21 @@ void vtkDataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
   vtkIdType locIn = j * inNumComp;
 
   T* outPtr = this->GetPointer(locOut);
-  T* inPtr = static_cast<T*>(source->GetVoidPointer(locIn));
+  if (!source->HasStandardMemoryLayout())
+    {
+    vtkDataArray* da = static_cast<vtkDataArray*>(source);
+    for (int cur = 0; cur < inNumComp; cur++)
+      {
+      outPtr[cur] = static_cast<T>(da->GetComponent(j, cur));
+      }
+    }
+  else
+    {
+    T* inPtr = static_cast<T*>(source->GetVoidPointer(locIn));
 
-  size_t s=static_cast<size_t>(inNumComp);
-  memcpy(outPtr, inPtr, s*sizeof(T));
+    size_t s=static_cast<size_t>(inNumComp);
+    memcpy(outPtr, inPtr, s*sizeof(T));
+    }
 
   vtkIdType maxId = maxSize-1;
   if ( maxId > this->MaxId )
@@ -513,6 +539,16 @@ vtkIdType vtkDataArrayTemplate<T>::InsertNextTuple(vtkIdType j,
       }
     }
 
+  if (!source->HasStandardMemoryLayout())
+    {
+    vtkDataArray* da = static_cast<vtkDataArray*>(source);
+    for (int cur = 0; cur < this->NumberOfComponents; cur++)
+      {
+      this->InsertNextValue(static_cast<T>(da->GetComponent(j, cur)));
+      }
+    return (this->GetNumberOfTuples()-1);
+    }
+
   T* data = static_cast<T*>(source->GetVoidPointer(0));
   vtkIdType locj = j * source->GetNumberOfComponents();
   
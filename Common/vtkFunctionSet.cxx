@@ -22,6 +22,33 @@ vtkFunctionSet::vtkFunctionSet()
   this->NumIndepVars = 0;
 }
 
+vtkIdType vtkFunctionSet::BatchFunctionValues(vtkIdType n, double** x,
+                                              double** f, int* valid)
+{
+  int numVars = this->GetNumberOfIndependentVariables();
+  int numFuncs = this->GetNumberOfFunctions();
+  double* xp = new double[numVars];
+  double* fp = new double[numFuncs];
+  vtkIdType numValid = 0;
+  int i;
+  for (vtkIdType p=0; p < n; p++)
+    {
+    for (i=0; i < numVars; i++)
+      {
+      xp[i] = x[i][p];
+      }
+    valid[p] = (this->FunctionValues(xp, fp) ? 1 : 0);
+    numValid += valid[p];
+    for (i=0; i < numFuncs; i++)
+      {
+      f[i][p] = (valid[p] ? fp[i] : 0.0);
+      }
+    }
+  delete [] xp;
+  delete [] fp;
+  return numValid;
+}
+
 void vtkFunctionSet::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
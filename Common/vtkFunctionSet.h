@@ -41,6 +41,18 @@ public:
   // GetNumberOfIndependentVariables.
   virtual int FunctionValues(double* x, double* f) = 0;
 
+  // Description:
+  // Evaluate the functions at n points at once. The points are stored by
+  // variable ("structure of arrays"): x[j][p] is the independent variable
+  // j of point p, and f[i][p] receives the function i at point p. valid[p]
+  // is set to 1 where the functions could be evaluated, otherwise to 0 and
+  // f[i][p] to 0. Return the number of valid points.
+  // The default implementation calls FunctionValues() for each point.
+  // Subclasses that can evaluate the points together, in loops that the
+  // compiler vectorizes, should override it.
+  virtual vtkIdType BatchFunctionValues(vtkIdType n, double** x, double** f,
+                                        int* valid);
+
   // Description:
   // Return the number of functions. Note that this is constant for 
   // a given type of set of functions and can not be changed at 
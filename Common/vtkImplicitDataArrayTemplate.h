@@ -0,0 +1,295 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImplicitDataArrayTemplate - Implementation template for a vtkDataArray computing its values on demand.
+// .SECTION Description
+// vtkImplicitDataArrayTemplate does not store its values: they are
+// computed when they are asked for by a backend, a functor deriving from
+// vtkImplicitArrayBackend that returns value idx (component
+// idx % NumberOfComponents of tuple idx / NumberOfComponents). This
+// avoids allocating arrays that are derived from other data. The
+// following backends are provided:
+//
+// - vtkImplicitConstantBackend: every value is the same, see
+//   SetConstantValue().
+// - vtkImplicitAffineBackend: values are slope * x + intercept, where x
+//   is the index of the value or a value of another array, see
+//   SetAffineValues() and SetAffineTransform().
+// - vtkImplicitIndexedBackend: tuple i is tuple indices[i] of another
+//   array, see SetIndexedView().
+//
+// Any other functor can be given to SetBackend(). GetTuple(),
+// GetComponent() and the range computation go through the backend, and
+// so do the vtkDataArray and vtkDataArrayTemplate methods copying or
+// interpolating tuples from other arrays, since HasStandardMemoryLayout()
+// returns 0. Filters therefore use these arrays without allocating memory.
+// GetTuple(i, tuple) and GetComponent() can be called concurrently when
+// the backend can.
+//
+// .SECTION Caveats
+// Modifying the array, GetVoidPointer() and WriteVoidPointer() materialize
+// it: the values are computed once into an ordinary buffer and the array
+// behaves as a vtkDataArrayTemplate from then on. Materializing is
+// serialized by a lock, so concurrent GetVoidPointer() calls compute the
+// values only once. This keeps filters that copy the structure of their
+// input arrays (vtkDataSetAttributes::CopyAllocate()) working, but code
+// that needs performance should check HasStandardMemoryLayout() and use
+// the tuple API or NewIterator(), which do not materialize the array.
+//
+// .SECTION See Also
+// vtkImplicitFloatArray vtkImplicitDoubleArray vtkSOADataArrayTemplate
+
+#ifndef __vtkImplicitDataArrayTemplate_h
+#define __vtkImplicitDataArrayTemplate_h
+
+#include "vtkDataArray.h"
+
+class vtkIdTypeArray;
+class vtkSimpleCriticalSection;
+template <class T> class vtkDataArrayTemplate;
+
+//BTX
+// Compute the values of a vtkImplicitDataArrayTemplate. GetValue() is
+// called concurrently when filters run in parallel and must not modify
+// the backend.
+template <class T>
+class vtkImplicitArrayBackend
+{
+public:
+  virtual ~vtkImplicitArrayBackend() {}
+
+  // Return value idx of an array with numComp components.
+  virtual T GetValue(vtkIdType idx, int numComp) = 0;
+};
+
+// Every value is Value.
+template <class T>
+class vtkImplicitConstantBackend : public vtkImplicitArrayBackend<T>
+{
+public:
+  vtkImplicitConstantBackend(T value) : Value(value) {}
+  virtual T GetValue(vtkIdType, int) { return this->Value; }
+
+  T Value;
+};
+
+// Value idx is Slope * x + Intercept where x is idx, or value idx of
+// Source if there is one.
+template <class T>
+class vtkImplicitAffineBackend : public vtkImplicitArrayBackend<T>
+{
+public:
+  vtkImplicitAffineBackend(double slope, double intercept,
+                           vtkDataArray *source);
+  virtual ~vtkImplicitAffineBackend();
+  virtual T GetValue(vtkIdType idx, int numComp);
+
+  double Slope;
+  double Intercept;
+  vtkDataArray *Source;
+};
+
+// Tuple i is tuple Indices[i] of Source.
+template <class T>
+class vtkImplicitIndexedBackend : public vtkImplicitArrayBackend<T>
+{
+public:
+  vtkImplicitIndexedBackend(vtkDataArray *source, vtkIdTypeArray *indices);
+  virtual ~vtkImplicitIndexedBackend();
+  virtual T GetValue(vtkIdType idx, int numComp);
+
+  vtkDataArray *Source;
+  vtkIdTypeArray *Indices;
+};
+//ETX
+
+template <class T>
+class vtkImplicitDataArrayTemplate: public vtkDataArray
+{
+public:
+  typedef vtkDataArray Superclass;
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Compute the values with the given backend. The array takes ownership
+  // of the backend and has numTuples tuples. Set the number of components
+  // first.
+  void SetBackend(vtkImplicitArrayBackend<T> *backend, vtkIdType numTuples);
+  vtkImplicitArrayBackend<T> *GetBackend() { return this->Backend; }
+
+  // Description:
+  // Make the array numTuples tuples of the given value.
+  void SetConstantValue(double value, vtkIdType numTuples);
+
+  // Description:
+  // Make value idx of the array slope * idx + intercept, e.g. the
+  // coordinates along one axis of a uniform grid.
+  void SetAffineValues(double slope, double intercept, vtkIdType numTuples);
+
+  // Description:
+  // Make the array slope * source + intercept. The array has the size and
+  // number of components of source, and keeps a reference to it.
+  void SetAffineTransform(vtkDataArray *source, double slope,
+                          double intercept);
+
+  // Description:
+  // Make tuple i of the array tuple indices[i] of source. The array has
+  // the number of components of source, and keeps references to both
+  // arrays.
+  void SetIndexedView(vtkDataArray *source, vtkIdTypeArray *indices);
+
+  // Description:
+  // Compute the values into an ordinary buffer. Does nothing if the array
+  // is already materialized. Thread safe.
+  void Materialize();
+
+  // Description:
+  // Return 0 while the values are computed by a backend.
+  virtual int HasStandardMemoryLayout()
+    { return this->Storage != 0 || this->Backend == 0; }
+
+  // Description:
+  // Return the data type and its size.
+  int GetDataType();
+  int GetDataTypeSize() { return static_cast<int>(sizeof(T)); }
+
+  // Description:
+  // Methods reading the values. They go through the backend if there is
+  // one.
+  double* GetTuple(vtkIdType i);
+  void GetTuple(vtkIdType i, double* tuple);
+  double GetComponent(vtkIdType i, int j);
+  T GetValue(vtkIdType id);
+  void GetTupleValue(vtkIdType i, T* tuple);
+  virtual vtkIdType LookupValue(vtkVariant value);
+  virtual void LookupValue(vtkVariant value, vtkIdList* ids);
+  vtkIdType LookupValue(T value);
+  void LookupValue(T value, vtkIdList* ids);
+
+  // Description:
+  // Return a pointer to the values; materializes the array.
+  virtual void* GetVoidPointer(vtkIdType id);
+  T* GetPointer(vtkIdType id)
+    { return static_cast<T*>(this->GetVoidPointer(id)); }
+
+  // Description:
+  // Methods modifying the array. They materialize it first.
+  int Allocate(vtkIdType sz, vtkIdType ext=1000);
+  void Initialize();
+  void SetNumberOfTuples(vtkIdType number);
+  virtual void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  virtual void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  virtual vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray* source);
+  void SetTuple(vtkIdType i, const float* tuple);
+  void SetTuple(vtkIdType i, const double* tuple);
+  void InsertTuple(vtkIdType i, const float* tuple);
+  void InsertTuple(vtkIdType i, const double* tuple);
+  vtkIdType InsertNextTuple(const float* tuple);
+  vtkIdType InsertNextTuple(const double* tuple);
+  void SetComponent(vtkIdType i, int j, double c);
+  void InsertComponent(vtkIdType i, int j, double c);
+  void SetValue(vtkIdType id, T value);
+  void SetNumberOfValues(vtkIdType number);
+  void InsertValue(vtkIdType id, T f);
+  void InsertVariantValue(vtkIdType id, vtkVariant value);
+  vtkIdType InsertNextValue(T f);
+  virtual void RemoveTuple(vtkIdType id);
+  virtual void RemoveFirstTuple();
+  virtual void RemoveLastTuple();
+  void Squeeze();
+  virtual int Resize(vtkIdType numTuples);
+  virtual void* WriteVoidPointer(vtkIdType id, vtkIdType number);
+  virtual void SetVoidArray(void* array, vtkIdType size, int save);
+
+  // Description:
+  // Deep copy of another array. The values are copied, not the backend.
+  void DeepCopy(vtkDataArray* da);
+  void DeepCopy(vtkAbstractArray* aa)
+    { this->Superclass::DeepCopy(aa); }
+
+  // Description:
+  // Copy the values to the given pointer.
+  virtual void ExportToVoidPointer(void *out_ptr);
+
+  // Description:
+  // Returns a vtkArrayIteratorTemplate<T>. While the values are computed
+  // by a backend, the iterator reads them through GetValue() and does not
+  // materialize the array; writing through it is then not supported.
+  virtual vtkArrayIterator* NewIterator();
+
+  virtual void DataChanged();
+  virtual void ClearLookup();
+
+  // Description:
+  // Return the memory in kilobytes allocated by the array.
+  virtual unsigned long GetActualMemorySize();
+
+protected:
+  vtkImplicitDataArrayTemplate(vtkIdType numComp);
+  ~vtkImplicitDataArrayTemplate();
+
+  // The backend is kept once the array is materialized, since readers
+  // may still be using it; it is released with the values.
+  vtkImplicitArrayBackend<T> *Backend;
+
+  // Values once the array is materialized.
+  vtkDataArrayTemplate<T> *Storage;
+  vtkSimpleCriticalSection *MaterializeLock;
+
+  int TupleSize; //used for data conversion
+  double* Tuple;
+
+  // Release the backend and storage.
+  void ReleaseData();
+
+  // Update MaxId and Size after the storage was modified.
+  void UpdateFromStorage();
+
+  // Release the backend, e.g. before new values are allocated.
+  void DeleteBackend();
+
+  // Used by NewIterator().
+  static T GetIteratorValue(vtkAbstractArray* array, vtkIdType id);
+
+private:
+  vtkImplicitDataArrayTemplate(const vtkImplicitDataArrayTemplate&);  // Not implemented.
+  void operator=(const vtkImplicitDataArrayTemplate&);  // Not implemented.
+};
+
+#if !defined(VTK_NO_EXPLICIT_TEMPLATE_INSTANTIATION)
+# define VTK_IMPLICIT_DATA_ARRAY_TEMPLATE_INSTANTIATE(T) \
+   template class VTK_COMMON_EXPORT vtkImplicitDataArrayTemplate< T >
+#else
+# include "vtkImplicitDataArrayTemplateImplicit.txx"
+# define VTK_IMPLICIT_DATA_ARRAY_TEMPLATE_INSTANTIATE(T)
+#endif
+
+#endif // !defined(__vtkImplicitDataArrayTemplate_h)
+
+// This portion must be OUTSIDE the include blockers.  Each
+// vtkImplicitDataArrayTemplate subclass uses this to give its
+// instantiation of this template a DLL interface.
+#if defined(VTK_IMPLICIT_DATA_ARRAY_TEMPLATE_TYPE)
+# if defined(VTK_BUILD_SHARED_LIBS) && defined(_MSC_VER)
+#  pragma warning (push)
+#  pragma warning (disable: 4091) // warning C4091: 'extern ' :
+   // ignored on left of 'int' when no variable is declared
+#  pragma warning (disable: 4231) // Compiler-specific extension warning.
+#  pragma warning (disable: 4910) // extern and dllexport incompatible
+   // See vtkDataArrayTemplate.h.
+   extern VTK_IMPLICIT_DATA_ARRAY_TEMPLATE_INSTANTIATE(VTK_IMPLICIT_DATA_ARRAY_TEMPLATE_TYPE);
+#  pragma warning (pop)
+# endif
+# undef VTK_IMPLICIT_DATA_ARRAY_TEMPLATE_TYPE
+#endif
@@ -0,0 +1,766 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#ifndef __vtkImplicitDataArrayTemplate_txx
+#define __vtkImplicitDataArrayTemplate_txx
+
+#include "vtkImplicitDataArrayTemplate.h"
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkCriticalSection.h"
+#include "vtkDataArrayTemplate.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkTypeTraits.h"
+
+// We do not provide a definition for the copy constructor or
+// operator=.  Block the warning.
+#ifdef _MSC_VER
+# pragma warning (disable: 4661)
+#endif
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitAffineBackend<T>::vtkImplicitAffineBackend(double slope,
+                                                      double intercept,
+                                                      vtkDataArray *source)
+{
+  this->Slope = slope;
+  this->Intercept = intercept;
+  this->Source = source;
+  if (this->Source)
+    {
+    this->Source->Register(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitAffineBackend<T>::~vtkImplicitAffineBackend()
+{
+  if (this->Source)
+    {
+    this->Source->UnRegister(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T vtkImplicitAffineBackend<T>::GetValue(vtkIdType idx, int numComp)
+{
+  double x = static_cast<double>(idx);
+  if (this->Source)
+    {
+    x = this->Source->GetComponent(idx / numComp,
+                                   static_cast<int>(idx % numComp));
+    }
+  return static_cast<T>(this->Slope * x + this->Intercept);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitIndexedBackend<T>::vtkImplicitIndexedBackend(
+  vtkDataArray *source, vtkIdTypeArray *indices)
+{
+  this->Source = source;
+  this->Source->Register(0);
+  this->Indices = indices;
+  this->Indices->Register(0);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitIndexedBackend<T>::~vtkImplicitIndexedBackend()
+{
+  this->Source->UnRegister(0);
+  this->Indices->UnRegister(0);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T vtkImplicitIndexedBackend<T>::GetValue(vtkIdType idx, int numComp)
+{
+  vtkIdType tuple = this->Indices->GetValue(idx / numComp);
+  return static_cast<T>(
+    this->Source->GetComponent(tuple, static_cast<int>(idx % numComp)));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitDataArrayTemplate<T>::vtkImplicitDataArrayTemplate(
+  vtkIdType numComp): vtkDataArray(numComp)
+{
+  this->Backend = 0;
+  this->Storage = 0;
+  this->MaterializeLock = new vtkSimpleCriticalSection;
+  this->Tuple = 0;
+  this->TupleSize = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitDataArrayTemplate<T>::~vtkImplicitDataArrayTemplate()
+{
+  this->ReleaseData();
+  delete this->MaterializeLock;
+  if (this->Tuple)
+    {
+    free(this->Tuple);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::DeleteBackend()
+{
+  if (this->Backend)
+    {
+    delete this->Backend;
+    this->Backend = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::ReleaseData()
+{
+  this->DeleteBackend();
+  if (this->Storage)
+    {
+    this->Storage->Delete();
+    this->Storage = 0;
+    }
+  this->Size = 0;
+  this->MaxId = -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::UpdateFromStorage()
+{
+  this->Size = this->Storage->GetSize();
+  this->MaxId = this->Storage->GetMaxId();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetBackend(
+  vtkImplicitArrayBackend<T> *backend, vtkIdType numTuples)
+{
+  this->ReleaseData();
+  this->Backend = backend;
+  if (backend)
+    {
+    this->Size = numTuples * this->NumberOfComponents;
+    this->MaxId = this->Size - 1;
+    }
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetConstantValue(double value,
+                                                       vtkIdType numTuples)
+{
+  this->SetBackend(
+    new vtkImplicitConstantBackend<T>(static_cast<T>(value)), numTuples);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetAffineValues(double slope,
+                                                      double intercept,
+                                                      vtkIdType numTuples)
+{
+  this->SetBackend(new vtkImplicitAffineBackend<T>(slope, intercept, 0),
+                   numTuples);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetAffineTransform(vtkDataArray *source,
+                                                         double slope,
+                                                         double intercept)
+{
+  if (!source)
+    {
+    vtkErrorMacro("No source array.");
+    return;
+    }
+  this->NumberOfComponents = source->GetNumberOfComponents();
+  this->SetBackend(new vtkImplicitAffineBackend<T>(slope, intercept, source),
+                   source->GetNumberOfTuples());
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetIndexedView(vtkDataArray *source,
+                                                     vtkIdTypeArray *indices)
+{
+  if (!source || !indices)
+    {
+    vtkErrorMacro("No source array or indices.");
+    return;
+    }
+  this->NumberOfComponents = source->GetNumberOfComponents();
+  this->SetBackend(new vtkImplicitIndexedBackend<T>(source, indices),
+                   indices->GetNumberOfTuples());
+}
+
+//----------------------------------------------------------------------------
+// The storage is filled before it is published, so readers either see no
+// storage and use the backend, or see all the values.
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::Materialize()
+{
+  this->MaterializeLock->Lock();
+  if (this->Storage)
+    {
+    this->Storage->SetNumberOfComponents(this->NumberOfComponents);
+    this->MaterializeLock->Unlock();
+    return;
+    }
+
+  vtkDataArrayTemplate<T> *storage = static_cast<vtkDataArrayTemplate<T>*>(
+    vtkDataArray::CreateDataArray(this->GetDataType()));
+  storage->SetNumberOfComponents(this->NumberOfComponents);
+  if (this->Backend)
+    {
+    vtkIdType numValues = this->MaxId + 1;
+    int numComp = this->NumberOfComponents;
+    T *values = storage->WritePointer(0, numValues);
+    for (vtkIdType idx = 0; values && idx < numValues; idx++)
+      {
+      values[idx] = this->Backend->GetValue(idx, numComp);
+      }
+    }
+  this->Storage = storage;
+  this->UpdateFromStorage();
+  this->MaterializeLock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkImplicitDataArrayTemplate<T>::GetDataType()
+{
+  return vtkTypeTraits<T>::VTKTypeID();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::PrintSelf(ostream& os,
+                                                vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Backend: " << static_cast<void*>(this->Backend) << "\n";
+  os << indent << "Materialized: " << (this->Storage ? "Yes" : "No") << "\n";
+}
+
+//----------------------------------------------------------------------------
+// Get a pointer to a tuple at the ith location. This is a dangerous method
+// (it is not thread safe since a pointer is returned).
+template <class T>
+double* vtkImplicitDataArrayTemplate<T>::GetTuple(vtkIdType i)
+{
+  if (this->TupleSize < this->NumberOfComponents)
+    {
+    this->TupleSize = this->NumberOfComponents;
+    free(this->Tuple);
+    this->Tuple = static_cast<double*>(
+      malloc(this->TupleSize * sizeof(double)));
+    }
+  this->GetTuple(i, this->Tuple);
+  return this->Tuple;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::GetTuple(vtkIdType i, double* tuple)
+{
+  vtkDataArrayTemplate<T> *storage = this->Storage;
+  if (storage)
+    {
+    storage->GetTuple(i, tuple);
+    }
+  else if (this->Backend)
+    {
+    int numComp = this->NumberOfComponents;
+    for (int j = 0; j < numComp; j++)
+      {
+      tuple[j] =
+        static_cast<double>(this->Backend->GetValue(i*numComp + j, numComp));
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double vtkImplicitDataArrayTemplate<T>::GetComponent(vtkIdType i, int j)
+{
+  return static_cast<double>(this->GetValue(i*this->NumberOfComponents + j));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T vtkImplicitDataArrayTemplate<T>::GetValue(vtkIdType id)
+{
+  vtkDataArrayTemplate<T> *storage = this->Storage;
+  if (storage)
+    {
+    return storage->GetValue(id);
+    }
+  if (this->Backend)
+    {
+    return this->Backend->GetValue(id, this->NumberOfComponents);
+    }
+  return static_cast<T>(0);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::GetTupleValue(vtkIdType i, T* tuple)
+{
+  int numComp = this->NumberOfComponents;
+  for (int j = 0; j < numComp; j++)
+    {
+    tuple[j] = this->GetValue(i*numComp + j);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitDataArrayTemplate<T>::LookupValue(vtkVariant var)
+{
+  T* dummyPtr = 0;
+  bool valid = true;
+  T value = var.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    return this->LookupValue(value);
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::LookupValue(vtkVariant var,
+                                                  vtkIdList* ids)
+{
+  T* dummyPtr = 0;
+  bool valid = true;
+  T value = var.ToNumeric(&valid, dummyPtr);
+  ids->Reset();
+  if (valid)
+    {
+    this->LookupValue(value, ids);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitDataArrayTemplate<T>::LookupValue(T value)
+{
+  if (this->Storage || !this->Backend)
+    {
+    return this->Storage ? this->Storage->LookupValue(value) : -1;
+    }
+  for (vtkIdType id = 0; id <= this->MaxId; id++)
+    {
+    if (this->Backend->GetValue(id, this->NumberOfComponents) == value)
+      {
+      return id;
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::LookupValue(T value, vtkIdList* ids)
+{
+  ids->Reset();
+  if (this->Storage || !this->Backend)
+    {
+    if (this->Storage)
+      {
+      this->Storage->LookupValue(value, ids);
+      }
+    return;
+    }
+  for (vtkIdType id = 0; id <= this->MaxId; id++)
+    {
+    if (this->Backend->GetValue(id, this->NumberOfComponents) == value)
+      {
+      ids->InsertNextId(id);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkImplicitDataArrayTemplate<T>::GetVoidPointer(vtkIdType id)
+{
+  this->Materialize();
+  return this->Storage->GetVoidPointer(id);
+}
+
+//----------------------------------------------------------------------------
+// Allocate memory for this array. The values of the backend are dropped.
+template <class T>
+int vtkImplicitDataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType ext)
+{
+  this->DeleteBackend();
+  this->Materialize();
+  int result = this->Storage->Allocate(sz, ext);
+  this->UpdateFromStorage();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::Initialize()
+{
+  this->ReleaseData();
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetNumberOfTuples(vtkIdType number)
+{
+  this->Materialize();
+  this->Storage->SetNumberOfTuples(number);
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
+                                               vtkAbstractArray* source)
+{
+  this->Materialize();
+  this->Storage->SetTuple(i, j, source);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
+                                                  vtkAbstractArray* source)
+{
+  this->Materialize();
+  this->Storage->InsertTuple(i, j, source);
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitDataArrayTemplate<T>::InsertNextTuple(
+  vtkIdType j, vtkAbstractArray* source)
+{
+  this->Materialize();
+  vtkIdType result = this->Storage->InsertNextTuple(j, source);
+  this->UpdateFromStorage();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetTuple(vtkIdType i,
+                                               const float* tuple)
+{
+  this->Materialize();
+  this->Storage->SetTuple(i, tuple);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetTuple(vtkIdType i,
+                                               const double* tuple)
+{
+  this->Materialize();
+  this->Storage->SetTuple(i, tuple);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::InsertTuple(vtkIdType i,
+                                                  const float* tuple)
+{
+  this->Materialize();
+  this->Storage->InsertTuple(i, tuple);
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::InsertTuple(vtkIdType i,
+                                                  const double* tuple)
+{
+  this->Materialize();
+  this->Storage->InsertTuple(i, tuple);
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitDataArrayTemplate<T>::InsertNextTuple(const float* tuple)
+{
+  this->Materialize();
+  vtkIdType result = this->Storage->InsertNextTuple(tuple);
+  this->UpdateFromStorage();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitDataArrayTemplate<T>::InsertNextTuple(
+  const double* tuple)
+{
+  this->Materialize();
+  vtkIdType result = this->Storage->InsertNextTuple(tuple);
+  this->UpdateFromStorage();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetComponent(vtkIdType i, int j,
+                                                   double c)
+{
+  this->Materialize();
+  this->Storage->SetComponent(i, j, c);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::InsertComponent(vtkIdType i, int j,
+                                                      double c)
+{
+  this->Materialize();
+  this->Storage->InsertComponent(i, j, c);
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetValue(vtkIdType id, T value)
+{
+  this->Materialize();
+  this->Storage->SetValue(id, value);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetNumberOfValues(vtkIdType number)
+{
+  this->Materialize();
+  this->Storage->SetNumberOfValues(number);
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::InsertValue(vtkIdType id, T f)
+{
+  this->Materialize();
+  this->Storage->InsertValue(id, f);
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::InsertVariantValue(vtkIdType id,
+                                                         vtkVariant value)
+{
+  this->Materialize();
+  this->Storage->InsertVariantValue(id, value);
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitDataArrayTemplate<T>::InsertNextValue(T f)
+{
+  this->Materialize();
+  vtkIdType result = this->Storage->InsertNextValue(f);
+  this->UpdateFromStorage();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::RemoveTuple(vtkIdType id)
+{
+  this->Materialize();
+  this->Storage->RemoveTuple(id);
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::RemoveFirstTuple()
+{
+  this->Materialize();
+  this->Storage->RemoveFirstTuple();
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::RemoveLastTuple()
+{
+  this->Materialize();
+  this->Storage->RemoveLastTuple();
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::Squeeze()
+{
+  if (this->Storage)
+    {
+    this->Storage->Squeeze();
+    this->UpdateFromStorage();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkImplicitDataArrayTemplate<T>::Resize(vtkIdType numTuples)
+{
+  this->Materialize();
+  int result = this->Storage->Resize(numTuples);
+  this->UpdateFromStorage();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkImplicitDataArrayTemplate<T>::WriteVoidPointer(vtkIdType id,
+                                                        vtkIdType number)
+{
+  this->Materialize();
+  void *result = this->Storage->WriteVoidPointer(id, number);
+  this->UpdateFromStorage();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetVoidArray(void* array,
+                                                   vtkIdType size, int save)
+{
+  this->DeleteBackend();
+  this->Materialize();
+  this->Storage->SetVoidArray(array, size, save);
+  this->UpdateFromStorage();
+}
+
+//----------------------------------------------------------------------------
+// Deep copy of another array.
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::DeepCopy(vtkDataArray* da)
+{
+  // Do nothing on a NULL input, avoid self-copy.
+  if (!da || da == this)
+    {
+    return;
+    }
+
+  this->ReleaseData();
+  this->NumberOfComponents = da->GetNumberOfComponents();
+  this->Materialize();
+  this->Storage->DeepCopy(da);
+  this->UpdateFromStorage();
+  this->vtkAbstractArray::DeepCopy(da);
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::ExportToVoidPointer(void *out_ptr)
+{
+  if (!out_ptr)
+    {
+    return;
+    }
+  if (this->Storage)
+    {
+    this->Storage->ExportToVoidPointer(out_ptr);
+    }
+  else if (this->Backend)
+    {
+    T *out = static_cast<T*>(out_ptr);
+    for (vtkIdType idx = 0; idx <= this->MaxId; idx++)
+      {
+      out[idx] = this->Backend->GetValue(idx, this->NumberOfComponents);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T vtkImplicitDataArrayTemplate<T>::GetIteratorValue(vtkAbstractArray* array,
+                                                    vtkIdType id)
+{
+  return static_cast<vtkImplicitDataArrayTemplate<T>*>(array)->GetValue(id);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkArrayIterator* vtkImplicitDataArrayTemplate<T>::NewIterator()
+{
+  vtkArrayIteratorTemplate<T>* iter = vtkArrayIteratorTemplate<T>::New();
+  if (this->Storage || !this->Backend)
+    {
+    this->Materialize();
+    iter->Initialize(this);
+    }
+  else
+    {
+    iter->InitializeValueFunction(this,
+      &vtkImplicitDataArrayTemplate<T>::GetIteratorValue);
+    }
+  return iter;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::DataChanged()
+{
+  if (this->Storage)
+    {
+    this->Storage->DataChanged();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::ClearLookup()
+{
+  if (this->Storage)
+    {
+    this->Storage->ClearLookup();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+unsigned long vtkImplicitDataArrayTemplate<T>::GetActualMemorySize()
+{
+  return this->Storage ? this->Storage->GetActualMemorySize() : 0;
+}
+
+#endif
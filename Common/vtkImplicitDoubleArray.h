@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImplicitDoubleArray - array of double computing its values on demand
+// .SECTION Description
+// vtkImplicitDoubleArray is an array of values of type double that are
+// computed when they are asked for instead of being stored: constant
+// values, affine functions of the index or of another array, or a view of
+// selected tuples of another array. See vtkImplicitDataArrayTemplate.
+// .SECTION See Also
+// vtkDoubleArray vtkImplicitDataArrayTemplate
+
+#ifndef __vtkImplicitDoubleArray_h
+#define __vtkImplicitDoubleArray_h
+
+// Tell the template header how to give our superclass a DLL interface.
+#if !defined(__vtkImplicitDoubleArray_cxx)
+# define VTK_IMPLICIT_DATA_ARRAY_TEMPLATE_TYPE double
+#endif
+
+#include "vtkDataArray.h"
+#include "vtkImplicitDataArrayTemplate.h" // Real Superclass
+
+// Fake the superclass for the wrappers.
+#define vtkDataArray vtkImplicitDataArrayTemplate<double>
+class VTK_COMMON_EXPORT vtkImplicitDoubleArray : public vtkDataArray
+#undef vtkDataArray
+{
+public:
+  static vtkImplicitDoubleArray* New();
+  vtkTypeRevisionMacro(vtkImplicitDoubleArray,vtkDataArray);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get the data type.
+  int GetDataType()
+    { return VTK_DOUBLE; }
+
+  // Description:
+  // Make the array numTuples tuples of the given value.
+  void SetConstantValue(double value, vtkIdType numTuples)
+    { this->RealSuperclass::SetConstantValue(value, numTuples); }
+
+  // Description:
+  // Make value idx of the array slope * idx + intercept.
+  void SetAffineValues(double slope, double intercept, vtkIdType numTuples)
+    { this->RealSuperclass::SetAffineValues(slope, intercept, numTuples); }
+
+  // Description:
+  // Make the array slope * source + intercept.
+  void SetAffineTransform(vtkDataArray *source, double slope,
+                          double intercept)
+    { this->RealSuperclass::SetAffineTransform(source, slope, intercept); }
+
+  // Description:
+  // Make tuple i of the array tuple indices[i] of source.
+  void SetIndexedView(vtkDataArray *source, vtkIdTypeArray *indices)
+    { this->RealSuperclass::SetIndexedView(source, indices); }
+
+  // Description:
+  // Compute the values into an ordinary buffer and release the backend.
+  void Materialize()
+    { this->RealSuperclass::Materialize(); }
+
+  // Description:
+  // Copy the tuple value into a user-provided array.
+  void GetTupleValue(vtkIdType i, double* tuple)
+    { this->RealSuperclass::GetTupleValue(i, tuple); }
+
+  // Description:
+  // Get the data at a particular index.
+  double GetValue(vtkIdType id)
+    { return this->RealSuperclass::GetValue(id); }
+
+  // Description:
+  // Set the data at a particular index. Materializes the array.
+  void SetValue(vtkIdType id, double value)
+    { this->RealSuperclass::SetValue(id, value); }
+
+  // Description:
+  // Insert data at a specified position in the array.
+  void InsertValue(vtkIdType id, double f)
+    { this->RealSuperclass::InsertValue(id, f); }
+
+  // Description:
+  // Insert data at the end of the array. Return its location in the array.
+  vtkIdType InsertNextValue(double f)
+    { return this->RealSuperclass::InsertNextValue(f); }
+
+  // Description:
+  // Get the address of a particular data index. Materializes the array.
+  double* GetPointer(vtkIdType id)
+    { return this->RealSuperclass::GetPointer(id); }
+
+protected:
+  vtkImplicitDoubleArray(vtkIdType numComp=1);
+  ~vtkImplicitDoubleArray();
+
+private:
+  //BTX
+  typedef vtkImplicitDataArrayTemplate<double> RealSuperclass;
+  //ETX
+  vtkImplicitDoubleArray(const vtkImplicitDoubleArray&);  // Not implemented.
+  void operator=(const vtkImplicitDoubleArray&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,42 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Instantiate superclass first to give the template a DLL interface.
+#include "vtkImplicitDataArrayTemplate.txx"
+VTK_IMPLICIT_DATA_ARRAY_TEMPLATE_INSTANTIATE(float);
+
+#define __vtkImplicitFloatArray_cxx
+#include "vtkImplicitFloatArray.h"
+
+#include "vtkObjectFactory.h"
+
+//----------------------------------------------------------------------------
+vtkCxxRevisionMacro(vtkImplicitFloatArray, "$Revision$");
+vtkStandardNewMacro(vtkImplicitFloatArray);
+
+//----------------------------------------------------------------------------
+vtkImplicitFloatArray::vtkImplicitFloatArray(vtkIdType numComp): RealSuperclass(numComp)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkImplicitFloatArray::~vtkImplicitFloatArray()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkImplicitFloatArray::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->RealSuperclass::PrintSelf(os,indent);
+}
@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImplicitFloatArray - array of float computing its values on demand
+// .SECTION Description
+// vtkImplicitFloatArray is an array of values of type float that are
+// computed when they are asked for instead of being stored: constant
+// values, affine functions of the index or of another array, or a view of
+// selected tuples of another array. See vtkImplicitDataArrayTemplate.
+// .SECTION See Also
+// vtkFloatArray vtkImplicitDataArrayTemplate
+
+#ifndef __vtkImplicitFloatArray_h
+#define __vtkImplicitFloatArray_h
+
+// Tell the template header how to give our superclass a DLL interface.
+#if !defined(__vtkImplicitFloatArray_cxx)
+# define VTK_IMPLICIT_DATA_ARRAY_TEMPLATE_TYPE float
+#endif
+
+#include "vtkDataArray.h"
+#include "vtkImplicitDataArrayTemplate.h" // Real Superclass
+
+// Fake the superclass for the wrappers.
+#define vtkDataArray vtkImplicitDataArrayTemplate<float>
+class VTK_COMMON_EXPORT vtkImplicitFloatArray : public vtkDataArray
+#undef vtkDataArray
+{
+public:
+  static vtkImplicitFloatArray* New();
+  vtkTypeRevisionMacro(vtkImplicitFloatArray,vtkDataArray);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get the data type.
+  int GetDataType()
+    { return VTK_FLOAT; }
+
+  // Description:
+  // Make the array numTuples tuples of the given value.
+  void SetConstantValue(double value, vtkIdType numTuples)
+    { this->RealSuperclass::SetConstantValue(value, numTuples); }
+
+  // Description:
+  // Make value idx of the array slope * idx + intercept.
+  void SetAffineValues(double slope, double intercept, vtkIdType numTuples)
+    { this->RealSuperclass::SetAffineValues(slope, intercept, numTuples); }
+
+  // Description:
+  // Make the array slope * source + intercept.
+  void SetAffineTransform(vtkDataArray *source, double slope,
+                          double intercept)
+    { this->RealSuperclass::SetAffineTransform(source, slope, intercept); }
+
+  // Description:
+  // Make tuple i of the array tuple indices[i] of source.
+  void SetIndexedView(vtkDataArray *source, vtkIdTypeArray *indices)
+    { this->RealSuperclass::SetIndexedView(source, indices); }
+
+  // Description:
+  // Compute the values into an ordinary buffer and release the backend.
+  void Materialize()
+    { this->RealSuperclass::Materialize(); }
+
+  // Description:
+  // Copy the tuple value into a user-provided array.
+  void GetTupleValue(vtkIdType i, float* tuple)
+    { this->RealSuperclass::GetTupleValue(i, tuple); }
+
+  // Description:
+  // Get the data at a particular index.
+  float GetValue(vtkIdType id)
+    { return this->RealSuperclass::GetValue(id); }
+
+  // Description:
+  // Set the data at a particular index. Materializes the array.
+  void SetValue(vtkIdType id, float value)
+    { this->RealSuperclass::SetValue(id, value); }
+
+  // Description:
+  // Insert data at a specified position in the array.
+  void InsertValue(vtkIdType id, float f)
+    { this->RealSuperclass::InsertValue(id, f); }
+
+  // Description:
+  // Insert data at the end of the array. Return its location in the array.
+  vtkIdType InsertNextValue(float f)
+    { return this->RealSuperclass::InsertNextValue(f); }
+
+  // Description:
+  // Get the address of a particular data index. Materializes the array.
+  float* GetPointer(vtkIdType id)
+    { return this->RealSuperclass::GetPointer(id); }
+
+protected:
+  vtkImplicitFloatArray(vtkIdType numComp=1);
+  ~vtkImplicitFloatArray();
+
+private:
+  //BTX
+  typedef vtkImplicitDataArrayTemplate<float> RealSuperclass;
+  //ETX
+  vtkImplicitFloatArray(const vtkImplicitFloatArray&);  // Not implemented.
+  void operator=(const vtkImplicitFloatArray&);  // Not implemented.
+};
+
+#endif
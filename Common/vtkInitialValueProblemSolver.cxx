@@ -16,6 +16,8 @@
 
 #include "vtkFunctionSet.h"
 
+#include <math.h>
+
 vtkCxxRevisionMacro(vtkInitialValueProblemSolver, "$Revision$");
 
 vtkInitialValueProblemSolver::vtkInitialValueProblemSolver() 
@@ -25,6 +27,12 @@ vtkInitialValueProblemSolver::vtkInitialValueProblemSolver()
   this->Derivs = 0;
   this->Initialized = 0;
   this->Adaptive = 0;
+  this->BatchValues = 0;
+  this->BatchValuesSize = 0;
+  this->BatchRows = 0;
+  this->BatchRowsSize = 0;
+  this->BatchValid = 0;
+  this->BatchValidSize = 0;
 }
 
 vtkInitialValueProblemSolver::~vtkInitialValueProblemSolver() 
@@ -35,6 +43,9 @@ vtkInitialValueProblemSolver::~vtkInitialValueProblemSolver()
   delete[] this->Derivs;
   this->Derivs = 0;
   this->Initialized = 0;
+  delete[] this->BatchValues;
+  delete[] this->BatchRows;
+  delete[] this->BatchValid;
 }
 
 void vtkInitialValueProblemSolver::SetFunctionSet(vtkFunctionSet* fset)
@@ -56,6 +67,96 @@ void vtkInitialValueProblemSolver::SetFunctionSet(vtkFunctionSet* fset)
   this->Initialize();
 }
 
+int vtkInitialValueProblemSolver::ComputeNextSteps(vtkIdType n,
+                                                   double** xprev,
+                                                   double** xnext, double t,
+                                                   double delT, double* error,
+                                                   int* status)
+{
+  if (!this->FunctionSet || !this->Initialized)
+    {
+    vtkErrorMacro("Integrator not initialized!");
+    return NOT_INITIALIZED;
+    }
+
+  int i, numDerivs = this->FunctionSet->GetNumberOfFunctions();
+  double* xp = new double[2*numDerivs];
+  double* xn = xp + numDerivs;
+  double absDelT = fabs(delT);
+  for (vtkIdType p=0; p < n; p++)
+    {
+    for (i=0; i < numDerivs; i++)
+      {
+      xp[i] = xn[i] = xprev[i][p];
+      }
+    // Equal minimum and maximum steps disable the step size control.
+    double step = delT, delTActual, err = 0.0;
+    status[p] = this->ComputeNextStep(xp, 0, xn, t, step, delTActual,
+                                      absDelT, absDelT, 0.0, err);
+    for (i=0; i < numDerivs; i++)
+      {
+      xnext[i][p] = xn[i];
+      }
+    if (error)
+      {
+      error[p] = err;
+      }
+    }
+  delete[] xp;
+  return 0;
+}
+
+double** vtkInitialValueProblemSolver::AllocateBatch(vtkIdType n,
+                                                     int numRows)
+{
+  if (this->BatchValuesSize < n*numRows)
+    {
+    delete[] this->BatchValues;
+    this->BatchValuesSize = n*numRows;
+    this->BatchValues = new double[this->BatchValuesSize];
+    }
+  if (this->BatchRowsSize < numRows)
+    {
+    delete[] this->BatchRows;
+    this->BatchRowsSize = numRows;
+    this->BatchRows = new double*[numRows];
+    }
+  for (int i=0; i < numRows; i++)
+    {
+    this->BatchRows[i] = this->BatchValues + i*n;
+    }
+  return this->BatchRows;
+}
+
+void vtkInitialValueProblemSolver::EvaluateBatch(vtkIdType n, double** vals,
+                                                 double** derivs,
+                                                 double** xnext, int* status)
+{
+  if (this->BatchValidSize < n)
+    {
+    delete[] this->BatchValid;
+    this->BatchValidSize = n;
+    this->BatchValid = new int[n];
+    }
+  int* valid = this->BatchValid;
+  if (this->FunctionSet->BatchFunctionValues(n, vals, derivs, valid) == n)
+    {
+    return;
+    }
+  int i, numDerivs = this->FunctionSet->GetNumberOfFunctions();
+  for (vtkIdType p=0; p < n; p++)
+    {
+    if (!valid[p] && !status[p])
+      {
+      status[p] = OUT_OF_DOMAIN;
+      for (i=0; i < numDerivs; i++)
+        {
+        xnext[i][p] = vals[i][p];
+        }
+      }
+    }
+}
+
 void vtkInitialValueProblemSolver::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
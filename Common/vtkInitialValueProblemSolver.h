@@ -92,6 +92,26 @@ public:
                               double minStep, double maxStep, 
                               double maxError, double& error) = 0;
 
+  // Description:
+  // Advance n particles from t to t+delT at once. The particles are stored
+  // by variable ("structure of arrays"), e.g. in the component buffers of
+  // a vtkSOADoubleArray: xprev[i][p] is the value i of particle p, and
+  // xnext[i][p] receives it at t+delT. All the particles take the same
+  // step delT: adaptive solvers do not control the step size here, but
+  // return the estimated error of each particle in error so that the
+  // caller can repeat the steps that are not accurate enough. The other
+  // solvers set error to 0. error may be NULL. status[p] receives 0 or
+  // the error code of particle p (see ComputeNextStep()); xnext is not a
+  // valid step for the particles whose status is not 0.
+  // This method returns NOT_INITIALIZED when the solver has no function
+  // set, 0 otherwise.
+  // The default implementation calls ComputeNextStep() for each particle.
+  // vtkRungeKutta2, vtkRungeKutta4 and vtkRungeKutta45 evaluate each stage
+  // for all the particles with vtkFunctionSet::BatchFunctionValues().
+  virtual int ComputeNextSteps(vtkIdType n, double** xprev, double** xnext,
+                               double t, double delT, double* error,
+                               int* status);
+
   // Description:
   // Set / get the dataset used for the implicit function evaluation.
   virtual void SetFunctionSet(vtkFunctionSet* functionset);
@@ -117,6 +137,15 @@ protected:
 
   virtual void Initialize();
 
+  // Helpers of the batched steps. AllocateBatch() returns numRows rows of
+  // n values, valid until the next call. EvaluateBatch() evaluates the
+  // function set at the points vals (the time is the last row) into
+  // derivs. The particles that leave the domain for the first time get
+  // the OUT_OF_DOMAIN status, and the point of the evaluation in xnext.
+  double** AllocateBatch(vtkIdType n, int numRows);
+  void EvaluateBatch(vtkIdType n, double** vals, double** derivs,
+                     double** xnext, int* status);
+
   vtkFunctionSet* FunctionSet;
 
   double* Vals;
@@ -124,6 +153,13 @@ protected:
   int Initialized;
   int Adaptive;
 
+  double* BatchValues;
+  vtkIdType BatchValuesSize;
+  double** BatchRows;
+  int BatchRowsSize;
+  int* BatchValid;
+  vtkIdType BatchValidSize;
+
 private:
   vtkInitialValueProblemSolver(const vtkInitialValueProblemSolver&);  // Not implemented.
   void operator=(const vtkInitialValueProblemSolver&);  // Not implemented.
@@ -18,6 +18,7 @@
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 
 vtkCxxRevisionMacro(vtkLinearTransform, "$Revision$");
 
@@ -176,6 +177,75 @@ void vtkLinearTransform::TransformPointsNormalsVectors(vtkPoints *inPts,
     }
 }
 
+//----------------------------------------------------------------------------
+// Transform tuples [begin, end) of Input as points, vectors or normals and
+// store them at the same index plus Offset in the pre-sized Output.
+// Several threads may run on disjoint ranges.
+class vtkLinearTransformFunctor
+{
+public:
+  enum { POINTS, VECTORS, NORMALS };
+
+  int Mode;
+  double (*Matrix)[4];
+  vtkDataArray *Input;
+  vtkDataArray *Output;
+  vtkIdType Offset;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    double x[3];
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->Input->GetTuple(i,x);
+      if (this->Mode == POINTS)
+        {
+        vtkLinearTransformPoint(this->Matrix,x,x);
+        }
+      else
+        {
+        vtkLinearTransformVector(this->Matrix,x,x);
+        if (this->Mode == NORMALS)
+          {
+          vtkMath::Normalize(x);
+          }
+        }
+      this->Output->SetTuple(this->Offset + i,x);
+      }
+    }
+};
+
+// Tuples transformed by one call of the functor.
+static const vtkIdType VTK_LINEAR_TRANSFORM_GRAIN = 10000;
+
+//----------------------------------------------------------------------------
+// Run the functor over all input tuples, appending the results to the
+// output like InsertNextTuple() would. Returns 0 if the arrays do not
+// have 3 components, in which case nothing is done.
+static int vtkLinearTransformArray(vtkLinearTransformFunctor& functor,
+                                   vtkDataArray *in, vtkDataArray *out)
+{
+  if (in->GetNumberOfComponents() != 3 || out->GetNumberOfComponents() != 3)
+    {
+    return 0;
+    }
+
+  vtkIdType n = in->GetNumberOfTuples();
+  vtkIdType offset = out->GetNumberOfTuples();
+  if (offset > 0)
+    {
+    // keep the tuples already in the output
+    out->Resize(offset + n);
+    }
+  out->SetNumberOfTuples(offset + n);
+
+  functor.Input = in;
+  functor.Output = out;
+  functor.Offset = offset;
+  vtkSMPTools::For(0, n, VTK_LINEAR_TRANSFORM_GRAIN, functor);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkLinearTransform::TransformPoints(vtkPoints *inPts, 
                                          vtkPoints *outPts)
@@ -186,6 +256,14 @@ void vtkLinearTransform::TransformPoints(vtkPoints *inPts,
 
   this->Update();
 
+  vtkLinearTransformFunctor functor;
+  functor.Mode = vtkLinearTransformFunctor::POINTS;
+  functor.Matrix = matrix;
+  if (vtkLinearTransformArray(functor, inPts->GetData(), outPts->GetData()))
+    {
+    return;
+    }
+
   for (vtkIdType i = 0; i < n; i++)
     {
     inPts->GetPoint(i,point);
@@ -211,6 +289,14 @@ void vtkLinearTransform::TransformNormals(vtkDataArray *inNms,
   vtkMatrix4x4::Invert(*matrix,*matrix);
   vtkMatrix4x4::Transpose(*matrix,*matrix);
 
+  vtkLinearTransformFunctor functor;
+  functor.Mode = vtkLinearTransformFunctor::NORMALS;
+  functor.Matrix = matrix;
+  if (vtkLinearTransformArray(functor, inNms, outNms))
+    {
+    return;
+    }
+
   for (vtkIdType i = 0; i < n; i++)
     {
     inNms->GetTuple(i,norm);
@@ -234,6 +320,14 @@ void vtkLinearTransform::TransformVectors(vtkDataArray *inNms,
 
   double (*matrix)[4] = this->Matrix->Element;
 
+  vtkLinearTransformFunctor functor;
+  functor.Mode = vtkLinearTransformFunctor::VECTORS;
+  functor.Matrix = matrix;
+  if (vtkLinearTransformArray(functor, inNms, outNms))
+    {
+    return;
+    }
+
   for (vtkIdType i = 0; i < n; i++)
     {
     inNms->GetTuple(i,vec);
@@ -243,4 +337,3 @@ void vtkLinearTransform::TransformVectors(vtkDataArray *inNms,
     outNms->InsertNextTuple(vec);
     }
 }
-
@@ -16,6 +16,7 @@
 
 #include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
+#include "vtkThreadPool.h"
 #include "vtkWindows.h"
 
 vtkCxxRevisionMacro(vtkMultiThreader, "$Revision$");
@@ -79,69 +80,94 @@ int vtkMultiThreader::GetGlobalDefaultNumberOfThreads()
 {
   if (vtkMultiThreaderGlobalDefaultNumberOfThreads == 0)
     {
-    int num = 1; // default is 1
+    int num = vtkMultiThreader::GetNumberOfProcessors();
+
+    // Lets limit the number of threads to VTK_MAX_THREADS
+    if (num > VTK_MAX_THREADS)
+      {
+      num = VTK_MAX_THREADS;
+      }
+
+    vtkMultiThreaderGlobalDefaultNumberOfThreads = num;
+    }
+
+
+  return vtkMultiThreaderGlobalDefaultNumberOfThreads;
+}
+
+// 0 => Off.
+static int vtkMultiThreaderGlobalDefaultUseThreadPool = 0;
+
+void vtkMultiThreader::SetGlobalDefaultUseThreadPool(int val)
+{
+  vtkMultiThreaderGlobalDefaultUseThreadPool = val;
+}
+
+int vtkMultiThreader::GetGlobalDefaultUseThreadPool()
+{
+  return vtkMultiThreaderGlobalDefaultUseThreadPool;
+}
+
+int vtkMultiThreader::GetNumberOfProcessors()
+{
+  int num = 1; // default is 1
 #ifdef VTK_USE_SPROC
-    // Default the number of threads to be the number of available
-    // processors if we are using sproc()
-    num = prctl( PR_MAXPPROCS );
+  // Default the number of threads to be the number of available
+  // processors if we are using sproc()
+  num = prctl( PR_MAXPPROCS );
 #endif
 
 #ifdef VTK_USE_PTHREADS
-    // Default the number of threads to be the number of available
-    // processors if we are using pthreads()
+  // Default the number of threads to be the number of available
+  // processors if we are using pthreads()
 #ifdef _SC_NPROCESSORS_ONLN
-    num = sysconf( _SC_NPROCESSORS_ONLN );
+  num = sysconf( _SC_NPROCESSORS_ONLN );
 #elif defined(_SC_NPROC_ONLN)
-    num = sysconf( _SC_NPROC_ONLN );
+  num = sysconf( _SC_NPROC_ONLN );
 #endif
 #if defined(__SVR4) && defined(sun) && defined(PTHREAD_MUTEX_NORMAL)
-    pthread_setconcurrency(num);
+  pthread_setconcurrency(num);
 #endif
 #endif
 
 #ifdef __APPLE__
-    // Determine the number of CPU cores. Prefer sysctlbyname()
-    // over MPProcessors() because it doesn't require CoreServices
-    // (which is only available in 32bit on Mac OS X 10.4).
-    // hw.logicalcpu takes into account cores/CPUs that are
-    // disabled because of power management.
-    size_t dataLen = sizeof(int); // 'num' is an 'int'
-    int result = sysctlbyname ("hw.logicalcpu", &num, &dataLen, NULL, 0);
-    if (result == -1)
-      {
-      num = 1;
-      }
+  // Determine the number of CPU cores. Prefer sysctlbyname()
+  // over MPProcessors() because it doesn't require CoreServices
+  // (which is only available in 32bit on Mac OS X 10.4).
+  // hw.logicalcpu takes into account cores/CPUs that are
+  // disabled because of power management.
+  size_t dataLen = sizeof(int); // 'num' is an 'int'
+  int result = sysctlbyname ("hw.logicalcpu", &num, &dataLen, NULL, 0);
+  if (result == -1)
+    {
+    num = 1;
+    }
 #endif
 
 #ifdef _WIN32
-    {
-      SYSTEM_INFO sysInfo;
-      GetSystemInfo(&sysInfo);
-      num = sysInfo.dwNumberOfProcessors;
-    }
+  {
+    SYSTEM_INFO sysInfo;
+    GetSystemInfo(&sysInfo);
+    num = sysInfo.dwNumberOfProcessors;
+  }
 #endif
 
 #ifndef VTK_USE_WIN32_THREADS
 #ifndef VTK_USE_SPROC
 #ifndef VTK_USE_PTHREADS
-    // If we are not multithreading, the number of threads should
-    // always be 1
-    num = 1;
+  // If we are not multithreading, the number of threads should
+  // always be 1
+  num = 1;
 #endif  
 #endif  
 #endif
-  
-    // Lets limit the number of threads to VTK_MAX_THREADS
-    if (num > VTK_MAX_THREADS)
-      {
-      num = VTK_MAX_THREADS;
-      }
 
-    vtkMultiThreaderGlobalDefaultNumberOfThreads = num;
+  if (num < 1)
+    {
+    num = 1;
     }
 
-
-  return vtkMultiThreaderGlobalDefaultNumberOfThreads;
+  return num;
 }
 
 // Constructor. Default all the methods to NULL. Since the
@@ -165,6 +191,8 @@ vtkMultiThreader::vtkMultiThreader()
   this->SingleMethod = NULL;
   this->NumberOfThreads = 
     vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  this->UseThreadPool =
+    vtkMultiThreader::GetGlobalDefaultUseThreadPool();
 
 }
 
@@ -260,6 +288,11 @@ void vtkMultiThreader::SingleMethodExecute()
     this->NumberOfThreads = vtkMultiThreaderGlobalMaximumNumberOfThreads;
     }
   
+  if ( this->UseThreadPool )
+    {
+    this->ThreadPoolExecute(1);
+    return;
+    }
     
   // We are using sproc (on SGIs), pthreads(on Suns), or a single thread
   // (the default)  
@@ -449,6 +482,12 @@ void vtkMultiThreader::MultipleMethodExecute()
       }
     }
 
+  if ( this->UseThreadPool )
+    {
+    this->ThreadPoolExecute(0);
+    return;
+    }
+
   // We are using sproc (on SGIs), pthreads(on Suns), CreateThread
   // on a PC or a single thread (the default)  
 
@@ -599,6 +638,50 @@ void vtkMultiThreader::MultipleMethodExecute()
 #endif
 }
 
+//----------------------------------------------------------------------------
+// Arguments of vtkMultiThreaderThreadPoolExecute().
+struct vtkMultiThreaderPoolStruct
+{
+  vtkMultiThreader::ThreadInfo *Info;
+  vtkThreadFunctionType         SingleMethod;
+  vtkThreadFunctionType        *MultipleMethod;
+};
+
+// Run the methods of the thread ids in [begin, end) on a pool worker.
+static void vtkMultiThreaderThreadPoolExecute(void *arg, vtkIdType begin,
+                                              vtkIdType end, int)
+{
+  vtkMultiThreaderPoolStruct *str =
+    static_cast<vtkMultiThreaderPoolStruct *>(arg);
+  for ( vtkIdType i = begin; i < end; i++ )
+    {
+    vtkThreadFunctionType method =
+      str->SingleMethod ? str->SingleMethod : str->MultipleMethod[i];
+    method( (void *)(&str->Info[i]) );
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMultiThreader::ThreadPoolExecute(int single)
+{
+  int thread_loop;
+  for ( thread_loop = 0; thread_loop < this->NumberOfThreads; thread_loop++ )
+    {
+    this->ThreadInfoArray[thread_loop].UserData =
+      single ? this->SingleData : this->MultipleData[thread_loop];
+    this->ThreadInfoArray[thread_loop].NumberOfThreads = this->NumberOfThreads;
+    }
+
+  vtkMultiThreaderPoolStruct str;
+  str.Info = this->ThreadInfoArray;
+  str.SingleMethod = single ? this->SingleMethod : NULL;
+  str.MultipleMethod = this->MultipleMethod;
+
+  // One task per thread id, the pool balances them over its workers.
+  vtkThreadPool::GetInstance()->ParallelFor(
+    0, this->NumberOfThreads, 1, vtkMultiThreaderThreadPoolExecute, &str);
+}
+
 int vtkMultiThreader::SpawnThread( vtkThreadFunctionType f, void *userdata )
 {
   int id;
@@ -828,6 +911,7 @@ void vtkMultiThreader::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent); 
 
   os << indent << "Thread Count: " << this->NumberOfThreads << "\n";
+  os << indent << "Use Thread Pool: " << this->UseThreadPool << "\n";
   os << indent << "Global Maximum Number Of Threads: " << 
     vtkMultiThreaderGlobalMaximumNumberOfThreads << endl;
   os << "Thread system used: " <<
@@ -18,6 +18,15 @@
 // execution using sproc() on an SGI, or pthread_create on any platform
 // supporting POSIX threads.  This class can be used to execute a single
 // method on multiple threads, or to specify a method per thread. 
+//
+// When UseThreadPool is on, SingleMethodExecute() and
+// MultipleMethodExecute() do not create new threads but run the methods
+// on the persistent workers of the process-wide vtkThreadPool. The
+// methods then may not run concurrently (the pool can have fewer workers
+// than NumberOfThreads), so they must not wait for each other.
+//
+// .SECTION See Also
+// vtkThreadPool
 
 #ifndef __vtkMultiThreader_h
 #define __vtkMultiThreader_h
@@ -138,6 +147,26 @@ public:
   static void SetGlobalDefaultNumberOfThreads(int val);
   static int  GetGlobalDefaultNumberOfThreads();
 
+  // Description:
+  // Return the number of processors of the machine, or 1 when VTK is
+  // built without thread support. Unlike the default number of threads,
+  // this is not limited to VTK_MAX_THREADS.
+  static int GetNumberOfProcessors();
+
+  // Description:
+  // Set/Get whether the Execute methods run on the process-wide
+  // vtkThreadPool instead of creating and joining threads at every call.
+  // This is off by default and initialized from the global default.
+  vtkSetMacro(UseThreadPool, int);
+  vtkGetMacro(UseThreadPool, int);
+  vtkBooleanMacro(UseThreadPool, int);
+
+  // Description:
+  // Set/Get the value which is used to initialize UseThreadPool in the
+  // constructor. Initially this default is off.
+  static void SetGlobalDefaultUseThreadPool(int val);
+  static int  GetGlobalDefaultUseThreadPool();
+
   // These methods are excluded from Tcl wrapping 1) because the
   // wrapper gives up on them and 2) because they really shouldn't be
   // called from a script anyway.
@@ -197,6 +226,12 @@ protected:
   // The number of threads to use
   int                        NumberOfThreads;
 
+  // Run the methods on the vtkThreadPool workers
+  int                        UseThreadPool;
+
+  // Run SingleMethod (single != 0) or the MultipleMethods on the pool.
+  void                       ThreadPoolExecute(int single);
+
   // An array of thread info containing a thread id
   // (0, 1, 2, .. VTK_MAX_THREADS-1), the thread count, and a pointer
   // to void so that user data can be passed to each thread
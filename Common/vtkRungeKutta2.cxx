@@ -95,8 +95,84 @@ int vtkRungeKutta2::ComputeNextStep(double* xprev, double* dxprev, double* xnext
   return 0;
 }
 
+// Calculate next time step of n particles, one stage at a time
+int vtkRungeKutta2::ComputeNextSteps(vtkIdType n, double** xprev,
+                                     double** xnext, double t, double delT,
+                                     double* error, int* status)
+{
+  if (!this->FunctionSet)
+    {
+    vtkErrorMacro("No derivative functions are provided!");
+    return NOT_INITIALIZED;
+    }
 
+  if (!this->Initialized)
+    {
+    vtkErrorMacro("Integrator not initialized!");
+    return NOT_INITIALIZED;
+    }
+
+  int i, numDerivs = this->FunctionSet->GetNumberOfFunctions();
+  int numVals = numDerivs + 1;
+  vtkIdType p;
+  double** vals = this->AllocateBatch(n, numVals + numDerivs);
+  double** derivs = vals + numVals;
+  for(p=0; p<n; p++)
+    {
+    status[p] = 0;
+    }
+
+  // Obtain the derivatives dx_i at x_i
+  for(i=0; i<numVals-1; i++)
+    {
+    memcpy(vals[i], xprev[i], n*sizeof(double));
+    }
+  for(p=0; p<n; p++)
+    {
+    vals[numVals-1][p] = t;
+    }
+  this->EvaluateBatch(n, vals, derivs, xnext, status);
 
+  // Half-step
+  for(i=0; i<numVals-1; i++)
+    {
+    double* v = vals[i];
+    const double* x = xprev[i];
+    const double* d = derivs[i];
+    for(p=0; p<n; p++)
+      {
+      v[p] = x[p] + delT/2.0*d[p];
+      }
+    }
+  for(p=0; p<n; p++)
+    {
+    vals[numVals-1][p] = t + delT/2.0;
+    }
 
+  // Obtain the derivatives at x_i + dt/2 * dx_i
+  this->EvaluateBatch(n, vals, derivs, xnext, status);
 
+  // Calculate x_i using improved values of derivatives
+  for(i=0; i<numDerivs; i++)
+    {
+    double* xn = xnext[i];
+    const double* x = xprev[i];
+    const double* d = derivs[i];
+    for(p=0; p<n; p++)
+      {
+      if (!status[p])
+        {
+        xn[p] = x[p] + delT*d[p];
+        }
+      }
+    }
 
+  if (error)
+    {
+    for(p=0; p<n; p++)
+      {
+      error[p] = 0.0;
+      }
+    }
+  return 0;
+}
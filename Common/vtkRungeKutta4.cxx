@@ -149,6 +149,105 @@ int vtkRungeKutta4::ComputeNextStep(double* xprev, double* dxprev, double* xnext
   return 0;
 }
 
+// Same as ComputeNextStep(), one stage at a time for all the particles
+int vtkRungeKutta4::ComputeNextSteps(vtkIdType n, double** xprev,
+                                     double** xnext, double t, double delT,
+                                     double* error, int* status)
+{
+  if (!this->FunctionSet)
+    {
+    vtkErrorMacro("No derivative functions are provided!");
+    return NOT_INITIALIZED;
+    }
+
+  if (!this->Initialized)
+    {
+    vtkErrorMacro("Integrator not initialized!");
+    return NOT_INITIALIZED;
+    }
+
+  int i, numDerivs = this->FunctionSet->GetNumberOfFunctions();
+  int numVals = numDerivs + 1;
+  vtkIdType p;
+  double** vals = this->AllocateBatch(n, numVals + 4*numDerivs);
+  double** k[4];
+  for(i=0; i<4; i++)
+    {
+    k[i] = vals + numVals + i*numDerivs;
+    }
+  for(p=0; p<n; p++)
+    {
+    status[p] = 0;
+    }
+
+  // 1
+  for(i=0; i<numVals-1; i++)
+    {
+    memcpy(vals[i], xprev[i], n*sizeof(double));
+    }
+  for(p=0; p<n; p++)
+    {
+    vals[numVals-1][p] = t;
+    }
+  this->EvaluateBatch(n, vals, k[0], xnext, status);
+
+  // 2 and 3 from the midpoints, 4 from the end of the step
+  for(int stage=1; stage<4; stage++)
+    {
+    for(i=0; i<numVals-1; i++)
+      {
+      double* v = vals[i];
+      const double* x = xprev[i];
+      const double* d = k[stage-1][i];
+      if (stage < 3)
+        {
+        for(p=0; p<n; p++)
+          {
+          v[p] = x[p] + delT/2.0*d[p];
+          }
+        }
+      else
+        {
+        for(p=0; p<n; p++)
+          {
+          v[p] = x[p] + delT*d[p];
+          }
+        }
+      }
+    for(p=0; p<n; p++)
+      {
+      vals[numVals-1][p] = t + (stage < 3 ? delT/2.0 : delT);
+      }
+    this->EvaluateBatch(n, vals, k[stage], xnext, status);
+    }
+
+  for(i=0; i<numDerivs; i++)
+    {
+    double* xn = xnext[i];
+    const double* x = xprev[i];
+    const double* d1 = k[0][i];
+    const double* d2 = k[1][i];
+    const double* d3 = k[2][i];
+    const double* d4 = k[3][i];
+    for(p=0; p<n; p++)
+      {
+      if (!status[p])
+        {
+        xn[p] = x[p] + delT*(d1[p]/6.0 + d2[p]/3.0 + d3[p]/3.0 + d4[p]/6.0);
+        }
+      }
+    }
+
+  if (error)
+    {
+    for(p=0; p<n; p++)
+      {
+      error[p] = 0.0;
+      }
+    }
+  return 0;
+}
+
 void vtkRungeKutta4::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
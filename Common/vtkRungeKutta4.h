@@ -83,6 +83,14 @@ public:
                               double minStep, double maxStep, 
                               double maxError, double& error);
 
+  // Description:
+  // Advance n particles at once, see
+  // vtkInitialValueProblemSolver::ComputeNextSteps().
+  // error is set to 0.
+  virtual int ComputeNextSteps(vtkIdType n, double** xprev, double** xnext,
+                               double t, double delT, double* error,
+                               int* status);
+
 protected:
   vtkRungeKutta4();
   ~vtkRungeKutta4();
@@ -318,6 +318,159 @@ int vtkRungeKutta45::ComputeAStep(double* xprev, double* dxprev,
   return 0;
 }
 
+//----------------------------------------------------------------------------
+// Same as ComputeAStep(), one stage at a time for all the particles
+int vtkRungeKutta45::ComputeNextSteps(vtkIdType n, double** xprev,
+                                      double** xnext, double t, double delT,
+                                      double* error, int* status)
+{
+  if (!this->FunctionSet)
+    {
+    vtkErrorMacro("No derivative functions are provided!");
+    return NOT_INITIALIZED ;
+    }
+
+  if (!this->Initialized)
+    {
+    vtkErrorMacro("Integrator not initialized!");
+    return NOT_INITIALIZED;
+    }
+
+  int i, j, k, numDerivs = this->FunctionSet->GetNumberOfFunctions();
+  int numVals = numDerivs + 1;
+  vtkIdType p;
+  // The stage points, the six derivatives, two sums and the error of each
+  // particle.
+  double** vals = this->AllocateBatch(n, numVals + 6*numDerivs + 3);
+  double** nextDerivs[6];
+  for (i=0; i<6; i++)
+    {
+    nextDerivs[i] = vals + numVals + i*numDerivs;
+    }
+  double* sum = vals[numVals + 6*numDerivs];
+  double* dsum = vals[numVals + 6*numDerivs + 1];
+  double* err = vals[numVals + 6*numDerivs + 2];
+  for (p=0; p<n; p++)
+    {
+    status[p] = 0;
+    }
+
+  // Obtain the derivatives dx_i at x_i
+  for (j=0; j<numVals-1; j++)
+    {
+    memcpy(vals[j], xprev[j], n*sizeof(double));
+    }
+  for (p=0; p<n; p++)
+    {
+    vals[numVals-1][p] = t;
+    }
+  this->EvaluateBatch(n, vals, nextDerivs[0], xnext, status);
+
+  for (i=1; i<6; i++)
+    {
+    // Step i
+    // Calculate k_i (NextDerivs) for each step
+    for (j=0; j<numVals-1; j++)
+      {
+      double* v = vals[j];
+      const double* x = xprev[j];
+      for (p=0; p<n; p++)
+        {
+        v[p] = 0;
+        }
+      for (k=0; k<i; k++)
+        {
+        const double b = B[i-1][k];
+        const double* d = nextDerivs[k][j];
+        for (p=0; p<n; p++)
+          {
+          v[p] += b*d[p];
+          }
+        }
+      for (p=0; p<n; p++)
+        {
+        v[p] = x[p] + delT*v[p];
+        }
+      }
+    for (p=0; p<n; p++)
+      {
+      vals[numVals-1][p] = t + delT*A[i-1];
+      }
+    this->EvaluateBatch(n, vals, nextDerivs[i], xnext, status);
+    }
+
+  // Calculate xnext and the norm of the error vector
+  for (p=0; p<n; p++)
+    {
+    err[p] = 0;
+    }
+  for (i=0; i<numDerivs; i++)
+    {
+    for (p=0; p<n; p++)
+      {
+      sum[p] = 0;
+      }
+    for (j=0; j<6; j++)
+      {
+      const double c = C[j];
+      const double* d = nextDerivs[j][i];
+      for (p=0; p<n; p++)
+        {
+        sum[p] += c*d[p];
+        }
+      }
+    double* xn = xnext[i];
+    const double* x = xprev[i];
+    for (p=0; p<n; p++)
+      {
+      if (!status[p])
+        {
+        xn[p] = x[p] + delT*sum[p];
+        }
+      }
+
+    for (p=0; p<n; p++)
+      {
+      dsum[p] = 0;
+      }
+    for (j=0; j<6; j++)
+      {
+      const double dc = DC[j];
+      const double* d = nextDerivs[j][i];
+      for (p=0; p<n; p++)
+        {
+        dsum[p] += dc*d[p];
+        }
+      }
+    for (p=0; p<n; p++)
+      {
+      err[p] += delT*dsum[p]*delT*dsum[p];
+      }
+    }
+
+  for (p=0; p<n; p++)
+    {
+    if (error)
+      {
+      error[p] = sqrt(err[p]);
+      }
+    if (!status[p])
+      {
+      int numZero = 0;
+      for (i=0; i<numDerivs; i++)
+        {
+        numZero += (xnext[i][p] == xprev[i][p]);
+        }
+      if (numZero == numDerivs)
+        {
+        status[p] = UNEXPECTED_VALUE;
+        }
+      }
+    }
+
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkRungeKutta45::PrintSelf(ostream& os, vtkIndent indent)
 {
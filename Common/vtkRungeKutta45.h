@@ -97,6 +97,14 @@ public:
                               double minStep, double maxStep, 
                               double maxError, double& error);
 
+  // Description:
+  // Advance n particles at once, see
+  // vtkInitialValueProblemSolver::ComputeNextSteps(). The step size
+  // is not controlled: error receives the estimated error of each step.
+  virtual int ComputeNextSteps(vtkIdType n, double** xprev, double** xnext,
+                               double t, double delT, double* error,
+                               int* status);
+
 protected:
   vtkRungeKutta45();
   ~vtkRungeKutta45();
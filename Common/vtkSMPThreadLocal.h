@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPThreadLocal - one instance of an object per thread
+// .SECTION Description
+// vtkSMPThreadLocal holds one copy of T for every thread that can execute
+// a vtkSMPTools::For() or vtkSMPTools::Reduce(). Local() returns the copy
+// of the calling thread, which it creates from the exemplar on first use,
+// so the functors of a parallel loop can accumulate into it without
+// locking. After the loop, the copies that were used are visited with an
+// iterator, typically to combine them:
+//
+// \code
+// vtkSMPThreadLocal<double> sum(0.0);
+// ...
+// sum.Local() += x;        // in the functor
+// ...
+// double total = 0.0;
+// for (vtkSMPThreadLocal<double>::iterator it = sum.begin();
+//      it != sum.end(); ++it)
+//   {
+//   total += *it;
+//   }
+// \endcode
+//
+// Every thread executing a For() or a Reduce() has its own copy, whether
+// it is a worker of the vtkThreadPool or the thread that submitted the
+// loop. The copies are created on demand, so the number of threads may
+// change between loops. Threads that call Local() outside of a loop
+// share one copy and must not call it concurrently. Local() takes a
+// lock, so functors call it once per sub-range rather than once per id.
+//
+// .SECTION See Also
+// vtkSMPTools vtkThreadPool
+
+#ifndef __vtkSMPThreadLocal_h
+#define __vtkSMPThreadLocal_h
+
+#include "vtkSMPTools.h"
+#include "vtkCriticalSection.h" // For the lock guarding the slots
+
+#include <vtkstd/vector> // For the per-thread storage
+
+template <class T>
+class vtkSMPThreadLocal
+{
+public:
+  // Description:
+  // Create the storage. The copies are default constructed, or copies of
+  // exemplar.
+  vtkSMPThreadLocal() : Exemplar() {}
+  vtkSMPThreadLocal(const T& exemplar) : Exemplar(exemplar) {}
+
+  ~vtkSMPThreadLocal()
+    {
+    for (size_t i = 0; i < this->Slots.size(); ++i)
+      {
+      delete this->Slots[i];
+      }
+    }
+
+  // Description:
+  // Return the copy of the calling thread. The copy does not move when
+  // other threads create theirs.
+  T& Local()
+    {
+    size_t index = static_cast<size_t>(vtkSMPTools::GetThreadIndex());
+    this->Lock.Lock();
+    if (index >= this->Slots.size())
+      {
+      this->Slots.resize(index + 1, 0);
+      }
+    T *slot = this->Slots[index];
+    if (!slot)
+      {
+      slot = new T(this->Exemplar);
+      this->Slots[index] = slot;
+      }
+    this->Lock.Unlock();
+    return *slot;
+    }
+
+  // Description:
+  // Return the number of copies that have been used.
+  int GetNumberOfUsedSlots() const
+    {
+    int num = 0;
+    for (size_t i = 0; i < this->Slots.size(); ++i)
+      {
+      num += (this->Slots[i] != 0);
+      }
+    return num;
+    }
+
+  //BTX
+  // Description:
+  // Iterator over the copies that have been used. It must not be used
+  // while a loop is running.
+  class iterator
+  {
+  public:
+    iterator() : Owner(0), Index(0) {}
+    T& operator*() const { return *this->Owner->Slots[this->Index]; }
+    T* operator->() const { return this->Owner->Slots[this->Index]; }
+    iterator& operator++()
+      {
+      ++this->Index;
+      this->Skip();
+      return *this;
+      }
+    bool operator==(const iterator& other) const
+      {
+      return this->Owner == other.Owner && this->Index == other.Index;
+      }
+    bool operator!=(const iterator& other) const
+      {
+      return !(*this == other);
+      }
+
+  private:
+    friend class vtkSMPThreadLocal<T>;
+    iterator(vtkSMPThreadLocal<T> *owner, size_t index)
+      : Owner(owner), Index(index)
+      {
+      this->Skip();
+      }
+    void Skip()
+      {
+      while (this->Index < this->Owner->Slots.size() &&
+             !this->Owner->Slots[this->Index])
+        {
+        ++this->Index;
+        }
+      }
+    vtkSMPThreadLocal<T> *Owner;
+    size_t Index;
+  };
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, this->Slots.size()); }
+  //ETX
+
+private:
+  T Exemplar;
+  vtkstd::vector<T*> Slots;
+  vtkSimpleCriticalSection Lock;
+
+  vtkSMPThreadLocal(const vtkSMPThreadLocal&);  // Not implemented.
+  void operator=(const vtkSMPThreadLocal&);  // Not implemented.
+};
+
+#endif
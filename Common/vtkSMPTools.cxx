@@ -0,0 +1,37 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPTools.h"
+
+//----------------------------------------------------------------------------
+int vtkSMPTools::GetNumberOfThreads()
+{
+  return vtkThreadPool::GetInstance()->GetNumberOfThreads();
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPTools::GetThreadIndex()
+{
+  vtkThreadPool *pool = vtkThreadPool::GetInstance();
+  int index = pool->GetThreadIndex();
+  return index < 0 ? pool->GetNumberOfThreads() : index;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPTools::ParallelFor(vtkIdType first, vtkIdType last,
+                              vtkIdType grain,
+                              vtkThreadPoolFunctionType f, void *data)
+{
+  vtkThreadPool::GetInstance()->ParallelFor(first, last, grain, f, data);
+}
@@ -0,0 +1,337 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPTools - parallel loops over ranges of ids
+// .SECTION Description
+// vtkSMPTools runs functors over a range of ids [first, last) on the
+// workers of the process-wide vtkThreadPool. It is meant for filters that
+// process points or cells independently of each other.
+//
+// For() calls f(begin, end) on sub-ranges that cover [first, last)
+// exactly once. The functor must provide
+// \code
+// void operator()(vtkIdType begin, vtkIdType end);
+// \endcode
+// and must be safe to call concurrently: it may read shared data and
+// write to disjoint parts of pre-allocated arrays, anything else has to go
+// through a vtkSMPThreadLocal.
+//
+// Reduce() additionally calls f.Initialize() once on every thread before
+// the first sub-range processed by that thread, and f.Reduce() on the
+// calling thread after all sub-ranges are done. Initialize() typically
+// sets up vtkSMPThreadLocal members, Reduce() combines them.
+//
+// The grain is the largest number of ids given to one call of the
+// functor; when it is smaller than 1 it is chosen from the size of the
+// range and the number of threads. Ranges no larger than the grain are
+// processed on the calling thread. The calling thread executes sub-ranges
+// too, under a thread index of its own.
+//
+// vtkSMPProgress reports the progress of a loop from the thread that
+// started it, as sub-ranges complete.
+//
+// Sort() is a parallel stable merge sort. Its result does not depend on
+// the number of threads.
+//
+// .SECTION Caveats
+// Most VTK methods are not thread-safe; in particular vtkDataSet::GetCell(id)
+// and vtkDataSet::GetPoint(id) return shared storage. Functors should
+// access raw arrays, or use methods documented as thread-safe.
+//
+// .SECTION See Also
+// vtkSMPThreadLocal vtkThreadPool
+
+#ifndef __vtkSMPTools_h
+#define __vtkSMPTools_h
+
+#include "vtkThreadPool.h" // For vtkThreadPoolFunctionType
+#include "vtkCriticalSection.h" // For the Reduce() bookkeeping
+#include "vtkMultiThreader.h" // For vtkSMPProgress
+
+#include <vtkstd/algorithm> // For Sort()
+#include <vtkstd/vector> // For the Reduce() bookkeeping
+
+// Smallest number of elements sorted by one thread in Sort().
+#define VTK_SMP_TOOLS_SORT_GRAIN 8192
+
+//BTX
+// Adapt a functor to the vtkThreadPoolFunctionType signature.
+template <class Functor>
+class vtkSMPToolsFunctorInternal
+{
+public:
+  static void Execute(void *data, vtkIdType begin, vtkIdType end, int)
+    {
+    (*static_cast<Functor *>(data))(begin, end);
+    }
+};
+
+// Call Initialize() on the first sub-range a thread processes.
+template <class Functor>
+class vtkSMPToolsReduceInternal
+{
+public:
+  vtkSMPToolsReduceInternal(Functor& f) : F(f) {}
+
+  void operator()(vtkIdType begin, vtkIdType end);
+
+  Functor& F;
+  // one flag per thread index, grown under the lock
+  vtkstd::vector<unsigned char> Initialized;
+  vtkSimpleCriticalSection Lock;
+};
+
+// Report the progress of a loop over Total ids. The functors call
+// Advance() with the number of ids of every sub-range they complete; the
+// thread that created the object calls UpdateProgress() on the filter,
+// the others only count.
+template <class Filter>
+class vtkSMPProgress
+{
+public:
+  vtkSMPProgress(Filter *filter, vtkIdType total)
+    : Self(filter), Total(total), Done(0),
+      Owner(vtkMultiThreader::GetCurrentThreadID()) {}
+
+  void Advance(vtkIdType n)
+    {
+    this->Lock.Lock();
+    this->Done += n;
+    double progress = static_cast<double>(this->Done) /
+      (this->Total > 0 ? this->Total : 1);
+    this->Lock.Unlock();
+    if (vtkMultiThreader::ThreadsEqual(
+          this->Owner, vtkMultiThreader::GetCurrentThreadID()))
+      {
+      this->Self->UpdateProgress(progress);
+      }
+    }
+
+private:
+  Filter *Self;
+  vtkIdType Total;
+  vtkIdType Done;
+  vtkMultiThreaderIDType Owner;
+  vtkSimpleCriticalSection Lock;
+};
+
+// Stable sort of blocks of equal size.
+template <class T>
+class vtkSMPToolsSortInternal
+{
+public:
+  T *Data;
+  vtkIdType Size;
+  vtkIdType NumberOfBlocks;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType b = begin; b < end; ++b)
+      {
+      vtkstd::stable_sort(this->Data + b * this->Size / this->NumberOfBlocks,
+                          this->Data + (b+1) * this->Size /
+                          this->NumberOfBlocks);
+      }
+    }
+};
+
+// Merge pairs of sorted runs of Width blocks from Source to Target. Every
+// pair is merged by 2*Width pieces of about one block each; the pieces
+// are found by binary search so that they can be merged independently.
+template <class T>
+class vtkSMPToolsMergeInternal
+{
+public:
+  T *Source;
+  T *Target;
+  vtkIdType Size;
+  vtkIdType NumberOfBlocks;
+  vtkIdType Width;
+
+  vtkIdType Block(vtkIdType b)
+    {
+    b = (b < this->NumberOfBlocks ? b : this->NumberOfBlocks);
+    return b * this->Size / this->NumberOfBlocks;
+    }
+
+  // Number of elements taken from a (of size na) among the first d
+  // elements of the stable merge of a and b (of size nb).
+  static vtkIdType Split(const T *a, vtkIdType na, const T *b, vtkIdType nb,
+                         vtkIdType d)
+    {
+    vtkIdType lo = (d > nb ? d - nb : 0);
+    vtkIdType hi = (d < na ? d : na);
+    while (lo < hi)
+      {
+      vtkIdType mid = (lo + hi) / 2;
+      if (!(b[d - mid - 1] < a[mid]))
+        {
+        lo = mid + 1;
+        }
+      else
+        {
+        hi = mid;
+        }
+      }
+    return lo;
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType piece = begin; piece < end; ++piece)
+      {
+      vtkIdType pair = piece / (2 * this->Width);
+      vtkIdType first = this->Block(2 * pair * this->Width);
+      vtkIdType middle = this->Block((2 * pair + 1) * this->Width);
+      vtkIdType last = this->Block((2 * pair + 2) * this->Width);
+      const T *a = this->Source + first;
+      const T *b = this->Source + middle;
+      vtkIdType na = middle - first;
+      vtkIdType nb = last - middle;
+      vtkIdType p = piece - 2 * pair * this->Width;
+      vtkIdType d0 = (na + nb) * p / (2 * this->Width);
+      vtkIdType d1 = (na + nb) * (p + 1) / (2 * this->Width);
+      vtkIdType i0 = Split(a, na, b, nb, d0);
+      vtkIdType i1 = Split(a, na, b, nb, d1);
+      vtkstd::merge(a + i0, a + i1, b + d0 - i0, b + d1 - i1,
+                    this->Target + first + d0);
+      }
+    }
+};
+//ETX
+
+class VTK_COMMON_EXPORT vtkSMPTools
+{
+public:
+  // Description:
+  // Return the number of threads that execute the loops.
+  static int GetNumberOfThreads();
+
+  // Description:
+  // Return the index of the calling thread: its vtkThreadPool index while
+  // it executes a loop (in [0, GetNumberOfThreads()) for the workers, above
+  // for the threads that submitted a loop), GetNumberOfThreads() for the
+  // threads outside of any loop.
+  static int GetThreadIndex();
+
+  //BTX
+  // Description:
+  // Call f(begin, end) over [first, last) in parallel.
+  template <class Functor>
+  static void For(vtkIdType first, vtkIdType last, vtkIdType grain,
+                  Functor& f)
+    {
+    if (last <= first)
+      {
+      return;
+      }
+    vtkSMPTools::ParallelFor(first, last, grain,
+                             &vtkSMPToolsFunctorInternal<Functor>::Execute,
+                             &f);
+    }
+  template <class Functor>
+  static void For(vtkIdType first, vtkIdType last, Functor& f)
+    {
+    vtkSMPTools::For(first, last, 0, f);
+    }
+
+  // Description:
+  // Call f.Initialize() once per thread, f(begin, end) over [first, last)
+  // in parallel, then f.Reduce().
+  template <class Functor>
+  static void Reduce(vtkIdType first, vtkIdType last, vtkIdType grain,
+                     Functor& f)
+    {
+    vtkSMPToolsReduceInternal<Functor> reduce(f);
+    vtkSMPTools::For(first, last, grain, reduce);
+    f.Reduce();
+    }
+  template <class Functor>
+  static void Reduce(vtkIdType first, vtkIdType last, Functor& f)
+    {
+    vtkSMPTools::Reduce(first, last, 0, f);
+    }
+
+  // Description:
+  // Sort [begin, end) with operator< keeping the order of equal elements.
+  template <class T>
+  static void Sort(T *begin, T *end)
+    {
+    vtkIdType size = static_cast<vtkIdType>(end - begin);
+    vtkIdType numBlocks = 1;
+    while (numBlocks < 2 * vtkSMPTools::GetNumberOfThreads() &&
+           size / (2 * numBlocks) >= VTK_SMP_TOOLS_SORT_GRAIN)
+      {
+      numBlocks *= 2;
+      }
+    if (numBlocks == 1)
+      {
+      vtkstd::stable_sort(begin, end);
+      return;
+      }
+
+    vtkSMPToolsSortInternal<T> sorter;
+    sorter.Data = begin;
+    sorter.Size = size;
+    sorter.NumberOfBlocks = numBlocks;
+    vtkSMPTools::For(0, numBlocks, 1, sorter);
+
+    vtkstd::vector<T> buffer(begin, end);
+    vtkSMPToolsMergeInternal<T> merger;
+    merger.Source = begin;
+    merger.Target = &buffer[0];
+    merger.Size = size;
+    merger.NumberOfBlocks = numBlocks;
+    for (merger.Width = 1; merger.Width < numBlocks; merger.Width *= 2)
+      {
+      vtkSMPTools::For(0, numBlocks, 1, merger);
+      vtkstd::swap(merger.Source, merger.Target);
+      }
+    if (merger.Source != begin)
+      {
+      vtkstd::copy(buffer.begin(), buffer.end(), begin);
+      }
+    }
+  //ETX
+
+protected:
+  //BTX
+  static void ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+                          vtkThreadPoolFunctionType f, void *data);
+  //ETX
+};
+
+//BTX
+template <class Functor>
+void vtkSMPToolsReduceInternal<Functor>::operator()(vtkIdType begin,
+                                                    vtkIdType end)
+{
+  size_t index = static_cast<size_t>(vtkSMPTools::GetThreadIndex());
+  this->Lock.Lock();
+  if (index >= this->Initialized.size())
+    {
+    this->Initialized.resize(index + 1, 0);
+    }
+  int initialized = this->Initialized[index];
+  this->Initialized[index] = 1;
+  this->Lock.Unlock();
+  if (!initialized)
+    {
+    this->F.Initialize();
+    }
+  this->F(begin, end);
+}
+//ETX
+
+#endif
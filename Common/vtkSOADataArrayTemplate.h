@@ -0,0 +1,323 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSOADataArrayTemplate - Implementation template for a vtkDataArray with one buffer per component.
+// .SECTION Description
+// vtkSOADataArrayTemplate stores each component of its tuples in a
+// separate buffer ("structure of arrays") instead of interleaving them
+// like vtkDataArrayTemplate does. A buffer may also be strided, i.e. the
+// values of consecutive tuples are Stride values apart. This allows
+// applications that keep x, y and z (or any field components) in
+// separate arrays, or in arrays of records, to hand them to VTK without
+// copying them: see SetArray() and SetStridedArray().
+//
+// The whole vtkDataArray API is supported. GetTuple(), GetComponent(),
+// SetTuple(), the Insert methods and the range computation work directly
+// on the component buffers.
+//
+// .SECTION Caveats
+// HasStandardMemoryLayout() returns 0 unless the values are interleaved
+// in one buffer as in vtkDataArrayTemplate, i.e. a single contiguous
+// component, or components given as consecutive members of an array of
+// records. Otherwise GetVoidPointer() and WriteVoidPointer() interleave
+// the array: the values are copied once into a buffer owned by the array
+// and the components point into it from then on, so writes through the
+// pointer are seen by the other methods. Buffers given to SetArray() are
+// no longer used after that. Interleaving is serialized by a lock, so
+// concurrent GetVoidPointer() calls convert the array only once. Code that
+// needs performance should check HasStandardMemoryLayout() and use
+// GetComponentPointer() and GetComponentStride(), the tuple API or
+// NewIterator(), which iterates over the component buffers.
+//
+// .SECTION See Also
+// vtkSOAFloatArray vtkSOADoubleArray vtkDataArrayTemplate
+
+#ifndef __vtkSOADataArrayTemplate_h
+#define __vtkSOADataArrayTemplate_h
+
+#include "vtkDataArray.h"
+
+class vtkSimpleCriticalSection;
+
+template <class T>
+class vtkSOADataArrayTemplate: public vtkDataArray
+{
+public:
+  typedef vtkDataArray Superclass;
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Allocate memory for this array. Delete old storage only if necessary.
+  // sz is the number of values. Note that ext is no longer used.
+  int Allocate(vtkIdType sz, vtkIdType ext=1000);
+
+  // Description:
+  // Release storage and reset array to initial state.
+  void Initialize();
+
+  // Description:
+  // Return the data type and its size.
+  int GetDataType();
+  int GetDataTypeSize() { return static_cast<int>(sizeof(T)); }
+
+  // Description:
+  // Return 1 only when the values are interleaved in one buffer.
+  virtual int HasStandardMemoryLayout();
+
+  // Description:
+  // Set the number of components. As for the interleaved arrays, the
+  // values of an allocated array are kept and regrouped into tuples of the
+  // new size; the component buffers are reallocated to match.
+  virtual void SetNumberOfComponents(int num);
+
+  // Description:
+  // Set the number of n-tuples in the array. Existing values are kept.
+  void SetNumberOfTuples(vtkIdType number);
+
+  // Description:
+  // Set, insert or append the jth tuple of the source array. The source
+  // must have the same number of components and data type.
+  virtual void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  virtual void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  virtual vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray* source);
+
+  // Description:
+  // Get a pointer to a tuple at the ith location. This is a dangerous method
+  // (it is not thread safe since a pointer is returned).
+  double* GetTuple(vtkIdType i);
+
+  // Description:
+  // Copy the tuple value into a user-provided array.
+  void GetTuple(vtkIdType i, double* tuple);
+  void GetTupleValue(vtkIdType i, T* tuple);
+
+  // Description:
+  // Set the tuple value at the ith location in the array.
+  void SetTuple(vtkIdType i, const float* tuple);
+  void SetTuple(vtkIdType i, const double* tuple);
+  void SetTupleValue(vtkIdType i, const T* tuple);
+
+  // Description:
+  // Insert (memory allocation performed) the tuple into the ith location
+  // in the array.
+  void InsertTuple(vtkIdType i, const float* tuple);
+  void InsertTuple(vtkIdType i, const double* tuple);
+  void InsertTupleValue(vtkIdType i, const T* tuple);
+
+  // Description:
+  // Insert (memory allocation performed) the tuple onto the end of the array.
+  vtkIdType InsertNextTuple(const float* tuple);
+  vtkIdType InsertNextTuple(const double* tuple);
+  vtkIdType InsertNextTupleValue(const T* tuple);
+
+  // Description:
+  // Resize object to just fit data requirement. Reclaims extra memory.
+  void Squeeze() { this->Resize(this->GetNumberOfTuples()); }
+
+  // Description:
+  // Resize the array while conserving the data. Buffers given with
+  // SetStridedArray() are replaced by contiguous ones.
+  virtual int Resize(vtkIdType numTuples);
+
+  // Description:
+  // Get/Set the value at a particular index, i.e. component id %
+  // NumberOfComponents of tuple id / NumberOfComponents. SetValue() does
+  // not do range checking.
+  T GetValue(vtkIdType id)
+    {
+    int comp = static_cast<int>(id % this->NumberOfComponents);
+    return this->Arrays[comp][(id / this->NumberOfComponents) *
+                              this->Strides[comp]];
+    }
+  void SetValue(vtkIdType id, T value)
+    {
+    int comp = static_cast<int>(id % this->NumberOfComponents);
+    this->Arrays[comp][(id / this->NumberOfComponents) *
+                       this->Strides[comp]] = value;
+    }
+
+  // Description:
+  // Specify the number of values for this object to hold.
+  void SetNumberOfValues(vtkIdType number);
+
+  // Description:
+  // Insert data at a specified position in the array.
+  void InsertValue(vtkIdType id, T f);
+  void InsertVariantValue(vtkIdType id, vtkVariant value);
+
+  // Description:
+  // Insert data at the end of the array. Return its location in the array.
+  vtkIdType InsertNextValue(T f);
+
+  // Description:
+  // These methods remove tuples from the data array. They shift data and
+  // resize array, so the data array is still valid after this operation.
+  virtual void RemoveTuple(vtkIdType id);
+  virtual void RemoveFirstTuple() { this->RemoveTuple(0); }
+  virtual void RemoveLastTuple();
+
+  // Description:
+  // Get/Set/Insert the data component at the ith tuple and jth component
+  // location.
+  double GetComponent(vtkIdType i, int j)
+    {
+    return static_cast<double>(this->Arrays[j][i * this->Strides[j]]);
+    }
+  void SetComponent(vtkIdType i, int j, double c)
+    {
+    this->Arrays[j][i * this->Strides[j]] = static_cast<T>(c);
+    }
+  virtual void InsertComponent(vtkIdType i, int j, double c);
+
+  // Description:
+  // Return the buffer holding component comp and the distance, in values,
+  // between consecutive tuples in it. Component comp of tuple i is
+  // GetComponentPointer(comp)[i * GetComponentStride(comp)].
+  T* GetComponentPointer(int comp) { return this->Arrays[comp]; }
+  vtkIdType GetComponentStride(int comp) { return this->Strides[comp]; }
+
+  // Description:
+  // Return a pointer to the interleaved values, interleaving the array
+  // first if needed; see the caveats.
+  virtual void* GetVoidPointer(vtkIdType id);
+
+  // Description:
+  // Make room for number values at id and return a pointer to them,
+  // interleaving the array first if needed; see the caveats.
+  virtual void* WriteVoidPointer(vtkIdType id, vtkIdType number);
+
+  // Description:
+  // Deep copy of another array.
+  void DeepCopy(vtkDataArray* da);
+  void DeepCopy(vtkAbstractArray* aa)
+    { this->Superclass::DeepCopy(aa); }
+
+//BTX
+  enum DeleteMethod
+  {
+    VTK_DATA_ARRAY_FREE,
+    VTK_DATA_ARRAY_DELETE
+  };
+//ETX
+
+  // Description:
+  // Let the array use the given buffer of numTuples values for component
+  // comp, without copying it. Set the number of components first. All
+  // components must be given buffers of the same number of tuples. Set save
+  // to 1 to keep the class from deleting the buffer; otherwise it is
+  // released with free() or delete[] according to deleteMethod
+  // (VTK_DATA_ARRAY_FREE or VTK_DATA_ARRAY_DELETE).
+  void SetArray(int comp, T* array, vtkIdType numTuples, int save,
+                int deleteMethod);
+  void SetArray(int comp, T* array, vtkIdType numTuples, int save)
+    { this->SetArray(comp, array, numTuples, save, VTK_DATA_ARRAY_FREE); }
+
+  // Description:
+  // Only supported for arrays with a single component.
+  virtual void SetVoidArray(void* array, vtkIdType size, int save);
+
+  // Description:
+  // Like SetArray(), for a component whose consecutive values are stride
+  // values apart, e.g. a member of an array of records. The buffer is
+  // never deleted by the array.
+  void SetStridedArray(int comp, T* array, vtkIdType numTuples,
+                       vtkIdType stride);
+
+  // Description:
+  // Copy the values, interleaved, to the given pointer.
+  virtual void ExportToVoidPointer(void *out_ptr);
+
+  // Description:
+  // Returns a vtkArrayIteratorTemplate<T> over the component buffers.
+  virtual vtkArrayIterator* NewIterator();
+
+  //BTX
+  // Description:
+  // Return the indices where a specific value appears (linear search).
+  virtual vtkIdType LookupValue(vtkVariant value);
+  virtual void LookupValue(vtkVariant value, vtkIdList* ids);
+  //ETX
+  vtkIdType LookupValue(T value);
+  void LookupValue(T value, vtkIdList* ids);
+
+  // Description:
+  // Tell the array that its values were modified through the component
+  // pointers. There is no cached state to release.
+  virtual void DataChanged() {}
+  virtual void ClearLookup() {}
+
+  // Description:
+  // Return the memory in kilobytes allocated by the array.
+  virtual unsigned long GetActualMemorySize();
+
+protected:
+  vtkSOADataArrayTemplate(vtkIdType numComp);
+  ~vtkSOADataArrayTemplate();
+
+  // One buffer per component.
+  T** Arrays;
+  vtkIdType* Strides;
+  int* SaveUserArrays;
+  int* DeleteMethods;
+  int NumberOfArrays;
+
+  // Buffer the components point into once the array is interleaved.
+  T* Interleaved;
+  vtkSimpleCriticalSection *InterleaveLock;
+
+  int TupleSize; //used for data conversion
+  double* Tuple;
+
+  // Make sure there is one buffer per component, and that the buffers can
+  // hold numTuples tuples, growing them as InsertNextValue() does.
+  int EnsureCapacity(vtkIdType numTuples);
+  // Copy the values to Interleaved and point the components into it,
+  // unless the layout is already standard.
+  int Interleave();
+  void SetNumberOfArrays(int num);
+  void DeleteArray(int comp);
+
+  virtual void ComputeScalarRange(int comp);
+
+private:
+  vtkSOADataArrayTemplate(const vtkSOADataArrayTemplate&);  // Not implemented.
+  void operator=(const vtkSOADataArrayTemplate&);  // Not implemented.
+};
+
+#if !defined(VTK_NO_EXPLICIT_TEMPLATE_INSTANTIATION)
+# define VTK_SOA_DATA_ARRAY_TEMPLATE_INSTANTIATE(T) \
+   template class VTK_COMMON_EXPORT vtkSOADataArrayTemplate< T >
+#else
+# include "vtkSOADataArrayTemplateImplicit.txx"
+# define VTK_SOA_DATA_ARRAY_TEMPLATE_INSTANTIATE(T)
+#endif
+
+#endif // !defined(__vtkSOADataArrayTemplate_h)
+
+// This portion must be OUTSIDE the include blockers.  Each
+// vtkSOADataArrayTemplate subclass uses this to give its instantiation
+// of this template a DLL interface.
+#if defined(VTK_SOA_DATA_ARRAY_TEMPLATE_TYPE)
+# if defined(VTK_BUILD_SHARED_LIBS) && defined(_MSC_VER)
+#  pragma warning (push)
+#  pragma warning (disable: 4091) // warning C4091: 'extern ' :
+   // ignored on left of 'int' when no variable is declared
+#  pragma warning (disable: 4231) // Compiler-specific extension warning.
+#  pragma warning (disable: 4910) // extern and dllexport incompatible
+   // See vtkDataArrayTemplate.h.
+   extern VTK_SOA_DATA_ARRAY_TEMPLATE_INSTANTIATE(VTK_SOA_DATA_ARRAY_TEMPLATE_TYPE);
+#  pragma warning (pop)
+# endif
+# undef VTK_SOA_DATA_ARRAY_TEMPLATE_TYPE
+#endif
@@ -0,0 +1,958 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#ifndef __vtkSOADataArrayTemplate_txx
+#define __vtkSOADataArrayTemplate_txx
+
+#include "vtkSOADataArrayTemplate.h"
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkCriticalSection.h"
+#include "vtkIdList.h"
+#include "vtkTypeTraits.h"
+#include <vtkstd/new>
+#include <vtkstd/exception>
+
+// We do not provide a definition for the copy constructor or
+// operator=.  Block the warning.
+#ifdef _MSC_VER
+# pragma warning (disable: 4661)
+#endif
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>::vtkSOADataArrayTemplate(vtkIdType numComp):
+  vtkDataArray(numComp)
+{
+  this->Arrays = 0;
+  this->Strides = 0;
+  this->SaveUserArrays = 0;
+  this->DeleteMethods = 0;
+  this->NumberOfArrays = 0;
+  this->Interleaved = 0;
+  this->InterleaveLock = new vtkSimpleCriticalSection;
+  this->Tuple = 0;
+  this->TupleSize = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>::~vtkSOADataArrayTemplate()
+{
+  this->SetNumberOfArrays(0);
+  delete this->InterleaveLock;
+  if (this->Tuple)
+    {
+    free(this->Tuple);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::GetDataType()
+{
+  return vtkTypeTraits<T>::VTKTypeID();
+}
+
+//----------------------------------------------------------------------------
+// The layout is standard when component comp of tuple i is at
+// Arrays[0][i*NumberOfComponents + comp], as in vtkDataArrayTemplate.
+template <class T>
+int vtkSOADataArrayTemplate<T>::HasStandardMemoryLayout()
+{
+  int numComp = this->NumberOfComponents;
+  if (this->NumberOfArrays != numComp)
+    {
+    return numComp == 1 && this->NumberOfArrays == 0;
+    }
+  for (int comp = 0; comp < numComp; comp++)
+    {
+    if (this->Arrays[comp] != this->Arrays[0] + comp ||
+        (numComp > 1 && !this->Arrays[comp]) ||
+        this->Strides[comp] != numComp)
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::DeleteArray(int comp)
+{
+  if (this->Arrays[comp] && !this->SaveUserArrays[comp])
+    {
+    if (this->DeleteMethods[comp] == VTK_DATA_ARRAY_FREE)
+      {
+      free(this->Arrays[comp]);
+      }
+    else
+      {
+      delete[] this->Arrays[comp];
+      }
+    }
+  this->Arrays[comp] = 0;
+  this->Strides[comp] = 1;
+  this->SaveUserArrays[comp] = 0;
+  this->DeleteMethods[comp] = VTK_DATA_ARRAY_FREE;
+}
+
+//----------------------------------------------------------------------------
+// Release all buffers and make room for num of them.
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetNumberOfArrays(int num)
+{
+  for (int comp = 0; comp < this->NumberOfArrays; comp++)
+    {
+    this->DeleteArray(comp);
+    }
+  free(this->Interleaved);
+  this->Interleaved = 0;
+  delete [] this->Arrays;
+  delete [] this->Strides;
+  delete [] this->SaveUserArrays;
+  delete [] this->DeleteMethods;
+  this->Arrays = 0;
+  this->Strides = 0;
+  this->SaveUserArrays = 0;
+  this->DeleteMethods = 0;
+  this->NumberOfArrays = num;
+  this->Size = 0;
+  this->MaxId = -1;
+  if (num > 0)
+    {
+    this->Arrays = new T*[num];
+    this->Strides = new vtkIdType[num];
+    this->SaveUserArrays = new int[num];
+    this->DeleteMethods = new int[num];
+    for (int comp = 0; comp < num; comp++)
+      {
+      this->Arrays[comp] = 0;
+      this->Strides[comp] = 1;
+      this->SaveUserArrays[comp] = 0;
+      this->DeleteMethods[comp] = VTK_DATA_ARRAY_FREE;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetArray(int comp, T* array,
+                                          vtkIdType numTuples, int save,
+                                          int deleteMethod)
+{
+  if (comp < 0 || comp >= this->NumberOfComponents)
+    {
+    vtkErrorMacro("Invalid component " << comp);
+    return;
+    }
+  if (this->NumberOfArrays != this->NumberOfComponents)
+    {
+    this->SetNumberOfArrays(this->NumberOfComponents);
+    }
+
+  vtkDebugMacro(<<"Setting component " << comp << " to: "
+                << static_cast<void*>(array));
+
+  this->DeleteArray(comp);
+  this->Arrays[comp] = array;
+  this->SaveUserArrays[comp] = save;
+  this->DeleteMethods[comp] = deleteMethod;
+  this->Size = numTuples * this->NumberOfComponents;
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetVoidArray(void* array, vtkIdType size,
+                                              int save)
+{
+  if (this->NumberOfComponents != 1)
+    {
+    vtkErrorMacro("SetVoidArray is only supported for arrays with a single "
+                  "component. Use SetArray for each component.");
+    return;
+    }
+  this->SetArray(0, static_cast<T*>(array), size, save);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetStridedArray(int comp, T* array,
+                                                 vtkIdType numTuples,
+                                                 vtkIdType stride)
+{
+  this->SetArray(comp, array, numTuples, 1);
+  if (comp >= 0 && comp < this->NumberOfComponents)
+    {
+    this->Strides[comp] = (stride > 0 ? stride : 1);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Allocate memory for this array. Delete old storage only if necessary.
+template <class T>
+int vtkSOADataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
+{
+  vtkIdType numTuples = (sz + this->NumberOfComponents - 1) /
+    this->NumberOfComponents;
+  if (this->NumberOfArrays != this->NumberOfComponents ||
+      numTuples * this->NumberOfComponents > this->Size)
+    {
+    this->SetNumberOfArrays(this->NumberOfComponents);
+    if (!this->Resize(numTuples > 0 ? numTuples : 1))
+      {
+      return 0;
+      }
+    }
+  this->MaxId = -1;
+  this->DataChanged();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Release storage and reset array to initial state.
+template <class T>
+void vtkSOADataArrayTemplate<T>::Initialize()
+{
+  this->SetNumberOfArrays(0);
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+// Resize all the buffers to hold numTuples tuples, keeping the values.
+template <class T>
+int vtkSOADataArrayTemplate<T>::Resize(vtkIdType numTuples)
+{
+  if (numTuples <= 0)
+    {
+    this->Initialize();
+    return 1;
+    }
+  if (this->NumberOfArrays != this->NumberOfComponents)
+    {
+    this->SetNumberOfArrays(this->NumberOfComponents);
+    }
+
+  // The components of an interleaved array go back to buffers of their
+  // own.
+  vtkIdType oldTuples = this->Size / this->NumberOfComponents;
+  vtkIdType numKept = this->GetNumberOfTuples();
+  numKept = (numKept < numTuples ? numKept : numTuples);
+  for (int comp = 0; comp < this->NumberOfArrays; comp++)
+    {
+    if (numTuples == oldTuples && this->Strides[comp] == 1 &&
+        !this->Interleaved)
+      {
+      continue;
+      }
+    T* newArray = static_cast<T*>(
+      malloc(static_cast<size_t>(numTuples) * sizeof(T)));
+    if (!newArray)
+      {
+      vtkErrorMacro("Unable to allocate " << numTuples
+                    << " elements of size " << sizeof(T)
+                    << " bytes. ");
+      #if !defined NDEBUG
+      // We're debugging, crash here preserving the stack
+      abort();
+      #elif !defined VTK_DONT_THROW_BAD_ALLOC
+      // We can throw something that has universal meaning
+      throw vtkstd::bad_alloc();
+      #else
+      // We indicate that malloc failed by return
+      return 0;
+      #endif
+      }
+    T* oldArray = this->Arrays[comp];
+    vtkIdType stride = this->Strides[comp];
+    for (vtkIdType i = 0; i < numKept; i++)
+      {
+      newArray[i] = oldArray[i*stride];
+      }
+    this->DeleteArray(comp);
+    this->Arrays[comp] = newArray;
+    }
+  free(this->Interleaved);
+  this->Interleaved = 0;
+
+  this->Size = numTuples * this->NumberOfComponents;
+  if (this->MaxId >= this->Size)
+    {
+    this->MaxId = this->Size - 1;
+    }
+  this->DataChanged();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Grow the buffers, more than doubling them, to hold numTuples tuples.
+template <class T>
+int vtkSOADataArrayTemplate<T>::EnsureCapacity(vtkIdType numTuples)
+{
+  if (this->NumberOfArrays == this->NumberOfComponents &&
+      numTuples * this->NumberOfComponents <= this->Size)
+    {
+    return 1;
+    }
+  return this->Resize(this->Size / this->NumberOfComponents + numTuples);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetNumberOfValues(vtkIdType number)
+{
+  vtkIdType numTuples = (number + this->NumberOfComponents - 1) /
+    this->NumberOfComponents;
+  if (this->NumberOfArrays != this->NumberOfComponents ||
+      numTuples * this->NumberOfComponents > this->Size)
+    {
+    if (!this->Resize(numTuples))
+      {
+      return;
+      }
+    }
+  this->MaxId = number - 1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+// Regroup the values into tuples of num components, like
+// vtkDataArrayTemplate does by keeping its buffer.
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetNumberOfComponents(int num)
+{
+  num = (num < 1 ? 1 : num);
+  if (num == this->NumberOfComponents)
+    {
+    return;
+    }
+  if (this->NumberOfArrays == 0)
+    {
+    this->Superclass::SetNumberOfComponents(num);
+    return;
+    }
+
+  vtkIdType numValues = this->MaxId + 1;
+  T* values = 0;
+  if (numValues > 0)
+    {
+    values = static_cast<T*>(
+      malloc(static_cast<size_t>(numValues) * sizeof(T)));
+    if (!values)
+      {
+      vtkErrorMacro("Unable to allocate " << numValues
+                    << " elements of size " << sizeof(T)
+                    << " bytes. ");
+      return;
+      }
+    for (vtkIdType id = 0; id < numValues; id++)
+      {
+      values[id] = this->GetValue(id);
+      }
+    }
+  vtkIdType size = this->Size;
+
+  this->SetNumberOfArrays(0);
+  this->Superclass::SetNumberOfComponents(num);
+  this->Resize((size + num - 1) / num);
+  for (vtkIdType id = 0; id < numValues; id++)
+    {
+    this->SetValue(id, values[id]);
+    }
+  this->MaxId = numValues - 1;
+  free(values);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetNumberOfTuples(vtkIdType number)
+{
+  this->SetNumberOfValues(number*this->NumberOfComponents);
+}
+
+//----------------------------------------------------------------------------
+// Deep copy of another array.
+template <class T>
+void vtkSOADataArrayTemplate<T>::DeepCopy(vtkDataArray* da)
+{
+  // Do nothing on a NULL input, avoid self-copy.
+  if (!da || da == this)
+    {
+    return;
+    }
+
+  this->SetNumberOfArrays(0);
+  this->NumberOfComponents = da->GetNumberOfComponents();
+  vtkIdType numTuples = da->GetNumberOfTuples();
+  this->SetNumberOfTuples(numTuples);
+  int numComp = this->NumberOfComponents;
+  if (da->HasStandardMemoryLayout() && da->GetDataType() == this->GetDataType())
+    {
+    T* from = static_cast<T*>(da->GetVoidPointer(0));
+    for (int comp = 0; comp < numComp; comp++)
+      {
+      T* to = this->Arrays[comp];
+      for (vtkIdType i = 0; i < numTuples; i++)
+        {
+        to[i] = from[i*numComp + comp];
+        }
+      }
+    }
+  else
+    {
+    for (int comp = 0; comp < numComp; comp++)
+      {
+      T* to = this->Arrays[comp];
+      for (vtkIdType i = 0; i < numTuples; i++)
+        {
+        to[i] = static_cast<T>(da->GetComponent(i, comp));
+        }
+      }
+    }
+  this->vtkAbstractArray::DeepCopy(da);
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  vtkOStreamWrapper osw(os);
+  for (int comp = 0; comp < this->NumberOfArrays; comp++)
+    {
+    osw << indent << "Array " << comp << ": "
+        << static_cast<void*>(this->Arrays[comp])
+        << " (stride " << this->Strides[comp] << ")\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+// Set the tuple at the ith location using the jth tuple in the source array.
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
+                                          vtkAbstractArray* source)
+{
+  vtkDataArray* da = vtkDataArray::SafeDownCast(source);
+  if (!da || source->GetDataType() != this->GetDataType())
+    {
+    vtkWarningMacro("Input and output array data types do not match.");
+    return;
+    }
+  if (this->NumberOfComponents != source->GetNumberOfComponents())
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return;
+    }
+
+  for (int comp = 0; comp < this->NumberOfComponents; comp++)
+    {
+    this->Arrays[comp][i*this->Strides[comp]] =
+      static_cast<T>(da->GetComponent(j, comp));
+    }
+}
+
+//----------------------------------------------------------------------------
+// Insert the jth tuple in the source array, at ith location in this array.
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
+                                             vtkAbstractArray* source)
+{
+  if (source->GetDataType() != this->GetDataType())
+    {
+    vtkWarningMacro("Input and output array data types do not match.");
+    return;
+    }
+  if (this->NumberOfComponents != source->GetNumberOfComponents())
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return;
+    }
+  if (!this->EnsureCapacity(i+1))
+    {
+    return;
+    }
+  this->SetTuple(i, j, source);
+  vtkIdType maxId = (i+1)*this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(vtkIdType j,
+                                                      vtkAbstractArray* source)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, j, source);
+  return (this->GetNumberOfTuples() > i ? i : -1);
+}
+
+//----------------------------------------------------------------------------
+// Get a pointer to a tuple at the ith location. This is a dangerous method
+// (it is not thread safe since a pointer is returned).
+template <class T>
+double* vtkSOADataArrayTemplate<T>::GetTuple(vtkIdType i)
+{
+  if (this->TupleSize < this->NumberOfComponents)
+    {
+    this->TupleSize = this->NumberOfComponents;
+    free(this->Tuple);
+    this->Tuple = static_cast<double*>(
+      malloc(this->TupleSize * sizeof(double)));
+    }
+  this->GetTuple(i, this->Tuple);
+  return this->Tuple;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::GetTuple(vtkIdType i, double* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; comp++)
+    {
+    tuple[comp] =
+      static_cast<double>(this->Arrays[comp][i*this->Strides[comp]]);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::GetTupleValue(vtkIdType i, T* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; comp++)
+    {
+    tuple[comp] = this->Arrays[comp][i*this->Strides[comp]];
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, const float* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; comp++)
+    {
+    this->Arrays[comp][i*this->Strides[comp]] = static_cast<T>(tuple[comp]);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, const double* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; comp++)
+    {
+    this->Arrays[comp][i*this->Strides[comp]] = static_cast<T>(tuple[comp]);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTupleValue(vtkIdType i, const T* tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; comp++)
+    {
+    this->Arrays[comp][i*this->Strides[comp]] = tuple[comp];
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, const float* tuple)
+{
+  if (!this->EnsureCapacity(i+1))
+    {
+    return;
+    }
+  this->SetTuple(i, tuple);
+  vtkIdType maxId = (i+1)*this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, const double* tuple)
+{
+  if (!this->EnsureCapacity(i+1))
+    {
+    return;
+    }
+  this->SetTuple(i, tuple);
+  vtkIdType maxId = (i+1)*this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTupleValue(vtkIdType i, const T* tuple)
+{
+  if (!this->EnsureCapacity(i+1))
+    {
+    return;
+    }
+  this->SetTupleValue(i, tuple);
+  vtkIdType maxId = (i+1)*this->NumberOfComponents - 1;
+  if (maxId > this->MaxId)
+    {
+    this->MaxId = maxId;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(const float* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(const double* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTupleValue(const T* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTupleValue(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertValue(vtkIdType id, T f)
+{
+  if (!this->EnsureCapacity(id / this->NumberOfComponents + 1))
+    {
+    return;
+    }
+  this->SetValue(id, f);
+  if (id > this->MaxId)
+    {
+    this->MaxId = id;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertVariantValue(vtkIdType id,
+                                                    vtkVariant value)
+{
+  T* dummyPtr = 0;
+  bool valid;
+  T toInsert = value.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    this->InsertValue(id, toInsert);
+    }
+  else
+    {
+    vtkErrorMacro("unable to insert value of type " << value.GetType());
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextValue(T f)
+{
+  this->InsertValue(this->MaxId + 1, f);
+  return this->MaxId;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertComponent(vtkIdType i, int j,
+                                                 double c)
+{
+  this->InsertValue(i*this->NumberOfComponents + j, static_cast<T>(c));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::RemoveTuple(vtkIdType id)
+{
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  if (id < 0 || id >= numTuples)
+    {
+    return;
+    }
+  for (int comp = 0; comp < this->NumberOfComponents; comp++)
+    {
+    T* array = this->Arrays[comp];
+    vtkIdType stride = this->Strides[comp];
+    for (vtkIdType i = id; i < numTuples - 1; i++)
+      {
+      array[i*stride] = array[(i+1)*stride];
+      }
+    }
+  this->MaxId -= this->NumberOfComponents;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::RemoveLastTuple()
+{
+  if (this->GetNumberOfTuples() > 0)
+    {
+    this->MaxId -= this->NumberOfComponents;
+    this->DataChanged();
+    }
+}
+
+//----------------------------------------------------------------------------
+// Move the values to one buffer owned by the array, interleaved as in
+// vtkDataArrayTemplate, and point the components into it. The lock makes
+// concurrent calls convert the array once.
+template <class T>
+int vtkSOADataArrayTemplate<T>::Interleave()
+{
+  this->InterleaveLock->Lock();
+  if (this->HasStandardMemoryLayout())
+    {
+    this->InterleaveLock->Unlock();
+    return 1;
+    }
+
+  int numComp = this->NumberOfComponents;
+  vtkIdType numTuples = this->Size / numComp;
+  T* values = static_cast<T*>(
+    malloc(static_cast<size_t>(numTuples > 0 ? numTuples : 1) * numComp *
+           sizeof(T)));
+  if (!values)
+    {
+    vtkErrorMacro("Unable to allocate " << numTuples * numComp
+                  << " elements of size " << sizeof(T)
+                  << " bytes. ");
+    this->InterleaveLock->Unlock();
+    return 0;
+    }
+  vtkIdType numKept = this->GetNumberOfTuples();
+  if (this->NumberOfArrays == numComp)
+    {
+    for (int comp = 0; comp < numComp; comp++)
+      {
+      T* array = this->Arrays[comp];
+      vtkIdType stride = this->Strides[comp];
+      for (vtkIdType i = 0; i < numKept; i++)
+        {
+        values[i*numComp + comp] = array[i*stride];
+        }
+      }
+    }
+  else
+    {
+    this->SetNumberOfArrays(numComp);
+    }
+
+  for (int comp = 0; comp < numComp; comp++)
+    {
+    this->DeleteArray(comp);
+    this->Arrays[comp] = values + comp;
+    this->Strides[comp] = numComp;
+    // the buffer is released with Interleaved
+    this->SaveUserArrays[comp] = 1;
+    }
+  free(this->Interleaved);
+  this->Interleaved = values;
+  this->InterleaveLock->Unlock();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkSOADataArrayTemplate<T>::GetVoidPointer(vtkIdType id)
+{
+  if (!this->Interleave() || this->NumberOfArrays == 0)
+    {
+    return 0;
+    }
+  return this->Arrays[0] + id;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkSOADataArrayTemplate<T>::WriteVoidPointer(vtkIdType id,
+                                                   vtkIdType number)
+{
+  vtkIdType newSize = id + number;
+  int numComp = this->NumberOfComponents;
+  if (newSize > this->Size &&
+      !this->EnsureCapacity((newSize + numComp - 1) / numComp))
+    {
+    return 0;
+    }
+  if (!this->Interleave())
+    {
+    return 0;
+    }
+  if (newSize - 1 > this->MaxId)
+    {
+    this->MaxId = newSize - 1;
+    }
+  this->DataChanged();
+  return this->Arrays[0] + id;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::ExportToVoidPointer(void *out_ptr)
+{
+  if (!out_ptr)
+    {
+    return;
+    }
+  T* out = static_cast<T*>(out_ptr);
+  int numComp = this->NumberOfComponents;
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  for (int comp = 0; comp < numComp && comp < this->NumberOfArrays; comp++)
+    {
+    T* array = this->Arrays[comp];
+    vtkIdType stride = this->Strides[comp];
+    for (vtkIdType i = 0; i < numTuples; i++)
+      {
+      out[i*numComp + comp] = array[i*stride];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkArrayIterator* vtkSOADataArrayTemplate<T>::NewIterator()
+{
+  vtkArrayIteratorTemplate<T>* iter = vtkArrayIteratorTemplate<T>::New();
+  if (this->NumberOfArrays == this->NumberOfComponents)
+    {
+    iter->InitializeComponents(this, this->Arrays, this->Strides);
+    }
+  return iter;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::LookupValue(vtkVariant var)
+{
+  T* dummyPtr = 0;
+  bool valid = true;
+  T value = var.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    return this->LookupValue(value);
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::LookupValue(vtkVariant var, vtkIdList* ids)
+{
+  T* dummyPtr = 0;
+  bool valid = true;
+  T value = var.ToNumeric(&valid, dummyPtr);
+  ids->Reset();
+  if (valid)
+    {
+    this->LookupValue(value, ids);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::LookupValue(T value)
+{
+  for (vtkIdType id = 0; id <= this->MaxId; id++)
+    {
+    if (this->GetValue(id) == value)
+      {
+      return id;
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::LookupValue(T value, vtkIdList* ids)
+{
+  ids->Reset();
+  for (vtkIdType id = 0; id <= this->MaxId; id++)
+    {
+    if (this->GetValue(id) == value)
+      {
+      ids->InsertNextId(id);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+unsigned long vtkSOADataArrayTemplate<T>::GetActualMemorySize()
+{
+  double size = static_cast<double>(this->Size) * sizeof(T);
+  // kilobytes
+  return static_cast<unsigned long>(ceil(size/1024.0));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::ComputeScalarRange(int comp)
+{
+  // Compute range only if there are data.
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  if (numTuples == 0)
+    {
+    return;
+    }
+
+  // Compute the range of scalar values.
+  T* array = this->Arrays[comp];
+  vtkIdType stride = this->Strides[comp];
+  T range[2] = {vtkTypeTraits<T>::Max(), vtkTypeTraits<T>::Min()};
+  for (vtkIdType i = 0; i < numTuples; i++)
+    {
+    T s = array[i*stride];
+    if(s < range[0])
+      {
+      range[0] = s;
+      }
+    if(s > range[1])
+      {
+      range[1] = s;
+      }
+    }
+
+  // Store the range.
+  this->Range[0] = static_cast<double>(range[0]);
+  this->Range[1] = static_cast<double>(range[1]);
+}
+
+#endif
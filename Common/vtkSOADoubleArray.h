@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSOADoubleArray - array of double with one buffer per component
+// .SECTION Description
+// vtkSOADoubleArray is an array of values of type double that stores each
+// component in its own, possibly strided, buffer. It lets applications
+// pass separate x, y, z arrays (or members of an array of records) to VTK
+// without copying them. See vtkSOADataArrayTemplate for the caveats.
+// .SECTION See Also
+// vtkDoubleArray vtkSOADataArrayTemplate
+
+#ifndef __vtkSOADoubleArray_h
+#define __vtkSOADoubleArray_h
+
+// Tell the template header how to give our superclass a DLL interface.
+#if !defined(__vtkSOADoubleArray_cxx)
+# define VTK_SOA_DATA_ARRAY_TEMPLATE_TYPE double
+#endif
+
+#include "vtkDataArray.h"
+#include "vtkSOADataArrayTemplate.h" // Real Superclass
+
+// Fake the superclass for the wrappers.
+#define vtkDataArray vtkSOADataArrayTemplate<double>
+class VTK_COMMON_EXPORT vtkSOADoubleArray : public vtkDataArray
+#undef vtkDataArray
+{
+public:
+  static vtkSOADoubleArray* New();
+  vtkTypeRevisionMacro(vtkSOADoubleArray,vtkDataArray);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get the data type.
+  int GetDataType()
+    { return VTK_DOUBLE; }
+
+  // Description:
+  // Copy the tuple value into a user-provided array.
+  void GetTupleValue(vtkIdType i, double* tuple)
+    { this->RealSuperclass::GetTupleValue(i, tuple); }
+
+  // Description:
+  // Set the tuple value at the ith location in the array.
+  void SetTupleValue(vtkIdType i, const double* tuple)
+    { this->RealSuperclass::SetTupleValue(i, tuple); }
+
+  // Description:
+  // Insert (memory allocation performed) the tuple into the ith location
+  // in the array.
+  void InsertTupleValue(vtkIdType i, const double* tuple)
+    { this->RealSuperclass::InsertTupleValue(i, tuple); }
+
+  // Description:
+  // Insert (memory allocation performed) the tuple onto the end of the array.
+  vtkIdType InsertNextTupleValue(const double* tuple)
+    { return this->RealSuperclass::InsertNextTupleValue(tuple); }
+
+  // Description:
+  // Get the data at a particular index.
+  double GetValue(vtkIdType id)
+    { return this->RealSuperclass::GetValue(id); }
+
+  // Description:
+  // Set the data at a particular index. Does not do range checking. Make sure
+  // you use the method SetNumberOfValues() before inserting data.
+  void SetValue(vtkIdType id, double value)
+    { this->RealSuperclass::SetValue(id, value); }
+
+  // Description:
+  // Specify the number of values for this object to hold.
+  void SetNumberOfValues(vtkIdType number)
+    { this->RealSuperclass::SetNumberOfValues(number); }
+
+  // Description:
+  // Insert data at a specified position in the array.
+  void InsertValue(vtkIdType id, double f)
+    { this->RealSuperclass::InsertValue(id, f); }
+
+  // Description:
+  // Insert data at the end of the array. Return its location in the array.
+  vtkIdType InsertNextValue(double f)
+    { return this->RealSuperclass::InsertNextValue(f); }
+
+  // Description:
+  // Return the buffer holding component comp and the distance, in values,
+  // between consecutive tuples in it.
+  double* GetComponentPointer(int comp)
+    { return this->RealSuperclass::GetComponentPointer(comp); }
+  vtkIdType GetComponentStride(int comp)
+    { return this->RealSuperclass::GetComponentStride(comp); }
+
+  // Description:
+  // Let the array use the given buffer of numTuples values for component
+  // comp, without copying it. Set save to 1 to keep the class from
+  // deleting the buffer when it cleans up or reallocates memory.
+  void SetArray(int comp, double* array, vtkIdType numTuples, int save)
+    { this->RealSuperclass::SetArray(comp, array, numTuples, save); }
+  void SetArray(int comp, double* array, vtkIdType numTuples, int save,
+                int deleteMethod)
+    {
+    this->RealSuperclass::SetArray(comp, array, numTuples, save,
+                                   deleteMethod);
+    }
+
+  // Description:
+  // Use a buffer whose consecutive values are stride values apart for
+  // component comp. The buffer is never deleted by the array.
+  void SetStridedArray(int comp, double* array, vtkIdType numTuples,
+                       vtkIdType stride)
+    {
+    this->RealSuperclass::SetStridedArray(comp, array, numTuples, stride);
+    }
+
+protected:
+  vtkSOADoubleArray(vtkIdType numComp=1);
+  ~vtkSOADoubleArray();
+
+private:
+  //BTX
+  typedef vtkSOADataArrayTemplate<double> RealSuperclass;
+  //ETX
+  vtkSOADoubleArray(const vtkSOADoubleArray&);  // Not implemented.
+  void operator=(const vtkSOADoubleArray&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,42 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Instantiate superclass first to give the template a DLL interface.
+#include "vtkSOADataArrayTemplate.txx"
+VTK_SOA_DATA_ARRAY_TEMPLATE_INSTANTIATE(float);
+
+#define __vtkSOAFloatArray_cxx
+#include "vtkSOAFloatArray.h"
+
+#include "vtkObjectFactory.h"
+
+//----------------------------------------------------------------------------
+vtkCxxRevisionMacro(vtkSOAFloatArray, "$Revision$");
+vtkStandardNewMacro(vtkSOAFloatArray);
+
+//----------------------------------------------------------------------------
+vtkSOAFloatArray::vtkSOAFloatArray(vtkIdType numComp): RealSuperclass(numComp)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkSOAFloatArray::~vtkSOAFloatArray()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkSOAFloatArray::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->RealSuperclass::PrintSelf(os,indent);
+}
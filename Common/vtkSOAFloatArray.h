@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSOAFloatArray - array of float with one buffer per component
+// .SECTION Description
+// vtkSOAFloatArray is an array of values of type float that stores each
+// component in its own, possibly strided, buffer. It lets applications
+// pass separate x, y, z arrays (or members of an array of records) to VTK
+// without copying them. See vtkSOADataArrayTemplate for the caveats.
+// .SECTION See Also
+// vtkFloatArray vtkSOADataArrayTemplate
+
+#ifndef __vtkSOAFloatArray_h
+#define __vtkSOAFloatArray_h
+
+// Tell the template header how to give our superclass a DLL interface.
+#if !defined(__vtkSOAFloatArray_cxx)
+# define VTK_SOA_DATA_ARRAY_TEMPLATE_TYPE float
+#endif
+
+#include "vtkDataArray.h"
+#include "vtkSOADataArrayTemplate.h" // Real Superclass
+
+// Fake the superclass for the wrappers.
+#define vtkDataArray vtkSOADataArrayTemplate<float>
+class VTK_COMMON_EXPORT vtkSOAFloatArray : public vtkDataArray
+#undef vtkDataArray
+{
+public:
+  static vtkSOAFloatArray* New();
+  vtkTypeRevisionMacro(vtkSOAFloatArray,vtkDataArray);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get the data type.
+  int GetDataType()
+    { return VTK_FLOAT; }
+
+  // Description:
+  // Copy the tuple value into a user-provided array.
+  void GetTupleValue(vtkIdType i, float* tuple)
+    { this->RealSuperclass::GetTupleValue(i, tuple); }
+
+  // Description:
+  // Set the tuple value at the ith location in the array.
+  void SetTupleValue(vtkIdType i, const float* tuple)
+    { this->RealSuperclass::SetTupleValue(i, tuple); }
+
+  // Description:
+  // Insert (memory allocation performed) the tuple into the ith location
+  // in the array.
+  void InsertTupleValue(vtkIdType i, const float* tuple)
+    { this->RealSuperclass::InsertTupleValue(i, tuple); }
+
+  // Description:
+  // Insert (memory allocation performed) the tuple onto the end of the array.
+  vtkIdType InsertNextTupleValue(const float* tuple)
+    { return this->RealSuperclass::InsertNextTupleValue(tuple); }
+
+  // Description:
+  // Get the data at a particular index.
+  float GetValue(vtkIdType id)
+    { return this->RealSuperclass::GetValue(id); }
+
+  // Description:
+  // Set the data at a particular index. Does not do range checking. Make sure
+  // you use the method SetNumberOfValues() before inserting data.
+  void SetValue(vtkIdType id, float value)
+    { this->RealSuperclass::SetValue(id, value); }
+
+  // Description:
+  // Specify the number of values for this object to hold.
+  void SetNumberOfValues(vtkIdType number)
+    { this->RealSuperclass::SetNumberOfValues(number); }
+
+  // Description:
+  // Insert data at a specified position in the array.
+  void InsertValue(vtkIdType id, float f)
+    { this->RealSuperclass::InsertValue(id, f); }
+
+  // Description:
+  // Insert data at the end of the array. Return its location in the array.
+  vtkIdType InsertNextValue(float f)
+    { return this->RealSuperclass::InsertNextValue(f); }
+
+  // Description:
+  // Return the buffer holding component comp and the distance, in values,
+  // between consecutive tuples in it.
+  float* GetComponentPointer(int comp)
+    { return this->RealSuperclass::GetComponentPointer(comp); }
+  vtkIdType GetComponentStride(int comp)
+    { return this->RealSuperclass::GetComponentStride(comp); }
+
+  // Description:
+  // Let the array use the given buffer of numTuples values for component
+  // comp, without copying it. Set save to 1 to keep the class from
+  // deleting the buffer when it cleans up or reallocates memory.
+  void SetArray(int comp, float* array, vtkIdType numTuples, int save)
+    { this->RealSuperclass::SetArray(comp, array, numTuples, save); }
+  void SetArray(int comp, float* array, vtkIdType numTuples, int save,
+                int deleteMethod)
+    {
+    this->RealSuperclass::SetArray(comp, array, numTuples, save,
+                                   deleteMethod);
+    }
+
+  // Description:
+  // Use a buffer whose consecutive values are stride values apart for
+  // component comp. The buffer is never deleted by the array.
+  void SetStridedArray(int comp, float* array, vtkIdType numTuples,
+                       vtkIdType stride)
+    {
+    this->RealSuperclass::SetStridedArray(comp, array, numTuples, stride);
+    }
+
+protected:
+  vtkSOAFloatArray(vtkIdType numComp=1);
+  ~vtkSOAFloatArray();
+
+private:
+  //BTX
+  typedef vtkSOADataArrayTemplate<float> RealSuperclass;
+  //ETX
+  vtkSOAFloatArray(const vtkSOAFloatArray&);  // Not implemented.
+  void operator=(const vtkSOAFloatArray&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,644 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkThreadPool.h"
+
+#include "vtkConditionVariable.h"
+#include "vtkCriticalSection.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkObjectFactory.h"
+#include "vtkWindows.h"
+
+#include <vtkstd/deque>
+#include <vtkstd/vector>
+
+vtkCxxRevisionMacro(vtkThreadPool, "$Revision$");
+vtkStandardNewMacro(vtkThreadPool);
+
+// See vtkMultiThreader.cxx for the reason of this typedef.
+#if defined(VTK_USE_PTHREADS)
+extern "C" { typedef void *(*vtkExternCThreadFunctionType)(void *); }
+#endif
+
+#if defined(VTK_USE_PTHREADS) || defined(VTK_USE_WIN32_THREADS)
+# define VTK_THREAD_POOL_HAS_THREADS
+#endif
+
+// Thread-specific key holding the vtkThreadPoolThread of the calling
+// thread, NULL for threads that take no part in an execution.
+#if defined(VTK_USE_PTHREADS)
+static pthread_key_t vtkThreadPoolWorkerKey;
+#elif defined(VTK_USE_WIN32_THREADS)
+static DWORD vtkThreadPoolWorkerKey;
+#endif
+
+vtkThreadPool *vtkThreadPool::Instance = 0;
+vtkThreadPoolCleanup vtkThreadPool::Cleanup;
+
+// Guards the creation of the process-wide instance.
+static vtkSimpleCriticalSection vtkThreadPoolInstanceLock;
+
+//----------------------------------------------------------------------------
+vtkThreadPoolCleanup::vtkThreadPoolCleanup()
+{
+#if defined(VTK_USE_PTHREADS)
+  pthread_key_create(&vtkThreadPoolWorkerKey, NULL);
+#elif defined(VTK_USE_WIN32_THREADS)
+  vtkThreadPoolWorkerKey = TlsAlloc();
+#endif
+}
+
+//----------------------------------------------------------------------------
+vtkThreadPoolCleanup::~vtkThreadPoolCleanup()
+{
+  // Stop the workers of the process-wide pool and release it.
+  if (vtkThreadPool::Instance)
+    {
+    vtkThreadPool::Instance->Delete();
+    vtkThreadPool::Instance = 0;
+    }
+#if defined(VTK_USE_PTHREADS)
+  pthread_key_delete(vtkThreadPoolWorkerKey);
+#elif defined(VTK_USE_WIN32_THREADS)
+  TlsFree(vtkThreadPoolWorkerKey);
+#endif
+}
+
+//----------------------------------------------------------------------------
+// One execution of ParallelFor(). Pending counts the pieces that have been
+// queued or are executing and is guarded by the pool's WakeLock.
+struct vtkThreadPoolJob
+{
+  vtkThreadPoolFunctionType Function;
+  void *Data;
+  vtkIdType Grain;
+  vtkIdType Pending;
+};
+
+// A sub-range of a job waiting in a worker queue.
+struct vtkThreadPoolTask
+{
+  vtkThreadPoolJob *Job;
+  vtkIdType Begin;
+  vtkIdType End;
+};
+
+// What the pool knows about a thread executing its tasks. Index is the
+// thread index given to the functions, Queue the worker queue that
+// receives the pieces split by the thread. Workers use their own queue;
+// other threads are registered for the duration of a ParallelFor() and
+// push on the queue of a worker.
+struct vtkThreadPoolThread
+{
+  vtkThreadPoolInternals *Pool;
+  int Index;
+  int Queue;
+  int IsWorker;
+};
+
+class vtkThreadPoolWorker
+{
+public:
+  vtkThreadPoolThread Info;
+  vtkThreadProcessIDType Thread;
+
+  // The owner pushes and pops at the back, thieves take from the front.
+  vtkSimpleCriticalSection QueueLock;
+  vtkstd::deque<vtkThreadPoolTask> Queue;
+};
+
+//----------------------------------------------------------------------------
+class vtkThreadPoolInternals
+{
+public:
+  vtkThreadPoolInternals()
+    {
+    this->Generation = 0;
+    this->ShuttingDown = 0;
+    this->NextQueue = 0;
+    this->NumberOfGuests = 0;
+    this->SleepingGuests = 0;
+    }
+
+  vtkThreadPoolThread *FindCurrentThread();
+  void Push(int queue, vtkThreadPoolJob *job, vtkIdType begin, vtkIdType end);
+  int Pop(int queue, vtkThreadPoolTask& task);
+  int Steal(int queue, vtkThreadPoolTask& task, vtkThreadPoolJob *job);
+  void Run(vtkThreadPoolThread *thread, vtkThreadPoolTask task);
+  void WaitForJob(vtkThreadPoolThread *thread, vtkThreadPoolJob *job);
+  void WorkerLoop(vtkThreadPoolWorker *worker);
+  int AcquireGuest();
+  void ReleaseGuest(int guest);
+
+  vtkstd::vector<vtkThreadPoolWorker*> Workers;
+
+  // WakeLock guards Generation, ShuttingDown, the guest numbers and the
+  // Pending count of the jobs. Generation is incremented whenever a task
+  // is queued or a job completes so that sleeping threads do not miss a
+  // wake up. The workers sleep on WakeCondition and the guests on
+  // GuestCondition, so that a guest cannot take the wake up of a worker.
+  // Every queued task wakes one sleeping worker and the sleeping guests,
+  // which only run the tasks of their own job; the completion of a job
+  // wakes everybody since any of them may be waiting for it.
+  vtkSimpleMutexLock WakeLock;
+  vtkSimpleConditionVariable WakeCondition;
+  vtkSimpleConditionVariable GuestCondition;
+  int SleepingGuests;
+  unsigned long Generation;
+  int ShuttingDown;
+  int NextQueue;
+
+  // Numbers of the threads other than the workers that take part in an
+  // execution. Free numbers are reused so that the indices stay small.
+  int NumberOfGuests;
+  vtkstd::vector<int> FreeGuests;
+
+  // Serializes starting and stopping of the workers.
+  vtkSimpleCriticalSection StartLock;
+};
+
+//----------------------------------------------------------------------------
+static vtkThreadPoolThread *vtkThreadPoolGetThread()
+{
+#if defined(VTK_USE_PTHREADS)
+  return static_cast<vtkThreadPoolThread *>(
+    pthread_getspecific(vtkThreadPoolWorkerKey));
+#elif defined(VTK_USE_WIN32_THREADS)
+  return static_cast<vtkThreadPoolThread *>(
+    TlsGetValue(vtkThreadPoolWorkerKey));
+#else
+  return 0;
+#endif
+}
+
+//----------------------------------------------------------------------------
+static void vtkThreadPoolSetThread(vtkThreadPoolThread *thread)
+{
+#if defined(VTK_USE_PTHREADS)
+  pthread_setspecific(vtkThreadPoolWorkerKey, thread);
+#elif defined(VTK_USE_WIN32_THREADS)
+  TlsSetValue(vtkThreadPoolWorkerKey, thread);
+#else
+  (void)thread;
+#endif
+}
+
+//----------------------------------------------------------------------------
+// Return the calling thread if it executes tasks of this pool, or NULL.
+vtkThreadPoolThread *vtkThreadPoolInternals::FindCurrentThread()
+{
+  vtkThreadPoolThread *thread = vtkThreadPoolGetThread();
+  if (thread && thread->Pool == this)
+    {
+    return thread;
+    }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadPoolInternals::AcquireGuest()
+{
+  int guest;
+  this->WakeLock.Lock();
+  if (this->FreeGuests.empty())
+    {
+    guest = this->NumberOfGuests++;
+    }
+  else
+    {
+    guest = this->FreeGuests.back();
+    this->FreeGuests.pop_back();
+    }
+  this->WakeLock.Unlock();
+  return guest;
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadPoolInternals::ReleaseGuest(int guest)
+{
+  this->WakeLock.Lock();
+  this->FreeGuests.push_back(guest);
+  this->WakeLock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadPoolInternals::Push(int queue, vtkThreadPoolJob *job,
+                                  vtkIdType begin, vtkIdType end)
+{
+  vtkThreadPoolTask task;
+  task.Job = job;
+  task.Begin = begin;
+  task.End = end;
+
+  vtkThreadPoolWorker *worker = this->Workers[queue];
+  this->WakeLock.Lock();
+  // The piece is accounted for before anybody can take it.
+  ++job->Pending;
+  worker->QueueLock.Lock();
+  worker->Queue.push_back(task);
+  worker->QueueLock.Unlock();
+  ++this->Generation;
+  this->WakeCondition.Signal();
+  if (this->SleepingGuests)
+    {
+    this->GuestCondition.Broadcast();
+    }
+  this->WakeLock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadPoolInternals::Pop(int queue, vtkThreadPoolTask& task)
+{
+  vtkThreadPoolWorker *worker = this->Workers[queue];
+  int found = 0;
+  worker->QueueLock.Lock();
+  if (!worker->Queue.empty())
+    {
+    task = worker->Queue.back();
+    worker->Queue.pop_back();
+    found = 1;
+    }
+  worker->QueueLock.Unlock();
+  return found;
+}
+
+//----------------------------------------------------------------------------
+// Take the oldest task of another queue, or the oldest task of the given
+// job if it is not NULL.
+int vtkThreadPoolInternals::Steal(int queue, vtkThreadPoolTask& task,
+                                  vtkThreadPoolJob *job)
+{
+  int num = static_cast<int>(this->Workers.size());
+  for (int i = 1; i <= num; ++i)
+    {
+    vtkThreadPoolWorker *victim = this->Workers[(queue + i) % num];
+    int found = 0;
+    victim->QueueLock.Lock();
+    vtkstd::deque<vtkThreadPoolTask>::iterator it = victim->Queue.begin();
+    while (job && it != victim->Queue.end() && it->Job != job)
+      {
+      ++it;
+      }
+    if (it != victim->Queue.end())
+      {
+      task = *it;
+      victim->Queue.erase(it);
+      found = 1;
+      }
+    victim->QueueLock.Unlock();
+    if (found)
+      {
+      return 1;
+      }
+    }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Split the task until it is no larger than the grain, queueing the upper
+// halves so that idle workers can steal them, then execute the rest.
+void vtkThreadPoolInternals::Run(vtkThreadPoolThread *thread,
+                                 vtkThreadPoolTask task)
+{
+  vtkThreadPoolJob *job = task.Job;
+  while (task.End - task.Begin > job->Grain)
+    {
+    vtkIdType mid = task.Begin + (task.End - task.Begin) / 2;
+    this->Push(thread->Queue, job, mid, task.End);
+    task.End = mid;
+    }
+
+  job->Function(job->Data, task.Begin, task.End, thread->Index);
+
+  this->WakeLock.Lock();
+  if (--job->Pending == 0)
+    {
+    ++this->Generation;
+    this->WakeCondition.Broadcast();
+    this->GuestCondition.Broadcast();
+    }
+  this->WakeLock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+// Block until all pieces of the job are done. The thread executes queued
+// tasks while it waits so that it does not idle: any task for a worker, so
+// that nested executions make progress, only the tasks of its job for the
+// other threads, so that the threads executing a job are the workers and
+// the thread that submitted it.
+void vtkThreadPoolInternals::WaitForJob(vtkThreadPoolThread *thread,
+                                        vtkThreadPoolJob *job)
+{
+  vtkThreadPoolTask task;
+  for (;;)
+    {
+    this->WakeLock.Lock();
+    if (job->Pending == 0)
+      {
+      this->WakeLock.Unlock();
+      return;
+      }
+    unsigned long generation = this->Generation;
+    this->WakeLock.Unlock();
+
+    if ((thread->IsWorker && this->Pop(thread->Queue, task)) ||
+        this->Steal(thread->Queue, task, thread->IsWorker ? 0 : job))
+      {
+      this->Run(thread, task);
+      continue;
+      }
+
+    this->WakeLock.Lock();
+    while (this->Generation == generation && job->Pending != 0)
+      {
+      if (thread->IsWorker)
+        {
+        this->WakeCondition.Wait(this->WakeLock);
+        }
+      else
+        {
+        ++this->SleepingGuests;
+        this->GuestCondition.Wait(this->WakeLock);
+        --this->SleepingGuests;
+        }
+      }
+    this->WakeLock.Unlock();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadPoolInternals::WorkerLoop(vtkThreadPoolWorker *worker)
+{
+  vtkThreadPoolThread *thread = &worker->Info;
+  vtkThreadPoolSetThread(thread);
+
+  vtkThreadPoolTask task;
+  for (;;)
+    {
+    this->WakeLock.Lock();
+    if (this->ShuttingDown)
+      {
+      this->WakeLock.Unlock();
+      break;
+      }
+    unsigned long generation = this->Generation;
+    this->WakeLock.Unlock();
+
+    if (this->Pop(thread->Queue, task) || this->Steal(thread->Queue, task, 0))
+      {
+      this->Run(thread, task);
+      continue;
+      }
+
+    this->WakeLock.Lock();
+    while (this->Generation == generation && !this->ShuttingDown)
+      {
+      this->WakeCondition.Wait(this->WakeLock);
+      }
+    this->WakeLock.Unlock();
+    }
+}
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkThreadPoolWorkerMain(void *arg)
+{
+  vtkThreadPoolWorker *worker = static_cast<vtkThreadPoolWorker *>(arg);
+  worker->Info.Pool->WorkerLoop(worker);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+vtkThreadPool::vtkThreadPool()
+{
+  this->Internals = new vtkThreadPoolInternals;
+  this->NumberOfThreads = vtkMultiThreader::GetNumberOfProcessors();
+}
+
+//----------------------------------------------------------------------------
+vtkThreadPool::~vtkThreadPool()
+{
+  this->StopWorkers();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+vtkThreadPool *vtkThreadPool::GetInstance()
+{
+  // The lock is always taken: testing Instance before would need a
+  // memory barrier to be safe.
+  vtkThreadPoolInstanceLock.Lock();
+  if (!vtkThreadPool::Instance)
+    {
+    vtkThreadPool::Instance = vtkThreadPool::New();
+    }
+  vtkThreadPoolInstanceLock.Unlock();
+  return vtkThreadPool::Instance;
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadPool::SetNumberOfThreads(int num)
+{
+  if (num < 1 || num == this->NumberOfThreads)
+    {
+    return;
+    }
+  this->StopWorkers();
+  this->NumberOfThreads = num;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadPool::IsWorkerThread()
+{
+  vtkThreadPoolThread *thread = this->Internals->FindCurrentThread();
+  return thread && thread->IsWorker;
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadPool::GetThreadIndex()
+{
+  vtkThreadPoolThread *thread = this->Internals->FindCurrentThread();
+  return thread ? thread->Index : -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadPool::StartWorkers()
+{
+#ifdef VTK_THREAD_POOL_HAS_THREADS
+  vtkThreadPoolInternals *internals = this->Internals;
+  internals->StartLock.Lock();
+  if (internals->Workers.empty())
+    {
+    internals->ShuttingDown = 0;
+    internals->NextQueue = 0;
+
+    int i;
+    for (i = 0; i < this->NumberOfThreads; ++i)
+      {
+      vtkThreadPoolWorker *worker = new vtkThreadPoolWorker;
+      worker->Info.Pool = internals;
+      worker->Info.Index = i;
+      worker->Info.Queue = i;
+      worker->Info.IsWorker = 1;
+      internals->Workers.push_back(worker);
+      }
+
+    for (i = 0; i < this->NumberOfThreads; ++i)
+      {
+      vtkThreadPoolWorker *worker = internals->Workers[i];
+#if defined(VTK_USE_PTHREADS)
+      int threadError = pthread_create(
+        &worker->Thread, 0,
+        reinterpret_cast<vtkExternCThreadFunctionType>(
+          vtkThreadPoolWorkerMain), worker);
+      if (threadError != 0)
+        {
+        vtkErrorMacro(<< "Unable to create a thread.  pthread_create() "
+                      "returned " << threadError);
+        }
+#else
+      DWORD threadId;
+      worker->Thread = CreateThread(NULL, 0, vtkThreadPoolWorkerMain,
+                                    worker, 0, &threadId);
+      if (worker->Thread == NULL)
+        {
+        vtkErrorMacro("Error in thread creation !!!");
+        }
+#endif
+      }
+    }
+  internals->StartLock.Unlock();
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadPool::StopWorkers()
+{
+#ifdef VTK_THREAD_POOL_HAS_THREADS
+  vtkThreadPoolInternals *internals = this->Internals;
+  internals->StartLock.Lock();
+  if (!internals->Workers.empty())
+    {
+    internals->WakeLock.Lock();
+    internals->ShuttingDown = 1;
+    internals->WakeCondition.Broadcast();
+    internals->WakeLock.Unlock();
+
+    int num = static_cast<int>(internals->Workers.size());
+    int i;
+    for (i = 0; i < num; ++i)
+      {
+#if defined(VTK_USE_PTHREADS)
+      pthread_join(internals->Workers[i]->Thread, NULL);
+#else
+      WaitForSingleObject(internals->Workers[i]->Thread, INFINITE);
+      CloseHandle(internals->Workers[i]->Thread);
+#endif
+      }
+    for (i = 0; i < num; ++i)
+      {
+      delete internals->Workers[i];
+      }
+    internals->Workers.clear();
+    }
+  internals->StartLock.Unlock();
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadPool::ParallelFor(vtkIdType first, vtkIdType last,
+                                vtkIdType grain,
+                                vtkThreadPoolFunctionType f, void *data)
+{
+  if (last <= first)
+    {
+    return;
+    }
+
+#ifdef VTK_THREAD_POOL_HAS_THREADS
+  this->StartWorkers();
+  vtkThreadPoolInternals *internals = this->Internals;
+
+  if (grain < 1)
+    {
+    // A few pieces per worker leave room for stealing.
+    grain = (last - first) / (4 * this->NumberOfThreads);
+    if (grain < 1)
+      {
+      grain = 1;
+      }
+    }
+
+  vtkThreadPoolJob job;
+  job.Function = f;
+  job.Data = data;
+  job.Grain = grain;
+  job.Pending = 0;
+
+  // A thread that is not yet executing tasks of this pool takes part in
+  // the execution under a guest index above those of the workers, and
+  // pushes on the queue of a worker. Submissions of different threads are
+  // spread over the workers.
+  vtkThreadPoolThread *thread = internals->FindCurrentThread();
+  vtkThreadPoolThread guest;
+  vtkThreadPoolThread *previous = 0;
+  if (!thread)
+    {
+    int number = internals->AcquireGuest();
+    guest.Pool = internals;
+    guest.Index = this->NumberOfThreads + 1 + number;
+    guest.IsWorker = 0;
+    internals->WakeLock.Lock();
+    guest.Queue = internals->NextQueue;
+    internals->NextQueue =
+      (internals->NextQueue + 1) % static_cast<int>(internals->Workers.size());
+    internals->WakeLock.Unlock();
+    previous = vtkThreadPoolGetThread();
+    vtkThreadPoolSetThread(&guest);
+    thread = &guest;
+    }
+
+  if (last - first <= grain)
+    {
+    // not worth waking anybody
+    f(data, first, last, thread->Index);
+    }
+  else
+    {
+    internals->Push(thread->Queue, &job, first, last);
+    internals->WaitForJob(thread, &job);
+    }
+
+  if (thread == &guest)
+    {
+    vtkThreadPoolSetThread(previous);
+    internals->ReleaseGuest(guest.Index - this->NumberOfThreads - 1);
+    }
+#else
+  // No thread support, the caller does all the work.
+  (void)grain;
+  f(data, first, last, 0);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadPool::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "Running Workers: "
+     << this->Internals->Workers.size() << "\n";
+}
@@ -0,0 +1,142 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkThreadPool - persistent work-stealing pool of worker threads
+// .SECTION Description
+// vtkThreadPool keeps a set of worker threads alive between parallel
+// executions so that the cost of creating and joining OS threads is paid
+// only once per process instead of once per execution (as is the case
+// with vtkMultiThreader::SingleMethodExecute()).
+//
+// Work is submitted as a range of ids [first, last) together with a grain
+// size. The range is recursively halved by the thread that owns it until
+// pieces are no larger than the grain; the upper halves are pushed on the
+// owning worker's queue where idle workers can steal them. Each worker
+// pops its own most recently pushed (smallest, cache-warm) piece and
+// steals the oldest (largest) piece of other workers, which keeps load
+// balanced with few synchronizations.
+//
+// The number of worker threads is not limited by VTK_MAX_THREADS. By
+// default it is the number of processors of the machine.
+//
+// A process-wide pool is available through GetInstance(); it is used by
+// vtkMultiThreader when UseThreadPool is on. The thread that submits work
+// executes pending pieces until its work is done: any piece if it is a
+// worker (nested parallelism, which therefore does not dead-lock), the
+// pieces of its own work otherwise, so that the threads executing some
+// work are the workers and the thread that submitted it. A queued piece
+// wakes a single sleeping worker, and the submitting threads that wait.
+//
+// .SECTION Caveats
+// The function given to ParallelFor() is called concurrently and must not
+// wait on other pieces of the same execution. SetNumberOfThreads() must
+// not be called while an execution is in progress.
+//
+// .SECTION See Also
+// vtkMultiThreader
+
+#ifndef __vtkThreadPool_h
+#define __vtkThreadPool_h
+
+#include "vtkObject.h"
+
+//BTX
+// Function executed by the pool. It is called with the user data, a
+// sub-range [begin, end) of the submitted range and the index of the
+// calling thread, as returned by vtkThreadPool::GetThreadIndex().
+typedef void (*vtkThreadPoolFunctionType)(void *data, vtkIdType begin,
+                                          vtkIdType end, int threadId);
+
+class vtkThreadPoolInternals;
+
+class VTK_COMMON_EXPORT vtkThreadPoolCleanup
+{
+public:
+  vtkThreadPoolCleanup();
+  ~vtkThreadPoolCleanup();
+};
+//ETX
+
+class VTK_COMMON_EXPORT vtkThreadPool : public vtkObject
+{
+public:
+  static vtkThreadPool *New();
+  vtkTypeRevisionMacro(vtkThreadPool,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Return the process-wide pool. It is created on first use and
+  // destroyed when the program exits. Do not call Delete() on it.
+  static vtkThreadPool *GetInstance();
+
+  // Description:
+  // Set/Get the number of worker threads. Workers are started lazily by
+  // the first execution. Changing the value stops the running workers;
+  // new ones are started by the next execution. Values smaller than 1 are
+  // ignored. There is no upper limit.
+  void SetNumberOfThreads(int num);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Return 1 if the calling thread is one of the worker threads of this
+  // pool.
+  int IsWorkerThread();
+
+  // Description:
+  // Return the index of the calling thread: in [0, GetNumberOfThreads())
+  // for the workers of this pool, above GetNumberOfThreads() for the other
+  // threads while they execute a ParallelFor() of this pool (every such
+  // thread has its own index, the smallest free one), -1 otherwise.
+  int GetThreadIndex();
+
+  //BTX
+  // Description:
+  // Call f(data, begin, end, threadId) on sub-ranges of [first, last)
+  // that cover the range exactly once. Sub-ranges are no larger than
+  // grain (unless grain is smaller than 1, in which case a grain is
+  // chosen from the range size and the number of threads). A range no
+  // larger than the grain is processed by the calling thread. Returns
+  // when all sub-ranges have been processed.
+  void ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+                   vtkThreadPoolFunctionType f, void *data);
+  //ETX
+
+protected:
+  vtkThreadPool();
+  ~vtkThreadPool();
+
+  // Description:
+  // Start/stop the worker threads.
+  void StartWorkers();
+  void StopWorkers();
+
+  int NumberOfThreads;
+
+  //BTX
+  vtkThreadPoolInternals *Internals;
+  friend class vtkThreadPoolInternals;
+  friend class vtkThreadPoolCleanup;
+  //ETX
+
+private:
+  static vtkThreadPool *Instance;
+  //BTX
+  static vtkThreadPoolCleanup Cleanup;
+  //ETX
+
+  vtkThreadPool(const vtkThreadPool&);  // Not implemented.
+  void operator=(const vtkThreadPool&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,305 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the queries of vtkBVHCellLocator with brute force searches over
+// all the cells, and the batched line intersections on one and several
+// threads with the single line ones.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadPool.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
+
+#include <math.h>
+
+// A closed bumpy surface of triangles.
+static vtkSmartPointer<vtkPolyData> MakeSurface()
+{
+  const int nTheta = 40, nPhi = 80;
+  vtkSmartPointer<vtkPoints> pts = vtkSmartPointer<vtkPoints>::New();
+  vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+  int i, j;
+  for (i = 0; i <= nTheta; i++)
+    {
+    double theta = vtkMath::Pi() * i / nTheta;
+    for (j = 0; j < nPhi; j++)
+      {
+      double phi = 2.0 * vtkMath::Pi() * j / nPhi;
+      double r = 1.0 + 0.2 * sin(5.0 * theta) * cos(3.0 * phi);
+      pts->InsertNextPoint(r * sin(theta) * cos(phi),
+                           r * sin(theta) * sin(phi), r * cos(theta));
+      }
+    }
+  for (i = 0; i < nTheta; i++)
+    {
+    for (j = 0; j < nPhi; j++)
+      {
+      vtkIdType a = i * nPhi + j, b = i * nPhi + (j + 1) % nPhi;
+      vtkIdType tri[3];
+      tri[0] = a; tri[1] = b; tri[2] = a + nPhi;
+      polys->InsertNextCell(3, tri);
+      tri[0] = b; tri[1] = b + nPhi; tri[2] = a + nPhi;
+      polys->InsertNextCell(3, tri);
+      }
+    }
+  vtkSmartPointer<vtkPolyData> pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(pts);
+  pd->SetPolys(polys);
+  return pd;
+}
+
+static void RandomPoint(double range, double x[3])
+{
+  for (int i = 0; i < 3; i++)
+    {
+    x[i] = vtkMath::Random(-range, range);
+    }
+}
+
+static int TestLines(vtkPolyData *surface, vtkBVHCellLocator *locator)
+{
+  const vtkIdType numLines = 1000;
+  vtkSmartPointer<vtkPoints> p1s = vtkSmartPointer<vtkPoints>::New();
+  vtkSmartPointer<vtkPoints> p2s = vtkSmartPointer<vtkPoints>::New();
+  p1s->SetDataTypeToDouble();
+  p2s->SetDataTypeToDouble();
+  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+  vtkstd::vector<vtkIdType> hitIds(numLines);
+  vtkstd::vector<double> hitTs(numLines);
+  double p1[3], p2[3], t, x[3], pcoords[3];
+  int subId;
+  vtkIdType i, cellId;
+  for (i = 0; i < numLines; i++)
+    {
+    // Half of the lines start inside the surface, most others cross it.
+    RandomPoint(i % 2 ? 0.5 : 2.0, p1);
+    RandomPoint(2.0, p2);
+    p1s->InsertNextPoint(p1);
+    p2s->InsertNextPoint(p2);
+
+    vtkIdType bestId = -1;
+    double bestT = 0.0;
+    for (cellId = 0; cellId < surface->GetNumberOfCells(); cellId++)
+      {
+      surface->GetCell(cellId, cell);
+      if (cell->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId) &&
+          (bestId < 0 || t < bestT))
+        {
+        bestId = cellId;
+        bestT = t;
+        }
+      }
+    if (!locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId,
+                                    cellId, cell))
+      {
+      cellId = -1;
+      }
+    if (cellId != bestId || (cellId >= 0 && t != bestT))
+      {
+      cerr << "IntersectWithLine() differs for line " << i << "\n";
+      return 0;
+      }
+    hitIds[i] = cellId;
+    hitTs[i] = t;
+    }
+
+  vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkDoubleArray> ts = vtkSmartPointer<vtkDoubleArray>::New();
+  vtkSmartPointer<vtkPoints> xs = vtkSmartPointer<vtkPoints>::New();
+  for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+    {
+    vtkThreadPool::GetInstance()->SetNumberOfThreads(numThreads);
+    locator->IntersectWithLines(p1s, p2s, 0.0, cellIds, ts, xs);
+    if (cellIds->GetNumberOfIds() != numLines ||
+        ts->GetNumberOfTuples() != numLines ||
+        xs->GetNumberOfPoints() != numLines)
+      {
+      cerr << "IntersectWithLines() returned "
+           << cellIds->GetNumberOfIds() << " ids\n";
+      return 0;
+      }
+    for (i = 0; i < numLines; i++)
+      {
+      if (cellIds->GetId(i) != hitIds[i] ||
+          (hitIds[i] >= 0 && ts->GetValue(i) != hitTs[i]))
+        {
+        cerr << "IntersectWithLines() differs for line " << i << " on "
+             << numThreads << " threads\n";
+        return 0;
+        }
+      }
+    }
+
+  // Without a tree every line misses, with one value in every output.
+  vtkSmartPointer<vtkBVHCellLocator> empty =
+    vtkSmartPointer<vtkBVHCellLocator>::New();
+  empty->IntersectWithLines(p1s, p2s, 0.0, cellIds, ts, xs);
+  if (cellIds->GetNumberOfIds() != numLines ||
+      ts->GetNumberOfTuples() != numLines ||
+      xs->GetNumberOfPoints() != numLines || cellIds->GetId(0) != -1)
+    {
+    cerr << "IntersectWithLines() without a tree returned "
+         << cellIds->GetNumberOfIds() << " ids, "
+         << ts->GetNumberOfTuples() << " ts and "
+         << xs->GetNumberOfPoints() << " points\n";
+    return 0;
+    }
+  return 1;
+}
+
+static int TestClosestPoints(vtkPolyData *surface, vtkBVHCellLocator *locator)
+{
+  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+  double x[3], closest[3], pcoords[3], weights[3], dist2, bestDist2;
+  int subId;
+  vtkIdType cellId;
+  for (int i = 0; i < 200; i++)
+    {
+    RandomPoint(2.0, x);
+    bestDist2 = VTK_DOUBLE_MAX;
+    for (cellId = 0; cellId < surface->GetNumberOfCells(); cellId++)
+      {
+      surface->GetCell(cellId, cell);
+      if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2,
+                                 weights) != -1 && dist2 < bestDist2)
+        {
+        bestDist2 = dist2;
+        }
+      }
+    locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    if (cellId < 0 || fabs(dist2 - bestDist2) > 1.0e-12)
+      {
+      cerr << "FindClosestPoint() differs for point " << i << "\n";
+      return 0;
+      }
+    int inside;
+    double radius = sqrt(bestDist2) * (i % 2 ? 0.99 : 1.01);
+    vtkIdType found = locator->FindClosestPointWithinRadius(
+      x, radius, closest, cell, cellId, subId, dist2, inside);
+    if (found != (i % 2 ? 0 : 1))
+      {
+      cerr << "FindClosestPointWithinRadius() differs for point " << i
+           << "\n";
+      return 0;
+      }
+    }
+  return 1;
+}
+
+static int TestBounds(vtkPolyData *surface, vtkBVHCellLocator *locator)
+{
+  vtkSmartPointer<vtkIdList> cells = vtkSmartPointer<vtkIdList>::New();
+  double x[3], bbox[6], cellBounds[6];
+  for (int i = 0; i < 50; i++)
+    {
+    RandomPoint(1.2, x);
+    for (int j = 0; j < 3; j++)
+      {
+      bbox[2*j] = x[j] - 0.2;
+      bbox[2*j+1] = x[j] + 0.2;
+      }
+    vtkstd::vector<vtkIdType> expected;
+    for (vtkIdType cellId = 0; cellId < surface->GetNumberOfCells(); cellId++)
+      {
+      surface->GetCellBounds(cellId, cellBounds);
+      if (cellBounds[0] <= bbox[1] && cellBounds[1] >= bbox[0] &&
+          cellBounds[2] <= bbox[3] && cellBounds[3] >= bbox[2] &&
+          cellBounds[4] <= bbox[5] && cellBounds[5] >= bbox[4])
+        {
+        expected.push_back(cellId);
+        }
+      }
+    locator->FindCellsWithinBounds(bbox, cells);
+    vtkstd::vector<vtkIdType> found(cells->GetPointer(0),
+                                    cells->GetPointer(0) +
+                                    cells->GetNumberOfIds());
+    vtkstd::sort(found.begin(), found.end());
+    if (found != expected)
+      {
+      cerr << "FindCellsWithinBounds() differs for box " << i << "\n";
+      return 0;
+      }
+    }
+  return 1;
+}
+
+static int TestFindCell()
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(21, 17, 13);
+  image->SetOrigin(-1.0, -0.8, -0.6);
+  image->SetSpacing(0.1, 0.1, 0.1);
+  vtkSmartPointer<vtkBVHCellLocator> locator =
+    vtkSmartPointer<vtkBVHCellLocator>::New();
+  locator->SetDataSet(image);
+  locator->BuildLocator();
+
+  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+  double x[3], pcoords[3], weights[8];
+  int subId;
+  for (int i = 0; i < 500; i++)
+    {
+    // Points of the image, and points a little outside of it.
+    RandomPoint(1.0, x);
+    x[1] *= 0.8;
+    x[2] *= 0.6;
+    vtkIdType expected =
+      image->FindCell(x, NULL, cell, -1, 0.0, subId, pcoords, weights);
+    if (i % 2)
+      {
+      x[i % 3] += (x[i % 3] < 0.0 ? -1.0 : 1.0);
+      expected = -1;
+      }
+    if (locator->FindCell(x, 0.0, cell, pcoords, weights) != expected)
+      {
+      cerr << "FindCell() differs for point " << i << "\n";
+      return 0;
+      }
+    }
+  return 1;
+}
+
+int TestBVHCellLocator(int, char *[])
+{
+  vtkMath::RandomSeed(8775070);
+  vtkSmartPointer<vtkPolyData> surface = MakeSurface();
+
+  // Few cells per leaf and many cells per subtree built in parallel.
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+  vtkSmartPointer<vtkBVHCellLocator> locator =
+    vtkSmartPointer<vtkBVHCellLocator>::New();
+  locator->SetDataSet(surface);
+  locator->SetNumberOfCellsPerNode(2);
+  locator->BuildLocator();
+  if (locator->GetNumberOfNodes() < surface->GetNumberOfCells() - 1)
+    {
+    cerr << "Too few nodes: " << locator->GetNumberOfNodes() << "\n";
+    return 1;
+    }
+
+  int success = TestLines(surface, locator) &&
+    TestClosestPoints(surface, locator) &&
+    TestBounds(surface, locator) && TestFindCell();
+  return success ? 0 : 1;
+}
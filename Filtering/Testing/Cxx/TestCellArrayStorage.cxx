@@ -0,0 +1,289 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkCellArray gives the same cells with the legacy and the
+// offsets storage, and the conversions between them.
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#define NUM_CELLS 500
+
+// Compare the traversal and random access of two cell arrays.
+static int CompareCells(vtkCellArray *a, vtkCellArray *b, const char *what)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells() ||
+      a->GetNumberOfConnectivityEntries() !=
+      b->GetNumberOfConnectivityEntries())
+    {
+    cerr << what << ": sizes differ\n";
+    return 1;
+    }
+
+  // The cursors read the cells without converting them.
+  vtkIdType cellId, i, nptsA, nptsB;
+  const vtkIdType *ptsA, *ptsB;
+  vtkCellArrayCursor cursorA, cursorB;
+  vtkIdList *bufA = vtkIdList::New();
+  vtkIdList *bufB = vtkIdList::New();
+  vtkIdList *idsA = vtkIdList::New();
+  vtkIdList *idsB = vtkIdList::New();
+  int errors = 0;
+  a->InitTraversal(cursorA);
+  b->InitTraversal(cursorB);
+  for (cellId = 0; a->GetNextCell(cursorA, nptsA, ptsA, bufA); cellId++)
+    {
+    if (!b->GetNextCell(cursorB, nptsB, ptsB, bufB) || nptsA != nptsB ||
+        cursorA.Location != cursorB.Location)
+      {
+      errors++;
+      break;
+      }
+    for (i = 0; i < nptsA; i++)
+      {
+      if (ptsA[i] != ptsB[i])
+        {
+        errors++;
+        }
+      }
+    a->GetCellAtId(cellId, idsA);
+    b->GetCellAtId(cellId, idsB);
+    if (a->GetCellSize(cellId) != nptsA ||
+        idsA->GetNumberOfIds() != nptsA || idsB->GetNumberOfIds() != nptsA ||
+        idsA->GetId(nptsA-1) != idsB->GetId(nptsA-1))
+      {
+      errors++;
+      }
+    }
+  if (cellId != a->GetNumberOfCells() ||
+      b->GetNextCell(cursorB, nptsB, ptsB, bufB) ||
+      a->GetMaxCellSize() != b->GetMaxCellSize())
+    {
+    errors++;
+    }
+  bufA->Delete();
+  bufB->Delete();
+  idsA->Delete();
+  idsB->Delete();
+  if (errors)
+    {
+    cerr << what << ": the cells differ\n";
+    }
+  return (errors ? 1 : 0);
+}
+
+int TestCellArrayStorage(int, char *[])
+{
+  int errors = 0;
+  vtkIdType i, j, pts[8];
+
+  // The same cells, of 1 to 8 points, in both storage modes.
+  vtkCellArray *legacy = vtkCellArray::New();
+  vtkCellArray *offsets = vtkCellArray::New();
+  offsets->SetStorageModeToOffsets();
+  for (i = 0; i < NUM_CELLS; i++)
+    {
+    vtkIdType npts = i % 8 + 1;
+    for (j = 0; j < npts; j++)
+      {
+      pts[j] = (7 * i + j) % 1000;
+      }
+    legacy->InsertNextCell(npts, pts);
+    offsets->InsertNextCell(npts, pts);
+    }
+
+  // Cells built point by point.
+  legacy->InsertNextCell(3);
+  offsets->InsertNextCell(3);
+  for (j = 0; j < 3; j++)
+    {
+    legacy->InsertCellPoint(j + 10);
+    offsets->InsertCellPoint(j + 10);
+    }
+  legacy->UpdateCellCount(3);
+  offsets->UpdateCellCount(3);
+  errors += CompareCells(legacy, offsets, "Insertion");
+
+  if (sizeof(vtkIdType) > sizeof(int) && !offsets->IsStorage32Bit())
+    {
+    cerr << "Small point ids should be stored with 32 bits\n";
+    errors++;
+    }
+  vtkDataArray *conn = offsets->GetConnectivityArray();
+  if (offsets->GetOffsetsArray()->GetNumberOfTuples() != NUM_CELLS + 2 ||
+      conn->GetNumberOfTuples() !=
+      offsets->GetNumberOfConnectivityEntries() - NUM_CELLS - 1)
+    {
+    cerr << "Wrong sizes of the offsets and connectivity arrays\n";
+    errors++;
+    }
+
+  // Modifications by location.
+  vtkIdType loc = legacy->GetInsertLocation(3);
+  vtkIdType npts, *cellPts;
+  legacy->ReverseCell(loc);
+  offsets->ReverseCell(loc);
+  const vtkIdType *reversed;
+  vtkIdList *buffer = vtkIdList::New();
+  offsets->GetCell(loc, npts, reversed, buffer);
+  if (npts != 3 || reversed[0] != 12)
+    {
+    cerr << "ReverseCell failed\n";
+    errors++;
+    }
+  buffer->Delete();
+  pts[0] = 1; pts[1] = 2; pts[2] = 3;
+  legacy->ReplaceCell(0, 1, pts);
+  offsets->ReplaceCell(0, 1, pts);
+  errors += CompareCells(legacy, offsets, "Replacement");
+
+  // Copies and conversions.
+  vtkCellArray *copy = vtkCellArray::New();
+  copy->DeepCopy(offsets);
+  errors += CompareCells(legacy, copy, "DeepCopy");
+  copy->SetStorageModeToLegacy();
+  errors += CompareCells(legacy, copy, "Conversion to legacy");
+  if (copy->GetData()->GetMaxId() + 1 != legacy->GetData()->GetMaxId() + 1)
+    {
+    cerr << "Wrong legacy list\n";
+    errors++;
+    }
+  copy->SetStorageModeToOffsets();
+  errors += CompareCells(legacy, copy, "Conversion to offsets");
+
+  // GetPointer() converts the cells back to the list, so that writes
+  // through it reach the cells.
+  vtkIdType size = legacy->GetNumberOfConnectivityEntries();
+  vtkIdType *list = copy->GetPointer();
+  for (i = 0; i < size && list[i] == legacy->GetPointer()[i]; i++)
+    {
+    }
+  if (i < size || copy->GetPointer() != list ||
+      copy->GetStorageMode() != VTK_CELL_ARRAY_LEGACY_STORAGE)
+    {
+    cerr << "GetPointer gave a wrong list or kept the offsets\n";
+    errors++;
+    }
+  vtkIdList *ids = vtkIdList::New();
+  list[1] = 7;
+  copy->GetCellAtId(0, ids);
+  if (ids->GetNumberOfIds() != 1 || ids->GetId(0) != 7)
+    {
+    cerr << "A write through GetPointer was lost\n";
+    errors++;
+    }
+  list[1] = legacy->GetPointer()[1];
+  ids->Delete();
+  copy->SetStorageModeToOffsets();
+  copy->InsertNextCell(1, pts);
+  if (copy->GetData()->GetNumberOfTuples() != size + 2 ||
+      copy->GetPointer()[size+1] != pts[0])
+    {
+    cerr << "GetData gave a stale list\n";
+    errors++;
+    }
+  copy->SetStorageModeToOffsets();
+
+  // Writable pointers to 32 bit cells convert them to vtkIdType.
+  copy->GetCell(0, npts, cellPts);
+  if (copy->IsStorage32Bit() ||
+      copy->GetStorageMode() != VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    cerr << "GetCell did not convert the 32 bit cells\n";
+    errors++;
+    }
+  copy->WritePointer(0, 0);
+  if (copy->GetStorageMode() != VTK_CELL_ARRAY_LEGACY_STORAGE)
+    {
+    cerr << "WritePointer did not convert to the legacy storage\n";
+    errors++;
+    }
+
+  // Large point ids switch to 64 bit arrays.
+  if (sizeof(vtkIdType) > sizeof(int))
+    {
+    vtkCellArray *wide = vtkCellArray::New();
+    wide->DeepCopy(offsets);
+    pts[0] = 5;
+    pts[1] = static_cast<vtkIdType>(VTK_INT_MAX) + 10;
+    legacy->InsertNextCell(2, pts);
+    wide->InsertNextCell(2, pts);
+    if (wide->IsStorage32Bit())
+      {
+      cerr << "Large point ids were not widened\n";
+      errors++;
+      }
+    errors += CompareCells(legacy, wide, "Widening");
+    wide->Delete();
+    }
+
+  // Arrays given by the user.
+  vtkIntArray *o = vtkIntArray::New();
+  vtkIntArray *c = vtkIntArray::New();
+  o->InsertNextValue(0);
+  for (i = 0; i < NUM_CELLS; i++)
+    {
+    c->InsertNextValue(i);
+    c->InsertNextValue(i + 1);
+    o->InsertNextValue(2 * (i + 1));
+    }
+  copy->SetData(o, c);
+  if (copy->GetNumberOfCells() != NUM_CELLS ||
+      copy->GetCellSize(NUM_CELLS-1) != 2 ||
+      copy->GetConnectivityArray() != c)
+    {
+    cerr << "SetData failed\n";
+    errors++;
+    }
+  o->Delete();
+
+  // A polydata using the offsets storage.
+  vtkPoints *points = vtkPoints::New();
+  for (i = 0; i < NUM_CELLS + 1; i++)
+    {
+    points->InsertNextPoint(i, 0.0, 0.0);
+    }
+  vtkPolyData *poly = vtkPolyData::New();
+  poly->SetPoints(points);
+  poly->SetLines(copy);
+  poly->BuildLinks();
+  poly->GetBounds();
+  if (copy->GetConnectivityArray() != c)
+    {
+    cerr << "Building the cells, links or bounds converted the cells\n";
+    errors++;
+    }
+  unsigned short ncells;
+  vtkIdType *cells;
+  poly->GetPointCells(10, ncells, cells);
+  poly->GetCellPoints(NUM_CELLS-1, npts, cellPts);
+  if (ncells != 2 || npts != 2 || cellPts[1] != NUM_CELLS)
+    {
+    cerr << "vtkPolyData does not use the offsets storage correctly\n";
+    errors++;
+    }
+
+  poly->Delete();
+  points->Delete();
+  c->Delete();
+  copy->Delete();
+  offsets->Delete();
+  legacy->Delete();
+
+  return errors;
+}
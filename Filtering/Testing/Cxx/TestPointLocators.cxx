@@ -18,8 +18,13 @@
 #include "vtkMath.h"
 #include "vtkPointLocator.h"
 #include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStructuredGrid.h"
+#include "vtkThreadPool.h"
 
+#include <vtkstd/algorithm>
 #include <vtkstd/vector>
 
 // returns true if 2 points are equidistant from x, within a tolerance
@@ -130,6 +135,8 @@ int ComparePointLocators()
   uniformLocator->SetDataSet(sgrid);
   vtkKdTreePointLocator* kdtree = vtkKdTreePointLocator::New();
   kdtree->SetDataSet(sgrid);
+  vtkStaticPointLocator* staticLocator = vtkStaticPointLocator::New();
+  staticLocator->SetDataSet(sgrid);
   
   double bounds[6];
   sgrid->GetBounds(bounds);
@@ -142,6 +149,7 @@ int ComparePointLocators()
   int numSearchPoints = 20;
   vtkIdList* uniformList = vtkIdList::New();
   vtkIdList* kdtreeList = vtkIdList::New();
+  vtkIdList* staticList = vtkIdList::New();
   for(i=0;i<numSearchPoints;i++)
     {
     double point[3] = {(bounds[0]+(bounds[1]-bounds[0])*i/numSearchPoints),
@@ -149,7 +157,9 @@ int ComparePointLocators()
                        (bounds[4]+(bounds[5]-bounds[4])*i/numSearchPoints)};
     vtkIdType uniformPt = uniformLocator->FindClosestPoint(point);
     vtkIdType kdtreePt = kdtree->FindClosestPoint(point);
-    if(!ArePointsEquidistant(point, uniformPt, kdtreePt, sgrid))
+    vtkIdType staticPt = staticLocator->FindClosestPoint(point);
+    if(!ArePointsEquidistant(point, uniformPt, kdtreePt, sgrid) ||
+       !ArePointsEquidistant(point, uniformPt, staticPt, sgrid))
       {
       cerr << " from FindClosestPoint.\n";
       rval++;
@@ -157,6 +167,7 @@ int ComparePointLocators()
     int N = 1+i*250/numSearchPoints; // test different amounts of points to search for
     uniformLocator->FindClosestNPoints(N, point, uniformList);  
     kdtree->FindClosestNPoints(N, point, kdtreeList);
+    staticLocator->FindClosestNPoints(N, point, staticList);
     if(!ArePointsEquidistant(point, uniformPt, uniformList->GetId(0), sgrid))
       {
       cerr << "for comparing FindClosestPoint and first result of FindClosestNPoints for uniform locator.\n";      
@@ -170,7 +181,8 @@ int ComparePointLocators()
     
     for(j=0;j<N;j++)
       {
-      if(!ArePointsEquidistant(point, kdtreeList->GetId(j), uniformList->GetId(j), sgrid))
+      if(!ArePointsEquidistant(point, kdtreeList->GetId(j), uniformList->GetId(j), sgrid) ||
+         !ArePointsEquidistant(point, staticList->GetId(j), uniformList->GetId(j), sgrid))
         {
         cerr << "for point " << j << " for ClosestNPoints search.\n";
         rval++;
@@ -179,8 +191,11 @@ int ComparePointLocators()
     double radius = 10;
     uniformLocator->FindPointsWithinRadius(radius, point, uniformList);
     kdtree->FindPointsWithinRadius(radius, point, kdtreeList);
+    staticLocator->FindPointsWithinRadius(radius, point, staticList);
     if(!DoesListHaveProperPoints(point, uniformList, kdtreeList, sgrid) ||
-       !DoesListHaveProperPoints(point, kdtreeList, uniformList, sgrid))
+       !DoesListHaveProperPoints(point, kdtreeList, uniformList, sgrid) ||
+       staticList->GetNumberOfIds() != uniformList->GetNumberOfIds() ||
+       !DoesListHaveProperPoints(point, staticList, uniformList, sgrid))
       {
       cerr << "Problem with FindPointsWithinRadius\n";
       rval++;
@@ -189,15 +204,17 @@ int ComparePointLocators()
     double dist2;
     uniformPt = uniformLocator->FindClosestPointWithinRadius(radius, point, dist2);
     kdtreePt = kdtree->FindClosestPointWithinRadius(radius, point, dist2);
-    if(uniformPt < 0 || kdtreePt < 0)
+    staticPt = staticLocator->FindClosestPointWithinRadius(radius, point, dist2);
+    if(uniformPt < 0 || kdtreePt < 0 || staticPt < 0)
       {
-      if(uniformPt >=0 || kdtreePt >= 0)
+      if(uniformPt >=0 || kdtreePt >= 0 || staticPt >= 0)
         {
         cerr << "Inconsistent results for FindClosestPointWithinRadius\n";
         rval++;
         }
       }
-    else if(!ArePointsEquidistant(point, uniformPt, kdtreePt, sgrid))
+    else if(!ArePointsEquidistant(point, uniformPt, kdtreePt, sgrid) ||
+            !ArePointsEquidistant(point, uniformPt, staticPt, sgrid))
       {
       cerr << "Incorrect result for FindClosestPointWithinRadius.\n";
       rval++;
@@ -216,7 +233,9 @@ int ComparePointLocators()
 
   uniformList->Delete();
   kdtreeList->Delete();
+  staticList->Delete();
 
+  staticLocator->Delete();
   kdtree->Delete();
   uniformLocator->Delete();
   sgrid->Delete();
@@ -298,10 +317,115 @@ int TestKdTreePointLocator()
   return rval;
 }
 
+// Query the static point locator from several threads and check the
+// results against brute force searches.
+class StaticLocatorQueries
+{
+public:
+  vtkStaticPointLocator *Locator;
+  vtkPoints *Points;
+  vtkPoints *Queries;
+  int *Errors; // one flag per query
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *result = vtkIdList::New();
+    double x[3], pt[3];
+    for (vtkIdType q = begin; q < end; q++)
+      {
+      this->Queries->GetPoint(q, x);
+      vtkIdType numPts = this->Points->GetNumberOfPoints();
+      vtkIdType closest = -1, numWithin = 0;
+      double minDist2 = VTK_DOUBLE_MAX, radius = 0.05;
+      vtkstd::vector<double> dist2(numPts);
+      for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+        {
+        this->Points->GetPoint(ptId, pt);
+        dist2[ptId] = vtkMath::Distance2BetweenPoints(x, pt);
+        if (dist2[ptId] < minDist2)
+          {
+          minDist2 = dist2[ptId];
+          closest = ptId;
+          }
+        numWithin += (dist2[ptId] <= radius*radius);
+        }
+      int error = 0;
+      if (this->Locator->FindClosestPoint(x) != closest)
+        {
+        error = 1;
+        }
+      this->Locator->FindPointsWithinRadius(radius, x, result);
+      if (result->GetNumberOfIds() != numWithin)
+        {
+        error = 1;
+        }
+      this->Locator->FindClosestNPoints(10, x, result);
+      vtkstd::vector<double> sorted(dist2);
+      vtkstd::sort(sorted.begin(), sorted.end());
+      for (vtkIdType i = 0; i < 10 && !error; i++)
+        {
+        error = (dist2[result->GetId(i)] != sorted[i]);
+        }
+      this->Errors[q] = error;
+      }
+    result->Delete();
+    }
+};
+
+int TestStaticPointLocator()
+{
+  // Use several workers even on single processor machines.
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+
+  vtkPoints *points = vtkPoints::New();
+  vtkPoints *queries = vtkPoints::New();
+  vtkMath::RandomSeed(8775070);
+  for (vtkIdType i = 0; i < 5000; i++)
+    {
+    points->InsertNextPoint(vtkMath::Random(), vtkMath::Random(),
+                            0.2 * vtkMath::Random());
+    }
+  for (vtkIdType i = 0; i < 200; i++)
+    {
+    queries->InsertNextPoint(vtkMath::Random(-0.5, 1.5),
+                             vtkMath::Random(-0.5, 1.5),
+                             vtkMath::Random(-0.5, 0.7));
+    }
+  vtkPolyData *cloud = vtkPolyData::New();
+  cloud->SetPoints(points);
+
+  vtkStaticPointLocator *locator = vtkStaticPointLocator::New();
+  locator->SetDataSet(cloud);
+  locator->BuildLocator();
+
+  StaticLocatorQueries check;
+  check.Locator = locator;
+  check.Points = points;
+  check.Queries = queries;
+  vtkstd::vector<int> errors(queries->GetNumberOfPoints());
+  check.Errors = &errors[0];
+  vtkSMPTools::For(0, queries->GetNumberOfPoints(), 1, check);
+
+  int rval = 0;
+  if (vtkstd::count(errors.begin(), errors.end(), 1) != 0)
+    {
+    cerr << "Wrong results from threaded queries of vtkStaticPointLocator\n";
+    rval++;
+    }
+
+  locator->Delete();
+  cloud->Delete();
+  queries->Delete();
+  points->Delete();
+
+  return rval;
+}
+
 int TestPointLocators(int , char *[])
 {
   int rval = ComparePointLocators();
   rval += TestKdTreePointLocator();
+  rval += TestStaticPointLocator();
 
   return rval;
 }
@@ -0,0 +1,182 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the links built by vtkStaticCellLinks on several threads, and
+// the edge neighbors found with them, with the ones of vtkCellLinks.
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
+#include "vtkThreadPool.h"
+#include "vtkUnstructuredGrid.h"
+
+static int CompareLinks(vtkDataSet *ds, const char *what)
+{
+  vtkCellLinks *links = vtkCellLinks::New();
+  links->Allocate(ds->GetNumberOfPoints());
+  links->BuildLinks(ds);
+  vtkStaticCellLinks *staticLinks = vtkStaticCellLinks::New();
+  staticLinks->BuildLinks(ds);
+
+  int errors = 0;
+  vtkIdType ptId, i, size = 0;
+  for (ptId = 0; ptId < ds->GetNumberOfPoints() && !errors; ptId++)
+    {
+    vtkIdType ncells = links->GetNcells(ptId);
+    size += ncells;
+    if (staticLinks->GetNcells(ptId) != ncells)
+      {
+      errors++;
+      }
+    for (i = 0; i < ncells && !errors; i++)
+      {
+      if (staticLinks->GetCells(ptId)[i] != links->GetCells(ptId)[i])
+        {
+        errors++;
+        }
+      }
+    }
+  if (errors || staticLinks->GetLinksSize() != size ||
+      staticLinks->GetNumberOfPoints() != ds->GetNumberOfPoints())
+    {
+    cerr << what << ": the links differ at point " << ptId-1 << "\n";
+    errors = 1;
+    }
+
+  vtkStaticCellLinks *copy = vtkStaticCellLinks::New();
+  copy->DeepCopy(staticLinks);
+  if (copy->GetLinksSize() != size ||
+      copy->GetNcells(0) != staticLinks->GetNcells(0))
+    {
+    cerr << what << ": DeepCopy failed\n";
+    errors = 1;
+    }
+
+  copy->Delete();
+  staticLinks->Delete();
+  links->Delete();
+  return errors;
+}
+
+int TestStaticCellLinks(int, char *[])
+{
+  int errors = 0;
+  vtkIdType i, j, pts[8];
+  const vtkIdType numPts = 3000;
+
+  // Use several workers even on single processor machines.
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+
+  vtkPoints *points = vtkPoints::New();
+  for (i = 0; i < numPts; i++)
+    {
+    points->InsertNextPoint(i, 2 * i, 3 * i);
+    }
+
+  // Mixed polygons, lines and vertices; the last points are not used.
+  vtkCellArray *polys = vtkCellArray::New();
+  vtkCellArray *verts = vtkCellArray::New();
+  for (i = 0; i < 20000; i++)
+    {
+    vtkIdType npts = i % 6 + 3;
+    for (j = 0; j < npts; j++)
+      {
+      pts[j] = (17 * i + 5 * j) % (numPts - 10);
+      }
+    polys->InsertNextCell(npts, pts);
+    if (i % 10 == 0)
+      {
+      verts->InsertNextCell(1, pts);
+      }
+    }
+  vtkPolyData *pd = vtkPolyData::New();
+  pd->SetPoints(points);
+  pd->SetPolys(polys);
+  pd->SetVerts(verts);
+  pd->BuildCells(); // vtkCellLinks::BuildLinks() requires the cells.
+  errors += CompareLinks(pd, "vtkPolyData");
+
+  // Edge neighbors match the ones found with the links of the polydata.
+  vtkStaticCellLinks *pdLinks = vtkStaticCellLinks::New();
+  pdLinks->BuildLinks(pd);
+  pd->BuildLinks();
+  vtkIdList *ids = vtkIdList::New();
+  vtkIdList *staticIds = vtkIdList::New();
+  vtkIdType cellId, npts, *cellPts;
+  for (cellId = 0; cellId < pd->GetNumberOfCells(); cellId += 7)
+    {
+    pd->GetCellPoints(cellId, npts, cellPts);
+    vtkIdType p1 = cellPts[0], p2 = cellPts[npts > 1 ? 1 : 0];
+    pd->GetCellEdgeNeighbors(cellId, p1, p2, ids);
+    pdLinks->GetCellEdgeNeighbors(cellId, p1, p2, staticIds);
+    for (i = 0; i < ids->GetNumberOfIds() &&
+           i < staticIds->GetNumberOfIds() &&
+           ids->GetId(i) == staticIds->GetId(i); i++)
+      {
+      }
+    if (ids->GetNumberOfIds() != staticIds->GetNumberOfIds() ||
+        i < ids->GetNumberOfIds())
+      {
+      cerr << "Wrong edge neighbors of cell " << cellId << "\n";
+      errors++;
+      break;
+      }
+    }
+  staticIds->Delete();
+  ids->Delete();
+  pdLinks->Delete();
+
+  vtkUnstructuredGrid *ug = vtkUnstructuredGrid::New();
+  ug->SetPoints(points);
+  ug->Allocate(10000);
+  for (i = 0; i < 10000; i++)
+    {
+    for (j = 0; j < 8; j++)
+      {
+      pts[j] = (31 * i + 7 * j) % numPts;
+      }
+    ug->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+    }
+  errors += CompareLinks(ug, "vtkUnstructuredGrid");
+
+  vtkImageData *image = vtkImageData::New();
+  image->SetDimensions(15, 12, 10);
+  errors += CompareLinks(image, "vtkImageData");
+
+  // A dataset without cells.
+  vtkPolyData *empty = vtkPolyData::New();
+  empty->SetPoints(points);
+  vtkStaticCellLinks *links = vtkStaticCellLinks::New();
+  links->BuildLinks(empty);
+  if (links->GetNcells(numPts - 1) != 0 || links->GetLinksSize() != 0)
+    {
+    cerr << "Wrong links without cells\n";
+    errors++;
+    }
+
+  links->Delete();
+  empty->Delete();
+  image->Delete();
+  ug->Delete();
+  pd->Delete();
+  verts->Delete();
+  polys->Delete();
+  points->Delete();
+
+  return errors;
+}
@@ -0,0 +1,267 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Traverse the cells of datasets and cell arrays from several threads with
+// the thread-safe API and compare with a serial traversal.
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkDoubleArray.h"
+#include "vtkSMPTools.h"
+#include "vtkStructuredGrid.h"
+#include "vtkThreadPool.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtkstd/vector>
+
+// Combine the type and the point ids of a cell.
+static vtkIdType vtkTestCellChecksum(int type, vtkIdType npts,
+                                     const vtkIdType *pts)
+{
+  vtkIdType sum = 1000 * type + npts;
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    sum += (i + 1) * pts[i];
+    }
+  return sum;
+}
+
+// Checksums of the cells of a dataset, computed with GetCellType(),
+// GetCellPoints() and GetCell() with a vtkGenericCell, and their bounds.
+class vtkTestDataSetCells
+{
+public:
+  vtkDataSet *DataSet;
+  vtkIdType *Checksums;
+  int *Errors;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *ptIds = vtkIdList::New();
+    vtkGenericCell *cell = vtkGenericCell::New();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      int type = this->DataSet->GetCellType(cellId);
+      this->DataSet->GetCellPoints(cellId, npts, pts, ptIds);
+      this->Checksums[cellId] = vtkTestCellChecksum(type, npts, pts);
+      this->DataSet->GetCell(cellId, cell);
+      if (cell->GetCellType() != type ||
+          cell->GetNumberOfPoints() != npts ||
+          (npts > 0 && cell->GetPointId(npts-1) != pts[npts-1]))
+        {
+        this->Errors[cellId] = 1;
+        }
+      double bounds[6], x[3];
+      this->DataSet->GetCellBounds(cellId, bounds);
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        this->DataSet->GetPoint(pts[i], x);
+        if (x[0] < bounds[0] || x[0] > bounds[1] || x[1] < bounds[2] ||
+            x[1] > bounds[3] || x[2] < bounds[4] || x[2] > bounds[5])
+          {
+          this->Errors[cellId] = 1;
+          }
+        }
+      }
+    cell->Delete();
+    ptIds->Delete();
+    }
+};
+
+// Checksums of the cells of a cell array traversed with cursors.
+class vtkTestCellArrayCells
+{
+public:
+  vtkCellArray *Cells;
+  vtkIdType *Checksums;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *ptIds = vtkIdList::New();
+    vtkCellArrayCursor cursor;
+    vtkIdType npts;
+    const vtkIdType *pts;
+    this->Cells->InitTraversal(cursor, begin);
+    for (vtkIdType cellId = begin;
+         cellId < end && this->Cells->GetNextCell(cursor, npts, pts, ptIds);
+         cellId++)
+      {
+      this->Checksums[cellId] = vtkTestCellChecksum(0, npts, pts);
+      }
+    ptIds->Delete();
+    }
+};
+
+static int TestDataSet(vtkDataSet *ds, const char *what)
+{
+  vtkIdType cellId, numCells = ds->GetNumberOfCells();
+  vtkstd::vector<vtkIdType> checksums(numCells, -1);
+  vtkstd::vector<int> errors(numCells, 0);
+
+  // The first call is made from a single thread.
+  vtkIdList *ptIds = vtkIdList::New();
+  ds->GetCellType(0);
+  ds->GetCellPoints(0, ptIds);
+
+  vtkTestDataSetCells cells;
+  cells.DataSet = ds;
+  cells.Checksums = &checksums[0];
+  cells.Errors = &errors[0];
+  vtkSMPTools::For(0, numCells, 100, cells);
+
+  int result = 0;
+  for (cellId = 0; cellId < numCells; cellId++)
+    {
+    ds->GetCellPoints(cellId, ptIds);
+    if (errors[cellId] || checksums[cellId] !=
+        vtkTestCellChecksum(ds->GetCellType(cellId),
+                            ptIds->GetNumberOfIds(), ptIds->GetPointer(0)))
+      {
+      cerr << what << ": cell " << cellId << " is wrong\n";
+      result = 1;
+      break;
+      }
+    }
+  ptIds->Delete();
+  return result;
+}
+
+static int TestCellArray(vtkCellArray *ca, const char *what)
+{
+  vtkIdType cellId, numCells = ca->GetNumberOfCells();
+  vtkstd::vector<vtkIdType> checksums(numCells, -1);
+
+  // Builds the table of locations of the legacy storage.
+  vtkIdList *ptIds = vtkIdList::New();
+  ca->GetCellAtId(0, ptIds);
+
+  vtkTestCellArrayCells cells;
+  cells.Cells = ca;
+  cells.Checksums = &checksums[0];
+  vtkSMPTools::For(0, numCells, 100, cells);
+
+  int result = 0;
+  for (cellId = 0; cellId < numCells; cellId++)
+    {
+    ca->GetCellAtId(cellId, ptIds);
+    if (checksums[cellId] != vtkTestCellChecksum(0, ptIds->GetNumberOfIds(),
+                                                 ptIds->GetPointer(0)))
+      {
+      cerr << what << ": cell " << cellId << " is wrong\n";
+      result = 1;
+      break;
+      }
+    }
+  ptIds->Delete();
+  return result;
+}
+
+int TestThreadedCellAccess(int, char *[])
+{
+  int errors = 0;
+  vtkIdType i, j, pts[8];
+  const int dim = 20;
+
+  // Use several workers even on single processor machines.
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+
+  vtkPoints *points = vtkPoints::New();
+  vtkDoubleArray *coords = vtkDoubleArray::New();
+  for (i = 0; i < dim; i++)
+    {
+    coords->InsertNextValue(i);
+    }
+  for (i = 0; i < dim*dim*dim; i++)
+    {
+    points->InsertNextPoint(i % dim, (i / dim) % dim, i / (dim*dim));
+    }
+
+  // Polygons of 3 to 7 points and lines.
+  vtkCellArray *polys = vtkCellArray::New();
+  vtkCellArray *lines = vtkCellArray::New();
+  for (i = 0; i < 5000; i++)
+    {
+    vtkIdType npts = i % 5 + 3;
+    for (j = 0; j < npts; j++)
+      {
+      pts[j] = (13 * i + 7 * j) % (dim*dim*dim);
+      }
+    polys->InsertNextCell(npts, pts);
+    lines->InsertNextCell(2, pts);
+    }
+  errors += TestCellArray(polys, "Legacy cell array");
+
+  vtkPolyData *pd = vtkPolyData::New();
+  pd->SetPoints(points);
+  pd->SetPolys(polys);
+  pd->SetLines(lines);
+  errors += TestDataSet(pd, "vtkPolyData");
+
+  // The same cells stored with offsets.
+  polys->SetStorageModeToOffsets();
+  lines->SetStorageModeToOffsets();
+  errors += TestCellArray(polys, "Offsets cell array");
+  pd->DeleteCells();
+  errors += TestDataSet(pd, "vtkPolyData with offsets");
+
+  vtkUnstructuredGrid *ug = vtkUnstructuredGrid::New();
+  ug->SetPoints(points);
+  ug->Allocate(5000);
+  for (i = 0; i < 5000; i++)
+    {
+    for (j = 0; j < 8; j++)
+      {
+      pts[j] = (11 * i + 3 * j) % (dim*dim*dim);
+      }
+    ug->InsertNextCell(i % 2 ? VTK_HEXAHEDRON : VTK_TETRA, i % 2 ? 8 : 4,
+                       pts);
+    }
+  errors += TestDataSet(ug, "vtkUnstructuredGrid");
+  ug->GetCells()->SetStorageModeToOffsets();
+  errors += TestDataSet(ug, "vtkUnstructuredGrid with offsets");
+
+  vtkImageData *image = vtkImageData::New();
+  image->SetDimensions(dim, dim, dim);
+  errors += TestDataSet(image, "vtkImageData");
+
+  vtkRectilinearGrid *rg = vtkRectilinearGrid::New();
+  rg->SetDimensions(dim, dim, 1);
+  rg->SetXCoordinates(coords);
+  rg->SetYCoordinates(coords);
+  errors += TestDataSet(rg, "vtkRectilinearGrid");
+
+  vtkStructuredGrid *sg = vtkStructuredGrid::New();
+  sg->SetDimensions(dim, dim, dim);
+  sg->SetPoints(points);
+  errors += TestDataSet(sg, "vtkStructuredGrid");
+
+  sg->Delete();
+  rg->Delete();
+  image->Delete();
+  ug->Delete();
+  pd->Delete();
+  lines->Delete();
+  polys->Delete();
+  coords->Delete();
+  points->Delete();
+
+  return errors;
+}
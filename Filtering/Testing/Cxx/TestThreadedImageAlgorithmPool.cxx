@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Execute a vtkThreadedImageAlgorithm on the thread pool. The threadIds
+// must stay below NumberOfThreads, no two threads may use one at the same
+// time, threadId 0 must be the thread that called Update(), and every
+// voxel must be written once.
+
+#include "vtkCriticalSection.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkThreadPool.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+#include <vtkstd/vector>
+
+// A source that counts the writes of every voxel and checks the threadIds.
+// The voxels of different pieces are different, so the counts need no
+// lock.
+class vtkTestPoolImageSource : public vtkThreadedImageAlgorithm
+{
+public:
+  static vtkTestPoolImageSource *New();
+  vtkTypeRevisionMacro(vtkTestPoolImageSource,vtkThreadedImageAlgorithm);
+
+  virtual void ThreadedRequestData(vtkInformation *,
+                                   vtkInformationVector **,
+                                   vtkInformationVector *,
+                                   vtkImageData ***,
+                                   vtkImageData **,
+                                   int extent[6], int threadId)
+    {
+    if (threadId < 0 || threadId >= this->NumberOfThreads)
+      {
+      this->Errors++;
+      return;
+      }
+    this->Lock.Lock();
+    if (this->Busy[threadId]++ ||
+        (threadId == 0) != vtkMultiThreader::ThreadsEqual(
+          this->Caller, vtkMultiThreader::GetCurrentThreadID()))
+      {
+      this->Errors++;
+      }
+    this->Lock.Unlock();
+
+    for (int k = extent[4]; k <= extent[5]; k++)
+      {
+      for (int j = extent[2]; j <= extent[3]; j++)
+        {
+        for (int i = extent[0]; i <= extent[1]; i++)
+          {
+          this->Writes[(k*30 + j)*20 + i]++;
+          }
+        }
+      }
+
+    this->Lock.Lock();
+    this->Busy[threadId]--;
+    this->Lock.Unlock();
+    }
+
+  vtkMultiThreaderIDType Caller;
+  int Errors;
+  vtkstd::vector<int> Writes;
+
+protected:
+  vtkTestPoolImageSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->Errors = 0;
+    this->Writes.resize(20*30*64, 0);
+    for (int i = 0; i < VTK_MAX_THREADS; i++)
+      {
+      this->Busy[i] = 0;
+      }
+    }
+
+  virtual int RequestInformation(vtkInformation *,
+                                 vtkInformationVector **,
+                                 vtkInformationVector *outputVector)
+    {
+    int ext[6] = { 0, 19, 0, 29, 0, 63 };
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext, 6);
+    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_INT, 1);
+    return 1;
+    }
+
+  vtkSimpleCriticalSection Lock;
+  int Busy[VTK_MAX_THREADS];
+
+private:
+  vtkTestPoolImageSource(const vtkTestPoolImageSource&);  // Not implemented.
+  void operator=(const vtkTestPoolImageSource&);  // Not implemented.
+};
+
+vtkCxxRevisionMacro(vtkTestPoolImageSource, "$Revision$");
+vtkStandardNewMacro(vtkTestPoolImageSource);
+
+int TestThreadedImageAlgorithmPool(int, char *[])
+{
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+
+  // fewer threadIds than the pool has threads, and more
+  int numbersOfThreads[3] = { 1, 3, 8 };
+  for (int t = 0; t < 3; t++)
+    {
+    for (int piecesPerThread = 1; piecesPerThread <= 5; piecesPerThread += 4)
+      {
+      vtkTestPoolImageSource *source = vtkTestPoolImageSource::New();
+      source->UseThreadPoolOn();
+      source->SetNumberOfThreads(numbersOfThreads[t]);
+      source->SetPiecesPerThread(piecesPerThread);
+      source->Caller = vtkMultiThreader::GetCurrentThreadID();
+      source->Update();
+
+      vtkIdType wrong = 0;
+      for (size_t i = 0; i < source->Writes.size(); i++)
+        {
+        wrong += (source->Writes[i] != 1);
+        }
+      int errors = source->Errors;
+      source->Delete();
+      if (errors || wrong)
+        {
+        cerr << "With " << numbersOfThreads[t] << " threads and "
+             << piecesPerThread << " pieces per thread: " << errors
+             << " wrong threadIds, " << wrong << " voxels not written once\n";
+        return 1;
+        }
+      }
+    }
+  return 0;
+}
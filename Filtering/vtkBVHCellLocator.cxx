@@ -0,0 +1,1138 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBVHCellLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/utility>
+#include <vtkstd/vector>
+
+#include <float.h>
+#include <math.h>
+
+vtkCxxRevisionMacro(vtkBVHCellLocator, "$Revision$");
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+//----------------------------------------------------------------------------
+// A node of the tree. Leaves have Count > 0 cells, which are
+// CellIds[Offset] to CellIds[Offset+Count-1]. Interior nodes have a Count
+// of 0 and their two children are Nodes[Offset] and Nodes[Offset+1].
+struct vtkBVHCellLocatorNode
+{
+  float Bounds[6];
+  int Offset;
+  int Count;
+};
+
+// Number of bins along each axis for the surface area heuristic.
+static const int vtkBVHCellLocatorNumberOfBins = 16;
+
+// Number of lines traversing the tree together in IntersectWithLines().
+static const int vtkBVHCellLocatorPacketSize = 8;
+
+//----------------------------------------------------------------------------
+// Round to the closest floats below and above a double, so that boxes
+// stored in single precision contain the boxes they were computed from.
+static inline float vtkBVHCellLocatorRoundDown(double x)
+{
+  float f = static_cast<float>(x);
+  if (f > x)
+    {
+    f = static_cast<float>(x - (x < 0.0 ? -x : x) * FLT_EPSILON - FLT_MIN);
+    }
+  return f;
+}
+
+static inline float vtkBVHCellLocatorRoundUp(double x)
+{
+  float f = static_cast<float>(x);
+  if (f < x)
+    {
+    f = static_cast<float>(x + (x < 0.0 ? -x : x) * FLT_EPSILON + FLT_MIN);
+    }
+  return f;
+}
+
+//----------------------------------------------------------------------------
+static inline double vtkBVHCellLocatorArea(const float b[6])
+{
+  double dx = b[1] - b[0];
+  double dy = b[3] - b[2];
+  double dz = b[5] - b[4];
+  if (dx < 0.0 || dy < 0.0 || dz < 0.0)
+    {
+    return 0.0;
+    }
+  return dx*dy + dy*dz + dz*dx;
+}
+
+static inline void vtkBVHCellLocatorEmpty(float b[6])
+{
+  b[0] = b[2] = b[4] = FLT_MAX;
+  b[1] = b[3] = b[5] = -FLT_MAX;
+}
+
+static inline void vtkBVHCellLocatorGrow(float b[6], const float c[6])
+{
+  for (int i = 0; i < 6; i += 2)
+    {
+    b[i] = (c[i] < b[i] ? c[i] : b[i]);
+    b[i+1] = (c[i+1] > b[i+1] ? c[i+1] : b[i+1]);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Squared distance from x to a box, 0 inside.
+static inline double vtkBVHCellLocatorDistance2(const float b[6],
+                                                const double x[3])
+{
+  double dist2 = 0.0;
+  for (int i = 0; i < 3; i++)
+    {
+    double d = (x[i] < b[2*i] ? b[2*i] - x[i] :
+                (x[i] > b[2*i+1] ? x[i] - b[2*i+1] : 0.0));
+    dist2 += d*d;
+    }
+  return dist2;
+}
+
+//----------------------------------------------------------------------------
+// Compute the single precision bounds of the cells, and the center of
+// these bounds. Cells without points get an empty box.
+class vtkBVHCellLocatorCellBounds
+{
+public:
+  vtkDataSet *DataSet;
+  const double *Center; // used for the cells without points
+  float *Bounds;
+  float *Centers;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkGenericCell *cell = vtkGenericCell::New();
+    double *b;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      float *bounds = this->Bounds + 6*cellId;
+      float *center = this->Centers + 3*cellId;
+      this->DataSet->GetCell(cellId, cell);
+      if (cell->GetNumberOfPoints() < 1)
+        {
+        vtkBVHCellLocatorEmpty(bounds);
+        for (int i = 0; i < 3; i++)
+          {
+          center[i] = static_cast<float>(this->Center[i]);
+          }
+        continue;
+        }
+      b = cell->GetBounds();
+      for (int i = 0; i < 3; i++)
+        {
+        bounds[2*i] = vtkBVHCellLocatorRoundDown(b[2*i]);
+        bounds[2*i+1] = vtkBVHCellLocatorRoundUp(b[2*i+1]);
+        center[i] = static_cast<float>(0.5 * (b[2*i] + b[2*i+1]));
+        }
+      }
+    cell->Delete();
+    }
+};
+
+//----------------------------------------------------------------------------
+// Tell whether a cell goes to the first child of a split.
+class vtkBVHCellLocatorInFirstChild
+{
+public:
+  const float *Centers;
+  int Axis;
+  double Min;
+  double Scale;
+  int Bin;
+
+  bool operator()(vtkIdType cellId) const
+    {
+    int bin = static_cast<int>(
+      (this->Centers[3*cellId+this->Axis] - this->Min) * this->Scale);
+    return (bin < 0 ? 0 : bin) < this->Bin;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Build trees over ranges of CellIds. The nodes are numbered as they are
+// created, the root of a tree first, and the two children of a node are
+// always consecutive.
+class vtkBVHCellLocatorBuilder
+{
+public:
+  const float *Bounds;
+  const float *Centers;
+  vtkIdType *CellIds;
+  int MaximumLeafSize;
+
+  // A node whose cells are CellIds[Begin] to CellIds[End-1].
+  struct Range
+  {
+    vtkIdType Node;
+    vtkIdType Begin;
+    vtkIdType End;
+  };
+
+  // Compute the bounds of the cells of the range, and sort them in two
+  // children with the surface area heuristic. Return the number of cells
+  // of the first child, 0 when the cells should stay in a leaf.
+  vtkIdType Split(const Range& range, float nodeBounds[6])
+    {
+    const vtkIdType n = range.End - range.Begin;
+    vtkIdType *ids = this->CellIds + range.Begin;
+    float centerBounds[6];
+    vtkIdType i;
+    vtkBVHCellLocatorEmpty(nodeBounds);
+    vtkBVHCellLocatorEmpty(centerBounds);
+    for (i = 0; i < n; i++)
+      {
+      const float *c = this->Centers + 3*ids[i];
+      float point[6] = { c[0], c[0], c[1], c[1], c[2], c[2] };
+      vtkBVHCellLocatorGrow(nodeBounds, this->Bounds + 6*ids[i]);
+      vtkBVHCellLocatorGrow(centerBounds, point);
+      }
+    if (n < 2)
+      {
+      return 0;
+      }
+
+    // Bin the centers along each axis, and sweep the bins to evaluate
+    // the cost of the splits between consecutive bins.
+    const int nBins = vtkBVHCellLocatorNumberOfBins;
+    double bestCost = VTK_DOUBLE_MAX, bestScale = 0.0;
+    int bestAxis = -1, bestBin = 0;
+    for (int axis = 0; axis < 3; axis++)
+      {
+      double min = centerBounds[2*axis];
+      double extent = centerBounds[2*axis+1] - min;
+      if (extent <= 0.0)
+        {
+        continue;
+        }
+      double scale = nBins * (1.0 - 1.0e-6) / extent;
+      vtkIdType counts[vtkBVHCellLocatorNumberOfBins];
+      float bins[vtkBVHCellLocatorNumberOfBins][6];
+      int b;
+      for (b = 0; b < nBins; b++)
+        {
+        counts[b] = 0;
+        vtkBVHCellLocatorEmpty(bins[b]);
+        }
+      for (i = 0; i < n; i++)
+        {
+        b = static_cast<int>((this->Centers[3*ids[i]+axis] - min) * scale);
+        b = (b < 0 ? 0 : (b >= nBins ? nBins - 1 : b));
+        counts[b]++;
+        vtkBVHCellLocatorGrow(bins[b], this->Bounds + 6*ids[i]);
+        }
+
+      // Cost of the bins b to nBins-1, then of the bins 0 to b-1.
+      double rightCosts[vtkBVHCellLocatorNumberOfBins];
+      vtkIdType rightCounts[vtkBVHCellLocatorNumberOfBins];
+      float box[6];
+      vtkIdType count = 0;
+      vtkBVHCellLocatorEmpty(box);
+      for (b = nBins - 1; b > 0; b--)
+        {
+        vtkBVHCellLocatorGrow(box, bins[b]);
+        count += counts[b];
+        rightCounts[b] = count;
+        rightCosts[b] = vtkBVHCellLocatorArea(box) * count;
+        }
+      count = 0;
+      vtkBVHCellLocatorEmpty(box);
+      for (b = 1; b < nBins; b++)
+        {
+        vtkBVHCellLocatorGrow(box, bins[b-1]);
+        count += counts[b-1];
+        if (count == 0 || rightCounts[b] == 0)
+          {
+          continue;
+          }
+        double cost = vtkBVHCellLocatorArea(box) * count + rightCosts[b];
+        if (cost < bestCost)
+          {
+          bestCost = cost;
+          bestAxis = axis;
+          bestBin = b;
+          bestScale = scale;
+          }
+        }
+      }
+
+    if (bestAxis < 0)
+      {
+      // All the centers are at the same position: split the cells in two
+      // halves if there are too many of them.
+      return (n > this->MaximumLeafSize ? n / 2 : 0);
+      }
+
+    // A ray traverses a node with a probability proportional to its area.
+    // Testing a cell costs about as much as traversing a node.
+    double area = vtkBVHCellLocatorArea(nodeBounds);
+    if (n <= this->MaximumLeafSize && n * area <= area + bestCost)
+      {
+      return 0;
+      }
+
+    vtkBVHCellLocatorInFirstChild inFirst;
+    inFirst.Centers = this->Centers;
+    inFirst.Axis = bestAxis;
+    inFirst.Min = centerBounds[2*bestAxis];
+    inFirst.Scale = bestScale;
+    inFirst.Bin = bestBin;
+    return vtkstd::partition(ids, ids + n, inFirst) - ids;
+    }
+
+  // Split a node, appending its children to nodes, or make it a leaf.
+  // Return 1 if the node was split. Its children are pushed on the stack.
+  int BuildNode(const Range& range,
+                vtkstd::vector<vtkBVHCellLocatorNode>& nodes,
+                vtkstd::vector<Range>& stack)
+    {
+    vtkBVHCellLocatorNode node;
+    vtkIdType nFirst = this->Split(range, node.Bounds);
+    if (nFirst == 0)
+      {
+      node.Offset = static_cast<int>(range.Begin);
+      node.Count = static_cast<int>(range.End - range.Begin);
+      nodes[range.Node] = node;
+      return 0;
+      }
+    Range first, second;
+    first.Node = static_cast<vtkIdType>(nodes.size());
+    first.Begin = range.Begin;
+    first.End = range.Begin + nFirst;
+    second.Node = first.Node + 1;
+    second.Begin = first.End;
+    second.End = range.End;
+    node.Offset = static_cast<int>(first.Node);
+    node.Count = 0;
+    nodes[range.Node] = node;
+    nodes.resize(nodes.size() + 2);
+    stack.push_back(second);
+    stack.push_back(first);
+    return 1;
+    }
+
+  // Build the tree of a range into nodes, its root being nodes[0].
+  void Build(vtkIdType begin, vtkIdType end,
+             vtkstd::vector<vtkBVHCellLocatorNode>& nodes)
+    {
+    vtkstd::vector<Range> stack;
+    Range root;
+    root.Node = 0;
+    root.Begin = begin;
+    root.End = end;
+    nodes.resize(1);
+    stack.push_back(root);
+    while (!stack.empty())
+      {
+      Range range = stack.back();
+      stack.pop_back();
+      this->BuildNode(range, nodes, stack);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Build the trees of independent ranges of cells.
+class vtkBVHCellLocatorBuildSubtrees
+{
+public:
+  vtkBVHCellLocatorBuilder *Builder;
+  const vtkBVHCellLocatorBuilder::Range *Ranges;
+  vtkstd::vector<vtkBVHCellLocatorNode> *Subtrees;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->Builder->Build(this->Ranges[i].Begin, this->Ranges[i].End,
+                           this->Subtrees[i]);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Intersect up to vtkBVHCellLocatorPacketSize finite lines with the cells.
+// The lines traverse the tree together: a node is visited when one of
+// them crosses its box, and the cells of a leaf are fetched once for all
+// the lines. The boxes are tested against all the lines of the packet in
+// loops without branches, which compilers can vectorize.
+class vtkBVHCellLocatorPacket
+{
+public:
+  int NumberOfLines;
+  double P1[vtkBVHCellLocatorPacketSize][3];
+  double P2[vtkBVHCellLocatorPacketSize][3];
+
+  // Results, CellId is -1 for the lines that hit nothing.
+  vtkIdType CellId[vtkBVHCellLocatorPacketSize];
+  double T[vtkBVHCellLocatorPacketSize];
+  double X[vtkBVHCellLocatorPacketSize][3];
+  double PCoords[vtkBVHCellLocatorPacketSize][3];
+  int SubId[vtkBVHCellLocatorPacketSize];
+
+  void Intersect(const vtkBVHCellLocatorNode *nodes, const vtkIdType *cellIds,
+                 vtkDataSet *dataSet, double tol, vtkGenericCell *cell,
+                 vtkstd::vector<int>& stack)
+    {
+    const int size = vtkBVHCellLocatorPacketSize;
+    double origin[3][vtkBVHCellLocatorPacketSize];
+    double inverse[3][vtkBVHCellLocatorPacketSize];
+    double tMax[vtkBVHCellLocatorPacketSize];
+    double direction[3] = { 0.0, 0.0, 0.0 };
+    int active[vtkBVHCellLocatorPacketSize];
+    int i, l;
+
+    // Lines past NumberOfLines are never active.
+    for (l = 0; l < size; l++)
+      {
+      this->CellId[l] = -1;
+      tMax[l] = (l < this->NumberOfLines ? 1.0 : -1.0);
+      for (i = 0; i < 3; i++)
+        {
+        double d = 0.0;
+        origin[i][l] = 0.0;
+        if (l < this->NumberOfLines)
+          {
+          origin[i][l] = this->P1[l][i];
+          d = this->P2[l][i] - this->P1[l][i];
+          direction[i] += d;
+          }
+        // Avoid 0*inf in the slab tests.
+        inverse[i][l] = 1.0 / (d == 0.0 ? 1.0e-300 : d);
+        }
+      }
+
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty())
+      {
+      const vtkBVHCellLocatorNode *node = nodes + stack.back();
+      stack.pop_back();
+
+      double lo[3], hi[3];
+      for (i = 0; i < 3; i++)
+        {
+        lo[i] = node->Bounds[2*i] - tol;
+        hi[i] = node->Bounds[2*i+1] + tol;
+        }
+      int any = 0;
+      for (l = 0; l < size; l++)
+        {
+        double t0 = 0.0, t1 = tMax[l];
+        for (i = 0; i < 3; i++)
+          {
+          double a = (lo[i] - origin[i][l]) * inverse[i][l];
+          double b = (hi[i] - origin[i][l]) * inverse[i][l];
+          double tNear = (a < b ? a : b);
+          double tFar = (a < b ? b : a);
+          t0 = (tNear > t0 ? tNear : t0);
+          t1 = (tFar < t1 ? tFar : t1);
+          }
+        active[l] = (t0 <= t1);
+        any |= active[l];
+        }
+      if (!any)
+        {
+        continue;
+        }
+
+      if (node->Count == 0)
+        {
+        // Visit first the child closest to the origins of the lines.
+        const float *b0 = nodes[node->Offset].Bounds;
+        const float *b1 = nodes[node->Offset+1].Bounds;
+        double order = 0.0;
+        for (i = 0; i < 3; i++)
+          {
+          order += (static_cast<double>(b1[2*i]) + b1[2*i+1] -
+                    b0[2*i] - b0[2*i+1]) * direction[i];
+          }
+        if (order < 0.0)
+          {
+          stack.push_back(node->Offset);
+          stack.push_back(node->Offset + 1);
+          }
+        else
+          {
+          stack.push_back(node->Offset + 1);
+          stack.push_back(node->Offset);
+          }
+        continue;
+        }
+
+      for (int c = 0; c < node->Count; c++)
+        {
+        vtkIdType cellId = cellIds[node->Offset + c];
+        dataSet->GetCell(cellId, cell);
+        for (l = 0; l < size; l++)
+          {
+          double t, x[3], pcoords[3];
+          int subId;
+          if (!active[l] ||
+              !cell->IntersectWithLine(this->P1[l], this->P2[l], tol, t, x,
+                                       pcoords, subId) ||
+              t > tMax[l] || (t == tMax[l] && this->CellId[l] >= 0 &&
+                              cellId > this->CellId[l]))
+            {
+            continue;
+            }
+          tMax[l] = t;
+          this->CellId[l] = cellId;
+          this->SubId[l] = subId;
+          for (i = 0; i < 3; i++)
+            {
+            this->X[l][i] = x[i];
+            this->PCoords[l][i] = pcoords[i];
+            }
+          }
+        }
+      }
+
+    for (l = 0; l < size; l++)
+      {
+      this->T[l] = tMax[l];
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Intersect packets of consecutive lines. The results are written to
+// separate arrays of the lines, the lines that hit nothing get a null t
+// and x. Every thread keeps its vtkGenericCell and traversal stack for all
+// the ranges it executes.
+class vtkBVHCellLocatorIntersectLines
+{
+public:
+  const vtkBVHCellLocatorNode *Nodes;
+  const vtkIdType *CellIds;
+  vtkDataSet *DataSet;
+  vtkPoints *P1s;
+  vtkPoints *P2s;
+  double Tolerance;
+  vtkIdType NumberOfLines;
+  vtkIdType *HitIds;
+  double *Ts;
+  vtkPoints *Xs;
+  vtkSMPThreadLocal<vtkGenericCell *> Cell;
+  vtkSMPThreadLocal<vtkstd::vector<int> > Stack;
+
+  vtkBVHCellLocatorIntersectLines() : Cell(0) {}
+
+  void Initialize()
+    {
+    this->Cell.Local() = vtkGenericCell::New();
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkGenericCell *cell = this->Cell.Local();
+    vtkstd::vector<int>& stack = this->Stack.Local();
+    vtkBVHCellLocatorPacket packet;
+    double zero[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType p = begin; p < end; p++)
+      {
+      vtkIdType first = p * vtkBVHCellLocatorPacketSize;
+      vtkIdType n = this->NumberOfLines - first;
+      packet.NumberOfLines = static_cast<int>(
+        n < vtkBVHCellLocatorPacketSize ? n : vtkBVHCellLocatorPacketSize);
+      int l;
+      for (l = 0; l < packet.NumberOfLines; l++)
+        {
+        this->P1s->GetPoint(first + l, packet.P1[l]);
+        this->P2s->GetPoint(first + l, packet.P2[l]);
+        }
+      packet.Intersect(this->Nodes, this->CellIds, this->DataSet,
+                       this->Tolerance, cell, stack);
+      for (l = 0; l < packet.NumberOfLines; l++)
+        {
+        vtkIdType lineId = first + l;
+        int hit = (packet.CellId[l] >= 0);
+        this->HitIds[lineId] = packet.CellId[l];
+        if (this->Ts)
+          {
+          this->Ts[lineId] = (hit ? packet.T[l] : 0.0);
+          }
+        if (this->Xs)
+          {
+          this->Xs->SetPoint(lineId, hit ? packet.X[l] : zero);
+          }
+        }
+      }
+    }
+
+  void Reduce()
+    {
+    vtkSMPThreadLocal<vtkGenericCell *>::iterator it = this->Cell.begin();
+    for (; it != this->Cell.end(); ++it)
+      {
+      (*it)->Delete();
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->NumberOfCellsPerNode = 8;
+  this->Nodes = NULL;
+  this->NumberOfNodes = 0;
+  this->CellIds = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  delete [] this->Nodes;
+  this->Nodes = NULL;
+  this->NumberOfNodes = 0;
+  delete [] this->CellIds;
+  this->CellIds = NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  // don't rebuild if build time is newer than modified and dataset modified
+  // time
+  if (this->Nodes && this->DataSet && this->BuildTime > this->MTime &&
+      this->BuildTime > this->DataSet->GetMTime())
+    {
+    return;
+    }
+  // don't rebuild if UseExistingSearchStructure is ON and a tree structure
+  // already exists
+  if (this->Nodes && this->UseExistingSearchStructure)
+    {
+    this->BuildTime.Modified();
+    vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
+    return;
+    }
+
+  vtkDebugMacro(<< "Building bounding volume hierarchy...");
+  this->FreeSearchStructure();
+
+  vtkIdType numCells;
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
+    {
+    vtkErrorMacro(<< "No cells to build hierarchy");
+    return;
+    }
+  if (numCells > VTK_LARGE_INTEGER / 2)
+    {
+    vtkErrorMacro(<< "Too many cells to build hierarchy");
+    return;
+    }
+
+  // Bounds and centers of the cells. GetCell() and GetBounds() are called
+  // once from this thread so that they can be called from the others.
+  vtkstd::vector<float> bounds(6*numCells);
+  vtkstd::vector<float> centers(3*numCells);
+  double center[3];
+  this->DataSet->GetCenter(center);
+  this->DataSet->GetCell(0, this->GenericCell);
+
+  vtkBVHCellLocatorCellBounds cellBounds;
+  cellBounds.DataSet = this->DataSet;
+  cellBounds.Center = center;
+  cellBounds.Bounds = &bounds[0];
+  cellBounds.Centers = &centers[0];
+  vtkSMPTools::For(0, numCells, cellBounds);
+
+  this->CellIds = new vtkIdType[numCells];
+  for (vtkIdType i = 0; i < numCells; i++)
+    {
+    this->CellIds[i] = i;
+    }
+
+  vtkBVHCellLocatorBuilder builder;
+  builder.Bounds = &bounds[0];
+  builder.Centers = &centers[0];
+  builder.CellIds = this->CellIds;
+  builder.MaximumLeafSize = this->NumberOfCellsPerNode;
+
+  // Split the top of the tree from this thread, until the remaining nodes
+  // are small enough to be built in parallel. The size limit depends only
+  // on the number of cells so that the tree is the same for any number of
+  // threads.
+  vtkIdType subtreeSize = numCells / 64;
+  subtreeSize = (subtreeSize < 1024 ? 1024 : subtreeSize);
+  vtkstd::vector<vtkBVHCellLocatorNode> nodes(1);
+  vtkstd::vector<vtkBVHCellLocatorBuilder::Range> stack, subtrees;
+  vtkBVHCellLocatorBuilder::Range root;
+  root.Node = 0;
+  root.Begin = 0;
+  root.End = numCells;
+  stack.push_back(root);
+  while (!stack.empty())
+    {
+    vtkBVHCellLocatorBuilder::Range range = stack.back();
+    stack.pop_back();
+    if (range.End - range.Begin <= subtreeSize)
+      {
+      subtrees.push_back(range);
+      }
+    else
+      {
+      builder.BuildNode(range, nodes, stack);
+      }
+    }
+
+  vtkIdType numSubtrees = static_cast<vtkIdType>(subtrees.size());
+  vtkstd::vector<vtkstd::vector<vtkBVHCellLocatorNode> >
+    subtreeNodes(numSubtrees);
+  vtkBVHCellLocatorBuildSubtrees buildSubtrees;
+  buildSubtrees.Builder = &builder;
+  buildSubtrees.Ranges = &subtrees[0];
+  buildSubtrees.Subtrees = &subtreeNodes[0];
+  vtkSMPTools::For(0, numSubtrees, 1, buildSubtrees);
+
+  // Append the subtrees to the top of the tree. The root of a subtree
+  // replaces its node of the top, the other nodes are renumbered.
+  vtkIdType numNodes = static_cast<vtkIdType>(nodes.size());
+  vtkIdType s;
+  for (s = 0; s < numSubtrees; s++)
+    {
+    numNodes += static_cast<vtkIdType>(subtreeNodes[s].size()) - 1;
+    }
+  this->Nodes = new vtkBVHCellLocatorNode[numNodes];
+  this->NumberOfNodes = static_cast<vtkIdType>(nodes.size());
+  vtkstd::copy(nodes.begin(), nodes.end(), this->Nodes);
+  for (s = 0; s < numSubtrees; s++)
+    {
+    const vtkstd::vector<vtkBVHCellLocatorNode>& subtree = subtreeNodes[s];
+    int shift = static_cast<int>(this->NumberOfNodes) - 1;
+    for (size_t n = 0; n < subtree.size(); n++)
+      {
+      vtkBVHCellLocatorNode node = subtree[n];
+      if (node.Count == 0)
+        {
+        node.Offset += shift;
+        }
+      this->Nodes[n == 0 ? subtrees[s].Node : shift + n] = node;
+      }
+    this->NumberOfNodes += static_cast<vtkIdType>(subtree.size()) - 1;
+    }
+
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(double a0[3], double a1[3],
+                                         double tol, double& t, double x[3],
+                                         double pcoords[3], int &subId,
+                                         vtkIdType &cellId,
+                                         vtkGenericCell *cell)
+{
+  cellId = -1;
+  if (!this->Nodes)
+    {
+    return 0;
+    }
+
+  vtkBVHCellLocatorPacket packet;
+  vtkstd::vector<int> stack;
+  packet.NumberOfLines = 1;
+  for (int i = 0; i < 3; i++)
+    {
+    packet.P1[0][i] = a0[i];
+    packet.P2[0][i] = a1[i];
+    }
+  packet.Intersect(this->Nodes, this->CellIds, this->DataSet, tol, cell,
+                   stack);
+  if (packet.CellId[0] < 0)
+    {
+    return 0;
+    }
+
+  cellId = packet.CellId[0];
+  t = packet.T[0];
+  subId = packet.SubId[0];
+  for (int i = 0; i < 3; i++)
+    {
+    x[i] = packet.X[0][i];
+    pcoords[i] = packet.PCoords[0][i];
+    }
+  this->DataSet->GetCell(cellId, cell);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::IntersectWithLines(vtkPoints *p1s, vtkPoints *p2s,
+                                           double tol, vtkIdList *cellIds,
+                                           vtkDoubleArray *ts, vtkPoints *xs)
+{
+  if (!p1s || !p2s || !cellIds ||
+      p1s->GetNumberOfPoints() != p2s->GetNumberOfPoints())
+    {
+    vtkErrorMacro(<< "Two lists of points of the same size are required");
+    return;
+    }
+
+  // All the outputs have one value per line, also when nothing is hit or
+  // the tree is not built.
+  vtkIdType numLines = p1s->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numLines);
+  if (ts)
+    {
+    ts->SetNumberOfComponents(1);
+    ts->SetNumberOfTuples(numLines);
+    }
+  if (xs)
+    {
+    xs->SetNumberOfPoints(numLines);
+    }
+  if (!this->Nodes)
+    {
+    for (vtkIdType i = 0; i < numLines; i++)
+      {
+      cellIds->SetId(i, -1);
+      if (ts)
+        {
+        ts->SetValue(i, 0.0);
+        }
+      if (xs)
+        {
+        xs->SetPoint(i, 0.0, 0.0, 0.0);
+        }
+      }
+    return;
+    }
+  if (numLines == 0)
+    {
+    return;
+    }
+
+  // Make sure GetCell() is first called from this thread.
+  this->DataSet->GetCell(0, this->GenericCell);
+
+  vtkBVHCellLocatorIntersectLines intersect;
+  intersect.Nodes = this->Nodes;
+  intersect.CellIds = this->CellIds;
+  intersect.DataSet = this->DataSet;
+  intersect.P1s = p1s;
+  intersect.P2s = p2s;
+  intersect.Tolerance = tol;
+  intersect.NumberOfLines = numLines;
+  intersect.HitIds = cellIds->GetPointer(0);
+  intersect.Ts = (ts ? ts->GetPointer(0) : NULL);
+  intersect.Xs = xs;
+  vtkIdType numPackets = (numLines + vtkBVHCellLocatorPacketSize - 1) /
+    vtkBVHCellLocatorPacketSize;
+  vtkSMPTools::Reduce(0, numPackets, intersect);
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::FindClosestPoint(double x[3], double closestPoint[3],
+                                         vtkGenericCell *cell,
+                                         vtkIdType &cellId, int &subId,
+                                         double& dist2)
+{
+  int inside;
+  if (!this->FindClosestPointWithinRadius(x, VTK_DOUBLE_MAX, closestPoint,
+                                          cell, cellId, subId, dist2,
+                                          inside))
+    {
+    cellId = -1;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindClosestPointWithinRadius(
+  double x[3], double radius, double closestPoint[3], vtkGenericCell *cell,
+  vtkIdType &cellId, int &subId, double& dist2, int &inside)
+{
+  cellId = -1;
+  if (!this->Nodes)
+    {
+    return 0;
+    }
+
+  // Visit the nodes closer than the closest point found so far, the
+  // closest child first.
+  double bestDist2 = radius * radius;
+  double point[3], pcoords[3], d2;
+  int sub, status;
+  vtkstd::vector<double> weights(VTK_CELL_SIZE);
+  vtkstd::vector<int> stack;
+  stack.push_back(0);
+  while (!stack.empty())
+    {
+    const vtkBVHCellLocatorNode *node = this->Nodes + stack.back();
+    stack.pop_back();
+    if (vtkBVHCellLocatorDistance2(node->Bounds, x) > bestDist2)
+      {
+      continue;
+      }
+    if (node->Count == 0)
+      {
+      double d0 = vtkBVHCellLocatorDistance2(
+        this->Nodes[node->Offset].Bounds, x);
+      double d1 = vtkBVHCellLocatorDistance2(
+        this->Nodes[node->Offset+1].Bounds, x);
+      stack.push_back(d0 <= d1 ? node->Offset + 1 : node->Offset);
+      stack.push_back(d0 <= d1 ? node->Offset : node->Offset + 1);
+      continue;
+      }
+    for (int c = 0; c < node->Count; c++)
+      {
+      vtkIdType id = this->CellIds[node->Offset + c];
+      this->DataSet->GetCell(id, cell);
+      if (cell->GetNumberOfPoints() > static_cast<int>(weights.size()))
+        {
+        weights.resize(cell->GetNumberOfPoints());
+        }
+      status = cell->EvaluatePosition(x, point, sub, pcoords, d2,
+                                      &weights[0]);
+      if (status == -1 || d2 > bestDist2 ||
+          (d2 == bestDist2 && cellId >= 0 && id > cellId))
+        {
+        continue;
+        }
+      bestDist2 = d2;
+      cellId = id;
+      subId = sub;
+      inside = status;
+      closestPoint[0] = point[0];
+      closestPoint[1] = point[1];
+      closestPoint[2] = point[2];
+      }
+    }
+
+  if (cellId < 0)
+    {
+    return 0;
+    }
+  dist2 = bestDist2;
+  this->DataSet->GetCell(cellId, cell);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindCell(double x[3], double tol2,
+                                      vtkGenericCell *GenCell,
+                                      double pcoords[3], double *weights)
+{
+  if (!this->Nodes)
+    {
+    return -1;
+    }
+
+  double tol = sqrt(tol2), closestPoint[3], dist2;
+  int subId;
+  vtkstd::vector<int> stack;
+  stack.push_back(0);
+  while (!stack.empty())
+    {
+    const vtkBVHCellLocatorNode *node = this->Nodes + stack.back();
+    stack.pop_back();
+    if (x[0] < node->Bounds[0] - tol || x[0] > node->Bounds[1] + tol ||
+        x[1] < node->Bounds[2] - tol || x[1] > node->Bounds[3] + tol ||
+        x[2] < node->Bounds[4] - tol || x[2] > node->Bounds[5] + tol)
+      {
+      continue;
+      }
+    if (node->Count == 0)
+      {
+      stack.push_back(node->Offset + 1);
+      stack.push_back(node->Offset);
+      continue;
+      }
+    for (int c = 0; c < node->Count; c++)
+      {
+      vtkIdType cellId = this->CellIds[node->Offset + c];
+      this->DataSet->GetCell(cellId, GenCell);
+      if (GenCell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2,
+                                    weights) == 1 && dist2 <= tol2)
+        {
+        return cellId;
+        }
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsWithinBounds(double *bbox, vtkIdList *cells)
+{
+  cells->Reset();
+  if (!this->Nodes)
+    {
+    return;
+    }
+
+  double cellBounds[6];
+  vtkstd::vector<int> stack;
+  stack.push_back(0);
+  while (!stack.empty())
+    {
+    const vtkBVHCellLocatorNode *node = this->Nodes + stack.back();
+    stack.pop_back();
+    if (node->Bounds[0] > bbox[1] || node->Bounds[1] < bbox[0] ||
+        node->Bounds[2] > bbox[3] || node->Bounds[3] < bbox[2] ||
+        node->Bounds[4] > bbox[5] || node->Bounds[5] < bbox[4])
+      {
+      continue;
+      }
+    if (node->Count == 0)
+      {
+      stack.push_back(node->Offset + 1);
+      stack.push_back(node->Offset);
+      continue;
+      }
+    for (int c = 0; c < node->Count; c++)
+      {
+      vtkIdType cellId = this->CellIds[node->Offset + c];
+      this->DataSet->GetCellBounds(cellId, cellBounds);
+      if (cellBounds[0] <= bbox[1] && cellBounds[1] >= bbox[0] &&
+          cellBounds[2] <= bbox[3] && cellBounds[3] >= bbox[2] &&
+          cellBounds[4] <= bbox[5] && cellBounds[5] >= bbox[4])
+        {
+        cells->InsertNextId(cellId);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsAlongLine(double p1[3], double p2[3],
+                                           double tolerance, vtkIdList *cells)
+{
+  cells->Reset();
+  if (!this->Nodes)
+    {
+    return;
+    }
+
+  double inverse[3];
+  int i;
+  for (i = 0; i < 3; i++)
+    {
+    double d = p2[i] - p1[i];
+    inverse[i] = 1.0 / (d == 0.0 ? 1.0e-300 : d);
+    }
+
+  vtkstd::vector<int> stack;
+  stack.push_back(0);
+  while (!stack.empty())
+    {
+    const vtkBVHCellLocatorNode *node = this->Nodes + stack.back();
+    stack.pop_back();
+    double t0 = 0.0, t1 = 1.0;
+    for (i = 0; i < 3; i++)
+      {
+      double a = (node->Bounds[2*i] - tolerance - p1[i]) * inverse[i];
+      double b = (node->Bounds[2*i+1] + tolerance - p1[i]) * inverse[i];
+      t0 = vtkstd::max(t0, vtkstd::min(a, b));
+      t1 = vtkstd::min(t1, vtkstd::max(a, b));
+      }
+    if (t0 > t1)
+      {
+      continue;
+      }
+    if (node->Count == 0)
+      {
+      stack.push_back(node->Offset + 1);
+      stack.push_back(node->Offset);
+      continue;
+      }
+    for (int c = 0; c < node->Count; c++)
+      {
+      cells->InsertNextId(this->CellIds[node->Offset + c]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Add the boxes of the nodes at the given depth, and of the leaves above
+// it, to the representation. A negative level gives all the leaves.
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData *pd)
+{
+  if (!this->Nodes)
+    {
+    vtkWarningMacro(<< "No hierarchy to generate representation from");
+    return;
+    }
+
+  static const int faces[6][4] = {
+    {0,2,6,4}, {1,5,7,3}, {0,4,5,1}, {2,3,7,6}, {0,1,3,2}, {4,6,7,5} };
+  vtkPoints *pts = vtkPoints::New();
+  vtkCellArray *polys = vtkCellArray::New();
+  vtkstd::vector<vtkstd::pair<int,int> > stack; // node and depth
+  stack.push_back(vtkstd::pair<int,int>(0, 0));
+  while (!stack.empty())
+    {
+    const vtkBVHCellLocatorNode *node = this->Nodes + stack.back().first;
+    int depth = stack.back().second;
+    stack.pop_back();
+    if (node->Count == 0 && (level < 0 || depth < level))
+      {
+      stack.push_back(vtkstd::pair<int,int>(node->Offset + 1, depth + 1));
+      stack.push_back(vtkstd::pair<int,int>(node->Offset, depth + 1));
+      continue;
+      }
+    vtkIdType first = pts->GetNumberOfPoints();
+    for (int corner = 0; corner < 8; corner++)
+      {
+      pts->InsertNextPoint(node->Bounds[corner & 1],
+                           node->Bounds[2 + ((corner >> 1) & 1)],
+                           node->Bounds[4 + ((corner >> 2) & 1)]);
+      }
+    for (int face = 0; face < 6; face++)
+      {
+      vtkIdType ids[4];
+      for (int i = 0; i < 4; i++)
+        {
+        ids[i] = first + faces[face][i];
+        }
+      polys->InsertNextCell(4, ids);
+      }
+    }
+
+  pd->SetPoints(pts);
+  pts->Delete();
+  pd->SetPolys(polys);
+  polys->Delete();
+  pd->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Nodes: " << this->NumberOfNodes << "\n";
+}
@@ -0,0 +1,231 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkBVHCellLocator - bounding volume hierarchy to quickly locate cells
+// .SECTION Description
+// vtkBVHCellLocator is a binary tree of axis aligned boxes over the cells of
+// a dataset. Each node stores its box in single precision (rounded
+// outwards) and either the index of its two children or the range of its
+// cells, so that a node takes 32 bytes and two nodes fit in a cache line.
+// The cells are split with the surface area heuristic (SAH): at each node
+// the centroids of the cells are binned along each axis, and the split that
+// minimizes the expected cost of a ray query is kept.
+//
+// BuildLocator() runs on the vtkThreadPool (see vtkSMPTools). The bounds of
+// the cells are computed in parallel, the top of the tree is split from the
+// calling thread until there are enough subtrees, and the subtrees are then
+// built in parallel. The tree does not depend on the number of threads.
+//
+// Once built, the query methods only read the locator, and are thread safe
+// when they are given their own vtkGenericCell. IntersectWithLines()
+// intersects a batch of lines in parallel: consecutive lines are grouped in
+// packets that traverse the tree together, which amortizes the traversal
+// and the fetching of the cells over coherent lines.
+//
+// .SECTION Caveats
+// LazyEvaluation is not supported: call BuildLocator() before querying the
+// locator. Queries of a locator that is not built find nothing.
+//
+// .SECTION See Also
+// vtkAbstractCellLocator vtkCellLocator vtkModifiedBSPTree vtkSMPTools
+
+#ifndef __vtkBVHCellLocator_h
+#define __vtkBVHCellLocator_h
+
+#include "vtkAbstractCellLocator.h"
+
+class vtkDoubleArray;
+struct vtkBVHCellLocatorNode;
+
+class VTK_FILTERING_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+public:
+  vtkTypeRevisionMacro(vtkBVHCellLocator,vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Construct with at most 8 cells per leaf.
+  static vtkBVHCellLocator *New();
+
+//BTX
+/*
+  if the borland compiler is ever removed, we can use these declarations
+  instead of reimplementaing the calls in this subclass
+  using vtkAbstractCellLocator::IntersectWithLine;
+  using vtkAbstractCellLocator::FindClosestPoint;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+*/
+//ETX
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual int IntersectWithLine(
+    double a0[3], double a1[3], double tol,
+    double& t, double x[3], double pcoords[3],
+    int &subId)
+  {
+    return Superclass::
+      IntersectWithLine(a0, a1, tol,t, x, pcoords, subId);
+  }
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual int IntersectWithLine(
+    double a0[3], double a1[3], double tol,
+    double& t, double x[3], double pcoords[3],
+    int &subId, vtkIdType &cellId)
+  {
+    return Superclass::
+      IntersectWithLine(a0, a1, tol,t, x, pcoords, subId, cellId);
+  }
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual int IntersectWithLine(
+    const double a0[3], const double a1[3],
+    vtkPoints *points, vtkIdList *cellIds)
+  {
+    return Superclass::
+      IntersectWithLine(a0, a1, points, cellIds);
+  }
+
+  // Description:
+  // Return the first intersection of the finite line (a0,a1) with the
+  // cells, and the cell intersected, as a cell id and as a generic cell.
+  // t is the parametric coordinate of the intersection along the line.
+  // This method is thread safe once the locator is built.
+  virtual int IntersectWithLine(double a0[3], double a1[3], double tol,
+                                double& t, double x[3], double pcoords[3],
+                                int &subId, vtkIdType &cellId,
+                                vtkGenericCell *cell);
+
+  // Description:
+  // Intersect a batch of finite lines (p1s[i],p2s[i]) with the cells. The
+  // id of the first cell hit by line i is returned in cellIds (-1 when the
+  // line hits nothing). If ts or xs are given, the parametric coordinate
+  // of the hit along the line and its position are returned there too
+  // (0 for the lines that hit nothing). All the outputs get one value per
+  // line, also when the locator is not built.
+  // The lines are processed in parallel, in packets of consecutive lines,
+  // so lines with close origins and directions should be consecutive.
+  void IntersectWithLines(vtkPoints *p1s, vtkPoints *p2s, double tol,
+                          vtkIdList *cellIds, vtkDoubleArray *ts,
+                          vtkPoints *xs);
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual void FindClosestPoint(
+    double x[3], double closestPoint[3],
+    vtkIdType &cellId, int &subId, double& dist2)
+  {
+    Superclass::
+      FindClosestPoint(x, closestPoint, cellId, subId, dist2);
+  }
+
+  // Description:
+  // Return the closest point and the cell which is closest to the point x.
+  // The closest point is somewhere on a cell, it need not be one of the
+  // vertices of the cell. This method is thread safe once the locator is
+  // built.
+  virtual void FindClosestPoint(
+    double x[3], double closestPoint[3],
+    vtkGenericCell *cell, vtkIdType &cellId,
+    int &subId, double& dist2);
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double x[3], double radius,
+    double closestPoint[3], vtkIdType &cellId,
+    int &subId, double& dist2)
+  {
+    return Superclass::FindClosestPointWithinRadius
+      (x, radius, closestPoint, cellId, subId, dist2);
+  }
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double x[3], double radius,
+    double closestPoint[3],
+    vtkGenericCell *cell, vtkIdType &cellId,
+    int &subId, double& dist2)
+  {
+    return Superclass::FindClosestPointWithinRadius
+      (x, radius, closestPoint, cell, cellId, subId, dist2);
+  }
+
+  // Description:
+  // Return the closest point within a specified radius and the cell which is
+  // closest to the point x. This method returns 1 if a point is found
+  // within the specified radius, 0 otherwise. inside returns the result of
+  // the EvaluatePosition() call on the closest cell. This method is thread
+  // safe once the locator is built.
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double x[3], double radius, double closestPoint[3],
+    vtkGenericCell *cell, vtkIdType &cellId,
+    int &subId, double& dist2, int &inside);
+
+  // Description:
+  // Returns the Id of the cell containing the point,
+  // returns -1 if no cell found. This interface uses a tolerance of zero
+  virtual vtkIdType FindCell(double x[3])
+    { return this->Superclass::FindCell(x); }
+
+  // Description:
+  // Find the cell containing a given point. returns -1 if no cell found
+  // the cell parameters are copied into the supplied variables, a cell must
+  // be provided to store the information. This method is thread safe once
+  // the locator is built.
+  virtual vtkIdType FindCell(
+    double x[3], double tol2, vtkGenericCell *GenCell,
+    double pcoords[3], double *weights);
+
+  // Description:
+  // Return the list of the cells whose bounds overlap the given bounding
+  // box. The user must provide the vtkIdList to populate.
+  virtual void FindCellsWithinBounds(double *bbox, vtkIdList *cells);
+
+  // Description:
+  // Given a finite line defined by the two points (p1,p2), return the list
+  // of the cells in the leaves crossed by the line. The user must provide
+  // the vtkIdList to populate.
+  virtual void FindCellsAlongLine(
+    double p1[3], double p2[3], double tolerance, vtkIdList *cells);
+
+  // Description:
+  // Return the number of nodes of the tree.
+  vtkGetMacro(NumberOfNodes,vtkIdType);
+
+  // Description:
+  // Satisfy vtkLocator abstract interface.
+  // These methods are not thread safe.
+  virtual void FreeSearchStructure();
+  virtual void BuildLocator();
+  virtual void GenerateRepresentation(int level, vtkPolyData *pd);
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator();
+
+  vtkBVHCellLocatorNode *Nodes; // the tree, its root first
+  vtkIdType NumberOfNodes;
+  vtkIdType *CellIds; // cell ids sorted by leaf
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&);  // Not implemented.
+  void operator=(const vtkBVHCellLocator&);  // Not implemented.
+};
+
+#endif
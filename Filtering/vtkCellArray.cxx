@@ -13,11 +13,31 @@
 
 =========================================================================*/
 #include "vtkCellArray.h"
+#include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkPoints.h"
 
 vtkCxxRevisionMacro(vtkCellArray, "$Revision$");
 vtkStandardNewMacro(vtkCellArray);
 
+//----------------------------------------------------------------------------
+// Write numCells cells given by offsets and connectivity in the list form.
+template <class T>
+static void vtkCellArrayWriteList(const T *offsets, const T *conn,
+                                  vtkIdType numCells, vtkIdType *ptr)
+{
+  for (vtkIdType cellId=0; cellId < numCells; cellId++)
+    {
+    vtkIdType npts = offsets[cellId+1] - offsets[cellId];
+    const T *pts = conn + offsets[cellId];
+    *ptr++ = npts;
+    for (vtkIdType i=0; i < npts; i++)
+      {
+      *ptr++ = pts[i];
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkCellArray::vtkCellArray()
 {
@@ -25,6 +45,14 @@ vtkCellArray::vtkCellArray()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+
+  this->StorageMode = VTK_CELL_ARRAY_LEGACY_STORAGE;
+  this->Offsets32 = NULL;
+  this->Connectivity32 = NULL;
+  this->Offsets64 = NULL;
+  this->Connectivity64 = NULL;
+  this->TraversalCellId = 0;
+  this->Locations = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -40,12 +68,33 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
   this->NumberOfCells = ca->NumberOfCells;
   this->InsertLocation = ca->InsertLocation;
   this->TraversalLocation = ca->TraversalLocation;
+  this->TraversalCellId = ca->TraversalCellId;
+  this->ReleaseLocations();
+
+  this->ReleaseOffsets();
+  this->StorageMode = ca->StorageMode;
+  if (ca->Offsets32)
+    {
+    this->Offsets32 = vtkIntArray::New();
+    this->Offsets32->DeepCopy(ca->Offsets32);
+    this->Connectivity32 = vtkIntArray::New();
+    this->Connectivity32->DeepCopy(ca->Connectivity32);
+    }
+  else if (ca->Offsets64)
+    {
+    this->Offsets64 = vtkIdTypeArray::New();
+    this->Offsets64->DeepCopy(ca->Offsets64);
+    this->Connectivity64 = vtkIdTypeArray::New();
+    this->Connectivity64->DeepCopy(ca->Connectivity64);
+    }
 }
 
 //----------------------------------------------------------------------------
 vtkCellArray::~vtkCellArray()
 {
   this->Ia->Delete();
+  this->ReleaseOffsets();
+  this->ReleaseLocations();
 }
 
 //----------------------------------------------------------------------------
@@ -55,6 +104,31 @@ void vtkCellArray::Initialize()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
+  this->ReleaseLocations();
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    this->NewOffsets(sizeof(vtkIdType) > sizeof(int), 0, 0);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::Allocate(const vtkIdType sz, const int ext)
+{
+  if (this->StorageMode == VTK_CELL_ARRAY_LEGACY_STORAGE)
+    {
+    return this->Ia->Allocate(sz,ext);
+    }
+
+  // sz is a size of the legacy list, which holds about one count for three
+  // point ids.
+  this->NumberOfCells = 0;
+  this->InsertLocation = 0;
+  this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
+  this->ReleaseLocations();
+  this->NewOffsets(sizeof(vtkIdType) > sizeof(int), sz/4, sz);
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -64,6 +138,20 @@ int vtkCellArray::GetMaxCellSize()
 {
   int i, npts=0, maxSize=0;
 
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    vtkIdType cellId, offset = 0, next;
+    for (cellId=0; cellId < this->NumberOfCells; cellId++, offset = next)
+      {
+      next = this->GetOffset(cellId+1);
+      if ( (npts=static_cast<int>(next - offset)) > maxSize )
+        {
+        maxSize = npts;
+        }
+      }
+    return maxSize;
+    }
+
   for (i=0; i<this->Ia->GetMaxId(); i+=(npts+1))
     {
     if ( (npts=this->Ia->GetValue(i)) > maxSize )
@@ -81,9 +169,13 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
   if ( cells && cells != this->Ia )
     {
     this->Modified();
+    // Register first in case cells is an array of this cell array.
+    cells->Register(this);
+    this->ReleaseOffsets();
+    this->StorageMode = VTK_CELL_ARRAY_LEGACY_STORAGE;
+    this->ReleaseLocations();
     this->Ia->Delete();
     this->Ia = cells;
-    this->Ia->Register(this);
 
     this->NumberOfCells = ncells;
     this->InsertLocation = cells->GetMaxId() + 1;
@@ -91,10 +183,647 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkCellArray::SetStorageMode(int mode)
+{
+  if (mode != VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    mode = VTK_CELL_ARRAY_LEGACY_STORAGE;
+    }
+  if (mode == this->StorageMode)
+    {
+    return;
+    }
+
+  vtkIdType cellId, i, loc, npts;
+  vtkIdType size = this->GetNumberOfConnectivityEntries();
+  if (mode == VTK_CELL_ARRAY_LEGACY_STORAGE)
+    {
+    vtkIdType *ptr = this->Ia->WritePointer(0, size);
+    if (this->Offsets32)
+      {
+      vtkCellArrayWriteList(this->Offsets32->GetPointer(0),
+                            this->Connectivity32->GetPointer(0),
+                            this->NumberOfCells, ptr);
+      }
+    else
+      {
+      vtkCellArrayWriteList(this->Offsets64->GetPointer(0),
+                            this->Connectivity64->GetPointer(0),
+                            this->NumberOfCells, ptr);
+      }
+    this->ReleaseOffsets();
+    }
+  else
+    {
+    // Count the cells and find the largest point id to pick the width of
+    // the arrays.
+    vtkIdType *cells = this->Ia->GetPointer(0);
+    vtkIdType numCells = 0, maxId = 0;
+    for (loc=0; loc < size; loc += npts+1)
+      {
+      npts = cells[loc];
+      for (i=1; i <= npts; i++)
+        {
+        if (cells[loc+i] > maxId)
+          {
+          maxId = cells[loc+i];
+          }
+        }
+      numCells++;
+      }
+    this->NewOffsets(sizeof(vtkIdType) > sizeof(int) &&
+                     maxId <= VTK_INT_MAX && size <= VTK_INT_MAX,
+                     numCells, size - numCells);
+    if (this->Offsets32)
+      {
+      int *offsets = this->Offsets32->WritePointer(0, numCells+1);
+      int *conn = this->Connectivity32->WritePointer(0, size-numCells);
+      offsets[0] = 0;
+      for (loc=0, cellId=0; loc < size; loc += npts+1, cellId++)
+        {
+        npts = cells[loc];
+        for (i=1; i <= npts; i++)
+          {
+          *conn++ = static_cast<int>(cells[loc+i]);
+          }
+        offsets[cellId+1] = static_cast<int>(offsets[cellId] + npts);
+        }
+      }
+    else
+      {
+      vtkIdType *offsets = this->Offsets64->WritePointer(0, numCells+1);
+      vtkIdType *conn = this->Connectivity64->WritePointer(0, size-numCells);
+      offsets[0] = 0;
+      for (loc=0, cellId=0; loc < size; loc += npts+1, cellId++)
+        {
+        npts = cells[loc];
+        for (i=1; i <= npts; i++)
+          {
+          *conn++ = cells[loc+i];
+          }
+        offsets[cellId+1] = offsets[cellId] + npts;
+        }
+      }
+    this->NumberOfCells = numCells;
+    this->InsertLocation = size;
+    this->Ia->Initialize();
+    }
+
+  this->StorageMode = mode;
+  this->ReleaseLocations();
+  this->SetTraversalLocation(this->TraversalLocation);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetData(vtkDataArray *offsets, vtkDataArray *connectivity)
+{
+  vtkIntArray *o32 = vtkIntArray::SafeDownCast(offsets);
+  vtkIntArray *c32 = vtkIntArray::SafeDownCast(connectivity);
+  vtkIdTypeArray *o64 = vtkIdTypeArray::SafeDownCast(offsets);
+  vtkIdTypeArray *c64 = vtkIdTypeArray::SafeDownCast(connectivity);
+  if ( !(o32 && c32) && !(o64 && c64) )
+    {
+    vtkErrorMacro("The offsets and connectivity must both be vtkIntArray "
+                  "or both vtkIdTypeArray");
+    return;
+    }
+
+  // Register first in case the arrays are the current ones.
+  offsets->Register(this);
+  connectivity->Register(this);
+  this->ReleaseOffsets();
+  if (o32)
+    {
+    this->Offsets32 = o32;
+    this->Connectivity32 = c32;
+    }
+  else
+    {
+    this->Offsets64 = o64;
+    this->Connectivity64 = c64;
+    }
+  if (offsets->GetNumberOfTuples() == 0)
+    {
+    offsets->InsertTuple1(0, 0.0);
+    }
+
+  this->StorageMode = VTK_CELL_ARRAY_OFFSETS_STORAGE;
+  this->Ia->Initialize();
+  this->ReleaseLocations();
+  this->NumberOfCells = offsets->GetNumberOfTuples() - 1;
+  this->InsertLocation = this->GetOffset(this->NumberOfCells) +
+    this->NumberOfCells;
+  this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray *vtkCellArray::GetOffsetsArray()
+{
+  if (this->Offsets32)
+    {
+    return this->Offsets32;
+    }
+  return this->Offsets64;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray *vtkCellArray::GetConnectivityArray()
+{
+  if (this->Connectivity32)
+    {
+    return this->Connectivity32;
+    }
+  return this->Connectivity64;
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::IsStorage32Bit()
+{
+  return (this->Offsets32 != NULL);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCellSize(vtkIdType cellId)
+{
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    return this->GetOffset(cellId+1) - this->GetOffset(cellId);
+    }
+  return this->Ia->GetValue(this->GetCellLocation(cellId));
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdList *ptIds)
+{
+  vtkIdType i, npts;
+  const vtkIdType *pts;
+
+  this->GetCellAtId(cellId, npts, pts, ptIds);
+  if (npts == 0 || pts != ptIds->GetPointer(0))
+    {
+    ptIds->SetNumberOfIds(npts);
+    for (i=0; i < npts; i++)
+      {
+      ptIds->SetId(i, pts[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType &npts,
+                               const vtkIdType* &pts, vtkIdList *ptIds)
+{
+  if (this->StorageMode == VTK_CELL_ARRAY_LEGACY_STORAGE)
+    {
+    vtkIdType loc = this->GetCellLocation(cellId);
+    npts = this->Ia->GetValue(loc);
+    pts = this->Ia->GetPointer(loc+1);
+    return;
+    }
+
+  vtkIdType offset = this->GetOffset(cellId);
+  npts = this->GetOffset(cellId+1) - offset;
+  if (this->Connectivity64)
+    {
+    pts = this->Connectivity64->GetPointer(offset);
+    return;
+    }
+
+  // The 32 bit ids are converted into the list of the caller so that
+  // threads can read the same cell array.
+  int *pts32 = this->Connectivity32->GetPointer(offset);
+  ptIds->SetNumberOfIds(npts);
+  for (vtkIdType i=0; i < npts; i++)
+    {
+    ptIds->SetId(i, pts32[i]);
+    }
+  pts = ptIds->GetPointer(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
+                           const vtkIdType* &pts, vtkIdList *ptIds)
+{
+  if (this->StorageMode == VTK_CELL_ARRAY_LEGACY_STORAGE)
+    {
+    npts = this->Ia->GetValue(loc);
+    pts = this->Ia->GetPointer(loc+1);
+    return;
+    }
+  this->GetCellAtId(this->GetCellIdAtLocation(loc), npts, pts, ptIds);
+}
+
+//----------------------------------------------------------------------------
+// Bounds of the points pts of a cell, whatever the type of the ids.
+template <class T>
+static void vtkCellArrayCellBounds(const T *pts, vtkIdType npts,
+                                   vtkPoints *points, double bounds[6])
+{
+  if (npts <= 0)
+    {
+    vtkMath::UninitializeBounds(bounds);
+    return;
+    }
+
+  double x[3];
+  points->GetPoint(pts[0], x);
+  bounds[0] = bounds[1] = x[0];
+  bounds[2] = bounds[3] = x[1];
+  bounds[4] = bounds[5] = x[2];
+  for (vtkIdType i=1; i < npts; i++)
+    {
+    points->GetPoint(pts[i], x);
+    bounds[0] = (x[0] < bounds[0] ? x[0] : bounds[0]);
+    bounds[1] = (x[0] > bounds[1] ? x[0] : bounds[1]);
+    bounds[2] = (x[1] < bounds[2] ? x[1] : bounds[2]);
+    bounds[3] = (x[1] > bounds[3] ? x[1] : bounds[3]);
+    bounds[4] = (x[2] < bounds[4] ? x[2] : bounds[4]);
+    bounds[5] = (x[2] > bounds[5] ? x[2] : bounds[5]);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellBounds(vtkIdType loc, vtkPoints *points,
+                                 double bounds[6])
+{
+  if (this->StorageMode == VTK_CELL_ARRAY_LEGACY_STORAGE)
+    {
+    vtkCellArrayCellBounds(this->Ia->GetPointer(loc+1),
+                           this->Ia->GetValue(loc), points, bounds);
+    return;
+    }
+
+  vtkIdType cellId = this->GetCellIdAtLocation(loc);
+  vtkIdType offset = this->GetOffset(cellId);
+  vtkIdType npts = this->GetOffset(cellId+1) - offset;
+  if (this->Connectivity32)
+    {
+    vtkCellArrayCellBounds(this->Connectivity32->GetPointer(offset), npts,
+                           points, bounds);
+    }
+  else
+    {
+    vtkCellArrayCellBounds(this->Connectivity64->GetPointer(offset), npts,
+                           points, bounds);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::InitTraversal(vtkCellArrayCursor &cursor, vtkIdType cellId)
+{
+  cursor.CellId = cellId;
+  if (cellId <= 0)
+    {
+    cursor.CellId = 0;
+    cursor.Location = 0;
+    }
+  else if (cellId >= this->NumberOfCells)
+    {
+    cursor.Location = this->GetNumberOfConnectivityEntries();
+    }
+  else if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    cursor.Location = this->GetOffset(cellId) + cellId;
+    }
+  else
+    {
+    cursor.Location = this->GetCellLocation(cellId);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::GetNextCell(vtkCellArrayCursor &cursor, vtkIdType &npts,
+                              const vtkIdType* &pts, vtkIdList *ptIds)
+{
+  if (cursor.CellId >= this->NumberOfCells)
+    {
+    return 0;
+    }
+  if (this->StorageMode == VTK_CELL_ARRAY_LEGACY_STORAGE)
+    {
+    if (cursor.Location > this->Ia->GetMaxId())
+      {
+      return 0;
+      }
+    npts = this->Ia->GetValue(cursor.Location);
+    pts = this->Ia->GetPointer(cursor.Location+1);
+    }
+  else
+    {
+    this->GetCellAtId(cursor.CellId, npts, pts, ptIds);
+    }
+  cursor.CellId++;
+  cursor.Location += npts + 1;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Return the location of cell cellId with the legacy storage. The table
+// of locations is completed up to the last cell when cellId is not in it,
+// so that later calls do not modify it.
+vtkIdType vtkCellArray::GetCellLocation(vtkIdType cellId)
+{
+  if (!this->Locations)
+    {
+    this->Locations = vtkIdTypeArray::New();
+    }
+  vtkIdType numLocs = this->Locations->GetNumberOfTuples();
+  if (cellId >= numLocs)
+    {
+    // The cells inserted since the table was built follow the last one.
+    vtkIdType loc = 0;
+    if (numLocs > 0)
+      {
+      loc = this->Locations->GetValue(numLocs-1);
+      loc += this->Ia->GetValue(loc) + 1;
+      }
+    vtkIdType maxId = this->Ia->GetMaxId();
+    for (; loc <= maxId; loc += this->Ia->GetValue(loc) + 1)
+      {
+      this->Locations->InsertNextValue(loc);
+      }
+    }
+  return this->Locations->GetValue(cellId);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetSize()
+{
+  if (this->Offsets32)
+    {
+    return this->Offsets32->GetSize() + this->Connectivity32->GetSize();
+    }
+  else if (this->Offsets64)
+    {
+    return this->Offsets64->GetSize() + this->Connectivity64->GetSize();
+    }
+  return this->Ia->GetSize();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::Squeeze()
+{
+  this->Ia->Squeeze();
+  if (this->Offsets32)
+    {
+    this->Offsets32->Squeeze();
+    this->Connectivity32->Squeeze();
+    }
+  else if (this->Offsets64)
+    {
+    this->Offsets64->Squeeze();
+    this->Connectivity64->Squeeze();
+    }
+}
+
+//----------------------------------------------------------------------------
+// Return the cell starting at location loc of the legacy list, or
+// NumberOfCells at the end of the list. Locations of cell c are
+// offsets[c] + c.
+vtkIdType vtkCellArray::GetCellIdAtLocation(vtkIdType loc)
+{
+  vtkIdType low = 0, high = this->NumberOfCells, mid;
+  while (low < high)
+    {
+    mid = (low + high) / 2;
+    if (this->GetOffset(mid) + mid < loc)
+      {
+      low = mid + 1;
+      }
+    else
+      {
+      high = mid;
+      }
+    }
+  return low;
+}
+
+//----------------------------------------------------------------------------
+// Return a writable pointer to the point ids of a cell. 32 bit ids cannot
+// be handed out this way, so the arrays are converted first.
+void vtkCellArray::GetOffsetsCell(vtkIdType cellId, vtkIdType &npts,
+                                  vtkIdType* &pts)
+{
+  if (this->Offsets32)
+    {
+    this->ConvertTo64Bit(0);
+    }
+  vtkIdType offset = this->Offsets64->GetValue(cellId);
+  npts = this->Offsets64->GetValue(cellId+1) - offset;
+  pts = this->Connectivity64->GetPointer(offset);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::InsertNextOffsetsCell(vtkIdType npts,
+                                              const vtkIdType* pts)
+{
+  vtkIdType i, size = this->InsertLocation - this->NumberOfCells;
+  if (this->Offsets32)
+    {
+    vtkIdType maxId = 0;
+    for (i=0; i < npts; i++)
+      {
+      if (pts[i] > maxId)
+        {
+        maxId = pts[i];
+        }
+      }
+    this->Widen(maxId, size + npts);
+    }
+
+  if (this->Offsets32)
+    {
+    int *conn = this->Connectivity32->WritePointer(size, npts);
+    for (i=0; i < npts; i++)
+      {
+      conn[i] = static_cast<int>(pts[i]);
+      }
+    this->Offsets32->InsertNextValue(static_cast<int>(size + npts));
+    }
+  else
+    {
+    vtkIdType *conn = this->Connectivity64->WritePointer(size, npts);
+    for (i=0; i < npts; i++)
+      {
+      conn[i] = pts[i];
+      }
+    this->Offsets64->InsertNextValue(size + npts);
+    }
+
+  this->InsertLocation += npts + 1;
+  return this->NumberOfCells++;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::StartOffsetsCell()
+{
+  // The cell is empty until its points are inserted.
+  vtkIdType size = this->InsertLocation - this->NumberOfCells;
+  if (this->Offsets32)
+    {
+    this->Offsets32->InsertNextValue(static_cast<int>(size));
+    }
+  else
+    {
+    this->Offsets64->InsertNextValue(size);
+    }
+  this->InsertLocation++;
+  this->NumberOfCells++;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::InsertOffsetsCellPoint(vtkIdType id)
+{
+  vtkIdType size = this->InsertLocation - this->NumberOfCells;
+  if (this->Offsets32)
+    {
+    this->Widen(id, size + 1);
+    }
+  if (this->Offsets32)
+    {
+    this->Connectivity32->InsertValue(size, static_cast<int>(id));
+    this->Offsets32->SetValue(this->NumberOfCells,
+                              static_cast<int>(size + 1));
+    }
+  else
+    {
+    this->Connectivity64->InsertValue(size, id);
+    this->Offsets64->SetValue(this->NumberOfCells, size + 1);
+    }
+  this->InsertLocation++;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetOffsetsCellPoint(vtkIdType cellId, int i, vtkIdType id)
+{
+  if (this->Offsets32)
+    {
+    this->Widen(id, 0);
+    }
+  if (this->Offsets32)
+    {
+    this->Connectivity32->SetValue(this->GetOffset(cellId) + i,
+                                   static_cast<int>(id));
+    }
+  else
+    {
+    this->Connectivity64->SetValue(this->GetOffset(cellId) + i, id);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ReleaseOffsets()
+{
+  if (this->Offsets32)
+    {
+    this->Offsets32->Delete();
+    this->Connectivity32->Delete();
+    this->Offsets32 = NULL;
+    this->Connectivity32 = NULL;
+    }
+  if (this->Offsets64)
+    {
+    this->Offsets64->Delete();
+    this->Connectivity64->Delete();
+    this->Offsets64 = NULL;
+    this->Connectivity64 = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Replace the offsets and connectivity with empty arrays allocated for
+// numCells cells and size point ids.
+void vtkCellArray::NewOffsets(int use32Bit, vtkIdType numCells,
+                              vtkIdType size)
+{
+  this->ReleaseOffsets();
+  if (use32Bit)
+    {
+    this->Offsets32 = vtkIntArray::New();
+    this->Offsets32->Allocate(numCells+1);
+    this->Offsets32->InsertNextValue(0);
+    this->Connectivity32 = vtkIntArray::New();
+    this->Connectivity32->Allocate(size);
+    }
+  else
+    {
+    this->Offsets64 = vtkIdTypeArray::New();
+    this->Offsets64->Allocate(numCells+1);
+    this->Offsets64->InsertNextValue(0);
+    this->Connectivity64 = vtkIdTypeArray::New();
+    this->Connectivity64->Allocate(size);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Convert 32 bit arrays to vtkIdType if point id or a connectivity of the
+// given size does not fit in them.
+void vtkCellArray::Widen(vtkIdType id, vtkIdType size)
+{
+  if (!this->Offsets32 || (id <= VTK_INT_MAX && id >= VTK_INT_MIN &&
+                           size <= VTK_INT_MAX))
+    {
+    return;
+    }
+  this->ConvertTo64Bit(size);
+}
+
+//----------------------------------------------------------------------------
+// Replace the 32 bit arrays by vtkIdType ones with room for size point ids.
+void vtkCellArray::ConvertTo64Bit(vtkIdType size)
+{
+  if (!this->Offsets32)
+    {
+    return;
+    }
+
+  vtkIdType i, numOffsets = this->Offsets32->GetNumberOfTuples();
+  vtkIdType connSize = this->Connectivity32->GetNumberOfTuples();
+  vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+  vtkIdType *optr = offsets->WritePointer(0, numOffsets);
+  for (i=0; i < numOffsets; i++)
+    {
+    optr[i] = this->Offsets32->GetValue(i);
+    }
+  vtkIdTypeArray *conn = vtkIdTypeArray::New();
+  conn->Allocate(size > connSize ? size : connSize);
+  if (connSize > 0)
+    {
+    vtkIdType *cptr = conn->WritePointer(0, connSize);
+    for (i=0; i < connSize; i++)
+      {
+      cptr[i] = this->Connectivity32->GetValue(i);
+      }
+    }
+
+  this->ReleaseOffsets();
+  this->Offsets64 = offsets;
+  this->Connectivity64 = conn;
+}
+
 //----------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize()
 {
-  return this->Ia->GetActualMemorySize();
+  unsigned long size = this->Ia->GetActualMemorySize();
+  if (this->Locations)
+    {
+    size += this->Locations->GetActualMemorySize();
+    }
+  if (this->Offsets32)
+    {
+    size += this->Offsets32->GetActualMemorySize() +
+      this->Connectivity32->GetActualMemorySize();
+    }
+  else if (this->Offsets64)
+    {
+    size += this->Offsets64->GetActualMemorySize() +
+      this->Connectivity64->GetActualMemorySize();
+    }
+  return size;
 }
 
 //----------------------------------------------------------------------------
@@ -105,4 +834,8 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Cells: " << this->NumberOfCells << endl;
   os << indent << "Insert Location: " << this->InsertLocation << endl;
   os << indent << "Traversal Location: " << this->TraversalLocation << endl;
+  os << indent << "Storage Mode: "
+     << (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE ?
+         (this->Offsets32 ? "Offsets (32 bit)" : "Offsets") : "Legacy")
+     << endl;
 }
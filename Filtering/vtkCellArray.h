@@ -26,6 +26,28 @@
 // using the vtkCellTypes and vtkCellLinks objects to extend the definition of 
 // the data structure.
 //
+// Alternatively the cells can be stored as an array of offsets and an
+// array of connectivity (SetStorageModeToOffsets()): the point ids of cell
+// i are connectivity[offsets[i]] to connectivity[offsets[i+1]-1]. This
+// gives constant time access to any cell with GetCellAtId(). When VTK is
+// built with 64 bit ids, 32 bit arrays are used as long as the point ids
+// and the size of the connectivity fit, which makes the cells about 40%
+// smaller than the list above. Both arrays grow to 64 bits when needed.
+// The whole API works with both storage modes; locations (see GetCell()
+// and GetTraversalLocation()) keep referring to positions in the list
+// above, and finding the cell at a location is then a binary search over
+// the offsets (O(log n)). GetPointer() and GetData(), which hand out the
+// list itself, convert the cells back to the list storage in place, like
+// WritePointer() and SetCells(), which replace the cells. Code that only
+// reads the cells should traverse them with a vtkCellArrayCursor or use
+// GetCellAtId() instead, which keep the offsets storage.
+//
+// The methods handing out a writable pointer to the point ids of a cell
+// (GetCell(loc, npts, pts) and GetNextCell(npts, pts)) convert 32 bit
+// arrays to vtkIdType first, so that writes reach the cell array. Code
+// running in several threads should use the overloads taking a vtkIdList
+// or a vtkCellArrayCursor, which never modify the cell array.
+//
 // .SECTION See Also
 // vtkCellTypes vtkCellLinks
 
@@ -35,8 +57,25 @@
 #include "vtkObject.h"
 
 #include "vtkIdTypeArray.h" // Needed for inline methods
+#include "vtkIntArray.h" // Needed for inline methods
 #include "vtkCell.h" // Needed for inline methods
 
+class vtkPoints;
+
+#define VTK_CELL_ARRAY_LEGACY_STORAGE 0
+#define VTK_CELL_ARRAY_OFFSETS_STORAGE 1
+
+//BTX
+// Position of a traversal of a vtkCellArray. The cursor is owned by the
+// caller, so that several threads can traverse the same cell array, see
+// vtkCellArray::InitTraversal(vtkCellArrayCursor&, vtkIdType).
+struct vtkCellArrayCursor
+{
+  vtkIdType CellId;
+  vtkIdType Location;
+};
+//ETX
+
 class VTK_FILTERING_EXPORT vtkCellArray : public vtkObject
 {
 public:
@@ -49,8 +88,7 @@ public:
 
   // Description:
   // Allocate memory and set the size to extend by.
-  int Allocate(const vtkIdType sz, const int ext=1000) 
-    {return this->Ia->Allocate(sz,ext);}
+  int Allocate(const vtkIdType sz, const int ext=1000);
 
   // Description:
   // Free any memory and reset to an empty state.
@@ -65,6 +103,78 @@ public:
   // DO NOT do any kind of allocation, advanced use only.
   vtkSetMacro(NumberOfCells, vtkIdType);
 
+  // Description:
+  // Set/Get how the cells are stored: as a single list
+  // (VTK_CELL_ARRAY_LEGACY_STORAGE, the default) or as offsets and
+  // connectivity arrays (VTK_CELL_ARRAY_OFFSETS_STORAGE). Changing the
+  // mode converts the cells.
+  void SetStorageMode(int mode);
+  vtkGetMacro(StorageMode, int);
+  void SetStorageModeToLegacy()
+    {this->SetStorageMode(VTK_CELL_ARRAY_LEGACY_STORAGE);}
+  void SetStorageModeToOffsets()
+    {this->SetStorageMode(VTK_CELL_ARRAY_OFFSETS_STORAGE);}
+
+  // Description:
+  // Use the given offsets and connectivity arrays, which must both be
+  // vtkIntArray or both vtkIdTypeArray, without copying them. offsets has
+  // one more value than there are cells, the first one being 0. Switches
+  // to VTK_CELL_ARRAY_OFFSETS_STORAGE.
+  void SetData(vtkDataArray *offsets, vtkDataArray *connectivity);
+
+  // Description:
+  // Return the offsets and connectivity arrays, or NULL with the legacy
+  // storage.
+  vtkDataArray *GetOffsetsArray();
+  vtkDataArray *GetConnectivityArray();
+
+  // Description:
+  // Return 1 if the offsets and connectivity are 32 bit integers.
+  int IsStorage32Bit();
+
+  // Description:
+  // Return the number of points and the point ids of cell cellId. This
+  // takes constant time with the offsets storage. With the legacy storage
+  // the first call builds a table of cell locations.
+  // THESE METHODS ARE THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
+  // THE CELL ARRAY IS NOT MODIFIED
+  vtkIdType GetCellSize(vtkIdType cellId);
+  void GetCellAtId(vtkIdType cellId, vtkIdList *pts);
+
+  // Description:
+  // Get the point ids of the cell at location loc, or of cell cellId,
+  // without copying them when possible: pts points either into the cell
+  // array or to the ids copied into ptIds, which is owned by the caller.
+  // ptIds is only used when IsStorage32Bit() and may be NULL otherwise.
+  // THESE METHODS ARE THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
+  // THE CELL ARRAY IS NOT MODIFIED
+  void GetCell(vtkIdType loc, vtkIdType &npts, const vtkIdType* &pts,
+               vtkIdList *ptIds);
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts,
+                   vtkIdList *ptIds);
+
+  // Description:
+  // Compute the bounds of the cell at location loc from the given points.
+  // The point ids are read where they are stored, 32 bit ones included,
+  // so nothing is allocated or copied.
+  // THIS METHOD IS THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
+  // THE CELL ARRAY IS NOT MODIFIED
+  void GetCellBounds(vtkIdType loc, vtkPoints *points, double bounds[6]);
+
+  //BTX
+  // Description:
+  // Traversal keeping its position in a cursor owned by the caller.
+  // InitTraversal() places the cursor on cell cellId. GetNextCell() gets
+  // the cell at the cursor as GetCellAtId() does, advances the cursor and
+  // returns 1, or returns 0 after the last cell. Threads can traverse
+  // ranges of cells of the same cell array with their own cursors.
+  // THESE METHODS ARE THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
+  // THE CELL ARRAY IS NOT MODIFIED
+  void InitTraversal(vtkCellArrayCursor &cursor, vtkIdType cellId=0);
+  int GetNextCell(vtkCellArrayCursor &cursor, vtkIdType &npts,
+                  const vtkIdType* &pts, vtkIdList *ptIds);
+  //ETX
+
   // Description:
   // Utility routines help manage memory of cell array. EstimateSize()
   // returns a value used to initialize and allocate memory for array based
@@ -78,29 +188,36 @@ public:
   // Description:
   // A cell traversal methods that is more efficient than vtkDataSet traversal
   // methods.  InitTraversal() initializes the traversal of the list of cells.
-  void InitTraversal() {this->TraversalLocation=0;};
+  void InitTraversal() {this->TraversalLocation=0; this->TraversalCellId=0;};
 
   // Description:
   // A cell traversal methods that is more efficient than vtkDataSet traversal
   // methods.  GetNextCell() gets the next cell in the list. If end of list
-  // is encountered, 0 is returned.
+  // is encountered, 0 is returned. 32 bit offsets storage is converted to
+  // vtkIdType by the first call.
   int GetNextCell(vtkIdType& npts, vtkIdType* &pts);
 
   // Description:
   // Get the size of the allocated connectivity array.
-  vtkIdType GetSize() 
-    {return this->Ia->GetSize();}
+  vtkIdType GetSize();
   
   // Description:
   // Get the total number of entries (i.e., data values) in the connectivity 
   // array. This may be much less than the allocated size (i.e., return value 
   // from GetSize().)
   vtkIdType GetNumberOfConnectivityEntries() 
-    {return this->Ia->GetMaxId()+1;}
+    {
+    if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+      {
+      return this->InsertLocation;
+      }
+    return this->Ia->GetMaxId()+1;
+    }
 
   // Description:
   // Internal method used to retrieve a cell given an offset into
-  // the internal array.
+  // the internal array. With the offsets storage the cell is found by a
+  // binary search (O(log n)), and 32 bit arrays are converted to vtkIdType.
   void GetCell(vtkIdType loc, vtkIdType &npts, vtkIdType* &pts);
 
   // Description:
@@ -141,11 +258,18 @@ public:
     {return (this->InsertLocation - npts - 1);};
   
   // Description:
-  // Get/Set the current traversal location.
+  // Get/Set the current traversal location. With the offsets storage,
+  // setting it finds the cell by a binary search (O(log n)).
   vtkIdType GetTraversalLocation() 
     {return this->TraversalLocation;}
   void SetTraversalLocation(vtkIdType loc) 
-    {this->TraversalLocation = loc;}
+    {
+    this->TraversalLocation = loc;
+    if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+      {
+      this->TraversalCellId = this->GetCellIdAtLocation(loc);
+      }
+    }
   
   // Description:
   // Computes the current traversal location within the internal array. Used 
@@ -155,11 +279,14 @@ public:
   
   // Description:
   // Special method inverts ordering of current cell. Must be called
-  // carefully or the cell topology may be corrupted.
+  // carefully or the cell topology may be corrupted. With the offsets
+  // storage the cell at loc is found by a binary search (O(log n)).
   void ReverseCell(vtkIdType loc);
 
   // Description:
   // Replace the point ids of the cell with a different list of point ids.
+  // With the offsets storage the cell at loc is found by a binary search
+  // (O(log n)).
   void ReplaceCell(vtkIdType loc, int npts, const vtkIdType *pts);
 
   // Description:
@@ -168,14 +295,17 @@ public:
   int GetMaxCellSize();
 
   // Description:
-  // Get pointer to array of cell data.
+  // Get pointer to array of cell data. With the offsets storage the cells
+  // are converted back to the list first, see GetData().
   vtkIdType *GetPointer() 
-    {return this->Ia->GetPointer(0);}
+    {
+    return this->GetData()->GetPointer(0);
+    }
 
   // Description:
   // Get pointer to data array for purpose of direct writes of data. Size is the
   // total storage consumed by the cell array. ncells is the number of cells
-  // represented in the array.
+  // represented in the array. The cells are then stored as a single list.
   vtkIdType *WritePointer(const vtkIdType ncells, const vtkIdType size);
 
   // Description:
@@ -193,9 +323,18 @@ public:
   void DeepCopy(vtkCellArray *ca);
 
   // Description:
-  // Return the underlying data as a data array.
+  // Return the underlying data as a data array. With the offsets storage
+  // the cells are converted back to the list storage first, so that the
+  // array can be modified; this modifies the cell array and must not be
+  // done by several threads at the same time.
   vtkIdTypeArray* GetData() 
-    {return this->Ia;}
+    {
+    if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+      {
+      this->SetStorageModeToLegacy();
+      }
+    return this->Ia;
+    }
 
   // Description:
   // Reuse list. Reset to initial condition.
@@ -203,8 +342,7 @@ public:
 
   // Description:
   // Reclaim any extra memory.
-  void Squeeze() 
-    {this->Ia->Squeeze();}
+  void Squeeze();
 
   // Description:
   // Return the memory in kilobytes consumed by this cell array. Used to
@@ -224,6 +362,48 @@ protected:
   vtkIdType TraversalLocation;   //keep track of traversal position
   vtkIdTypeArray *Ia;
 
+  // Offsets storage. Either the 32 bit or the vtkIdType arrays are used.
+  int StorageMode;
+  vtkIntArray *Offsets32;
+  vtkIntArray *Connectivity32;
+  vtkIdTypeArray *Offsets64;
+  vtkIdTypeArray *Connectivity64;
+  vtkIdType TraversalCellId;
+
+  // Location of every cell with the legacy storage, allocated and built
+  // on demand by GetCellLocation().
+  vtkIdTypeArray *Locations;
+
+  vtkIdType GetOffset(vtkIdType cellId)
+    {
+    return (this->Offsets32 ? this->Offsets32->GetValue(cellId) :
+            this->Offsets64->GetValue(cellId));
+    }
+  vtkIdType GetConnectivityValue(vtkIdType idx)
+    {
+    return (this->Connectivity32 ? this->Connectivity32->GetValue(idx) :
+            this->Connectivity64->GetValue(idx));
+    }
+  vtkIdType GetCellIdAtLocation(vtkIdType loc);
+  void ReleaseLocations()
+    {
+    if (this->Locations)
+      {
+      this->Locations->Delete();
+      this->Locations = NULL;
+      }
+    }
+  vtkIdType GetCellLocation(vtkIdType cellId);
+  void GetOffsetsCell(vtkIdType cellId, vtkIdType &npts, vtkIdType* &pts);
+  vtkIdType InsertNextOffsetsCell(vtkIdType npts, const vtkIdType* pts);
+  void StartOffsetsCell();
+  void InsertOffsetsCellPoint(vtkIdType id);
+  void SetOffsetsCellPoint(vtkIdType cellId, int i, vtkIdType id);
+  void ReleaseOffsets();
+  void NewOffsets(int use32Bit, vtkIdType numCells, vtkIdType size);
+  void Widen(vtkIdType id, vtkIdType size);
+  void ConvertTo64Bit(vtkIdType size);
+
 private:
   vtkCellArray(const vtkCellArray&);  // Not implemented.
   void operator=(const vtkCellArray&);  // Not implemented.
@@ -234,6 +414,10 @@ private:
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
                                               const vtkIdType* pts)
 {
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    return this->InsertNextOffsetsCell(npts, pts);
+    }
   vtkIdType i = this->Ia->GetMaxId() + 1;
   vtkIdType *ptr = this->Ia->WritePointer(i, npts+1);
   
@@ -252,6 +436,10 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdList *pts)
 {
   vtkIdType npts = pts->GetNumberOfIds();
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    return this->InsertNextOffsetsCell(npts, pts->GetPointer(0));
+    }
   vtkIdType i = this->Ia->GetMaxId() + 1;
   vtkIdType *ptr = this->Ia->WritePointer(i,npts+1);
   
@@ -269,6 +457,11 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkIdList *pts)
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 {
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    this->StartOffsetsCell();
+    return this->NumberOfCells - 1;
+    }
   this->InsertLocation = this->Ia->InsertNextValue(npts) + 1;
   this->NumberOfCells++;
 
@@ -278,12 +471,22 @@ inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id) 
 {
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    this->InsertOffsetsCellPoint(id);
+    return;
+    }
   this->Ia->InsertValue(this->InsertLocation++, id);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::UpdateCellCount(int npts) 
 {
+  // The offsets storage counts the points as they are inserted.
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    return;
+    }
   this->Ia->SetValue(this->InsertLocation-npts-1, npts);
 }
 
@@ -291,6 +494,10 @@ inline void vtkCellArray::UpdateCellCount(int npts)
 inline vtkIdType vtkCellArray::InsertNextCell(vtkCell *cell)
 {
   vtkIdType npts = cell->GetNumberOfPoints();
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    return this->InsertNextOffsetsCell(npts, cell->PointIds->GetPointer(0));
+    }
   vtkIdType i = this->Ia->GetMaxId() + 1;
   vtkIdType *ptr = this->Ia->WritePointer(i,npts+1);
   
@@ -311,12 +518,36 @@ inline void vtkCellArray::Reset()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
   this->Ia->Reset();
+  this->ReleaseLocations();
+  if (this->Offsets32)
+    {
+    this->Offsets32->Reset();
+    this->Offsets32->InsertNextValue(0);
+    this->Connectivity32->Reset();
+    }
+  else if (this->Offsets64)
+    {
+    this->Offsets64->Reset();
+    this->Offsets64->InsertNextValue(0);
+    this->Connectivity64->Reset();
+    }
 }
 
 //----------------------------------------------------------------------------
 inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 {
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    if (this->TraversalCellId >= this->NumberOfCells)
+      {
+      return 0;
+      }
+    this->GetOffsetsCell(this->TraversalCellId++, npts, pts);
+    this->TraversalLocation += npts + 1;
+    return 1;
+    }
   if ( this->Ia->GetMaxId() >= 0 && 
        this->TraversalLocation <= this->Ia->GetMaxId() ) 
     {
@@ -335,6 +566,11 @@ inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 inline void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
                                   vtkIdType* &pts)
 {
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    this->GetOffsetsCell(this->GetCellIdAtLocation(loc), npts, pts);
+    return;
+    }
   npts = this->Ia->GetValue(loc++);
   pts  = this->Ia->GetPointer(loc);
 }
@@ -344,6 +580,20 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 {
   int i;
   vtkIdType tmp;
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    vtkIdType cellId = this->GetCellIdAtLocation(loc);
+    vtkIdType offset = this->GetOffset(cellId);
+    vtkIdType npts = this->GetOffset(cellId+1) - offset;
+    for (i=0; i < (npts/2); i++)
+      {
+      tmp = this->GetConnectivityValue(offset+i);
+      this->SetOffsetsCellPoint(cellId, i,
+                                this->GetConnectivityValue(offset+npts-i-1));
+      this->SetOffsetsCellPoint(cellId, npts-i-1, tmp);
+      }
+    return;
+    }
   vtkIdType npts=this->Ia->GetValue(loc);
   vtkIdType *pts=this->Ia->GetPointer(loc+1);
   for (i=0; i < (npts/2); i++) 
@@ -358,6 +608,15 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
                                       const vtkIdType *pts)
 {
+  if (this->StorageMode == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    vtkIdType cellId = this->GetCellIdAtLocation(loc);
+    for (int i=0; i < npts; i++)
+      {
+      this->SetOffsetsCellPoint(cellId, i, pts[i]);
+      }
+    return;
+    }
   vtkIdType *oldPts=this->Ia->GetPointer(loc+1);
   for (int i=0; i < npts; i++)
     {
@@ -369,9 +628,11 @@ inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
 inline vtkIdType *vtkCellArray::WritePointer(const vtkIdType ncells,
                                              const vtkIdType size)
 {
+  this->SetStorageModeToLegacy();
   this->NumberOfCells = ncells;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->ReleaseLocations();
   return this->Ia->WritePointer(0,size);
 }
 
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 
@@ -142,13 +143,16 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data)
   // Use fast path if polydata
   if ( data->GetDataObjectType() == VTK_POLY_DATA )
     {
-    vtkIdType *pts, npts;
+    const vtkIdType *pts;
+    vtkIdType npts;
+    // 32 bit ids are read into this list, the cells are not converted.
+    vtkIdList *ptIds = vtkIdList::New();
     
     vtkPolyData *pdata = static_cast<vtkPolyData *>(data);
     // traverse data to determine number of uses of each point
     for (cellId=0; cellId < numCells; cellId++)
       {
-      pdata->GetCellPoints(cellId, npts, pts);
+      pdata->GetCellPoints(cellId, npts, pts, ptIds);
       for (j=0; j < npts; j++)
         {
         this->IncrementLinkCount(pts[j]);      
@@ -161,12 +165,13 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data)
 
     for (cellId=0; cellId < numCells; cellId++)
       {
-      pdata->GetCellPoints(cellId, npts, pts);
+      pdata->GetCellPoints(cellId, npts, pts, ptIds);
       for (j=0; j < npts; j++)
         {
         this->InsertCellReference(pts[j], (linkLoc[pts[j]])++, cellId);      
         }      
       }
+    ptIds->Delete();
     }
 
   else //any other type of dataset
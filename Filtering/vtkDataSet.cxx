@@ -279,6 +279,15 @@ void vtkDataSet::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
   otherCells->Delete();
 }
 
+//----------------------------------------------------------------------------
+void vtkDataSet::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                               const vtkIdType* &pts, vtkIdList *ptIds)
+{
+  this->GetCellPoints(cellId, ptIds);
+  npts = ptIds->GetNumberOfIds();
+  pts = ptIds->GetPointer(0);
+}
+
 //----------------------------------------------------------------------------
 void vtkDataSet::GetCellTypes(vtkCellTypes *types)
 {
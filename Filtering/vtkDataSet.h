@@ -135,6 +135,17 @@ public:
   // THE DATASET IS NOT MODIFIED
   virtual void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds) = 0;
 
+  // Description:
+  // Topological inquiry to get points defining cell without copying them
+  // when possible: pts points either into the dataset or to the ids copied
+  // into ptIds, which is owned by the caller. With GetCellType() and
+  // GetCell(vtkIdType, vtkGenericCell*) this lets several threads traverse
+  // the cells of the same dataset, each with its own ptIds.
+  // THIS METHOD IS THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
+  // THE DATASET IS NOT MODIFIED
+  virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                             const vtkIdType* &pts, vtkIdList *ptIds);
+
   // Description:
   // Topological inquiry to get cells using point.
   // THIS METHOD IS THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
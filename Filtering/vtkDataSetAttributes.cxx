@@ -694,10 +694,10 @@ void vtkDataSetAttributes::RemoveArray(int index)
 void vtkDataSetAttributes::CopyData(vtkDataSetAttributes* fromPd,
                                     vtkIdType fromId, vtkIdType toId)
 {
-  int i;
-  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
-      i=this->RequiredArrays.NextIndex())
+  int i, j, numArrays = this->RequiredArrays.GetListSize();
+  for(j=0; j < numArrays; j++)
     {
+    i = this->RequiredArrays.GetIndex(j);
     this->CopyTuple(fromPd->Data[i], this->Data[this->TargetIndices[i]], 
                     fromId, toId);
     }
@@ -726,10 +726,10 @@ void vtkDataSetAttributes::InterpolatePoint(vtkDataSetAttributes *fromPd,
                                             vtkIdType toId, vtkIdList *ptIds, 
                                             double *weights)
 {
-  int i;
-  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
-      i=this->RequiredArrays.NextIndex())
+  int i, j, numArrays = this->RequiredArrays.GetListSize();
+  for(j=0; j < numArrays; j++)
     {
+    i = this->RequiredArrays.GetIndex(j);
     vtkAbstractArray* fromArray = this->Data[this->TargetIndices[i]];    
     fromArray->InterpolateTuple(toId, ptIds, fromPd->Data[i], weights);
     }
@@ -744,10 +744,10 @@ void vtkDataSetAttributes::InterpolateEdge(vtkDataSetAttributes *fromPd,
                                            vtkIdType toId, vtkIdType p1,
                                            vtkIdType p2, double t)
 {
-  int i;
-  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
-      i=this->RequiredArrays.NextIndex())
+  int i, j, numArrays = this->RequiredArrays.GetListSize();
+  for(j=0; j < numArrays; j++)
     {
+    i = this->RequiredArrays.GetIndex(j);
     vtkAbstractArray* fromArray = fromPd->Data[i];
     vtkAbstractArray* toArray = this->Data[this->TargetIndices[i]];
 
@@ -1563,6 +1563,50 @@ void vtkDataSetAttributes::CopyData(vtkDataSetAttributes::FieldList& list,
     }
 }
 
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::CopyData(vtkDataSetAttributes::FieldList& list,
+                                    vtkDataSetAttributes* fromDSA,
+                                    int idx, vtkIdType srcStart,
+                                    vtkIdType dstStart, vtkIdType n)
+{
+  vtkAbstractArray *fromDA;
+  vtkAbstractArray *toDA;
+  vtkIdType j;
+
+  int i;
+  for (i=0; i < list.NumberOfFields; i++)
+    {
+    if ( list.FieldIndices[i] >= 0 && list.DSAIndices[idx][i] >= 0 )
+      {
+      toDA = this->GetAbstractArray(list.FieldIndices[i]);
+      fromDA = fromDSA->GetAbstractArray(list.DSAIndices[idx][i]);
+      int numComp = fromDA->GetNumberOfComponents();
+      // The raw pointers of other layouts are copies, that would be made
+      // by every thread.
+      if ( fromDA->IsNumeric() && fromDA->GetDataType() != VTK_BIT &&
+           fromDA->GetDataType() == toDA->GetDataType() &&
+           numComp == toDA->GetNumberOfComponents() &&
+           fromDA->HasStandardMemoryLayout() &&
+           toDA->HasStandardMemoryLayout() )
+        {
+        if ( n > 0 )
+          {
+          memcpy(toDA->GetVoidPointer(dstStart*numComp),
+                 fromDA->GetVoidPointer(srcStart*numComp),
+                 n*numComp*fromDA->GetDataTypeSize());
+          }
+        }
+      else
+        {
+        for (j=0; j < n; j++)
+          {
+          toDA->SetTuple(dstStart+j, srcStart+j, fromDA);
+          }
+        }
+      }
+    }
+}
+
 //--------------------------------------------------------------------------
 // Interpolate data from points and interpolation weights. Make sure that the 
 // method InterpolateAllocate() has been invoked before using this method.
@@ -37,6 +37,11 @@
 // Finally this class provides a mechanism to determine which attributes a 
 // group of sources have in common, and to copy tuples from a source into 
 // the destination, for only those attributes that are held by all.
+//
+// CopyData(), InterpolatePoint() and InterpolateEdge() do not modify the
+// attributes object. Once the destination arrays hold enough tuples (e.g.
+// after SetNumberOfTuples()), they may be called concurrently for
+// distinct destination ids.
 
 #ifndef __vtkDataSetAttributes_h
 #define __vtkDataSetAttributes_h
@@ -528,6 +533,17 @@ public:
                 vtkDataSetAttributes* dsa, int idx, vtkIdType fromId,
                 vtkIdType toId);
 
+  // Description:
+  // Copy the n tuples starting at srcStart of the input idx of the
+  // FieldList to the tuples starting at dstStart. The arrays must already
+  // hold dstStart+n tuples, for instance after SetNumberOfTuples().
+  // Numeric arrays with the standard memory layout are copied with
+  // memcpy(), the others tuple by tuple. Concurrent calls that write to
+  // disjoint ranges are safe, except for vtkBitArray.
+  void CopyData(vtkDataSetAttributes::FieldList& list,
+                vtkDataSetAttributes* dsa, int idx, vtkIdType srcStart,
+                vtkIdType dstStart, vtkIdType n);
+
   // Description:
   // A special form of InterpolateAllocate() to be used with FieldLists. Use it 
   // when you are interpolating data from a set of vtkDataSetAttributes.
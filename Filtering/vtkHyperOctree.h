@@ -309,6 +309,9 @@ public:
   virtual void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds);
   virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
                              vtkIdType* &pts);
+  virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                             const vtkIdType* &pts, vtkIdList *ptIds)
+    {this->vtkDataSet::GetCellPoints(cellId, npts, pts, ptIds);}
 
   // Description:
   // Topological inquiry to get cells using point.
@@ -77,6 +77,9 @@ public:
   virtual void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
     {vtkStructuredData::GetCellPoints(cellId,ptIds,this->DataDescription,
                                       this->GetDimensions());}
+  virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                             const vtkIdType* &pts, vtkIdList *ptIds)
+    {this->vtkDataSet::GetCellPoints(cellId, npts, pts, ptIds);}
   virtual void GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
     {vtkStructuredData::GetPointCells(ptId,cellIds,this->GetDimensions());}
   virtual void ComputeBounds();
@@ -256,7 +256,8 @@ int vtkPolyData::GetCellType(vtkIdType cellId)
 vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
 {
   int i, loc;
-  vtkIdType *pts, numPts;
+  const vtkIdType *pts;
+  vtkIdType numPts;
   vtkCell *cell = NULL;
   unsigned char type;
 
@@ -276,7 +277,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->Vertex = vtkVertex::New();
         }
       cell = this->Vertex;
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_VERTEX:
@@ -285,7 +286,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->PolyVertex = vtkPolyVertex::New();
         }
       cell = this->PolyVertex;
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -296,7 +297,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->Line = vtkLine::New();
         }
       cell = this->Line;
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_LINE:
@@ -305,7 +306,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->PolyLine = vtkPolyLine::New();
         }
       cell = this->PolyLine;
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -316,7 +317,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->Triangle = vtkTriangle::New();
         }
       cell = this->Triangle;
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_QUAD:
@@ -325,7 +326,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->Quad = vtkQuad::New();
         }
       cell = this->Quad;
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLYGON:
@@ -334,7 +335,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->Polygon = vtkPolygon::New();
         }
       cell = this->Polygon;
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -345,7 +346,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
         this->TriangleStrip = vtkTriangleStrip::New();
         }
       cell = this->TriangleStrip;
-      this->Strips->GetCell(loc,numPts,pts);
+      this->Strips->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -373,7 +374,7 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
 void vtkPolyData::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 {
   int             i, loc;
-  vtkIdType       *pts=0;
+  const vtkIdType *pts=0;
   vtkIdType       numPts;
   unsigned char   type;
   double           x[3];
@@ -390,48 +391,48 @@ void vtkPolyData::GetCell(vtkIdType cellId, vtkGenericCell *cell)
     {
     case VTK_VERTEX:
       cell->SetCellTypeToVertex();
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_VERTEX:
       cell->SetCellTypeToPolyVertex();
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_LINE: 
       cell->SetCellTypeToLine();
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_LINE:
       cell->SetCellTypeToPolyLine();
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_TRIANGLE:
       cell->SetCellTypeToTriangle();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_QUAD:
       cell->SetCellTypeToQuad();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLYGON:
       cell->SetCellTypeToPolygon();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_TRIANGLE_STRIP:
       cell->SetCellTypeToTriangleStrip();
-      this->Strips->GetCell(loc,numPts,pts);
+      this->Strips->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -527,10 +528,9 @@ void vtkPolyData::CopyCells(vtkPolyData *pd, vtkIdList *idList,
 // constructing a cell.
 void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
 {
-  int i, loc;
-  vtkIdType *pts, numPts;
+  int loc;
   unsigned char type;
-  double x[3];
+  vtkCellArray *cells;
 
   if ( !this->Cells )
     {
@@ -544,22 +544,22 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
     {
     case VTK_VERTEX:
     case VTK_POLY_VERTEX:
-      this->Verts->GetCell(loc,numPts,pts);
+      cells = this->Verts;
       break;
 
     case VTK_LINE: 
     case VTK_POLY_LINE:
-      this->Lines->GetCell(loc,numPts,pts);
+      cells = this->Lines;
       break;
 
     case VTK_TRIANGLE:
     case VTK_QUAD:
     case VTK_POLYGON:
-      this->Polys->GetCell(loc,numPts,pts);
+      cells = this->Polys;
       break;
 
     case VTK_TRIANGLE_STRIP:
-      this->Strips->GetCell(loc,numPts,pts);
+      cells = this->Strips;
       break;
 
     default:
@@ -568,31 +568,7 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
       return;
     }
 
-  // carefully compute the bounds
-  if (numPts)
-    {
-    this->Points->GetPoint( pts[0], x );
-    bounds[0] = x[0];
-    bounds[2] = x[1];
-    bounds[4] = x[2];
-    bounds[1] = x[0];
-    bounds[3] = x[1];
-    bounds[5] = x[2];
-    for (i=1; i < numPts; i++)
-      {
-      this->Points->GetPoint( pts[i], x );
-      bounds[0] = (x[0] < bounds[0] ? x[0] : bounds[0]);
-      bounds[1] = (x[0] > bounds[1] ? x[0] : bounds[1]);
-      bounds[2] = (x[1] < bounds[2] ? x[1] : bounds[2]);
-      bounds[3] = (x[1] > bounds[3] ? x[1] : bounds[3]);
-      bounds[4] = (x[2] < bounds[4] ? x[2] : bounds[4]);
-      bounds[5] = (x[2] > bounds[5] ? x[2] : bounds[5]);
-      }
-    }
-  else
-    {
-    vtkMath::UninitializeBounds(bounds);
-    }
+  cells->GetCellBounds(loc, this->Points, bounds);
 }
 
 
@@ -610,8 +586,10 @@ void vtkPolyData::ComputeBounds()
       } 
 
     int t, i;
-    vtkIdType *pts = 0;
+    const vtkIdType *pts = 0;
     vtkIdType npts = 0;
+    vtkCellArrayCursor cursor;
+    vtkIdList *ptIds = vtkIdList::New();
     double x[3];
 
     vtkCellArray *cella[4];
@@ -629,7 +607,8 @@ void vtkPolyData::ComputeBounds()
     // Iterate over cells's points
     for (t = 0; t < 4; t++) 
       {
-      for (cella[t]->InitTraversal(); cella[t]->GetNextCell(npts,pts); )
+      for (cella[t]->InitTraversal(cursor);
+           cella[t]->GetNextCell(cursor,npts,pts,ptIds); )
         {
         for (i = 0;  i < npts; i++)
           {
@@ -644,6 +623,7 @@ void vtkPolyData::ComputeBounds()
           }
         }
       }
+    ptIds->Delete();
     if (!doneOne)
       {
       vtkMath::UninitializeBounds(this->Bounds);
@@ -961,7 +941,8 @@ void vtkPolyData::BuildCells()
   vtkCellArray *inPolys=this->GetPolys();
   vtkCellArray *inStrips=this->GetStrips();
   vtkIdType npts=0;
-  vtkIdType *pts=0;
+  const vtkIdType *pts=0;
+  vtkCellArrayCursor cursor;
   vtkCellTypes *cells;
 
   vtkDebugMacro (<< "Building PolyData cells.");
@@ -981,54 +962,61 @@ void vtkPolyData::BuildCells()
   this->Cells->Register(this);
   cells->Delete();
   //
-  // Traverse various lists to create cell array
+  // Traverse various lists to create cell array. The cursors read 32 bit
+  // ids without converting the cell arrays.
   //
-  for (inVerts->InitTraversal(); inVerts->GetNextCell(npts,pts); )
+  vtkIdList *ptIds = vtkIdList::New();
+  for (inVerts->InitTraversal(cursor);
+       inVerts->GetNextCell(cursor,npts,pts,ptIds); )
     {
     if ( npts > 1 )
       {
       cells->InsertNextCell(VTK_POLY_VERTEX,
-                            inVerts->GetTraversalLocation(npts));
+                            cursor.Location-npts-1);
       }
     else
       {
-      cells->InsertNextCell(VTK_VERTEX,inVerts->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_VERTEX,cursor.Location-npts-1);
       }
     }
 
-  for (inLines->InitTraversal(); inLines->GetNextCell(npts,pts); )
+  for (inLines->InitTraversal(cursor);
+       inLines->GetNextCell(cursor,npts,pts,ptIds); )
     {
     if ( npts > 2 )
       {
-      cells->InsertNextCell(VTK_POLY_LINE,inLines->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_POLY_LINE,cursor.Location-npts-1);
       }
     else
       {
-      cells->InsertNextCell(VTK_LINE,inLines->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_LINE,cursor.Location-npts-1);
       } 
     }
 
-  for (inPolys->InitTraversal(); inPolys->GetNextCell(npts,pts); )
+  for (inPolys->InitTraversal(cursor);
+       inPolys->GetNextCell(cursor,npts,pts,ptIds); )
     {
     if ( npts == 3 )
       {
-      cells->InsertNextCell(VTK_TRIANGLE,inPolys->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_TRIANGLE,cursor.Location-npts-1);
       }
     else if ( npts == 4 )
       {
-      cells->InsertNextCell(VTK_QUAD,inPolys->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_QUAD,cursor.Location-npts-1);
       }
     else
       {
-      cells->InsertNextCell(VTK_POLYGON,inPolys->GetTraversalLocation(npts));
+      cells->InsertNextCell(VTK_POLYGON,cursor.Location-npts-1);
       }
     }
 
-  for (inStrips->InitTraversal(); inStrips->GetNextCell(npts,pts); )
+  for (inStrips->InitTraversal(cursor);
+       inStrips->GetNextCell(cursor,npts,pts,ptIds); )
     {
     cells->InsertNextCell(VTK_TRIANGLE_STRIP,
-                          inStrips->GetTraversalLocation(npts));
+                          cursor.Location-npts-1);
     }
+  ptIds->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -1076,19 +1064,58 @@ void vtkPolyData::BuildLinks(int initialSize)
 void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 {
   vtkIdType i;
-  vtkIdType *pts, npts;
+  const vtkIdType *pts;
+  vtkIdType npts;
   
-  ptIds->Reset();
+  this->vtkPolyData::GetCellPoints(cellId, npts, pts, ptIds);
+  if (npts == 0 || pts != ptIds->GetPointer(0))
+    {
+    ptIds->SetNumberOfIds(npts);
+    for (i=0; i<npts; i++)
+      {
+      ptIds->SetId(i,pts[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Point ids of a cell without copying them when possible. ptIds is only
+// used when the cell array stores 32 bit ids.
+void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                                const vtkIdType* &pts, vtkIdList *ptIds)
+{
+  int loc;
+  unsigned char type;
+
   if ( this->Cells == NULL )
     {
     this->BuildCells();
     }
 
-  this->vtkPolyData::GetCellPoints(cellId, npts, pts);
-  ptIds->InsertId (npts-1,pts[npts-1]);
-  for (i=0; i<npts-1; i++)
+  type = this->Cells->GetCellType(cellId);
+  loc = this->Cells->GetCellLocation(cellId);
+
+  switch (type)
     {
-    ptIds->SetId(i,pts[i]);
+    case VTK_VERTEX: case VTK_POLY_VERTEX:
+      this->Verts->GetCell(loc,npts,pts,ptIds);
+      break;
+
+    case VTK_LINE: case VTK_POLY_LINE:
+      this->Lines->GetCell(loc,npts,pts,ptIds);
+      break;
+
+    case VTK_TRIANGLE: case VTK_QUAD: case VTK_POLYGON:
+      this->Polys->GetCell(loc,npts,pts,ptIds);
+      break;
+
+    case VTK_TRIANGLE_STRIP:
+      this->Strips->GetCell(loc,npts,pts,ptIds);
+      break;
+
+    default:
+      npts = 0;
+      pts = NULL;
     }
 }
 
@@ -107,6 +107,14 @@ public:
   // Copy a cells point ids into list provided. (Less efficient.)
   void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds);
 
+  // Description:
+  // Get the point ids of a cell without copying them when possible, see
+  // vtkDataSet::GetCellPoints().
+  // THIS METHOD IS THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
+  // THE DATASET IS NOT MODIFIED
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                     const vtkIdType* &pts, vtkIdList *ptIds);
+
   // Description:
   // Efficient method to obtain cells using a particular point. Make sure that
   // routine BuildLinks() has been called.
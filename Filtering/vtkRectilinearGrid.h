@@ -86,6 +86,9 @@ public:
   void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
     {vtkStructuredData::GetCellPoints(cellId,ptIds,this->DataDescription,
                                       this->Dimensions);}
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                     const vtkIdType* &pts, vtkIdList *ptIds)
+    {this->vtkDataSet::GetCellPoints(cellId, npts, pts, ptIds);}
   void GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
     {vtkStructuredData::GetPointCells(ptId,cellIds,this->Dimensions);}
   void ComputeBounds();
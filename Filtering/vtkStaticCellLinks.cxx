@@ -0,0 +1,331 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticCellLinks.h"
+
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <vtkstd/vector>
+
+vtkCxxRevisionMacro(vtkStaticCellLinks, "$Revision$");
+vtkStandardNewMacro(vtkStaticCellLinks);
+
+//----------------------------------------------------------------------------
+// State shared by the passes of BuildLinks(). The cells are split in
+// NumberOfChunks chunks of ChunkSize cells and the point ids in as many
+// ranges of RangeSize ids. Counts[c*NumberOfChunks+r] is the number of uses
+// of the points of range r by the cells of chunk c, and then the position
+// of the first pair of chunk c in range r. The point of a pair is kept in
+// PairPoints and its cell directly in Links, where the ranges then sort
+// their cells by point.
+class vtkStaticCellLinksBuild
+{
+public:
+  vtkDataSet *DataSet;
+  vtkIdType NumberOfCells;
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfChunks;
+  vtkIdType ChunkSize;
+  vtkIdType RangeSize;
+  vtkIdType *Counts;
+  vtkIdType *RangeStarts;
+  vtkIdType *PairPoints;
+  vtkIdType *Offsets;
+  vtkIdType *Links;
+};
+
+//----------------------------------------------------------------------------
+// Count the uses of each range of points by each chunk of cells, or
+// scatter the pairs of each chunk when Scatter is set.
+class vtkStaticCellLinksChunks
+{
+public:
+  vtkStaticCellLinksBuild *Build;
+  int Scatter;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkStaticCellLinksBuild *b = this->Build;
+    vtkIdList *ptIds = vtkIdList::New();
+    vtkIdType npts, i, cellId, lastCell;
+    const vtkIdType *pts;
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+      {
+      vtkIdType *row = b->Counts + chunk * b->NumberOfChunks;
+      if (!this->Scatter)
+        {
+        for (i = 0; i < b->NumberOfChunks; i++)
+          {
+          row[i] = 0;
+          }
+        }
+      cellId = chunk * b->ChunkSize;
+      lastCell = cellId + b->ChunkSize;
+      if (lastCell > b->NumberOfCells)
+        {
+        lastCell = b->NumberOfCells;
+        }
+      for (; cellId < lastCell; cellId++)
+        {
+        b->DataSet->GetCellPoints(cellId, npts, pts, ptIds);
+        for (i = 0; i < npts; i++)
+          {
+          vtkIdType range = pts[i] / b->RangeSize;
+          if (this->Scatter)
+            {
+            vtkIdType pos = row[range]++;
+            b->PairPoints[pos] = pts[i];
+            b->Links[pos] = cellId;
+            }
+          else
+            {
+            row[range]++;
+            }
+          }
+        }
+      }
+    ptIds->Delete();
+    }
+};
+
+//----------------------------------------------------------------------------
+// Compute the offsets of the points of each range from the histogram of
+// its pairs, and scatter the cell ids to their place in the links. The
+// range of links is copied first, as the pairs are read from it. The pairs
+// of a range are ordered by cell id, so are the lists of cells of its
+// points.
+class vtkStaticCellLinksRanges
+{
+public:
+  vtkStaticCellLinksBuild *Build;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkStaticCellLinksBuild *b = this->Build;
+    vtkstd::vector<vtkIdType> cursor;
+    vtkstd::vector<vtkIdType> pairCells;
+    for (vtkIdType range = begin; range < end; range++)
+      {
+      vtkIdType firstPt = range * b->RangeSize;
+      vtkIdType lastPt = firstPt + b->RangeSize;
+      if (lastPt > b->NumberOfPoints)
+        {
+        lastPt = b->NumberOfPoints;
+        }
+      if (firstPt >= lastPt)
+        {
+        continue;
+        }
+      vtkIdType first = b->RangeStarts[range];
+      vtkIdType last = b->RangeStarts[range+1];
+      vtkIdType i, ptId;
+
+      cursor.assign(lastPt - firstPt, 0);
+      for (i = first; i < last; i++)
+        {
+        cursor[b->PairPoints[i] - firstPt]++;
+        }
+      vtkIdType offset = first;
+      for (ptId = firstPt; ptId < lastPt; ptId++)
+        {
+        vtkIdType ncells = cursor[ptId - firstPt];
+        cursor[ptId - firstPt] = offset;
+        offset += ncells;
+        b->Offsets[ptId+1] = offset;
+        }
+      pairCells.assign(b->Links + first, b->Links + last);
+      for (i = first; i < last; i++)
+        {
+        b->Links[cursor[b->PairPoints[i] - firstPt]++] = pairCells[i - first];
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkStaticCellLinks::vtkStaticCellLinks()
+{
+  this->NumberOfPoints = 0;
+  this->LinksSize = 0;
+  this->Offsets = NULL;
+  this->Links = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkStaticCellLinks::~vtkStaticCellLinks()
+{
+  this->Initialize();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::Initialize()
+{
+  delete [] this->Offsets;
+  delete [] this->Links;
+  this->Offsets = NULL;
+  this->Links = NULL;
+  this->NumberOfPoints = 0;
+  this->LinksSize = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::BuildLinks(vtkDataSet *data)
+{
+  this->Initialize();
+
+  vtkStaticCellLinksBuild build;
+  build.DataSet = data;
+  build.NumberOfPoints = data->GetNumberOfPoints();
+  build.NumberOfCells = data->GetNumberOfCells();
+  this->NumberOfPoints = build.NumberOfPoints;
+  this->Offsets = new vtkIdType[build.NumberOfPoints+1];
+  this->Offsets[0] = 0;
+  if (build.NumberOfPoints == 0)
+    {
+    return;
+    }
+  if (build.NumberOfCells == 0)
+    {
+    for (vtkIdType ptId = 1; ptId <= build.NumberOfPoints; ptId++)
+      {
+      this->Offsets[ptId] = 0;
+      }
+    return;
+    }
+
+  // The first call to GetCellPoints() is made from this thread, as the
+  // thread-safe methods of vtkDataSet require.
+  vtkIdList *ptIds = vtkIdList::New();
+  data->GetCellPoints(0, ptIds);
+  ptIds->Delete();
+
+  // A few chunks per thread balance the load.
+  build.NumberOfChunks = 4 * vtkSMPTools::GetNumberOfThreads();
+  if (build.NumberOfChunks > build.NumberOfCells)
+    {
+    build.NumberOfChunks = build.NumberOfCells;
+    }
+  vtkIdType numChunks = build.NumberOfChunks;
+  build.ChunkSize = (build.NumberOfCells + numChunks - 1) / numChunks;
+  build.RangeSize = (build.NumberOfPoints + numChunks - 1) / numChunks;
+  vtkstd::vector<vtkIdType> counts(numChunks * numChunks);
+  vtkstd::vector<vtkIdType> rangeStarts(numChunks + 1);
+  build.Counts = &counts[0];
+  build.RangeStarts = &rangeStarts[0];
+
+  vtkStaticCellLinksChunks chunks;
+  chunks.Build = &build;
+  chunks.Scatter = 0;
+  vtkSMPTools::For(0, numChunks, 1, chunks);
+
+  // Pairs are grouped by range of points, then by chunk of cells.
+  vtkIdType chunk, range, pos = 0;
+  for (range = 0; range < numChunks; range++)
+    {
+    rangeStarts[range] = pos;
+    for (chunk = 0; chunk < numChunks; chunk++)
+      {
+      vtkIdType count = counts[chunk * numChunks + range];
+      counts[chunk * numChunks + range] = pos;
+      pos += count;
+      }
+    }
+  rangeStarts[numChunks] = pos;
+  this->LinksSize = pos;
+
+  this->Links = new vtkIdType[pos];
+  build.Offsets = this->Offsets;
+  build.Links = this->Links;
+  build.PairPoints = new vtkIdType[pos];
+  chunks.Scatter = 1;
+  vtkSMPTools::For(0, numChunks, 1, chunks);
+
+  vtkStaticCellLinksRanges ranges;
+  ranges.Build = &build;
+  vtkSMPTools::For(0, numChunks, 1, ranges);
+
+  delete [] build.PairPoints;
+}
+
+//----------------------------------------------------------------------------
+// Same as vtkPolyData::GetCellEdgeNeighbors(): the lists of cells of p1
+// and p2 are sorted, so they are merged.
+void vtkStaticCellLinks::GetCellEdgeNeighbors(vtkIdType cellId, vtkIdType p1,
+                                              vtkIdType p2,
+                                              vtkIdList *cellIds)
+{
+  const vtkIdType *cells1 = this->GetCells(p1);
+  const vtkIdType *end1 = cells1 + this->GetNcells(p1);
+  const vtkIdType *cells2 = this->GetCells(p2);
+  const vtkIdType *end2 = cells2 + this->GetNcells(p2);
+
+  cellIds->Reset();
+  for (; cells1 < end1; cells1++)
+    {
+    while (cells2 < end2 && *cells2 < *cells1)
+      {
+      cells2++;
+      }
+    if (cells2 == end2)
+      {
+      break;
+      }
+    if (*cells2 == *cells1 && *cells1 != cellId)
+      {
+      cellIds->InsertNextId(*cells1);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkStaticCellLinks::GetActualMemorySize()
+{
+  vtkIdType size = 0;
+  if (this->Offsets)
+    {
+    size += (this->NumberOfPoints + 1) * sizeof(vtkIdType);
+    }
+  size += this->LinksSize * sizeof(vtkIdType);
+
+  return static_cast<unsigned long>( ceil(size/1024.0)); //kilobytes
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::DeepCopy(vtkStaticCellLinks *src)
+{
+  this->Initialize();
+  if (!src->Offsets)
+    {
+    return;
+    }
+  this->NumberOfPoints = src->NumberOfPoints;
+  this->LinksSize = src->LinksSize;
+  this->Offsets = new vtkIdType[this->NumberOfPoints+1];
+  memcpy(this->Offsets, src->Offsets,
+         (this->NumberOfPoints+1) * sizeof(vtkIdType));
+  this->Links = new vtkIdType[this->LinksSize];
+  memcpy(this->Links, src->Links, this->LinksSize * sizeof(vtkIdType));
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Points: " << this->NumberOfPoints << "\n";
+  os << indent << "Links Size: " << this->LinksSize << "\n";
+}
@@ -0,0 +1,112 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticCellLinks - compact links from points to the cells using them
+// .SECTION Description
+// vtkStaticCellLinks provides the same information as vtkCellLinks, the
+// list of cells using each point, for datasets that are not modified once
+// the links are built. The lists are stored in two arrays: the ids of the
+// cells using point ptId are Links[Offsets[ptId]] to
+// Links[Offsets[ptId+1]-1], in increasing order. This avoids one heap
+// allocation per point and the 65535 cells per point limit of vtkCellLinks.
+//
+// BuildLinks() runs on the vtkThreadPool (see vtkSMPTools). The cells are
+// split in chunks and the point ids in as many ranges. A parallel pass
+// counts the uses of each point range by each chunk, and a second pass
+// scatters the (point, cell) pairs of each chunk to the part of a
+// temporary array reserved to it. Each point range is then processed
+// independently: a histogram of its pairs gives the offsets of its points,
+// and the cell ids are scattered to their place. The result does not
+// depend on the number of threads. Besides the links, building them takes
+// a temporary array of the same size, and each thread copies the links of
+// the range of points it processes.
+//
+// .SECTION Caveats
+// The links cannot be edited: build them again when the dataset changes.
+// BuildLinks() uses vtkDataSet::GetCellPoints() from several threads.
+//
+// .SECTION See Also
+// vtkCellLinks vtkSMPTools
+
+#ifndef __vtkStaticCellLinks_h
+#define __vtkStaticCellLinks_h
+
+#include "vtkObject.h"
+
+class vtkDataSet;
+class vtkIdList;
+
+class VTK_FILTERING_EXPORT vtkStaticCellLinks : public vtkObject
+{
+public:
+  static vtkStaticCellLinks *New();
+  vtkTypeRevisionMacro(vtkStaticCellLinks,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Build the links of the given dataset.
+  void BuildLinks(vtkDataSet *data);
+
+  // Description:
+  // Release the links.
+  void Initialize();
+
+  // Description:
+  // Get the number of points and the total number of links.
+  vtkIdType GetNumberOfPoints() { return this->NumberOfPoints; }
+  vtkIdType GetLinksSize() { return this->LinksSize; }
+
+  // Description:
+  // Get the number of cells using the point ptId, and the list of their
+  // ids. THESE METHODS ARE THREAD SAFE.
+  vtkIdType GetNcells(vtkIdType ptId)
+    { return this->Offsets[ptId+1] - this->Offsets[ptId]; }
+  vtkIdType *GetCells(vtkIdType ptId)
+    { return this->Links + this->Offsets[ptId]; }
+
+  // Description:
+  // Get the cells other than cellId using the edge (p1,p2), as
+  // vtkPolyData::GetCellEdgeNeighbors() does. THIS METHOD IS THREAD SAFE.
+  void GetCellEdgeNeighbors(vtkIdType cellId, vtkIdType p1, vtkIdType p2,
+                            vtkIdList *cellIds);
+
+  // Description:
+  // Direct access to the offsets (GetNumberOfPoints()+1 values) and links
+  // (GetLinksSize() values).
+  vtkIdType *GetOffsets() { return this->Offsets; }
+  vtkIdType *GetLinks() { return this->Links; }
+
+  // Description:
+  // Return the memory in kilobytes consumed by the links.
+  unsigned long GetActualMemorySize();
+
+  // Description:
+  // Standard DeepCopy method.
+  void DeepCopy(vtkStaticCellLinks *src);
+
+protected:
+  vtkStaticCellLinks();
+  ~vtkStaticCellLinks();
+
+  vtkIdType NumberOfPoints;
+  vtkIdType LinksSize;
+  vtkIdType *Offsets;
+  vtkIdType *Links;
+
+private:
+  vtkStaticCellLinks(const vtkStaticCellLinks&);  // Not implemented.
+  void operator=(const vtkStaticCellLinks&);  // Not implemented.
+};
+
+#endif
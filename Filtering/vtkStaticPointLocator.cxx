@@ -0,0 +1,670 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticPointLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/utility>
+#include <vtkstd/vector>
+
+vtkCxxRevisionMacro(vtkStaticPointLocator, "$Revision$");
+vtkStandardNewMacro(vtkStaticPointLocator);
+
+//----------------------------------------------------------------------------
+// A point and the bucket it falls in. Sorting the pairs by bucket keeps
+// the points of a bucket in increasing id order.
+struct vtkStaticPointLocatorTuple
+{
+  vtkIdType Bucket;
+  vtkIdType PtId;
+
+  bool operator<(const vtkStaticPointLocatorTuple& tuple) const
+    {
+    return this->Bucket < tuple.Bucket;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Compute the bucket of each point, as GetBucketIndices() does.
+class vtkStaticPointLocatorBin
+{
+public:
+  vtkDataSet *DataSet;
+  const double *Bounds;
+  const int *Divisions;
+  vtkStaticPointLocatorTuple *Tuples;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    const int *divs = this->Divisions;
+    double x[3];
+    int ijk[3];
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      this->DataSet->GetPoint(ptId, x);
+      for (int j = 0; j < 3; j++)
+        {
+        double t = (x[j] - this->Bounds[2*j]) /
+          (this->Bounds[2*j+1] - this->Bounds[2*j]) * divs[j];
+        ijk[j] = (t <= 0.0 ? 0 :
+                  (t >= divs[j] ? divs[j] - 1 : static_cast<int>(t)));
+        }
+      this->Tuples[ptId].Bucket = ijk[0] +
+        static_cast<vtkIdType>(ijk[1]) * divs[0] +
+        static_cast<vtkIdType>(ijk[2]) * divs[0] * divs[1];
+      this->Tuples[ptId].PtId = ptId;
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Extract the point ids of the sorted pairs, and set the offset of each
+// bucket. The offset of bucket b is written by the first pair whose bucket
+// is b or more, so the ranges of pairs are processed independently.
+class vtkStaticPointLocatorOffsets
+{
+public:
+  const vtkStaticPointLocatorTuple *Tuples;
+  vtkIdType *BucketOffsets;
+  vtkIdType *PointIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType prevBucket = (begin == 0 ? -1 : this->Tuples[begin-1].Bucket);
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      vtkIdType bucket = this->Tuples[i].Bucket;
+      for (vtkIdType b = prevBucket + 1; b <= bucket; b++)
+        {
+        this->BucketOffsets[b] = i;
+        }
+      prevBucket = bucket;
+      this->PointIds[i] = this->Tuples[i].PtId;
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Call f(bucketId) for the buckets of the box [lo,hi] that are not in the
+// box [innerLo,innerHi]. An inner box with innerLo > innerHi is empty.
+template <class F>
+static void vtkStaticPointLocatorVisit(const int divs[3], const int lo[3],
+                                       const int hi[3], const int innerLo[3],
+                                       const int innerHi[3], F& f)
+{
+  vtkIdType sliceSize = static_cast<vtkIdType>(divs[0]) * divs[1];
+  int i, j, k;
+  for (k = lo[2]; k <= hi[2]; k++)
+    {
+    int kInside = (k >= innerLo[2] && k <= innerHi[2]);
+    for (j = lo[1]; j <= hi[1]; j++)
+      {
+      vtkIdType rowId = k * sliceSize + static_cast<vtkIdType>(j) * divs[0];
+      if (kInside && j >= innerLo[1] && j <= innerHi[1])
+        {
+        // Skip the inner box on this row.
+        for (i = lo[0]; i <= hi[0] && i < innerLo[0]; i++)
+          {
+          f(rowId + i);
+          }
+        for (i = (innerHi[0] + 1 > lo[0] ? innerHi[0] + 1 : lo[0]);
+             i <= hi[0]; i++)
+          {
+          f(rowId + i);
+          }
+        }
+      else
+        {
+        for (i = lo[0]; i <= hi[0]; i++)
+          {
+          f(rowId + i);
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Common state of the functors visiting the points of buckets.
+class vtkStaticPointLocatorQuery
+{
+public:
+  const vtkIdType *BucketOffsets;
+  const vtkIdType *PointIds;
+  vtkDataSet *DataSet;
+  const double *X;
+};
+
+// Keep the closest point within MinDist2. Ties go to the smallest id.
+class vtkStaticPointLocatorClosest : public vtkStaticPointLocatorQuery
+{
+public:
+  vtkIdType Closest;
+  double MinDist2;
+
+  void operator()(vtkIdType bucket)
+    {
+    double pt[3];
+    for (vtkIdType i = this->BucketOffsets[bucket];
+         i < this->BucketOffsets[bucket+1]; i++)
+      {
+      vtkIdType ptId = this->PointIds[i];
+      this->DataSet->GetPoint(ptId, pt);
+      double dist2 = vtkMath::Distance2BetweenPoints(this->X, pt);
+      if (dist2 < this->MinDist2 ||
+          (dist2 == this->MinDist2 &&
+           (this->Closest < 0 || ptId < this->Closest)))
+        {
+        this->Closest = ptId;
+        this->MinDist2 = dist2;
+        }
+      }
+    }
+};
+
+// Insert the points within Radius2 in Result.
+class vtkStaticPointLocatorWithinRadius : public vtkStaticPointLocatorQuery
+{
+public:
+  double Radius2;
+  vtkIdList *Result;
+
+  void operator()(vtkIdType bucket)
+    {
+    double pt[3];
+    for (vtkIdType i = this->BucketOffsets[bucket];
+         i < this->BucketOffsets[bucket+1]; i++)
+      {
+      this->DataSet->GetPoint(this->PointIds[i], pt);
+      if (vtkMath::Distance2BetweenPoints(this->X, pt) <= this->Radius2)
+        {
+        this->Result->InsertNextId(this->PointIds[i]);
+        }
+      }
+    }
+};
+
+// Gather the points within Radius2 with their squared distance.
+class vtkStaticPointLocatorGather : public vtkStaticPointLocatorQuery
+{
+public:
+  double Radius2;
+  vtkstd::vector<vtkstd::pair<double,vtkIdType> > *Points;
+
+  void operator()(vtkIdType bucket)
+    {
+    double pt[3];
+    for (vtkIdType i = this->BucketOffsets[bucket];
+         i < this->BucketOffsets[bucket+1]; i++)
+      {
+      vtkIdType ptId = this->PointIds[i];
+      this->DataSet->GetPoint(ptId, pt);
+      double dist2 = vtkMath::Distance2BetweenPoints(this->X, pt);
+      if (dist2 <= this->Radius2)
+        {
+        this->Points->push_back(vtkstd::pair<double,vtkIdType>(dist2, ptId));
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Construct with automatic computation of divisions, averaging
+// 3 points per bucket.
+vtkStaticPointLocator::vtkStaticPointLocator()
+{
+  this->Divisions[0] = this->Divisions[1] = this->Divisions[2] = 50;
+  this->NumberOfPointsPerBucket = 3;
+  this->H[0] = this->H[1] = this->H[2] = 0.0;
+  this->NumberOfBuckets = 0;
+  this->BucketOffsets = NULL;
+  this->PointIds = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkStaticPointLocator::~vtkStaticPointLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::Initialize()
+{
+  // free up hash table
+  this->FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FreeSearchStructure()
+{
+  delete [] this->BucketOffsets;
+  delete [] this->PointIds;
+  this->BucketOffsets = NULL;
+  this->PointIds = NULL;
+  this->NumberOfBuckets = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GetBucketIndices(const double x[3], int ijk[3])
+{
+  for (int j = 0; j < 3; j++)
+    {
+    double t = (x[j] - this->Bounds[2*j]) /
+      (this->Bounds[2*j+1] - this->Bounds[2*j]) * this->Divisions[j];
+    ijk[j] = (t <= 0.0 ? 0 :
+              (t >= this->Divisions[j] ? this->Divisions[j] - 1 :
+               static_cast<int>(t)));
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GetBucketRange(const double x[3], double dist,
+                                           int minIjk[3], int maxIjk[3])
+{
+  double lo[3], hi[3];
+  for (int j = 0; j < 3; j++)
+    {
+    lo[j] = x[j] - dist;
+    hi[j] = x[j] + dist;
+    }
+  this->GetBucketIndices(lo, minIjk);
+  this->GetBucketIndices(hi, maxIjk);
+}
+
+//----------------------------------------------------------------------------
+//  Bin the points of the dataset in a uniform subdivision of space, subject
+//  to the NumberOfPointsPerBucket constraint when Automatic is on.
+void vtkStaticPointLocator::BuildLocator()
+{
+  vtkIdType numPts;
+  int i, ndivs[3];
+
+  if ( (this->BucketOffsets != NULL) && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+    {
+    return;
+    }
+
+  vtkDebugMacro( << "Binning points..." );
+  this->Level = 1; //only single lowest level
+
+  if ( !this->DataSet || (numPts = this->DataSet->GetNumberOfPoints()) < 1 )
+    {
+    vtkErrorMacro( << "No points to subdivide");
+    return;
+    }
+  this->FreeSearchStructure();
+
+  // Size the buckets. GetBounds() also makes the point access methods of
+  // the dataset safe to call from several threads.
+  double *bounds = this->DataSet->GetBounds();
+  for (i=0; i<3; i++)
+    {
+    this->Bounds[2*i] = bounds[2*i];
+    this->Bounds[2*i+1] = bounds[2*i+1];
+    if ( this->Bounds[2*i+1] <= this->Bounds[2*i] ) //prevent zero width
+      {
+      this->Bounds[2*i+1] = this->Bounds[2*i] + 1.0;
+      }
+    }
+
+  if ( this->Automatic )
+    {
+    double level = static_cast<double>(numPts) / this->NumberOfPointsPerBucket;
+    level = ceil( pow(level, 0.33333333) );
+    for (i=0; i<3; i++)
+      {
+      ndivs[i] = static_cast<int>(level);
+      }
+    }
+  else
+    {
+    for (i=0; i<3; i++)
+      {
+      ndivs[i] = this->Divisions[i];
+      }
+    }
+  for (i=0; i<3; i++)
+    {
+    this->Divisions[i] = (ndivs[i] > 0 ? ndivs[i] : 1);
+    this->H[i] = (this->Bounds[2*i+1] - this->Bounds[2*i]) / this->Divisions[i];
+    }
+  this->NumberOfBuckets = static_cast<vtkIdType>(this->Divisions[0]) *
+    this->Divisions[1] * this->Divisions[2];
+
+  // Compute the bucket of each point, then sort the points by bucket.
+  vtkStaticPointLocatorTuple *tuples = new vtkStaticPointLocatorTuple[numPts];
+  vtkStaticPointLocatorBin bin;
+  bin.DataSet = this->DataSet;
+  bin.Bounds = this->Bounds;
+  bin.Divisions = this->Divisions;
+  bin.Tuples = tuples;
+  vtkSMPTools::For(0, numPts, bin);
+  vtkSMPTools::Sort(tuples, tuples + numPts);
+
+  // Extract the offsets of the buckets and the sorted point ids. The
+  // buckets after the last non empty one end the array.
+  this->BucketOffsets = new vtkIdType[this->NumberOfBuckets+1];
+  this->PointIds = new vtkIdType[numPts];
+  vtkStaticPointLocatorOffsets offsets;
+  offsets.Tuples = tuples;
+  offsets.BucketOffsets = this->BucketOffsets;
+  offsets.PointIds = this->PointIds;
+  vtkSMPTools::For(0, numPts, offsets);
+  for (vtkIdType b = tuples[numPts-1].Bucket + 1; b <= this->NumberOfBuckets;
+       b++)
+    {
+    this->BucketOffsets[b] = numPts;
+    }
+  delete [] tuples;
+
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::FindClosestPoint(const double x[3])
+{
+  double dist2;
+  return this->FindClosestPointWithinRadius(VTK_DOUBLE_MAX, x, dist2);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::FindClosestPointWithinRadius(
+  double radius, const double x[3], double& dist2)
+{
+  dist2 = -1.0;
+  if ( !this->DataSet || this->DataSet->GetNumberOfPoints() < 1 )
+    {
+    return -1;
+    }
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  vtkStaticPointLocatorClosest closest;
+  closest.BucketOffsets = this->BucketOffsets;
+  closest.PointIds = this->PointIds;
+  closest.DataSet = this->DataSet;
+  closest.X = x;
+  closest.Closest = -1;
+  closest.MinDist2 = radius*radius;
+
+  // Search the shells of buckets around the bucket of x until a point is
+  // found, without leaving the buckets overlapped by the radius.
+  int ijk[3], radiusLo[3], radiusHi[3], lo[3], hi[3], innerLo[3], innerHi[3];
+  int j, level, maxLevel = 0;
+  this->GetBucketIndices(x, ijk);
+  this->GetBucketRange(x, radius, radiusLo, radiusHi);
+  for (j=0; j<3; j++)
+    {
+    maxLevel = (ijk[j] - radiusLo[j] > maxLevel ? ijk[j] - radiusLo[j] :
+                maxLevel);
+    maxLevel = (radiusHi[j] - ijk[j] > maxLevel ? radiusHi[j] - ijk[j] :
+                maxLevel);
+    }
+  for (level=0; closest.Closest < 0 && level <= maxLevel; level++)
+    {
+    for (j=0; j<3; j++)
+      {
+      lo[j] = (ijk[j] - level > radiusLo[j] ? ijk[j] - level : radiusLo[j]);
+      hi[j] = (ijk[j] + level < radiusHi[j] ? ijk[j] + level : radiusHi[j]);
+      innerLo[j] = ijk[j] - level + 1;
+      innerHi[j] = ijk[j] + level - 1;
+      }
+    vtkStaticPointLocatorVisit(this->Divisions, lo, hi, innerLo, innerHi,
+                               closest);
+    }
+
+  // The point found may not be the closest one: search the buckets
+  // overlapped by the sphere through it that were not searched yet.
+  if ( closest.Closest >= 0 && closest.MinDist2 > 0.0 )
+    {
+    this->GetBucketRange(x, sqrt(closest.MinDist2), lo, hi);
+    for (j=0; j<3; j++)
+      {
+      innerLo[j] = ijk[j] - level + 1;
+      innerHi[j] = ijk[j] + level - 1;
+      }
+    vtkStaticPointLocatorVisit(this->Divisions, lo, hi, innerLo, innerHi,
+                               closest);
+    }
+
+  if ( closest.Closest >= 0 )
+    {
+    dist2 = closest.MinDist2;
+    }
+  return closest.Closest;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestNPoints(int N, const double x[3],
+                                               vtkIdList *result)
+{
+  result->Reset();
+  if ( N < 1 || !this->DataSet || this->DataSet->GetNumberOfPoints() < 1 )
+    {
+    return;
+    }
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  vtkstd::vector<vtkstd::pair<double,vtkIdType> > points;
+  vtkStaticPointLocatorGather gather;
+  gather.BucketOffsets = this->BucketOffsets;
+  gather.PointIds = this->PointIds;
+  gather.DataSet = this->DataSet;
+  gather.X = x;
+  gather.Radius2 = VTK_DOUBLE_MAX;
+  gather.Points = &points;
+
+  // First gather the points of expanding shells of buckets until there
+  // are at least N of them.
+  int ijk[3], lo[3], hi[3], innerLo[3], innerHi[3];
+  int j, level, maxLevel = 0;
+  this->GetBucketIndices(x, ijk);
+  for (j=0; j<3; j++)
+    {
+    maxLevel = (this->Divisions[j] > maxLevel ? this->Divisions[j] : maxLevel);
+    }
+  for (level=0; static_cast<int>(points.size()) < N && level < maxLevel;
+       level++)
+    {
+    for (j=0; j<3; j++)
+      {
+      lo[j] = (ijk[j] - level > 0 ? ijk[j] - level : 0);
+      hi[j] = (ijk[j] + level < this->Divisions[j] - 1 ? ijk[j] + level :
+               this->Divisions[j] - 1);
+      innerLo[j] = ijk[j] - level + 1;
+      innerHi[j] = ijk[j] + level - 1;
+      }
+    vtkStaticPointLocatorVisit(this->Divisions, lo, hi, innerLo, innerHi,
+                               gather);
+    }
+
+  // Then add the points of the buckets not searched yet that may be closer
+  // than the N-th closest point found.
+  if ( static_cast<int>(points.size()) >= N )
+    {
+    vtkstd::nth_element(points.begin(), points.begin() + (N-1), points.end());
+    gather.Radius2 = points[N-1].first;
+    if ( gather.Radius2 > 0.0 )
+      {
+      this->GetBucketRange(x, sqrt(gather.Radius2), lo, hi);
+      for (j=0; j<3; j++)
+        {
+        innerLo[j] = ijk[j] - level + 1;
+        innerHi[j] = ijk[j] + level - 1;
+        }
+      vtkStaticPointLocatorVisit(this->Divisions, lo, hi, innerLo, innerHi,
+                                 gather);
+      }
+    }
+
+  int numFound = (static_cast<int>(points.size()) < N ?
+                  static_cast<int>(points.size()) : N);
+  vtkstd::partial_sort(points.begin(), points.begin() + numFound,
+                       points.end());
+  result->SetNumberOfIds(numFound);
+  for (j=0; j < numFound; j++)
+    {
+    result->SetId(j, points[j].second);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindPointsWithinRadius(double R, const double x[3],
+                                                   vtkIdList *result)
+{
+  result->Reset();
+  if ( !this->DataSet || this->DataSet->GetNumberOfPoints() < 1 )
+    {
+    return;
+    }
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  vtkStaticPointLocatorWithinRadius within;
+  within.BucketOffsets = this->BucketOffsets;
+  within.PointIds = this->PointIds;
+  within.DataSet = this->DataSet;
+  within.X = x;
+  within.Radius2 = R*R;
+  within.Result = result;
+
+  int lo[3], hi[3], innerLo[3] = {1, 1, 1}, innerHi[3] = {0, 0, 0};
+  this->GetBucketRange(x, R, lo, hi);
+  vtkStaticPointLocatorVisit(this->Divisions, lo, hi, innerLo, innerHi,
+                             within);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::GetPointsInBucket(const double x[3],
+                                                   int ijk[3],
+                                                   const vtkIdType* &ptIds)
+{
+  ptIds = NULL;
+  if ( this->BucketOffsets == NULL )
+    {
+    return 0;
+    }
+  this->GetBucketIndices(x, ijk);
+  vtkIdType bucket = ijk[0] + static_cast<vtkIdType>(ijk[1]) *
+    this->Divisions[0] + static_cast<vtkIdType>(ijk[2]) *
+    this->Divisions[0] * this->Divisions[1];
+  ptIds = this->PointIds + this->BucketOffsets[bucket];
+  return this->BucketOffsets[bucket+1] - this->BucketOffsets[bucket];
+}
+
+//----------------------------------------------------------------------------
+// Build a representation of the boundary between empty and non empty
+// buckets.
+void vtkStaticPointLocator::GenerateRepresentation(int vtkNotUsed(level),
+                                                   vtkPolyData *pd)
+{
+  if ( this->BucketOffsets == NULL )
+    {
+    vtkErrorMacro(<<"Can't build representation...no data!");
+    return;
+    }
+
+  vtkPoints *pts = vtkPoints::New();
+  pts->Allocate(5000);
+  vtkCellArray *polys = vtkCellArray::New();
+  polys->Allocate(10000);
+
+  int i, j, k, ii, ijk[3];
+  vtkIdType idx, step[3];
+  step[0] = 1;
+  step[1] = this->Divisions[0];
+  step[2] = static_cast<vtkIdType>(this->Divisions[0]) * this->Divisions[1];
+  for ( k=0; k < this->Divisions[2]; k++)
+    {
+    for ( j=0; j < this->Divisions[1]; j++)
+      {
+      for ( i=0; i < this->Divisions[0]; i++)
+        {
+        ijk[0] = i; ijk[1] = j; ijk[2] = k;
+        idx = i + j*step[1] + k*step[2];
+        int inside = (this->BucketOffsets[idx+1] > this->BucketOffsets[idx]);
+        for (ii=0; ii < 3; ii++)
+          {
+          // face shared with the "negative" neighbor
+          int neiInside = 0;
+          if ( ijk[ii] > 0 )
+            {
+            vtkIdType nei = idx - step[ii];
+            neiInside = (this->BucketOffsets[nei+1] > this->BucketOffsets[nei]);
+            }
+          if ( inside != neiInside )
+            {
+            this->GenerateFace(ii,i,j,k,pts,polys);
+            }
+          // buckets on "positive" boundaries close the representation
+          if ( inside && ijk[ii]+1 >= this->Divisions[ii] )
+            {
+            this->GenerateFace(ii, i+(ii==0), j+(ii==1), k+(ii==2),
+                               pts, polys);
+            }
+          }
+        }
+      }
+    }
+
+  pd->SetPoints(pts);
+  pts->Delete();
+  pd->SetPolys(polys);
+  polys->Delete();
+  pd->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GenerateFace(int face, int i, int j, int k,
+                                         vtkPoints *pts, vtkCellArray *polys)
+{
+  vtkIdType ids[4];
+  double origin[3], x[3];
+  int u = (face + 1) % 3, v = (face + 2) % 3;
+
+  // define first corner, then walk around the face in its (u,v) plane
+  origin[0] = this->Bounds[0] + i * this->H[0];
+  origin[1] = this->Bounds[2] + j * this->H[1];
+  origin[2] = this->Bounds[4] + k * this->H[2];
+  ids[0] = pts->InsertNextPoint(origin);
+
+  x[0] = origin[0]; x[1] = origin[1]; x[2] = origin[2];
+  x[u] += this->H[u];
+  ids[1] = pts->InsertNextPoint(x);
+  x[v] += this->H[v];
+  ids[2] = pts->InsertNextPoint(x);
+  x[u] = origin[u];
+  ids[3] = pts->InsertNextPoint(x);
+
+  polys->InsertNextCell(4,ids);
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number of Points Per Bucket: "
+     << this->NumberOfPointsPerBucket << "\n";
+  os << indent << "Divisions: (" << this->Divisions[0] << ", "
+     << this->Divisions[1] << ", " << this->Divisions[2] << ")\n";
+  os << indent << "Number Of Buckets: " << this->NumberOfBuckets << "\n";
+}
@@ -0,0 +1,151 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticPointLocator - quickly locate points in a dataset that does not change
+// .SECTION Description
+// vtkStaticPointLocator divides space in a regular array of buckets like
+// vtkPointLocator, but is meant for datasets that are only queried once the
+// locator is built: points cannot be inserted. The ids of the points are
+// stored in a single array sorted by bucket, and the points of bucket b are
+// PointIds[BucketOffsets[b]] to PointIds[BucketOffsets[b+1]-1]. There is
+// no per bucket allocation, so the locator is much smaller and faster to
+// build than vtkPointLocator on large point clouds.
+//
+// BuildLocator() runs on the vtkThreadPool (see vtkSMPTools): the bucket of
+// each point is computed in parallel, the (bucket, point id) pairs are
+// sorted with vtkSMPTools::Sort(), and the offsets of the buckets are
+// filled in parallel from the sorted pairs. Within a bucket the points are
+// in increasing id order, so the results do not depend on the number of
+// threads.
+
+// .SECTION Caveats
+// The query methods are thread safe once the locator is built: call
+// BuildLocator() (or any query) from a single thread first.
+
+// .SECTION See Also
+// vtkPointLocator vtkAbstractPointLocator vtkSMPTools
+
+#ifndef __vtkStaticPointLocator_h
+#define __vtkStaticPointLocator_h
+
+#include "vtkAbstractPointLocator.h"
+
+class vtkCellArray;
+class vtkIdList;
+class vtkPoints;
+
+class VTK_FILTERING_EXPORT vtkStaticPointLocator : public vtkAbstractPointLocator
+{
+public:
+  // Description:
+  // Construct with automatic computation of divisions, averaging
+  // 3 points per bucket.
+  static vtkStaticPointLocator *New();
+
+  vtkTypeRevisionMacro(vtkStaticPointLocator,vtkAbstractPointLocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the number of divisions in x-y-z directions. Used when Automatic
+  // is off.
+  vtkSetVector3Macro(Divisions,int);
+  vtkGetVectorMacro(Divisions,int,3);
+
+  // Description:
+  // Specify the average number of points in each bucket. Used when
+  // Automatic is on.
+  vtkSetClampMacro(NumberOfPointsPerBucket,int,1,VTK_LARGE_INTEGER);
+  vtkGetMacro(NumberOfPointsPerBucket,int);
+
+  // Description:
+  // Given a position x, return the id of the point closest to it.
+  // These methods are thread safe if BuildLocator() is directly or
+  // indirectly called from a single thread first.
+  virtual vtkIdType FindClosestPoint(const double x[3]);
+
+  // Description:
+  // Given a position x and a radius r, return the id of the point
+  // closest to the point in that radius, or -1 if there is none.
+  // dist2 returns the squared distance to the point.
+  // These methods are thread safe if BuildLocator() is directly or
+  // indirectly called from a single thread first.
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double radius, const double x[3], double& dist2);
+
+  // Description:
+  // Find the closest N points to a position. The returned points are
+  // sorted from closest to farthest; points at the same distance are
+  // sorted by id.
+  // These methods are thread safe if BuildLocator() is directly or
+  // indirectly called from a single thread first.
+  virtual void FindClosestNPoints(int N, const double x[3], vtkIdList *result);
+
+  // Description:
+  // Find all points within a specified radius R of position x.
+  // The result is sorted by bucket, then by point id.
+  // These methods are thread safe if BuildLocator() is directly or
+  // indirectly called from a single thread first.
+  virtual void FindPointsWithinRadius(double R, const double x[3],
+                                      vtkIdList *result);
+
+  // Description:
+  // Return the number of points in the bucket containing x, and a pointer
+  // to their ids in ptIds. The ijk indices of the bucket are returned too.
+  // This method is thread safe once the locator is built.
+  vtkIdType GetPointsInBucket(const double x[3], int ijk[3],
+                              const vtkIdType* &ptIds);
+
+  // Description:
+  // Return the total number of buckets.
+  vtkGetMacro(NumberOfBuckets,vtkIdType);
+
+  // Description:
+  // See vtkLocator interface documentation.
+  // These methods are not thread safe.
+  void Initialize();
+  void FreeSearchStructure();
+  void BuildLocator();
+  void GenerateRepresentation(int level, vtkPolyData *pd);
+
+protected:
+  vtkStaticPointLocator();
+  virtual ~vtkStaticPointLocator();
+
+  // Description:
+  // Compute the ijk indices of the bucket containing x, clamped to the
+  // grid of buckets.
+  void GetBucketIndices(const double x[3], int ijk[3]);
+
+  // Description:
+  // Compute the range of buckets overlapped by the box of half width dist
+  // centered at x.
+  void GetBucketRange(const double x[3], double dist,
+                      int minIjk[3], int maxIjk[3]);
+
+  void GenerateFace(int face, int i, int j, int k,
+                    vtkPoints *pts, vtkCellArray *polys);
+
+  int Divisions[3]; // Number of sub-divisions in x-y-z directions
+  int NumberOfPointsPerBucket; // Average number of points when Automatic
+  double H[3]; // width of each bucket in x-y-z directions
+  vtkIdType NumberOfBuckets; // total number of buckets
+  vtkIdType *BucketOffsets; // NumberOfBuckets+1 offsets into PointIds
+  vtkIdType *PointIds; // point ids sorted by bucket
+
+private:
+  vtkStaticPointLocator(const vtkStaticPointLocator&);  // Not implemented.
+  void operator=(const vtkStaticPointLocator&);  // Not implemented.
+};
+
+#endif
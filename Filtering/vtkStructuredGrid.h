@@ -79,6 +79,9 @@ public:
   int GetCellType(vtkIdType cellId);
   vtkIdType GetNumberOfCells();
   void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds);
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                     const vtkIdType* &pts, vtkIdList *ptIds)
+    {this->vtkDataSet::GetCellPoints(cellId, npts, pts, ptIds);}
   void GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
     {
       vtkStructuredData::GetPointCells(ptId,cellIds,this->GetDimensions());
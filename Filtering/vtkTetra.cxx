@@ -332,6 +332,12 @@ int *vtkTetra::GetEdgeArray(int edgeId)
   return edges[edgeId];
 }
 
+//----------------------------------------------------------------------------
+int *vtkTetra::GetTriangleCases(int caseId)
+{
+  return triCases[caseId].edges;
+}
+
 //----------------------------------------------------------------------------
 vtkCell *vtkTetra::GetEdge(int edgeId)
 {
@@ -159,6 +159,12 @@ public:
   static int *GetEdgeArray(int edgeId);
   static int *GetFaceArray(int faceId);
 
+  // Description:
+  // Return the marching tetrahedra case used by Contour(). Bit i of caseId
+  // is set when the scalar of vertex i is >= the contour value. The case
+  // is a list of edge ids, three per triangle, terminated by -1.
+  static int *GetTriangleCases(int caseId);
+
 protected:
   vtkTetra();
   ~vtkTetra();
@@ -16,6 +16,7 @@
 
 #include "vtkCellData.h"
 #include "vtkCommand.h"
+#include "vtkCriticalSection.h"
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -24,6 +25,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkThreadPool.h"
 #include "vtkTrivialProducer.h"
 
 vtkCxxRevisionMacro(vtkThreadedImageAlgorithm, "$Revision$");
@@ -33,6 +35,8 @@ vtkThreadedImageAlgorithm::vtkThreadedImageAlgorithm()
 {
   this->Threader = vtkMultiThreader::New();
   this->NumberOfThreads = this->Threader->GetNumberOfThreads();
+  this->UseThreadPool = this->Threader->GetUseThreadPool();
+  this->PiecesPerThread = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -47,6 +51,8 @@ void vtkThreadedImageAlgorithm::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
   
   os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "UseThreadPool: " << this->UseThreadPool << "\n";
+  os << indent << "PiecesPerThread: " << this->PiecesPerThread << "\n";
 }
 
 struct vtkImageThreadStruct
@@ -57,6 +63,16 @@ struct vtkImageThreadStruct
   vtkInformationVector *OutputsInfo;
   vtkImageData   ***Inputs;
   vtkImageData   **Outputs;
+  // pieces handed out one by one when PiecesPerThread > 1
+  int NumberOfPieces;
+  int NextPiece;
+  vtkSimpleCriticalSection *PieceLock;
+  // with the thread pool, the threads that hold each threadId and whether
+  // they are executing pieces under it; threadId 0 is the calling thread
+  int NumberOfThreadIds;
+  vtkMultiThreaderIDType ThreadIds[VTK_MAX_THREADS];
+  int ThreadIdUsed[VTK_MAX_THREADS];
+  int ThreadIdBusy[VTK_MAX_THREADS];
 };
 
 //----------------------------------------------------------------------------
@@ -123,22 +139,10 @@ int vtkThreadedImageAlgorithm::SplitExtent(int splitExt[6],
 }
 
 
-// this mess is really a simple function. All it does is call
-// the ThreadedExecute method after setting the correct
-// extent for this thread. Its just a pain to calculate
-// the correct extent.
-VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
+// Get the extent that the threads split, return 0 if there is none.
+static int vtkThreadedImageAlgorithmGetExtent(vtkImageThreadStruct *str,
+                                              int ext[6])
 {
-  vtkImageThreadStruct *str;
-  int ext[6], splitExt[6], total;
-  int threadId, threadCount;
-  
-  threadId = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->ThreadID;
-  threadCount = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->NumberOfThreads;
-  
-  str = static_cast<vtkImageThreadStruct *>
-    (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
-
   // if we have an output
   if (str->Filter->GetNumberOfOutputPorts())
     {
@@ -150,7 +154,7 @@ VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
     // update directly, for now an error
     if (outputPort == -1)
       {
-      return VTK_THREAD_RETURN_VALUE;
+      return 0;
       }
   
     // get the update extent from the output port
@@ -180,10 +184,61 @@ VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
       }
     if (inPort >= str->Filter->GetNumberOfInputPorts())
       {
-      return VTK_THREAD_RETURN_VALUE;
+      return 0;
       }
     }
+  return 1;
+}
+
+// this mess is really a simple function. All it does is call
+// the ThreadedExecute method after setting the correct
+// extent for this thread. Its just a pain to calculate
+// the correct extent.
+VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
+{
+  vtkImageThreadStruct *str;
+  int ext[6], splitExt[6], total;
+  int threadId, threadCount;
+  
+  threadId = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->ThreadID;
+  threadCount = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->NumberOfThreads;
+  
+  str = static_cast<vtkImageThreadStruct *>
+    (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
+
+  if (!vtkThreadedImageAlgorithmGetExtent(str, ext))
+    {
+    return VTK_THREAD_RETURN_VALUE;
+    }
   
+  if (str->NumberOfPieces > threadCount)
+    {
+    // take the pieces one after the other until none is left
+    total = str->Filter->SplitExtent(splitExt, ext, 0, str->NumberOfPieces);
+    for (;;)
+      {
+      str->PieceLock->Lock();
+      int piece = str->NextPiece++;
+      str->PieceLock->Unlock();
+      if (piece >= total)
+        {
+        break;
+        }
+      str->Filter->SplitExtent(splitExt, ext, piece, str->NumberOfPieces);
+      if (splitExt[1] < splitExt[0] ||
+          splitExt[3] < splitExt[2] ||
+          splitExt[5] < splitExt[4])
+        {
+        continue;
+        }
+      str->Filter->ThreadedRequestData(str->Request,
+                                       str->InputsInfo, str->OutputsInfo,
+                                       str->Inputs, str->Outputs,
+                                       splitExt, threadId);
+      }
+    return VTK_THREAD_RETURN_VALUE;
+    }
+
   // execute the actual method with appropriate extent
   // first find out how many pieces extent can be split into.
   total = str->Filter->SplitExtent(splitExt, ext, threadId, threadCount);
@@ -213,6 +268,88 @@ VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
 }
 
 
+//----------------------------------------------------------------------------
+// Give the calling thread of the vtkThreadPool a threadId in
+// [0, NumberOfThreadIds), the one it already holds if any, and mark it
+// busy. Return -1 if all of them are taken, or if the thread is already
+// executing pieces under its threadId (it steals from the pool while a
+// piece waits for nested work): the pieces are left to the others.
+static int vtkThreadedImageAlgorithmAcquireId(vtkImageThreadStruct *str)
+{
+  vtkMultiThreaderIDType self = vtkMultiThreader::GetCurrentThreadID();
+  int threadId = -1;
+  str->PieceLock->Lock();
+  int i;
+  for (i = 0; i < str->NumberOfThreadIds && threadId < 0; ++i)
+    {
+    if (str->ThreadIdUsed[i] &&
+        vtkMultiThreader::ThreadsEqual(str->ThreadIds[i], self))
+      {
+      threadId = (str->ThreadIdBusy[i] ? -2 : i);
+      }
+    }
+  for (i = 0; i < str->NumberOfThreadIds && threadId == -1; ++i)
+    {
+    if (!str->ThreadIdUsed[i])
+      {
+      str->ThreadIds[i] = self;
+      str->ThreadIdUsed[i] = 1;
+      threadId = i;
+      }
+    }
+  if (threadId >= 0)
+    {
+    str->ThreadIdBusy[threadId] = 1;
+    }
+  str->PieceLock->Unlock();
+  return (threadId >= 0 ? threadId : -1);
+}
+
+//----------------------------------------------------------------------------
+// Execute pieces of the update extent on a thread of the vtkThreadPool.
+// There is one task per threadId; each of them takes the pieces one after
+// the other until none is left, under the threadId of its thread.
+static void vtkThreadedImageAlgorithmPoolExecute(void *arg, vtkIdType,
+                                                 vtkIdType, int)
+{
+  vtkImageThreadStruct *str = static_cast<vtkImageThreadStruct *>(arg);
+  int ext[6], splitExt[6];
+  if (!vtkThreadedImageAlgorithmGetExtent(str, ext))
+    {
+    return;
+    }
+  int threadId = vtkThreadedImageAlgorithmAcquireId(str);
+  if (threadId < 0)
+    {
+    return;
+    }
+  int total = str->Filter->SplitExtent(splitExt, ext, 0, str->NumberOfPieces);
+  for (;;)
+    {
+    str->PieceLock->Lock();
+    int piece = str->NextPiece++;
+    str->PieceLock->Unlock();
+    if (piece >= total)
+      {
+      break;
+      }
+    str->Filter->SplitExtent(splitExt, ext, piece, str->NumberOfPieces);
+    if (splitExt[1] < splitExt[0] ||
+        splitExt[3] < splitExt[2] ||
+        splitExt[5] < splitExt[4])
+      {
+      continue;
+      }
+    str->Filter->ThreadedRequestData(str->Request,
+                                     str->InputsInfo, str->OutputsInfo,
+                                     str->Inputs, str->Outputs,
+                                     splitExt, threadId);
+    }
+  str->PieceLock->Lock();
+  str->ThreadIdBusy[threadId] = 0;
+  str->PieceLock->Unlock();
+}
+
 //----------------------------------------------------------------------------
 // This is the superclasses style of Execute method.  Convert it into
 // an imaging style Execute method.
@@ -283,13 +420,44 @@ int vtkThreadedImageAlgorithm::RequestData(
     this->CopyAttributeData(str.Inputs[0][0],str.Outputs[0],inputVector);
     }
     
-  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
-  this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute, &str);  
+  vtkSimpleCriticalSection pieceLock;
+  str.NextPiece = 0;
+  str.PieceLock = &pieceLock;
 
   // always shut off debugging to avoid threading problems with GetMacros
   int debug = this->Debug;
   this->Debug = 0;
-  this->Threader->SingleMethodExecute();
+  if (this->UseThreadPool)
+    {
+    // one task per threadId, no more than the pool can run at once with
+    // the calling thread, which holds threadId 0 so that the progress is
+    // reported from it
+    vtkThreadPool *pool = vtkThreadPool::GetInstance();
+    str.NumberOfThreadIds = pool->GetNumberOfThreads() + 1;
+    if (str.NumberOfThreadIds > this->NumberOfThreads)
+      {
+      str.NumberOfThreadIds = this->NumberOfThreads;
+      }
+    for (i = 0; i < str.NumberOfThreadIds; ++i)
+      {
+      str.ThreadIdUsed[i] = 0;
+      str.ThreadIdBusy[i] = 0;
+      }
+    str.ThreadIds[0] = vtkMultiThreader::GetCurrentThreadID();
+    str.ThreadIdUsed[0] = 1;
+    str.NumberOfPieces = str.NumberOfThreadIds * this->PiecesPerThread;
+    pool->ParallelFor(0, str.NumberOfThreadIds, 1,
+                      vtkThreadedImageAlgorithmPoolExecute, &str);
+    }
+  else
+    {
+    this->Threader->SetNumberOfThreads(this->NumberOfThreads);
+    this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute,
+                                    &str);
+    str.NumberOfPieces = this->Threader->GetNumberOfThreads() *
+      this->PiecesPerThread;
+    this->Threader->SingleMethodExecute();
+    }
   this->Debug = debug;
 
   // free up the arrays
@@ -58,6 +58,32 @@ public:
   vtkSetClampMacro( NumberOfThreads, int, 1, VTK_MAX_THREADS );
   vtkGetMacro( NumberOfThreads, int );
 
+  // Description:
+  // Set/Get whether the threads are taken from the process-wide
+  // vtkThreadPool instead of being created at every execution. The
+  // default is vtkMultiThreader::GetGlobalDefaultUseThreadPool(). The
+  // update extent is then split into NumberOfThreads pieces (times
+  // PiecesPerThread), or one more than the pool has threads if that is
+  // less. The threadId given to ThreadedRequestData() stays in
+  // [0, NumberOfThreads), no two threads use the same one at once, and
+  // threadId 0 is the thread that called Update(). A threadId may receive
+  // several pieces, or none: subclasses that reset their results per
+  // threadId at every piece must turn it off.
+  vtkSetMacro( UseThreadPool, int );
+  vtkGetMacro( UseThreadPool, int );
+  vtkBooleanMacro( UseThreadPool, int );
+
+  // Description:
+  // Set/Get the number of pieces the update extent is split into per
+  // thread. With the default of 1 every thread executes exactly one
+  // piece. Larger values produce smaller pieces that the threads take
+  // one after the other, which balances the load when the cost of the
+  // pieces differs. ThreadedRequestData() is then called several times
+  // with the same threadId, so only subclasses that accumulate (rather
+  // than overwrite) per-thread results should use it.
+  vtkSetClampMacro( PiecesPerThread, int, 1, 1024 );
+  vtkGetMacro( PiecesPerThread, int );
+
   // Description:
   // Putting this here until I merge graphics and imaging streaming.
   virtual int SplitExtent(int splitExt[6], int startExt[6], 
@@ -69,6 +95,8 @@ protected:
 
   vtkMultiThreader *Threader;
   int NumberOfThreads;
+  int UseThreadPool;
+  int PiecesPerThread;
   
   // Description:
   // This is called by the superclass.
@@ -261,7 +261,7 @@ void vtkTriangleStrip::Derivatives(int subId, double pcoords[3], double *values,
 //----------------------------------------------------------------------------
 // Given a triangle strip, decompose it into (triangle) polygons. The 
 // polygons are appended to the end of the list of polygons.
-void vtkTriangleStrip::DecomposeStrip(int npts, vtkIdType *pts,
+void vtkTriangleStrip::DecomposeStrip(int npts, const vtkIdType *pts,
                                       vtkCellArray *polys)
 {
   int p1, p2, p3, i;
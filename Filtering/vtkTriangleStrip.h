@@ -76,7 +76,8 @@ public:
   // Description:
   // Given a triangle strip, decompose it into a list of (triangle)
   // polygons. The polygons are appended to the end of the list of triangles.
-  static void DecomposeStrip(int npts, vtkIdType *pts, vtkCellArray *tris);
+  static void DecomposeStrip(int npts, const vtkIdType *pts,
+                             vtkCellArray *tris);
 
   // Description:
   // Compute the interpolation functions/derivatives
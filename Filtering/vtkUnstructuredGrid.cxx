@@ -437,11 +437,11 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
   int i;
   int loc;
   vtkCell *cell = NULL;
-  vtkIdType *pts, numPts;
+  const vtkIdType *pts;
+  vtkIdType numPts;
 
   loc = this->Locations->GetValue(cellId);
   vtkDebugMacro(<< "location = " <<  loc);
-  this->Connectivity->GetCell(loc,numPts,pts);
 
   int cellType = static_cast<int>(this->Types->GetValue(cellId));
   switch (cellType)
@@ -709,7 +709,9 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
     return NULL;
     }
 
-  // Copy the points over to the cell.
+  // Copy the points over to the cell. 32 bit ids are read into its list,
+  // without converting the connectivity.
+  this->Connectivity->GetCell(loc,numPts,pts,cell->PointIds);
   cell->PointIds->SetNumberOfIds(numPts);
   cell->Points->SetNumberOfPoints(numPts);
   for (i=0; i<numPts; i++)
@@ -734,13 +736,14 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
   int i;
   int    loc;
   double  x[3];
-  vtkIdType *pts, numPts;
+  const vtkIdType *pts;
+  vtkIdType numPts;
 
   int cellType = static_cast<int>(this->Types->GetValue(cellId));
   cell->SetCellType(cellType);
 
   loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  this->Connectivity->GetCell(loc,numPts,pts,cell->PointIds);
 
   cell->PointIds->SetNumberOfIds(numPts);
   cell->Points->SetNumberOfPoints(numPts);
@@ -771,40 +774,8 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 // constructing a cell.
 void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
 {
-  int i;
-  int loc;
-  double x[3];
-  vtkIdType *pts, numPts;
-
-  loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
-
-  // carefully compute the bounds
-  if (numPts)
-    {
-    this->Points->GetPoint( pts[0], x );
-    bounds[0] = x[0];
-    bounds[2] = x[1];
-    bounds[4] = x[2];
-    bounds[1] = x[0];
-    bounds[3] = x[1];
-    bounds[5] = x[2];
-    for (i=1; i < numPts; i++)
-      {
-      this->Points->GetPoint( pts[i], x );
-      bounds[0] = (x[0] < bounds[0] ? x[0] : bounds[0]);
-      bounds[1] = (x[0] > bounds[1] ? x[0] : bounds[1]);
-      bounds[2] = (x[1] < bounds[2] ? x[1] : bounds[2]);
-      bounds[3] = (x[1] > bounds[3] ? x[1] : bounds[3]);
-      bounds[4] = (x[2] < bounds[4] ? x[2] : bounds[4]);
-      bounds[5] = (x[2] > bounds[5] ? x[2] : bounds[5]);
-      }
-    }
-  else
-    {
-    vtkMath::UninitializeBounds(bounds);
-    }
-
+  vtkIdType loc = this->Locations->GetValue(cellId);
+  this->Connectivity->GetCellBounds(loc, this->Points, bounds);
 }
 
 //----------------------------------------------------------------------------
@@ -975,6 +946,18 @@ void vtkUnstructuredGrid::SetCells(int type, vtkCellArray *cells)
   this->Locations->Register(this);
   this->Locations->Delete();
 
+  // the cells given here have no faces
+  if ( this->Faces )
+    {
+    this->Faces->UnRegister(this);
+    this->Faces = NULL;
+    }
+  if ( this->FaceLocations )
+    {
+    this->FaceLocations->UnRegister(this);
+    this->FaceLocations = NULL;
+    }
+
   // build types
   for (i=0, cells->InitTraversal(); cells->GetNextCell(npts,pts); i++)
     {
@@ -1021,6 +1004,18 @@ void vtkUnstructuredGrid::SetCells(int *types, vtkCellArray *cells)
   this->Locations->Register(this);
   this->Locations->Delete();
 
+  // the cells given here have no faces
+  if ( this->Faces )
+    {
+    this->Faces->UnRegister(this);
+    this->Faces = NULL;
+    }
+  if ( this->FaceLocations )
+    {
+    this->FaceLocations->UnRegister(this);
+    this->FaceLocations = NULL;
+    }
+
   // build types
   for (i=0, cells->InitTraversal(); cells->GetNextCell(npts,pts); i++)
     {
@@ -1034,6 +1029,16 @@ void vtkUnstructuredGrid::SetCells(int *types, vtkCellArray *cells)
 void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray *cellTypes,
                                    vtkIdTypeArray *cellLocations,
                                    vtkCellArray *cells)
+{
+  this->SetCells(cellTypes, cellLocations, cells, NULL, NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray *cellTypes,
+                                   vtkIdTypeArray *cellLocations,
+                                   vtkCellArray *cells,
+                                   vtkIdTypeArray *faceLocations,
+                                   vtkIdTypeArray *faces)
 {
   // set cell array
   if ( this->Connectivity )
@@ -1068,6 +1073,26 @@ void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray *cellTypes,
     this->Locations->Register(this);
     }
 
+  // faces of the face-explicit cells, if any
+  if ( faceLocations )
+    {
+    faceLocations->Register(this);
+    }
+  if ( this->FaceLocations )
+    {
+    this->FaceLocations->UnRegister(this);
+    }
+  this->FaceLocations = faceLocations;
+
+  if ( faces )
+    {
+    faces->Register(this);
+    }
+  if ( this->Faces )
+    {
+    this->Faces->UnRegister(this);
+    }
+  this->Faces = faces;
 }
 
 //----------------------------------------------------------------------------
@@ -1091,16 +1116,30 @@ void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 {
   int i;
   int loc;
-  vtkIdType *pts, numPts;
+  const vtkIdType *pts;
+  vtkIdType numPts;
 
   loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
-  ptIds->SetNumberOfIds(numPts);
-  for (i=0; i<numPts; i++)
+  this->Connectivity->GetCell(loc,numPts,pts,ptIds);
+  if (numPts == 0 || pts != ptIds->GetPointer(0))
     {
-    ptIds->SetId(i,pts[i]);
+    ptIds->SetNumberOfIds(numPts);
+    for (i=0; i<numPts; i++)
+      {
+      ptIds->SetId(i,pts[i]);
+      }
     }
+}
 
+//----------------------------------------------------------------------------
+// Point ids of a cell without copying them when possible. ptIds is only
+// used when the connectivity stores 32 bit ids.
+void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                                        const vtkIdType* &pts,
+                                        vtkIdList *ptIds)
+{
+  this->Connectivity->GetCell(this->Locations->GetValue(cellId),
+                              npts,pts,ptIds);
 }
 
 //----------------------------------------------------------------------------
@@ -1297,6 +1336,16 @@ unsigned long vtkUnstructuredGrid::GetActualMemorySize()
     size += this->Locations->GetActualMemorySize();
     }
 
+  if ( this->Faces )
+    {
+    size += this->Faces->GetActualMemorySize();
+    }
+
+  if ( this->FaceLocations )
+    {
+    size += this->FaceLocations->GetActualMemorySize();
+    }
+
   return size;
 }
 
@@ -1349,6 +1398,25 @@ void vtkUnstructuredGrid::ShallowCopy(vtkDataObject *dataObject)
       this->Locations->Register(this);
       }
 
+    if (this->Faces)
+      {
+      this->Faces->UnRegister(this);
+      }
+    this->Faces = grid->Faces;
+    if (this->Faces)
+      {
+      this->Faces->Register(this);
+      }
+
+    if (this->FaceLocations)
+      {
+      this->FaceLocations->UnRegister(this);
+      }
+    this->FaceLocations = grid->FaceLocations;
+    if (this->FaceLocations)
+      {
+      this->FaceLocations->Register(this);
+      }
     }
 
   // Do superclass
@@ -1414,7 +1482,7 @@ void vtkUnstructuredGrid::DeepCopy(vtkDataObject *dataObject)
     if (grid->Faces)
       {
       this->Faces = vtkIdTypeArray::New();
-      this->Faces->DeepCopy(grid->Locations);
+      this->Faces->DeepCopy(grid->Faces);
       this->Faces->Register(this);
       this->Faces->Delete();
       }
@@ -1427,7 +1495,7 @@ void vtkUnstructuredGrid::DeepCopy(vtkDataObject *dataObject)
     if (grid->FaceLocations)
       {
       this->FaceLocations = vtkIdTypeArray::New();
-      this->FaceLocations->DeepCopy(grid->Locations);
+      this->FaceLocations->DeepCopy(grid->FaceLocations);
       this->FaceLocations->Register(this);
       this->FaceLocations->Delete();
       }
@@ -97,6 +97,8 @@ public:
   virtual void GetCell(vtkIdType cellId, vtkGenericCell *cell);
   virtual void GetCellBounds(vtkIdType cellId, double bounds[6]);
   virtual void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds);
+  virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                             const vtkIdType* &pts, vtkIdList *ptIds);
   void GetPointCells(vtkIdType ptId, vtkIdList *cellIds);
 
   int GetCellType(vtkIdType cellId);
@@ -118,6 +120,25 @@ public:
   void SetCells(vtkUnsignedCharArray *cellTypes, vtkIdTypeArray *cellLocations, 
                 vtkCellArray *cells);
   vtkCellArray *GetCells() {return this->Connectivity;};
+
+  // Description:
+  // Set the cells together with the faces of the face-explicit cells
+  // (e.g. polyhedron). faceLocations holds, for each cell, the location of
+  // its face list in faces, or -1 when the cell has none. Each face list
+  // is the number of faces followed by the faces in vtkCellArray format
+  // (n,i,j,k,n,i,j,k,...). Both may be NULL when there are no such cells;
+  // the other forms of SetCells() remove the faces.
+  void SetCells(vtkUnsignedCharArray *cellTypes, vtkIdTypeArray *cellLocations,
+                vtkCellArray *cells, vtkIdTypeArray *faceLocations,
+                vtkIdTypeArray *faces);
+
+  // Description:
+  // Get the faces of the face-explicit cells and their locations, see
+  // SetCells(). Both are NULL when no cell has faces. GetFaces(cellId)
+  // returns the face list of a cell, or NULL.
+  vtkIdTypeArray *GetFaces() {return this->Faces;};
+  vtkIdTypeArray *GetFaceLocations() {return this->FaceLocations;};
+  vtkIdType *GetFaces(vtkIdType cellId);
   void ReplaceCell(vtkIdType cellId, int npts, vtkIdType *pts);
   int InsertNextLinkedCell(int type, int npts, vtkIdType *pts);
   void RemoveReferenceToCell(vtkIdType ptId, vtkIdType cellId);
@@ -241,7 +262,6 @@ protected:
   // (n,i,j,k,n,i,j,k,...).
   vtkIdTypeArray *Faces;
   vtkIdTypeArray *FaceLocations;
-  vtkIdType      *GetFaces(vtkIdType cellId);
 
 private:
   // Hide these from the user and the compiler.
@@ -0,0 +1,289 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Append polygonal data with vertices, lines, polygons and strips, and
+// unstructured grids, serially and on one and several threads. The outputs
+// must be identical.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkLineSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPointSource.h"
+#include "vtkPolyData.h"
+#include "vtkSOADoubleArray.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+#include "vtkThreadPool.h"
+#include "vtkUnstructuredGrid.h"
+
+// Keep the geometry and topology only, and add a point and a cell array
+// numbered from start.
+static void AddArrays(vtkDataSet *ds, int start)
+{
+  ds->GetPointData()->Initialize();
+  ds->GetCellData()->Initialize();
+  vtkSmartPointer<vtkDoubleArray> values =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  values->SetName("Values");
+  values->SetNumberOfComponents(2);
+  vtkIdType i;
+  for (i = 0; i < ds->GetNumberOfPoints(); i++)
+    {
+    values->InsertNextTuple2(start + i, -i);
+    }
+  ds->GetPointData()->SetScalars(values);
+  vtkSmartPointer<vtkIntArray> cellValues =
+    vtkSmartPointer<vtkIntArray>::New();
+  cellValues->SetName("CellValues");
+  for (i = 0; i < ds->GetNumberOfCells(); i++)
+    {
+    cellValues->InsertNextValue(start + i);
+    }
+  ds->GetCellData()->AddArray(cellValues);
+}
+
+// Replace the point scalars by the same values in a structure-of-arrays,
+// whose values are not available through one pointer.
+static void ScalarsToSOA(vtkDataSet *ds)
+{
+  vtkDataArray *values = ds->GetPointData()->GetScalars();
+  vtkSmartPointer<vtkSOADoubleArray> soa =
+    vtkSmartPointer<vtkSOADoubleArray>::New();
+  soa->SetName(values->GetName());
+  soa->SetNumberOfComponents(values->GetNumberOfComponents());
+  soa->SetNumberOfTuples(values->GetNumberOfTuples());
+  double tuple[2];
+  for (vtkIdType i = 0; i < values->GetNumberOfTuples(); i++)
+    {
+    values->GetTuple(i, tuple);
+    soa->SetTuple(i, tuple);
+    }
+  ds->GetPointData()->SetScalars(soa);
+}
+
+static vtkSmartPointer<vtkPolyData> Copy(vtkPolyData *input, int start)
+{
+  vtkSmartPointer<vtkPolyData> pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->DeepCopy(input);
+  AddArrays(pd, start);
+  return pd;
+}
+
+static int CompareArrays(vtkFieldData *a, vtkFieldData *b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    return 0;
+    }
+  for (int i = 0; i < a->GetNumberOfArrays(); i++)
+    {
+    vtkDataArray *da = a->GetArray(i), *db = b->GetArray(i);
+    if (da->GetDataType() != db->GetDataType() ||
+        da->GetNumberOfTuples() != db->GetNumberOfTuples() ||
+        da->GetNumberOfComponents() != db->GetNumberOfComponents())
+      {
+      return 0;
+      }
+    for (vtkIdType j = 0; j < da->GetNumberOfTuples(); j++)
+      {
+      for (int k = 0; k < da->GetNumberOfComponents(); k++)
+        {
+        if (da->GetComponent(j, k) != db->GetComponent(j, k))
+          {
+          return 0;
+          }
+        }
+      }
+    }
+  return 1;
+}
+
+static int Compare(vtkDataSet *reference, vtkDataSet *appended)
+{
+  vtkIdType i, j, numPts = reference->GetNumberOfPoints();
+  if (appended->GetNumberOfPoints() != numPts ||
+      appended->GetNumberOfCells() != reference->GetNumberOfCells())
+    {
+    cerr << "Appended " << appended->GetNumberOfPoints() << " points and "
+         << appended->GetNumberOfCells() << " cells instead of " << numPts
+         << " points and " << reference->GetNumberOfCells() << " cells\n";
+    return 0;
+    }
+  double x[3], y[3];
+  for (i = 0; i < numPts; i++)
+    {
+    reference->GetPoint(i, x);
+    appended->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      cerr << "Point " << i << " differs\n";
+      return 0;
+      }
+    }
+  vtkSmartPointer<vtkIdList> a = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> b = vtkSmartPointer<vtkIdList>::New();
+  for (i = 0; i < reference->GetNumberOfCells(); i++)
+    {
+    reference->GetCellPoints(i, a);
+    appended->GetCellPoints(i, b);
+    int same = reference->GetCellType(i) == appended->GetCellType(i) &&
+      a->GetNumberOfIds() == b->GetNumberOfIds();
+    for (j = 0; same && j < a->GetNumberOfIds(); j++)
+      {
+      same = a->GetId(j) == b->GetId(j);
+      }
+    if (!same)
+      {
+      cerr << "Cell " << i << " differs\n";
+      return 0;
+      }
+    }
+  if (!CompareArrays(reference->GetPointData(), appended->GetPointData()) ||
+      !CompareArrays(reference->GetCellData(), appended->GetCellData()))
+    {
+    cerr << "Data arrays differ\n";
+    return 0;
+    }
+  return 1;
+}
+
+int TestAppendThreaded(int, char *[])
+{
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  sphere->SetThetaResolution(24);
+  sphere->SetPhiResolution(12);
+  vtkSmartPointer<vtkStripper> stripper = vtkSmartPointer<vtkStripper>::New();
+  stripper->SetInputConnection(sphere->GetOutputPort());
+  vtkSmartPointer<vtkLineSource> line = vtkSmartPointer<vtkLineSource>::New();
+  line->SetResolution(30);
+  vtkSmartPointer<vtkPointSource> cloud =
+    vtkSmartPointer<vtkPointSource>::New();
+  cloud->SetNumberOfPoints(200);
+  stripper->Update();
+  line->Update();
+  cloud->Update();
+
+  // Inputs of every cell kind, one of them with double points and one
+  // empty.
+  const int numInputs = 6;
+  vtkSmartPointer<vtkPolyData> inputs[numInputs];
+  inputs[0] = Copy(sphere->GetOutput(), 0);
+  inputs[1] = Copy(line->GetOutput(), 1000);
+  inputs[2] = vtkSmartPointer<vtkPolyData>::New();
+  inputs[3] = Copy(stripper->GetOutput(), 2000);
+  inputs[4] = Copy(cloud->GetOutput(), 3000);
+  inputs[5] = Copy(sphere->GetOutput(), 4000);
+  vtkSmartPointer<vtkPoints> doublePts = vtkSmartPointer<vtkPoints>::New();
+  doublePts->SetDataTypeToDouble();
+  doublePts->DeepCopy(inputs[5]->GetPoints());
+  inputs[5]->SetPoints(doublePts);
+
+  // The same inputs as unstructured grids.
+  vtkSmartPointer<vtkUnstructuredGrid> grids[numInputs];
+  int i;
+  for (i = 0; i < numInputs; i++)
+    {
+    vtkSmartPointer<vtkAppendFilter> convert =
+      vtkSmartPointer<vtkAppendFilter>::New();
+    convert->AddInput(inputs[i]);
+    convert->Update();
+    grids[i] = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    grids[i]->ShallowCopy(convert->GetOutput());
+    }
+
+  // Cells in offsets storage are read without their list form.
+  inputs[5]->GetPolys()->SetStorageModeToOffsets();
+  grids[5]->GetCells()->SetStorageModeToOffsets();
+
+  // Arrays without the standard memory layout are copied tuple by tuple.
+  ScalarsToSOA(inputs[4]);
+  ScalarsToSOA(grids[4]);
+
+  vtkSmartPointer<vtkPolyData> referencePD;
+  vtkSmartPointer<vtkUnstructuredGrid> referenceUG;
+  // No thread count means the serial reference.
+  int threadCounts[3] = { 0, 1, 4 };
+  for (int t = 0; t < 3; t++)
+    {
+    int numThreads = threadCounts[t];
+    vtkThreadPool::GetInstance()->SetNumberOfThreads(
+      numThreads ? numThreads : 1);
+    vtkSmartPointer<vtkAppendPolyData> appendPD =
+      vtkSmartPointer<vtkAppendPolyData>::New();
+    vtkSmartPointer<vtkAppendFilter> appendUG =
+      vtkSmartPointer<vtkAppendFilter>::New();
+    appendPD->SetUseThreadPool(numThreads > 0);
+    appendUG->SetUseThreadPool(numThreads > 0);
+    for (i = 0; i < numInputs; i++)
+      {
+      appendPD->AddInput(inputs[i]);
+      appendUG->AddInput(grids[i]);
+      }
+    appendPD->Update();
+    appendUG->Update();
+    if (numThreads == 0)
+      {
+      referencePD = appendPD->GetOutput();
+      referenceUG = appendUG->GetOutput();
+      if (referencePD->GetNumberOfCells() == 0 ||
+          referencePD->GetNumberOfStrips() == 0 ||
+          referencePD->GetPointData()->GetScalars() == NULL ||
+          referenceUG->GetCellData()->GetArray("CellValues") == NULL)
+        {
+        cerr << "Unexpected serial output\n";
+        return 1;
+        }
+      }
+    else if (!Compare(referencePD, appendPD->GetOutput()) ||
+             !Compare(referenceUG, appendUG->GetOutput()))
+      {
+      return 1;
+      }
+    }
+
+  // With the thread pool a single unstructured grid is passed through.
+  // Without it, the grid is copied as before. Both keep the field data.
+  vtkSmartPointer<vtkIntArray> field =
+    vtkSmartPointer<vtkIntArray>::New();
+  field->SetName("field");
+  field->InsertNextValue(1);
+  grids[0]->GetFieldData()->AddArray(field);
+  for (int useThreadPool = 0; useThreadPool < 2; useThreadPool++)
+    {
+    vtkSmartPointer<vtkAppendFilter> single =
+      vtkSmartPointer<vtkAppendFilter>::New();
+    single->SetUseThreadPool(useThreadPool);
+    single->AddInput(grids[0]);
+    single->Update();
+    vtkUnstructuredGrid *output = single->GetOutput();
+    if (!Compare(grids[0], output) ||
+        (output->GetPoints() == grids[0]->GetPoints()) != useThreadPool ||
+        output->GetFieldData()->GetNumberOfArrays() != 1)
+      {
+      cerr << "The single input is " << (useThreadPool ? "not " : "")
+           << "passed through with UseThreadPool " << useThreadPool << "\n";
+      return 1;
+      }
+    }
+  return 0;
+}
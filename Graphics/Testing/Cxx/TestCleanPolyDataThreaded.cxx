@@ -0,0 +1,201 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Clean a soup of triangles, lines and vertices that do not share their
+// points, with vtkMergePoints and by sorting the points on one and several
+// threads. The outputs must be identical.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadPool.h"
+
+static vtkSmartPointer<vtkPolyData> MakeSoup(int dataType)
+{
+  const int res = 80;
+  vtkSmartPointer<vtkPoints> pts = vtkSmartPointer<vtkPoints>::New();
+  pts->SetDataType(dataType);
+  vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
+  vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
+  vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+  vtkSmartPointer<vtkIdTypeArray> ids = vtkSmartPointer<vtkIdTypeArray>::New();
+  ids->SetName("Ids");
+  vtkSmartPointer<vtkDoubleArray> cellIds =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  cellIds->SetName("CellIds");
+
+  // Every triangle of a grid has its own points, plus a few degenerate
+  // triangles and an unused point.
+  vtkIdType tri[3];
+  int i, j, k;
+  for (i = 0; i < res; i++)
+    {
+    for (j = 0; j < res; j++)
+      {
+      double corners[4][3];
+      for (k = 0; k < 4; k++)
+        {
+        int a = i + (k == 1 || k == 2), b = j + (k >= 2);
+        corners[k][0] = 0.1 * a;
+        corners[k][1] = 0.1 * b;
+        corners[k][2] = 0.01 * ((a * b) % 7);
+        }
+      for (k = 0; k < 2; k++)
+        {
+        tri[0] = pts->InsertNextPoint(corners[0]);
+        tri[1] = pts->InsertNextPoint(corners[k + 1]);
+        tri[2] = pts->InsertNextPoint(corners[(i + j) % 5 ? k + 2 : 0]);
+        polys->InsertNextCell(3, tri);
+        }
+      }
+    }
+  pts->InsertNextPoint(-1.0, -1.0, -1.0);
+  for (i = 0; i < 50; i++)
+    {
+    tri[0] = pts->InsertNextPoint(0.1 * i, 0.0, 0.0);
+    tri[1] = pts->InsertNextPoint(0.1 * i, (i % 3) ? 0.1 : 0.0, 0.0);
+    lines->InsertNextCell(2, tri);
+    tri[0] = pts->InsertNextPoint(0.1 * i, 0.1 * i, 0.0);
+    verts->InsertNextCell(1, tri);
+    }
+  for (i = 0; i < pts->GetNumberOfPoints(); i++)
+    {
+    ids->InsertNextValue(i);
+    }
+
+  vtkSmartPointer<vtkPolyData> soup = vtkSmartPointer<vtkPolyData>::New();
+  soup->SetPoints(pts);
+  soup->SetVerts(verts);
+  soup->SetLines(lines);
+  soup->SetPolys(polys);
+  soup->GetPointData()->AddArray(ids);
+  for (i = 0; i < soup->GetNumberOfCells(); i++)
+    {
+    cellIds->InsertNextValue(i);
+    }
+  soup->GetCellData()->AddArray(cellIds);
+  return soup;
+}
+
+static vtkSmartPointer<vtkPolyData> Clean(vtkPolyData *input,
+                                          int useThreadPool)
+{
+  vtkSmartPointer<vtkCleanPolyData> clean =
+    vtkSmartPointer<vtkCleanPolyData>::New();
+  clean->SetInput(input);
+  clean->SetUseThreadPool(useThreadPool);
+  clean->Update();
+  // A second update with the locator created by the first one.
+  clean->Modified();
+  clean->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(clean->GetOutput());
+  return output;
+}
+
+static int CompareCells(vtkCellArray *a, vtkCellArray *b)
+{
+  if (a->GetNumberOfConnectivityEntries() !=
+      b->GetNumberOfConnectivityEntries())
+    {
+    return 0;
+    }
+  vtkIdType *pa = a->GetPointer(), *pb = b->GetPointer();
+  for (vtkIdType i = 0; i < a->GetNumberOfConnectivityEntries(); i++)
+    {
+    if (pa[i] != pb[i])
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+static int Compare(vtkPolyData *reference, vtkPolyData *cleaned)
+{
+  vtkIdType i, numPts = reference->GetNumberOfPoints();
+  if (cleaned->GetNumberOfPoints() != numPts ||
+      cleaned->GetNumberOfCells() != reference->GetNumberOfCells() ||
+      cleaned->GetPoints()->GetDataType() !=
+      reference->GetPoints()->GetDataType())
+    {
+    cerr << "Cleaned " << cleaned->GetNumberOfPoints() << " points and "
+         << cleaned->GetNumberOfCells() << " cells instead of " << numPts
+         << " points and " << reference->GetNumberOfCells() << " cells\n";
+    return 0;
+    }
+  double x[3], y[3];
+  vtkDataArray *refIds = reference->GetPointData()->GetArray("Ids");
+  vtkDataArray *ids = cleaned->GetPointData()->GetArray("Ids");
+  for (i = 0; i < numPts; i++)
+    {
+    reference->GetPoint(i, x);
+    cleaned->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+        ids->GetComponent(i, 0) != refIds->GetComponent(i, 0))
+      {
+      cerr << "Point " << i << " differs\n";
+      return 0;
+      }
+    }
+  vtkDataArray *refCellIds = reference->GetCellData()->GetArray("CellIds");
+  vtkDataArray *cellIds = cleaned->GetCellData()->GetArray("CellIds");
+  for (i = 0; i < reference->GetNumberOfCells(); i++)
+    {
+    if (cellIds->GetComponent(i, 0) != refCellIds->GetComponent(i, 0))
+      {
+      cerr << "Cell data " << i << " differs\n";
+      return 0;
+      }
+    }
+  if (!CompareCells(reference->GetVerts(), cleaned->GetVerts()) ||
+      !CompareCells(reference->GetLines(), cleaned->GetLines()) ||
+      !CompareCells(reference->GetPolys(), cleaned->GetPolys()))
+    {
+    cerr << "Cells differ\n";
+    return 0;
+    }
+  return 1;
+}
+
+int TestCleanPolyDataThreaded(int, char *[])
+{
+  int dataTypes[2] = { VTK_FLOAT, VTK_DOUBLE };
+  for (int t = 0; t < 2; t++)
+    {
+    vtkSmartPointer<vtkPolyData> soup = MakeSoup(dataTypes[t]);
+    vtkSmartPointer<vtkPolyData> reference = Clean(soup, 0);
+    if (reference->GetNumberOfPoints() >= soup->GetNumberOfPoints() / 4)
+      {
+      cerr << "Too few points merged\n";
+      return 1;
+      }
+    for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+      {
+      vtkThreadPool::GetInstance()->SetNumberOfThreads(numThreads);
+      if (!Compare(reference, Clean(soup, 1)))
+        {
+        return 1;
+        }
+      }
+    }
+  return 0;
+}
@@ -0,0 +1,258 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Contour a tetrahedral grid with and without the thread pool. The
+// threaded path merges points by edge instead of with a locator, but
+// numbers points and cells like the serial path, so the outputs must be
+// identical. One contour value goes exactly through grid points.
+// Two documented differences are checked on small grids: a point on a
+// vertex is the vertex itself, and coincident points of distinct grid
+// points are not merged.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkContourGrid.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadPool.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <math.h>
+
+static vtkSmartPointer<vtkPolyData> Contour(vtkUnstructuredGrid *grid,
+                                            int useThreadPool)
+{
+  vtkSmartPointer<vtkContourGrid> contour =
+    vtkSmartPointer<vtkContourGrid>::New();
+  contour->SetInput(grid);
+  contour->SetValue(0, 10.0);
+  contour->SetValue(1, 6.5);
+  contour->SetUseThreadPool(useThreadPool);
+  contour->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(contour->GetOutput());
+  return output;
+}
+
+static int SameArray(vtkDataArray *a, vtkDataArray *b)
+{
+  if (!a || !b ||
+      a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    return 0;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+      {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+        {
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+static int Compare(vtkPolyData *serial, vtkPolyData *threaded)
+{
+  if (serial->GetNumberOfPoints() != threaded->GetNumberOfPoints() ||
+      serial->GetNumberOfCells() != threaded->GetNumberOfCells())
+    {
+    cerr << "Threaded contour has " << threaded->GetNumberOfPoints()
+         << " points and " << threaded->GetNumberOfCells()
+         << " cells instead of " << serial->GetNumberOfPoints() << " and "
+         << serial->GetNumberOfCells() << endl;
+    return 0;
+    }
+  if (!SameArray(serial->GetPoints()->GetData(),
+                 threaded->GetPoints()->GetData()) ||
+      !SameArray(serial->GetPolys()->GetData(),
+                 threaded->GetPolys()->GetData()))
+    {
+    cerr << "Threaded contour geometry differs" << endl;
+    return 0;
+    }
+  if (!SameArray(serial->GetPointData()->GetArray("Distance"),
+                 threaded->GetPointData()->GetArray("Distance")) ||
+      !SameArray(serial->GetPointData()->GetArray("Coordinates"),
+                 threaded->GetPointData()->GetArray("Coordinates")) ||
+      !SameArray(serial->GetCellData()->GetArray("CellIds"),
+                 threaded->GetCellData()->GetArray("CellIds")))
+    {
+    cerr << "Threaded contour attributes differ" << endl;
+    return 0;
+    }
+  return 1;
+}
+
+// A grid of tetrahedra with one scalar per point.
+static vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int numPts,
+                                                     const double *x,
+                                                     const float *s,
+                                                     int numTetras,
+                                                     const vtkIdType *conn)
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  vtkSmartPointer<vtkFloatArray> scalars =
+    vtkSmartPointer<vtkFloatArray>::New();
+  for (int i = 0; i < numPts; ++i)
+    {
+    points->InsertNextPoint(x + 3*i);
+    scalars->InsertNextValue(s[i]);
+    }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  grid->Allocate(numTetras);
+  for (int i = 0; i < numTetras; ++i)
+    {
+    grid->InsertNextCell(VTK_TETRA, 4, const_cast<vtkIdType *>(conn + 4*i));
+    }
+  return grid;
+}
+
+static vtkSmartPointer<vtkPolyData> ContourValue(vtkUnstructuredGrid *grid,
+                                                 int useThreadPool)
+{
+  vtkSmartPointer<vtkContourGrid> contour =
+    vtkSmartPointer<vtkContourGrid>::New();
+  contour->SetInput(grid);
+  contour->SetValue(0, 0.5);
+  contour->SetUseThreadPool(useThreadPool);
+  contour->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(contour->GetOutput());
+  return output;
+}
+
+// Point 0 is on the contour: its two edges to the points below give one
+// point, which is point 0 itself, and one of the two triangles is
+// degenerate.
+static int TestVertexPoint()
+{
+  double x[12] = { 0.1, 0.7, 0.3,  1.3, 0.1, 0.7,
+                   0.3, 1.9, 0.1,  0.7, 0.3, 1.7 };
+  float s[4] = { 0.5f, 1.0f, 0.0f, 0.0f };
+  vtkIdType conn[4] = { 0, 1, 2, 3 };
+  vtkSmartPointer<vtkPolyData> threaded =
+    ContourValue(MakeGrid(4, x, s, 1, conn), 1);
+  vtkIdType onVertex = 0;
+  double p[3];
+  for (vtkIdType i = 0; i < threaded->GetNumberOfPoints(); ++i)
+    {
+    threaded->GetPoint(i, p);
+    // the output points are floats
+    onVertex += (p[0] == static_cast<float>(x[0]) &&
+                 p[1] == static_cast<float>(x[1]) &&
+                 p[2] == static_cast<float>(x[2]));
+    }
+  if (threaded->GetNumberOfPoints() != 3 ||
+      threaded->GetNumberOfCells() != 1 || onVertex != 1)
+    {
+    cerr << "Contour through a vertex has " << threaded->GetNumberOfPoints()
+         << " points, " << threaded->GetNumberOfCells() << " cells and "
+         << onVertex << " points on the vertex instead of 3, 1 and 1\n";
+    return 0;
+    }
+  return 1;
+}
+
+// Points 4, 5 and 6 of the second tetrahedron are copies of points 1, 2
+// and 3 of the first one. The serial locator merges the points of the two
+// edges crossing their common face, the threaded path keeps both.
+static int TestCoincidentPoints()
+{
+  double x[24] = { 0, 0, 0,  1, 0, 0,  0, 1, 0,  0, 0, 1,
+                   1, 0, 0,  0, 1, 0,  0, 0, 1,  1, 1, 1 };
+  float s[8] = { 0, 1, 0, 0, 1, 0, 0, 1 };
+  vtkIdType conn[8] = { 0, 1, 2, 3,  4, 5, 6, 7 };
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(8, x, s, 2, conn);
+  vtkSmartPointer<vtkPolyData> serial = ContourValue(grid, 0);
+  vtkSmartPointer<vtkPolyData> threaded = ContourValue(grid, 1);
+  if (serial->GetNumberOfPoints() != 5 ||
+      threaded->GetNumberOfPoints() != 7 ||
+      serial->GetNumberOfCells() != 3 || threaded->GetNumberOfCells() != 3)
+    {
+    cerr << "Coincident points: " << serial->GetNumberOfPoints()
+         << " serial and " << threaded->GetNumberOfPoints()
+         << " threaded points instead of 5 and 7\n";
+    return 0;
+    }
+  return 1;
+}
+
+int TestContourGridTetras(int, char *[])
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(-12, 12, -12, 12, -12, 12);
+  vtkSmartPointer<vtkFloatArray> distance =
+    vtkSmartPointer<vtkFloatArray>::New();
+  distance->SetName("Distance");
+  vtkSmartPointer<vtkFloatArray> coordinates =
+    vtkSmartPointer<vtkFloatArray>::New();
+  coordinates->SetName("Coordinates");
+  coordinates->SetNumberOfComponents(3);
+  for (int k = -12; k <= 12; ++k)
+    {
+    for (int j = -12; j <= 12; ++j)
+      {
+      for (int i = -12; i <= 12; ++i)
+        {
+        distance->InsertNextValue(
+          static_cast<float>(sqrt(static_cast<double>(i*i+j*j+k*k))));
+        coordinates->InsertNextTuple3(i, j, k);
+        }
+      }
+    }
+  image->GetPointData()->SetScalars(distance);
+  image->GetPointData()->AddArray(coordinates);
+
+  vtkSmartPointer<vtkDataSetTriangleFilter> tetras =
+    vtkSmartPointer<vtkDataSetTriangleFilter>::New();
+  tetras->SetInput(image);
+  tetras->Update();
+  vtkUnstructuredGrid *grid = tetras->GetOutput();
+  vtkSmartPointer<vtkIdTypeArray> cellIds =
+    vtkSmartPointer<vtkIdTypeArray>::New();
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+    {
+    cellIds->InsertNextValue(i);
+    }
+  grid->GetCellData()->AddArray(cellIds);
+
+  vtkSmartPointer<vtkPolyData> serial = Contour(grid, 0);
+  if (serial->GetNumberOfCells() == 0)
+    {
+    cerr << "Empty contour" << endl;
+    return 1;
+    }
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(1);
+  vtkSmartPointer<vtkPolyData> threaded1 = Contour(grid, 1);
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+  vtkSmartPointer<vtkPolyData> threaded4 = Contour(grid, 1);
+
+  return (Compare(serial, threaded1) && Compare(serial, threaded4) &&
+          TestVertexPoint() && TestCoincidentPoints()) ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Glyph points with a table of two glyphs, copying the glyphs and as
+// instances. Each instance transform applied to its glyph must give the
+// copied glyph points.
+
+#include "vtkConeSource.h"
+#include "vtkCubeSource.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkMath.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#include <math.h>
+
+static vtkSmartPointer<vtkPolyData> Glyph(vtkPolyData *input,
+                                          vtkPolyData *cone,
+                                          vtkPolyData *cube,
+                                          int generateInstances)
+{
+  vtkSmartPointer<vtkGlyph3D> glyph = vtkSmartPointer<vtkGlyph3D>::New();
+  glyph->SetInput(input);
+  glyph->SetSource(0, cone);
+  glyph->SetSource(1, cube);
+  glyph->SetIndexModeToScalar();
+  glyph->SetScaleModeToScaleByVector();
+  glyph->SetColorModeToColorByScalar();
+  glyph->SetScaleFactor(0.3);
+  glyph->SetRange(0.0, 1.0);
+  glyph->GeneratePointIdsOn();
+  glyph->SetGenerateInstances(generateInstances);
+  glyph->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(glyph->GetOutput());
+  return output;
+}
+
+int TestGlyph3DInstances(int, char *[])
+{
+  const vtkIdType numPts = 500;
+  vtkMath::RandomSeed(1749);
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  vtkSmartPointer<vtkDoubleArray> scalars =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  vtkSmartPointer<vtkDoubleArray> vectors =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  vectors->SetNumberOfComponents(3);
+  vtkIdType i, j;
+  for (i = 0; i < numPts; i++)
+    {
+    points->InsertNextPoint(vtkMath::Random(-5.0, 5.0),
+                            vtkMath::Random(-5.0, 5.0),
+                            vtkMath::Random(-5.0, 5.0));
+    scalars->InsertNextValue(vtkMath::Random(0.0, 1.0));
+    vectors->InsertNextTuple3(vtkMath::Random(-1.0, 1.0),
+                              vtkMath::Random(-1.0, 1.0),
+                              vtkMath::Random(-1.0, 1.0));
+    }
+  vtkSmartPointer<vtkPolyData> input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+
+  vtkSmartPointer<vtkConeSource> cone = vtkSmartPointer<vtkConeSource>::New();
+  cone->SetResolution(7);
+  cone->Update();
+  vtkSmartPointer<vtkCubeSource> cube = vtkSmartPointer<vtkCubeSource>::New();
+  cube->Update();
+  vtkPolyData *sources[2] = { cone->GetOutput(), cube->GetOutput() };
+
+  vtkSmartPointer<vtkPolyData> glyphs =
+    Glyph(input, sources[0], sources[1], 0);
+  vtkSmartPointer<vtkPolyData> instances =
+    Glyph(input, sources[0], sources[1], 1);
+
+  vtkPointData *pd = instances->GetPointData();
+  vtkDataArray *transforms = pd->GetArray("GlyphTransform");
+  vtkDataArray *indices = pd->GetArray("GlyphIndex");
+  if (instances->GetNumberOfPoints() != numPts ||
+      instances->GetNumberOfCells() != 0 || !transforms || !indices ||
+      transforms->GetNumberOfComponents() != 9 ||
+      !pd->GetScalars() || pd->GetScalars()->GetNumberOfTuples() != numPts ||
+      !pd->GetArray("GlyphVector") || !pd->GetArray("InputPointIds"))
+    {
+    cerr << "Unexpected instances\n";
+    return 1;
+    }
+
+  // The glyphs are copied in the order of the input points.
+  double m[9], x[3], p[3], y[3];
+  int numCones = 0;
+  vtkIdType glyphPtId = 0;
+  for (i = 0; i < numPts; i++)
+    {
+    instances->GetPoint(i, x);
+    input->GetPoint(i, p);
+    if (x[0] != p[0] || x[1] != p[1] || x[2] != p[2] ||
+        pd->GetArray("InputPointIds")->GetComponent(i, 0) != i)
+      {
+      cerr << "Instance " << i << " is not at its input point\n";
+      return 1;
+      }
+    int index = static_cast<int>(indices->GetComponent(i, 0));
+    numCones += (index == 0);
+    transforms->GetTuple(i, m);
+    vtkPolyData *source = sources[index];
+    for (j = 0; j < source->GetNumberOfPoints(); j++, glyphPtId++)
+      {
+      source->GetPoint(j, p);
+      glyphs->GetPoint(glyphPtId, y);
+      for (int k = 0; k < 3; k++)
+        {
+        double t = x[k] + m[3*k]*p[0] + m[3*k+1]*p[1] + m[3*k+2]*p[2];
+        if (fabs(t - y[k]) > 1.0e-5)
+          {
+          cerr << "Instance " << i << " differs from its glyph\n";
+          return 1;
+          }
+        }
+      }
+    }
+  if (glyphPtId != glyphs->GetNumberOfPoints() ||
+      numCones == 0 || numCones == numPts)
+    {
+    cerr << "The glyphs do not match the instances\n";
+    return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Generate the normals of a mesh with sharp edges, triangle strips and
+// unused points, serially and on one and several threads, with and without
+// splitting, consistency and flipping, from cells in list and in 32 bit
+// offsets storage. The outputs must be identical.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkCubeSource.h"
+#include "vtkDoubleArray.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+#include "vtkThreadPool.h"
+
+static int CompareArrays(vtkDataArray *a, vtkDataArray *b)
+{
+  if (!a || !b)
+    {
+    return a == b;
+    }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    return 0;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    for (int k = 0; k < a->GetNumberOfComponents(); k++)
+      {
+      if (a->GetComponent(i, k) != b->GetComponent(i, k))
+        {
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+static int Compare(vtkPolyData *reference, vtkPolyData *output)
+{
+  if (!CompareArrays(reference->GetPoints()->GetData(),
+                     output->GetPoints()->GetData()))
+    {
+    cerr << "Points differ\n";
+    return 0;
+    }
+  vtkCellArray *a = reference->GetPolys(), *b = output->GetPolys();
+  if (a->GetNumberOfConnectivityEntries() !=
+      b->GetNumberOfConnectivityEntries())
+    {
+    cerr << "Polygons differ\n";
+    return 0;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfConnectivityEntries(); i++)
+    {
+    if (a->GetPointer()[i] != b->GetPointer()[i])
+      {
+      cerr << "Polygons differ\n";
+      return 0;
+      }
+    }
+  if (!CompareArrays(reference->GetPointData()->GetNormals(),
+                     output->GetPointData()->GetNormals()) ||
+      !CompareArrays(reference->GetCellData()->GetNormals(),
+                     output->GetCellData()->GetNormals()) ||
+      !CompareArrays(reference->GetPointData()->GetArray("Ids"),
+                     output->GetPointData()->GetArray("Ids")))
+    {
+    cerr << "Normals or point data differ\n";
+    return 0;
+    }
+  return 1;
+}
+
+int TestPolyDataNormalsThreaded(int, char *[])
+{
+  // A cube with shared points has sharp edges to split, a coarse sphere
+  // has smooth and sharp ones, and its strips give more triangles.
+  vtkSmartPointer<vtkCubeSource> cube = vtkSmartPointer<vtkCubeSource>::New();
+  vtkSmartPointer<vtkCleanPolyData> cleanCube =
+    vtkSmartPointer<vtkCleanPolyData>::New();
+  cleanCube->SetInputConnection(cube->GetOutputPort());
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  sphere->SetThetaResolution(9);
+  sphere->SetPhiResolution(7);
+  sphere->SetCenter(2.0, 0.0, 0.0);
+  vtkSmartPointer<vtkSphereSource> fineSphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  fineSphere->SetThetaResolution(60);
+  fineSphere->SetPhiResolution(30);
+  fineSphere->SetCenter(0.0, 3.0, 0.0);
+  vtkSmartPointer<vtkStripper> stripper = vtkSmartPointer<vtkStripper>::New();
+  stripper->SetInputConnection(fineSphere->GetOutputPort());
+  vtkSmartPointer<vtkAppendPolyData> append =
+    vtkSmartPointer<vtkAppendPolyData>::New();
+  append->AddInputConnection(cleanCube->GetOutputPort());
+  append->AddInputConnection(sphere->GetOutputPort());
+  append->AddInputConnection(stripper->GetOutputPort());
+  append->Update();
+
+  vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
+  mesh->DeepCopy(append->GetOutput());
+  mesh->GetPointData()->Initialize();
+  mesh->GetPoints()->InsertNextPoint(5.0, 5.0, 5.0); // unused
+  vtkSmartPointer<vtkDoubleArray> ids = vtkSmartPointer<vtkDoubleArray>::New();
+  ids->SetName("Ids");
+  for (vtkIdType i = 0; i < mesh->GetNumberOfPoints(); i++)
+    {
+    ids->InsertNextValue(i);
+    }
+  mesh->GetPointData()->AddArray(ids);
+
+  // The same mesh with the cells in 32 bit offsets storage, which the
+  // filter must read without converting it.
+  vtkSmartPointer<vtkPolyData> mesh32 = vtkSmartPointer<vtkPolyData>::New();
+  mesh32->DeepCopy(mesh);
+  mesh32->GetPolys()->SetStorageModeToOffsets();
+  mesh32->GetStrips()->SetStorageModeToOffsets();
+  vtkPolyData *inputs[2] = { mesh, mesh32 };
+
+  for (int options = 0; options < 8; options++)
+    {
+    vtkSmartPointer<vtkPolyData> reference;
+    int threadCounts[3] = { 0, 1, 4 };
+    for (int in = 0; in < 2; in++)
+      {
+      for (int t = 0; t < 3; t++)
+        {
+        vtkThreadPool::GetInstance()->SetNumberOfThreads(
+          threadCounts[t] ? threadCounts[t] : 1);
+        vtkSmartPointer<vtkPolyDataNormals> normals =
+          vtkSmartPointer<vtkPolyDataNormals>::New();
+        normals->SetInput(inputs[in]);
+        normals->SetSplitting(options & 1);
+        normals->SetConsistency((options & 2) != 0);
+        normals->SetFlipNormals((options & 4) != 0);
+        normals->ComputeCellNormalsOn();
+        normals->SetUseThreadPool(threadCounts[t] > 0);
+        normals->Update();
+        vtkPolyData *output = normals->GetOutput();
+        if (in == 0 && t == 0)
+          {
+          reference = vtkSmartPointer<vtkPolyData>::New();
+          reference->ShallowCopy(output);
+          if ((options & 1) &&
+              output->GetNumberOfPoints() <= mesh->GetNumberOfPoints())
+            {
+            cerr << "No sharp edge was split\n";
+            return 1;
+            }
+          }
+        else if (!Compare(reference, output))
+          {
+          cerr << "with options " << options << " on " << threadCounts[t]
+               << " threads" << (in ? " from 32 bit cells\n" : "\n");
+          return 1;
+          }
+        }
+      }
+    }
+  if (!mesh32->GetPolys()->IsStorage32Bit() ||
+      !mesh32->GetStrips()->IsStorage32Bit())
+    {
+    cerr << "The 32 bit cells of the input were converted\n";
+    return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Probe a tetrahedral grid with an image, first with vtkDataSet::FindCell(),
+// then with a cell locator on one and several threads. The same points
+// must be found and the interpolated values must agree.
+
+#include "vtkCellData.h"
+#include "vtkCellLocator.h"
+#include "vtkCharArray.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkPointData.h"
+#include "vtkProbeFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadPool.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <math.h>
+
+static vtkSmartPointer<vtkImageData> Probe(vtkImageData *input,
+                                           vtkUnstructuredGrid *source,
+                                           int useLocator)
+{
+  vtkSmartPointer<vtkProbeFilter> probe =
+    vtkSmartPointer<vtkProbeFilter>::New();
+  probe->SetInput(input);
+  probe->SetSource(source);
+  if (useLocator)
+    {
+    vtkSmartPointer<vtkCellLocator> locator =
+      vtkSmartPointer<vtkCellLocator>::New();
+    probe->SetCellLocator(locator);
+    }
+  probe->Update();
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->ShallowCopy(probe->GetOutput());
+  return output;
+}
+
+static int Compare(vtkImageData *reference, vtkImageData *probed)
+{
+  vtkCharArray *refMask = vtkCharArray::SafeDownCast(
+    reference->GetPointData()->GetArray("vtkValidPointMask"));
+  vtkCharArray *mask = vtkCharArray::SafeDownCast(
+    probed->GetPointData()->GetArray("vtkValidPointMask"));
+  vtkDataArray *refDistance = reference->GetPointData()->GetArray("Distance");
+  vtkDataArray *distance = probed->GetPointData()->GetArray("Distance");
+  if (!mask || !distance || !probed->GetPointData()->GetArray("CellIds") ||
+      distance->GetNumberOfTuples() != refDistance->GetNumberOfTuples())
+    {
+    cerr << "Missing probed arrays" << endl;
+    return 0;
+    }
+  for (vtkIdType i = 0; i < refDistance->GetNumberOfTuples(); ++i)
+    {
+    if (mask->GetValue(i) != refMask->GetValue(i) ||
+        fabs(distance->GetComponent(i, 0) -
+             refDistance->GetComponent(i, 0)) > 1.0e-4)
+      {
+      cerr << "Probed point " << i << " differs" << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+int TestProbeFilterLocator(int, char *[])
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(-12, 12, -12, 12, -12, 12);
+  vtkSmartPointer<vtkFloatArray> distance =
+    vtkSmartPointer<vtkFloatArray>::New();
+  distance->SetName("Distance");
+  for (int k = -12; k <= 12; ++k)
+    {
+    for (int j = -12; j <= 12; ++j)
+      {
+      for (int i = -12; i <= 12; ++i)
+        {
+        distance->InsertNextValue(
+          static_cast<float>(sqrt(static_cast<double>(i*i+j*j+k*k))));
+        }
+      }
+    }
+  image->GetPointData()->SetScalars(distance);
+
+  vtkSmartPointer<vtkDataSetTriangleFilter> tetras =
+    vtkSmartPointer<vtkDataSetTriangleFilter>::New();
+  tetras->SetInput(image);
+  tetras->Update();
+  vtkUnstructuredGrid *grid = tetras->GetOutput();
+  vtkSmartPointer<vtkIdTypeArray> cellIds =
+    vtkSmartPointer<vtkIdTypeArray>::New();
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+    {
+    cellIds->InsertNextValue(i);
+    }
+  grid->GetCellData()->AddArray(cellIds);
+
+  // Probe points inside and outside of the grid, away from its boundary.
+  vtkSmartPointer<vtkImageData> input = vtkSmartPointer<vtkImageData>::New();
+  input->SetDimensions(41, 47, 53);
+  input->SetOrigin(-14.05, -14.03, -14.07);
+  input->SetSpacing(0.7, 0.61, 0.53);
+
+  vtkSmartPointer<vtkImageData> reference = Probe(input, grid, 0);
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(1);
+  vtkSmartPointer<vtkImageData> threaded1 = Probe(input, grid, 1);
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+  vtkSmartPointer<vtkImageData> threaded4 = Probe(input, grid, 1);
+
+  return (Compare(reference, threaded1) && Compare(reference, threaded4)) ?
+    0 : 1;
+}
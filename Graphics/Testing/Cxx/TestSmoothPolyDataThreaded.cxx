@@ -0,0 +1,208 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Smooth a noisy mesh with boundaries, strips and lines serially and on
+// one and several threads. The windowed sinc outputs must be identical;
+// the Laplacian outputs must not depend on the number of threads and stay
+// close to the serial one. Smoothing again after changing the number of
+// iterations or the points must give the output of a new filter.
+
+#include "vtkAppendPolyData.h"
+#include "vtkLineSource.h"
+#include "vtkPlaneSource.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+#include "vtkThreadPool.h"
+#include "vtkWindowedSincPolyDataFilter.h"
+
+#include <math.h>
+
+// Return the largest distance between the points of a and b, or -1 if
+// they do not have the same number of points.
+static double MaxDistance(vtkPolyData *a, vtkPolyData *b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints())
+    {
+    return -1.0;
+    }
+  double maxDist = 0.0, x[3], y[3];
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); i++)
+    {
+    a->GetPoint(i, x);
+    b->GetPoint(i, y);
+    double dist = sqrt((x[0] - y[0]) * (x[0] - y[0]) +
+                       (x[1] - y[1]) * (x[1] - y[1]) +
+                       (x[2] - y[2]) * (x[2] - y[2]));
+    maxDist = (dist > maxDist ? dist : maxDist);
+    }
+  return maxDist;
+}
+
+static vtkSmartPointer<vtkPolyData> Sinc(vtkPolyData *input, int options,
+                                         int numThreads, int iterations)
+{
+  vtkSmartPointer<vtkWindowedSincPolyDataFilter> smooth =
+    vtkSmartPointer<vtkWindowedSincPolyDataFilter>::New();
+  smooth->SetInput(input);
+  smooth->SetNumberOfIterations(iterations);
+  smooth->SetFeatureEdgeSmoothing(options & 1);
+  smooth->SetNonManifoldSmoothing((options & 2) != 0);
+  smooth->SetNormalizeCoordinates((options & 4) != 0);
+  smooth->SetUseThreadPool(numThreads > 0);
+  smooth->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(smooth->GetOutput());
+  return output;
+}
+
+static vtkSmartPointer<vtkPolyData> Laplacian(vtkPolyData *input,
+                                              int options, int numThreads)
+{
+  vtkSmartPointer<vtkSmoothPolyDataFilter> smooth =
+    vtkSmartPointer<vtkSmoothPolyDataFilter>::New();
+  smooth->SetInput(input);
+  smooth->SetNumberOfIterations(50);
+  smooth->SetRelaxationFactor(0.1);
+  smooth->SetFeatureEdgeSmoothing(options & 1);
+  smooth->SetBoundarySmoothing((options & 2) == 0);
+  smooth->SetUseThreadPool(numThreads > 0);
+  smooth->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(smooth->GetOutput());
+  return output;
+}
+
+int TestSmoothPolyDataThreaded(int, char *[])
+{
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(20);
+  vtkSmartPointer<vtkStripper> stripper = vtkSmartPointer<vtkStripper>::New();
+  stripper->SetInputConnection(sphere->GetOutputPort());
+  vtkSmartPointer<vtkPlaneSource> plane =
+    vtkSmartPointer<vtkPlaneSource>::New();
+  plane->SetResolution(30, 30);
+  plane->SetCenter(3.0, 0.0, 0.0);
+  vtkSmartPointer<vtkLineSource> line = vtkSmartPointer<vtkLineSource>::New();
+  line->SetPoint1(-1.0, 3.0, 0.0);
+  line->SetPoint2(1.0, 3.0, 0.0);
+  line->SetResolution(40);
+  vtkSmartPointer<vtkAppendPolyData> append =
+    vtkSmartPointer<vtkAppendPolyData>::New();
+  append->AddInputConnection(sphere->GetOutputPort());
+  append->AddInputConnection(stripper->GetOutputPort());
+  append->AddInputConnection(plane->GetOutputPort());
+  append->AddInputConnection(line->GetOutputPort());
+  append->Update();
+
+  // Add some deterministic noise.
+  vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
+  mesh->DeepCopy(append->GetOutput());
+  vtkPoints *points = mesh->GetPoints();
+  vtkIdType i;
+  double x[3];
+  for (i = 0; i < points->GetNumberOfPoints(); i++)
+    {
+    points->GetPoint(i, x);
+    x[0] += 0.02 * sin(17.0 * i);
+    x[1] += 0.02 * sin(29.0 * i);
+    x[2] += 0.02 * sin(43.0 * i);
+    points->SetPoint(i, x);
+    }
+
+  int threadCounts[3] = { 0, 1, 4 };
+  int options, t;
+  for (options = 0; options < 8; options++)
+    {
+    vtkSmartPointer<vtkPolyData> sinc[3], laplacian[3];
+    for (t = 0; t < 3; t++)
+      {
+      vtkThreadPool::GetInstance()->SetNumberOfThreads(
+        threadCounts[t] ? threadCounts[t] : 1);
+      sinc[t] = Sinc(mesh, options, threadCounts[t], 20);
+      laplacian[t] = Laplacian(mesh, options & 3, threadCounts[t]);
+      }
+    if (MaxDistance(mesh, sinc[0]) <= 0.0 ||
+        MaxDistance(mesh, laplacian[0]) <= 0.0)
+      {
+      cerr << "No point was smoothed with options " << options << "\n";
+      return 1;
+      }
+    for (t = 1; t < 3; t++)
+      {
+      if (MaxDistance(sinc[0], sinc[t]) != 0.0)
+        {
+        cerr << "Windowed sinc output differs with options " << options
+             << " on " << threadCounts[t] << " threads\n";
+        return 1;
+        }
+      }
+    double dist = MaxDistance(laplacian[0], laplacian[1]);
+    if (MaxDistance(laplacian[1], laplacian[2]) != 0.0 ||
+        dist < 0.0 || dist > 0.005)
+      {
+      cerr << "Laplacian output differs with options " << options
+           << " by " << dist << "\n";
+      return 1;
+      }
+    }
+
+  // The adjacency kept from the previous execution must not change the
+  // output.
+  for (t = 0; t < 3; t += 2)
+    {
+    vtkThreadPool::GetInstance()->SetNumberOfThreads(
+      threadCounts[t] ? threadCounts[t] : 1);
+    vtkSmartPointer<vtkPolyData> input = vtkSmartPointer<vtkPolyData>::New();
+    input->DeepCopy(mesh);
+    vtkSmartPointer<vtkWindowedSincPolyDataFilter> smooth =
+      vtkSmartPointer<vtkWindowedSincPolyDataFilter>::New();
+    smooth->SetInput(input);
+    smooth->SetUseThreadPool(threadCounts[t] > 0);
+    smooth->Update();
+    smooth->SetNumberOfIterations(10);
+    smooth->Update();
+    if (MaxDistance(smooth->GetOutput(),
+                    Sinc(input, 0, threadCounts[t], 10)) != 0.0)
+      {
+      cerr << "Changing the number of iterations gives another output\n";
+      return 1;
+      }
+    // Moving a point changes the classification of its neighbors.
+    input->GetPoints()->SetPoint(0, 0.0, 0.0, 2.0);
+    input->Modified();
+    smooth->Update();
+    if (MaxDistance(smooth->GetOutput(),
+                    Sinc(input, 0, threadCounts[t], 10)) != 0.0)
+      {
+      cerr << "Moving a point gives another output\n";
+      return 1;
+      }
+    }
+
+  // Lines only.
+  line->Update();
+  vtkSmartPointer<vtkPolyData> lines = Sinc(line->GetOutput(), 0, 4, 20);
+  if (lines->GetNumberOfPoints() != line->GetOutput()->GetNumberOfPoints())
+    {
+    cerr << "Lines were not smoothed\n";
+    return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,372 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reorder a tetrahedral mesh of random points, a sphere and a grid of
+// polyhedra along the Morton and Hilbert curves, serially and on several
+// threads. The original ids must map the output back to the input, faces
+// of the polyhedra included, and the points of a cell must get closer ids.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDelaunay3D.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPointSource.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpatialReorderFilter.h"
+#include "vtkSphereSource.h"
+#include "vtkThreadPool.h"
+#include "vtkUnstructuredGrid.h"
+
+// Add a point and a cell array that hold the ids.
+static void AddIds(vtkDataSet *ds)
+{
+  vtkSmartPointer<vtkDoubleArray> ids = vtkSmartPointer<vtkDoubleArray>::New();
+  ids->SetName("Ids");
+  vtkIdType i;
+  for (i = 0; i < ds->GetNumberOfPoints(); i++)
+    {
+    ids->InsertNextValue(i);
+    }
+  ds->GetPointData()->AddArray(ids);
+  vtkSmartPointer<vtkDoubleArray> cellIds =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  cellIds->SetName("CellIds");
+  for (i = 0; i < ds->GetNumberOfCells(); i++)
+    {
+    cellIds->InsertNextValue(i);
+    }
+  ds->GetCellData()->AddArray(cellIds);
+}
+
+// Average over the cells of the spread of their point ids.
+static double Spread(vtkDataSet *ds)
+{
+  vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+  double spread = 0.0;
+  for (vtkIdType i = 0; i < ds->GetNumberOfCells(); i++)
+    {
+    ds->GetCellPoints(i, ids);
+    vtkIdType minId = ids->GetId(0), maxId = ids->GetId(0);
+    for (vtkIdType j = 1; j < ids->GetNumberOfIds(); j++)
+      {
+      minId = (ids->GetId(j) < minId ? ids->GetId(j) : minId);
+      maxId = (ids->GetId(j) > maxId ? ids->GetId(j) : maxId);
+      }
+    spread += maxId - minId;
+    }
+  return spread / ds->GetNumberOfCells();
+}
+
+// Check that the faces of the output cells map back to those of the input.
+static int FacesMapBack(vtkUnstructuredGrid *input,
+                        vtkUnstructuredGrid *output,
+                        vtkIdTypeArray *pointIds, vtkIdTypeArray *cellIds)
+{
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); i++)
+    {
+    vtkIdType *a = output->GetFaces(i);
+    vtkIdType *b = input->GetFaces(cellIds->GetValue(i));
+    int same = (a == NULL) == (b == NULL);
+    if (same && a)
+      {
+      vtkIdType nfaces = *a++;
+      same = (nfaces == *b++);
+      for (vtkIdType f = 0; same && f < nfaces; f++)
+        {
+        vtkIdType npts = *a++;
+        same = (npts == *b++);
+        for (vtkIdType j = 0; same && j < npts; j++)
+          {
+          same = pointIds->GetValue(*a++) == *b++;
+          }
+        }
+      }
+    if (!same)
+      {
+      cerr << "The faces of cell " << i << " do not map back\n";
+      return 0;
+      }
+    }
+  return 1;
+}
+
+// Check that the original ids map the output back to the input.
+static int MapsBack(vtkDataSet *input, vtkDataSet *output)
+{
+  vtkIdTypeArray *pointIds = vtkIdTypeArray::SafeDownCast(
+    output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  vtkIdTypeArray *cellIds = vtkIdTypeArray::SafeDownCast(
+    output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  vtkDataArray *ids = output->GetPointData()->GetArray("Ids");
+  vtkDataArray *cellData = output->GetCellData()->GetArray("CellIds");
+  if (!pointIds || !cellIds || !ids || !cellData ||
+      output->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+      output->GetNumberOfCells() != input->GetNumberOfCells())
+    {
+    cerr << "Missing original ids or data\n";
+    return 0;
+    }
+  vtkIdType i, j;
+  double x[3], y[3];
+  for (i = 0; i < output->GetNumberOfPoints(); i++)
+    {
+    vtkIdType ptId = pointIds->GetValue(i);
+    output->GetPoint(i, x);
+    input->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+        ids->GetComponent(i, 0) != ptId)
+      {
+      cerr << "Point " << i << " does not map back\n";
+      return 0;
+      }
+    }
+  vtkSmartPointer<vtkIdList> a = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> b = vtkSmartPointer<vtkIdList>::New();
+  for (i = 0; i < output->GetNumberOfCells(); i++)
+    {
+    vtkIdType cellId = cellIds->GetValue(i);
+    output->GetCellPoints(i, a);
+    input->GetCellPoints(cellId, b);
+    int same = output->GetCellType(i) == input->GetCellType(cellId) &&
+      a->GetNumberOfIds() == b->GetNumberOfIds() &&
+      cellData->GetComponent(i, 0) == cellId;
+    for (j = 0; same && j < a->GetNumberOfIds(); j++)
+      {
+      same = pointIds->GetValue(a->GetId(j)) == b->GetId(j);
+      }
+    if (!same)
+      {
+      cerr << "Cell " << i << " does not map back\n";
+      return 0;
+      }
+    }
+  vtkUnstructuredGrid *inGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (inGrid && inGrid->GetFaces() &&
+      !FacesMapBack(inGrid, vtkUnstructuredGrid::SafeDownCast(output),
+                    pointIds, cellIds))
+    {
+    return 0;
+    }
+  return 1;
+}
+
+static int SameValues(vtkIdTypeArray *a, vtkIdTypeArray *b)
+{
+  if (!a || !b || a == b || a->GetNumberOfTuples() != b->GetNumberOfTuples())
+    {
+    return 0;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    if (a->GetValue(i) != b->GetValue(i))
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+// A grid of cubes inserted in scattered order, every other one as a
+// polyhedron with its faces and the others as hexahedra.
+static vtkSmartPointer<vtkUnstructuredGrid> Polyhedra()
+{
+  const int n = 5;
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  int i, j, k;
+  for (k = 0; k <= n; k++)
+    {
+    for (j = 0; j <= n; j++)
+      {
+      for (i = 0; i <= n; i++)
+        {
+        points->InsertNextPoint(i, j, k);
+        }
+      }
+    }
+  vtkSmartPointer<vtkUnstructuredGrid> grid =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate(n*n*n);
+  static const int faceCorners[6][4] = {
+    {0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4},
+    {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7} };
+  for (int c = 0; c < n*n*n; c++)
+    {
+    // 47 is prime to 125, the cubes are all visited.
+    int cube = (c*47) % (n*n*n);
+    i = cube % n;
+    j = (cube / n) % n;
+    k = cube / (n*n);
+    vtkIdType base = i + (n+1)*(j + (n+1)*k);
+    vtkIdType pts[8];
+    pts[0] = base;
+    pts[1] = base + 1;
+    pts[2] = base + n + 2;
+    pts[3] = base + n + 1;
+    for (int p = 0; p < 4; p++)
+      {
+      pts[p+4] = pts[p] + (n+1)*(n+1);
+      }
+    if (c % 2 == 0)
+      {
+      vtkIdType faces[30];
+      for (int f = 0; f < 6; f++)
+        {
+        faces[5*f] = 4;
+        for (int p = 0; p < 4; p++)
+          {
+          faces[5*f+1+p] = pts[faceCorners[f][p]];
+          }
+        }
+      grid->InsertNextCell(VTK_POLYHEDRON, 8, pts, 6, faces);
+      }
+    else
+      {
+      grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+      }
+    }
+  return grid;
+}
+
+static int TestInput(vtkPointSet *input, int checkSpread)
+{
+  for (int curve = VTK_REORDER_MORTON; curve <= VTK_REORDER_HILBERT; curve++)
+    {
+    vtkSmartPointer<vtkSpatialReorderFilter> reference;
+    int threadCounts[3] = { 0, 1, 4 };
+    for (int t = 0; t < 3; t++)
+      {
+      vtkThreadPool::GetInstance()->SetNumberOfThreads(
+        threadCounts[t] ? threadCounts[t] : 1);
+      vtkSmartPointer<vtkSpatialReorderFilter> reorder =
+        vtkSmartPointer<vtkSpatialReorderFilter>::New();
+      reorder->SetInput(input);
+      reorder->SetCurveType(curve);
+      reorder->SetUseThreadPool(threadCounts[t] > 0);
+      reorder->Update();
+      vtkPointSet *output = reorder->GetOutput();
+      if (!MapsBack(input, output))
+        {
+        return 0;
+        }
+      if (t == 0)
+        {
+        reference = reorder;
+        if (checkSpread && Spread(output) > 0.25 * Spread(input))
+          {
+          cerr << reorder->GetCurveTypeAsString() << " spread "
+               << Spread(output) << " instead of less than a quarter of "
+               << Spread(input) << "\n";
+          return 0;
+          }
+        continue;
+        }
+      // The order does not depend on the number of threads.
+      vtkDataArray *a =
+        reference->GetOutput()->GetPointData()->GetArray("vtkOriginalPointIds");
+      vtkDataArray *b = output->GetPointData()->GetArray("vtkOriginalPointIds");
+      vtkDataArray *c =
+        reference->GetOutput()->GetCellData()->GetArray("vtkOriginalCellIds");
+      vtkDataArray *d = output->GetCellData()->GetArray("vtkOriginalCellIds");
+      vtkIdType i;
+      for (i = 0; i < a->GetNumberOfTuples(); i++)
+        {
+        if (a->GetComponent(i, 0) != b->GetComponent(i, 0))
+          {
+          cerr << "Point order differs on " << threadCounts[t] << " threads\n";
+          return 0;
+          }
+        }
+      for (i = 0; i < c->GetNumberOfTuples(); i++)
+        {
+        if (c->GetComponent(i, 0) != d->GetComponent(i, 0))
+          {
+          cerr << "Cell order differs on " << threadCounts[t] << " threads\n";
+          return 0;
+          }
+        }
+      }
+    }
+  return 1;
+}
+
+int TestSpatialReorderFilter(int, char *[])
+{
+  // Random points give a mesh with no locality at all.
+  vtkSmartPointer<vtkPointSource> cloud =
+    vtkSmartPointer<vtkPointSource>::New();
+  cloud->SetNumberOfPoints(2000);
+  vtkSmartPointer<vtkDelaunay3D> delaunay =
+    vtkSmartPointer<vtkDelaunay3D>::New();
+  delaunay->SetInputConnection(cloud->GetOutputPort());
+  delaunay->Update();
+  vtkSmartPointer<vtkUnstructuredGrid> grid =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->ShallowCopy(delaunay->GetOutput());
+  AddIds(grid);
+  if (!TestInput(grid, 1))
+    {
+    return 1;
+    }
+
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(20);
+  sphere->Update();
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->DeepCopy(sphere->GetOutput());
+  AddIds(polyData);
+  if (!TestInput(polyData, 0))
+    {
+    return 1;
+    }
+
+  vtkSmartPointer<vtkUnstructuredGrid> polyhedra = Polyhedra();
+  AddIds(polyhedra);
+  if (!TestInput(polyhedra, 0))
+    {
+    return 1;
+    }
+
+  // Without reordering the faces are kept, and they are shared or copied
+  // with the grid.
+  vtkSmartPointer<vtkSpatialReorderFilter> pass =
+    vtkSmartPointer<vtkSpatialReorderFilter>::New();
+  pass->SetInput(polyhedra);
+  pass->ReorderPointsOff();
+  pass->ReorderCellsOff();
+  pass->Update();
+  vtkSmartPointer<vtkUnstructuredGrid> shallow =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  shallow->ShallowCopy(polyhedra);
+  vtkSmartPointer<vtkUnstructuredGrid> deep =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  deep->DeepCopy(polyhedra);
+  if (!MapsBack(polyhedra, pass->GetOutput()) ||
+      shallow->GetFaces() != polyhedra->GetFaces() ||
+      shallow->GetFaceLocations() != polyhedra->GetFaceLocations() ||
+      !SameValues(deep->GetFaces(), polyhedra->GetFaces()) ||
+      !SameValues(deep->GetFaceLocations(), polyhedra->GetFaceLocations()))
+    {
+    cerr << "The faces are not kept\n";
+    return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Trace streamlines in a swirling field, on an image and on a tetrahedral
+// grid, serially and then on one and several threads. The threaded
+// streamlines must be the serial ones, in the same order.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRungeKutta45.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamTracer.h"
+#include "vtkThreadPool.h"
+#include "vtkUnstructuredGrid.h"
+
+static vtkSmartPointer<vtkPolyData> Trace(vtkDataSet *input,
+                                          vtkPolyData *seeds,
+                                          int interpolatorType,
+                                          int useThreadPool)
+{
+  vtkSmartPointer<vtkStreamTracer> tracer =
+    vtkSmartPointer<vtkStreamTracer>::New();
+  tracer->SetInput(input);
+  tracer->SetSource(seeds);
+  tracer->SetInterpolatorType(interpolatorType);
+  vtkSmartPointer<vtkRungeKutta45> integrator =
+    vtkSmartPointer<vtkRungeKutta45>::New();
+  tracer->SetIntegrator(integrator);
+  tracer->SetMaximumPropagation(20.0);
+  tracer->SetIntegrationDirectionToBoth();
+  tracer->SetUseThreadPool(useThreadPool);
+  tracer->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(tracer->GetOutput());
+  return output;
+}
+
+static int Compare(vtkPolyData *reference, vtkPolyData *traced)
+{
+  vtkIdType i, numPts = reference->GetNumberOfPoints();
+  if (traced->GetNumberOfPoints() != numPts ||
+      traced->GetNumberOfLines() != reference->GetNumberOfLines() ||
+      reference->GetNumberOfLines() < 100)
+    {
+    cerr << "Traced " << traced->GetNumberOfPoints() << " points and "
+         << traced->GetNumberOfLines() << " lines instead of " << numPts
+         << " points and " << reference->GetNumberOfLines() << " lines\n";
+    return 0;
+    }
+  double x[3], y[3];
+  vtkDataArray *refTime =
+    reference->GetPointData()->GetArray("IntegrationTime");
+  vtkDataArray *time = traced->GetPointData()->GetArray("IntegrationTime");
+  vtkDataArray *normals = traced->GetPointData()->GetArray("Normals");
+  if (!time || !normals ||
+      traced->GetPointData()->GetNumberOfArrays() !=
+      reference->GetPointData()->GetNumberOfArrays())
+    {
+    cerr << "Missing point data arrays\n";
+    return 0;
+    }
+  for (i = 0; i < numPts; i++)
+    {
+    reference->GetPoint(i, x);
+    traced->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+        time->GetComponent(i, 0) != refTime->GetComponent(i, 0))
+      {
+      cerr << "Point " << i << " differs\n";
+      return 0;
+      }
+    }
+
+  vtkCellArray *refLines = reference->GetLines();
+  vtkCellArray *lines = traced->GetLines();
+  vtkIntArray *refReasons = vtkIntArray::SafeDownCast(
+    reference->GetCellData()->GetArray("ReasonForTermination"));
+  vtkIntArray *reasons = vtkIntArray::SafeDownCast(
+    traced->GetCellData()->GetArray("ReasonForTermination"));
+  if (!reasons)
+    {
+    cerr << "Missing ReasonForTermination\n";
+    return 0;
+    }
+  vtkIdType refNpts, *refPts, npts, *pts, cellId = 0;
+  refLines->InitTraversal();
+  lines->InitTraversal();
+  while (refLines->GetNextCell(refNpts, refPts))
+    {
+    lines->GetNextCell(npts, pts);
+    if (npts != refNpts ||
+        reasons->GetValue(cellId) != refReasons->GetValue(cellId))
+      {
+      cerr << "Line " << cellId << " differs\n";
+      return 0;
+      }
+    for (i = 0; i < npts; i++)
+      {
+      if (pts[i] != refPts[i])
+        {
+        cerr << "Line " << cellId << " differs\n";
+        return 0;
+        }
+      }
+    cellId++;
+    }
+  return 1;
+}
+
+static int TestInput(vtkDataSet *input, vtkPolyData *seeds,
+                     int interpolatorType)
+{
+  vtkSmartPointer<vtkPolyData> reference =
+    Trace(input, seeds, interpolatorType, 0);
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(1);
+  vtkSmartPointer<vtkPolyData> threaded1 =
+    Trace(input, seeds, interpolatorType, 1);
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+  vtkSmartPointer<vtkPolyData> threaded4 =
+    Trace(input, seeds, interpolatorType, 1);
+  return Compare(reference, threaded1) && Compare(reference, threaded4);
+}
+
+int TestStreamTracerThreaded(int, char *[])
+{
+  // A swirl around z with an upward drift.
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(13, 13, 9);
+  image->SetOrigin(-3.0, -3.0, -2.0);
+  image->SetSpacing(0.5, 0.5, 0.5);
+  vtkSmartPointer<vtkDoubleArray> velocity =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  double x[3];
+  vtkIdType i;
+  for (i = 0; i < image->GetNumberOfPoints(); i++)
+    {
+    image->GetPoint(i, x);
+    velocity->InsertNextTuple3(-x[1] + 0.1 * x[2], x[0], 0.2 + 0.1 * x[0]);
+    }
+  image->GetPointData()->SetVectors(velocity);
+
+  vtkSmartPointer<vtkDataSetTriangleFilter> tetras =
+    vtkSmartPointer<vtkDataSetTriangleFilter>::New();
+  tetras->SetInput(image);
+  tetras->Update();
+
+  // Seeds inside and a few outside of the field.
+  vtkSmartPointer<vtkPolyData> seeds = vtkSmartPointer<vtkPolyData>::New();
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  for (i = 0; i < 300; i++)
+    {
+    points->InsertNextPoint(-3.2 + 0.021 * i, 0.7 - 0.0047 * i,
+                            -1.9 + 0.0123 * i);
+    }
+  seeds->SetPoints(points);
+
+  return (TestInput(image, seeds,
+                    vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR) &&
+          TestInput(tetras->GetOutput(), seeds,
+                    vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR) &&
+          TestInput(tetras->GetOutput(), seeds,
+                    vtkStreamTracer::INTERPOLATOR_WITH_CELL_LOCATOR)) ? 0 : 1;
+}
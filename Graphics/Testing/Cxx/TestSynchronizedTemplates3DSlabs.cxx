@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Contour a sphere in slabs and compare with the serial output: the
+// surfaces must have the same size, be closed (the slab seams are merged)
+// and not depend on the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSynchronizedTemplates3D.h"
+#include "vtkThreadPool.h"
+
+#include <vtkstd/map>
+#include <vtkstd/utility>
+
+#include <math.h>
+
+static vtkSmartPointer<vtkPolyData> Contour(vtkImageData *image,
+                                            int useThreadPool)
+{
+  vtkSmartPointer<vtkSynchronizedTemplates3D> contour =
+    vtkSmartPointer<vtkSynchronizedTemplates3D>::New();
+  contour->SetInput(image);
+  contour->SetValue(0, 20.5);
+  contour->SetValue(1, 10.5);
+  contour->SetUseThreadPool(useThreadPool);
+  contour->SetSlabThickness(3);
+  contour->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(contour->GetOutput());
+  return output;
+}
+
+// Every edge of a closed triangle mesh is used by exactly two triangles.
+static int IsClosed(vtkPolyData *surface)
+{
+  vtkstd::map<vtkstd::pair<vtkIdType, vtkIdType>, int> edges;
+  vtkCellArray *polys = surface->GetPolys();
+  vtkIdType npts, *pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+    {
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      vtkIdType a = pts[i], b = pts[(i + 1) % npts];
+      ++edges[vtkstd::make_pair(a < b ? a : b, a < b ? b : a)];
+      }
+    }
+  vtkstd::map<vtkstd::pair<vtkIdType, vtkIdType>, int>::iterator it;
+  for (it = edges.begin(); it != edges.end(); ++it)
+    {
+    if (it->second != 2)
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+int TestSynchronizedTemplates3DSlabs(int, char *[])
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(-30, 30, -30, 30, -30, 30);
+  image->SetScalarTypeToFloat();
+  image->AllocateScalars();
+  float *s = static_cast<float *>(image->GetScalarPointer());
+  for (int k = -30; k <= 30; ++k)
+    {
+    for (int j = -30; j <= 30; ++j)
+      {
+      for (int i = -30; i <= 30; ++i)
+        {
+        *s++ = static_cast<float>(sqrt(static_cast<double>(i*i+j*j+k*k)));
+        }
+      }
+    }
+
+  vtkSmartPointer<vtkPolyData> serial = Contour(image, 0);
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(1);
+  vtkSmartPointer<vtkPolyData> slabs1 = Contour(image, 1);
+  vtkThreadPool::GetInstance()->SetNumberOfThreads(4);
+  vtkSmartPointer<vtkPolyData> slabs4 = Contour(image, 1);
+
+  if (serial->GetNumberOfPoints() != slabs1->GetNumberOfPoints() ||
+      serial->GetNumberOfCells() != slabs1->GetNumberOfCells())
+    {
+    cerr << "Slabs produced " << slabs1->GetNumberOfPoints() << " points and "
+         << slabs1->GetNumberOfCells() << " cells instead of "
+         << serial->GetNumberOfPoints() << " and "
+         << serial->GetNumberOfCells() << endl;
+    return 1;
+    }
+  if (!IsClosed(serial) || !IsClosed(slabs1))
+    {
+    cerr << "Surface is not closed" << endl;
+    return 1;
+    }
+
+  // The output must not depend on the number of threads.
+  vtkDataArray *pts1 = slabs1->GetPoints()->GetData();
+  vtkDataArray *pts4 = slabs4->GetPoints()->GetData();
+  vtkDataArray *nrm1 = slabs1->GetPointData()->GetNormals();
+  vtkDataArray *nrm4 = slabs4->GetPointData()->GetNormals();
+  if (pts4->GetNumberOfTuples() != pts1->GetNumberOfTuples() ||
+      !nrm1 || !nrm4)
+    {
+    cerr << "Bad output with 4 threads" << endl;
+    return 1;
+    }
+  for (vtkIdType i = 0; i < pts1->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < 3; ++c)
+      {
+      if (pts1->GetComponent(i, c) != pts4->GetComponent(i, c) ||
+          nrm1->GetComponent(i, c) != nrm4->GetComponent(i, c))
+        {
+        cerr << "Point " << i << " depends on the number of threads" << endl;
+        return 1;
+        }
+      }
+    }
+  vtkIdType *c1 = slabs1->GetPolys()->GetPointer();
+  vtkIdType *c4 = slabs4->GetPolys()->GetPointer();
+  vtkIdType size = slabs1->GetPolys()->GetNumberOfConnectivityEntries();
+  for (vtkIdType i = 0; i < size; ++i)
+    {
+    if (c1[i] != c4[i])
+      {
+      cerr << "Cells depend on the number of threads" << endl;
+      return 1;
+      }
+    }
+
+  return 0;
+}
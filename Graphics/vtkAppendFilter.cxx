@@ -15,6 +15,7 @@
 #include "vtkAppendFilter.h"
 
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDataSetCollection.h"
@@ -22,9 +23,17 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vtkstd/vector>
+
 vtkCxxRevisionMacro(vtkAppendFilter, "$Revision$");
 vtkStandardNewMacro(vtkAppendFilter);
 
@@ -32,6 +41,7 @@ vtkStandardNewMacro(vtkAppendFilter);
 vtkAppendFilter::vtkAppendFilter()
 {
   this->InputList = NULL;
+  this->UseThreadPool = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -91,6 +101,141 @@ vtkDataSetCollection *vtkAppendFilter::GetInputList()
   return this->InputList;
 }
 
+//----------------------------------------------------------------------------
+// Where an unstructured grid input goes in the output: its first point,
+// cell and connectivity entry, and its index in the FieldLists.
+struct vtkAppendFilterPlacement
+{
+  vtkUnstructuredGrid *Input;
+  vtkIdType PointOffset;
+  vtkIdType CellOffset;
+  vtkIdType ConnectivityOffset;
+  int ListIndex;
+};
+
+//----------------------------------------------------------------------------
+// Copy a range of unstructured grid inputs to their place in the
+// preallocated output.
+class vtkAppendFilterAppendInputs
+{
+public:
+  vtkAppendFilter *Self;
+  vtkSMPProgress<vtkAppendFilter> *Progress;
+  vtkAppendFilterPlacement *Placements;
+  vtkDataSetAttributes::FieldList *PointList;
+  vtkDataSetAttributes::FieldList *CellList;
+  vtkPointData *OutputPD;
+  vtkCellData *OutputCD;
+  float *Points;
+  vtkIdType *Connectivity;
+  vtkIdType *Locations;
+  unsigned char *Types;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType i;
+    for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+      if (this->Self->GetAbortExecute())
+        {
+        return;
+        }
+      vtkAppendFilterPlacement& placement = this->Placements[idx];
+      vtkUnstructuredGrid *ug = placement.Input;
+      vtkIdType numPts = ug->GetNumberOfPoints();
+      vtkIdType numCells = ug->GetNumberOfCells();
+      if (numPts > 0)
+        {
+        vtkDataArray *inPts = ug->GetPoints()->GetData();
+        float *outPts = this->Points + 3*placement.PointOffset;
+        if (inPts->GetDataType() == VTK_FLOAT &&
+            inPts->HasStandardMemoryLayout())
+          {
+          memcpy(outPts, inPts->GetVoidPointer(0), 3*numPts*sizeof(float));
+          }
+        else
+          {
+          double x[3];
+          for (i = 0; i < numPts; i++)
+            {
+            inPts->GetTuple(i, x);
+            outPts[3*i] = static_cast<float>(x[0]);
+            outPts[3*i+1] = static_cast<float>(x[1]);
+            outPts[3*i+2] = static_cast<float>(x[2]);
+            }
+          }
+        this->OutputPD->CopyData(*this->PointList, ug->GetPointData(),
+                                 placement.ListIndex, 0,
+                                 placement.PointOffset, numPts);
+        }
+      if (numCells > 0)
+        {
+        vtkCellArray *inCells = ug->GetCells();
+        vtkIdType *outConn = this->Connectivity + placement.ConnectivityOffset;
+        vtkIdType *outLocs = this->Locations + placement.CellOffset;
+        vtkIdType cellId, j;
+        if (inCells->GetStorageMode() == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+          {
+          // Read through a cursor, GetPointer() would convert the cells
+          // of the input back to the list.
+          vtkIdList *ptIds = vtkIdList::New();
+          vtkCellArrayCursor cursor;
+          vtkIdType npts;
+          const vtkIdType *pts;
+          inCells->InitTraversal(cursor);
+          for (cellId = 0; cellId < numCells; cellId++)
+            {
+            vtkIdType loc = cursor.Location;
+            inCells->GetNextCell(cursor, npts, pts, ptIds);
+            outLocs[cellId] = loc + placement.ConnectivityOffset;
+            outConn[loc] = npts;
+            for (j = 0; j < npts; j++)
+              {
+              outConn[loc+1+j] = pts[j] + placement.PointOffset;
+              }
+            }
+          ptIds->Delete();
+          }
+        else
+          {
+          vtkIdType *inConn = inCells->GetPointer();
+          vtkIdType *inLocs = ug->GetCellLocationsArray()->GetPointer(0);
+          for (cellId = 0; cellId < numCells; cellId++)
+            {
+            vtkIdType loc = inLocs[cellId];
+            vtkIdType npts = inConn[loc];
+            outLocs[cellId] = loc + placement.ConnectivityOffset;
+            outConn[loc] = npts;
+            for (j = 1; j <= npts; j++)
+              {
+              outConn[loc+j] = inConn[loc+j] + placement.PointOffset;
+              }
+            }
+          }
+        memcpy(this->Types + placement.CellOffset,
+               ug->GetCellTypesArray()->GetPointer(0), numCells);
+        this->OutputCD->CopyData(*this->CellList, ug->GetCellData(),
+                                 placement.ListIndex, 0,
+                                 placement.CellOffset, numCells);
+        }
+      this->Progress->Advance(1);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+static int vtkAppendFilterHasBitArray(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); i++)
+    {
+    if (fd->GetAbstractArray(i)->GetDataType() == VTK_BIT)
+      {
+      return 1;
+      }
+    }
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 // Append data sets into single unstructured grid
 int vtkAppendFilter::RequestData(
@@ -120,6 +265,20 @@ int vtkAppendFilter::RequestData(
 
   vtkDebugMacro(<<"Appending data together");
 
+  int numInputs = inputVector[0]->GetNumberOfInformationObjects();
+
+  // On the threaded path a single unstructured grid is passed through.
+  // The serial path keeps copying it, so that its output does not change.
+  if (this->UseThreadPool && numInputs == 1)
+    {
+    vtkUnstructuredGrid *ug = vtkUnstructuredGrid::GetData(inputVector[0], 0);
+    if (ug)
+      {
+      output->ShallowCopy(ug);
+      return 1;
+      }
+    }
+
   // Loop over all data sets, checking to see what data is common to 
   // all inputs. Note that data is common if 1) it is the same attribute 
   // type (scalar, vector, etc.), 2) it is the same native type (int, 
@@ -130,11 +289,11 @@ int vtkAppendFilter::RequestData(
   numPts = 0;
   numCells = 0;
 
-  int numInputs = inputVector[0]->GetNumberOfInformationObjects();
   vtkDataSetAttributes::FieldList ptList(numInputs);
   vtkDataSetAttributes::FieldList cellList(numInputs);
   int firstPD=1;
   int firstCD=1;
+  int allUnstructured=1;
   vtkInformation *inInfo = 0;
   for (idx = 0; idx < numInputs; ++idx)
     {
@@ -153,6 +312,10 @@ int vtkAppendFilter::RequestData(
 
       numPts += ds->GetNumberOfPoints();
       numCells += ds->GetNumberOfCells();
+      if ( !ds->IsA("vtkUnstructuredGrid") )
+        {
+        allUnstructured = 0;
+        }
 
       pd = ds->GetPointData();
       if ( firstPD )
@@ -183,7 +346,95 @@ int vtkAppendFilter::RequestData(
     vtkDebugMacro(<<"No data to append!");
     return 1;
     }
-  
+
+  if ( this->UseThreadPool && allUnstructured )
+    {
+    // Compute where every input goes, then copy the inputs concurrently.
+    vtkstd::vector<vtkAppendFilterPlacement> placements;
+    vtkIdType connectivitySize = 0;
+    vtkIdType cellOffset = 0;
+    ptOffset = 0;
+    for (idx = 0; idx < numInputs; ++idx)
+      {
+      vtkUnstructuredGrid *ug =
+        vtkUnstructuredGrid::GetData(inputVector[0], idx);
+      if ( ug == NULL ||
+           (ug->GetNumberOfPoints() <= 0 && ug->GetNumberOfCells() <= 0) )
+        {
+        continue;
+        }
+      vtkAppendFilterPlacement placement;
+      placement.Input = ug;
+      placement.PointOffset = ptOffset;
+      placement.CellOffset = cellOffset;
+      placement.ConnectivityOffset = connectivitySize;
+      placement.ListIndex = static_cast<int>(placements.size());
+      placements.push_back(placement);
+      ptOffset += ug->GetNumberOfPoints();
+      if ( ug->GetNumberOfCells() > 0 )
+        {
+        cellOffset += ug->GetNumberOfCells();
+        connectivitySize += ug->GetCells()->GetNumberOfConnectivityEntries();
+        }
+      }
+
+    outputPD->CopyGlobalIdsOn();
+    outputPD->CopyAllocate(ptList,numPts);
+    outputCD->CopyGlobalIdsOn();
+    outputCD->CopyAllocate(cellList,numCells);
+    for (i = 0; i < outputPD->GetNumberOfArrays(); i++)
+      {
+      outputPD->GetAbstractArray(i)->SetNumberOfTuples(numPts);
+      }
+    for (i = 0; i < outputCD->GetNumberOfArrays(); i++)
+      {
+      outputCD->GetAbstractArray(i)->SetNumberOfTuples(numCells);
+      }
+
+    newPts = vtkPoints::New();
+    newPts->SetNumberOfPoints(numPts);
+    vtkCellArray *cells = vtkCellArray::New();
+    vtkUnsignedCharArray *types = vtkUnsignedCharArray::New();
+    vtkIdTypeArray *locations = vtkIdTypeArray::New();
+    types->SetNumberOfValues(numCells);
+    locations->SetNumberOfValues(numCells);
+
+    vtkAppendFilterAppendInputs append;
+    vtkSMPProgress<vtkAppendFilter> progress(
+      this, static_cast<vtkIdType>(placements.size()));
+    append.Self = this;
+    append.Progress = &progress;
+    append.Placements = &placements[0];
+    append.PointList = &ptList;
+    append.CellList = &cellList;
+    append.OutputPD = outputPD;
+    append.OutputCD = outputCD;
+    append.Points =
+      static_cast<vtkFloatArray *>(newPts->GetData())->GetPointer(0);
+    append.Connectivity = cells->WritePointer(numCells, connectivitySize);
+    append.Locations = locations->GetPointer(0);
+    append.Types = types->GetPointer(0);
+    // Bits of a vtkBitArray shared by two inputs cannot be written
+    // concurrently.
+    if (vtkAppendFilterHasBitArray(outputPD) ||
+        vtkAppendFilterHasBitArray(outputCD))
+      {
+      append(0, static_cast<vtkIdType>(placements.size()));
+      }
+    else
+      {
+      vtkSMPTools::For(0, static_cast<vtkIdType>(placements.size()), append);
+      }
+
+    output->SetPoints(newPts);
+    output->SetCells(types, locations, cells);
+    newPts->Delete();
+    cells->Delete();
+    types->Delete();
+    locations->Delete();
+    return 1;
+    }
+
   // Now can allocate memory
   output->Allocate(numCells); //allocate storage for geometry/topology
   outputPD->CopyGlobalIdsOn();
@@ -281,4 +532,7 @@ int vtkAppendFilter::FillInputPortInformation(int, vtkInformation *info)
 void vtkAppendFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "UseThreadPool: "
+     << (this->UseThreadPool ? "On\n" : "Off\n");
 }
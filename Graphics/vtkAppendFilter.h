@@ -20,6 +20,12 @@
 // and appended only if all datasets have the point attributes available. 
 // (For example, if one dataset has scalars but another does not, scalars will 
 // not be appended.)
+//
+// When UseThreadPool is on, a single unstructured grid input is shallow
+// copied to the output. When UseThreadPool is on and all the inputs are
+// unstructured grids, the inputs are copied concurrently on the workers of
+// the vtkThreadPool to their precomputed place in the output, with
+// memcpy() for the arrays and shifted point ids for the connectivity.
 
 // .SECTION See Also
 // vtkAppendPolyData
@@ -56,6 +62,13 @@ public:
   // will not be reflected in the actual inputs.
   vtkDataSetCollection *GetInputList();
 
+  // Description:
+  // Copy unstructured grid inputs in parallel with the vtkThreadPool.
+  // Off by default.
+  vtkSetMacro(UseThreadPool,int);
+  vtkGetMacro(UseThreadPool,int);
+  vtkBooleanMacro(UseThreadPool,int);
+
 protected:
   vtkAppendFilter();
   ~vtkAppendFilter();
@@ -69,6 +82,8 @@ protected:
   // Here as a convenience.  It is a copy of the input array.
   vtkDataSetCollection *InputList;
 
+  int UseThreadPool;
+
 private:
   vtkAppendFilter(const vtkAppendFilter&);  // Not implemented.
   void operator=(const vtkAppendFilter&);  // Not implemented.
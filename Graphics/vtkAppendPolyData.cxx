@@ -18,13 +18,17 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vtkstd/vector>
+
 vtkCxxRevisionMacro(vtkAppendPolyData, "$Revision$");
 vtkStandardNewMacro(vtkAppendPolyData);
 
@@ -33,6 +37,7 @@ vtkAppendPolyData::vtkAppendPolyData()
 {
   this->ParallelStreaming = 0;
   this->UserManagedInputs = 0;
+  this->UseThreadPool = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -104,6 +109,136 @@ void vtkAppendPolyData::SetInputByNumber(int num, vtkPolyData *input)
   this->SetNthInputConnection(0, num, input? input->GetProducerPort() : 0);
 }
 
+//----------------------------------------------------------------------------
+// Where an input goes in the output: its first point, the first cell and
+// connectivity entry in each of the verts, lines, polys and strips, and its
+// index in the point and cell FieldLists (-1 when it has no points or no
+// cells).
+struct vtkAppendPolyDataPlacement
+{
+  vtkIdType PointOffset;
+  vtkIdType CellOffsets[4];
+  vtkIdType ConnectivityOffsets[4];
+  int PointListIndex;
+  int CellListIndex;
+};
+
+//----------------------------------------------------------------------------
+// Copy a range of inputs to their place in the preallocated output.
+class vtkAppendPolyDataAppendInputs
+{
+public:
+  vtkAppendPolyData *Self;
+  vtkSMPProgress<vtkAppendPolyData> *Progress;
+  vtkPolyData **Inputs;
+  vtkAppendPolyDataPlacement *Placements;
+  vtkDataSetAttributes::FieldList *PointList;
+  vtkDataSetAttributes::FieldList *CellList;
+  vtkPointData *OutputPD;
+  vtkCellData *OutputCD;
+  vtkPoints *NewPts;
+  int AllSame;
+  vtkDataArray *NewPtScalars;
+  vtkDataArray *NewPtVectors;
+  vtkDataArray *NewPtNormals;
+  vtkDataArray *NewPtTCoords;
+  vtkDataArray *NewPtTensors;
+  vtkCellArray *NewCells[4];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+      if (this->Self->GetAbortExecute())
+        {
+        return;
+        }
+      vtkPolyData *ds = this->Inputs[idx];
+      vtkAppendPolyDataPlacement& placement = this->Placements[idx];
+      if (placement.PointListIndex >= 0)
+        {
+        vtkPointData *inPD = ds->GetPointData();
+        vtkIdType ptOffset = placement.PointOffset;
+        if (this->AllSame)
+          {
+          this->Self->AppendData(this->NewPts->GetData(),
+                                 ds->GetPoints()->GetData(), ptOffset);
+          }
+        else
+          {
+          this->Self->AppendDifferentPoints(this->NewPts->GetData(),
+                                            ds->GetPoints()->GetData(),
+                                            ptOffset);
+          }
+        if (this->NewPtScalars)
+          {
+          this->Self->AppendData(this->NewPtScalars, inPD->GetScalars(),
+                                 ptOffset);
+          }
+        if (this->NewPtNormals)
+          {
+          this->Self->AppendData(this->NewPtNormals, inPD->GetNormals(),
+                                 ptOffset);
+          }
+        if (this->NewPtVectors)
+          {
+          this->Self->AppendData(this->NewPtVectors, inPD->GetVectors(),
+                                 ptOffset);
+          }
+        if (this->NewPtTCoords)
+          {
+          this->Self->AppendData(this->NewPtTCoords, inPD->GetTCoords(),
+                                 ptOffset);
+          }
+        if (this->NewPtTensors)
+          {
+          this->Self->AppendData(this->NewPtTensors, inPD->GetTensors(),
+                                 ptOffset);
+          }
+        this->OutputPD->CopyData(*this->PointList, inPD,
+                                 placement.PointListIndex, 0, ptOffset,
+                                 ds->GetNumberOfPoints());
+        }
+
+      if (placement.CellListIndex >= 0)
+        {
+        // The cells of an input are its verts, lines, polys then strips.
+        vtkCellArray *inCells[4];
+        inCells[0] = ds->GetVerts();
+        inCells[1] = ds->GetLines();
+        inCells[2] = ds->GetPolys();
+        inCells[3] = ds->GetStrips();
+        vtkIdType inCellId = 0;
+        for (int i = 0; i < 4; i++)
+          {
+          vtkIdType numCells = inCells[i]->GetNumberOfCells();
+          this->OutputCD->CopyData(*this->CellList, ds->GetCellData(),
+                                   placement.CellListIndex, inCellId,
+                                   placement.CellOffsets[i], numCells);
+          inCellId += numCells;
+          this->Self->AppendCells(this->NewCells[i]->GetPointer() +
+                                  placement.ConnectivityOffsets[i],
+                                  inCells[i], placement.PointOffset);
+          }
+        }
+      this->Progress->Advance(1);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+static int vtkAppendPolyDataHasBitArray(vtkFieldData *fd)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); i++)
+    {
+    if (fd->GetAbstractArray(i)->GetDataType() == VTK_BIT)
+      {
+      return 1;
+      }
+    }
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output,
     vtkPolyData* inputs[], int numInputs)
@@ -351,14 +486,107 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output,
   outputPD->CopyAllocate(ptList,numPts);
   outputCD->CopyAllocate(cellList,numCells);
 
-  // loop over all input sets
+  if ( this->UseThreadPool )
+    {
+    // Compute where every input goes, then copy the inputs concurrently.
+    vtkstd::vector<vtkAppendPolyDataPlacement> placements(numInputs);
+    vtkIdType cellOffsets[4], connectivityOffsets[4] = {0, 0, 0, 0};
+    cellOffsets[0] = 0;
+    cellOffsets[1] = numVerts;
+    cellOffsets[2] = numVerts + numLines;
+    cellOffsets[3] = numVerts + numLines + numPolys;
+    vtkIdType ptOffset = 0;
+    countPD = countCD = 0;
+    for (idx = 0; idx < numInputs; ++idx)
+      {
+      vtkAppendPolyDataPlacement& placement = placements[idx];
+      placement.PointListIndex = placement.CellListIndex = -1;
+      ds = inputs[idx];
+      if (ds == NULL)
+        {
+        continue;
+        }
+      placement.PointOffset = ptOffset;
+      if (ds->GetNumberOfPoints() > 0)
+        {
+        placement.PointListIndex = countPD++;
+        }
+      vtkCellArray *inCells[4];
+      inCells[0] = ds->GetVerts();
+      inCells[1] = ds->GetLines();
+      inCells[2] = ds->GetPolys();
+      inCells[3] = ds->GetStrips();
+      for (i = 0; i < 4; i++)
+        {
+        placement.CellOffsets[i] = cellOffsets[i];
+        placement.ConnectivityOffsets[i] = connectivityOffsets[i];
+        if (ds->GetNumberOfCells() > 0)
+          {
+          cellOffsets[i] += inCells[i]->GetNumberOfCells();
+          connectivityOffsets[i] += inCells[i]->GetNumberOfConnectivityEntries();
+          }
+        }
+      if (ds->GetNumberOfCells() > 0)
+        {
+        placement.CellListIndex = countCD++;
+        }
+      ptOffset += ds->GetNumberOfPoints();
+      }
+
+    newVerts->WritePointer(numVerts, connectivityOffsets[0]);
+    newLines->WritePointer(numLines, connectivityOffsets[1]);
+    newStrips->WritePointer(numStrips, connectivityOffsets[3]);
+    for (i = 0; i < outputPD->GetNumberOfArrays(); i++)
+      {
+      outputPD->GetAbstractArray(i)->SetNumberOfTuples(numPts);
+      }
+    for (i = 0; i < outputCD->GetNumberOfArrays(); i++)
+      {
+      outputCD->GetAbstractArray(i)->SetNumberOfTuples(numCells);
+      }
+
+    vtkAppendPolyDataAppendInputs append;
+    vtkSMPProgress<vtkAppendPolyData> progress(this, numInputs);
+    append.Self = this;
+    append.Progress = &progress;
+    append.Inputs = inputs;
+    append.Placements = &placements[0];
+    append.PointList = &ptList;
+    append.CellList = &cellList;
+    append.OutputPD = outputPD;
+    append.OutputCD = outputCD;
+    append.NewPts = newPts;
+    append.AllSame = AllSame;
+    append.NewPtScalars = newPtScalars;
+    append.NewPtVectors = newPtVectors;
+    append.NewPtNormals = newPtNormals;
+    append.NewPtTCoords = newPtTCoords;
+    append.NewPtTensors = newPtTensors;
+    append.NewCells[0] = newVerts;
+    append.NewCells[1] = newLines;
+    append.NewCells[2] = newPolys;
+    append.NewCells[3] = newStrips;
+    // Bits of a vtkBitArray shared by two inputs cannot be written
+    // concurrently.
+    if (vtkAppendPolyDataHasBitArray(outputPD) ||
+        vtkAppendPolyDataHasBitArray(outputCD))
+      {
+      append(0, numInputs);
+      }
+    else
+      {
+      vtkSMPTools::For(0, numInputs, append);
+      }
+    }
+
+  // loop over all input sets, unless they were appended concurrently
   vtkIdType ptOffset = 0;
   vtkIdType vertOffset = 0;
   vtkIdType linesOffset = 0;
   vtkIdType polysOffset = 0;
   vtkIdType stripsOffset = 0;
   countPD = countCD = 0;
-  for (idx = 0; idx < numInputs; ++idx)
+  for (idx = 0; idx < numInputs && !this->UseThreadPool; ++idx)
     {
     this->UpdateProgress(0.2 + 0.8*idx/numInputs);
     ds = inputs[idx];
@@ -669,6 +897,7 @@ void vtkAppendPolyData::PrintSelf(ostream& os, vtkIndent indent)
 
   os << "ParallelStreaming:" << (this->ParallelStreaming?"On":"Off") << endl;
   os << "UserManagedInputs:" << (this->UserManagedInputs?"On":"Off") << endl;
+  os << "UseThreadPool:" << (this->UseThreadPool?"On":"Off") << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -702,6 +931,16 @@ void vtkAppendPolyData::AppendData(vtkDataArray *dest, vtkDataArray *src,
     return;
     }
   
+  // The raw pointer of another layout would be a copy.
+  if (!src->HasStandardMemoryLayout() || !dest->HasStandardMemoryLayout())
+    {
+    for (vtkIdType i = 0; i < src->GetNumberOfTuples(); i++)
+      {
+      dest->SetTuple(offset + i, i, src);
+      }
+    return;
+    }
+
   // convert from tuples to components.
   offset *= src->GetNumberOfComponents();
   length = src->GetMaxId() + 1;
@@ -754,6 +993,16 @@ void vtkAppendPolyData::AppendDifferentPoints(vtkDataArray *dest,
     case VTK_DOUBLE:
       dDest = static_cast<double*>(
         dest->GetVoidPointer(offset*src->GetNumberOfComponents()));
+      // The raw pointer of another layout would be a copy.
+      if (!src->HasStandardMemoryLayout())
+        {
+        int numComp = src->GetNumberOfComponents();
+        for (p=0; p<src->GetNumberOfTuples(); p++)
+          {
+          src->GetTuple(p, dDest + p*numComp);
+          }
+        break;
+        }
       //
       switch (src->GetDataType())
         {
@@ -792,6 +1041,26 @@ vtkIdType *vtkAppendPolyData::AppendCells(vtkIdType *pDest, vtkCellArray *src,
     return pDest;
     }
 
+  if (src->GetStorageMode() == VTK_CELL_ARRAY_OFFSETS_STORAGE)
+    {
+    // Read through a cursor, the list form of the cells would be a copy.
+    vtkIdList *ptIds = vtkIdList::New();
+    vtkCellArrayCursor cursor;
+    vtkIdType npts;
+    const vtkIdType *pts;
+    src->InitTraversal(cursor);
+    while (src->GetNextCell(cursor, npts, pts, ptIds))
+      {
+      *pDest++ = npts;
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        *pDest++ = offset + pts[i];
+        }
+      }
+    ptIds->Delete();
+    return pDest;
+    }
+
   pSrc = src->GetPointer();
   end = pSrc + src->GetNumberOfConnectivityEntries();
   pNum = pSrc;
@@ -21,6 +21,12 @@
 // extracted and appended only if all datasets have the point and/or cell
 // attributes available.  (For example, if one dataset has point scalars but
 // another does not, point scalars will not be appended.)
+//
+// When UseThreadPool is on, the position of every input in the output
+// points, cells and attribute arrays is computed first, and the inputs are
+// then copied concurrently on the workers of the vtkThreadPool, with
+// memcpy() for the arrays and shifted point ids for the cells. The output
+// is the same as the serial one.
 
 // .SECTION See Also
 // vtkAppendFilter
@@ -90,6 +96,12 @@ public:
   vtkGetMacro(ParallelStreaming, int); 
   vtkBooleanMacro(ParallelStreaming, int); 
 
+  // Description:
+  // Copy the inputs in parallel with the vtkThreadPool. Off by default.
+  vtkSetMacro(UseThreadPool, int);
+  vtkGetMacro(UseThreadPool, int);
+  vtkBooleanMacro(UseThreadPool, int);
+
 //BTX
   int ExecuteAppend(vtkPolyData* output,
     vtkPolyData* inputs[], int numInputs);
@@ -101,6 +113,8 @@ protected:
   // Flag for selecting parallel streaming behavior
   int ParallelStreaming;
 
+  int UseThreadPool;
+
   // Usual data generation method
   virtual int RequestData(vtkInformation *, 
                           vtkInformationVector **, vtkInformationVector *);
@@ -115,6 +129,10 @@ protected:
   vtkIdType *AppendCells(vtkIdType *pDest, vtkCellArray *src,
                          vtkIdType offset);
 
+//BTX
+  friend class vtkAppendPolyDataAppendInputs;
+//ETX
+
  private:
   // hide the superclass' AddInput() from the user and the compiler
   void AddInput(vtkDataObject *)
@@ -17,6 +17,7 @@
 #include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -24,10 +25,85 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkCellArray.h"
+#include "vtkSMPThreadLocal.h"
+
+#include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkCellCenters, "$Revision$");
 vtkStandardNewMacro(vtkCellCenters);
 
+// Cells processed by one call of the functor.
+static const vtkIdType VTK_CELL_CENTERS_GRAIN = 1000;
+
+//----------------------------------------------------------------------------
+// Compute the centers of cells [begin, end). Every thread uses its own
+// vtkGenericCell and weights so that GetCell(id, cell) can run
+// concurrently.
+class vtkCellCentersFunctor
+{
+public:
+  vtkCellCenters *Self;
+  vtkSMPProgress<vtkCellCenters> *Progress;
+  vtkDataSet *Input;
+  vtkPoints *NewPts;
+  int MaxCellSize;
+  vtkSMPThreadLocal<vtkGenericCell *> Cell;
+  vtkSMPThreadLocal<vtkstd::vector<double> > Weights;
+  vtkSMPThreadLocal<int> HasEmptyCells;
+  int AnyEmptyCells;
+
+  vtkCellCentersFunctor() : Cell(0) {}
+
+  void Initialize()
+    {
+    this->Cell.Local() = vtkGenericCell::New();
+    int size = this->MaxCellSize > 0 ? this->MaxCellSize : 1;
+    this->Weights.Local().resize(size);
+    this->HasEmptyCells.Local() = 0;
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    if (this->Self->GetAbortExecute())
+      {
+      return;
+      }
+    vtkGenericCell *cell = this->Cell.Local();
+    double *weights = &this->Weights.Local()[0];
+    double x[3], pcoords[3];
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Input->GetCell(cellId, cell);
+      if (cell->GetCellType() != VTK_EMPTY_CELL)
+        {
+        int subId = cell->GetParametricCenter(pcoords);
+        cell->EvaluateLocation(subId, pcoords, x, weights);
+        this->NewPts->SetPoint(cellId,x);
+        }
+      else
+        {
+        this->HasEmptyCells.Local() = 1;
+        }
+      }
+    this->Progress->Advance(end - begin);
+    }
+
+  void Reduce()
+    {
+    this->AnyEmptyCells = 0;
+    vtkSMPThreadLocal<int>::iterator eit = this->HasEmptyCells.begin();
+    for (; eit != this->HasEmptyCells.end(); ++eit)
+      {
+      this->AnyEmptyCells |= *eit;
+      }
+    vtkSMPThreadLocal<vtkGenericCell *>::iterator cit = this->Cell.begin();
+    for (; cit != this->Cell.end(); ++cit)
+      {
+      (*cit)->Delete();
+      }
+    }
+};
+
 //----------------------------------------------------------------------------
 // Construct object with vertex cell generation turned off.
 vtkCellCenters::vtkCellCenters()
@@ -52,14 +128,10 @@ int vtkCellCenters::RequestData(
   vtkPolyData *output = vtkPolyData::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType cellId, numCells;
-  int subId;
+  vtkIdType numCells;
   vtkCellData *inCD;
   vtkPointData *outPD;
   vtkPoints *newPts;
-  vtkCell *cell;
-  double x[3], pcoords[3];
-  double *weights;
 
   inCD=input->GetCellData();
   outPD=output->GetPointData();
@@ -72,32 +144,38 @@ int vtkCellCenters::RequestData(
 
   newPts = vtkPoints::New();
   newPts->SetNumberOfPoints(numCells);
-  weights = new double [input->GetMaxCellSize()];
 
-  int abort=0;
-  vtkIdType progressInterval = numCells/10 + 1;
-  int hasEmptyCells = 0;
-  for (cellId=0; cellId < numCells && !abort; cellId++)
+  // Cells may build internal structures (e.g. vtkPolyData::BuildCells())
+  // on first access, do that before going parallel.
+  vtkGenericCell *warmup = vtkGenericCell::New();
+  input->GetCell(0, warmup);
+  warmup->Delete();
+
+  vtkDebugMacro(<<"Computing cell centers");
+  this->UpdateProgress (0.0);
+  vtkCellCentersFunctor functor;
+  functor.Self = this;
+  functor.Input = input;
+  functor.NewPts = newPts;
+  functor.MaxCellSize = input->GetMaxCellSize();
+  // the vertex cells, if any, take the second half of the progress
+  vtkSMPProgress<vtkCellCenters> progress(
+    this, this->VertexCells ? 2*numCells : numCells);
+  functor.Progress = &progress;
+  // Only the data sets known to implement a thread-safe GetCell(id, cell)
+  // are processed in parallel.
+  vtkIdType grain = VTK_CELL_CENTERS_GRAIN;
+  if (!input->IsA("vtkPolyData") && !input->IsA("vtkUnstructuredGrid") &&
+      !input->IsA("vtkImageData") && !input->IsA("vtkRectilinearGrid") &&
+      !input->IsA("vtkStructuredGrid"))
     {
-    if ( ! (cellId % progressInterval) ) 
-      {
-      vtkDebugMacro(<<"Processing #" << cellId);
-      this->UpdateProgress (0.5*cellId/numCells);
-      abort = this->GetAbortExecute();
-      }
-
-    cell = input->GetCell(cellId);
-    if (cell->GetCellType() != VTK_EMPTY_CELL)
-      {
-      subId = cell->GetParametricCenter(pcoords);
-      cell->EvaluateLocation(subId, pcoords, x, weights);
-      newPts->SetPoint(cellId,x);
-      }
-    else
-      {
-      hasEmptyCells = 1;
-      }
+    grain = numCells;
     }
+  vtkSMPTools::Reduce(0, numCells, grain, functor);
+  int hasEmptyCells = functor.AnyEmptyCells;
+  int abort = this->GetAbortExecute();
+  vtkIdType progressInterval = numCells/10 + 1;
+  vtkIdType cellId;
 
   if ( this->VertexCells )
     {
@@ -115,8 +193,7 @@ int vtkCellCenters::RequestData(
         abort = this->GetAbortExecute();
         }
 
-      cell = input->GetCell(cellId);
-      if (cell->GetCellType() != VTK_EMPTY_CELL)
+      if (input->GetCellType(cellId) != VTK_EMPTY_CELL)
         {
         pts[0] = cellId;
         verts->InsertNextCell(1,pts);
@@ -139,10 +216,6 @@ int vtkCellCenters::RequestData(
     {
     outPD->PassData(inCD); //because number of points = number of cells
     }
-  if (weights)
-    {
-    delete [] weights;
-    }
 
   return 1;
 }
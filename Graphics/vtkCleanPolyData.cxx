@@ -22,9 +22,12 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkIncrementalPointLocator.h"
 
+#include <vtkstd/vector>
+
 vtkCxxRevisionMacro(vtkCleanPolyData, "$Revision$");
 vtkStandardNewMacro(vtkCleanPolyData);
 
@@ -46,6 +49,7 @@ vtkCleanPolyData::vtkCleanPolyData()
   this->ConvertStripsToPolys = 1;
   this->Locator = NULL;
   this->PieceInvariant = 1;
+  this->UseThreadPool = 0;
 }
 
 //--------------------------------------------------------------------------
@@ -177,7 +181,9 @@ int vtkCleanPolyData::RequestData(
   vtkIdType *pts = 0;
   double x[3];
   double newx[3];
-  vtkIdType *pointMap=0; //used if no merging
+  vtkIdType *pointMap=0; //used if no merging or merging by sorting
+  vtkIdType *mergeMap=0; //used if merging by sorting
+  vtkIdType mergeId;
 
   vtkCellArray *inVerts  = input->GetVerts(),  *newVerts  = NULL;
   vtkCellArray *inLines  = input->GetLines(),  *newLines  = NULL;
@@ -187,9 +193,23 @@ int vtkCleanPolyData::RequestData(
   vtkPointData *inputPD = input->GetPointData();
   vtkCellData  *inputCD = input->GetCellData();
 
+  // Without tolerance, coincident points may be found by sorting them
+  if ( this->PointMerging && this->UseThreadPool &&
+       (this->ToleranceIsAbsolute ? this->AbsoluteTolerance :
+        this->Tolerance*input->GetLength()) == 0.0 &&
+       (!this->Locator || this->Locator->IsA("vtkMergePoints")) )
+    {
+    mergeMap = new vtkIdType [numPts];
+    if ( !this->BuildMergeMap(input, newPts->GetDataType(), mergeMap) )
+      {
+      delete [] mergeMap;
+      mergeMap = 0;
+      }
+    }
+
   // We must be careful to 'operate' on the bounds of the locator so
   // that all inserted points lie inside it
-  if ( this->PointMerging )
+  if ( this->PointMerging && !mergeMap )
     {
     this->CreateDefaultLocator(input);
     if (this->ToleranceIsAbsolute) 
@@ -248,11 +268,12 @@ int vtkCleanPolyData::RequestData(
         {
         inPts->GetPoint(pts[i],x);
         this->OperateOnPoint(x, newx);
-        if ( ! this->PointMerging )
+        if ( ! this->PointMerging || mergeMap )
           {
-          if ( (ptId=pointMap[pts[i]]) == -1 )
+          mergeId = (mergeMap ? mergeMap[pts[i]] : pts[i]);
+          if ( (ptId=pointMap[mergeId]) == -1 )
             {
-            pointMap[pts[i]] = ptId = numUsedPts++;
+            pointMap[mergeId] = ptId = numUsedPts++;
             newPts->SetPoint(ptId,newx);
             outputPD->CopyData(inputPD,pts[i],ptId);
             }
@@ -293,11 +314,12 @@ int vtkCleanPolyData::RequestData(
         {
         inPts->GetPoint(pts[i],x);
         this->OperateOnPoint(x, newx);
-        if ( ! this->PointMerging )
+        if ( ! this->PointMerging || mergeMap )
           {
-          if ( (ptId=pointMap[pts[i]]) == -1 )
+          mergeId = (mergeMap ? mergeMap[pts[i]] : pts[i]);
+          if ( (ptId=pointMap[mergeId]) == -1 )
             {
-            pointMap[pts[i]] = ptId = numUsedPts++;
+            pointMap[mergeId] = ptId = numUsedPts++;
             newPts->SetPoint(ptId,newx);
             outputPD->CopyData(inputPD,pts[i],ptId);
             }
@@ -359,11 +381,12 @@ int vtkCleanPolyData::RequestData(
         {
         inPts->GetPoint(pts[i],x);
         this->OperateOnPoint(x, newx);
-        if ( ! this->PointMerging )
+        if ( ! this->PointMerging || mergeMap )
           {
-          if ( (ptId=pointMap[pts[i]]) == -1 )
+          mergeId = (mergeMap ? mergeMap[pts[i]] : pts[i]);
+          if ( (ptId=pointMap[mergeId]) == -1 )
             {
-            pointMap[pts[i]] = ptId = numUsedPts++;
+            pointMap[mergeId] = ptId = numUsedPts++;
             newPts->SetPoint(ptId,newx);
             outputPD->CopyData(inputPD,pts[i],ptId);
             }
@@ -445,11 +468,12 @@ int vtkCleanPolyData::RequestData(
         {
         inPts->GetPoint(pts[i],x);
         this->OperateOnPoint(x, newx);
-        if ( ! this->PointMerging )
+        if ( ! this->PointMerging || mergeMap )
           {
-          if ( (ptId=pointMap[pts[i]]) == -1 )
+          mergeId = (mergeMap ? mergeMap[pts[i]] : pts[i]);
+          if ( (ptId=pointMap[mergeId]) == -1 )
             {
-            pointMap[pts[i]] = ptId = numUsedPts++;
+            pointMap[mergeId] = ptId = numUsedPts++;
             newPts->SetPoint(ptId,newx);
             outputPD->CopyData(inputPD,pts[i],ptId);
             }
@@ -534,7 +558,7 @@ int vtkCleanPolyData::RequestData(
   // Update ourselves and release memory
   //
   delete [] updatedPts;
-  if ( this->PointMerging )
+  if ( this->PointMerging && !mergeMap )
     {
     this->Locator->Initialize(); //release memory.
     }
@@ -542,6 +566,7 @@ int vtkCleanPolyData::RequestData(
     {
     newPts->SetNumberOfPoints(numUsedPts);
     delete [] pointMap;
+    delete [] mergeMap;
     }
 
   // Now transfer all CellData from Lines/Polys/Strips into final
@@ -603,6 +628,138 @@ int vtkCleanPolyData::RequestData(
   return 1;
 }
 
+//--------------------------------------------------------------------------
+// A point once operated on, with its Morton key. Sorting by key and then
+// by coordinates brings coincident points together, in increasing id
+// order since the sort is stable.
+struct vtkCleanPolyDataTuple
+{
+  vtkTypeUInt64 Key;
+  double X[3];
+  vtkIdType PtId;
+
+  bool operator<(const vtkCleanPolyDataTuple& tuple) const
+    {
+    if ( this->Key != tuple.Key )
+      {
+      return this->Key < tuple.Key;
+      }
+    if ( this->X[0] != tuple.X[0] )
+      {
+      return this->X[0] < tuple.X[0];
+      }
+    if ( this->X[1] != tuple.X[1] )
+      {
+      return this->X[1] < tuple.X[1];
+      }
+    return this->X[2] < tuple.X[2];
+    }
+};
+
+// Number of bits of each quantized coordinate in the Morton key.
+#define VTK_CLEAN_POLY_DATA_KEY_BITS 21
+
+//--------------------------------------------------------------------------
+// Quantize the coordinates over the bounds and interleave their bits.
+class vtkCleanPolyDataKeys
+{
+public:
+  vtkCleanPolyDataTuple *Tuples;
+  double Origin[3];
+  double Scale[3];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    const double maxCoord = (1 << VTK_CLEAN_POLY_DATA_KEY_BITS) - 1;
+    vtkTypeUInt64 q[3];
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      vtkCleanPolyDataTuple& tuple = this->Tuples[ptId];
+      int i, b;
+      for (i = 0; i < 3; i++)
+        {
+        double c = (tuple.X[i] - this->Origin[i]) * this->Scale[i];
+        c = (c >= 0.0 ? (c <= maxCoord ? c : maxCoord) : 0.0);
+        q[i] = static_cast<vtkTypeUInt64>(c);
+        }
+      tuple.Key = 0;
+      for (b = 0; b < VTK_CLEAN_POLY_DATA_KEY_BITS; b++)
+        {
+        for (i = 0; i < 3; i++)
+          {
+          tuple.Key |= ((q[i] >> b) & 1) << (3*b + i);
+          }
+        }
+      }
+    }
+};
+
+//--------------------------------------------------------------------------
+// Points are merged when they are equal once converted to the type of the
+// output points, as vtkMergePoints does.
+int vtkCleanPolyData::BuildMergeMap(vtkPolyData *input, int dataType,
+                                    vtkIdType *mergeMap)
+{
+  if ( dataType != VTK_FLOAT && dataType != VTK_DOUBLE )
+    {
+    return 0;
+    }
+
+  vtkIdType ptId, numPts = input->GetNumberOfPoints();
+  vtkstd::vector<vtkCleanPolyDataTuple> tuples(numPts);
+  double x[3], bounds[6];
+  int i;
+  for (ptId=0; ptId < numPts; ptId++)
+    {
+    vtkCleanPolyDataTuple& tuple = tuples[ptId];
+    input->GetPoint(ptId, x);
+    this->OperateOnPoint(x, tuple.X);
+    tuple.PtId = ptId;
+    for (i=0; i < 3; i++)
+      {
+      if ( dataType == VTK_FLOAT )
+        {
+        tuple.X[i] = static_cast<float>(tuple.X[i]);
+        }
+      if ( ptId == 0 || tuple.X[i] < bounds[2*i] )
+        {
+        bounds[2*i] = tuple.X[i];
+        }
+      if ( ptId == 0 || tuple.X[i] > bounds[2*i+1] )
+        {
+        bounds[2*i+1] = tuple.X[i];
+        }
+      }
+    }
+
+  vtkCleanPolyDataKeys keys;
+  keys.Tuples = &tuples[0];
+  for (i=0; i < 3; i++)
+    {
+    keys.Origin[i] = bounds[2*i];
+    keys.Scale[i] = (bounds[2*i+1] > bounds[2*i] ?
+                     ((1 << VTK_CLEAN_POLY_DATA_KEY_BITS) - 1) /
+                     (bounds[2*i+1] - bounds[2*i]) : 0.0);
+    }
+  vtkSMPTools::For(0, numPts, keys);
+  vtkSMPTools::Sort(&tuples[0], &tuples[0] + numPts);
+
+  // Map each run of coincident points to its first point.
+  vtkIdType first = 0;
+  for (ptId=0; ptId < numPts; ptId++)
+    {
+    const double *y = tuples[ptId].X;
+    const double *z = tuples[first].X;
+    if ( y[0] != z[0] || y[1] != z[1] || y[2] != z[2] )
+      {
+      first = ptId;
+      }
+    mergeMap[tuples[ptId].PtId] = tuples[first].PtId;
+    }
+
+  return 1;
+}
+
 //--------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
@@ -682,6 +839,8 @@ void vtkCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
     }
   os << indent << "PieceInvariant: "
      << (this->PieceInvariant ? "On\n" : "Off\n");
+  os << indent << "Use Thread Pool: "
+     << (this->UseThreadPool ? "On\n" : "Off\n");
 }
 
 //--------------------------------------------------------------------------
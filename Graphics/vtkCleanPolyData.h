@@ -43,6 +43,15 @@
 // Note that merging of points can be disabled. In this case, a point locator
 // will not be used, and points that are not used by any cells will be
 // eliminated, but never merged.
+//
+// When UseThreadPool is on and the tolerance is zero, the points are not
+// inserted in the locator. Instead, the points given by OperateOnPoint are
+// sorted in parallel on the workers of the vtkThreadPool, by a Morton key
+// computed from their coordinates quantized over the bounds, and the
+// groups of coincident points are found in one pass over the sorted
+// points. The output is identical to the one obtained with vtkMergePoints.
+// This mode requires float or double points and is not used when a
+// locator other than vtkMergePoints was set.
 
 // .SECTION Caveats
 // Merging points can alter topology, including introducing non-manifold
@@ -148,6 +157,13 @@ public:
   vtkGetMacro(PieceInvariant, int);
   vtkBooleanMacro(PieceInvariant, int);
 
+  // Description:
+  // Merge coincident points by a parallel sort instead of a locator when
+  // the tolerance is zero. Off by default.
+  vtkSetMacro(UseThreadPool,int);
+  vtkGetMacro(UseThreadPool,int);
+  vtkBooleanMacro(UseThreadPool,int);
+
 protected:
   vtkCleanPolyData();
  ~vtkCleanPolyData();
@@ -167,6 +183,14 @@ protected:
   vtkIncrementalPointLocator *Locator;
 
   int PieceInvariant;
+  int UseThreadPool;
+
+  // Description:
+  // Return in mergeMap, for every input point, the smallest id of the
+  // points that coincide with it once operated on. Return 0 when the
+  // points cannot be merged this way.
+  int BuildMergeMap(vtkPolyData *input, int dataType, vtkIdType *mergeMap);
+
 private:
   vtkCleanPolyData(const vtkCleanPolyData&);  // Not implemented.
   void operator=(const vtkCleanPolyData&);  // Not implemented.
@@ -19,12 +19,18 @@
 #include "vtkCellData.h"
 #include "vtkContourValues.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkSimpleScalarTree.h"
+#include "vtkSMPTools.h"
+#include "vtkSOADoubleArray.h"
+#include "vtkSOAFloatArray.h"
+#include "vtkTetra.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkCutter.h"
 #include "vtkMergePoints.h"
@@ -33,6 +39,8 @@
 
 #include <math.h>
 
+#include <vtkstd/vector>
+
 vtkCxxRevisionMacro(vtkContourGrid, "$Revision$");
 vtkStandardNewMacro(vtkContourGrid);
 
@@ -51,6 +59,8 @@ vtkContourGrid::vtkContourGrid()
   this->UseScalarTree = 0;
   this->ScalarTree = NULL;
 
+  this->UseThreadPool = 0;
+
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
                                vtkDataSetAttributes::SCALARS);
@@ -319,6 +329,560 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
   output->Squeeze();
 }
 
+//----------------------------------------------------------------------------
+// Threaded contouring of tetrahedral grids. The cells are processed in
+// chunks of fixed size so that the output does not depend on the number
+// of threads. Every triangle vertex ("slot") gets an edge key; keys are
+// sorted to find the slots that share a point, and points are numbered in
+// the order of their first slot, as the locator of the serial path does.
+#define VTK_CONTOUR_GRID_CHUNK_SIZE 4096
+
+// The key of a triangle vertex: the mesh edge (V0 has the lower scalar)
+// or, when the contour goes through a mesh vertex, V0 == V1 == vertex.
+struct vtkContourGridEdge
+{
+  vtkIdType V0;
+  vtkIdType V1;
+  vtkIdType Slot;
+  int Value;
+
+  bool operator<(const vtkContourGridEdge& other) const
+    {
+    if (this->Value != other.Value)
+      {
+      return this->Value < other.Value;
+      }
+    if (this->V0 != other.V0)
+      {
+      return this->V0 < other.V0;
+      }
+    return this->V1 < other.V1;
+    }
+  bool SameKey(const vtkContourGridEdge& other) const
+    {
+    return this->Value == other.Value && this->V0 == other.V0 &&
+      this->V1 == other.V1;
+    }
+};
+
+// Data shared by the passes.
+template <class T>
+class vtkContourGridTetras
+{
+public:
+  T *Scalars;
+  vtkIdType ScalarStride;
+  vtkCellArray *Cells;
+  vtkIdType NumberOfCells;
+  double *Values;
+  int NumberOfValues;
+  vtkPoints *InPoints;
+  vtkPointData *InPd;
+  vtkCellData *InCd;
+
+  // Intermediate results.
+  vtkstd::vector<vtkIdType> ChunkOffsets; // first triangle of each chunk
+  vtkstd::vector<vtkIdType> TriangleCells;
+  vtkstd::vector<vtkContourGridEdge> Edges;
+  vtkstd::vector<vtkIdType> SlotPoints;
+  vtkstd::vector<vtkIdType> SlotOffsets; // first point of each slot chunk
+  vtkstd::vector<vtkIdType> PolyOffsets; // first polygon of each chunk
+
+  // Output.
+  vtkPoints *OutPoints;
+  vtkPointData *OutPd;
+  vtkIdType *Polys;
+  vtkCellData *OutCd;
+
+  int NumberOfTriangles[16];
+
+  vtkContourGridTetras()
+    {
+    for (int c = 0; c < 16; c++)
+      {
+      int *edge = vtkTetra::GetTriangleCases(c);
+      for (this->NumberOfTriangles[c] = 0; edge[0] > -1; edge += 3)
+        {
+        this->NumberOfTriangles[c]++;
+        }
+      }
+    }
+
+  vtkIdType GetNumberOfChunks()
+    {
+    return (this->NumberOfCells + VTK_CONTOUR_GRID_CHUNK_SIZE - 1) /
+      VTK_CONTOUR_GRID_CHUNK_SIZE;
+    }
+
+  double GetScalar(vtkIdType ptId)
+    {
+    return static_cast<double>(this->Scalars[ptId * this->ScalarStride]);
+    }
+
+  // Same classification as vtkTetra::Contour().
+  int GetCase(const vtkIdType *pts, double value, double s[4])
+    {
+    int index = 0;
+    for (int i = 0; i < 4; i++)
+      {
+      s[i] = this->GetScalar(pts[i]);
+      if (s[i] >= value)
+        {
+        index |= (1 << i);
+        }
+      }
+    return index;
+    }
+};
+
+// Count the triangles of every chunk of cells.
+template <class T>
+class vtkContourGridCountFunctor
+{
+public:
+  vtkContourGridTetras<T> *Tetras;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkContourGridTetras<T> *tetras = this->Tetras;
+    vtkIdList *ptIds = vtkIdList::New();
+    vtkCellArrayCursor cursor;
+    vtkIdType npts;
+    const vtkIdType *pts;
+    double s[4];
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+      {
+      vtkIdType cellId = chunk * VTK_CONTOUR_GRID_CHUNK_SIZE;
+      vtkIdType lastCell = cellId + VTK_CONTOUR_GRID_CHUNK_SIZE;
+      lastCell = (lastCell < tetras->NumberOfCells ?
+                  lastCell : tetras->NumberOfCells);
+      vtkIdType numTris = 0;
+      tetras->Cells->InitTraversal(cursor, cellId);
+      for ( ; cellId < lastCell; cellId++)
+        {
+        tetras->Cells->GetNextCell(cursor, npts, pts, ptIds);
+        for (int v = 0; v < tetras->NumberOfValues; v++)
+          {
+          numTris += tetras->NumberOfTriangles[
+            tetras->GetCase(pts, tetras->Values[v], s)];
+          }
+        }
+      tetras->ChunkOffsets[chunk + 1] = numTris;
+      }
+    ptIds->Delete();
+    }
+};
+
+// Write the triangles of every chunk of cells as edge keys.
+template <class T>
+class vtkContourGridEdgeFunctor
+{
+public:
+  vtkContourGridTetras<T> *Tetras;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkContourGridTetras<T> *tetras = this->Tetras;
+    vtkIdList *ptIds = vtkIdList::New();
+    vtkCellArrayCursor cursor;
+    vtkIdType npts;
+    const vtkIdType *pts;
+    double s[4];
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+      {
+      vtkIdType cellId = chunk * VTK_CONTOUR_GRID_CHUNK_SIZE;
+      vtkIdType lastCell = cellId + VTK_CONTOUR_GRID_CHUNK_SIZE;
+      lastCell = (lastCell < tetras->NumberOfCells ?
+                  lastCell : tetras->NumberOfCells);
+      vtkIdType tri = tetras->ChunkOffsets[chunk];
+      tetras->Cells->InitTraversal(cursor, cellId);
+      for ( ; cellId < lastCell; cellId++)
+        {
+        tetras->Cells->GetNextCell(cursor, npts, pts, ptIds);
+        for (int v = 0; v < tetras->NumberOfValues; v++)
+          {
+          double value = tetras->Values[v];
+          int *edge = vtkTetra::GetTriangleCases(
+            tetras->GetCase(pts, value, s));
+          for ( ; edge[0] > -1; edge += 3, tri++)
+            {
+            tetras->TriangleCells[tri] = cellId;
+            for (int i = 0; i < 3; i++)
+              {
+              int *vert = vtkTetra::GetEdgeArray(edge[i]);
+              int v1 = vert[0], v2 = vert[1];
+              if (s[vert[1]] - s[vert[0]] <= 0)
+                {
+                v1 = vert[1]; v2 = vert[0];
+                }
+              vtkContourGridEdge& key = tetras->Edges[3*tri + i];
+              key.Value = v;
+              key.Slot = 3*tri + i;
+              key.V0 = (s[v2] == value ? pts[v2] : pts[v1]);
+              key.V1 = pts[v2];
+              }
+            }
+          }
+        }
+      }
+    ptIds->Delete();
+    }
+};
+
+// Mark the slots that come first in their group of equal keys, and count
+// them per chunk of slots.
+template <class T>
+class vtkContourGridMarkFunctor
+{
+public:
+  vtkContourGridTetras<T> *Tetras;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkContourGridTetras<T> *tetras = this->Tetras;
+    vtkIdType numSlots = static_cast<vtkIdType>(tetras->Edges.size());
+    for (vtkIdType i = begin * VTK_CONTOUR_GRID_CHUNK_SIZE;
+         i < end * VTK_CONTOUR_GRID_CHUNK_SIZE && i < numSlots; i++)
+      {
+      const vtkContourGridEdge& key = tetras->Edges[i];
+      tetras->SlotPoints[key.Slot] =
+        (i == 0 || !tetras->Edges[i-1].SameKey(key) ? 1 : 0);
+      }
+    }
+};
+
+// Number the first slots in slot order.
+template <class T>
+class vtkContourGridNumberFunctor
+{
+public:
+  vtkContourGridTetras<T> *Tetras;
+  int Count;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkContourGridTetras<T> *tetras = this->Tetras;
+    vtkIdType numSlots = static_cast<vtkIdType>(tetras->SlotPoints.size());
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+      {
+      vtkIdType slot = chunk * VTK_CONTOUR_GRID_CHUNK_SIZE;
+      vtkIdType lastSlot = slot + VTK_CONTOUR_GRID_CHUNK_SIZE;
+      lastSlot = (lastSlot < numSlots ? lastSlot : numSlots);
+      vtkIdType ptId = (this->Count ? 0 : tetras->SlotOffsets[chunk]);
+      for ( ; slot < lastSlot; slot++)
+        {
+        if (tetras->SlotPoints[slot])
+          {
+          if (!this->Count)
+            {
+            tetras->SlotPoints[slot] = ptId;
+            }
+          ptId++;
+          }
+        }
+      if (this->Count)
+        {
+        tetras->SlotOffsets[chunk + 1] = ptId;
+        }
+      }
+    }
+};
+
+// Create the points of the first slots and give the other slots the id of
+// the point of their group.
+template <class T>
+class vtkContourGridPointFunctor
+{
+public:
+  vtkContourGridTetras<T> *Tetras;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkContourGridTetras<T> *tetras = this->Tetras;
+    vtkContourGridEdge *edges = &tetras->Edges[0];
+    vtkIdType numSlots = static_cast<vtkIdType>(tetras->Edges.size());
+    vtkIdType first = begin * VTK_CONTOUR_GRID_CHUNK_SIZE;
+    vtkIdType last = end * VTK_CONTOUR_GRID_CHUNK_SIZE;
+    last = (last < numSlots ? last : numSlots);
+
+    // the group of the first key may start in a previous chunk
+    vtkIdType group = first;
+    while (group > 0 && edges[group-1].SameKey(edges[group]))
+      {
+      group--;
+      }
+    double x1[3], x2[3], x[3];
+    for (vtkIdType i = first; i < last; i++)
+      {
+      if (!edges[group].SameKey(edges[i]))
+        {
+        group = i;
+        }
+      vtkIdType ptId = tetras->SlotPoints[edges[group].Slot];
+      if (group != i)
+        {
+        tetras->SlotPoints[edges[i].Slot] = ptId;
+        continue;
+        }
+
+      // Same expression as vtkTetra::Contour(), so that the points are
+      // bit-identical to the serial ones. A point on a vertex is the
+      // vertex itself.
+      const vtkContourGridEdge& key = edges[i];
+      double t = 1.0;
+      if (key.V0 != key.V1)
+        {
+        double s1 = tetras->GetScalar(key.V0);
+        double deltaScalar = tetras->GetScalar(key.V1) - s1;
+        t = (tetras->Values[key.Value] - s1) / deltaScalar;
+        tetras->InPoints->GetPoint(key.V0, x1);
+        tetras->InPoints->GetPoint(key.V1, x2);
+        for (int j = 0; j < 3; j++)
+          {
+          x[j] = x1[j] + t * (x2[j] - x1[j]);
+          }
+        }
+      else
+        {
+        tetras->InPoints->GetPoint(key.V0, x);
+        }
+      tetras->OutPoints->SetPoint(ptId, x);
+      tetras->OutPd->InterpolateEdge(tetras->InPd, ptId, key.V0, key.V1, t);
+      }
+    }
+};
+
+// Count or write the non degenerate triangles of every chunk of cells.
+template <class T>
+class vtkContourGridPolyFunctor
+{
+public:
+  vtkContourGridTetras<T> *Tetras;
+  int Count;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkContourGridTetras<T> *tetras = this->Tetras;
+    vtkIdType *slotPoints = &tetras->SlotPoints[0];
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+      {
+      vtkIdType polyId = (this->Count ? 0 : tetras->PolyOffsets[chunk]);
+      for (vtkIdType tri = tetras->ChunkOffsets[chunk];
+           tri < tetras->ChunkOffsets[chunk + 1]; tri++)
+        {
+        vtkIdType *pts = slotPoints + 3*tri;
+        if (pts[0] == pts[1] || pts[0] == pts[2] || pts[1] == pts[2])
+          {
+          continue;
+          }
+        if (!this->Count)
+          {
+          vtkIdType *poly = tetras->Polys + 4*polyId;
+          poly[0] = 3;
+          poly[1] = pts[0];
+          poly[2] = pts[1];
+          poly[3] = pts[2];
+          tetras->OutCd->CopyData(tetras->InCd, tetras->TriangleCells[tri],
+                                  polyId);
+          }
+        polyId++;
+        }
+      if (this->Count)
+        {
+        tetras->PolyOffsets[chunk + 1] = polyId;
+        }
+      }
+    }
+};
+
+// Turn per chunk counts (stored at index chunk+1) into offsets.
+static void vtkContourGridPrefixSum(vtkstd::vector<vtkIdType>& offsets)
+{
+  offsets[0] = 0;
+  for (size_t i = 1; i < offsets.size(); i++)
+    {
+    offsets[i] += offsets[i-1];
+    }
+}
+
+// Set the number of tuples of all the arrays.
+static void vtkContourGridResize(vtkFieldData *fd, vtkIdType num)
+{
+  for (int i = 0; i < fd->GetNumberOfArrays(); i++)
+    {
+    fd->GetAbstractArray(i)->SetNumberOfTuples(num);
+    }
+}
+
+template <class T>
+void vtkContourGridExecuteTetras(vtkContourGrid *self,
+                                 vtkUnstructuredGrid *input,
+                                 vtkPolyData *output,
+                                 T *scalarArrayPtr, vtkIdType scalarStride,
+                                 int numContours, double *values,
+                                 int computeScalars)
+{
+  vtkContourGridTetras<T> tetras;
+  tetras.Scalars = scalarArrayPtr;
+  tetras.ScalarStride = scalarStride;
+  tetras.Cells = input->GetCells();
+  tetras.NumberOfCells = input->GetNumberOfCells();
+  tetras.Values = values;
+  tetras.NumberOfValues = numContours;
+  tetras.InPoints = input->GetPoints();
+  tetras.InPd = input->GetPointData();
+  tetras.InCd = input->GetCellData();
+
+  // Place a cursor on the last cell from this thread: this completes the
+  // lazy initialization of the cell array, which the threads then only
+  // read.
+  vtkCellArrayCursor cursor;
+  tetras.Cells->InitTraversal(cursor, tetras.NumberOfCells - 1);
+
+  // Count the triangles, then write their edge keys.
+  vtkIdType numChunks = tetras.GetNumberOfChunks();
+  tetras.ChunkOffsets.resize(numChunks + 1);
+  vtkContourGridCountFunctor<T> count;
+  count.Tetras = &tetras;
+  vtkSMPTools::For(0, numChunks, 1, count);
+  vtkContourGridPrefixSum(tetras.ChunkOffsets);
+  vtkIdType numTris = tetras.ChunkOffsets[numChunks];
+  self->UpdateProgress(0.2);
+  if (numTris == 0 || self->GetAbortExecute())
+    {
+    return;
+    }
+
+  tetras.TriangleCells.resize(numTris);
+  tetras.Edges.resize(3*numTris);
+  vtkContourGridEdgeFunctor<T> edges;
+  edges.Tetras = &tetras;
+  vtkSMPTools::For(0, numChunks, 1, edges);
+  self->UpdateProgress(0.4);
+  if (self->GetAbortExecute())
+    {
+    return;
+    }
+
+  // Sort the keys and number the points in the order of their first slot.
+  vtkSMPTools::Sort(&tetras.Edges[0], &tetras.Edges[0] + 3*numTris);
+  self->UpdateProgress(0.6);
+  if (self->GetAbortExecute())
+    {
+    return;
+    }
+
+  vtkIdType numSlotChunks = (3*numTris + VTK_CONTOUR_GRID_CHUNK_SIZE - 1) /
+    VTK_CONTOUR_GRID_CHUNK_SIZE;
+  tetras.SlotPoints.resize(3*numTris);
+  tetras.SlotOffsets.resize(numSlotChunks + 1);
+  vtkContourGridMarkFunctor<T> mark;
+  mark.Tetras = &tetras;
+  vtkSMPTools::For(0, numSlotChunks, 1, mark);
+  vtkContourGridNumberFunctor<T> number;
+  number.Tetras = &tetras;
+  number.Count = 1;
+  vtkSMPTools::For(0, numSlotChunks, 1, number);
+  vtkContourGridPrefixSum(tetras.SlotOffsets);
+  number.Count = 0;
+  vtkSMPTools::For(0, numSlotChunks, 1, number);
+  vtkIdType numPts = tetras.SlotOffsets[numSlotChunks];
+
+  // Create the points.
+  vtkPointData *outPd = output->GetPointData();
+  if (!computeScalars)
+    {
+    outPd->CopyScalarsOff();
+    }
+  outPd->InterpolateAllocate(tetras.InPd, numPts);
+  vtkContourGridResize(outPd, numPts);
+  vtkPoints *newPts = vtkPoints::New();
+  newPts->SetNumberOfPoints(numPts);
+  tetras.OutPoints = newPts;
+  tetras.OutPd = outPd;
+  vtkContourGridPointFunctor<T> points;
+  points.Tetras = &tetras;
+  vtkSMPTools::For(0, numSlotChunks, 1, points);
+  output->SetPoints(newPts);
+  newPts->Delete();
+  self->UpdateProgress(0.8);
+  if (self->GetAbortExecute())
+    {
+    return;
+    }
+
+  // Create the triangles, skipping the degenerate ones.
+  tetras.PolyOffsets.resize(numChunks + 1);
+  vtkContourGridPolyFunctor<T> polys;
+  polys.Tetras = &tetras;
+  polys.Count = 1;
+  vtkSMPTools::For(0, numChunks, 1, polys);
+  vtkContourGridPrefixSum(tetras.PolyOffsets);
+  vtkIdType numPolys = tetras.PolyOffsets[numChunks];
+  if (numPolys == 0)
+    {
+    return;
+    }
+
+  vtkCellData *outCd = output->GetCellData();
+  outCd->CopyAllocate(tetras.InCd, numPolys);
+  vtkContourGridResize(outCd, numPolys);
+  vtkCellArray *newPolys = vtkCellArray::New();
+  tetras.Polys = newPolys->WritePointer(numPolys, 4*numPolys);
+  tetras.OutCd = outCd;
+  polys.Count = 0;
+  vtkSMPTools::For(0, numChunks, 1, polys);
+  output->SetPolys(newPolys);
+  newPolys->Delete();
+}
+
+// Find where the first component of the scalars is stored, without
+// copying an array that stores its components apart. Return 0 if the
+// array does not give access to its memory.
+static int vtkContourGridGetScalars(vtkDataArray *array, void *&ptr,
+                                    vtkIdType &stride)
+{
+  if (array->HasStandardMemoryLayout())
+    {
+    ptr = array->GetVoidPointer(0);
+    stride = array->GetNumberOfComponents();
+    return 1;
+    }
+  vtkSOAFloatArray *floats = vtkSOAFloatArray::SafeDownCast(array);
+  vtkSOADoubleArray *doubles = vtkSOADoubleArray::SafeDownCast(array);
+  if (floats)
+    {
+    ptr = floats->GetComponentPointer(0);
+    stride = floats->GetComponentStride(0);
+    }
+  else if (doubles)
+    {
+    ptr = doubles->GetComponentPointer(0);
+    stride = doubles->GetComponentStride(0);
+    }
+  return (floats || doubles);
+}
+
+// Return 1 if all the cells are tetrahedra.
+static int vtkContourGridIsTetrahedral(vtkUnstructuredGrid *input)
+{
+  vtkUnsignedCharArray *types = input->GetCellTypesArray();
+  if (!types || !input->GetCellLocationsArray())
+    {
+    return 0;
+    }
+  unsigned char *ptr = types->GetPointer(0);
+  vtkIdType numCells = types->GetNumberOfTuples();
+  for (vtkIdType i = 0; i < numCells; i++)
+    {
+    if (ptr[i] != VTK_TETRA)
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
 //
 // Contouring filter for unstructured grids.
 //
@@ -361,6 +925,23 @@ int vtkContourGrid::RequestData(
     return 1;
     }
 
+  vtkIdType scalarStride;
+  if ( this->UseThreadPool && vtkContourGridIsTetrahedral(input) &&
+       vtkContourGridGetScalars(inScalars, scalarArrayPtr, scalarStride) )
+    {
+    switch (inScalars->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkContourGridExecuteTetras(this, input, output,
+                                    static_cast<VTK_TT *>(scalarArrayPtr),
+                                    scalarStride, numContours, values,
+                                    computeScalars));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+      }
+    return 1;
+    }
+
   scalarArrayPtr = inScalars->GetVoidPointer(0);
         
   switch (inScalars->GetDataType())
@@ -427,6 +1008,8 @@ void vtkContourGrid::PrintSelf(ostream& os, vtkIndent indent)
      << (this->ComputeScalars ? "On\n" : "Off\n");
   os << indent << "Use Scalar Tree: " 
      << (this->UseScalarTree ? "On\n" : "Off\n");
+  os << indent << "Use Thread Pool: " 
+     << (this->UseThreadPool ? "On\n" : "Off\n");
 
   this->ContourValues->PrintSelf(os,indent.GetNextIndent());
 
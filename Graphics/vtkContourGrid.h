@@ -32,6 +32,20 @@
 // contours are being extracted. If you want to use a scalar tree,
 // invoke the method UseScalarTreeOn().
 //
+// When UseThreadPool is on and the input contains only tetrahedra, the
+// cells are contoured on the workers of the vtkThreadPool without a
+// point locator. Each intersection point is identified by the mesh edge
+// it lies on (or by the mesh vertex when the contour passes exactly
+// through it), and duplicates are removed by a parallel stable sort of
+// these keys. Points are numbered in the order in which the serial
+// algorithm creates them, so the output does not depend on the number of
+// threads. The Locator and UseScalarTree are ignored in this mode.
+// The points are computed with the serial expression and are identical
+// to the serial ones, with two differences: a point on a vertex is the
+// vertex itself, where the serial path interpolates it along each edge
+// of the vertex and may round it differently; and points are merged by
+// edge, so coincident points of distinct mesh points are not merged.
+//
 
 // .SECTION Caveats
 // For unstructured data or structured grids, normals and gradients
@@ -112,6 +126,13 @@ public:
   vtkGetMacro(UseScalarTree,int);
   vtkBooleanMacro(UseScalarTree,int);
 
+  // Description:
+  // Contour tetrahedral grids in parallel with the vtkThreadPool.
+  // Other grids are always contoured serially. Off by default.
+  vtkSetMacro(UseThreadPool,int);
+  vtkGetMacro(UseThreadPool,int);
+  vtkBooleanMacro(UseThreadPool,int);
+
   // Description:
   // Set / get a spatial locator for merging points. By default, 
   // an instance of vtkMergePoints is used.
@@ -138,6 +159,7 @@ protected:
   int UseScalarTree;
   vtkScalarTree *ScalarTree;
   vtkEdgeTable *EdgeTable;
+  int UseThreadPool;
   
 private:
   vtkContourGrid(const vtkContourGrid&);  // Not implemented.
@@ -17,16 +17,93 @@
 #include "vtkCellData.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
+#include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 
 vtkCxxRevisionMacro(vtkElevationFilter, "$Revision$");
 vtkStandardNewMacro(vtkElevationFilter);
 
+// Points processed by one call of the functor.
+static const vtkIdType VTK_ELEVATION_GRAIN = 10000;
+
+//----------------------------------------------------------------------------
+// Compute the elevation of points [begin, end). Point coordinates are read
+// in a thread-safe way for point sets, image data and rectilinear grids.
+class vtkElevationFunctor
+{
+public:
+  vtkElevationFilter *Filter;
+  vtkSMPProgress<vtkElevationFilter> *Progress;
+  vtkDataSet *Input;
+  vtkDataArray *Points;
+  vtkImageData *Image;
+  float *Scalars;
+  double LowPoint[3];
+  double DiffVector[3];
+  double Length2;
+  double ScalarRange[2];
+
+  void GetPoint(vtkIdType i, double x[3])
+    {
+    if (this->Points)
+      {
+      this->Points->GetTuple(i, x);
+      }
+    else if (this->Image)
+      {
+      // vtkImageData::GetPoint() returns shared storage, compute directly.
+      int *ext = this->Image->GetExtent();
+      double *origin = this->Image->GetOrigin();
+      double *spacing = this->Image->GetSpacing();
+      vtkIdType nx = ext[1] - ext[0] + 1;
+      vtkIdType ny = ext[3] - ext[2] + 1;
+      vtkIdType ij[3] = { i % nx, (i / nx) % ny, i / (nx * ny) };
+      for (int j = 0; j < 3; j++)
+        {
+        x[j] = origin[j] + (ij[j] + ext[2*j]) * spacing[j];
+        }
+      }
+    else
+      {
+      this->Input->GetPoint(i, x);
+      }
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    if (this->Filter->GetAbortExecute())
+      {
+      return;
+      }
+    double diffScalar = this->ScalarRange[1] - this->ScalarRange[0];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      // Project this input point into the 1D system.
+      double x[3];
+      this->GetPoint(i, x);
+      double v[3] = { x[0] - this->LowPoint[0],
+                      x[1] - this->LowPoint[1],
+                      x[2] - this->LowPoint[2] };
+      double s = vtkMath::Dot(v, this->DiffVector) / this->Length2;
+      s = (s < 0.0 ? 0.0 : s > 1.0 ? 1.0 : s);
+
+      // Store the resulting scalar value.
+      this->Scalars[i] =
+        static_cast<float>(this->ScalarRange[0] + s*diffScalar);
+      }
+    this->Progress->Advance(end - begin);
+    }
+};
+
 //----------------------------------------------------------------------------
 vtkElevationFilter::vtkElevationFilter()
 {
@@ -101,35 +178,40 @@ int vtkElevationFilter::RequestData(vtkInformation*,
     length2 = 1.0;
     }
 
-  // Support progress and abort.
-  vtkIdType tenth = (numPts >= 10? numPts/10 : 1);
-  double numPtsInv = 1.0/numPts;
-  int abort = 0;
-
-  // Compute parametric coordinate and map into scalar range.
-  double diffScalar = this->ScalarRange[1] - this->ScalarRange[0];
-  vtkDebugMacro("Generating elevation scalars!");
-  for(vtkIdType i=0; i < numPts && !abort; ++i)
+  // Compute parametric coordinate and map into scalar range. The points
+  // are processed in parallel when their coordinates can be read safely
+  // from several threads.
+  vtkElevationFunctor functor;
+  functor.Filter = this;
+  functor.Input = input;
+  functor.Points = 0;
+  functor.Image = vtkImageData::SafeDownCast(input);
+  functor.Scalars = newScalars->GetPointer(0);
+  functor.Length2 = length2;
+  for (int j = 0; j < 3; j++)
     {
-    // Periodically update progress and check for an abort request.
-    if(i % tenth == 0)
-      {
-      this->UpdateProgress((i+1)*numPtsInv);
-      abort = this->GetAbortExecute();
-      }
-
-    // Project this input point into the 1D system.
-    double x[3];
-    input->GetPoint(i, x);
-    double v[3] = { x[0] - this->LowPoint[0],
-                    x[1] - this->LowPoint[1],
-                    x[2] - this->LowPoint[2] };
-    double s = vtkMath::Dot(v, diffVector) / length2;
-    s = (s < 0.0 ? 0.0 : s > 1.0 ? 1.0 : s);
-
-    // Store the resulting scalar value.
-    newScalars->SetValue(i, this->ScalarRange[0] + s*diffScalar);
+    functor.LowPoint[j] = this->LowPoint[j];
+    functor.DiffVector[j] = diffVector[j];
+    }
+  functor.ScalarRange[0] = this->ScalarRange[0];
+  functor.ScalarRange[1] = this->ScalarRange[1];
+  vtkIdType grain = VTK_ELEVATION_GRAIN;
+  vtkPointSet *ps = vtkPointSet::SafeDownCast(input);
+  if (ps)
+    {
+    functor.Points = ps->GetPoints()->GetData();
     }
+  else if (!functor.Image && !vtkRectilinearGrid::SafeDownCast(input))
+    {
+    grain = numPts;
+    }
+
+  vtkDebugMacro("Generating elevation scalars!");
+  vtkSMPProgress<vtkElevationFilter> progress(this, numPts);
+  functor.Progress = &progress;
+  this->UpdateProgress(0.0);
+  vtkSMPTools::For(0, numPts, grain, functor);
+  this->UpdateProgress(1.0);
 
   // Copy all the input geometry and data to the output.
   output->CopyStructure(input);
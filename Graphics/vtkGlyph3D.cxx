@@ -22,7 +22,9 @@
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -55,6 +57,7 @@ vtkGlyph3D::vtkGlyph3D()
   this->SetPointIdsName("InputPointIds");
   this->SetNumberOfInputPorts(2);
   this->FillCellData = 0;
+  this->GenerateInstances = 0;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
@@ -111,6 +114,8 @@ int vtkGlyph3D::RequestData(
   vtkDataArray *newVectors=NULL;
   vtkDataArray *newNormals=NULL;
   vtkDataArray *newTCoords = NULL;
+  vtkFloatArray *newTransforms = NULL;
+  vtkIntArray *newIndices = NULL;
   double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
   vtkTransform *trans = vtkTransform::New();
   vtkCell *cell;
@@ -285,20 +290,41 @@ int vtkGlyph3D::RequestData(
     
     // Prepare to copy output.
     pd = input->GetPointData();
-    outputPD->CopyAllocate(pd,numPts*numSourcePts);
-    if (this->FillCellData)
+    outputPD->CopyAllocate(pd,numPts*
+                           (this->GenerateInstances ? 1 : numSourcePts));
+    if (this->FillCellData && !this->GenerateInstances)
       {
       outputCD->CopyAllocate(pd,numPts*numSourceCells);
       }
     }
 
+  // An instance is a single output point, whose glyph is transformed at
+  // render time (see vtkGlyphInstanceMapper). The normals and texture
+  // coordinates of the glyph are left in the source.
+  vtkIdType numGlyphPts = numSourcePts;
+  if ( this->GenerateInstances )
+    {
+    numGlyphPts = 1;
+    haveNormals = haveTCoords = 0;
+    newTransforms = vtkFloatArray::New();
+    newTransforms->SetNumberOfComponents(9);
+    newTransforms->Allocate(9*numPts);
+    newTransforms->SetName("GlyphTransform");
+    if ( this->IndexMode != VTK_INDEXING_OFF )
+      {
+      newIndices = vtkIntArray::New();
+      newIndices->Allocate(numPts);
+      newIndices->SetName("GlyphIndex");
+      }
+    }
+
   newPts = vtkPoints::New();
-  newPts->Allocate(numPts*numSourcePts);
+  newPts->Allocate(numPts*numGlyphPts);
   if ( this->GeneratePointIds )
     {
     pointIds = vtkIdTypeArray::New();
     pointIds->SetName(this->PointIdsName);
-    pointIds->Allocate(numPts*numSourcePts);
+    pointIds->Allocate(numPts*numGlyphPts);
     outputPD->AddArray(pointIds);
     pointIds->Delete();
     }
@@ -306,13 +332,13 @@ int vtkGlyph3D::RequestData(
     {
     newScalars = inCScalars->NewInstance();
     newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
-    newScalars->Allocate(inCScalars->GetNumberOfComponents()*numPts*numSourcePts);
+    newScalars->Allocate(inCScalars->GetNumberOfComponents()*numPts*numGlyphPts);
     newScalars->SetName(inCScalars->GetName());
     }
   else if ( (this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
     {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts*numSourcePts);
+    newScalars->Allocate(numPts*numGlyphPts);
     newScalars->SetName("GlyphScale");
     if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
       {
@@ -322,14 +348,14 @@ int vtkGlyph3D::RequestData(
   else if ( (this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
     {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts*numSourcePts);
+    newScalars->Allocate(numPts*numGlyphPts);
     newScalars->SetName("VectorMagnitude");
     }
   if ( haveVectors )
     {
     newVectors = vtkFloatArray::New();
     newVectors->SetNumberOfComponents(3);
-    newVectors->Allocate(3*numPts*numSourcePts);
+    newVectors->Allocate(3*numPts*numGlyphPts);
     newVectors->SetName("GlyphVector");
     }
   if ( haveNormals )
@@ -349,7 +375,11 @@ int vtkGlyph3D::RequestData(
     }
     
   // Setting up for calls to PolyData::InsertNextCell()
-  if (this->IndexMode != VTK_INDEXING_OFF )
+  if ( this->GenerateInstances )
+    {
+    // instances have no cells
+    }
+  else if (this->IndexMode != VTK_INDEXING_OFF )
     {
     output->Allocate(3*numPts*numSourceCells,numPts*numSourceCells);
     }
@@ -451,6 +481,10 @@ int vtkGlyph3D::RequestData(
         sourceNormals = source->GetPointData()->GetNormals();
         numSourcePts = sourcePts->GetNumberOfPoints();
         numSourceCells = source->GetNumberOfCells();
+        if ( !this->GenerateInstances )
+          {
+          numGlyphPts = numSourcePts;
+          }
         }
       }
 
@@ -482,7 +516,8 @@ int vtkGlyph3D::RequestData(
     trans->Identity();
     
     // Copy all topology (transformation independent)
-    for (cellId=0; cellId < numSourceCells; cellId++)
+    for (cellId=0; cellId < numSourceCells && !this->GenerateInstances;
+         cellId++)
       {
       cell = this->GetSource(index, inputVector[1])->GetCell(cellId);
       cellPts = cell->GetPointIds();
@@ -496,12 +531,19 @@ int vtkGlyph3D::RequestData(
     
     // translate Source to Input point
     input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
+    if ( this->GenerateInstances )
+      {
+      newPts->InsertNextPoint(x);
+      }
+    else
+      {
+      trans->Translate(x[0], x[1], x[2]);
+      }
     
     if ( haveVectors )
       {
       // Copy Input vector
-      for (i=0; i < numSourcePts; i++) 
+      for (i=0; i < numGlyphPts; i++) 
         {
         newVectors->InsertTuple(i+ptIncr, v);
         }
@@ -538,21 +580,21 @@ int vtkGlyph3D::RequestData(
     // Copy scalar value
     if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
       {
-      for (i=0; i < numSourcePts; i++)
+      for (i=0; i < numGlyphPts; i++)
         {
         newScalars->InsertTuple(i+ptIncr, &scalex); // = scaley = scalez
         }
       }
     else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
       {
-      for (i=0; i < numSourcePts; i++)
+      for (i=0; i < numGlyphPts; i++)
         {
         outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr+i);
         }
       }
     if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
       {
-      for (i=0; i < numSourcePts; i++) 
+      for (i=0; i < numGlyphPts; i++) 
         {
         newScalars->InsertTuple(i+ptIncr, &vMag);
         }
@@ -587,8 +629,25 @@ int vtkGlyph3D::RequestData(
       trans->Scale(scalex,scaley,scalez);
       }
     
-    // multiply points and normals by resulting matrix
-    trans->TransformPoints(sourcePts,newPts);
+    // multiply points and normals by resulting matrix, or keep the
+    // matrix of the instance
+    if ( this->GenerateInstances )
+      {
+      double m[9];
+      for (i=0; i < 9; i++)
+        {
+        m[i] = trans->GetMatrix()->GetElement(i/3, i%3);
+        }
+      newTransforms->InsertNextTuple(m);
+      if ( newIndices )
+        {
+        newIndices->InsertNextValue(index);
+        }
+      }
+    else
+      {
+      trans->TransformPoints(sourcePts,newPts);
+      }
     
     if ( haveNormals )
       {
@@ -598,11 +657,11 @@ int vtkGlyph3D::RequestData(
     // Copy point data from source (if possible)
     if ( pd ) 
       {
-      for (i=0; i < numSourcePts; i++)
+      for (i=0; i < numGlyphPts; i++)
         {
         outputPD->CopyData(pd,inPtId,ptIncr+i);
         }
-      if (this->FillCellData)
+      if (this->FillCellData && !this->GenerateInstances)
         {
         for (i=0; i < numSourceCells; i++)
           {
@@ -614,13 +673,13 @@ int vtkGlyph3D::RequestData(
     // If point ids are to be generated, do it here
     if ( this->GeneratePointIds )
       {
-      for (i=0; i < numSourcePts; i++)
+      for (i=0; i < numGlyphPts; i++)
         {
         pointIds->InsertNextValue(inPtId);
         }
       }
 
-    ptIncr += numSourcePts;
+    ptIncr += numGlyphPts;
     cellIncr += numSourceCells;
     } 
   
@@ -653,6 +712,18 @@ int vtkGlyph3D::RequestData(
     outputPD->SetTCoords(newTCoords);
     newTCoords->Delete();
     }
+
+  if (newTransforms)
+    {
+    outputPD->AddArray(newTransforms);
+    newTransforms->Delete();
+    }
+
+  if (newIndices)
+    {
+    outputPD->AddArray(newIndices);
+    newIndices->Delete();
+    }
   
   output->Squeeze();
   trans->Delete();
@@ -802,6 +873,8 @@ void vtkGlyph3D::PrintSelf(ostream& os, vtkIndent indent)
     }
 
   os << indent << "Fill Cell Data: " << (this->FillCellData ? "On\n" : "Off\n");
+  os << indent << "Generate Instances: "
+     << (this->GenerateInstances ? "On\n" : "Off\n");
 }
 
 int vtkGlyph3D::RequestUpdateExtent(
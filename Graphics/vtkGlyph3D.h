@@ -65,9 +65,18 @@
 // color scalars by using the SetInputArrayToProcess methods in
 // vtkAlgorithm. The first array is scalars, the next vectors, the next
 // normals and finally color scalars.
+//
+// When GenerateInstances is on, the glyph geometry is not copied. The output
+// has one point per glyph, at the input point, and no cells. The 3x3 matrix
+// that orients and scales the glyph is stored row by row in the 9 component
+// point data array "GlyphTransform", and the index into the glyph table in
+// "GlyphIndex" when indexing is on. Render the instances with
+// vtkGlyphInstanceMapper, which transforms the glyphs at render time; the
+// memory used then grows with the number of glyphs instead of the number of
+// glyphs times the number of points per glyph.
 
 // .SECTION See Also
-// vtkTensorGlyph
+// vtkTensorGlyph vtkGlyphInstanceMapper
 
 #ifndef __vtkGlyph3D_h
 #define __vtkGlyph3D_h
@@ -228,6 +237,14 @@ public:
   vtkGetMacro(FillCellData,int);
   vtkBooleanMacro(FillCellData,int);
 
+  // Description:
+  // Enable/disable the output of one point per glyph with its transform,
+  // instead of the transformed glyph geometry. FillCellData is ignored when
+  // this is on. Off by default.
+  vtkSetMacro(GenerateInstances,int);
+  vtkGetMacro(GenerateInstances,int);
+  vtkBooleanMacro(GenerateInstances,int);
+
   // Description:
   // This can be overwritten by subclass to return 0 when a point is
   // blanked. Default implementation is to always return 1;
@@ -255,6 +272,7 @@ protected:
   int IndexMode; // what to use to index into glyph table
   int GeneratePointIds; // produce input points ids for each output point
   int FillCellData; // whether to fill output cell data
+  int GenerateInstances; // whether to output glyph instances
   char *PointIdsName;
 
 private:
@@ -26,6 +26,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
 
 vtkCxxRevisionMacro(vtkPolyDataConnectivityFilter, "$Revision$");
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
@@ -83,7 +84,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
   vtkPoints *inPts;
   vtkPoints *newPts;
   vtkIdType *cells, *pts, npts, id, n;
-  unsigned short ncells;
+  vtkIdType ncells;
   vtkIdType maxCellsInRegion;
   vtkIdType largestRegionId = 0;
   vtkPointData *pd=input->GetPointData(), *outputPD=output->GetPointData();
@@ -129,7 +130,9 @@ int vtkPolyDataConnectivityFilter::RequestData(
   //
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  this->Mesh->BuildCells();
+  this->Links = vtkStaticCellLinks::New();
+  this->Links->BuildLinks(this->Mesh);
   this->UpdateProgress(0.10);
 
   // Initialize.  Keep track of points and cells visited.
@@ -211,7 +214,8 @@ int vtkPolyDataConnectivityFilter::RequestData(
         pt = this->Seeds->GetId(i);
         if ( pt >= 0 ) 
           {
-          this->Mesh->GetPointCells(pt,ncells,cells);
+          ncells = this->Links->GetNcells(pt);
+          cells = this->Links->GetCells(pt);
           for (j=0; j < ncells; j++) 
             {
             this->Wave->InsertNextId(cells[j]);
@@ -244,7 +248,8 @@ int vtkPolyDataConnectivityFilter::RequestData(
           minDist2 = dist2;
           }
         }
-      this->Mesh->GetPointCells(minId,ncells,cells);
+      ncells = this->Links->GetNcells(minId);
+      cells = this->Links->GetCells(minId);
       for (j=0; j < ncells; j++) 
         {
         this->Wave->InsertNextId(cells[j]);
@@ -396,6 +401,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
   delete [] this->Visited;
   delete [] this->PointMap;
   this->Mesh->Delete();
+  this->Links->Delete();
   output->Squeeze();
   this->CellIds->Delete();
   this->PointIds->Delete();
@@ -422,7 +428,7 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark ()
   int j, k;
   vtkIdType *pts, *cells, npts;
   vtkIdList *tmpWave;
-  unsigned short ncells;
+  vtkIdType ncells;
 
   while ( (numIds=this->Wave->GetNumberOfIds()) > 0 )
     {
@@ -444,7 +450,8 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark ()
               this->PointMap[ptId], this->RegionNumber);
             }
 
-          this->Mesh->GetPointCells(ptId,ncells,cells);
+          ncells = this->Links->GetNcells(ptId);
+          cells = this->Links->GetCells(ptId);
 
           // check connectivity criterion (geometric + scalar)
           for (k=0; k < ncells; k++)
@@ -53,6 +53,7 @@
 class vtkDataArray;
 class vtkIdList;
 class vtkIdTypeArray;
+class vtkStaticCellLinks;
 
 class VTK_GRAPHICS_EXPORT vtkPolyDataConnectivityFilter : public vtkPolyDataAlgorithm
 {
@@ -169,6 +170,7 @@ private:
   vtkIdType NumCellsInRegion;
   vtkDataArray *InScalars;
   vtkPolyData *Mesh;
+  vtkStaticCellLinks *Links;
   vtkIdList *Wave;
   vtkIdList *Wave2;
   vtkIdList *PointIds;
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -26,6 +27,11 @@
 #include "vtkPolygon.h"
 #include "vtkTriangleStrip.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkPolyDataNormals, "$Revision$");
 vtkStandardNewMacro(vtkPolyDataNormals);
@@ -42,6 +48,7 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   this->ComputeCellNormals = 0;
   this->NonManifoldTraversal = 1;
   this->AutoOrientNormals = 0;
+  this->UseThreadPool = 0;
   // some internal data
   this->NumFlips = 0;
 }
@@ -49,6 +56,304 @@ vtkPolyDataNormals::vtkPolyDataNormals()
 #define VTK_CELL_NOT_VISITED     0
 #define VTK_CELL_VISITED         1
 
+//----------------------------------------------------------------------------
+// Compute the normals of a range of polygons.
+class vtkPolyDataNormalsPolyNormals
+{
+public:
+  vtkPolyData *Mesh;
+  vtkPoints *Points;
+  float *Normals;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType npts, *pts;
+    double n[3];
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      vtkPolygon::ComputeNormal(this->Points, npts, pts, n);
+      float *normal = this->Normals + 3*cellId;
+      normal[0] = static_cast<float>(n[0]);
+      normal[1] = static_cast<float>(n[1]);
+      normal[2] = static_cast<float>(n[2]);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// For a range of points, group the polygons using each point into regions
+// that are not separated by a sharp edge, as MarkAndSplit() does. The
+// region of every link is stored in Regions; region 0 keeps the point and
+// every other region gets a new point.
+class vtkPolyDataNormalsMarkRegions
+{
+public:
+  vtkPolyData *Mesh;
+  vtkStaticCellLinks *Links;
+  const float *PolyNormals;
+  double CosAngle;
+  int *Regions;
+  vtkIdType *NumRegions;
+
+  // Return the position in cells of the only polygon other than cellId
+  // using the edge (ptId,nei), or -1. Mesh may be the input, so its cells
+  // are read without converting them, into ptIds when 32 bit.
+  vtkIdType EdgeNeighbor(vtkIdType cellId, vtkIdType nei, vtkIdType ncells,
+                         const vtkIdType *cells, vtkIdList *ptIds)
+    {
+    vtkIdType k, l, npts, found = -1;
+    const vtkIdType *pts;
+    for (k = 0; k < ncells; k++)
+      {
+      if ( cells[k] != cellId )
+        {
+        this->Mesh->GetCellPoints(cells[k], npts, pts, ptIds);
+        for (l = 0; l < npts && pts[l] != nei; l++)
+          {
+          }
+        if ( l < npts )
+          {
+          if ( found >= 0 )
+            {
+            return -1;
+            }
+          found = k;
+          }
+        }
+      }
+    return found;
+    }
+
+  // Return the other point of the polygon that shares an edge with ptId,
+  // given one of them.
+  static vtkIdType OtherNeighbor(vtkIdType ptId, vtkIdType nei,
+                                 vtkIdType npts, const vtkIdType *pts)
+    {
+    vtkIdType spot;
+    for (spot = 0; spot < npts && pts[spot] != ptId; spot++)
+      {
+      }
+    if ( spot == 0 )
+      {
+      return (pts[spot+1] != nei ? pts[spot+1] : pts[npts-1]);
+      }
+    else if ( spot == (npts-1) )
+      {
+      return (pts[spot-1] != nei ? pts[spot-1] : pts[0]);
+      }
+    return (pts[spot+1] != nei ? pts[spot+1] : pts[spot-1]);
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType npts, j, k;
+    const vtkIdType *pts;
+    vtkIdList *ptIds = vtkIdList::New();
+    vtkIdList *neiPtIds = vtkIdList::New();
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType *cells = this->Links->GetCells(ptId);
+      int *regions = this->Regions + this->Links->GetOffsets()[ptId];
+      this->NumRegions[ptId] = 1;
+      if ( ncells <= 1 )
+        {
+        for (j = 0; j < ncells; j++)
+          {
+          regions[j] = 0;
+          }
+        continue;
+        }
+
+      // A polygon using the point twice has two links, the first of which
+      // holds its region.
+      for (j = 0; j < ncells; j++)
+        {
+        regions[j] = -1;
+        }
+      int numRegions = 0;
+      for (j = 0; j < ncells; j++)
+        {
+        if ( regions[j] >= 0 || (j > 0 && cells[j] == cells[j-1]) )
+          {
+          continue;
+          }
+        regions[j] = numRegions;
+        this->Mesh->GetCellPoints(cells[j], npts, pts, ptIds);
+        vtkIdType spot;
+        for (spot = 0; spot < npts && pts[spot] != ptId; spot++)
+          {
+          }
+        vtkIdType neiPt[2];
+        if ( spot == 0 )
+          {
+          neiPt[0] = pts[spot+1];
+          neiPt[1] = pts[npts-1];
+          }
+        else if ( spot == (npts-1) )
+          {
+          neiPt[0] = pts[spot-1];
+          neiPt[1] = pts[0];
+          }
+        else
+          {
+          neiPt[0] = pts[spot+1];
+          neiPt[1] = pts[spot-1];
+          }
+
+        for (int i = 0; i < 2; i++) //for each of the two edges of the seed
+          {
+          vtkIdType cellId = cells[j];
+          vtkIdType nei = neiPt[i];
+          while ( cellId >= 0 ) //while we can grow this region
+            {
+            k = this->EdgeNeighbor(cellId, nei, ncells, cells, neiPtIds);
+            if ( k >= 0 && regions[k] < 0 )
+              {
+              const float *n1 = this->PolyNormals + 3*cellId;
+              const float *n2 = this->PolyNormals + 3*cells[k];
+              double thisNormal[3], neiNormal[3];
+              thisNormal[0] = n1[0]; thisNormal[1] = n1[1];
+              thisNormal[2] = n1[2];
+              neiNormal[0] = n2[0]; neiNormal[1] = n2[1]; neiNormal[2] = n2[2];
+              if ( vtkMath::Dot(thisNormal,neiNormal) > this->CosAngle )
+                {
+                regions[k] = numRegions;
+                cellId = cells[k];
+                this->Mesh->GetCellPoints(cellId, npts, pts, ptIds);
+                nei = OtherNeighbor(ptId, nei, npts, pts);
+                }
+              else
+                {
+                cellId = -1; //separated by edge angle
+                }
+              }
+            else
+              {
+              cellId = -1; //separated by previous visit, boundary, or non-manifold
+              }
+            }
+          }
+        numRegions++;
+        }
+      this->NumRegions[ptId] = numRegions;
+
+      // Every use of a polygon goes to its region.
+      for (j = 1; j < ncells; j++)
+        {
+        if ( cells[j] == cells[j-1] )
+          {
+          regions[j] = regions[j-1];
+          }
+        }
+      }
+    ptIds->Delete();
+    neiPtIds->Delete();
+    }
+};
+
+//----------------------------------------------------------------------------
+// Replace the points of a range of polygons by their split copies.
+class vtkPolyDataNormalsSplitPolys
+{
+public:
+  vtkPolyData *Mesh;
+  vtkStaticCellLinks *Links;
+  const int *Regions;
+  const vtkIdType *NumRegions;
+  const vtkIdType *SplitOffsets;
+  vtkIdType NumberOfPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType npts, *pts, i;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      for (i = 0; i < npts; i++)
+        {
+        vtkIdType ptId = pts[i];
+        if ( ptId >= this->NumberOfPoints || this->NumRegions[ptId] <= 1 )
+          {
+          continue;
+          }
+        const vtkIdType *cells = this->Links->GetCells(ptId);
+        const vtkIdType *link = vtkstd::lower_bound(
+          cells, cells + this->Links->GetNcells(ptId), cellId);
+        int region = this->Regions[this->Links->GetOffsets()[ptId] +
+                                   (link - cells)];
+        if ( region > 0 )
+          {
+          pts[i] = this->NumberOfPoints + this->SplitOffsets[ptId] +
+            region - 1;
+          }
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Sum the normals of the polygons using a range of input points, in the
+// order of the polygons and with the rounding of the serial accumulation,
+// and normalize them. Every region of a split point gets its own normal.
+class vtkPolyDataNormalsPointNormals
+{
+public:
+  vtkStaticCellLinks *Links;
+  const int *Regions;
+  const vtkIdType *NumRegions;
+  const vtkIdType *SplitOffsets;
+  vtkIdType NumberOfPoints;
+  const float *PolyNormals;
+  float *Normals;
+  double FlipDirection;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkstd::vector<float> sums;
+    vtkIdType j;
+    int k, r;
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      int numRegions = (this->NumRegions ?
+                        static_cast<int>(this->NumRegions[ptId]) : 1);
+      sums.assign(3*numRegions, 0.0f);
+      vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType *cells = this->Links->GetCells(ptId);
+      const int *regions = (this->Regions ?
+        this->Regions + this->Links->GetOffsets()[ptId] : NULL);
+      for (j = 0; j < ncells; j++)
+        {
+        const float *polyNormal = this->PolyNormals + 3*cells[j];
+        float *sum = &sums[3*(regions && numRegions > 1 ? regions[j] : 0)];
+        for (k = 0; k < 3; k++)
+          {
+          sum[k] = static_cast<float>(static_cast<double>(sum[k]) +
+                                      static_cast<double>(polyNormal[k]));
+          }
+        }
+      for (r = 0; r < numRegions; r++)
+        {
+        vtkIdType id = (r == 0 ? ptId : this->NumberOfPoints +
+                        this->SplitOffsets[ptId] + r - 1);
+        double vertNormal[3];
+        for (k = 0; k < 3; k++)
+          {
+          vertNormal[k] = sums[3*r+k];
+          }
+        double length = vtkMath::Norm(vertNormal);
+        for (k = 0; k < 3; k++)
+          {
+          this->Normals[3*id+k] = (length != 0.0 ?
+            static_cast<float>(vertNormal[k] / length * this->FlipDirection) :
+            0.0f);
+          }
+        }
+      }
+    }
+};
+
 // Generate normals for polygon meshes
 int vtkPolyDataNormals::RequestData(
   vtkInformation *vtkNotUsed(request),
@@ -84,6 +389,10 @@ int vtkPolyDataNormals::RequestData(
   double n[3];
   vtkCellArray *newPolys;
   vtkIdType ptId, oldId;
+  vtkStaticCellLinks *links = NULL;
+  vtkstd::vector<int> regions;
+  vtkstd::vector<vtkIdType> numRegions;
+  vtkstd::vector<vtkIdType> splitOffsets;
 
   vtkDebugMacro(<<"Generating surface normals");
 
@@ -130,10 +439,16 @@ int vtkPolyDataNormals::RequestData(
       polys = vtkCellArray::New();
       polys->Allocate(polys->EstimateSize(numStrips,5));
       }
-    for ( inStrips->InitTraversal(); inStrips->GetNextCell(npts,pts); )
+    // Read the strips of the input without converting them.
+    vtkIdList *stripPtIds = vtkIdList::New();
+    vtkCellArrayCursor cursor;
+    const vtkIdType *stripPts;
+    for ( inStrips->InitTraversal(cursor);
+          inStrips->GetNextCell(cursor,npts,stripPts,stripPtIds); )
       {
-      vtkTriangleStrip::DecomposeStrip(npts, pts, polys);
+      vtkTriangleStrip::DecomposeStrip(npts, stripPts, polys);
       }
+    stripPtIds->Delete();
     this->OldMesh->SetPolys(polys);
     polys->Delete();
     numPolys = polys->GetNumberOfCells();//added some new triangles
@@ -143,7 +458,24 @@ int vtkPolyDataNormals::RequestData(
     this->OldMesh->SetPolys(inPolys);
     polys = inPolys;
     }
-  this->OldMesh->BuildLinks();
+  if ( this->UseThreadPool )
+    {
+    // The links are only needed by the serial traversal of the polygons.
+    if ( this->Consistency || this->AutoOrientNormals )
+      {
+      this->OldMesh->BuildLinks();
+      }
+    else
+      {
+      this->OldMesh->BuildCells();
+      }
+    links = vtkStaticCellLinks::New();
+    links->BuildLinks(this->OldMesh);
+    }
+  else
+    {
+    this->OldMesh->BuildLinks();
+    }
   this->UpdateProgress(0.10);
   
   pd = input->GetPointData();
@@ -156,6 +488,9 @@ int vtkPolyDataNormals::RequestData(
   // create a copy because we're modifying it
   newPolys = vtkCellArray::New();
   newPolys->DeepCopy(polys);
+  // The copy is rewritten through pointers to its cells, which needs the
+  // list storage.
+  newPolys->SetStorageModeToLegacy();
   this->NewMesh->SetPolys(newPolys);
   this->NewMesh->BuildCells(); //builds connectivity
 
@@ -317,19 +652,31 @@ int vtkPolyDataNormals::RequestData(
   this->PolyNormals->SetName("Normals");
   this->PolyNormals->SetNumberOfTuples(numPolys);
 
-  for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts); 
-       cellId++ )
+  if ( this->UseThreadPool )
     {
-    if ((cellId % 1000) == 0)
+    vtkPolyDataNormalsPolyNormals polyNormals;
+    polyNormals.Mesh = this->NewMesh;
+    polyNormals.Points = inPts;
+    polyNormals.Normals = this->PolyNormals->GetPointer(0);
+    vtkSMPTools::For(0, numPolys, polyNormals);
+    this->UpdateProgress(0.666);
+    }
+  else
+    {
+    for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts); 
+         cellId++ )
       {
-      this->UpdateProgress (0.333 + 0.333 * (double) cellId / (double) numPolys);
-      if (this->GetAbortExecute())
+      if ((cellId % 1000) == 0)
         {
-        break; 
+        this->UpdateProgress (0.333 + 0.333 * (double) cellId / (double) numPolys);
+        if (this->GetAbortExecute())
+          {
+          break; 
+          }
         }
+      vtkPolygon::ComputeNormal(inPts, npts, pts, n);
+      this->PolyNormals->SetTuple(cellId,n);
       }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(cellId,n);
     }
 
   // Split mesh if sharp features
@@ -344,16 +691,60 @@ int vtkPolyDataNormals::RequestData(
     // to map new points into old points.
     //
     this->Map = vtkIdList::New();
-    this->Map->SetNumberOfIds(numPts);
-    for (i=0; i < numPts; i++)
+    if ( this->UseThreadPool )
       {
-      this->Map->SetId(i,i);
-      }
+      // Find the regions around every point, number the new points in
+      // point order as MarkAndSplit() does, then rewrite the polygons.
+      regions.resize(links->GetLinksSize() + 1);
+      numRegions.resize(numPts);
+      splitOffsets.resize(numPts);
+      vtkPolyDataNormalsMarkRegions mark;
+      mark.Mesh = this->OldMesh;
+      mark.Links = links;
+      mark.PolyNormals = this->PolyNormals->GetPointer(0);
+      mark.CosAngle = this->CosAngle;
+      mark.Regions = &regions[0];
+      mark.NumRegions = &numRegions[0];
+      vtkSMPTools::For(0, numPts, mark);
+
+      numNewPts = numPts;
+      for (ptId=0; ptId < numPts; ptId++)
+        {
+        splitOffsets[ptId] = numNewPts - numPts;
+        numNewPts += numRegions[ptId] - 1;
+        }
+      this->Map->SetNumberOfIds(numNewPts);
+      for (ptId=0; ptId < numPts; ptId++)
+        {
+        this->Map->SetId(ptId,ptId);
+        for (i=1; i < numRegions[ptId]; i++)
+          {
+          this->Map->SetId(numPts + splitOffsets[ptId] + i - 1, ptId);
+          }
+        }
 
-    for (ptId=0; ptId < numPts; ptId++)
+      vtkPolyDataNormalsSplitPolys split;
+      split.Mesh = this->NewMesh;
+      split.Links = links;
+      split.Regions = &regions[0];
+      split.NumRegions = &numRegions[0];
+      split.SplitOffsets = &splitOffsets[0];
+      split.NumberOfPoints = numPts;
+      vtkSMPTools::For(0, numPolys, split);
+      }
+    else
       {
-      this->MarkAndSplit(ptId);
-      }//for all input points
+      this->Map->SetNumberOfIds(numPts);
+      for (i=0; i < numPts; i++)
+        {
+        this->Map->SetId(i,i);
+        }
+
+      for (ptId=0; ptId < numPts; ptId++)
+        {
+        this->MarkAndSplit(ptId);
+        }//for all input points
+      }
 
     numNewPts = this->Map->GetNumberOfIds();
 
@@ -407,7 +798,20 @@ int vtkPolyDataNormals::RequestData(
     newNormals->SetTuple(i,n);
     }
 
-  if (this->ComputePointNormals)
+  if (this->ComputePointNormals && this->UseThreadPool)
+    {
+    vtkPolyDataNormalsPointNormals pointNormals;
+    pointNormals.Links = links;
+    pointNormals.Regions = (this->Splitting ? &regions[0] : NULL);
+    pointNormals.NumRegions = (this->Splitting ? &numRegions[0] : NULL);
+    pointNormals.SplitOffsets = (this->Splitting ? &splitOffsets[0] : NULL);
+    pointNormals.NumberOfPoints = numPts;
+    pointNormals.PolyNormals = this->PolyNormals->GetPointer(0);
+    pointNormals.Normals = newNormals->GetPointer(0);
+    pointNormals.FlipDirection = flipDirection;
+    vtkSMPTools::For(0, numPts, pointNormals);
+    }
+  else if (this->ComputePointNormals)
     {
     for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts); 
           cellId++ )
@@ -436,6 +840,10 @@ int vtkPolyDataNormals::RequestData(
           n[j] = vertNormal[j] / length * flipDirection;
           }
         }
+      else
+        {
+        n[0] = n[1] = n[2] = 0.0;
+        }
       newNormals->SetTuple(i,n);
       }
     }
@@ -477,6 +885,10 @@ int vtkPolyDataNormals::RequestData(
                    
   this->OldMesh->Delete();
   this->NewMesh->Delete();
+  if ( links )
+    {
+    links->Delete();
+    }
 
   return 1;
 }
@@ -730,5 +1142,7 @@ void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
      << (this->ComputeCellNormals ? "On\n" : "Off\n");
   os << indent << "Non-manifold Traversal: " 
      << (this->NonManifoldTraversal ? "On\n" : "Off\n");
+  os << indent << "UseThreadPool: " 
+     << (this->UseThreadPool ? "On\n" : "Off\n");
 }
 
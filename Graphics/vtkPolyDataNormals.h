@@ -24,6 +24,13 @@
 // averaging them at shared points. When sharp edges are present, the edges
 // are split and new points generated to prevent blurry edges (due to 
 // Gouraud shading).
+//
+// When UseThreadPool is on, the polygon normals, the splitting of sharp
+// edges and the point normals are computed on the workers of the
+// vtkThreadPool, with a vtkStaticCellLinks as the map from points to
+// polygons. Each point gathers the normals of its polygons in polygon
+// order, so the output is identical to the serial one. The consistent
+// ordering and the automatic orientation of the polygons remain serial.
 
 // .SECTION Caveats
 // Normals are computed only for polygons and triangle strips. Normals are
@@ -114,6 +121,13 @@ public:
   vtkSetMacro(NonManifoldTraversal,int);
   vtkGetMacro(NonManifoldTraversal,int);
   vtkBooleanMacro(NonManifoldTraversal,int);
+
+  // Description:
+  // Compute the normals and split the sharp edges in parallel with the
+  // vtkThreadPool. Off by default.
+  vtkSetMacro(UseThreadPool,int);
+  vtkGetMacro(UseThreadPool,int);
+  vtkBooleanMacro(UseThreadPool,int);
   
 protected:
   vtkPolyDataNormals();
@@ -131,6 +145,7 @@ protected:
   int ComputePointNormals;
   int ComputeCellNormals;
   int NumFlips;
+  int UseThreadPool;
 
 private:
   vtkIdList *Wave;
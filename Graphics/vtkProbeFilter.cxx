@@ -14,27 +14,116 @@
 =========================================================================*/
 #include "vtkProbeFilter.h"
 
+#include "vtkAbstractCellLocator.h"
+#include "vtkBitArray.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
 #include "vtkCharArray.h"
+#include "vtkGenericCell.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vtkstd/algorithm>
 #include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkProbeFilter, "$Revision$");
 vtkStandardNewMacro(vtkProbeFilter);
+vtkCxxSetObjectMacro(vtkProbeFilter,CellLocator,vtkAbstractCellLocator);
 
 class vtkProbeFilter::vtkVectorOfArrays : 
   public vtkstd::vector<vtkDataArray*>
 {
 };
 
+//----------------------------------------------------------------------------
+// Probe a range of points with a cell locator. Each call uses its own cell
+// and weights, and starts the search of a point from the cell found for
+// the previous one. Hits[ptId-FirstPoint] is set for the points found.
+class vtkProbeFilterLocatorProbe
+{
+public:
+  vtkDataSet *Input;
+  vtkDataSet *Source;
+  vtkPointData *OutPD;
+  vtkAbstractCellLocator *Locator;
+  vtkDataSetAttributes::FieldList *PointList;
+  vtkstd::vector<vtkDataArray*> *CellArrays;
+  int SourceIndex;
+  int MaxCellSize;
+  double Tol2;
+  int UseNullPoint;
+  char *MaskArray;
+  char *Hits;
+  vtkIdType FirstPoint;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkGenericCell *cell = vtkGenericCell::New();
+    vtkstd::vector<double> weights(this->MaxCellSize > 0 ?
+                                   this->MaxCellSize : 1);
+    vtkPointData *pd = this->Source->GetPointData();
+    vtkCellData *cd = this->Source->GetCellData();
+    double x[3], pcoords[3], closest[3], dist2;
+    int subId;
+    vtkIdType cellId = -1;
+
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      if (this->MaskArray[ptId] == static_cast<char>(1))
+        {
+        // skip points which have already been probed with success.
+        continue;
+        }
+      this->Input->GetPoint(ptId, x);
+
+      // Try the cell of the previous point first.
+      if (cellId >= 0)
+        {
+        this->Source->GetCell(cellId, cell);
+        if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2,
+                                   &weights[0]) != 1)
+          {
+          cellId = -1;
+          }
+        }
+      if (cellId < 0)
+        {
+        cellId = this->Locator->FindCell(x, this->Tol2, cell, pcoords,
+                                         &weights[0]);
+        }
+
+      if (cellId >= 0)
+        {
+        this->OutPD->InterpolatePoint(*this->PointList, pd, this->SourceIndex,
+                                      ptId, cell->PointIds, &weights[0]);
+        vtkstd::vector<vtkDataArray*>::iterator iter;
+        for (iter = this->CellArrays->begin();
+             iter != this->CellArrays->end(); ++iter)
+          {
+          vtkDataArray* inArray = cd->GetArray((*iter)->GetName());
+          if (inArray)
+            {
+            this->OutPD->CopyTuple(inArray, *iter, cellId, ptId);
+            }
+          }
+        this->MaskArray[ptId] = static_cast<char>(1);
+        this->Hits[ptId - this->FirstPoint] = 1;
+        }
+      else if (this->UseNullPoint)
+        {
+        this->OutPD->NullPoint(ptId);
+        }
+      }
+    cell->Delete();
+    }
+};
+
 //----------------------------------------------------------------------------
 vtkProbeFilter::vtkProbeFilter()
 {
@@ -52,6 +141,7 @@ vtkProbeFilter::vtkProbeFilter()
   this->CellList = 0;
 
   this->UseNullPoint = true;
+  this->CellLocator = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -66,6 +156,7 @@ vtkProbeFilter::~vtkProbeFilter()
 
   delete this->PointList;
   delete this->CellList;
+  this->SetCellLocator(NULL);
 }
 
 //----------------------------------------------------------------------------
@@ -269,6 +360,16 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
   double minRes2 = minRes * minRes;
   tol2 = tol2 > minRes2 ? minRes2 : tol2;
 
+  if (this->CellLocator && source->GetNumberOfCells() > 0)
+    {
+    if (mcs>256)
+      {
+      delete [] weights;
+      }
+    this->ProbeEmptyPointsWithLocator(input, srcIdx, source, output, tol2);
+    return;
+    }
+
   // Loop over all input points, interpolating source data
   //
   int abort=0;
@@ -335,6 +436,117 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkProbeFilter::ProbeEmptyPointsWithLocator(vtkDataSet *input,
+  int srcIdx, vtkDataSet *source, vtkDataSet *output, double tol2)
+{
+  vtkIdType ptId, numPts = input->GetNumberOfPoints();
+  vtkPointData *outPD = output->GetPointData();
+  char* maskArray = this->MaskPoints->GetPointer(0);
+  if (numPts < 1)
+    {
+    return;
+    }
+
+  // The points can be probed in parallel when the output arrays hold one
+  // contiguous tuple per point: size them now, so that the threads only
+  // write their own tuples.
+  int parallel = 1;
+  int i, numArrays = outPD->GetNumberOfArrays();
+  for (i=0; i < numArrays; i++)
+    {
+    vtkDataArray *array = outPD->GetArray(i);
+    if (!array || !array->HasStandardMemoryLayout() ||
+        vtkBitArray::SafeDownCast(array))
+      {
+      parallel = 0;
+      }
+    }
+  for (i=0; parallel && i < numArrays; i++)
+    {
+    vtkDataArray *array = outPD->GetArray(i);
+    if (array->GetNumberOfTuples() < numPts)
+      {
+      array->SetNumberOfTuples(numPts);
+      }
+    }
+
+  // Build the locator, then search the first point from this thread: this
+  // completes the lazy initialization of the locator and of the datasets.
+  double x[3];
+  this->CellLocator->SetDataSet(source);
+  this->CellLocator->BuildLocator();
+  vtkGenericCell *cell = vtkGenericCell::New();
+  vtkstd::vector<double> weights(source->GetMaxCellSize() + 1);
+  double pcoords[3], bounds[6];
+  input->GetPoint(0, x);
+  vtkIdType cellId = this->CellLocator->FindCell(x, tol2, cell, pcoords,
+                                                 &weights[0]);
+  source->GetCell(cellId >= 0 ? cellId : 0, cell);
+  source->GetCellBounds(cellId >= 0 ? cellId : 0, bounds);
+  cell->Delete();
+
+  vtkProbeFilterLocatorProbe probe;
+  probe.Input = input;
+  probe.Source = source;
+  probe.OutPD = outPD;
+  probe.Locator = this->CellLocator;
+  probe.PointList = this->PointList;
+  probe.CellArrays = this->CellArrays;
+  probe.SourceIndex = srcIdx;
+  probe.MaxCellSize = source->GetMaxCellSize();
+  probe.Tol2 = tol2;
+  probe.UseNullPoint = this->UseNullPoint;
+  probe.MaskArray = maskArray;
+
+  // Probe the points by blocks, reporting progress in between.
+  int abort=0;
+  vtkIdType blockSize = numPts/20 + 1;
+  vtkstd::vector<char> hits(blockSize);
+  for (vtkIdType first=0; first < numPts && !abort; first += blockSize)
+    {
+    vtkIdType last = (first + blockSize < numPts ? first + blockSize : numPts);
+    this->UpdateProgress(static_cast<double>(first)/numPts);
+    abort = this->GetAbortExecute();
+
+    vtkstd::fill(hits.begin(), hits.end(), 0);
+    probe.Hits = &hits[0];
+    probe.FirstPoint = first;
+    if (parallel)
+      {
+      vtkSMPTools::For(first, last, probe);
+      }
+    else
+      {
+      probe(first, last);
+      }
+
+    for (ptId=first; ptId < last; ptId++)
+      {
+      if (hits[ptId-first])
+        {
+        this->ValidPoints->InsertNextValue(ptId);
+        this->NumberOfValidPoints++;
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkProbeFilter::GetMTime()
+{
+  unsigned long mTime=this->Superclass::GetMTime();
+  unsigned long time;
+
+  if (this->CellLocator)
+    {
+    time = this->CellLocator->GetMTime();
+    mTime = ( time > mTime ? time : mTime );
+    }
+
+  return mTime;
+}
+
 //----------------------------------------------------------------------------
 int vtkProbeFilter::RequestInformation(
   vtkInformation *vtkNotUsed(request),
@@ -511,4 +723,5 @@ void vtkProbeFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ValidPointMaskArrayName: " << (this->ValidPointMaskArrayName?
     this->ValidPointMaskArrayName : "vtkValidPointMask") << "\n";
   os << indent << "ValidPoints: " << this->ValidPoints << "\n";
+  os << indent << "CellLocator: " << this->CellLocator << "\n";
 }
@@ -31,6 +31,13 @@
 // rendering techniques can be used to visualize the results. Another example:
 // a line or curve can be used to probe data to produce x-y plots along
 // that line or curve.
+//
+// By default the source cell containing each point is found with
+// vtkDataSet::FindCell(), one point after the other. When a cell locator is
+// set, it is used instead and the points are probed in parallel chunks with
+// the vtkThreadPool (see vtkSMPTools). Neighboring input points often fall
+// in the same source cell, so the search of each point of a chunk first
+// tries the cell of the previous point.
 
 #ifndef __vtkProbeFilter_h
 #define __vtkProbeFilter_h
@@ -38,6 +45,7 @@
 #include "vtkDataSetAlgorithm.h"
 #include "vtkDataSetAttributes.h" // needed for vtkDataSetAttributes::FieldList
 
+class vtkAbstractCellLocator;
 class vtkIdTypeArray;
 class vtkCharArray;
 class vtkMaskPoints;
@@ -85,12 +93,27 @@ public:
   vtkSetStringMacro(ValidPointMaskArrayName)
   vtkGetStringMacro(ValidPointMaskArrayName)
 
+  // Description:
+  // Set / get the locator used to find the source cell containing each
+  // point. The locator is given the source as dataset and built before
+  // probing. Its FindCell(x, tol2, cell, pcoords, weights) method must be
+  // thread safe once built, as the one of vtkCellLocator is. When no
+  // locator is set (the default), the points are probed serially with
+  // vtkDataSet::FindCell().
+  virtual void SetCellLocator(vtkAbstractCellLocator*);
+  vtkGetObjectMacro(CellLocator,vtkAbstractCellLocator);
+
+  // Description:
+  // Return the MTime also considering the cell locator.
+  unsigned long GetMTime();
+
 //BTX 
 protected:
   vtkProbeFilter();
   ~vtkProbeFilter();
 
   int SpatialMatch;
+  vtkAbstractCellLocator *CellLocator;
 
   virtual int RequestData(vtkInformation *, vtkInformationVector **, 
     vtkInformationVector *);
@@ -119,6 +142,11 @@ protected:
   void ProbeEmptyPoints(vtkDataSet *input, int srcIdx, vtkDataSet *source, 
     vtkDataSet *output);
 
+  // Description:
+  // Implementation of ProbeEmptyPoints() with the cell locator.
+  void ProbeEmptyPointsWithLocator(vtkDataSet *input, int srcIdx,
+    vtkDataSet *source, vtkDataSet *output, double tol2);
+
   char* ValidPointMaskArrayName;
   vtkIdTypeArray *ValidPoints;
   vtkCharArray* MaskPoints;
@@ -25,9 +25,14 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <vtkstd/vector>
+
 vtkCxxRevisionMacro(vtkSmoothPolyDataFilter, "$Revision$");
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
 
@@ -107,6 +112,38 @@ vtkSmoothPoint *vtkSmoothPoints::Resize(vtkIdType sz)
   return this->Array;
 }
 
+// The classification of the vertices and, for every vertex, the ids of
+// the points it is smoothed with, stored contiguously: the neighbors of
+// point i are Ids[Offsets[i]] to Ids[Offsets[i+1]-1]. They are kept across
+// executions and rebuilt only when the input or the parameters of the
+// classification change.
+class vtkSmoothPolyDataFilterAdjacency { //;prevent man page generation
+public:
+  vtkSmoothPolyDataFilterAdjacency() : Input(NULL) {};
+
+  int IsCurrent(vtkPolyData *input, int featureEdgeSmoothing,
+                double featureAngle, double edgeAngle, int boundarySmoothing)
+    {
+    return input == this->Input &&
+      input->GetMTime() < this->BuildTime.GetMTime() &&
+      featureEdgeSmoothing == this->FeatureEdgeSmoothing &&
+      featureAngle == this->FeatureAngle &&
+      edgeAngle == this->EdgeAngle &&
+      boundarySmoothing == this->BoundarySmoothing;
+    }
+
+  vtkstd::vector<char> Types;
+  vtkstd::vector<vtkIdType> Offsets;
+  vtkstd::vector<vtkIdType> Ids;
+
+  vtkPolyData *Input; // compared only, never dereferenced
+  int FeatureEdgeSmoothing;
+  double FeatureAngle;
+  double EdgeAngle;
+  int BoundarySmoothing;
+  vtkTimeStamp BuildTime;
+};
+
 // The following code defines methods for the vtkSmoothPolyDataFilter class
 //
 
@@ -130,10 +167,18 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->GenerateErrorScalars = 0;
   this->GenerateErrorVectors = 0;
 
+  this->UseThreadPool = 0;
+  this->Adjacency = new vtkSmoothPolyDataFilterAdjacency;
+
   // optional second input
   this->SetNumberOfInputPorts(2);
 }
 
+vtkSmoothPolyDataFilter::~vtkSmoothPolyDataFilter()
+{
+  delete this->Adjacency;
+}
+
 void vtkSmoothPolyDataFilter::SetSource(vtkPolyData *source)
 {
   this->SetInput(1, source);
@@ -160,7 +205,63 @@ typedef struct _vtkMeshVertex
   char      type;
   vtkIdList *edges; // connected edges (list of connected point ids)
 } vtkMeshVertex, *vtkMeshVertexPtr;
-    
+
+// Move the points [begin, end) towards the average of their neighbors.
+// Only the positions of the previous pass are read, so the points can be
+// moved in any order; the largest motion is kept per thread.
+class vtkSmoothPolyDataFilterRelax
+{
+public:
+  const char *Types;
+  const vtkIdType *Offsets;
+  const vtkIdType *Ids;
+  const float *Current;
+  float *Next;
+  double Factor;
+  vtkSMPThreadLocal<double> MaxDist;
+
+  vtkSmoothPolyDataFilterRelax() : MaxDist(0.0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    double &maxDist = this->MaxDist.Local();
+    double deltaX[3], dist;
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      const float *x = this->Current + 3*i;
+      float *xNew = this->Next + 3*i;
+      vtkIdType npts = this->Offsets[i+1] - this->Offsets[i];
+      int k;
+      if ( this->Types[i] == VTK_FIXED_VERTEX || npts == 0 )
+        {
+        for (k=0; k<3; k++)
+          {
+          xNew[k] = x[k];
+          }
+        continue;
+        }
+      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+      const vtkIdType *nei = this->Ids + this->Offsets[i];
+      for (vtkIdType j=0; j<npts; j++)
+        {
+        const float *y = this->Current + 3*nei[j];
+        for (k=0; k<3; k++)
+          {
+          deltaX[k] += (static_cast<double>(y[k]) - x[k]) / npts;
+          }
+        }
+      for (k=0; k<3; k++)
+        {
+        xNew[k] = static_cast<float>(x[k] + this->Factor * deltaX[k]);
+        }
+      if ( (dist = vtkMath::Norm(deltaX)) > maxDist )
+        {
+        maxDist = dist;
+        }
+      }
+    }
+};
+
 int vtkSmoothPolyDataFilter::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -183,24 +284,15 @@ int vtkSmoothPolyDataFilter::RequestData(
   vtkPolyData *output = vtkPolyData::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts, numCells, i, numPolys, numStrips;
+  vtkIdType numPts, numCells, i;
   int j, k;
   vtkIdType npts = 0;
-  vtkIdType *pts = 0;
-  vtkIdType p1, p2;
   double x[3], y[3], deltaX[3], xNew[3], conv, maxDist, dist, factor;
-  double x1[3], x2[3], x3[3], l1[3], l2[3];
-  double CosFeatureAngle; //Cosine of angle between adjacent polys
-  double CosEdgeAngle; // Cosine of angle between adjacent edges
+  double x1[3], x2[3], x3[3];
   double closestPt[3], dist2, *w = NULL;
   int iterationNumber, abortExecute;
-  vtkIdType numSimple=0, numBEdges=0, numFixed=0, numFEdges=0;
-  vtkPolyData *inMesh, *Mesh;
   vtkPoints *inPts;
-  vtkTriangleFilter *toTris=NULL;
-  vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints *newPts;
-  vtkMeshVertexPtr Verts;
   vtkCellLocator *cellLocator=NULL;
 
   // Check input
@@ -213,9 +305,6 @@ int vtkSmoothPolyDataFilter::RequestData(
     return 1;
     }
 
-  CosFeatureAngle = cos( vtkMath::RadiansFromDegrees( this->FeatureAngle) );
-  CosEdgeAngle =    cos( vtkMath::RadiansFromDegrees( this->EdgeAngle) );
-
   vtkDebugMacro(<<"Smoothing " << numPts << " vertices, " << numCells 
                << " cells with:\n"
                << "\tConvergence= " << this->Convergence << "\n"
@@ -235,6 +324,254 @@ int vtkSmoothPolyDataFilter::RequestData(
     return 1;
     }
 
+  // Peform topological analysis, unless the input and the classification
+  // are those of the previous execution.
+  if ( !this->Adjacency->IsCurrent(input, this->FeatureEdgeSmoothing,
+                                   this->FeatureAngle, this->EdgeAngle,
+                                   this->BoundarySmoothing) )
+    {
+    this->BuildAdjacency(input);
+    }
+  this->UpdateProgress(0.50);
+
+  const char *types = &this->Adjacency->Types[0];
+  const vtkIdType *offsets = &this->Adjacency->Offsets[0];
+  const vtkIdType *ids = this->Adjacency->Ids.empty() ? NULL :
+    &this->Adjacency->Ids[0];
+  inPts = input->GetPoints();
+  conv = this->Convergence * input->GetLength();
+
+
+  vtkDebugMacro(<<"Beginning smoothing iterations...");
+
+  // We've setup the topology...now perform Laplacian smoothing
+  //
+  newPts = vtkPoints::New();
+  newPts->SetNumberOfPoints(numPts);
+
+  // If Source defined, we do constrained smoothing (that is, points are 
+  // constrained to the surface of the mesh object).
+  if ( source )
+    {
+    this->SmoothPoints = new vtkSmoothPoints;
+    vtkSmoothPoint *sPtr;
+    cellLocator = vtkCellLocator::New();
+    w = new double[source->GetMaxCellSize()];
+    
+    cellLocator->SetDataSet(source);
+    cellLocator->BuildLocator();
+    
+    for (i=0; i < numPts; i++)
+      {
+      sPtr = this->SmoothPoints->InsertSmoothPoint(i);
+      cellLocator->FindClosestPoint(inPts->GetPoint(i), closestPt, 
+                                    sPtr->cellId, sPtr->subId, dist2);
+      newPts->SetPoint(i, closestPt);
+      }
+    }
+  else //smooth normally
+    {
+    for (i=0; i<numPts; i++) //initialize to old coordinates
+      {
+      newPts->SetPoint(i,inPts->GetPoint(i));
+      }
+    }
+
+  factor = this->RelaxationFactor;
+
+  // Without a source, the threads smooth in Jacobi passes: every pass reads
+  // the positions of the previous one and writes the other buffer.
+  vtkPoints *nextPts = NULL;
+  vtkSmoothPolyDataFilterRelax relax;
+  if ( this->UseThreadPool && !source )
+    {
+    nextPts = vtkPoints::New();
+    nextPts->SetDataTypeToFloat();
+    nextPts->SetNumberOfPoints(numPts);
+    relax.Types = types;
+    relax.Offsets = offsets;
+    relax.Ids = ids;
+    relax.Factor = factor;
+    }
+
+  for ( maxDist=VTK_DOUBLE_MAX, iterationNumber=0, abortExecute=0; 
+  maxDist > conv && iterationNumber < this->NumberOfIterations && !abortExecute;
+  iterationNumber++ )
+    {
+
+    if ( iterationNumber && !(iterationNumber % 5) )
+      {
+      this->UpdateProgress (0.5 + 0.5*iterationNumber/this->NumberOfIterations);
+      if (this->GetAbortExecute())
+        {
+        abortExecute = 1;
+        break;
+        }
+      }
+
+    maxDist=0.0;
+    if ( nextPts )
+      {
+      relax.Current =
+        static_cast<vtkFloatArray *>(newPts->GetData())->GetPointer(0);
+      relax.Next =
+        static_cast<vtkFloatArray *>(nextPts->GetData())->GetPointer(0);
+      vtkSMPThreadLocal<double>::iterator it;
+      for (it = relax.MaxDist.begin(); it != relax.MaxDist.end(); ++it)
+        {
+        *it = 0.0;
+        }
+      vtkSMPTools::For(0, numPts, relax);
+      for (it = relax.MaxDist.begin(); it != relax.MaxDist.end(); ++it)
+        {
+        maxDist = (*it > maxDist ? *it : maxDist);
+        }
+      vtkPoints *tmpPts = newPts;
+      newPts = nextPts;
+      nextPts = tmpPts;
+      continue;
+      }
+
+    for (i=0; i<numPts; i++) 
+      {
+      if ( types[i] != VTK_FIXED_VERTEX &&
+      (npts = offsets[i+1] - offsets[i]) > 0 )
+        {
+        newPts->GetPoint(i, x); //use current points
+        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+        for (j=0; j<npts; j++)
+          {
+          newPts->GetPoint(ids[offsets[i]+j], y);
+          for (k=0; k<3; k++)
+            {
+            deltaX[k] += (y[k] - x[k]) / npts;
+            }
+          }//for all connected points
+
+        for (k=0;k<3;k++) 
+          {
+          xNew[k] = x[k] + factor * deltaX[k];
+          }
+
+        // Constrain point to surface
+        if ( source ) 
+          {
+          vtkSmoothPoint *sPtr = this->SmoothPoints->GetSmoothPoint(i);
+          vtkCell *cell=NULL;
+
+          if ( sPtr->cellId >= 0 ) //in cell
+            {
+            cell = source->GetCell(sPtr->cellId);
+            }
+
+          if ( !cell || cell->EvaluatePosition(xNew, closestPt,
+          sPtr->subId, sPtr->p, dist2, w) == 0)
+            { // not in cell anymore
+            cellLocator->FindClosestPoint(xNew, closestPt, sPtr->cellId, 
+                                          sPtr->subId, dist2);
+            }
+          for (k=0; k<3; k++)
+            {
+            xNew[k] = closestPt[k];
+            }
+          }
+
+        newPts->SetPoint(i,xNew);
+        if ( (dist = vtkMath::Norm(deltaX)) > maxDist )
+          {
+          maxDist = dist;
+          }
+        }//if can move point
+      }//for all points
+    } //for not converged or within iteration count
+
+  vtkDebugMacro(<<"Performed " << iterationNumber << " smoothing passes");
+  if ( nextPts )
+    {
+    nextPts->Delete();
+    }
+  if ( source )
+    {
+    cellLocator->Delete();
+    delete this->SmoothPoints;
+    delete [] w;
+    }
+
+  // Update output. Only point coordinates have changed.
+  //
+  output->GetPointData()->PassData(input->GetPointData());
+  output->GetCellData()->PassData(input->GetCellData());
+
+  if ( this->GenerateErrorScalars )
+    {
+    vtkFloatArray *newScalars = vtkFloatArray::New();
+    newScalars->SetNumberOfTuples(numPts);
+    for (i=0; i<numPts; i++)
+      {
+      inPts->GetPoint(i,x1);
+      newPts->GetPoint(i,x2);
+      newScalars->SetComponent(i,0,
+                               sqrt(vtkMath::Distance2BetweenPoints(x1,x2)));
+      }
+    int idx = output->GetPointData()->AddArray(newScalars);
+    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+    newScalars->Delete();
+    }
+
+  if ( this->GenerateErrorVectors )
+    {
+    vtkFloatArray *newVectors = vtkFloatArray::New();
+    newVectors->SetNumberOfComponents(3);
+    newVectors->SetNumberOfTuples(numPts);
+    for (i=0; i<numPts; i++)
+      {
+      inPts->GetPoint(i,x1);
+      newPts->GetPoint(i,x2);
+      for (j=0; j<3; j++)
+        {
+        x3[j] = x2[j] - x1[j];
+        }
+      newVectors->SetTuple(i,x3);
+      }
+    output->GetPointData()->SetVectors(newVectors);
+    newVectors->Delete();
+    }
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+
+  output->SetVerts(input->GetVerts());
+  output->SetLines(input->GetLines());
+  output->SetPolys(input->GetPolys());
+  output->SetStrips(input->GetStrips());
+
+  return 1;
+}
+
+// Classify the vertices of the input and store, for every vertex, the
+// points it is smoothed with.
+void vtkSmoothPolyDataFilter::BuildAdjacency(vtkPolyData *input)
+{
+  vtkIdType numPts=input->GetNumberOfPoints();
+  vtkIdType i, numPolys, numStrips;
+  int j, k;
+  vtkIdType npts = 0;
+  vtkIdType *pts = 0;
+  vtkIdType p1, p2;
+  double x1[3], x2[3], x3[3], l1[3], l2[3];
+  double CosFeatureAngle; //Cosine of angle between adjacent polys
+  double CosEdgeAngle; // Cosine of angle between adjacent edges
+  vtkIdType numSimple=0, numBEdges=0, numFixed=0, numFEdges=0;
+  vtkPolyData *inMesh, *Mesh;
+  vtkStaticCellLinks *links;
+  vtkPoints *inPts;
+  vtkTriangleFilter *toTris=NULL;
+  vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
+  vtkMeshVertexPtr Verts;
+
+  CosFeatureAngle = cos( vtkMath::RadiansFromDegrees( this->FeatureAngle) );
+  CosEdgeAngle =    cos( vtkMath::RadiansFromDegrees( this->EdgeAngle) );
+
   // Peform topological analysis. What we're gonna do is build a connectivity
   // array of connected vertices. The outcome will be one of three
   // classifications for a vertex: VTK_SIMPLE_VERTEX, VTK_FIXED_VERTEX. or
@@ -251,7 +588,6 @@ int vtkSmoothPolyDataFilter::RequestData(
     }
 
   inPts = input->GetPoints();
-  conv = this->Convergence * input->GetLength();
   
   // check vertices first. Vertices are never smoothed_--------------
   for (inVerts=input->GetVerts(), inVerts->InitTraversal(); 
@@ -336,7 +672,8 @@ int vtkSmoothPolyDataFilter::RequestData(
       Mesh = toTris->GetOutput();
       }
 
-    Mesh->BuildLinks(); //to do neighborhood searching
+    links = vtkStaticCellLinks::New(); //to do neighborhood searching
+    links->BuildLinks(Mesh);
     polys = Mesh->GetPolys();
     this->UpdateProgress(0.375);
 
@@ -359,7 +696,7 @@ int vtkSmoothPolyDataFilter::RequestData(
           Verts[p2].edges->Allocate(16,6);
           }
 
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
+        links->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
         numNei = neighbors->GetNumberOfIds();
 
         edge = VTK_SIMPLE_VERTEX;
@@ -438,13 +775,12 @@ int vtkSmoothPolyDataFilter::RequestData(
       }
 
     inMesh->Delete();
+    links->Delete();
     if (toTris) {toTris->Delete();}
     
     neighbors->Delete();
     }//if strips or polys
 
-  this->UpdateProgress(0.50);
-
   //post-process edge vertices to make sure we can smooth them
   for (i=0; i<numPts; i++)
     {
@@ -513,179 +849,33 @@ int vtkSmoothPolyDataFilter::RequestData(
                 << numBEdges << " boundary edge vertices\n\t"
                 << numFixed << " fixed vertices\n\t");
 
-  vtkDebugMacro(<<"Beginning smoothing iterations...");
-
-  // We've setup the topology...now perform Laplacian smoothing
-  //
-  newPts = vtkPoints::New();
-  newPts->SetNumberOfPoints(numPts);
-
-  // If Source defined, we do constrained smoothing (that is, points are 
-  // constrained to the surface of the mesh object).
-  if ( source )
-    {
-    this->SmoothPoints = new vtkSmoothPoints;
-    vtkSmoothPoint *sPtr;
-    cellLocator = vtkCellLocator::New();
-    w = new double[source->GetMaxCellSize()];
-    
-    cellLocator->SetDataSet(source);
-    cellLocator->BuildLocator();
-    
-    for (i=0; i < numPts; i++)
-      {
-      sPtr = this->SmoothPoints->InsertSmoothPoint(i);
-      cellLocator->FindClosestPoint(inPts->GetPoint(i), closestPt, 
-                                    sPtr->cellId, sPtr->subId, dist2);
-      newPts->SetPoint(i, closestPt);
-      }
-    }
-  else //smooth normally
-    {
-    for (i=0; i<numPts; i++) //initialize to old coordinates
-      {
-      newPts->SetPoint(i,inPts->GetPoint(i));
-      }
-    }
-
-  factor = this->RelaxationFactor;
-  for ( maxDist=VTK_DOUBLE_MAX, iterationNumber=0, abortExecute=0; 
-  maxDist > conv && iterationNumber < this->NumberOfIterations && !abortExecute;
-  iterationNumber++ )
-    {
-
-    if ( iterationNumber && !(iterationNumber % 5) )
-      {
-      this->UpdateProgress (0.5 + 0.5*iterationNumber/this->NumberOfIterations);
-      if (this->GetAbortExecute())
-        {
-        abortExecute = 1;
-        break;
-        }
-      }
-
-    maxDist=0.0;
-    for (i=0; i<numPts; i++) 
-      {
-      if ( Verts[i].type != VTK_FIXED_VERTEX && Verts[i].edges != NULL &&
-      (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-        {
-        newPts->GetPoint(i, x); //use current points
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-        for (j=0; j<npts; j++)
-          {
-          newPts->GetPoint(Verts[i].edges->GetId(j), y);
-          for (k=0; k<3; k++)
-            {
-            deltaX[k] += (y[k] - x[k]) / npts;
-            }
-          }//for all connected points
-
-        for (k=0;k<3;k++) 
-          {
-          xNew[k] = x[k] + factor * deltaX[k];
-          }
-
-        // Constrain point to surface
-        if ( source ) 
-          {
-          vtkSmoothPoint *sPtr = this->SmoothPoints->GetSmoothPoint(i);
-          vtkCell *cell=NULL;
-
-          if ( sPtr->cellId >= 0 ) //in cell
-            {
-            cell = source->GetCell(sPtr->cellId);
-            }
-
-          if ( !cell || cell->EvaluatePosition(xNew, closestPt,
-          sPtr->subId, sPtr->p, dist2, w) == 0)
-            { // not in cell anymore
-            cellLocator->FindClosestPoint(xNew, closestPt, sPtr->cellId, 
-                                          sPtr->subId, dist2);
-            }
-          for (k=0; k<3; k++)
-            {
-            xNew[k] = closestPt[k];
-            }
-          }
-
-        newPts->SetPoint(i,xNew);
-        if ( (dist = vtkMath::Norm(deltaX)) > maxDist )
-          {
-          maxDist = dist;
-          }
-        }//if can move point
-      }//for all points
-    } //for not converged or within iteration count
-
-  vtkDebugMacro(<<"Performed " << iterationNumber << " smoothing passes");
-  if ( source )
-    {
-    cellLocator->Delete();
-    delete this->SmoothPoints;
-    delete [] w;
-    }
-
-  // Update output. Only point coordinates have changed.
-  //
-  output->GetPointData()->PassData(input->GetPointData());
-  output->GetCellData()->PassData(input->GetCellData());
-
-  if ( this->GenerateErrorScalars )
+  // store the lists one after the other and free up connectivity storage
+  vtkSmoothPolyDataFilterAdjacency *adjacency = this->Adjacency;
+  adjacency->Types.resize(numPts);
+  adjacency->Offsets.resize(numPts+1);
+  adjacency->Ids.clear();
+  for (i=0; i<numPts; i++)
     {
-    vtkFloatArray *newScalars = vtkFloatArray::New();
-    newScalars->SetNumberOfTuples(numPts);
-    for (i=0; i<numPts; i++)
+    adjacency->Types[i] = Verts[i].type;
+    adjacency->Offsets[i] = static_cast<vtkIdType>(adjacency->Ids.size());
+    if ( Verts[i].edges != NULL )
       {
-      inPts->GetPoint(i,x1);
-      newPts->GetPoint(i,x2);
-      newScalars->SetComponent(i,0,
-                               sqrt(vtkMath::Distance2BetweenPoints(x1,x2)));
-      }
-    int idx = output->GetPointData()->AddArray(newScalars);
-    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    newScalars->Delete();
-    }
-
-  if ( this->GenerateErrorVectors )
-    {
-    vtkFloatArray *newVectors = vtkFloatArray::New();
-    newVectors->SetNumberOfComponents(3);
-    newVectors->SetNumberOfTuples(numPts);
-    for (i=0; i<numPts; i++)
-      {
-      inPts->GetPoint(i,x1);
-      newPts->GetPoint(i,x2);
-      for (j=0; j<3; j++)
+      for (j=0; j < Verts[i].edges->GetNumberOfIds(); j++)
         {
-        x3[j] = x2[j] - x1[j];
+        adjacency->Ids.push_back(Verts[i].edges->GetId(j));
         }
-      newVectors->SetTuple(i,x3);
-      }
-    output->GetPointData()->SetVectors(newVectors);
-    newVectors->Delete();
-    }
-
-  output->SetPoints(newPts);
-  newPts->Delete();
-
-  output->SetVerts(input->GetVerts());
-  output->SetLines(input->GetLines());
-  output->SetPolys(input->GetPolys());
-  output->SetStrips(input->GetStrips());
-
-  //free up connectivity storage
-  for (i=0; i<numPts; i++)
-    {
-    if ( Verts[i].edges != NULL ) 
-      {
       Verts[i].edges->Delete();
-      Verts[i].edges = NULL;
       }
     }
+  adjacency->Offsets[numPts] = static_cast<vtkIdType>(adjacency->Ids.size());
   delete [] Verts;
 
-  return 1;
+  adjacency->Input = input;
+  adjacency->FeatureEdgeSmoothing = this->FeatureEdgeSmoothing;
+  adjacency->FeatureAngle = this->FeatureAngle;
+  adjacency->EdgeAngle = this->EdgeAngle;
+  adjacency->BoundarySmoothing = this->BoundarySmoothing;
+  adjacency->BuildTime.Modified();
 }
 
 int vtkSmoothPolyDataFilter::FillInputPortInformation(int port,
@@ -716,6 +906,7 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Boundary Smoothing: " << (this->BoundarySmoothing ? "On\n" : "Off\n");
   os << indent << "Generate Error Scalars: " << (this->GenerateErrorScalars ? "On\n" : "Off\n");
   os << indent << "Generate Error Vectors: " << (this->GenerateErrorVectors ? "On\n" : "Off\n");
+  os << indent << "Use Thread Pool: " << (this->UseThreadPool ? "On\n" : "Off\n");
   if ( this->GetSource() )
     {
       os << indent << "Source: " << static_cast<void *>(this->GetSource()) << "\n";
@@ -75,6 +75,18 @@
 // second input: the Source. If defined, the input mesh is constrained to
 // lie on the surface defined by the Source ivar.
 //
+// The classification of the vertices and their lists of connected vertices
+// are kept from one execution to the next, and rebuilt only when the input
+// or the parameters of the classification change. Changing the number of
+// iterations, the relaxation factor or the convergence only reruns the
+// smoothing passes.
+//
+// When UseThreadPool is on and no Source is defined, the points are moved
+// in parallel on the workers of the vtkThreadPool. Each pass then reads
+// the positions of the previous pass only (a Jacobi rather than a
+// Gauss-Seidel iteration), so the result does not depend on the number of
+// threads but differs slightly from the serial result.
+//
 // .SECTION Caveats
 // 
 // The Laplacian operation reduces high frequency information in the geometry
@@ -93,6 +105,7 @@
 #include "vtkPolyDataAlgorithm.h"
 
 class vtkSmoothPoints;
+class vtkSmoothPolyDataFilterAdjacency;
 
 class VTK_GRAPHICS_EXPORT vtkSmoothPolyDataFilter : public vtkPolyDataAlgorithm
 {
@@ -169,14 +182,26 @@ public:
   // constrained to lie upon.
   void SetSource(vtkPolyData *source);
   vtkPolyData *GetSource();
+
+  // Description:
+  // Smooth the points in parallel with the vtkThreadPool, unless a Source
+  // is defined. Off by default.
+  vtkSetMacro(UseThreadPool,int);
+  vtkGetMacro(UseThreadPool,int);
+  vtkBooleanMacro(UseThreadPool,int);
   
 protected:
   vtkSmoothPolyDataFilter();
-  ~vtkSmoothPolyDataFilter() {};
+  ~vtkSmoothPolyDataFilter();
 
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  // Description:
+  // Classify the vertices of the input and build the lists of vertices
+  // they are smoothed with.
+  void BuildAdjacency(vtkPolyData *input);
+
   double Convergence;
   int NumberOfIterations;
   double RelaxationFactor;
@@ -186,8 +211,10 @@ protected:
   int BoundarySmoothing;
   int GenerateErrorScalars;
   int GenerateErrorVectors;
+  int UseThreadPool;
 
   vtkSmoothPoints *SmoothPoints;
+  vtkSmoothPolyDataFilterAdjacency *Adjacency;
 private:
   vtkSmoothPolyDataFilter(const vtkSmoothPolyDataFilter&);  // Not implemented.
   void operator=(const vtkSmoothPolyDataFilter&);  // Not implemented.
@@ -0,0 +1,528 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpatialReorderFilter.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
+
+vtkCxxRevisionMacro(vtkSpatialReorderFilter, "$Revision$");
+vtkStandardNewMacro(vtkSpatialReorderFilter);
+
+// Number of bits of each quantized coordinate in the curve keys.
+#define VTK_REORDER_KEY_BITS 21
+
+//----------------------------------------------------------------------------
+// An id with its curve key. Equal keys are ordered by id so that the
+// order does not depend on the sort.
+struct vtkSpatialReorderItem
+{
+  vtkTypeUInt64 Key;
+  vtkIdType Id;
+
+  bool operator<(const vtkSpatialReorderItem& item) const
+    {
+    if ( this->Key != item.Key )
+      {
+      return this->Key < item.Key;
+      }
+    return this->Id < item.Id;
+    }
+};
+
+//----------------------------------------------------------------------------
+// Turn the quantized coordinates into the transposed Hilbert index, after
+// J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707, 2004.
+// Interleaving the bits of the result gives the index along the curve.
+static void vtkSpatialReorderAxesToTranspose(vtkTypeUInt32 q[3])
+{
+  vtkTypeUInt32 m = 1 << (VTK_REORDER_KEY_BITS - 1), p, b, t;
+  int i;
+
+  // Inverse undo excess work
+  for (b = m; b > 1; b >>= 1)
+    {
+    p = b - 1;
+    for (i = 0; i < 3; i++)
+      {
+      if ( q[i] & b )
+        {
+        q[0] ^= p;
+        }
+      else
+        {
+        t = (q[0] ^ q[i]) & p;
+        q[0] ^= t;
+        q[i] ^= t;
+        }
+      }
+    }
+
+  // Gray encode
+  q[1] ^= q[0];
+  q[2] ^= q[1];
+  t = 0;
+  for (b = m; b > 1; b >>= 1)
+    {
+    if ( q[2] & b )
+      {
+      t ^= b - 1;
+      }
+    }
+  for (i = 0; i < 3; i++)
+    {
+    q[i] ^= t;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Quantize the positions over the bounds and compute their curve keys.
+class vtkSpatialReorderKeys
+{
+public:
+  const double *X;
+  vtkSpatialReorderItem *Items;
+  double Origin[3];
+  double Scale;
+  int CurveType;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    const double maxCoord = (1 << VTK_REORDER_KEY_BITS) - 1;
+    vtkTypeUInt32 q[3];
+    int i, b;
+    for (vtkIdType id = begin; id < end; id++)
+      {
+      const double *x = this->X + 3*id;
+      for (i = 0; i < 3; i++)
+        {
+        double c = (x[i] - this->Origin[i]) * this->Scale;
+        c = (c >= 0.0 ? (c <= maxCoord ? c : maxCoord) : 0.0);
+        q[i] = static_cast<vtkTypeUInt32>(c);
+        }
+      if ( this->CurveType == VTK_REORDER_HILBERT )
+        {
+        vtkSpatialReorderAxesToTranspose(q);
+        }
+      vtkTypeUInt64 key = 0;
+      for (b = VTK_REORDER_KEY_BITS - 1; b >= 0; b--)
+        {
+        for (i = 0; i < 3; i++)
+          {
+          key = (key << 1) | ((q[i] >> b) & 1);
+          }
+        }
+      this->Items[id].Key = key;
+      this->Items[id].Id = id;
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkSpatialReorderFilter::vtkSpatialReorderFilter()
+{
+  this->CurveType = VTK_REORDER_HILBERT;
+  this->ReorderPoints = 1;
+  this->ReorderCells = 1;
+  this->PassThroughPointIds = 1;
+  this->PassThroughCellIds = 1;
+  this->UseThreadPool = 0;
+}
+
+//----------------------------------------------------------------------------
+const char *vtkSpatialReorderFilter::GetCurveTypeAsString()
+{
+  if ( this->CurveType == VTK_REORDER_MORTON )
+    {
+    return "Morton";
+    }
+  return "Hilbert";
+}
+
+//----------------------------------------------------------------------------
+void vtkSpatialReorderFilter::SortAlongCurve(const double *x, vtkIdType n,
+                                             double bounds[6],
+                                             vtkIdType *order)
+{
+  if ( n < 1 )
+    {
+    return;
+    }
+
+  // The same scale on all axes keeps the cells of the curve cubic.
+  vtkSpatialReorderKeys keys;
+  double extent = 0.0;
+  for (int i = 0; i < 3; i++)
+    {
+    keys.Origin[i] = bounds[2*i];
+    if ( bounds[2*i+1] - bounds[2*i] > extent )
+      {
+      extent = bounds[2*i+1] - bounds[2*i];
+      }
+    }
+  keys.Scale = (extent > 0.0 ?
+                ((1 << VTK_REORDER_KEY_BITS) - 1) / extent : 0.0);
+  keys.CurveType = this->CurveType;
+  keys.X = x;
+
+  vtkstd::vector<vtkSpatialReorderItem> items(n);
+  keys.Items = &items[0];
+  if ( this->UseThreadPool )
+    {
+    vtkSMPTools::For(0, n, keys);
+    vtkSMPTools::Sort(&items[0], &items[0] + n);
+    }
+  else
+    {
+    keys(0, n);
+    vtkstd::sort(items.begin(), items.end());
+    }
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    order[i] = items[i].Id;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkCellArray *vtkSpatialReorderFilter::ReorderCellArray(
+  vtkCellArray *cells, vtkPoints *points, const vtkIdType *pointMap,
+  double bounds[6], vtkIdType *cellOrder)
+{
+  vtkIdType numCells = cells->GetNumberOfCells();
+  vtkIdType size = cells->GetNumberOfConnectivityEntries();
+  vtkCellArray *newCells = vtkCellArray::New();
+  vtkIdType *newConn = newCells->WritePointer(numCells, size);
+  vtkIdList *ptIds = vtkIdList::New();
+  vtkCellArrayCursor cursor;
+  const vtkIdType *pts;
+  vtkIdType cellId, npts, j;
+
+  // The input cells are read through a cursor: GetPointer() would convert
+  // cells kept as offsets back to the list.
+  if ( !cellOrder )
+    {
+    cells->InitTraversal(cursor);
+    while (cells->GetNextCell(cursor, npts, pts, ptIds))
+      {
+      *newConn++ = npts;
+      for (j = 0; j < npts; j++)
+        {
+        *newConn++ = (pointMap ? pointMap[pts[j]] : pts[j]);
+        }
+      }
+    ptIds->Delete();
+    return newCells;
+    }
+
+  // Order the cells by the average of their points.
+  vtkstd::vector<vtkIdType> locations(numCells);
+  vtkstd::vector<double> centers(3*numCells);
+  double x[3];
+  cells->InitTraversal(cursor);
+  for (cellId = 0; cellId < numCells; cellId++)
+    {
+    double *center = &centers[3*cellId];
+    locations[cellId] = cursor.Location;
+    cells->GetNextCell(cursor, npts, pts, ptIds);
+    center[0] = center[1] = center[2] = 0.0;
+    for (j = 0; j < npts; j++)
+      {
+      points->GetPoint(pts[j], x);
+      center[0] += x[0];
+      center[1] += x[1];
+      center[2] += x[2];
+      }
+    if ( npts > 0 )
+      {
+      center[0] /= npts;
+      center[1] /= npts;
+      center[2] /= npts;
+      }
+    }
+  if ( numCells > 0 )
+    {
+    this->SortAlongCurve(&centers[0], numCells, bounds, cellOrder);
+    }
+
+  for (cellId = 0; cellId < numCells; cellId++)
+    {
+    cells->GetCell(locations[cellOrder[cellId]], npts, pts, ptIds);
+    *newConn++ = npts;
+    for (j = 0; j < npts; j++)
+      {
+      *newConn++ = (pointMap ? pointMap[pts[j]] : pts[j]);
+      }
+    }
+  ptIds->Delete();
+  return newCells;
+}
+
+//----------------------------------------------------------------------------
+int vtkSpatialReorderFilter::RequestData(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkPointSet *input = vtkPointSet::GetData(inputVector[0]);
+  vtkPointSet *output = vtkPointSet::GetData(outputVector);
+  vtkPolyData *inPoly = vtkPolyData::SafeDownCast(input);
+  vtkUnstructuredGrid *inGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  vtkPointData *inPD = input->GetPointData();
+  vtkPointData *outPD = output->GetPointData();
+  vtkCellData *inCD = input->GetCellData();
+  vtkCellData *outCD = output->GetCellData();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType i;
+
+  vtkDebugMacro(<<"Reordering " << numPts << " points and "
+                << numCells << " cells");
+
+  if ( (!inPoly && !inGrid) || numPts < 1 )
+    {
+    output->ShallowCopy(input);
+    return 1;
+    }
+
+  double bounds[6];
+  input->GetBounds(bounds);
+  vtkPoints *inPts = input->GetPoints();
+
+  // Points: sort them, then copy them and their data in the new order.
+  vtkstd::vector<vtkIdType> pointOrder;
+  vtkstd::vector<vtkIdType> pointMap;
+  if ( this->ReorderPoints )
+    {
+    pointOrder.resize(numPts);
+    pointMap.resize(numPts);
+    vtkstd::vector<double> x(3*numPts);
+    for (i = 0; i < numPts; i++)
+      {
+      inPts->GetPoint(i, &x[3*i]);
+      }
+    this->SortAlongCurve(&x[0], numPts, bounds, &pointOrder[0]);
+
+    vtkPoints *newPts = vtkPoints::New(inPts->GetDataType());
+    newPts->SetNumberOfPoints(numPts);
+    outPD->CopyGlobalIdsOn();
+    outPD->CopyAllocate(inPD, numPts);
+    for (i = 0; i < numPts; i++)
+      {
+      pointMap[pointOrder[i]] = i;
+      newPts->SetPoint(i, &x[3*pointOrder[i]]);
+      outPD->CopyData(inPD, pointOrder[i], i);
+      }
+    output->SetPoints(newPts);
+    newPts->Delete();
+    }
+  else
+    {
+    output->SetPoints(inPts);
+    outPD->PassData(inPD);
+    }
+  this->UpdateProgress(0.5);
+
+  // Cells: sort them and rewrite their connectivity with the new point
+  // ids.
+  const vtkIdType *map = (this->ReorderPoints ? &pointMap[0] : NULL);
+  vtkstd::vector<vtkIdType> cellOrder;
+  if ( this->ReorderCells )
+    {
+    cellOrder.resize(numCells + 1);
+    }
+  if ( inPoly )
+    {
+    vtkPolyData *outPoly = vtkPolyData::SafeDownCast(output);
+    vtkCellArray *inCells[4];
+    inCells[0] = inPoly->GetVerts();
+    inCells[1] = inPoly->GetLines();
+    inCells[2] = inPoly->GetPolys();
+    inCells[3] = inPoly->GetStrips();
+    vtkIdType offset = 0;
+    for (int type = 0; type < 4; type++)
+      {
+      vtkIdType n = inCells[type]->GetNumberOfCells();
+      vtkIdType *order = (this->ReorderCells ? &cellOrder[offset] : NULL);
+      vtkCellArray *newCells =
+        this->ReorderCellArray(inCells[type], inPts, map, bounds, order);
+      for (i = 0; order && i < n; i++)
+        {
+        order[i] += offset;
+        }
+      switch (type)
+        {
+        case 0: outPoly->SetVerts(newCells); break;
+        case 1: outPoly->SetLines(newCells); break;
+        case 2: outPoly->SetPolys(newCells); break;
+        case 3: outPoly->SetStrips(newCells); break;
+        }
+      newCells->Delete();
+      offset += n;
+      }
+    }
+  else if ( inGrid->GetCells() )
+    {
+    vtkUnstructuredGrid *outGrid = vtkUnstructuredGrid::SafeDownCast(output);
+    vtkIdType *order = (this->ReorderCells ? &cellOrder[0] : NULL);
+    vtkCellArray *newCells =
+      this->ReorderCellArray(inGrid->GetCells(), inPts, map, bounds, order);
+    vtkUnsignedCharArray *newTypes = vtkUnsignedCharArray::New();
+    vtkIdTypeArray *newLocations = vtkIdTypeArray::New();
+    newTypes->SetNumberOfValues(numCells);
+    newLocations->SetNumberOfValues(numCells);
+    unsigned char *types = inGrid->GetCellTypesArray()->GetPointer(0);
+    vtkIdType *conn = newCells->GetPointer();
+    vtkIdType loc = 0;
+    for (i = 0; i < numCells; i++)
+      {
+      newTypes->SetValue(i, types[order ? order[i] : i]);
+      newLocations->SetValue(i, loc);
+      loc += conn[loc] + 1;
+      }
+
+    // The face lists of polyhedra follow their cells, with the new point
+    // ids.
+    vtkIdTypeArray *newFaces = NULL;
+    vtkIdTypeArray *newFaceLocations = NULL;
+    if ( inGrid->GetFaces() )
+      {
+      vtkIdType *faceLocs = inGrid->GetFaceLocations()->GetPointer(0);
+      vtkIdType numFaceLocs = inGrid->GetFaceLocations()->GetNumberOfTuples();
+      vtkIdType *faces = inGrid->GetFaces()->GetPointer(0);
+      newFaces = vtkIdTypeArray::New();
+      newFaces->Allocate(inGrid->GetFaces()->GetNumberOfTuples());
+      newFaceLocations = vtkIdTypeArray::New();
+      newFaceLocations->SetNumberOfValues(numCells);
+      for (i = 0; i < numCells; i++)
+        {
+        vtkIdType cellId = (order ? order[i] : i);
+        vtkIdType faceLoc = (cellId < numFaceLocs ? faceLocs[cellId] : -1);
+        if ( faceLoc < 0 )
+          {
+          newFaceLocations->SetValue(i, -1);
+          continue;
+          }
+        newFaceLocations->SetValue(i, newFaces->GetMaxId() + 1);
+        vtkIdType *face = faces + faceLoc;
+        vtkIdType nfaces = *face++;
+        newFaces->InsertNextValue(nfaces);
+        for (vtkIdType f = 0; f < nfaces; f++)
+          {
+          vtkIdType npts = *face++;
+          newFaces->InsertNextValue(npts);
+          for (vtkIdType j = 0; j < npts; j++, face++)
+            {
+            newFaces->InsertNextValue(map ? map[*face] : *face);
+            }
+          }
+        }
+      }
+
+    outGrid->SetCells(newTypes, newLocations, newCells,
+                      newFaceLocations, newFaces);
+    newCells->Delete();
+    newTypes->Delete();
+    newLocations->Delete();
+    if ( newFaces )
+      {
+      newFaces->Delete();
+      newFaceLocations->Delete();
+      }
+    }
+
+  if ( this->ReorderCells )
+    {
+    outCD->CopyGlobalIdsOn();
+    outCD->CopyAllocate(inCD, numCells);
+    for (i = 0; i < numCells; i++)
+      {
+      outCD->CopyData(inCD, cellOrder[i], i);
+      }
+    }
+  else
+    {
+    outCD->PassData(inCD);
+    }
+
+  // The permutations, to map the results back to the input.
+  if ( this->PassThroughPointIds )
+    {
+    vtkIdTypeArray *originalPointIds = vtkIdTypeArray::New();
+    originalPointIds->SetName("vtkOriginalPointIds");
+    originalPointIds->SetNumberOfValues(numPts);
+    for (i = 0; i < numPts; i++)
+      {
+      originalPointIds->SetValue(i, this->ReorderPoints ? pointOrder[i] : i);
+      }
+    outPD->AddArray(originalPointIds);
+    originalPointIds->Delete();
+    }
+  if ( this->PassThroughCellIds )
+    {
+    vtkIdTypeArray *originalCellIds = vtkIdTypeArray::New();
+    originalCellIds->SetName("vtkOriginalCellIds");
+    originalCellIds->SetNumberOfValues(numCells);
+    for (i = 0; i < numCells; i++)
+      {
+      originalCellIds->SetValue(i, this->ReorderCells ? cellOrder[i] : i);
+      }
+    outCD->AddArray(originalCellIds);
+    originalCellIds->Delete();
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSpatialReorderFilter::FillInputPortInformation(int,
+                                                      vtkInformation *info)
+{
+  info->Remove(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE());
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(),
+               "vtkUnstructuredGrid");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkSpatialReorderFilter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Curve Type: " << this->GetCurveTypeAsString() << "\n";
+  os << indent << "Reorder Points: "
+     << (this->ReorderPoints ? "On\n" : "Off\n");
+  os << indent << "Reorder Cells: "
+     << (this->ReorderCells ? "On\n" : "Off\n");
+  os << indent << "PassThroughPointIds: "
+     << (this->PassThroughPointIds ? "On\n" : "Off\n");
+  os << indent << "PassThroughCellIds: "
+     << (this->PassThroughCellIds ? "On\n" : "Off\n");
+  os << indent << "UseThreadPool: "
+     << (this->UseThreadPool ? "On\n" : "Off\n");
+}
@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSpatialReorderFilter - renumber points and cells along a space-filling curve
+// .SECTION Description
+// vtkSpatialReorderFilter renumbers the points and the cells of polygonal
+// data or of an unstructured grid in the order in which a Morton (Z-order)
+// or a Hilbert curve visits them, and permutes the point and cell data to
+// match. The geometry and the topology are unchanged: only the ids are.
+// Points and cells that are close in space get close ids, so that locators,
+// cell links and the downstream filters that walk the mesh touch memory
+// with better locality than with the order of a mesh generator.
+//
+// The points are ordered by the curve key of their coordinates quantized
+// over the bounds, and the cells by the key of the average of their points.
+// The cells of polygonal data stay grouped as vertices, lines, polygons and
+// strips; each group is reordered on its own. The face lists of polyhedra
+// follow their cells and are renumbered with the points. Keys are made of
+// 21 bits per axis and equal keys are kept in input order, so the output
+// does not depend on the number of threads.
+//
+// With PassThroughPointIds and PassThroughCellIds on, the output point
+// data and cell data have a vtkIdTypeArray named "vtkOriginalPointIds" and
+// "vtkOriginalCellIds" that give, for every output point and cell, its id
+// in the input, so results computed downstream can be mapped back.
+//
+// When UseThreadPool is on, the keys are computed and sorted in parallel on
+// the workers of the vtkThreadPool.
+//
+// .SECTION Caveats
+// Structured grids are not supported: their points are ordered implicitly.
+//
+// .SECTION See Also
+// vtkCleanPolyData vtkCellLinks
+
+#ifndef __vtkSpatialReorderFilter_h
+#define __vtkSpatialReorderFilter_h
+
+#include "vtkPointSetAlgorithm.h"
+
+#define VTK_REORDER_MORTON  0
+#define VTK_REORDER_HILBERT 1
+
+class vtkCellArray;
+class vtkPoints;
+
+class VTK_GRAPHICS_EXPORT vtkSpatialReorderFilter : public vtkPointSetAlgorithm
+{
+public:
+  static vtkSpatialReorderFilter *New();
+  vtkTypeRevisionMacro(vtkSpatialReorderFilter,vtkPointSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Specify the space-filling curve. The Hilbert curve never jumps between
+  // distant cells of the grid and gives slightly better locality; the
+  // Morton curve is cheaper to compute. The default is the Hilbert curve.
+  vtkSetClampMacro(CurveType,int,VTK_REORDER_MORTON,VTK_REORDER_HILBERT);
+  vtkGetMacro(CurveType,int);
+  void SetCurveTypeToMorton()
+    {this->SetCurveType(VTK_REORDER_MORTON);};
+  void SetCurveTypeToHilbert()
+    {this->SetCurveType(VTK_REORDER_HILBERT);};
+  const char *GetCurveTypeAsString();
+
+  // Description:
+  // Turn on/off the renumbering of the points and of the cells. Both are
+  // on by default.
+  vtkSetMacro(ReorderPoints,int);
+  vtkGetMacro(ReorderPoints,int);
+  vtkBooleanMacro(ReorderPoints,int);
+  vtkSetMacro(ReorderCells,int);
+  vtkGetMacro(ReorderCells,int);
+  vtkBooleanMacro(ReorderCells,int);
+
+  // Description:
+  // If on, the output point data and cell data hold the input id of every
+  // point and cell, in arrays named "vtkOriginalPointIds" and
+  // "vtkOriginalCellIds". Both are on by default.
+  vtkSetMacro(PassThroughPointIds,int);
+  vtkGetMacro(PassThroughPointIds,int);
+  vtkBooleanMacro(PassThroughPointIds,int);
+  vtkSetMacro(PassThroughCellIds,int);
+  vtkGetMacro(PassThroughCellIds,int);
+  vtkBooleanMacro(PassThroughCellIds,int);
+
+  // Description:
+  // Compute and sort the keys in parallel with the vtkThreadPool.
+  // Off by default.
+  vtkSetMacro(UseThreadPool,int);
+  vtkGetMacro(UseThreadPool,int);
+  vtkBooleanMacro(UseThreadPool,int);
+
+protected:
+  vtkSpatialReorderFilter();
+  ~vtkSpatialReorderFilter() {};
+
+  int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+  int FillInputPortInformation(int port, vtkInformation *info);
+
+  // Description:
+  // Return in order the ids of the n positions in the order of the curve,
+  // the positions being quantized over bounds.
+  void SortAlongCurve(const double *x, vtkIdType n, double bounds[6],
+                      vtkIdType *order);
+
+  // Description:
+  // Return the cells renumbered along the curve, with their point ids
+  // replaced through pointMap when it is not NULL. cellOrder receives the
+  // input index of every output cell; when it is NULL, the cells keep
+  // their order. The caller deletes the result.
+  vtkCellArray *ReorderCellArray(vtkCellArray *cells, vtkPoints *points,
+                                 const vtkIdType *pointMap,
+                                 double bounds[6], vtkIdType *cellOrder);
+
+  int CurveType;
+  int ReorderPoints;
+  int ReorderCells;
+  int PassThroughPointIds;
+  int PassThroughCellIds;
+  int UseThreadPool;
+
+private:
+  vtkSpatialReorderFilter(const vtkSpatialReorderFilter&);  // Not implemented.
+  void operator=(const vtkSpatialReorderFilter&);  // Not implemented.
+};
+
+#endif
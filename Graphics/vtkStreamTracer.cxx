@@ -42,8 +42,11 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 
+#include <vtkstd/vector>
+
 vtkCxxRevisionMacro(vtkStreamTracer, "$Revision$");
 vtkStandardNewMacro(vtkStreamTracer);
 vtkCxxSetObjectMacro(vtkStreamTracer,Integrator,vtkInitialValueProblemSolver);
@@ -78,6 +81,8 @@ vtkStreamTracer::vtkStreamTracer()
   this->GenerateNormalsInIntegrate = true;
 
   this->InterpolatorPrototype = 0;
+
+  this->UseThreadPool = 0;
   
   this->SetNumberOfInputPorts(2);
 
@@ -600,8 +605,307 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
                                 double& inPropagation,
                                 vtkIdType& inNumSteps)
 {
-  int i;
+  if (this->GetIntegrator() == 0)
+    {
+    vtkErrorMacro("No integrator is specified.");
+    return;
+    }
+
   vtkIdType numLines = seedIds->GetNumberOfIds();
+  int completed;
+  if (this->UseThreadPool && numLines > 1)
+    {
+    completed = this->IntegrateInParallel(input0, output, seedSource, seedIds,
+                                          integrationDirections, lastPoint,
+                                          func, maxCellSize, vecName,
+                                          inPropagation, inNumSteps);
+    }
+  else
+    {
+    completed = this->IntegrateSeeds(input0, output, seedSource, seedIds,
+                                     integrationDirections, 0, numLines,
+                                     lastPoint, func, maxCellSize, vecName,
+                                     inPropagation, inNumSteps, 1);
+    }
+
+  if (completed && output->GetNumberOfPoints() > 1 &&
+      this->GenerateNormalsInIntegrate)
+    {
+    this->GenerateNormals(output, 0, vecName);
+    }
+
+  output->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+// The streamlines of a chunk of consecutive seeds. LastPoint[0] keeps
+// VTK_DOUBLE_MAX when no streamline of the chunk left the domain.
+struct vtkStreamTracerPiece
+{
+  vtkPolyData *Output;
+  double LastPoint[3];
+  double Propagation;
+  vtkIdType NumSteps;
+};
+
+//----------------------------------------------------------------------------
+// Integrate the seeds [begin,end) with the velocity field of the calling
+// thread. The streamlines go in a polydata of their own, stored in the
+// piece of the first seed, so that the pieces can be merged in seed order.
+class vtkStreamTracerIntegrateSeeds
+{
+public:
+  vtkStreamTracer *Self;
+  vtkDataSet *Input0;
+  vtkDataArray *SeedSource;
+  vtkIdList *SeedIds;
+  vtkIntArray *IntegrationDirections;
+  vtkAbstractInterpolatedVelocityField **Functions;
+  int NumberOfThreads;
+  int MaxCellSize;
+  const char *VecName;
+  double Propagation;
+  vtkIdType NumSteps;
+  vtkStreamTracerPiece *Pieces;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkStreamTracerPiece &piece = this->Pieces[begin];
+    piece.Output = vtkPolyData::New();
+    piece.LastPoint[0] = VTK_DOUBLE_MAX;
+    piece.LastPoint[1] = piece.LastPoint[2] = 0.0;
+    // As in the serial integration, the propagation and the number of steps
+    // given by the caller only apply to the first seed.
+    piece.Propagation = (begin == 0 ? this->Propagation : 0.0);
+    piece.NumSteps = (begin == 0 ? this->NumSteps : 0);
+    // The seeds are integrated by the workers and the calling thread, whose
+    // index is beyond those of the workers unless it is a worker itself.
+    int index = vtkSMPTools::GetThreadIndex();
+    index = (index < this->NumberOfThreads ? index : this->NumberOfThreads);
+    this->Self->IntegrateSeeds(this->Input0, piece.Output, this->SeedSource,
+                               this->SeedIds, this->IntegrationDirections,
+                               begin, end, piece.LastPoint,
+                               this->Functions[index],
+                               this->MaxCellSize, this->VecName,
+                               piece.Propagation, piece.NumSteps, 0);
+    }
+};
+
+//----------------------------------------------------------------------------
+int vtkStreamTracer::IntegrateInParallel(
+  vtkDataSet *input0, vtkPolyData* output, vtkDataArray* seedSource,
+  vtkIdList* seedIds, vtkIntArray* integrationDirections, double lastPoint[3],
+  vtkAbstractInterpolatedVelocityField* func, int maxCellSize,
+  const char *vecName, double& inPropagation, vtkIdType& inNumSteps)
+{
+  vtkIdType numLines = seedIds->GetNumberOfIds();
+  int i, numThreads = vtkSMPTools::GetNumberOfThreads();
+
+  // Complete the lazy initialization of the inputs from this thread: the
+  // bounds, and the point locators and links built by the first search.
+  double x[3], pcoords[3], bounds[6], outside[3];
+  int subId, j;
+  outside[0] = outside[1] = outside[2] = VTK_DOUBLE_MIN;
+  vtkGenericCell *cell = vtkGenericCell::New();
+  vtkCompositeDataIterator* iter = this->InputData->NewIterator();
+  for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal();
+       iter->GoToNextItem())
+    {
+    vtkDataSet* inp = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (inp && inp->GetNumberOfCells() > 0)
+      {
+      vtkstd::vector<double> weights(inp->GetMaxCellSize() + 1);
+      double length = inp->GetLength();
+      inp->GetBounds(bounds);
+      inp->GetCenter(x);
+      inp->FindCell(x, 0, cell, -1, 0.0, subId, pcoords, &weights[0]);
+      inp->GetCell(0, cell);
+      for (j=0; j < 3; j++)
+        {
+        if (bounds[2*j+1] + length + 1.0 > outside[j])
+          {
+          outside[j] = bounds[2*j+1] + length + 1.0;
+          }
+        }
+      }
+    }
+  iter->Delete();
+  cell->Delete();
+
+  // Each worker integrates with its own copy of the velocity field, which
+  // keeps the cached cell of its current streamline. The calling thread
+  // uses func. Evaluating the fields once outside of all the inputs
+  // searches every dataset, which builds the cell locators of the fields
+  // that use one.
+  vtkstd::vector<vtkAbstractInterpolatedVelocityField*> funcs(numThreads+1);
+  double velocity[3];
+  for (i=0; i <= numThreads; i++)
+    {
+    if (i < numThreads)
+      {
+      int cellSize = 0;
+      this->CheckInputs(funcs[i], &cellSize);
+      }
+    else
+      {
+      funcs[i] = func;
+      }
+    funcs[i]->FunctionValues(outside, velocity);
+    funcs[i]->ClearLastCellId();
+    }
+
+  vtkstd::vector<vtkStreamTracerPiece> pieces(numLines);
+  for (vtkIdType line=0; line < numLines; line++)
+    {
+    pieces[line].Output = 0;
+    }
+
+  vtkStreamTracerIntegrateSeeds integrate;
+  integrate.Self = this;
+  integrate.Input0 = input0;
+  integrate.SeedSource = seedSource;
+  integrate.SeedIds = seedIds;
+  integrate.IntegrationDirections = integrationDirections;
+  integrate.Functions = &funcs[0];
+  integrate.NumberOfThreads = numThreads;
+  integrate.MaxCellSize = maxCellSize;
+  integrate.VecName = vecName;
+  integrate.Propagation = inPropagation;
+  integrate.NumSteps = inNumSteps;
+  integrate.Pieces = &pieces[0];
+
+  // Integrate the seeds by blocks, reporting progress in between. The
+  // streamlines vary a lot in length, so the blocks are split in small
+  // chunks that the workers pick up as they become available.
+  int abort = 0;
+  vtkIdType blockSize = numLines/20 + 1;
+  vtkIdType grain = blockSize/(4*numThreads) + 1;
+  for (vtkIdType first=0; first < numLines && !abort; first += blockSize)
+    {
+    vtkIdType last = (first + blockSize < numLines ?
+                      first + blockSize : numLines);
+    this->UpdateProgress(static_cast<double>(first)/numLines);
+    abort = this->GetAbortExecute();
+    if (!abort)
+      {
+      vtkSMPTools::For(first, last, grain, integrate);
+      }
+    }
+
+  for (i=0; i < numThreads; i++)
+    {
+    funcs[i]->Delete();
+    }
+
+  // Merge the pieces in seed order, so that the output does not depend on
+  // the number of threads.
+  vtkIdType numPtsTotal = 0;
+  vtkPolyData *firstPiece = 0;
+  vtkIdType line;
+  for (line=0; line < numLines; line++)
+    {
+    if (pieces[line].Output)
+      {
+      if (!firstPiece)
+        {
+        firstPiece = pieces[line].Output;
+        }
+      numPtsTotal += pieces[line].Output->GetNumberOfPoints();
+      }
+    }
+
+  if (!abort && firstPiece)
+    {
+    vtkPointData *outputPD = output->GetPointData();
+    outputPD->CopyAllocate(firstPiece->GetPointData(), numPtsTotal);
+    vtkPoints* outputPoints = vtkPoints::New();
+    outputPoints->Allocate(numPtsTotal);
+    vtkCellArray* outputLines = vtkCellArray::New();
+    vtkIntArray* retVals = vtkIntArray::New();
+    retVals->SetName("ReasonForTermination");
+
+    for (line=0; line < numLines; line++)
+      {
+      vtkStreamTracerPiece &piece = pieces[line];
+      if (!piece.Output)
+        {
+        continue;
+        }
+      vtkIdType offset = outputPoints->GetNumberOfPoints();
+      vtkIdType ptId, numPts = piece.Output->GetNumberOfPoints();
+      vtkPointData *pd = piece.Output->GetPointData();
+      for (ptId=0; ptId < numPts; ptId++)
+        {
+        piece.Output->GetPoint(ptId, x);
+        outputPoints->InsertNextPoint(x);
+        outputPD->CopyData(pd, ptId, offset + ptId);
+        }
+
+      vtkCellArray *lines = piece.Output->GetLines();
+      vtkIntArray *reasons = vtkIntArray::SafeDownCast(
+        piece.Output->GetCellData()->GetArray("ReasonForTermination"));
+      if (lines && reasons)
+        {
+        vtkIdType npts, *pts, cellId = 0;
+        for (lines->InitTraversal(); lines->GetNextCell(npts, pts); cellId++)
+          {
+          outputLines->InsertNextCell(npts);
+          for (ptId=0; ptId < npts; ptId++)
+            {
+            outputLines->InsertCellPoint(offset + pts[ptId]);
+            }
+          retVals->InsertNextValue(reasons->GetValue(cellId));
+          }
+        }
+
+      if (piece.LastPoint[0] != VTK_DOUBLE_MAX)
+        {
+        memcpy(lastPoint, piece.LastPoint, 3*sizeof(double));
+        }
+      inPropagation = piece.Propagation;
+      inNumSteps = piece.NumSteps;
+      }
+
+    output->SetPoints(outputPoints);
+    if (numPtsTotal > 1)
+      {
+      output->SetLines(outputLines);
+      output->GetCellData()->AddArray(retVals);
+      }
+    outputPoints->Delete();
+    outputLines->Delete();
+    retVals->Delete();
+    }
+
+  for (line=0; line < numLines; line++)
+    {
+    if (pieces[line].Output)
+      {
+      pieces[line].Output->Delete();
+      }
+    }
+
+  return !abort;
+}
+
+//----------------------------------------------------------------------------
+int vtkStreamTracer::IntegrateSeeds(vtkDataSet *input0,
+                                    vtkPolyData* output,
+                                    vtkDataArray* seedSource, 
+                                    vtkIdList* seedIds,
+                                    vtkIntArray* integrationDirections,
+                                    vtkIdType firstLine,
+                                    vtkIdType lastLine,
+                                    double lastPoint[3],
+                                    vtkAbstractInterpolatedVelocityField* func,
+                                    int maxCellSize,
+                                    const char *vecName,
+                                    double& inPropagation,
+                                    vtkIdType& inNumSteps,
+                                    int reportProgress)
+{
+  int i;
+  vtkIdType numLines = lastLine - firstLine;
   double propagation = inPropagation;
   vtkIdType numSteps = inNumSteps;
 
@@ -620,12 +924,6 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
     weights = new double[maxCellSize];
     }
 
-  if (this->GetIntegrator() == 0)
-    {
-    vtkErrorMacro("No integrator is specified.");
-    return;
-    }
-
   // Used in GetCell() 
   vtkGenericCell* cell = vtkGenericCell::New();
 
@@ -685,11 +983,14 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
 
   int shouldAbort = 0;
 
-  for(int currentLine = 0; currentLine < numLines; currentLine++)
+  for(vtkIdType currentLine = firstLine; currentLine < lastLine; currentLine++)
     {
 
-    double progress = static_cast<double>(currentLine)/numLines;
-    this->UpdateProgress(progress);
+    double progress = static_cast<double>(currentLine-firstLine)/numLines;
+    if (reportProgress)
+      {
+      this->UpdateProgress(progress);
+      }
 
     switch (integrationDirections->GetValue(currentLine))
       {
@@ -708,6 +1009,12 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
     // Clear the last cell to avoid starting a search from
     // the last point in the streamline
     func->ClearLastCellId();
+    if (!reportProgress)
+      {
+      // Start from the first dataset too, so that the line does not
+      // depend on the seeds integrated before by the same thread.
+      func->SetLastCellId(-1, 0);
+      }
 
     // Initial point
     seedSource->GetTuple(seedIds->GetId(currentLine), point1);
@@ -799,10 +1106,10 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
         break;
         }
 
-      if ( numSteps++ % 1000 == 1 )
+      if ( numSteps++ % 1000 == 1 && reportProgress )
         {
-        progress = 
-          ( currentLine + propagation / this->MaximumPropagation ) / numLines;
+        progress = ( currentLine - firstLine + 
+                     propagation / this->MaximumPropagation ) / numLines;
         this->UpdateProgress(progress);
 
         if (this->GetAbortExecute())
@@ -836,7 +1143,10 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
           }
         maxStep = stepSize.Interval;
         }
-      this->LastUsedStepSize = stepSize.Interval;
+      if (reportProgress)
+        {
+        this->LastUsedStepSize = stepSize.Interval;
+        }
           
       // Calculate the next step using the integrator provided
       // Break if the next point is out of bounds.
@@ -1002,11 +1312,6 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
       {
       // Assign geometry and attributes
       output->SetLines(outputLines);
-      if (this->GenerateNormalsInIntegrate)
-        {
-        this->GenerateNormals(output, 0, vecName);
-        }
-
       outputCD->AddArray(retVals);
       }
     }
@@ -1034,9 +1339,8 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
   cell->Delete();
 
   delete[] weights;
-  
-  output->Squeeze();
-  return;
+
+  return !shouldAbort;
 }
 
 void vtkStreamTracer::GenerateNormals(vtkPolyData* output, double* firstNormal, 
@@ -1249,6 +1553,8 @@ void vtkStreamTracer::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Vorticity computation: " 
      << (this->ComputeVorticity ? " On" : " Off") << endl;
   os << indent << "Rotation scale: " << this->RotationScale << endl;
+  os << indent << "Use Thread Pool: "
+     << (this->UseThreadPool ? "On\n" : "Off\n");
 }
 
 vtkExecutive* vtkStreamTracer::CreateDefaultExecutive()
@@ -67,6 +67,16 @@
 // a source object, traces will be generated from each point in the source
 // that is inside the dataset.
 //
+// When UseThreadPool is on, the streamlines of a source are integrated in
+// parallel on the vtkThreadPool (see vtkSMPTools). Each thread integrates
+// its seeds with its own copy of the velocity field interpolator, and thus
+// keeps its own cached cell (and its own cell locators when the
+// interpolator uses them). The streamlines are merged in seed order, so
+// the output does not depend on the number of threads. To this end, the
+// search for the first point of every streamline starts from the first
+// input, which may select a different block than the serial integration
+// where the blocks of a composite input overlap.
+//
 // .SECTION See Also
 // vtkRibbonFilter vtkRuledSurfaceFilter vtkInitialValueProblemSolver 
 // vtkRungeKutta2 vtkRungeKutta4 vtkRungeKutta45 vtkTemporalStreamTracer
@@ -286,6 +296,14 @@ public:
   // vtkPointSet::FindCell() coupled with vtkPointLocator).
   void SetInterpolatorType( int interpType );
 
+  // Description:
+  // Integrate the streamlines of a source in parallel with the
+  // vtkThreadPool. LastUsedStepSize is not updated in this mode.
+  // Off by default.
+  vtkSetMacro(UseThreadPool,int);
+  vtkGetMacro(UseThreadPool,int);
+  vtkBooleanMacro(UseThreadPool,int);
+
 protected:
 
   vtkStreamTracer();
@@ -314,6 +332,38 @@ protected:
                  const char *vecFieldName,
                  double& propagation,
                  vtkIdType& numSteps);
+  // Integrate the seeds [firstLine,lastLine) in output. Progress, abort
+  // and LastUsedStepSize are only handled when reportProgress is set; the
+  // other calls may run concurrently, each with its own func. Return 0
+  // when aborted.
+  int IntegrateSeeds(vtkDataSet *input,
+                     vtkPolyData* output,
+                     vtkDataArray* seedSource, 
+                     vtkIdList* seedIds,
+                     vtkIntArray* integrationDirections,
+                     vtkIdType firstLine,
+                     vtkIdType lastLine,
+                     double lastPoint[3],
+                     vtkAbstractInterpolatedVelocityField* func,
+                     int maxCellSize,
+                     const char *vecFieldName,
+                     double& propagation,
+                     vtkIdType& numSteps,
+                     int reportProgress);
+  int IntegrateInParallel(vtkDataSet *input,
+                          vtkPolyData* output,
+                          vtkDataArray* seedSource, 
+                          vtkIdList* seedIds,
+                          vtkIntArray* integrationDirections,
+                          double lastPoint[3],
+                          vtkAbstractInterpolatedVelocityField* func,
+                          int maxCellSize,
+                          const char *vecFieldName,
+                          double& propagation,
+                          vtkIdType& numSteps);
+//BTX
+  friend class vtkStreamTracerIntegrateSeeds;
+//ETX
   void SimpleIntegrate(double seed[3], 
                        double lastPoint[3], 
                        double stepSize,
@@ -374,6 +424,8 @@ protected:
 
   vtkCompositeDataSet* InputData;
 
+  int UseThreadPool;
+
 private:
   vtkStreamTracer(const vtkStreamTracer&);  // Not implemented.
   void operator=(const vtkStreamTracer&);  // Not implemented.
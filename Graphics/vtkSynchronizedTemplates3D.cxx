@@ -28,6 +28,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredPoints.h"
@@ -37,6 +38,7 @@
 #include "vtkUnsignedShortArray.h"
 
 #include <math.h>
+#include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkSynchronizedTemplates3D, "$Revision$");
 vtkStandardNewMacro(vtkSynchronizedTemplates3D);
@@ -58,6 +60,9 @@ vtkSynchronizedTemplates3D::vtkSynchronizedTemplates3D()
 
   this->ArrayComponent = 0;
 
+  this->UseThreadPool = 0;
+  this->SlabThickness = 16;
+
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
                                vtkDataSetAttributes::SCALARS);
@@ -247,16 +252,103 @@ if (ComputeScalars) \
   newScalars->InsertNextTuple(&value); \
 }
 
+//----------------------------------------------------------------------------
+// Output of the contouring of one extent. When the extent is a slab,
+// Bottom and Top receive the ids of the points generated on the x and y
+// edges of its first and last z planes (two ids per grid point and per
+// contour value, -1 where there is no point) so that the points shared
+// with the neighbor slabs can be merged.
+struct vtkSynchronizedTemplates3DPiece
+{
+  int Extent[6];
+  void *Pointer;
+  vtkPolyData *Output;
+  vtkFloatArray *Scalars;
+  vtkFloatArray *Normals;
+  vtkFloatArray *Gradients;
+  vtkstd::vector<int> Bottom;
+  vtkstd::vector<int> Top;
+
+  // Used to stitch the slabs: output id of every point of the piece,
+  // number of points that are not merged with the previous slab and
+  // offsets of these points and of the cells in the output.
+  vtkstd::vector<vtkIdType> PointMap;
+  vtkIdType NumberOfOwnedPoints;
+  vtkIdType PointOffset;
+  vtkIdType CellOffset;
+  vtkIdType ConnectivityOffset;
+};
+
+//----------------------------------------------------------------------------
+// Allocate the output of a piece with the scalars, normals and gradients
+// arrays requested by the filter. This registers shared objects (lookup
+// tables of the input arrays) and must not run concurrently.
+static void vtkSynchronizedTemplates3DAllocatePiece(
+  vtkSynchronizedTemplates3D *self, vtkImageData *data,
+  vtkDataArray *inScalars, vtkSynchronizedTemplates3DPiece *piece)
+{
+  vtkPolyData *output = piece->Output;
+  int idx;
+
+  piece->Scalars = NULL;
+  piece->Normals = NULL;
+  piece->Gradients = NULL;
+  if (self->GetComputeScalars())
+    {
+    piece->Scalars = vtkFloatArray::New();
+    }
+  if (self->GetComputeNormals())
+    {
+    piece->Normals = vtkFloatArray::New();
+    }
+  if (self->GetComputeGradients())
+    {
+    piece->Gradients = vtkFloatArray::New();
+    }
+  vtkSynchronizedTemplates3DInitializeOutput(piece->Extent, 
+                                             data, output, 
+                                             piece->Scalars, piece->Normals, 
+                                             piece->Gradients, inScalars);
+
+  // The output keeps the only reference to the new arrays.
+  if (piece->Scalars)
+    {
+    // Lets set the name of the scalars here.
+    if (inScalars)
+      {
+      piece->Scalars->SetName(inScalars->GetName());
+      }
+    idx = output->GetPointData()->AddArray(piece->Scalars);
+    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+    piece->Scalars->Delete();
+    }
+  if (piece->Gradients)
+    {
+    idx = output->GetPointData()->AddArray(piece->Gradients);
+    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::VECTORS);
+    piece->Gradients->Delete();
+    }
+  if (piece->Normals)
+    {
+    output->GetPointData()->SetNormals(piece->Normals);
+    piece->Normals->Delete();
+    }
+}
+
 //----------------------------------------------------------------------------
 //
-// Contouring filter specialized for images
+// Contouring filter specialized for images. The output of the piece must
+// have been allocated by vtkSynchronizedTemplates3DAllocatePiece(). Only
+// the objects of the piece are modified, so pieces can be contoured
+// concurrently when progress is not reported.
 //
 template <class T>
-void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
-                  vtkInformation *inInfo,
-                  vtkImageData *data, vtkPolyData *output, T *ptr, 
-                  vtkDataArray *inScalars)
+void ContourImage(vtkSynchronizedTemplates3D *self, int *wholeExt,
+                  vtkImageData *data, vtkSynchronizedTemplates3DPiece *piece,
+                  T *ptr, vtkDataArray *inScalars, int reportProgress)
 {
+  int *exExt = piece->Extent;
+  vtkPolyData *output = piece->Output;
   int *inExt = data->GetExtent();
   int xdim = exExt[1] - exExt[0] + 1;
   int ydim = exExt[3] - exExt[2] + 1;
@@ -268,7 +360,7 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
   int xInc, yInc, zInc;
   double *origin = data->GetOrigin();
   double *spacing = data->GetSpacing();
-  int *isect1Ptr, *isect2Ptr;
+  int *isect1Ptr, *isect2Ptr, *isectPlane;
   double y, z, t;
   int i, j, k;
   int zstep, yisectstep;
@@ -285,7 +377,6 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
   int v0, v1, v2, v3;
   vtkIdType ptIds[3];
   double value;
-  int *wholeExt;
   // We need to know the edgePointId's for interpolating attributes.
   int edgePtId, inCellId, outCellId;
   vtkPointData *inPD = data->GetPointData();
@@ -293,29 +384,13 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
   vtkPointData *outPD = output->GetPointData();  
   vtkCellData *outCD = output->GetCellData();  
   // Use to be arguments
-  vtkFloatArray *newScalars = NULL;
-  vtkFloatArray *newNormals = NULL;
-  vtkFloatArray *newGradients = NULL;
+  vtkFloatArray *newScalars = piece->Scalars;
+  vtkFloatArray *newNormals = piece->Normals;
+  vtkFloatArray *newGradients = piece->Gradients;
   vtkPoints *newPts;
   vtkCellArray *newPolys;
   ptr += self->GetArrayComponent();
   
-  if (ComputeScalars)
-    {
-    newScalars = vtkFloatArray::New();
-    }
-  if (ComputeNormals)
-    {
-    newNormals = vtkFloatArray::New();
-    }
-  if (ComputeGradients)
-    {
-    newGradients = vtkFloatArray::New();
-    }
-  vtkSynchronizedTemplates3DInitializeOutput(exExt, 
-                                             data, output, 
-                                             newScalars, newNormals, 
-                                             newGradients, inScalars);
   newPts = output->GetPoints();
   newPolys = output->GetPolys();
   
@@ -333,8 +408,6 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
   yInc = xInc*(inExt[1]-inExt[0]+1);
   zInc = yInc*(inExt[3]-inExt[2]+1);
 
-  wholeExt = inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
-  
   // Kens increments, probably to do with edge array
   zstep = xdim*ydim;
   yisectstep = xdim*3;
@@ -375,8 +448,11 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
     //==================================================================
     for (k = zMin; k <= zMax; k++)
       {
-      self->UpdateProgress((double)vidx/numContours + 
-                           (k-zMin)/((zMax - zMin+1.0)*numContours));
+      if (reportProgress)
+        {
+        self->UpdateProgress((double)vidx/numContours + 
+                             (k-zMin)/((zMax - zMin+1.0)*numContours));
+        }
       z = origin[2] + spacing[2]*k;
       x[2] = z;
 
@@ -399,6 +475,7 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
         isect1Ptr = isect1 + xdim*ydim*3;
         isect2Ptr = isect1;
         }
+      isectPlane = isect2Ptr;
 
       inPtrY = inPtrZ;
       for (j = yMin; j <= yMax; j++)
@@ -602,40 +679,361 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
           }
         inPtrY += yInc;
         }
+
+      // Keep the ids of the points on the x and y edges of the first and
+      // last planes of a slab.
+      int *seam = NULL;
+      if (k == zMin && !piece->Bottom.empty())
+        {
+        seam = &piece->Bottom[vidx*xdim*ydim*2];
+        }
+      else if (k == zMax && !piece->Top.empty())
+        {
+        seam = &piece->Top[vidx*xdim*ydim*2];
+        }
+      if (seam)
+        {
+        for (i = 0; i < xdim*ydim; i++)
+          {
+          seam[2*i] = isectPlane[3*i];
+          seam[2*i+1] = isectPlane[3*i+1];
+          }
+        }
       inPtrZ += zInc;
       }
     }
   delete [] isect1;
+}
 
-  if (newScalars)
+//----------------------------------------------------------------------------
+// Contour the slabs [begin, end).
+template <class T>
+class vtkSynchronizedTemplates3DContourFunctor
+{
+public:
+  vtkSynchronizedTemplates3D *Self;
+  int *WholeExtent;
+  vtkImageData *Data;
+  vtkDataArray *InScalars;
+  vtkSynchronizedTemplates3DPiece *Slabs;
+
+  void operator()(vtkIdType begin, vtkIdType end)
     {
-    // Lets set the name of the scalars here.
-    if (inScalars)
+    for (vtkIdType s = begin; s < end && !this->Self->GetAbortExecute(); ++s)
       {
-      newScalars->SetName(inScalars->GetName());
+      ContourImage(this->Self, this->WholeExtent, this->Data, this->Slabs + s,
+                   static_cast<T *>(this->Slabs[s].Pointer),
+                   this->InScalars, 0);
       }
-    idx = output->GetPointData()->AddArray(newScalars);
-    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    newScalars->Delete();
-    newScalars = NULL;
     }
-  if (newGradients)
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+static void vtkSynchronizedTemplates3DContourSlabs(
+  vtkSynchronizedTemplates3D *self, int *wholeExt, vtkImageData *data,
+  vtkDataArray *inScalars, vtkSynchronizedTemplates3DPiece *slabs,
+  int numSlabs, T *)
+{
+  vtkSynchronizedTemplates3DContourFunctor<T> functor;
+  functor.Self = self;
+  functor.WholeExtent = wholeExt;
+  functor.Data = data;
+  functor.InScalars = inScalars;
+  functor.Slabs = slabs;
+  vtkSMPTools::For(0, numSlabs, 1, functor);
+}
+
+//----------------------------------------------------------------------------
+// Find the points of slabs [begin, end) that are also generated by the
+// previous slab. Their entry in the PointMap is -2 - (index of the seam
+// entry), the other points get -1 and are counted as owned by the slab.
+class vtkSynchronizedTemplates3DSeamFunctor
+{
+public:
+  vtkSynchronizedTemplates3DPiece *Slabs;
+
+  void operator()(vtkIdType begin, vtkIdType end)
     {
-    idx = output->GetPointData()->AddArray(newGradients);
-    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::VECTORS);
-    newGradients->Delete();
-    newGradients = NULL;
+    for (vtkIdType s = begin; s < end; ++s)
+      {
+      vtkSynchronizedTemplates3DPiece *piece = this->Slabs + s;
+      vtkstd::vector<vtkIdType>& pointMap = piece->PointMap;
+      pointMap.assign(piece->Output->GetNumberOfPoints(), -1);
+      if (s > 0)
+        {
+        const vtkstd::vector<int>& top = this->Slabs[s-1].Top;
+        for (size_t i = 0; i < piece->Bottom.size(); ++i)
+          {
+          int id = piece->Bottom[i];
+          if (id >= 0 && top[i] >= 0 && pointMap[id] == -1)
+            {
+            pointMap[id] = -2 - static_cast<vtkIdType>(i);
+            }
+          }
+        }
+      piece->NumberOfOwnedPoints = 0;
+      for (size_t i = 0; i < pointMap.size(); ++i)
+        {
+        if (pointMap[i] == -1)
+          {
+          ++piece->NumberOfOwnedPoints;
+          }
+        }
+      }
     }
-  if (newNormals)
+};
+
+//----------------------------------------------------------------------------
+// Number the points owned by slabs [begin, end) from their PointOffset.
+class vtkSynchronizedTemplates3DNumberFunctor
+{
+public:
+  vtkSynchronizedTemplates3DPiece *Slabs;
+
+  void operator()(vtkIdType begin, vtkIdType end)
     {
-    output->GetPointData()->SetNormals(newNormals);
-    newNormals->Delete();
-    newNormals = NULL;
+    for (vtkIdType s = begin; s < end; ++s)
+      {
+      vtkSynchronizedTemplates3DPiece *piece = this->Slabs + s;
+      vtkIdType id = piece->PointOffset;
+      for (size_t i = 0; i < piece->PointMap.size(); ++i)
+        {
+        if (piece->PointMap[i] == -1)
+          {
+          piece->PointMap[i] = id++;
+          }
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Copy the owned points, the cells and their attributes of slabs
+// [begin, end) to their place in the output.
+class vtkSynchronizedTemplates3DCopyFunctor
+{
+public:
+  vtkSynchronizedTemplates3DPiece *Slabs;
+  vtkPolyData *Output;
+  vtkIdType *Connectivity;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkPoints *outPts = this->Output->GetPoints();
+    vtkPointData *outPD = this->Output->GetPointData();
+    vtkCellData *outCD = this->Output->GetCellData();
+    double x[3];
+    vtkIdType i, j;
+    int a;
+
+    for (vtkIdType s = begin; s < end; ++s)
+      {
+      vtkSynchronizedTemplates3DPiece *piece = this->Slabs + s;
+      vtkPolyData *slab = piece->Output;
+      vtkPoints *pts = slab->GetPoints();
+      vtkPointData *pd = slab->GetPointData();
+      vtkCellData *cd = slab->GetCellData();
+      const vtkstd::vector<vtkIdType>& pointMap = piece->PointMap;
+
+      // The points merged with the previous slab have smaller ids.
+      vtkIdType numPts = static_cast<vtkIdType>(pointMap.size());
+      for (i = 0; i < numPts; ++i)
+        {
+        vtkIdType id = pointMap[i];
+        if (id >= piece->PointOffset)
+          {
+          pts->GetPoint(i, x);
+          outPts->SetPoint(id, x);
+          for (a = 0; a < pd->GetNumberOfArrays(); ++a)
+            {
+            outPD->GetAbstractArray(a)->SetTuple(id, i,
+                                                 pd->GetAbstractArray(a));
+            }
+          }
+        }
+
+      vtkCellArray *polys = slab->GetPolys();
+      vtkIdType size = polys->GetNumberOfConnectivityEntries();
+      vtkIdType *cells = polys->GetPointer();
+      vtkIdType *outCells = this->Connectivity + piece->ConnectivityOffset;
+      for (i = 0; i < size; i += cells[i] + 1)
+        {
+        outCells[i] = cells[i];
+        for (j = 1; j <= cells[i]; ++j)
+          {
+          outCells[i+j] = pointMap[cells[i+j]];
+          }
+        }
+      vtkIdType numCells = polys->GetNumberOfCells();
+      for (i = 0; i < numCells; ++i)
+        {
+        for (a = 0; a < cd->GetNumberOfArrays(); ++a)
+          {
+          outCD->GetAbstractArray(a)->SetTuple(piece->CellOffset + i, i,
+                                               cd->GetAbstractArray(a));
+          }
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Create in to the arrays of from, with num tuples and the same attributes.
+static void vtkSynchronizedTemplates3DAllocateArrays(
+  vtkDataSetAttributes *from, vtkDataSetAttributes *to, vtkIdType num)
+{
+  int attributes[vtkDataSetAttributes::NUM_ATTRIBUTES];
+  from->GetAttributeIndices(attributes);
+  for (int i = 0; i < from->GetNumberOfArrays(); ++i)
+    {
+    vtkAbstractArray *fromArray = from->GetAbstractArray(i);
+    vtkAbstractArray *array = fromArray->NewInstance();
+    array->SetNumberOfComponents(fromArray->GetNumberOfComponents());
+    array->SetName(fromArray->GetName());
+    vtkDataArray *da = vtkDataArray::SafeDownCast(array);
+    if (da)
+      {
+      da->SetLookupTable(
+        vtkDataArray::SafeDownCast(fromArray)->GetLookupTable());
+      }
+    array->SetNumberOfTuples(num);
+    int idx = to->AddArray(array);
+    array->Delete();
+    for (int j = 0; j < vtkDataSetAttributes::NUM_ATTRIBUTES; ++j)
+      {
+      if (attributes[j] == i)
+        {
+        to->SetActiveAttribute(idx, j);
+        }
+      }
     }
 }
 
+//----------------------------------------------------------------------------
+// Contour the execute extent in slabs of SlabThickness cell layers on the
+// thread pool. Every slab is contoured into its own output and records the
+// ids of the points on its first and last planes. The points on the first
+// plane of a slab are merged with the same points of the previous slab,
+// then prefix sums over the slabs give the place of the remaining points
+// and of the cells in the output, where they are copied in parallel. The
+// result only depends on the slab decomposition.
+static void vtkSynchronizedTemplates3DExecuteSlabs(
+  vtkSynchronizedTemplates3D *self, vtkImageData *data, vtkPolyData *output,
+  int *exExt, int *wholeExt, vtkDataArray *inScalars)
+{
+  int thickness = self->GetSlabThickness();
+  int numSlabs = (exExt[5] - exExt[4] + thickness - 1) / thickness;
+  size_t seamSize = static_cast<size_t>(self->GetNumberOfContours()) * 2 *
+    (exExt[1] - exExt[0] + 1) * (exExt[3] - exExt[2] + 1);
+  vtkstd::vector<vtkSynchronizedTemplates3DPiece> slabs(numSlabs);
+  int s;
+
+  // Allocation registers shared objects and is done serially.
+  for (s = 0; s < numSlabs; ++s)
+    {
+    vtkSynchronizedTemplates3DPiece *piece = &slabs[s];
+    for (int i = 0; i < 4; ++i)
+      {
+      piece->Extent[i] = exExt[i];
+      }
+    piece->Extent[4] = exExt[4] + s*thickness;
+    piece->Extent[5] = piece->Extent[4] + thickness;
+    if (piece->Extent[5] > exExt[5])
+      {
+      piece->Extent[5] = exExt[5];
+      }
+    piece->Pointer = data->GetArrayPointerForExtent(inScalars, piece->Extent);
+    piece->Output = vtkPolyData::New();
+    if (s > 0)
+      {
+      piece->Bottom.resize(seamSize, -1);
+      }
+    if (s < numSlabs - 1)
+      {
+      piece->Top.resize(seamSize, -1);
+      }
+    vtkSynchronizedTemplates3DAllocatePiece(self, data, inScalars, piece);
+    }
+
+  self->UpdateProgress(0.0);
+  switch (inScalars->GetDataType())
+    {
+    vtkTemplateMacro(
+      vtkSynchronizedTemplates3DContourSlabs(self, wholeExt, data, inScalars,
+                                             &slabs[0], numSlabs,
+                                             static_cast<VTK_TT *>(0)));
+    }
+  self->UpdateProgress(0.8);
+
+  if (!self->GetAbortExecute())
+    {
+    // Merge the seams and number the points.
+    vtkSynchronizedTemplates3DSeamFunctor seams;
+    seams.Slabs = &slabs[0];
+    vtkSMPTools::For(0, numSlabs, 1, seams);
 
+    vtkIdType numPts = 0, numCells = 0, size = 0;
+    for (s = 0; s < numSlabs; ++s)
+      {
+      vtkCellArray *polys = slabs[s].Output->GetPolys();
+      slabs[s].PointOffset = numPts;
+      slabs[s].CellOffset = numCells;
+      slabs[s].ConnectivityOffset = size;
+      numPts += slabs[s].NumberOfOwnedPoints;
+      numCells += polys->GetNumberOfCells();
+      size += polys->GetNumberOfConnectivityEntries();
+      }
 
+    vtkSynchronizedTemplates3DNumberFunctor number;
+    number.Slabs = &slabs[0];
+    vtkSMPTools::For(0, numSlabs, 1, number);
+
+    // Merged points take the id of the point of the previous slab, which
+    // is final since the slabs are visited in order.
+    for (s = 1; s < numSlabs; ++s)
+      {
+      vtkstd::vector<vtkIdType>& pointMap = slabs[s].PointMap;
+      const vtkstd::vector<int>& bottom = slabs[s].Bottom;
+      const vtkstd::vector<int>& top = slabs[s-1].Top;
+      const vtkstd::vector<vtkIdType>& prevMap = slabs[s-1].PointMap;
+      for (size_t i = 0; i < bottom.size(); ++i)
+        {
+        if (bottom[i] >= 0 &&
+            pointMap[bottom[i]] == -2 - static_cast<vtkIdType>(i))
+          {
+          pointMap[bottom[i]] = prevMap[top[i]];
+          }
+        }
+      }
+
+    // Allocate the output and copy the slabs into it.
+    vtkPoints *newPts = vtkPoints::New();
+    newPts->SetNumberOfPoints(numPts);
+    output->SetPoints(newPts);
+    newPts->Delete();
+    vtkCellArray *newPolys = vtkCellArray::New();
+    vtkIdType *connectivity = newPolys->WritePointer(numCells, size);
+    output->SetPolys(newPolys);
+    newPolys->Delete();
+    vtkSynchronizedTemplates3DAllocateArrays(
+      slabs[0].Output->GetPointData(), output->GetPointData(), numPts);
+    vtkSynchronizedTemplates3DAllocateArrays(
+      slabs[0].Output->GetCellData(), output->GetCellData(), numCells);
+
+    vtkSynchronizedTemplates3DCopyFunctor copy;
+    copy.Slabs = &slabs[0];
+    copy.Output = output;
+    copy.Connectivity = connectivity;
+    vtkSMPTools::For(0, numSlabs, 1, copy);
+    }
+
+  for (s = 0; s < numSlabs; ++s)
+    {
+    slabs[s].Output->Delete();
+    }
+  self->UpdateProgress(1.0);
+}
 
 //----------------------------------------------------------------------------
 void vtkSynchronizedTemplates3D::SetInputMemoryLimit(
@@ -698,12 +1096,32 @@ void vtkSynchronizedTemplates3D::ThreadedExecute(vtkImageData *data,
     return;
     }
   
+  int *wholeExt = 
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
+
+  // Contour in slabs on the thread pool when there is more than one.
+  if (this->UseThreadPool && exExt[5] - exExt[4] > this->SlabThickness)
+    {
+    vtkSynchronizedTemplates3DExecuteSlabs(this, data, output, exExt,
+                                           wholeExt, inScalars);
+    return;
+    }
+
   ptr = data->GetArrayPointerForExtent(inScalars, exExt);
+  vtkSynchronizedTemplates3DPiece piece;
+  for (int i = 0; i < 6; i++)
+    {
+    piece.Extent[i] = exExt[i];
+    }
+  piece.Pointer = ptr;
+  piece.Output = output;
+  vtkSynchronizedTemplates3DAllocatePiece(this, data, inScalars, &piece);
+
   switch (inScalars->GetDataType())
     {
     vtkTemplateMacro(
-      ContourImage(this, exExt, inInfo, data, output, 
-                   (VTK_TT *)ptr, inScalars));
+      ContourImage(this, wholeExt, data, &piece, 
+                   (VTK_TT *)ptr, inScalars, 1));
     }
 }
 
@@ -857,6 +1275,8 @@ void vtkSynchronizedTemplates3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Compute Gradients: " << (this->ComputeGradients ? "On\n" : "Off\n");
   os << indent << "Compute Scalars: " << (this->ComputeScalars ? "On\n" : "Off\n");
   os << indent << "ArrayComponent: " << this->ArrayComponent << endl;
+  os << indent << "Use Thread Pool: " << (this->UseThreadPool ? "On\n" : "Off\n");
+  os << indent << "Slab Thickness: " << this->SlabThickness << endl;
 }
 
 
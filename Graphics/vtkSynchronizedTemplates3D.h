@@ -18,6 +18,12 @@
 // vtkSynchronizedTemplates3D is a 3D implementation of the synchronized 
 // template algorithm. Note that vtkContourFilter will automatically
 // use this class when appropriate.
+//
+// When UseThreadPool is on, the execute extent is split along z into slabs
+// of SlabThickness cell layers. The slabs are contoured concurrently by the
+// workers of the vtkThreadPool and stitched into a single output: the
+// points on the plane shared by two slabs are generated once. The output
+// depends on SlabThickness but not on the number of threads.
 
 // .SECTION Caveats
 // This filter is specialized to 3D images (aka volumes).
@@ -135,6 +141,21 @@ public:
   vtkSetMacro(ArrayComponent, int);
   vtkGetMacro(ArrayComponent, int);
 
+  // Description:
+  // Turn on/off contouring of the execute extent in slabs on the
+  // vtkThreadPool. Points and cells are ordered by slab, so the output
+  // differs from the serial one by a renumbering. Off by default.
+  vtkSetMacro(UseThreadPool, int);
+  vtkGetMacro(UseThreadPool, int);
+  vtkBooleanMacro(UseThreadPool, int);
+
+  // Description:
+  // Set/Get the number of cell layers along z of the slabs contoured in
+  // parallel when UseThreadPool is on. Thin slabs balance load better,
+  // thick slabs share fewer points. Default is 16.
+  vtkSetClampMacro(SlabThickness, int, 1, VTK_LARGE_INTEGER);
+  vtkGetMacro(SlabThickness, int);
+
 protected:
   vtkSynchronizedTemplates3D();
   ~vtkSynchronizedTemplates3D();
@@ -152,6 +173,9 @@ protected:
 
   int ArrayComponent;
 
+  int UseThreadPool;
+  int SlabThickness;
+
 private:
   vtkSynchronizedTemplates3D(const vtkSynchronizedTemplates3D&);  // Not implemented.
   void operator=(const vtkSynchronizedTemplates3D&);  // Not implemented.
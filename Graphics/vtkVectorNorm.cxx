@@ -21,12 +21,106 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
 
 #include <math.h>
 
 vtkCxxRevisionMacro(vtkVectorNorm, "$Revision$");
 vtkStandardNewMacro(vtkVectorNorm);
 
+// Vectors processed by one call of the functors.
+static const vtkIdType VTK_VECTOR_NORM_GRAIN = 10000;
+
+// Compute the norms of vectors [begin, end) and their maximum.
+class vtkVectorNormFunctor
+{
+public:
+  vtkDataArray *Vectors;
+  float *Scalars;
+  vtkSMPProgress<vtkVectorNorm> *Progress;
+  vtkSMPThreadLocal<double> LocalMax;
+  double MaxScalar;
+
+  void Initialize()
+    {
+    this->LocalMax.Local() = 0.0;
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    double v[3], s;
+    double& maxScalar = this->LocalMax.Local();
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->Vectors->GetTuple(i, v);
+      s = sqrt((double)v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+      if ( s > maxScalar )
+        {
+        maxScalar = s;
+        }
+      this->Scalars[i] = static_cast<float>(s);
+      }
+    this->Progress->Advance(end - begin);
+    }
+
+  void Reduce()
+    {
+    this->MaxScalar = 0.0;
+    for (vtkSMPThreadLocal<double>::iterator it = this->LocalMax.begin();
+         it != this->LocalMax.end(); ++it)
+      {
+      if ( *it > this->MaxScalar )
+        {
+        this->MaxScalar = *it;
+        }
+      }
+    }
+};
+
+// Divide scalars [begin, end) by Factor.
+class vtkVectorNormNormalizeFunctor
+{
+public:
+  float *Scalars;
+  double Factor;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->Scalars[i] = static_cast<float>(this->Scalars[i] / this->Factor);
+      }
+    }
+};
+
+// Fill newScalars with the (optionally normalized) norms of vectors.
+static void vtkVectorNormExecute(vtkDataArray *vectors,
+                                 vtkFloatArray *newScalars, int normalize,
+                                 vtkSMPProgress<vtkVectorNorm> *progress)
+{
+  vtkIdType numVectors = vectors->GetNumberOfTuples();
+  newScalars->SetNumberOfTuples(numVectors);
+  if ( numVectors < 1 )
+    {
+    return;
+    }
+
+  vtkVectorNormFunctor functor;
+  functor.Vectors = vectors;
+  functor.Scalars = newScalars->GetPointer(0);
+  functor.Progress = progress;
+  vtkSMPTools::Reduce(0, numVectors, VTK_VECTOR_NORM_GRAIN, functor);
+
+  // If necessary, normalize
+  if ( normalize && functor.MaxScalar > 0.0 )
+    {
+    vtkVectorNormNormalizeFunctor normalizer;
+    normalizer.Scalars = functor.Scalars;
+    normalizer.Factor = functor.MaxScalar;
+    vtkSMPTools::For(0, numVectors, VTK_VECTOR_NORM_GRAIN, normalizer);
+    }
+}
+
 // Construct with normalize flag off.
 vtkVectorNorm::vtkVectorNorm()
 {
@@ -49,10 +143,8 @@ int vtkVectorNorm::RequestData(
   vtkDataSet *output = vtkDataSet::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numVectors, i;
   int computePtScalars=1, computeCellScalars=1;
   vtkFloatArray *newScalars;
-  double v[3], s, maxScalar;
   vtkDataArray *ptVectors, *cellVectors;
   vtkPointData *pd=input->GetPointData(), *outPD=output->GetPointData();
   vtkCellData *cd=input->GetCellData(), *outCD=output->GetCellData();
@@ -81,43 +173,17 @@ int vtkVectorNorm::RequestData(
     return 1;
     }
 
+  // Progress goes over the point vectors, then the cell vectors
+  vtkSMPProgress<vtkVectorNorm> progress(
+    this, (computePtScalars ? ptVectors->GetNumberOfTuples() : 0) +
+    (computeCellScalars ? cellVectors->GetNumberOfTuples() : 0));
+
   // Allocate / operate on point data
-  int abort=0;
-  vtkIdType progressInterval;
   if ( computePtScalars )
     {
-    numVectors = ptVectors->GetNumberOfTuples();
+    vtkDebugMacro(<<"Computing point vector norms");
     newScalars = vtkFloatArray::New();
-    newScalars->SetNumberOfTuples(numVectors);
-
-    progressInterval=numVectors/10+1;
-    for (maxScalar=0.0, i=0; i < numVectors && !abort; i++)
-      {
-      ptVectors->GetTuple(i, v);
-      s = sqrt((double)v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
-      if ( s > maxScalar )
-        {
-        maxScalar = s;
-        }
-      newScalars->SetComponent(i,0,s);
-
-      if ( ! (i % progressInterval) ) 
-        {
-        vtkDebugMacro(<<"Computing point vector norm #" << i);
-        this->UpdateProgress (0.5*i/numVectors);
-        }
-      }
-
-    // If necessary, normalize
-    if ( this->Normalize && maxScalar > 0.0 )
-      {
-      for (i=0; i < numVectors; i++)
-        {
-        s = newScalars->GetComponent(i,0);
-        s /= maxScalar;
-        newScalars->SetComponent(i,0,s);
-        }
-      }
+    vtkVectorNormExecute(ptVectors, newScalars, this->Normalize, &progress);
 
     int idx = outPD->AddArray(newScalars);
     outPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
@@ -128,37 +194,9 @@ int vtkVectorNorm::RequestData(
   // Allocate / operate on cell data
   if ( computeCellScalars )
     {
-    numVectors = cellVectors->GetNumberOfTuples();
+    vtkDebugMacro(<<"Computing cell vector norms");
     newScalars = vtkFloatArray::New();
-    newScalars->SetNumberOfTuples(numVectors);
-
-    progressInterval=numVectors/10+1;
-    for (maxScalar=0.0, i=0; i < numVectors && !abort; i++)
-      {
-      cellVectors->GetTuple(i, v);
-      s = sqrt((double)v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
-      if ( s > maxScalar )
-        {
-        maxScalar = s;
-        }
-      newScalars->SetComponent(i,0,s);
-      if ( ! (i % progressInterval) ) 
-        {
-        vtkDebugMacro(<<"Computing cell vector norm #" << i);
-        this->UpdateProgress (0.5+0.5*i/numVectors);
-        }
-      }
-
-    // If necessary, normalize
-    if ( this->Normalize && maxScalar > 0.0 )
-      {
-      for (i=0; i < numVectors; i++)
-        {
-        s = newScalars->GetComponent(i,0);
-        s /= maxScalar;
-        newScalars->SetComponent(i,0,s);
-        }
-      }
+    vtkVectorNormExecute(cellVectors, newScalars, this->Normalize, &progress);
 
     int idx = outCD->AddArray(newScalars);
     outCD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
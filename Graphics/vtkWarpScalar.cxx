@@ -23,10 +23,63 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 
 vtkCxxRevisionMacro(vtkWarpScalar, "$Revision$");
 vtkStandardNewMacro(vtkWarpScalar);
 
+// Points processed by one call of the functor.
+static const vtkIdType VTK_WARP_SCALAR_GRAIN = 10000;
+
+//----------------------------------------------------------------------------
+// Displace points [begin, end). Several threads may run on disjoint ranges,
+// so data normals are read with the thread-safe GetTuple(id, tuple).
+class vtkWarpScalarFunctor
+{
+public:
+  vtkWarpScalar *Self;
+  vtkSMPProgress<vtkWarpScalar> *Progress;
+  vtkPoints *InPts;
+  vtkPoints *NewPts;
+  vtkDataArray *InScalars;
+  vtkDataArray *InNormals;
+  double *Normal;
+  double ScaleFactor;
+  int XYPlane;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    if (this->Self->GetAbortExecute())
+      {
+      return;
+      }
+    double x[3], normal[3], *n = this->Normal, s, newX[3];
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      this->InPts->GetPoint(ptId, x);
+      if (this->InNormals)
+        {
+        this->InNormals->GetTuple(ptId, normal);
+        n = normal;
+        }
+      if ( this->XYPlane )
+        {
+        s = x[2];
+        }
+      else
+        {
+        s = this->InScalars->GetComponent(ptId,0);
+        }
+      for (int i=0; i<3; i++)
+        {
+        newX[i] = x[i] + this->ScaleFactor * s * n[i];
+        }
+      this->NewPts->SetPoint(ptId, newX);
+      }
+    this->Progress->Advance(end - begin);
+    }
+};
+
 //----------------------------------------------------------------------------
 vtkWarpScalar::vtkWarpScalar()
 {
@@ -89,9 +142,7 @@ int vtkWarpScalar::RequestData(
   vtkDataArray *inScalars;
   vtkPoints *newPts;
   vtkPointData *pd;
-  int i;
-  vtkIdType ptId, numPts;
-  double x[3], *n, s, newX[3];
+  vtkIdType numPts;
   
   vtkDebugMacro(<<"Warping data with scalars");
 
@@ -130,35 +181,31 @@ int vtkWarpScalar::RequestData(
   newPts = vtkPoints::New();
   newPts->SetNumberOfPoints(numPts);
 
-  // Loop over all points, adjusting locations
+  // Loop over all points in parallel, adjusting locations
   //
-  for (ptId=0; ptId < numPts; ptId++)
+  vtkWarpScalarFunctor functor;
+  functor.Self = this;
+  functor.InPts = inPts;
+  functor.NewPts = newPts;
+  functor.InScalars = inScalars;
+  functor.InNormals = 0;
+  functor.Normal = 0;
+  if ( this->PointNormal == &vtkWarpScalar::DataNormal )
     {
-    if ( ! (ptId % 10000) ) 
-      {
-      this->UpdateProgress ((double)ptId/numPts);
-      if (this->GetAbortExecute())
-        {
-        break;
-        }
-      }
-
-    inPts->GetPoint(ptId, x);
-    n = (this->*(this->PointNormal))(ptId,inNormals);
-    if ( this->XYPlane )
-      {
-      s = x[2];
-      }
-    else
-      {
-      s = inScalars->GetComponent(ptId,0);
-      }
-    for (i=0; i<3; i++)
-      {
-      newX[i] = x[i] + this->ScaleFactor * s * n[i];
-      }
-    newPts->SetPoint(ptId, newX);
+    functor.InNormals = inNormals;
+    }
+  else
+    {
+    functor.Normal = (this->*(this->PointNormal))(0,inNormals);
     }
+  functor.ScaleFactor = this->ScaleFactor;
+  functor.XYPlane = this->XYPlane;
+  vtkSMPProgress<vtkWarpScalar> progress(this, numPts);
+  functor.Progress = &progress;
+
+  this->UpdateProgress(0.0);
+  vtkSMPTools::For(0, numPts, VTK_WARP_SCALAR_GRAIN, functor);
+  this->UpdateProgress(1.0);
 
   // Update ourselves and release memory
   //
@@ -21,6 +21,9 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSOADoubleArray.h"
+#include "vtkSOAFloatArray.h"
 
 vtkCxxRevisionMacro(vtkWarpVector, "$Revision$");
 vtkStandardNewMacro(vtkWarpVector);
@@ -40,52 +43,160 @@ vtkWarpVector::~vtkWarpVector()
 {
 }
 
+// Points processed by one call of the functor.
+static const vtkIdType VTK_WARP_VECTOR_GRAIN = 10000;
+
 //----------------------------------------------------------------------------
+// Displace points [begin, end). Several threads may run on disjoint ranges.
+// Component c of input tuple i is InPts[c][i*PtsStride[c]], which covers
+// interleaved arrays as well as arrays with one buffer per component.
 template <class T1, class T2>
-void vtkWarpVectorExecute2(vtkWarpVector *self, T1 *inPts, 
-                           T1 *outPts, T2 *inVec, vtkIdType max)
+class vtkWarpVectorFunctor
 {
-  vtkIdType ptId;
-  T1 scaleFactor = (T1)self->GetScaleFactor();
-  
-  // Loop over all points, adjusting locations
-  for (ptId=0; ptId < max; ptId++)
+public:
+  vtkWarpVector *Self;
+  vtkSMPProgress<vtkWarpVector> *Progress;
+  T1 *InPts[3];
+  vtkIdType PtsStride[3];
+  T1 *OutPts;
+  T2 *InVec[3];
+  vtkIdType VecStride[3];
+  T1 ScaleFactor;
+
+  void operator()(vtkIdType begin, vtkIdType end)
     {
-    if (!(ptId & 0xfff)) 
+    if (this->Self->GetAbortExecute())
       {
-      self->UpdateProgress ((double)ptId/(max+1));
-      if (self->GetAbortExecute())
+      return;
+      }
+    T1 *outPts = this->OutPts + 3*begin;
+    T1 scaleFactor = this->ScaleFactor;
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      for (int i = 0; i < 3; i++)
         {
-        break;
+        *outPts++ = this->InPts[i][ptId*this->PtsStride[i]] +
+          scaleFactor * (T1)(this->InVec[i][ptId*this->VecStride[i]]);
         }
       }
-    
-    *outPts = *inPts + scaleFactor * (T1)(*inVec);
-    outPts++; inPts++; inVec++;
-    *outPts = *inPts + scaleFactor * (T1)(*inVec);
-    outPts++; inPts++; inVec++;
-    *outPts = *inPts + scaleFactor * (T1)(*inVec);
-    outPts++; inPts++; inVec++;
+    this->Progress->Advance(end - begin);
+    }
+};
+
+//----------------------------------------------------------------------------
+// Same as above through the tuple API, for arrays that do not give access
+// to their memory.
+class vtkWarpVectorGenericFunctor
+{
+public:
+  vtkWarpVector *Self;
+  vtkSMPProgress<vtkWarpVector> *Progress;
+  vtkDataArray *InPts;
+  vtkDataArray *OutPts;
+  vtkDataArray *InVec;
+  double ScaleFactor;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    if (this->Self->GetAbortExecute())
+      {
+      return;
+      }
+    double x[3], v[3];
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      this->InPts->GetTuple(ptId, x);
+      this->InVec->GetTuple(ptId, v);
+      for (int i = 0; i < 3; i++)
+        {
+        x[i] += this->ScaleFactor * v[i];
+        }
+      this->OutPts->SetTuple(ptId, x);
+      }
+    this->Progress->Advance(end - begin);
+    }
+};
+
+//----------------------------------------------------------------------------
+// Find where the first three components of an array are stored. Return 0
+// if the array does not give access to its memory.
+static int vtkWarpVectorGetComponents(vtkDataArray *array, void *ptrs[3],
+                                      vtkIdType strides[3])
+{
+  int i;
+  if (array->HasStandardMemoryLayout())
+    {
+    char *base = static_cast<char *>(array->GetVoidPointer(0));
+    for (i = 0; i < 3; i++)
+      {
+      ptrs[i] = base + i*array->GetDataTypeSize();
+      strides[i] = array->GetNumberOfComponents();
+      }
+    return 1;
+    }
+  vtkSOAFloatArray *floats = vtkSOAFloatArray::SafeDownCast(array);
+  vtkSOADoubleArray *doubles = vtkSOADoubleArray::SafeDownCast(array);
+  for (i = 0; i < 3 && (floats || doubles); i++)
+    {
+    if (floats)
+      {
+      ptrs[i] = floats->GetComponentPointer(i);
+      strides[i] = floats->GetComponentStride(i);
+      }
+    else
+      {
+      ptrs[i] = doubles->GetComponentPointer(i);
+      strides[i] = doubles->GetComponentStride(i);
+      }
     }
+  return (floats || doubles);
+}
+
+//----------------------------------------------------------------------------
+template <class T1, class T2>
+void vtkWarpVectorExecute2(vtkWarpVector *self, void *inPts[3],
+                           vtkIdType ptsStride[3], T1 *outPts,
+                           T2 *, void *inVec[3], vtkIdType vecStride[3],
+                           vtkIdType max)
+{
+  vtkWarpVectorFunctor<T1, T2> functor;
+  functor.Self = self;
+  for (int i = 0; i < 3; i++)
+    {
+    functor.InPts[i] = static_cast<T1 *>(inPts[i]);
+    functor.PtsStride[i] = ptsStride[i];
+    functor.InVec[i] = static_cast<T2 *>(inVec[i]);
+    functor.VecStride[i] = vecStride[i];
+    }
+  functor.OutPts = outPts;
+  functor.ScaleFactor = (T1)self->GetScaleFactor();
+  vtkSMPProgress<vtkWarpVector> progress(self, max);
+  functor.Progress = &progress;
+
+  // Loop over all points in parallel, adjusting locations
+  self->UpdateProgress(0.0);
+  vtkSMPTools::For(0, max, VTK_WARP_VECTOR_GRAIN, functor);
+  self->UpdateProgress(1.0);
 }
           
 //----------------------------------------------------------------------------
 template <class T>
 void vtkWarpVectorExecute(vtkWarpVector *self, 
-                          T *inPts, 
+                          void *inPts[3],
+                          vtkIdType ptsStride[3],
                           T *outPts, 
                           vtkIdType max,
-                          vtkDataArray *vectors)
+                          vtkDataArray *vectors,
+                          void *inVec[3],
+                          vtkIdType vecStride[3])
 {
-  void *inVec;
-  inVec = vectors->GetVoidPointer(0);
-
   // call templated function
   switch (vectors->GetDataType())
     {
     vtkTemplateMacro(
-      vtkWarpVectorExecute2(self, inPts, outPts, 
-                            (VTK_TT *)(inVec), max));
+      vtkWarpVectorExecute2(self, inPts, ptsStride, outPts,
+                            static_cast<VTK_TT *>(0), inVec, vecStride,
+                            max));
     default:
       break;
     }  
@@ -136,17 +247,39 @@ int vtkWarpVector::RequestData(
   output->SetPoints(points);
   points->Delete();
 
-  void *inPtr = input->GetPoints()->GetVoidPointer(0);
-  void *outPtr = output->GetPoints()->GetVoidPointer(0);
+  // Read the inputs in place, whatever their memory layout.
+  void *inPtr[3], *inVec[3];
+  vtkIdType ptsStride[3], vecStride[3];
+  vtkDataArray *inPts = input->GetPoints()->GetData();
+  if (vtkWarpVectorGetComponents(inPts, inPtr, ptsStride) &&
+      vtkWarpVectorGetComponents(vectors, inVec, vecStride))
+    {
+    void *outPtr = output->GetPoints()->GetVoidPointer(0);
 
-  // call templated function
-  switch (input->GetPoints()->GetDataType())
+    // call templated function
+    switch (input->GetPoints()->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkWarpVectorExecute( this, inPtr, ptsStride,
+                              (VTK_TT *)(outPtr), numPts, vectors,
+                              inVec, vecStride) );
+      default:
+        break;
+      }
+    }
+  else
     {
-    vtkTemplateMacro(
-      vtkWarpVectorExecute( this, (VTK_TT *)(inPtr), 
-                            (VTK_TT *)(outPtr), numPts, vectors) );
-    default:
-      break;
+    vtkWarpVectorGenericFunctor functor;
+    functor.Self = this;
+    functor.InPts = inPts;
+    functor.OutPts = output->GetPoints()->GetData();
+    functor.InVec = vectors;
+    functor.ScaleFactor = this->ScaleFactor;
+    vtkSMPProgress<vtkWarpVector> progress(this, numPts);
+    functor.Progress = &progress;
+    this->UpdateProgress(0.0);
+    vtkSMPTools::For(0, numPts, VTK_WARP_VECTOR_GRAIN, functor);
+    this->UpdateProgress(1.0);
     }
   
   // now pass the data.
@@ -24,12 +24,51 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 
+#include <vtkstd/vector>
+
 vtkCxxRevisionMacro(vtkWindowedSincPolyDataFilter, "$Revision$");
 vtkStandardNewMacro(vtkWindowedSincPolyDataFilter);
 
+// The classification of the vertices and, for every vertex, the ids of
+// the points it is smoothed with, stored contiguously: the neighbors of
+// point i are Ids[Offsets[i]] to Ids[Offsets[i+1]-1]. They are kept across
+// executions and rebuilt only when the input or the parameters of the
+// classification change.
+class vtkWindowedSincPolyDataFilterAdjacency { //;prevent man page generation
+public:
+  vtkWindowedSincPolyDataFilterAdjacency() : Input(NULL) {};
+
+  int IsCurrent(vtkPolyData *input, int featureEdgeSmoothing,
+                double featureAngle, double edgeAngle, int boundarySmoothing,
+                int nonManifoldSmoothing)
+    {
+    return input == this->Input &&
+      input->GetMTime() < this->BuildTime.GetMTime() &&
+      featureEdgeSmoothing == this->FeatureEdgeSmoothing &&
+      featureAngle == this->FeatureAngle &&
+      edgeAngle == this->EdgeAngle &&
+      boundarySmoothing == this->BoundarySmoothing &&
+      nonManifoldSmoothing == this->NonManifoldSmoothing;
+    }
+
+  vtkstd::vector<char> Types;
+  vtkstd::vector<vtkIdType> Offsets;
+  vtkstd::vector<vtkIdType> Ids;
+
+  vtkPolyData *Input; // compared only, never dereferenced
+  int FeatureEdgeSmoothing;
+  double FeatureAngle;
+  double EdgeAngle;
+  int BoundarySmoothing;
+  int NonManifoldSmoothing;
+  vtkTimeStamp BuildTime;
+};
+
 // Construct object with number of iterations 20; passband .1;
 // feature edge smoothing turned off; feature 
 
@@ -51,6 +90,14 @@ vtkWindowedSincPolyDataFilter::vtkWindowedSincPolyDataFilter()
   this->GenerateErrorVectors = 0;
 
   this->NormalizeCoordinates = 0;
+
+  this->UseThreadPool = 0;
+  this->Adjacency = new vtkWindowedSincPolyDataFilterAdjacency;
+}
+
+vtkWindowedSincPolyDataFilter::~vtkWindowedSincPolyDataFilter()
+{
+  delete this->Adjacency;
 }
 
 #define VTK_SIMPLE_VERTEX 0
@@ -64,7 +111,118 @@ typedef struct _vtkMeshVertex
   char      type;
   vtkIdList *edges; // connected edges (list of connected point ids)
 } vtkMeshVertex, *vtkMeshVertexPtr;
-    
+
+// One term of the Chebyshev expansion of the filter, over the points
+// [begin, end). The first pass reads X0 and writes X1 and X3; the next
+// ones read X0 and X1 and write X2 and X3. No pass reads what it writes,
+// so the points can be processed in any order.
+class vtkWindowedSincPolyDataFilterPass
+{
+public:
+  const char *Types;
+  const vtkIdType *Offsets;
+  const vtkIdType *Ids;
+  const double *C;
+  int IterationNumber;
+  float *X0;
+  float *X1;
+  float *X2;
+  float *X3;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    double x[3], y[3], deltaX[3], xNew[3], p_x0[3], p_x1[3];
+    vtkIdType i, j, npts;
+    int k;
+    for (i=begin; i<end; i++)
+      {
+      if ( (npts = this->Offsets[i+1] - this->Offsets[i]) == 0 )
+        {
+        // point is not allowed to move, just use the old point...
+        // (zero out the Laplacian; X1 was zeroed by the previous pass)
+        for (k=0; k<3; k++)
+          {
+          if ( this->IterationNumber == 1 )
+            {
+            this->X1[3*i+k] = 0.0f;
+            this->X3[3*i+k] = this->X0[3*i+k];
+            }
+          else
+            {
+            this->X2[3*i+k] = 0.0f;
+            }
+          }
+        continue;
+        }
+
+      const vtkIdType *edges = this->Ids + this->Offsets[i];
+      if ( this->IterationNumber == 1 )
+        {
+        for (k=0; k<3; k++)
+          {
+          x[k] = this->X0[3*i+k];
+          deltaX[k] = 0.0;
+          }
+        // calculate the negative of the laplacian
+        for (j=0; j<npts; j++)
+          {
+          for (k=0; k<3; k++)
+            {
+            y[k] = this->X0[3*edges[j]+k];
+            deltaX[k] += (x[k] - y[k]) / npts;
+            }
+          }
+        // X1 = X0 - 0.5 laplacian
+        for (k=0; k<3; k++)
+          {
+          deltaX[k] = x[k] - 0.5*deltaX[k];
+          this->X1[3*i+k] = static_cast<float>(deltaX[k]);
+          }
+        // X3 = c0 X0 + c1 X1
+        for (k=0; k<3; k++)
+          {
+          deltaX[k] = this->C[0]*x[k] + this->C[1]*deltaX[k];
+          this->X3[3*i+k] = (this->Types[i] == VTK_FIXED_VERTEX ?
+                             this->X0[3*i+k] :
+                             static_cast<float>(deltaX[k]));
+          }
+        continue;
+        }
+
+      for (k=0; k<3; k++)
+        {
+        p_x0[k] = this->X0[3*i+k];
+        p_x1[k] = this->X1[3*i+k];
+        deltaX[k] = 0.0;
+        }
+      // calculate the negative laplacian of x1
+      for (j=0; j<npts; j++)
+        {
+        for (k=0; k<3; k++)
+          {
+          y[k] = this->X1[3*edges[j]+k];
+          deltaX[k] += (p_x1[k] - y[k]) / npts;
+          }
+        }
+      // Taubin:  x2 = (x1 - x0) + (x1 - x2)
+      for (k=0; k<3; k++)
+        {
+        deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
+        this->X2[3*i+k] = static_cast<float>(deltaX[k]);
+        }
+      // smooth the vertex (x3 = x3 + cj x2)
+      if ( this->Types[i] != VTK_FIXED_VERTEX )
+        {
+        for (k=0; k<3; k++)
+          {
+          xNew[k] = this->X3[3*i+k] + this->C[this->IterationNumber]*deltaX[k];
+          this->X3[3*i+k] = static_cast<float>(xNew[k]);
+          }
+        }
+      }
+    }
+};
+
 int vtkWindowedSincPolyDataFilter::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -80,26 +238,15 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   vtkPolyData *output = vtkPolyData::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts, numCells, numPolys, numStrips, i;
-  int j, k;
-  vtkIdType npts = 0;
-  vtkIdType *pts = 0;
-  vtkIdType p1, p2;
-  double x[3], y[3], deltaX[3], xNew[3];
-  double x1[3], x2[3], x3[3], l1[3], l2[3];
-  double CosFeatureAngle; //Cosine of angle between adjacent polys
-  double CosEdgeAngle; // Cosine of angle between adjacent edges
+  vtkIdType numPts, numCells, i;
+  int j;
+  double x1[3], x2[3], x3[3];
   int iterationNumber, abortExecute;
-  vtkIdType numSimple=0, numBEdges=0, numFixed=0, numFEdges=0;
-  vtkPolyData *inMesh = NULL, *Mesh;
   vtkPoints *inPts;
-  vtkTriangleFilter *toTris=NULL;
-  vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints *newPts[4];
-  vtkMeshVertexPtr Verts;
 
   // variables specific to windowed sinc interpolation
-  double theta_pb, k_pb, sigma, p_x0[3], p_x1[3], p_x3[3];
+  double theta_pb, k_pb, sigma;
   double *w, *c, *cprime;
   int zero, one, two, three;
   
@@ -114,9 +261,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     return 1;
     }
 
-  CosFeatureAngle = cos( vtkMath::RadiansFromDegrees( this->FeatureAngle) );
-  CosEdgeAngle    = cos( vtkMath::RadiansFromDegrees( this->EdgeAngle) );
-
   vtkDebugMacro(<<"Smoothing " << numPts << " vertices, " << numCells 
                << " cells with:\n"
                << "\tIterations= " << this->NumberOfIterations << "\n"
@@ -142,369 +286,100 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     return 1;
     }
 //
-// Peform topological analysis. What we're gonna do is build a connectivity
-// array of connected vertices. The outcome will be one of three
-// classifications for a vertex: VTK_SIMPLE_VERTEX, VTK_FIXED_VERTEX. or
-// VTK_EDGE_VERTEX. Simple vertices are smoothed using all connected 
-// vertices. FIXED vertices are never smoothed. Edge vertices are smoothed
-// using a subset of the attached vertices.
+// Peform topological analysis, unless the input and the classification
+// are those of the previous execution.
 //
-  vtkDebugMacro(<<"Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
-  for (i=0; i<numPts; i++)
+  if ( !this->Adjacency->IsCurrent(input, this->FeatureEdgeSmoothing,
+                                   this->FeatureAngle, this->EdgeAngle,
+                                   this->BoundarySmoothing,
+                                   this->NonManifoldSmoothing) )
     {
-    Verts[i].type = VTK_SIMPLE_VERTEX; //can smooth
-    Verts[i].edges = NULL;
+    this->BuildAdjacency(input);
     }
+  this->UpdateProgress(0.50);
 
+  const char *types = &this->Adjacency->Types[0];
+  const vtkIdType *offsets = &this->Adjacency->Offsets[0];
+  const vtkIdType *ids = this->Adjacency->Ids.empty() ? NULL :
+    &this->Adjacency->Ids[0];
   inPts = input->GetPoints();
-  
-  // check vertices first. Vertices are never smoothed_--------------
-  for (inVerts=input->GetVerts(), inVerts->InitTraversal(); 
-  inVerts->GetNextCell(npts,pts); )
+
+//
+// Perform Windowed Sinc function interpolation
+//
+  vtkDebugMacro(<<"Beginning smoothing iterations...");
+
+  // need 4 vectors of points
+  zero=0; one=1; two=2; three=3;
+
+  newPts[0] = vtkPoints::New();
+  newPts[0]->SetNumberOfPoints(numPts);
+  newPts[1] = vtkPoints::New();
+  newPts[1]->SetNumberOfPoints(numPts);
+  newPts[2] = vtkPoints::New();
+  newPts[2]->SetNumberOfPoints(numPts);
+  newPts[3] = vtkPoints::New();
+  newPts[3]->SetNumberOfPoints(numPts);
+
+  // Get the center and length of the input dataset
+  double *inCenter = input->GetCenter();
+  double inLength = input->GetLength();
+
+  if (!this->NormalizeCoordinates)
     {
-    for (j=0; j<npts; j++)
+    for (i=0; i<numPts; i++) //initialize to old coordinates
       {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      newPts[zero]->SetPoint(i,inPts->GetPoint(i));
       }
     }
-
-  this->UpdateProgress(0.10);
-
-  // now check lines. Only manifold lines can be smoothed------------
-  for (inLines=input->GetLines(), inLines->InitTraversal(); 
-  inLines->GetNextCell(npts,pts); )
+  else
     {
-    for (j=0; j<npts; j++)
+    // center the data and scale to be within unit cube [-1, 1]
+    double normalizedPoint[3];
+    for (i=0; i<numPts; i++) //initialize to old coordinates
       {
-      if ( Verts[pts[j]].type == VTK_SIMPLE_VERTEX )
+      inPts->GetPoint(i, normalizedPoint);
+      for (j=0; j<3; ++j)
         {
-        if ( j == (npts-1) ) //end-of-line marked FIXED
-          {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
-          }
-        else if ( j == 0 ) //beginning-of-line marked FIXED
-          {
-          Verts[pts[0]].type = VTK_FIXED_VERTEX;
-          inPts->GetPoint(pts[0],x2);
-          inPts->GetPoint(pts[1],x3);
-          }
-        else //is edge vertex (unless already edge vertex!)
-          {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          //Verts[pts[j]].edges = new vtkIdList(2,2);
-          Verts[pts[j]].edges->SetId(0,pts[j-1]);
-          Verts[pts[j]].edges->SetId(1,pts[j+1]);
-          }
-        } //if simple vertex
-
-      else if ( Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX )
-        { //multiply connected, becomes fixed!
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = NULL;
+        normalizedPoint[j] = (normalizedPoint[j] - inCenter[j]) / inLength;
         }
+      newPts[zero]->SetPoint(i,normalizedPoint);
+      }
+    }
 
-      } //for all points in this line
-    } //for all lines
-
-  this->UpdateProgress(0.25);
-
-  // now polygons and triangle strips-------------------------------
-  inPolys=input->GetPolys();
-  numPolys = inPolys->GetNumberOfCells();
-  inStrips=input->GetStrips();
-  numStrips = inStrips->GetNumberOfCells();
-
-  if ( numPolys > 0 || numStrips > 0 )
-    { //build cell structure
-    vtkCellArray *polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    vtkIdType *neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList *neighbors;
+  // Smooth with a low pass filter defined as a windowed sinc function.
+  // Taubin describes this methodology is the IBM tech report RC-20404
+  // (#90237, dated 3/12/96) "Optimal Surface Smoothing as Filter Design"
+  // G. Taubin, T. Zhang and G. Golub. (Zhang and Golub are at Stanford
+  // University)
 
-    inMesh = vtkPolyData::New();
-    inMesh->SetPoints(inPts);
-    inMesh->SetPolys(inPolys);
-    Mesh = inMesh;
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
+  // The formulas here follow the notation of Taubin's TR, i.e.
+  // newPts[zero], newPts[one], etc. 
 
-    if ( (numStrips = inStrips->GetNumberOfCells()) > 0 )
-      { // convert data to triangles
-      inMesh->SetStrips(inStrips);
-      toTris = vtkTriangleFilter::New();
-      toTris->SetInput(inMesh);
-      toTris->Update();
-      Mesh = toTris->GetOutput();
-      }
+  // calculate weights and filter coefficients
+  k_pb = this->PassBand;   // reasonable default for k_pb in [0, 2] is 0.1
+  theta_pb = acos( 1.0 - 0.5 * k_pb ); // theta_pb in [0, M_PI/2]
 
-    Mesh->BuildLinks(); //to do neighborhood searching
-    polys = Mesh->GetPolys();
+  //vtkDebugMacro(<< "theta_pb = " << theta_pb);
 
-    for (cellId=0, polys->InitTraversal(); polys->GetNextCell(npts,pts); 
-         cellId++)
-      {
-      for (i=0; i < npts; i++) 
-        {
-        p1 = pts[i];
-        p2 = pts[(i+1)%npts];
+  w = new double[this->NumberOfIterations+1];
+  c = new double[this->NumberOfIterations+1];
+  cprime = new double[this->NumberOfIterations+1];
 
-        if ( Verts[p1].edges == NULL )
-          {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16,6);
-          // Verts[p1].edges = new vtkIdList(6,6);
-          }
-        if ( Verts[p2].edges == NULL )
-          {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16,6);
-          // Verts[p2].edges = new vtkIdList(6,6);
-          }
+  double zerovector[3];
+  zerovector[0] = zerovector[1] = zerovector[2] = 0.0;    
 
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
-        numNei = neighbors->GetNumberOfIds();
+  //
+  // Calculate the weights and the Chebychev coefficients c.
+  //
 
-        edge = VTK_SIMPLE_VERTEX;
-        if ( numNei == 0 )
-          {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-
-        else if ( numNei >= 2 )
-          {
-          // non-manifold case, check nonmanifold smoothing state
-          if (!this->NonManifoldSmoothing)
-            {
-            // check to make sure that this edge hasn't been marked already
-            for (j=0; j < numNei; j++)
-              {
-              if ( neighbors->GetId(j) < cellId )
-                {
-                break;
-                }
-              }
-            if ( j >= numNei )
-              {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-              }
-            }
-          }
-
-        else if ( numNei == 1 && (nei=neighbors->GetId(0)) > cellId ) 
-          {
-          if (this->FeatureEdgeSmoothing)
-            {
-            vtkPolygon::ComputeNormal(inPts,npts,pts,normal);
-            Mesh->GetCellPoints(nei,numNeiPts,neiPts);
-            vtkPolygon::ComputeNormal(inPts,numNeiPts,neiPts,neiNormal);
-
-            if ( vtkMath::Dot(normal,neiNormal) <= CosFeatureAngle ) 
-              {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-              }
-            }
-          }
-        else // a visited edge; skip rest of analysis
-          {
-          continue;
-          }
-
-        if ( edge && Verts[p1].type == VTK_SIMPLE_VERTEX )
-          {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-          }
-        else if ( (edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-        (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX ) )
-          {
-          Verts[p1].edges->InsertNextId(p2);
-          if ( Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
-            {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-            }
-          }
-
-        if ( edge && Verts[p2].type == VTK_SIMPLE_VERTEX )
-          {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-          }
-        else if ( (edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX ) ||
-        (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX ) )
-          {
-          Verts[p2].edges->InsertNextId(p1);
-          if ( Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
-            {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-            }
-          }
-        }
-      }
-
-    //    delete inMesh; // delete this later, windowed sinc smoothing needs it
-    if (toTris)
-      {
-      toTris->Delete();
-      }
-    neighbors->Delete();
-    }//if strips or polys
-
-  this->UpdateProgress(0.50);
-
-  //post-process edge vertices to make sure we can smooth them
-  for (i=0; i<numPts; i++)
-    {
-    if ( Verts[i].type == VTK_SIMPLE_VERTEX )
-      {
-      numSimple++;
-      }
-
-    else if ( Verts[i].type == VTK_FIXED_VERTEX )
-      {
-      numFixed++;
-      }
-
-    else if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX ||
-    Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
-      { //see how many edges; if two, what the angle is
-
-      if ( !this->BoundarySmoothing && 
-      Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
-        {
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numBEdges++;
-        }
-
-      else if ( (npts = Verts[i].edges->GetNumberOfIds()) != 2 )
-        {
-        // can only smooth edges on 2-manifold surfaces
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numFixed++;
-        }
-
-      else //check angle between edges
-        {
-        inPts->GetPoint(Verts[i].edges->GetId(0),x1);
-        inPts->GetPoint(i,x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1),x3);
-
-        for (k=0; k<3; k++)
-          {
-          l1[k] = x2[k] - x1[k];
-          l2[k] = x3[k] - x2[k];
-          }
-        if ((vtkMath::Normalize(l1) >= 0.0) && (vtkMath::Normalize(l2) >= 0.0)
-            && (vtkMath::Dot(l1,l2) < CosEdgeAngle))
-          {
-          numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
-          }
-        else
-          {
-          if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX )
-            {
-            numFEdges++;
-            }
-          else
-            {
-            numBEdges++;
-            }
-          }
-        }//if along edge
-      }//if edge vertex
-    }//for all points
-
-  vtkDebugMacro(<<"Found\n\t" << numSimple << " simple vertices\n\t"
-                << numFEdges << " feature edge vertices\n\t"
-                << numBEdges << " boundary edge vertices\n\t"
-                << numFixed << " fixed vertices\n\t");
-//
-// Perform Windowed Sinc function interpolation
-//
-  vtkDebugMacro(<<"Beginning smoothing iterations...");
-
-  // need 4 vectors of points
-  zero=0; one=1; two=2; three=3;
-
-  newPts[0] = vtkPoints::New();
-  newPts[0]->SetNumberOfPoints(numPts);
-  newPts[1] = vtkPoints::New();
-  newPts[1]->SetNumberOfPoints(numPts);
-  newPts[2] = vtkPoints::New();
-  newPts[2]->SetNumberOfPoints(numPts);
-  newPts[3] = vtkPoints::New();
-  newPts[3]->SetNumberOfPoints(numPts);
-
-  // Get the center and length of the input dataset
-  double *inCenter = input->GetCenter();
-  double inLength = input->GetLength();
-
-  if (!this->NormalizeCoordinates)
-    {
-    for (i=0; i<numPts; i++) //initialize to old coordinates
-      {
-      newPts[zero]->SetPoint(i,inPts->GetPoint(i));
-      }
-    }
-  else
-    {
-    // center the data and scale to be within unit cube [-1, 1]
-    double normalizedPoint[3];
-    for (i=0; i<numPts; i++) //initialize to old coordinates
-      {
-      inPts->GetPoint(i, normalizedPoint);
-      for (j=0; j<3; ++j)
-        {
-        normalizedPoint[j] = (normalizedPoint[j] - inCenter[j]) / inLength;
-        }
-      newPts[zero]->SetPoint(i,normalizedPoint);
-      }
-    }
-
-  // Smooth with a low pass filter defined as a windowed sinc function.
-  // Taubin describes this methodology is the IBM tech report RC-20404
-  // (#90237, dated 3/12/96) "Optimal Surface Smoothing as Filter Design"
-  // G. Taubin, T. Zhang and G. Golub. (Zhang and Golub are at Stanford
-  // University)
-
-  // The formulas here follow the notation of Taubin's TR, i.e.
-  // newPts[zero], newPts[one], etc. 
-
-  // calculate weights and filter coefficients
-  k_pb = this->PassBand;   // reasonable default for k_pb in [0, 2] is 0.1
-  theta_pb = acos( 1.0 - 0.5 * k_pb ); // theta_pb in [0, M_PI/2]
-
-  //vtkDebugMacro(<< "theta_pb = " << theta_pb);
-
-  w = new double[this->NumberOfIterations+1];
-  c = new double[this->NumberOfIterations+1];
-  cprime = new double[this->NumberOfIterations+1];
-
-  double zerovector[3];
-  zerovector[0] = zerovector[1] = zerovector[2] = 0.0;    
-
-  //
-  // Calculate the weights and the Chebychev coefficients c.
-  //
-
-  // Windowed sinc function weights. This is for a Hamming window. Other
-  // windowing function could be implemented here.
-  for (i=0; i <= (this->NumberOfIterations); i++)
-    {
-    w[i] = 0.54 + 0.46*cos(((double)i)*vtkMath::Pi()
-                           /(double)(this->NumberOfIterations+1));
-    }
+  // Windowed sinc function weights. This is for a Hamming window. Other
+  // windowing function could be implemented here.
+  for (i=0; i <= (this->NumberOfIterations); i++)
+    {
+    w[i] = 0.54 + 0.46*cos(((double)i)*vtkMath::Pi()
+                           /(double)(this->NumberOfIterations+1));
+    }
 
   // Calculate the optimal sigma (offset or fudge factor for the filter).
   // This is a Newton-Raphson Search.
@@ -579,54 +454,26 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     vtkErrorMacro(<< "An optimal offset for the smoothing filter could not be found.  Unpredictable smoothing/shrinkage may result.");
     }
   
+  vtkWindowedSincPolyDataFilterPass pass;
+  pass.Types = types;
+  pass.Offsets = offsets;
+  pass.Ids = ids;
+  pass.C = c;
+  pass.X3 = static_cast<vtkFloatArray *>(newPts[three]->GetData())->GetPointer(0);
+
   // first iteration
-  for (i=0; i<numPts; i++) 
+  pass.IterationNumber = 1;
+  pass.X0 = static_cast<vtkFloatArray *>(newPts[zero]->GetData())->GetPointer(0);
+  pass.X1 = static_cast<vtkFloatArray *>(newPts[one]->GetData())->GetPointer(0);
+  pass.X2 = NULL;
+  if ( this->UseThreadPool )
     {
-    if ( Verts[i].edges != NULL &&
-         (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-      {
-      // point is allowed to move
-      newPts[zero]->GetPoint(i, x); //use current points
-      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-      
-      // calculate the negative of the laplacian
-      for (j=0; j<npts; j++) //for all connected points
-        {
-        newPts[zero]->GetPoint(Verts[i].edges->GetId(j), y);
-        for (k=0; k<3; k++)
-          {
-          deltaX[k] += (x[k] - y[k]) / npts;
-          }
-        }
-      // newPts[one] = newPts[zero] - 0.5 newPts[one]
-      for (k=0; k<3; k++)
-        {
-        deltaX[k] = x[k] - 0.5*deltaX[k];
-        }
-      newPts[one]->SetPoint(i, deltaX);
-      
-      // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
-      for (k=0; k < 3; k++)
-        {
-        deltaX[k] = c[0]*x[k] + c[1]*deltaX[k];
-        }
-      if (Verts[i].type == VTK_FIXED_VERTEX)
-        {
-        newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-        }
-      else
-        {
-        newPts[three]->SetPoint(i, deltaX);
-        }
-      }//if can move point
-    else
-      {
-      // point is not allowed to move, just use the old point...
-      // (zero out the Laplacian)
-      newPts[one]->SetPoint(i, zerovector);
-      newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-      }
-    }//for all points
+    vtkSMPTools::For(0, numPts, pass);
+    }
+  else
+    {
+    pass(0, numPts);
+    }
   
   // for the rest of the iterations
   for ( iterationNumber=2, abortExecute=0;
@@ -642,54 +489,19 @@ int vtkWindowedSincPolyDataFilter::RequestData(
         break;
         }
       }
-    
-    for (i=0; i<numPts; i++) 
+
+    pass.IterationNumber = iterationNumber;
+    pass.X0 = static_cast<vtkFloatArray *>(newPts[zero]->GetData())->GetPointer(0);
+    pass.X1 = static_cast<vtkFloatArray *>(newPts[one]->GetData())->GetPointer(0);
+    pass.X2 = static_cast<vtkFloatArray *>(newPts[two]->GetData())->GetPointer(0);
+    if ( this->UseThreadPool )
       {
-      if ( Verts[i].edges != NULL &&
-           (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-        {
-        // point is allowed to move
-        newPts[zero]->GetPoint(i, p_x0); //use current points
-        newPts[one]->GetPoint(i, p_x1);
-        
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-        
-        // calculate the negative laplacian of x1
-        for (j=0; j<npts; j++)
-          {
-          newPts[one]->GetPoint(Verts[i].edges->GetId(j), y);
-          for (k=0; k<3; k++)
-            {
-            deltaX[k] += (p_x1[k] - y[k]) / npts;
-            }
-          }//for all connected points
-        
-        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
-        for (k=0; k<3; k++)
-          {
-          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
-          }
-        newPts[two]->SetPoint(i, deltaX);
-
-        // smooth the vertex (x3 = x3 + cj x2)
-        newPts[three]->GetPoint(i, p_x3);
-        for (k=0;k<3;k++) 
-          {
-          xNew[k] = p_x3[k] + c[iterationNumber] * deltaX[k];
-          }
-        if (Verts[i].type != VTK_FIXED_VERTEX)
-          {
-          newPts[three]->SetPoint(i,xNew);
-          }
-        }//if can move point
-      else
-        {
-        // point is not allowed to move, just use the old point...
-        // (zero out the Laplacian)
-        newPts[one]->SetPoint(i, zerovector);
-        newPts[two]->SetPoint(i, zerovector);
-        }
-      }//for all points
+      vtkSMPTools::For(0, numPts, pass);
+      }
+    else
+      {
+      pass(0, numPts);
+      }
 
     // update the pointers. three is always three. all other pointers
     // shift by one and wrap.
@@ -781,17 +593,350 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  // finally delete the constructed (local) mesh
-  inMesh->Delete();
+  return 1;
+}
+
+// Classify the vertices of the input and store, for every vertex, the
+// points it is smoothed with.
+void vtkWindowedSincPolyDataFilter::BuildAdjacency(vtkPolyData *input)
+{
+  vtkIdType numPts=input->GetNumberOfPoints();
+  vtkIdType i, numPolys, numStrips;
+  int j, k;
+  vtkIdType npts = 0;
+  vtkIdType *pts = 0;
+  vtkIdType p1, p2;
+  double x1[3], x2[3], x3[3], l1[3], l2[3];
+  double CosFeatureAngle; //Cosine of angle between adjacent polys
+  double CosEdgeAngle; // Cosine of angle between adjacent edges
+  vtkIdType numSimple=0, numBEdges=0, numFixed=0, numFEdges=0;
+  vtkPolyData *inMesh, *Mesh;
+  vtkStaticCellLinks *links;
+  vtkPoints *inPts;
+  vtkTriangleFilter *toTris=NULL;
+  vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
+  vtkMeshVertexPtr Verts;
+
+  CosFeatureAngle = cos( vtkMath::RadiansFromDegrees( this->FeatureAngle) );
+  CosEdgeAngle    = cos( vtkMath::RadiansFromDegrees( this->EdgeAngle) );
+
+//
+// Peform topological analysis. What we're gonna do is build a connectivity
+// array of connected vertices. The outcome will be one of three
+// classifications for a vertex: VTK_SIMPLE_VERTEX, VTK_FIXED_VERTEX. or
+// VTK_EDGE_VERTEX. Simple vertices are smoothed using all connected 
+// vertices. FIXED vertices are never smoothed. Edge vertices are smoothed
+// using a subset of the attached vertices.
+//
+  vtkDebugMacro(<<"Analyzing topology...");
+  Verts = new vtkMeshVertex[numPts];
+  for (i=0; i<numPts; i++)
+    {
+    Verts[i].type = VTK_SIMPLE_VERTEX; //can smooth
+    Verts[i].edges = NULL;
+    }
+
+  inPts = input->GetPoints();
   
-  //free up connectivity storage
+  // check vertices first. Vertices are never smoothed_--------------
+  for (inVerts=input->GetVerts(), inVerts->InitTraversal(); 
+  inVerts->GetNextCell(npts,pts); )
+    {
+    for (j=0; j<npts; j++)
+      {
+      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      }
+    }
+
+  this->UpdateProgress(0.10);
+
+  // now check lines. Only manifold lines can be smoothed------------
+  for (inLines=input->GetLines(), inLines->InitTraversal(); 
+  inLines->GetNextCell(npts,pts); )
+    {
+    for (j=0; j<npts; j++)
+      {
+      if ( Verts[pts[j]].type == VTK_SIMPLE_VERTEX )
+        {
+        if ( j == (npts-1) ) //end-of-line marked FIXED
+          {
+          Verts[pts[j]].type = VTK_FIXED_VERTEX;
+          }
+        else if ( j == 0 ) //beginning-of-line marked FIXED
+          {
+          Verts[pts[0]].type = VTK_FIXED_VERTEX;
+          inPts->GetPoint(pts[0],x2);
+          inPts->GetPoint(pts[1],x3);
+          }
+        else //is edge vertex (unless already edge vertex!)
+          {
+          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
+          Verts[pts[j]].edges = vtkIdList::New();
+          Verts[pts[j]].edges->SetNumberOfIds(2);
+          //Verts[pts[j]].edges = new vtkIdList(2,2);
+          Verts[pts[j]].edges->SetId(0,pts[j-1]);
+          Verts[pts[j]].edges->SetId(1,pts[j+1]);
+          }
+        } //if simple vertex
+
+      else if ( Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX )
+        { //multiply connected, becomes fixed!
+        Verts[pts[j]].type = VTK_FIXED_VERTEX;
+        Verts[pts[j]].edges->Delete();
+        Verts[pts[j]].edges = NULL;
+        }
+
+      } //for all points in this line
+    } //for all lines
+
+  this->UpdateProgress(0.25);
+
+  // now polygons and triangle strips-------------------------------
+  inPolys=input->GetPolys();
+  numPolys = inPolys->GetNumberOfCells();
+  inStrips=input->GetStrips();
+  numStrips = inStrips->GetNumberOfCells();
+
+  if ( numPolys > 0 || numStrips > 0 )
+    { //build cell structure
+    vtkCellArray *polys;
+    vtkIdType cellId;
+    int numNei, nei, edge;
+    vtkIdType numNeiPts;
+    vtkIdType *neiPts;
+    double normal[3], neiNormal[3];
+    vtkIdList *neighbors;
+
+    inMesh = vtkPolyData::New();
+    inMesh->SetPoints(inPts);
+    inMesh->SetPolys(inPolys);
+    Mesh = inMesh;
+    neighbors = vtkIdList::New();
+    neighbors->Allocate(VTK_CELL_SIZE);
+
+    if ( (numStrips = inStrips->GetNumberOfCells()) > 0 )
+      { // convert data to triangles
+      inMesh->SetStrips(inStrips);
+      toTris = vtkTriangleFilter::New();
+      toTris->SetInput(inMesh);
+      toTris->Update();
+      Mesh = toTris->GetOutput();
+      }
+
+    links = vtkStaticCellLinks::New(); //to do neighborhood searching
+    links->BuildLinks(Mesh);
+    polys = Mesh->GetPolys();
+
+    for (cellId=0, polys->InitTraversal(); polys->GetNextCell(npts,pts); 
+         cellId++)
+      {
+      for (i=0; i < npts; i++) 
+        {
+        p1 = pts[i];
+        p2 = pts[(i+1)%npts];
+
+        if ( Verts[p1].edges == NULL )
+          {
+          Verts[p1].edges = vtkIdList::New();
+          Verts[p1].edges->Allocate(16,6);
+          // Verts[p1].edges = new vtkIdList(6,6);
+          }
+        if ( Verts[p2].edges == NULL )
+          {
+          Verts[p2].edges = vtkIdList::New();
+          Verts[p2].edges->Allocate(16,6);
+          // Verts[p2].edges = new vtkIdList(6,6);
+          }
+
+        links->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
+        numNei = neighbors->GetNumberOfIds();
+
+        edge = VTK_SIMPLE_VERTEX;
+        if ( numNei == 0 )
+          {
+          edge = VTK_BOUNDARY_EDGE_VERTEX;
+          }
+
+        else if ( numNei >= 2 )
+          {
+          // non-manifold case, check nonmanifold smoothing state
+          if (!this->NonManifoldSmoothing)
+            {
+            // check to make sure that this edge hasn't been marked already
+            for (j=0; j < numNei; j++)
+              {
+              if ( neighbors->GetId(j) < cellId )
+                {
+                break;
+                }
+              }
+            if ( j >= numNei )
+              {
+              edge = VTK_FEATURE_EDGE_VERTEX;
+              }
+            }
+          }
+
+        else if ( numNei == 1 && (nei=neighbors->GetId(0)) > cellId ) 
+          {
+          if (this->FeatureEdgeSmoothing)
+            {
+            vtkPolygon::ComputeNormal(inPts,npts,pts,normal);
+            Mesh->GetCellPoints(nei,numNeiPts,neiPts);
+            vtkPolygon::ComputeNormal(inPts,numNeiPts,neiPts,neiNormal);
+
+            if ( vtkMath::Dot(normal,neiNormal) <= CosFeatureAngle ) 
+              {
+              edge = VTK_FEATURE_EDGE_VERTEX;
+              }
+            }
+          }
+        else // a visited edge; skip rest of analysis
+          {
+          continue;
+          }
+
+        if ( edge && Verts[p1].type == VTK_SIMPLE_VERTEX )
+          {
+          Verts[p1].edges->Reset();
+          Verts[p1].edges->InsertNextId(p2);
+          Verts[p1].type = edge;
+          }
+        else if ( (edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
+        (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
+        (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX ) )
+          {
+          Verts[p1].edges->InsertNextId(p2);
+          if ( Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
+            {
+            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
+            }
+          }
+
+        if ( edge && Verts[p2].type == VTK_SIMPLE_VERTEX )
+          {
+          Verts[p2].edges->Reset();
+          Verts[p2].edges->InsertNextId(p1);
+          Verts[p2].type = edge;
+          }
+        else if ( (edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX ) ||
+        (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
+        (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX ) )
+          {
+          Verts[p2].edges->InsertNextId(p1);
+          if ( Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
+            {
+            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
+            }
+          }
+        }
+      }
+
+    inMesh->Delete();
+    links->Delete();
+    if (toTris)
+      {
+      toTris->Delete();
+      }
+    neighbors->Delete();
+    }//if strips or polys
+
+  //post-process edge vertices to make sure we can smooth them
   for (i=0; i<numPts; i++)
     {
-    if ( Verts[i].edges != NULL ) {Verts[i].edges->Delete();}
+    if ( Verts[i].type == VTK_SIMPLE_VERTEX )
+      {
+      numSimple++;
+      }
+
+    else if ( Verts[i].type == VTK_FIXED_VERTEX )
+      {
+      numFixed++;
+      }
+
+    else if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX ||
+    Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
+      { //see how many edges; if two, what the angle is
+
+      if ( !this->BoundarySmoothing && 
+      Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
+        {
+        Verts[i].type = VTK_FIXED_VERTEX;
+        numBEdges++;
+        }
+
+      else if ( (npts = Verts[i].edges->GetNumberOfIds()) != 2 )
+        {
+        // can only smooth edges on 2-manifold surfaces
+        Verts[i].type = VTK_FIXED_VERTEX;
+        numFixed++;
+        }
+
+      else //check angle between edges
+        {
+        inPts->GetPoint(Verts[i].edges->GetId(0),x1);
+        inPts->GetPoint(i,x2);
+        inPts->GetPoint(Verts[i].edges->GetId(1),x3);
+
+        for (k=0; k<3; k++)
+          {
+          l1[k] = x2[k] - x1[k];
+          l2[k] = x3[k] - x2[k];
+          }
+        if ((vtkMath::Normalize(l1) >= 0.0) && (vtkMath::Normalize(l2) >= 0.0)
+            && (vtkMath::Dot(l1,l2) < CosEdgeAngle))
+          {
+          numFixed++;
+          Verts[i].type = VTK_FIXED_VERTEX;
+          }
+        else
+          {
+          if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX )
+            {
+            numFEdges++;
+            }
+          else
+            {
+            numBEdges++;
+            }
+          }
+        }//if along edge
+      }//if edge vertex
+    }//for all points
+
+  vtkDebugMacro(<<"Found\n\t" << numSimple << " simple vertices\n\t"
+                << numFEdges << " feature edge vertices\n\t"
+                << numBEdges << " boundary edge vertices\n\t"
+                << numFixed << " fixed vertices\n\t");
+
+  // store the lists one after the other and free up connectivity storage
+  vtkWindowedSincPolyDataFilterAdjacency *adjacency = this->Adjacency;
+  adjacency->Types.resize(numPts);
+  adjacency->Offsets.resize(numPts+1);
+  adjacency->Ids.clear();
+  for (i=0; i<numPts; i++)
+    {
+    adjacency->Types[i] = Verts[i].type;
+    adjacency->Offsets[i] = static_cast<vtkIdType>(adjacency->Ids.size());
+    if ( Verts[i].edges != NULL )
+      {
+      for (j=0; j < Verts[i].edges->GetNumberOfIds(); j++)
+        {
+        adjacency->Ids.push_back(Verts[i].edges->GetId(j));
+        }
+      Verts[i].edges->Delete();
+      }
     }
+  adjacency->Offsets[numPts] = static_cast<vtkIdType>(adjacency->Ids.size());
   delete [] Verts;
 
-  return 1;
+  adjacency->Input = input;
+  adjacency->FeatureEdgeSmoothing = this->FeatureEdgeSmoothing;
+  adjacency->FeatureAngle = this->FeatureAngle;
+  adjacency->EdgeAngle = this->EdgeAngle;
+  adjacency->BoundarySmoothing = this->BoundarySmoothing;
+  adjacency->NonManifoldSmoothing = this->NonManifoldSmoothing;
+  adjacency->BuildTime.Modified();
 }
 
 void vtkWindowedSincPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
@@ -808,4 +953,5 @@ void vtkWindowedSincPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Nonmanifold Smoothing: " << (this->NonManifoldSmoothing ? "On\n" : "Off\n");
   os << indent << "Generate Error Scalars: " << (this->GenerateErrorScalars ? "On\n" : "Off\n");
   os << indent << "Generate Error Vectors: " << (this->GenerateErrorVectors ? "On\n" : "Off\n");
+  os << indent << "Use Thread Pool: " << (this->UseThreadPool ? "On\n" : "Off\n");
 }
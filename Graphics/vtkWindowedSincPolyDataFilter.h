@@ -123,6 +123,15 @@
 // ivar GenerateErrorVectors is on, then a vector representing change in 
 // position is computed.
 //
+// The classification of the vertices and their lists of connected vertices
+// are kept from one execution to the next, and rebuilt only when the input
+// or the parameters of the classification change. Changing the number of
+// iterations or the pass band only reruns the smoothing passes.
+//
+// When UseThreadPool is on, every pass moves the points in parallel on the
+// workers of the vtkThreadPool. A pass only reads the results of the
+// previous ones, so the output is the same as the serial output.
+//
 // .SECTION Caveats
 // The smoothing operation reduces high frequency information in the
 // geometry of the mesh. With excessive smoothing important details may be
@@ -139,6 +148,8 @@
 
 #include "vtkPolyDataAlgorithm.h"
 
+class vtkWindowedSincPolyDataFilterAdjacency;
+
 class VTK_GRAPHICS_EXPORT vtkWindowedSincPolyDataFilter : public vtkPolyDataAlgorithm 
 {
 public:
@@ -216,13 +227,24 @@ public:
   vtkSetMacro(GenerateErrorVectors,int);
   vtkGetMacro(GenerateErrorVectors,int);
   vtkBooleanMacro(GenerateErrorVectors,int);
+
+  // Description:
+  // Smooth the points in parallel with the vtkThreadPool. Off by default.
+  vtkSetMacro(UseThreadPool,int);
+  vtkGetMacro(UseThreadPool,int);
+  vtkBooleanMacro(UseThreadPool,int);
   
  protected:
   vtkWindowedSincPolyDataFilter();
-  ~vtkWindowedSincPolyDataFilter() {};
+  ~vtkWindowedSincPolyDataFilter();
 
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
 
+  // Description:
+  // Classify the vertices of the input and build the lists of vertices
+  // they are smoothed with.
+  void BuildAdjacency(vtkPolyData *input);
+
   int NumberOfIterations;
   double PassBand;
   int FeatureEdgeSmoothing;
@@ -233,6 +255,9 @@ public:
   int GenerateErrorScalars;
   int GenerateErrorVectors;
   int NormalizeCoordinates;
+  int UseThreadPool;
+
+  vtkWindowedSincPolyDataFilterAdjacency *Adjacency;
 private:
   vtkWindowedSincPolyDataFilter(const vtkWindowedSincPolyDataFilter&);  // Not implemented.
   void operator=(const vtkWindowedSincPolyDataFilter&);  // Not implemented.
@@ -0,0 +1,161 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compute the distance map of a sparse mask with the algorithm of
+// Felzenszwalb and Huttenlocher in vtkImageEuclideanDistance.  It must be
+// the exact squared distance to the nearest zero voxel, with isotropic
+// and anisotropic spacing, in 2D and 3D, and must match Saito's
+// algorithm and itself with any number of threads.
+
+#include "vtkImageData.h"
+#include "vtkImageEuclideanDistance.h"
+#include "vtkMath.h"
+#include "vtkSmartPointer.h"
+
+#include <math.h>
+
+static vtkSmartPointer<vtkImageData> Distance(vtkImageData *mask,
+                                              int algorithm,
+                                              int dimensionality,
+                                              int threads)
+{
+  vtkSmartPointer<vtkImageEuclideanDistance> distance =
+    vtkSmartPointer<vtkImageEuclideanDistance>::New();
+  distance->SetInput(mask);
+  distance->SetAlgorithm(algorithm);
+  distance->SetDimensionality(dimensionality);
+  distance->SetNumberOfThreads(threads);
+  distance->Update();
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->DeepCopy(distance->GetOutput());
+  return output;
+}
+
+// The largest difference with the squared distance to the nearest zero
+// voxel, found by testing them all.  In 2D, the distances stay within
+// each slice.
+static double MaxError(vtkImageData *mask, vtkImageData *distance,
+                       int dimensionality)
+{
+  int *ext = mask->GetExtent();
+  double *spacing = mask->GetSpacing();
+  double maxError = 0.0;
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        double best = VTK_INT_MAX;
+        for (int kk = ext[4]; kk <= ext[5]; kk++)
+          {
+          if (dimensionality == 2 && kk != k)
+            {
+            continue;
+            }
+          for (int jj = ext[2]; jj <= ext[3]; jj++)
+            {
+            for (int ii = ext[0]; ii <= ext[1]; ii++)
+              {
+              if (mask->GetScalarComponentAsDouble(ii, jj, kk, 0) == 0)
+                {
+                double dx = (i - ii)*spacing[0];
+                double dy = (j - jj)*spacing[1];
+                double dz = (k - kk)*spacing[2];
+                double d = dx*dx + dy*dy + dz*dz;
+                best = (d < best ? d : best);
+                }
+              }
+            }
+          }
+        double error = fabs(
+          distance->GetScalarComponentAsDouble(i, j, k, 0) - best);
+        maxError = (error > maxError ? error : maxError);
+        }
+      }
+    }
+  return maxError;
+}
+
+// A few zero voxels, and one in every slice for the 2D maps.
+static vtkSmartPointer<vtkImageData> MakeMask(double spacing[3])
+{
+  vtkSmartPointer<vtkImageData> mask = vtkSmartPointer<vtkImageData>::New();
+  mask->SetExtent(0, 23, 3, 19, 2, 10);
+  mask->SetSpacing(spacing);
+  mask->SetScalarTypeToUnsignedChar();
+  mask->AllocateScalars();
+  int *ext = mask->GetExtent();
+  vtkMath::RandomSeed(1234);
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        int zero = (vtkMath::Random() < 0.01 || (i == 3 && j == k + 3));
+        mask->SetScalarComponentFromDouble(i, j, k, 0, (zero ? 0 : 255));
+        }
+      }
+    }
+  return mask;
+}
+
+int ImageEuclideanDistanceFelzenszwalb(int, char *[])
+{
+  double spacings[2][3] = { { 1.0, 1.0, 1.0 }, { 0.7, 1.3, 2.5 } };
+  for (int s = 0; s < 2; s++)
+    {
+    vtkSmartPointer<vtkImageData> mask = MakeMask(spacings[s]);
+    int *ext = mask->GetExtent();
+    for (int dim = 2; dim <= 3; dim++)
+      {
+      vtkSmartPointer<vtkImageData> distance =
+        Distance(mask, VTK_EDT_FELZENSZWALB, dim, 1);
+      vtkSmartPointer<vtkImageData> threaded =
+        Distance(mask, VTK_EDT_FELZENSZWALB, dim, 3);
+      vtkSmartPointer<vtkImageData> saito =
+        Distance(mask, VTK_EDT_SAITO, dim, 1);
+
+      double error = MaxError(mask, distance, dim);
+      double saitoDiff = 0.0;
+      double threadDiff = 0.0;
+      for (int k = ext[4]; k <= ext[5]; k++)
+        {
+        for (int j = ext[2]; j <= ext[3]; j++)
+          {
+          for (int i = ext[0]; i <= ext[1]; i++)
+            {
+            double d = distance->GetScalarComponentAsDouble(i, j, k, 0);
+            double diff = fabs(
+              saito->GetScalarComponentAsDouble(i, j, k, 0) - d);
+            saitoDiff = (diff > saitoDiff ? diff : saitoDiff);
+            diff = fabs(threaded->GetScalarComponentAsDouble(i, j, k, 0) - d);
+            threadDiff = (diff > threadDiff ? diff : threadDiff);
+            }
+          }
+        }
+
+      if (error > 1e-9 || saitoDiff > 1e-9 || threadDiff != 0.0)
+        {
+        cerr << "Spacing " << s << " in " << dim << "D: error " << error
+             << ", difference with Saito " << saitoDiff
+             << ", with threads " << threadDiff << "\n";
+        return 1;
+        }
+      }
+    }
+
+  return 0;
+}
@@ -0,0 +1,199 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Transform real and complex images whose sizes have small and large
+// prime factors with the multi-axis transform of vtkImageFFT and
+// vtkImageRFFT.  It must match the transform of one axis per iteration,
+// give the input back through the reverse transform, and give the same
+// result with any number of threads and for part of the output.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageFFT.h"
+#include "vtkImageRFFT.h"
+#include "vtkMath.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <math.h>
+
+static vtkSmartPointer<vtkImageData> MakeImage(int extent[6],
+                                               int scalarType,
+                                               int components)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(extent);
+  image->SetScalarType(scalarType);
+  image->SetNumberOfScalarComponents(components);
+  image->AllocateScalars();
+  vtkDataArray *scalars = image->GetPointData()->GetScalars();
+  vtkMath::RandomSeed(4321);
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+    {
+    for (int c = 0; c < components; c++)
+      {
+      scalars->SetComponent(i, c, floor(vtkMath::Random(-100.0, 100.0)));
+      }
+    }
+  return image;
+}
+
+// The largest difference between the components of a and b, over the
+// extent of b, relative to the largest magnitude in a.
+static double MaxDifference(vtkImageData *a, vtkImageData *b)
+{
+  int *ext = b->GetExtent();
+  int components = b->GetNumberOfScalarComponents();
+  double maxValue = 1e-30;
+  double maxDiff = 0.0;
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        for (int c = 0; c < components; c++)
+          {
+          double va = a->GetScalarComponentAsDouble(i, j, k, c);
+          double vb = b->GetScalarComponentAsDouble(i, j, k, c);
+          maxValue = (fabs(va) > maxValue ? fabs(va) : maxValue);
+          maxDiff = (fabs(va - vb) > maxDiff ? fabs(va - vb) : maxDiff);
+          }
+        }
+      }
+    }
+  return maxDiff/maxValue;
+}
+
+static vtkSmartPointer<vtkImageData> Transform(vtkImageFourierFilter *filter,
+                                               vtkImageData *image,
+                                               int dimensionality,
+                                               int multiAxis, int threads,
+                                               int *updateExtent = 0)
+{
+  filter->SetInput(image);
+  filter->SetDimensionality(dimensionality);
+  filter->SetMultiAxisTransform(multiAxis);
+  filter->SetNumberOfThreads(threads);
+  filter->UpdateInformation();
+  if (updateExtent)
+    {
+    filter->GetOutput()->SetUpdateExtent(updateExtent);
+    }
+  else
+    {
+    filter->GetOutput()->SetUpdateExtentToWholeExtent();
+    }
+  filter->GetOutput()->Update();
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->DeepCopy(filter->GetOutput());
+  return output;
+}
+
+int ImageFFTMultiAxis(int, char *[])
+{
+  // 17 and 37 go through Bluestein's algorithm, the other sizes through
+  // stages of radix 2, 3, 4, 5, 11 and 13
+  int extents[3][6] = {
+    { 0, 16, -2, 9, 0, 4 },
+    { 0, 10, 0, 25, 0, 0 },
+    { 3, 39, 0, 63, 0, 2 } };
+  int dimensionalities[3] = { 3, 2, 2 };
+  int scalarTypes[2] = { VTK_SHORT, VTK_FLOAT };
+
+  vtkSmartPointer<vtkImageFFT> fft = vtkSmartPointer<vtkImageFFT>::New();
+  vtkSmartPointer<vtkImageRFFT> rfft = vtkSmartPointer<vtkImageRFFT>::New();
+
+  for (int e = 0; e < 3; e++)
+    {
+    for (int components = 1; components <= 2; components++)
+      {
+      vtkSmartPointer<vtkImageData> image =
+        MakeImage(extents[e], scalarTypes[components - 1], components);
+      int dim = dimensionalities[e];
+
+      vtkSmartPointer<vtkImageData> decomposed =
+        Transform(fft, image, dim, 0, 1);
+      vtkSmartPointer<vtkImageData> multiAxis =
+        Transform(fft, image, dim, 1, 1);
+      vtkSmartPointer<vtkImageData> threaded =
+        Transform(fft, image, dim, 1, 4);
+      vtkSmartPointer<vtkImageData> reverse =
+        Transform(rfft, multiAxis, dim, 1, 3);
+      vtkSmartPointer<vtkImageData> reverseDecomposed =
+        Transform(rfft, multiAxis, dim, 0, 1);
+
+      // the transform of one axis per iteration is in single precision
+      double diff = MaxDifference(decomposed, multiAxis);
+      double threadDiff = MaxDifference(multiAxis, threaded);
+      double reverseDiff = MaxDifference(reverseDecomposed, reverse);
+      if (diff > 1e-5 || threadDiff > 1e-14 || reverseDiff > 1e-5)
+        {
+        cerr << "Extent " << e << " with " << components
+             << " components: the multi-axis transform differs by " << diff
+             << ", threaded by " << threadDiff << " and reverse by "
+             << reverseDiff << "\n";
+        return 1;
+        }
+
+      // the reverse transform gives the input back, with no imaginary part
+      // for real inputs
+      double roundTrip = 0.0;
+      int *ext = image->GetExtent();
+      for (int k = ext[4]; k <= ext[5]; k++)
+        {
+        for (int j = ext[2]; j <= ext[3]; j++)
+          {
+          for (int i = ext[0]; i <= ext[1]; i++)
+            {
+            for (int c = 0; c < 2; c++)
+              {
+              double v = (c < components ?
+                          image->GetScalarComponentAsDouble(i, j, k, c) : 0);
+              double d = fabs(v - reverse->GetScalarComponentAsDouble(
+                                i, j, k, c));
+              roundTrip = (d > roundTrip ? d : roundTrip);
+              }
+            }
+          }
+        }
+      if (roundTrip > 1e-9)
+        {
+        cerr << "Extent " << e << " with " << components
+             << " components: the reverse transform misses the input by "
+             << roundTrip << "\n";
+        return 1;
+        }
+
+      // part of the output, along a transformed axis and along the other
+      int part[6];
+      memcpy(part, extents[e], 6*sizeof(int));
+      part[2] += 1;
+      part[3] -= 2;
+      part[5] = part[4];
+      vtkSmartPointer<vtkImageData> piece =
+        Transform(fft, image, dim, 1, 2, part);
+      double pieceDiff = MaxDifference(multiAxis, piece);
+      if (pieceDiff > 1e-14)
+        {
+        cerr << "Extent " << e << " with " << components
+             << " components: part of the output differs by "
+             << pieceDiff << "\n";
+        return 1;
+        }
+      }
+    }
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Filter noisy images with vtkImageMedian3D using sliding histograms.
+// Every output voxel must be the lower middle value of its neighborhood,
+// clipped at the boundaries, and must match the sorting median wherever
+// the neighborhood holds an odd number of voxels, whatever the number of
+// threads.
+
+#include "vtkImageData.h"
+#include "vtkImageMedian3D.h"
+#include "vtkMath.h"
+#include "vtkSmartPointer.h"
+
+#include <math.h>
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
+
+static vtkSmartPointer<vtkImageData> MakeImage(int scalarType,
+                                               int components,
+                                               double range)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, 79, -2, 13, 0, 8);
+  image->SetScalarType(scalarType);
+  image->SetNumberOfScalarComponents(components);
+  image->AllocateScalars();
+  int *ext = image->GetExtent();
+  double minValue = image->GetScalarTypeMin();
+  vtkMath::RandomSeed(8775070);
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        for (int c = 0; c < components; c++)
+          {
+          // a ramp with noise over part of the range of the type
+          double v = minValue + (0.5*i/ext[1] + 0.5*vtkMath::Random())*range;
+          image->SetScalarComponentFromDouble(i, j, k, c, floor(v));
+          }
+        }
+      }
+    }
+  return image;
+}
+
+static vtkSmartPointer<vtkImageData> Median(vtkImageData *image,
+                                            int size[3], int histogram,
+                                            int threads)
+{
+  vtkSmartPointer<vtkImageMedian3D> median =
+    vtkSmartPointer<vtkImageMedian3D>::New();
+  median->SetInput(image);
+  median->SetKernelSize(size[0], size[1], size[2]);
+  median->SetUseHistogram(histogram);
+  median->SetNumberOfThreads(threads);
+  median->Update();
+  return median->GetOutput();
+}
+
+// Check the median of each voxel against a sort of its neighborhood.
+static int CheckMedian(vtkImageData *image, int size[3],
+                       vtkImageData *histogram, vtkImageData *sorted)
+{
+  int *ext = image->GetExtent();
+  int components = image->GetNumberOfScalarComponents();
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        int hood[6] = { i - size[0]/2, i - size[0]/2 + size[0] - 1,
+                        j - size[1]/2, j - size[1]/2 + size[1] - 1,
+                        k - size[2]/2, k - size[2]/2 + size[2] - 1 };
+        for (int a = 0; a < 3; a++)
+          {
+          hood[2*a] = (hood[2*a] > ext[2*a] ? hood[2*a] : ext[2*a]);
+          hood[2*a+1] = (hood[2*a+1] < ext[2*a+1] ? hood[2*a+1] : ext[2*a+1]);
+          }
+        for (int c = 0; c < components; c++)
+          {
+          vtkstd::vector<double> values;
+          for (int kk = hood[4]; kk <= hood[5]; kk++)
+            {
+            for (int jj = hood[2]; jj <= hood[3]; jj++)
+              {
+              for (int ii = hood[0]; ii <= hood[1]; ii++)
+                {
+                values.push_back(
+                  image->GetScalarComponentAsDouble(ii, jj, kk, c));
+                }
+              }
+            }
+          vtkstd::sort(values.begin(), values.end());
+          double expected = values[(values.size() - 1)/2];
+          double value = histogram->GetScalarComponentAsDouble(i, j, k, c);
+          if (value != expected ||
+              (values.size() % 2 == 1 &&
+               sorted->GetScalarComponentAsDouble(i, j, k, c) != expected))
+            {
+            cerr << "Median at (" << i << ", " << j << ", " << k << ") is "
+                 << value << " instead of " << expected << " with kernel "
+                 << size[0] << "x" << size[1] << "x" << size[2] << "\n";
+            return 0;
+            }
+          }
+        }
+      }
+    }
+  return 1;
+}
+
+int ImageMedian3DHistogram(int, char *[])
+{
+  int scalarTypes[4] = {
+    VTK_UNSIGNED_CHAR, VTK_SIGNED_CHAR, VTK_SHORT, VTK_UNSIGNED_SHORT };
+  // the shorts spread over a few thousand values and over their full range
+  double ranges[5] = { 255.0, 255.0, 3000.0, 65535.0, 65535.0 };
+  int sizes[5][3] = {
+    { 1, 1, 1 }, { 3, 3, 3 }, { 5, 3, 1 }, { 4, 2, 3 }, { 1, 7, 9 } };
+
+  for (int t = 0; t < 5; t++)
+    {
+    int scalarType = scalarTypes[t < 4 ? t : 2];
+    vtkSmartPointer<vtkImageData> image =
+      MakeImage(scalarType, 1 + t%2, ranges[t]);
+    for (int s = 0; s < 5; s++)
+      {
+      vtkSmartPointer<vtkImageData> histogram =
+        Median(image, sizes[s], 1, 1);
+      vtkSmartPointer<vtkImageData> threaded = Median(image, sizes[s], 1, 4);
+      vtkSmartPointer<vtkImageData> sorted = Median(image, sizes[s], 0, 1);
+      if (!CheckMedian(image, sizes[s], histogram, sorted) ||
+          !CheckMedian(image, sizes[s], threaded, sorted))
+        {
+        cerr << "with scalar type " << scalarType << "\n";
+        return 1;
+        }
+      }
+    }
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reslice images of several scalar types along oblique and permuted axes
+// that cut through the borders of the input, with nearest-neighbor, linear
+// and cubic interpolation and every border mode. The optimized output must
+// match the unoptimized one.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageReslice.h"
+#include "vtkMatrix4x4.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <math.h>
+
+static vtkSmartPointer<vtkImageData> MakeImage(int scalarType,
+                                               int components)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, 39, -3, 32, 0, 29);
+  image->SetSpacing(1.0, 1.2, 0.8);
+  image->SetOrigin(-5.0, 2.0, 1.0);
+  image->SetScalarType(scalarType);
+  image->SetNumberOfScalarComponents(components);
+  image->AllocateScalars();
+  int *ext = image->GetExtent();
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        for (int c = 0; c < components; c++)
+          {
+          double v = 60.0 + 50.0*sin(0.3*i + c)*cos(0.2*j) + 0.7*k;
+          image->SetScalarComponentFromDouble(i, j, k, c, v);
+          }
+        }
+      }
+    }
+  return image;
+}
+
+static double MaxDifference(vtkImageData *a, vtkImageData *b)
+{
+  vtkIdType n = a->GetNumberOfPoints()*a->GetNumberOfScalarComponents();
+  if (n != b->GetNumberOfPoints()*b->GetNumberOfScalarComponents())
+    {
+    return VTK_DOUBLE_MAX;
+    }
+  vtkDataArray *sa = a->GetPointData()->GetScalars();
+  vtkDataArray *sb = b->GetPointData()->GetScalars();
+  double maxDiff = 0.0;
+  for (vtkIdType i = 0; i < sa->GetNumberOfTuples(); i++)
+    {
+    for (int c = 0; c < sa->GetNumberOfComponents(); c++)
+      {
+      double diff = fabs(sa->GetComponent(i, c) - sb->GetComponent(i, c));
+      maxDiff = (diff > maxDiff ? diff : maxDiff);
+      }
+    }
+  return maxDiff;
+}
+
+int ImageResliceInterpolation(int, char *[])
+{
+  // an oblique rotation, and a permutation of the axes with a scale
+  double oblique[16] = {
+    0.866, -0.5, 0.0, 10.0,
+    0.5, 0.866, 0.1, 18.0,
+    0.0, -0.1, 0.995, 12.0,
+    0.0, 0.0, 0.0, 1.0 };
+  double permute[16] = {
+    0.0, 1.0, 0.0, 0.0,
+    0.0, 0.0, 1.0, 10.0,
+    1.0, 0.0, 0.0, 2.0,
+    0.0, 0.0, 0.0, 1.0 };
+  double *axes[2] = { oblique, permute };
+
+  int scalarTypes[4] = { VTK_UNSIGNED_CHAR, VTK_SHORT, VTK_FLOAT, VTK_DOUBLE };
+  int componentCounts[2] = { 1, 3 };
+  int interpolationModes[3] = { VTK_RESLICE_NEAREST, VTK_RESLICE_LINEAR,
+                                VTK_RESLICE_CUBIC };
+
+  for (int t = 0; t < 4; t++)
+    {
+    for (int nc = 0; nc < 2; nc++)
+      {
+      vtkSmartPointer<vtkImageData> image =
+        MakeImage(scalarTypes[t], componentCounts[nc]);
+      for (int a = 0; a < 2; a++)
+        {
+        vtkSmartPointer<vtkMatrix4x4> matrix =
+          vtkSmartPointer<vtkMatrix4x4>::New();
+        matrix->DeepCopy(axes[a]);
+        for (int m = 0; m < 3; m++)
+          {
+          for (int border = 0; border < 4; border++)
+            {
+            vtkSmartPointer<vtkImageData> outputs[2];
+            for (int optimize = 0; optimize < 2; optimize++)
+              {
+              vtkSmartPointer<vtkImageReslice> reslice =
+                vtkSmartPointer<vtkImageReslice>::New();
+              reslice->SetInput(image);
+              reslice->SetResliceAxes(matrix);
+              reslice->SetInterpolationMode(interpolationModes[m]);
+              reslice->SetOutputSpacing(0.7, 0.9, 1.1);
+              // nearest-neighbor sample points are kept away from the
+              // ties of rounding, that the two paths may break differently
+              double shift = (m == 0 ? 0.013 : 0.0);
+              reslice->SetOutputOrigin(-8.0 + shift, -6.0 + shift,
+                                       -4.0 + shift);
+              reslice->SetOutputExtent(0, 59, 0, 49, 0, 19);
+              reslice->SetBackgroundLevel(7.0);
+              reslice->SetBorder(border == 1);
+              reslice->SetWrap(border == 2);
+              reslice->SetMirror(border == 3);
+              reslice->SetOptimization(optimize);
+              reslice->Update();
+              outputs[optimize] = reslice->GetOutput();
+              }
+            // nearest-neighbor copies the voxels, the others allow for the
+            // rounding of float against double arithmetic
+            double tol = (scalarTypes[t] == VTK_FLOAT ||
+                          scalarTypes[t] == VTK_DOUBLE ? 1e-3 : 1.0);
+            tol = (m == 0 ? 0.0 : tol);
+            double diff = MaxDifference(outputs[0], outputs[1]);
+            if (diff > tol)
+              {
+              cerr << "Optimized output of type "
+                   << outputs[1]->GetScalarTypeAsString() << " with "
+                   << componentCounts[nc] << " components, axes " << a
+                   << ", interpolation " << interpolationModes[m]
+                   << " and border mode " << border << " differs by "
+                   << diff << "\n";
+              return 1;
+              }
+            }
+          }
+        }
+      }
+    }
+  return 0;
+}
@@ -0,0 +1,252 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reslice images with the windowed sinc and the B-spline interpolators.
+// The B-spline must go through the samples, the sinc must be more accurate
+// than linear interpolation on a smooth image, and the optimized output
+// must match the unoptimized one along oblique and permuted axes with
+// every border mode. The B-spline coefficients that a filter keeps between
+// executions must follow the changes of the input and of the wrap mode.
+
+#include "vtkDataArray.h"
+#include "vtkImageBSplineInterpolator.h"
+#include "vtkImageData.h"
+#include "vtkImageReslice.h"
+#include "vtkImageSincInterpolator.h"
+#include "vtkMatrix4x4.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <math.h>
+
+static double Smooth(double i, double j, double k, int c)
+{
+  return 60.0 + 50.0*sin(0.3*i + c)*cos(0.2*j) + 0.7*k;
+}
+
+static vtkSmartPointer<vtkImageData> MakeImage(int scalarType,
+                                               int components)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, 29, -3, 22, 0, 19);
+  image->SetScalarType(scalarType);
+  image->SetNumberOfScalarComponents(components);
+  image->AllocateScalars();
+  int *ext = image->GetExtent();
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        for (int c = 0; c < components; c++)
+          {
+          image->SetScalarComponentFromDouble(i, j, k, c, Smooth(i, j, k, c));
+          }
+        }
+      }
+    }
+  return image;
+}
+
+static double MaxDifference(vtkImageData *a, vtkImageData *b)
+{
+  vtkDataArray *sa = a->GetPointData()->GetScalars();
+  vtkDataArray *sb = b->GetPointData()->GetScalars();
+  if (sa->GetNumberOfTuples() != sb->GetNumberOfTuples() ||
+      sa->GetNumberOfComponents() != sb->GetNumberOfComponents())
+    {
+    return VTK_DOUBLE_MAX;
+    }
+  double maxDiff = 0.0;
+  for (vtkIdType i = 0; i < sa->GetNumberOfTuples(); i++)
+    {
+    for (int c = 0; c < sa->GetNumberOfComponents(); c++)
+      {
+      double diff = fabs(sa->GetComponent(i, c) - sb->GetComponent(i, c));
+      maxDiff = (diff > maxDiff ? diff : maxDiff);
+      }
+    }
+  return maxDiff;
+}
+
+// Return the largest error against the smooth function over the voxels
+// that are at least 'margin' voxels away from the borders of the input.
+static double MaxError(vtkImageData *output, double shift, int margin)
+{
+  int *ext = output->GetExtent();
+  double maxError = 0.0;
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        double x = i + shift, y = j + shift, z = k + shift;
+        if (x < margin || x > 29 - margin || y < margin - 3 ||
+            y > 22 - margin || z < margin || z > 19 - margin)
+          {
+          continue;
+          }
+        double error = fabs(output->GetScalarComponentAsDouble(i, j, k, 0) -
+                            Smooth(x, y, z, 0));
+        maxError = (error > maxError ? error : maxError);
+        }
+      }
+    }
+  return maxError;
+}
+
+static vtkSmartPointer<vtkImageData> Reslice(
+  vtkImageData *image, vtkMatrix4x4 *matrix, double shift,
+  vtkAbstractImageInterpolator *interpolator, int mode, int border,
+  int optimize)
+{
+  vtkSmartPointer<vtkImageReslice> reslice =
+    vtkSmartPointer<vtkImageReslice>::New();
+  reslice->SetInput(image);
+  reslice->SetResliceAxes(matrix);
+  reslice->SetInterpolator(interpolator);
+  reslice->SetInterpolationMode(mode);
+  reslice->SetOutputOrigin(shift, shift, shift);
+  reslice->SetBackgroundLevel(7.0);
+  reslice->SetBorder(border == 1);
+  reslice->SetWrap(border == 2);
+  reslice->SetMirror(border == 3);
+  reslice->SetOptimization(optimize);
+  reslice->Update();
+  return reslice->GetOutput();
+}
+
+int ImageResliceKernels(int, char *[])
+{
+  vtkSmartPointer<vtkImageSincInterpolator> sinc =
+    vtkSmartPointer<vtkImageSincInterpolator>::New();
+  vtkSmartPointer<vtkImageBSplineInterpolator> bspline =
+    vtkSmartPointer<vtkImageBSplineInterpolator>::New();
+
+  // The B-spline goes through the samples, whatever the border mode.
+  vtkSmartPointer<vtkImageData> image = MakeImage(VTK_DOUBLE, 1);
+  for (int border = 0; border < 4; border++)
+    {
+    double diff = MaxDifference(
+      image, Reslice(image, 0, 0.0, bspline, 0, border, 0));
+    if (diff > 1e-8)
+      {
+      cerr << "B-spline misses the samples by " << diff
+           << " with border mode " << border << "\n";
+      return 1;
+      }
+    }
+
+  // The kept coefficients are computed again for a modified input, and
+  // for another wrap mode: the output matches that of a new filter.
+  vtkSmartPointer<vtkImageReslice> reslice =
+    vtkSmartPointer<vtkImageReslice>::New();
+  reslice->SetInput(image);
+  reslice->SetInterpolator(bspline);
+  reslice->SetOutputOrigin(0.5, 0.5, 0.5);
+  reslice->SetBackgroundLevel(7.0);
+  reslice->Update();
+  vtkDataArray *scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+    {
+    scalars->SetComponent(i, 0, 3.0 - 0.5*scalars->GetComponent(i, 0));
+    }
+  image->Modified();
+  reslice->Update();
+  double diff = MaxDifference(reslice->GetOutput(),
+                              Reslice(image, 0, 0.5, bspline, 0, 0, 1));
+  if (diff != 0)
+    {
+    cerr << "B-spline of the modified input differs from a new filter by "
+         << diff << "\n";
+    return 1;
+    }
+  reslice->SetWrap(1);
+  reslice->Update();
+  diff = MaxDifference(reslice->GetOutput(),
+                       Reslice(image, 0, 0.5, bspline, 0, 2, 1));
+  if (diff != 0)
+    {
+    cerr << "Wrapped B-spline differs from a new filter by " << diff << "\n";
+    return 1;
+    }
+  image = MakeImage(VTK_DOUBLE, 1);
+
+  // Halfway between the samples, the sinc and the B-spline are closer to
+  // the smooth function than linear interpolation.
+  double linearError = MaxError(
+    Reslice(image, 0, 0.5, 0, VTK_RESLICE_LINEAR, 1, 1), 0.5, 3);
+  double sincError = MaxError(Reslice(image, 0, 0.5, sinc, 0, 1, 1), 0.5, 3);
+  double bsplineError = MaxError(
+    Reslice(image, 0, 0.5, bspline, 0, 1, 1), 0.5, 3);
+  if (sincError > 0.5*linearError || bsplineError > 0.5*linearError)
+    {
+    cerr << "Sinc error " << sincError << " and B-spline error "
+         << bsplineError << " against linear error " << linearError << "\n";
+    return 1;
+    }
+
+  // an oblique rotation, and a permutation of the axes
+  double oblique[16] = {
+    0.866, -0.5, 0.0, 10.0,
+    0.5, 0.866, 0.1, 8.0,
+    0.0, -0.1, 0.995, 6.0,
+    0.0, 0.0, 0.0, 1.0 };
+  double permute[16] = {
+    0.0, 1.0, 0.0, 0.0,
+    0.0, 0.0, 1.0, 5.0,
+    1.0, 0.0, 0.0, 2.0,
+    0.0, 0.0, 0.0, 1.0 };
+  double *axes[2] = { oblique, permute };
+  vtkAbstractImageInterpolator *interpolators[2] = { sinc, bspline };
+
+  int scalarTypes[2] = { VTK_UNSIGNED_CHAR, VTK_FLOAT };
+  for (int t = 0; t < 2; t++)
+    {
+    for (int nc = 1; nc <= 3; nc += 2)
+      {
+      image = MakeImage(scalarTypes[t], nc);
+      for (int a = 0; a < 2; a++)
+        {
+        vtkSmartPointer<vtkMatrix4x4> matrix =
+          vtkSmartPointer<vtkMatrix4x4>::New();
+        matrix->DeepCopy(axes[a]);
+        for (int m = 0; m < 2; m++)
+          {
+          for (int border = 0; border < 4; border++)
+            {
+            diff = MaxDifference(
+              Reslice(image, matrix, -2.3, interpolators[m], 0, border, 0),
+              Reslice(image, matrix, -2.3, interpolators[m], 0, border, 1));
+            // allow for rounding to the nearest integer
+            double tol = (scalarTypes[t] == VTK_FLOAT ? 1e-3 : 1.0);
+            if (diff > tol)
+              {
+              cerr << "Optimized output of "
+                   << interpolators[m]->GetClassName() << " with "
+                   << nc << " components of type " << scalarTypes[t]
+                   << ", axes " << a << " and border mode " << border
+                   << " differs by " << diff << "\n";
+              return 1;
+              }
+            }
+          }
+        }
+      }
+    }
+
+  return 0;
+}
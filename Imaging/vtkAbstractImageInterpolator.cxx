@@ -0,0 +1,106 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAbstractImageInterpolator.h"
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkPointData.h"
+
+vtkCxxRevisionMacro(vtkAbstractImageInterpolator, "$Revision$");
+
+//----------------------------------------------------------------------------
+vtkAbstractImageInterpolator::vtkAbstractImageInterpolator()
+{
+  this->WeightTable = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkAbstractImageInterpolator::~vtkAbstractImageInterpolator()
+{
+  if (this->WeightTable)
+    {
+    delete [] this->WeightTable;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "KernelSize: " << this->GetKernelSize() << "\n";
+  os << indent << "WeightTableResolution: "
+     << this->GetWeightTableResolution() << "\n";
+  os << indent << "RequiresCoefficients: "
+     << (this->GetRequiresCoefficients() ? "On\n" : "Off\n");
+}
+
+//----------------------------------------------------------------------------
+double *vtkAbstractImageInterpolator::GetWeightTable()
+{
+  if (this->WeightTable && this->WeightTableTime > this->GetMTime())
+    {
+    return this->WeightTable;
+    }
+
+  int size = this->GetKernelSize();
+  int resolution = this->GetWeightTableResolution();
+  if (this->WeightTable)
+    {
+    delete [] this->WeightTable;
+    }
+  this->WeightTable = new double[(resolution + 1)*size];
+
+  // the last row is the one for an offset of 1, i.e. the first row moved
+  // by one sample, so that lookups near 1 blend into it smoothly
+  for (int i = 0; i < resolution; i++)
+    {
+    this->ComputeWeights(static_cast<double>(i)/resolution,
+                         &this->WeightTable[i*size]);
+    }
+  double *last = &this->WeightTable[resolution*size];
+  last[0] = 0.0;
+  for (int j = 1; j < size; j++)
+    {
+    last[j] = this->WeightTable[j - 1];
+    }
+
+  this->WeightTableTime.Modified();
+  return this->WeightTable;
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::ComputeCoefficients(vtkImageData *input,
+                                                       vtkImageData *output,
+                                                       int vtkNotUsed(wrap))
+{
+  output->SetExtent(input->GetExtent());
+  output->SetScalarTypeToDouble();
+  output->SetNumberOfScalarComponents(input->GetNumberOfScalarComponents());
+  output->AllocateScalars();
+
+  vtkDataArray *inScalars = input->GetPointData()->GetScalars();
+  vtkDataArray *outScalars = output->GetPointData()->GetScalars();
+  vtkIdType n = outScalars->GetNumberOfTuples();
+  int numComponents = outScalars->GetNumberOfComponents();
+  double *outPtr = static_cast<double *>(outScalars->GetVoidPointer(0));
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    for (int c = 0; c < numComponents; c++)
+      {
+      *outPtr++ = inScalars->GetComponent(i, c);
+      }
+    }
+}
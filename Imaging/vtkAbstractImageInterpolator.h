@@ -0,0 +1,96 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAbstractImageInterpolator - separable interpolation kernel for vtkImageReslice
+// .SECTION Description
+// vtkAbstractImageInterpolator is the superclass of the interpolation
+// kernels that can be given to vtkImageReslice with SetInterpolator() in
+// place of its built-in interpolation modes. A kernel is separable: the
+// value at a point is the sum of the samples around it weighted by the
+// product of one weight per axis. Along each axis the kernel spans
+// KernelSize samples, half of them on each side of the point.
+//
+// Subclasses give the weights for a fractional offset with
+// ComputeWeights(). vtkImageReslice does not call it for every sample: it
+// looks the weights up in a table that GetWeightTable() fills once for
+// evenly spaced offsets, and interpolates linearly between its rows.
+//
+// A kernel that does not go through the samples, such as a B-spline,
+// applies to coefficients computed from the image rather than to the image
+// itself. Such a subclass returns 1 from GetRequiresCoefficients() and
+// computes the coefficients in ComputeCoefficients().
+// .SECTION See Also
+// vtkImageReslice vtkImageSincInterpolator vtkImageBSplineInterpolator
+
+#ifndef __vtkAbstractImageInterpolator_h
+#define __vtkAbstractImageInterpolator_h
+
+#include "vtkObject.h"
+
+// the largest number of samples a kernel may span along an axis
+#define VTK_INTERPOLATOR_MAX_KERNEL_SIZE 16
+
+class vtkImageData;
+
+class VTK_IMAGING_EXPORT vtkAbstractImageInterpolator : public vtkObject
+{
+public:
+  vtkTypeRevisionMacro(vtkAbstractImageInterpolator, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get the number of samples that the kernel spans along each axis. It is
+  // even and at most VTK_INTERPOLATOR_MAX_KERNEL_SIZE.
+  virtual int GetKernelSize() = 0;
+
+  // Description:
+  // Compute the KernelSize weights for a point at the fraction f of the way
+  // from a sample to the next one, with 0 <= f < 1.  The first weight
+  // applies to the sample KernelSize/2 - 1 before the first of the two.
+  virtual void ComputeWeights(double f, double *weights) = 0;
+
+  // Description:
+  // Get the table of the weights for GetWeightTableResolution() + 1 evenly
+  // spaced offsets from 0 to 1, KernelSize weights per offset. The table is
+  // computed again when the interpolator has been modified since the last
+  // call, so call this before sharing the table between threads.
+  double *GetWeightTable();
+  int GetWeightTableResolution() { return 512; };
+
+  // Description:
+  // Return 1 if the kernel applies to coefficients that ComputeCoefficients()
+  // computes from the image rather than to the image itself.
+  virtual int GetRequiresCoefficients() { return 0; };
+
+  // Description:
+  // Compute the coefficients that the kernel interpolates from the scalars
+  // of the input. The output gets the extent and the number of components
+  // of the input and double scalars. The image is extended past its borders
+  // periodically when wrap is on, and by mirroring it otherwise.
+  virtual void ComputeCoefficients(vtkImageData *input, vtkImageData *output,
+                                   int wrap);
+
+protected:
+  vtkAbstractImageInterpolator();
+  ~vtkAbstractImageInterpolator();
+
+  double *WeightTable;
+  vtkTimeStamp WeightTableTime;
+
+private:
+  vtkAbstractImageInterpolator(const vtkAbstractImageInterpolator&);  // Not implemented.
+  void operator=(const vtkAbstractImageInterpolator&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,170 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageBSplineInterpolator.h"
+
+#include "vtkImageData.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <vtkstd/vector>
+
+#include <math.h>
+
+vtkCxxRevisionMacro(vtkImageBSplineInterpolator, "$Revision$");
+vtkStandardNewMacro(vtkImageBSplineInterpolator);
+
+//----------------------------------------------------------------------------
+void vtkImageBSplineInterpolator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageBSplineInterpolator::ComputeWeights(double f, double *weights)
+{
+  double f2 = f*f;
+  double f3 = f2*f;
+  double r = 1 - f;
+
+  weights[0] = r*r*r/6;
+  weights[1] = (3*f3 - 6*f2 + 4)/6;
+  weights[2] = (-3*f3 + 3*f2 + 3*f + 1)/6;
+  weights[3] = f3/6;
+}
+
+//----------------------------------------------------------------------------
+// Replace the n samples of a line, 'stride' apart, by the coefficients of
+// the cubic B-spline that goes through them.  This is the recursive filter
+// of Unser, Aldroubi and Eden: a causal and an anticausal first-order
+// filter with the pole z.  The line is extended by mirroring it, the
+// sample before the first one being the first one, or periodically; one
+// period of the extended line is filtered in 'ext' so that the initial
+// values of both filters are exact.
+static void vtkBSplineFilterLine(double *line, vtkIdType stride, int n,
+                                 int wrap, double *ext)
+{
+  if (n < 2)
+    { // a single sample is its own coefficient
+    return;
+    }
+
+  const double z = sqrt(3.0) - 2.0;
+  const int horizon = 40; // z^40 is far below double precision
+  int p = (wrap ? n : 2*n);
+  double zp = pow(z, p);
+  int i;
+
+  for (i = 0; i < p; i++)
+    {
+    ext[i] = 6.0*line[(i < n ? i : 2*n - 1 - i)*stride];
+    }
+
+  // causal filter, starting from the sum over the previous period
+  double zk = 1.0;
+  double sum = ext[0];
+  for (i = 1; i < p && i < horizon; i++)
+    {
+    zk *= z;
+    sum += zk*ext[p - i];
+    }
+  ext[0] = sum/(1 - zp);
+  for (i = 1; i < p; i++)
+    {
+    ext[i] += z*ext[i - 1];
+    }
+
+  // anticausal filter, starting from the sum over the next period
+  zk = z;
+  sum = z*ext[p - 1];
+  for (i = 1; i < p && i < horizon; i++)
+    {
+    zk *= z;
+    sum += zk*ext[i - 1];
+    }
+  ext[p - 1] = -sum/(1 - zp);
+  for (i = p - 2; i >= 0; i--)
+    {
+    ext[i] = z*(ext[i + 1] - ext[i]);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+    line[i*stride] = ext[i];
+    }
+}
+
+//----------------------------------------------------------------------------
+// Filter the lines along Axis, each of them on its own: line l starts at
+// index l % Dimensions[axis1] along the next axis and l / Dimensions[axis1]
+// along the one after it.
+class vtkBSplineFilterLinesFunctor
+{
+public:
+  double *Coefficients;
+  vtkIdType Increments[3];
+  int Dimensions[3];
+  int NumberOfComponents;
+  int Axis;
+  int Wrap;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int axis = this->Axis;
+    int axis1 = (axis + 1) % 3;
+    int axis2 = (axis + 2) % 3;
+    vtkstd::vector<double> ext(2*this->Dimensions[axis]);
+    for (vtkIdType l = begin; l < end; l++)
+      {
+      vtkIdType i = l % this->Dimensions[axis1];
+      vtkIdType j = l / this->Dimensions[axis1];
+      double *line = this->Coefficients + i*this->Increments[axis1] +
+        j*this->Increments[axis2];
+      for (int c = 0; c < this->NumberOfComponents; c++)
+        {
+        vtkBSplineFilterLine(line + c, this->Increments[axis],
+                             this->Dimensions[axis], this->Wrap, &ext[0]);
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+void vtkImageBSplineInterpolator::ComputeCoefficients(vtkImageData *input,
+                                                      vtkImageData *output,
+                                                      int wrap)
+{
+  // start from a copy of the samples in double precision
+  this->Superclass::ComputeCoefficients(input, output, wrap);
+
+  vtkBSplineFilterLinesFunctor functor;
+  output->GetDimensions(functor.Dimensions);
+  functor.NumberOfComponents = output->GetNumberOfScalarComponents();
+  functor.Coefficients = static_cast<double *>(output->GetScalarPointer());
+  functor.Increments[0] = functor.NumberOfComponents;
+  functor.Increments[1] = functor.Increments[0]*functor.Dimensions[0];
+  functor.Increments[2] = functor.Increments[1]*functor.Dimensions[1];
+  functor.Wrap = wrap;
+
+  // the filter is separable: filter every line along each axis in turn,
+  // the lines along one axis in parallel
+  for (int axis = 0; axis < 3; axis++)
+    {
+    functor.Axis = axis;
+    vtkIdType numLines =
+      static_cast<vtkIdType>(functor.Dimensions[(axis + 1) % 3])*
+      functor.Dimensions[(axis + 2) % 3];
+    vtkSMPTools::For(0, numLines, functor);
+    }
+}
@@ -0,0 +1,61 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImageBSplineInterpolator - cubic B-spline interpolation for vtkImageReslice
+// .SECTION Description
+// vtkImageBSplineInterpolator interpolates with a cubic B-spline. It is
+// smoother than the cubic interpolation of vtkImageReslice and has a
+// continuous second derivative. A B-spline does not go through the
+// samples it is built on, so the kernel is applied to coefficients that
+// are computed by a recursive filter over the whole input before
+// reslicing: the spline built on them goes through the samples of the
+// image. The coefficients are computed in double precision along lines
+// that extend past the borders of the image by mirroring, or periodically
+// when vtkImageReslice wraps the image, so the whole input extent is
+// requested from upstream. The lines along each axis are filtered in
+// parallel.
+// .SECTION See Also
+// vtkImageReslice vtkAbstractImageInterpolator vtkImageSincInterpolator
+
+#ifndef __vtkImageBSplineInterpolator_h
+#define __vtkImageBSplineInterpolator_h
+
+#include "vtkAbstractImageInterpolator.h"
+
+class VTK_IMAGING_EXPORT vtkImageBSplineInterpolator :
+  public vtkAbstractImageInterpolator
+{
+public:
+  static vtkImageBSplineInterpolator *New();
+  vtkTypeRevisionMacro(vtkImageBSplineInterpolator,
+                       vtkAbstractImageInterpolator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  virtual int GetKernelSize() { return 4; };
+  virtual void ComputeWeights(double f, double *weights);
+
+  virtual int GetRequiresCoefficients() { return 1; };
+  virtual void ComputeCoefficients(vtkImageData *input, vtkImageData *output,
+                                   int wrap);
+
+protected:
+  vtkImageBSplineInterpolator() {};
+  ~vtkImageBSplineInterpolator() {};
+
+private:
+  vtkImageBSplineInterpolator(const vtkImageBSplineInterpolator&);  // Not implemented.
+  void operator=(const vtkImageBSplineInterpolator&);  // Not implemented.
+};
+
+#endif
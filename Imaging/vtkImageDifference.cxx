@@ -36,6 +36,9 @@ vtkImageDifference::vtkImageDifference()
   this->AllowShift = 1;
   this->Averaging = 1;
   this->SetNumberOfInputPorts(2);
+  // the errors are reset per threadId by every piece, and the thread pool
+  // may give several pieces to a threadId
+  this->UseThreadPool = 0;
 }
 
 
@@ -17,6 +17,7 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
@@ -555,6 +556,176 @@ void vtkImageEuclideanDistanceExecuteSaitoCached(
   free(temp);
   free(sq);
 }
+
+//----------------------------------------------------------------------------
+// The algorithm of Felzenszwalb and Huttenlocher for one line of n values
+// f: d[q] = min over p of (w*(q - p)^2 + f[p]), where w is the square of
+// the spacing.  The minimum is the lower envelope of the parabolas rooted
+// at each sample: v[] holds the samples whose parabola is part of it and
+// z[] the boundaries between them.  d may not be f.
+//
+// P. F. Felzenszwalb and D. P. Huttenlocher. Distance Transforms of Sampled
+// Functions. Cornell Computing and Information Science TR2004-1963, 2004.
+static void vtkImageEuclideanDistanceFelzenszwalbLine(const double *f,
+                                                      double *d, int n,
+                                                      double w, int *v,
+                                                      double *z)
+{
+  int k = 0;
+  int q;
+  double s;
+
+  v[0] = 0;
+  z[0] = -VTK_DOUBLE_MAX;
+  z[1] = VTK_DOUBLE_MAX;
+  for (q = 1; q < n; q++)
+    {
+    // drop the parabolas that the one of q hides, z[0] stops the search
+    for (;;)
+      {
+      int p = v[k];
+      s = ((f[q] + w*q*q) - (f[p] + w*p*p))/(2*w*(q - p));
+      if (s > z[k])
+        {
+        break;
+        }
+      k--;
+      }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = VTK_DOUBLE_MAX;
+    }
+
+  k = 0;
+  for (q = 0; q < n; q++)
+    {
+    while (z[k + 1] < q)
+      {
+      k++;
+      }
+    double dq = q - v[k];
+    d[q] = w*dq*dq + f[v[k]];
+    }
+}
+
+//----------------------------------------------------------------------------
+// The lines of one iteration of the algorithm of Felzenszwalb and
+// Huttenlocher.  They are processed in blocks of lines that are next to
+// each other in memory, so that lines along the slowest axes are read and
+// written in runs of contiguous values.
+#define VTK_EDT_BLOCK_SIZE 8
+
+struct vtkImageEuclideanDistanceLines
+{
+  vtkImageEuclideanDistance *Filter;
+  double *Ptr;
+  int Size0, Size1, Size2;
+  vtkIdType Inc0, Inc1, Inc2;
+  double Weight;
+};
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkImageEuclideanDistanceFelzenszwalbExecute(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkImageEuclideanDistanceLines *lines =
+    static_cast<vtkImageEuclideanDistanceLines *>(info->UserData);
+
+  int n = lines->Size0;
+  vtkIdType blocksPerRow =
+    (lines->Size1 + VTK_EDT_BLOCK_SIZE - 1)/VTK_EDT_BLOCK_SIZE;
+  vtkIdType numBlocks = blocksPerRow*lines->Size2;
+  vtkIdType firstBlock = numBlocks*info->ThreadID/info->NumberOfThreads;
+  vtkIdType lastBlock = numBlocks*(info->ThreadID + 1)/info->NumberOfThreads;
+
+  // the values of a block, line after line, and the envelope of one line
+  double *f = new double[VTK_EDT_BLOCK_SIZE*n];
+  double *d = new double[n];
+  double *z = new double[n + 1];
+  int *v = new int[n];
+
+  for (vtkIdType block = firstBlock; block < lastBlock; block++)
+    {
+    if (lines->Filter->AbortExecute)
+      {
+      break;
+      }
+    int idx1 = static_cast<int>(block % blocksPerRow)*VTK_EDT_BLOCK_SIZE;
+    vtkIdType idx2 = block/blocksPerRow;
+    int numLines = lines->Size1 - idx1;
+    numLines = (numLines < VTK_EDT_BLOCK_SIZE ? numLines : VTK_EDT_BLOCK_SIZE);
+    double *ptr = lines->Ptr + idx1*lines->Inc1 + idx2*lines->Inc2;
+    int idx0, l;
+
+    for (idx0 = 0; idx0 < n; idx0++)
+      {
+      double *ptr0 = ptr + idx0*lines->Inc0;
+      for (l = 0; l < numLines; l++)
+        {
+        f[l*n + idx0] = ptr0[l*lines->Inc1];
+        }
+      }
+
+    for (l = 0; l < numLines; l++)
+      {
+      vtkImageEuclideanDistanceFelzenszwalbLine(f + l*n, d, n,
+                                                lines->Weight, v, z);
+      memcpy(f + l*n, d, n*sizeof(double));
+      }
+
+    for (idx0 = 0; idx0 < n; idx0++)
+      {
+      double *ptr0 = ptr + idx0*lines->Inc0;
+      for (l = 0; l < numLines; l++)
+        {
+        ptr0[l*lines->Inc1] = f[l*n + idx0];
+        }
+      }
+    }
+
+  delete [] f;
+  delete [] d;
+  delete [] z;
+  delete [] v;
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageEuclideanDistance::ExecuteFelzenszwalb(vtkImageData *outData,
+                                                    int outExt[6],
+                                                    double *outPtr)
+{
+  int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
+  vtkImageEuclideanDistanceLines lines;
+
+  // Reorder axes
+  this->PermuteExtent(outExt, outMin0,outMax0,outMin1,outMax1,outMin2,outMax2);
+  this->PermuteIncrements(outData->GetIncrements(),
+                          lines.Inc0, lines.Inc1, lines.Inc2);
+
+  lines.Filter = this;
+  lines.Ptr = outPtr;
+  lines.Size0 = outMax0 - outMin0 + 1;
+  lines.Size1 = outMax1 - outMin1 + 1;
+  lines.Size2 = outMax2 - outMin2 + 1;
+
+  // Anisotropy is handled by the width of the parabolas
+  double spacing = 1.0;
+  if (this->ConsiderAnisotropy)
+    {
+    spacing = outData->GetSpacing()[this->Iteration];
+    }
+  lines.Weight = spacing*spacing;
+
+  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
+  this->Threader->SetUseThreadPool(this->UseThreadPool);
+  this->Threader->SetSingleMethod(
+    vtkImageEuclideanDistanceFelzenszwalbExecute, &lines);
+  this->Threader->SingleMethodExecute();
+}
 //----------------------------------------------------------------------------
 void vtkImageEuclideanDistance::AllocateOutputScalars(vtkImageData *outData)
 {
@@ -652,6 +823,10 @@ int vtkImageEuclideanDistance::IterativeRequestData(
       vtkImageEuclideanDistanceExecuteSaitoCached( this, outData, outExt, 
                                                    static_cast<double *>(outPtr) );
       break;
+    case VTK_EDT_FELZENSZWALB:
+      this->ExecuteFelzenszwalb( outData, outExt,
+                                 static_cast<double *>(outPtr) );
+      break;
     default:
       vtkErrorMacro(<< "Execute: Unknown Algorithm");
     }
@@ -747,6 +922,10 @@ void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << "Saito\n";
     }
+  else if ( this->Algorithm == VTK_EDT_FELZENSZWALB )
+    {
+    os << "Felzenszwalb\n";
+    }
   else 
     {
     os << "Saito Cached\n";
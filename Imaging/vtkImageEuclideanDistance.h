@@ -29,6 +29,12 @@
 // slow it very significantly. In that case, one should use 
 // ::SetAlgorithmToSaitoCached() instead for better performance. 
 //
+// ::SetAlgorithmToFelzenszwalb() selects the algorithm of Felzenszwalb
+// and Huttenlocher, which computes the exact distance along each axis as
+// the lower envelope of parabolas. Its cost is linear in the number of
+// voxels whatever the distances and the spacing, and the lines of each
+// axis are split across the threads of the filter.
+//
 // References:
 //
 // T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance 
@@ -38,6 +44,9 @@
 // O. Cuisenaire. Distance Transformation: fast algorithms and applications
 // to medical image processing. PhD Thesis, Universite catholique de Louvain,
 // October 1999. http://ltswww.epfl.ch/~cuisenai/papers/oc_thesis.pdf 
+//
+// P. F. Felzenszwalb and D. P. Huttenlocher. Distance Transforms of Sampled
+// Functions. Cornell Computing and Information Science TR2004-1963, 2004.
  
 
 #ifndef __vtkImageEuclideanDistance_h
@@ -47,6 +56,7 @@
 
 #define VTK_EDT_SAITO_CACHED 0
 #define VTK_EDT_SAITO 1 
+#define VTK_EDT_FELZENSZWALB 2
 
 class VTK_IMAGING_EXPORT vtkImageEuclideanDistance : public vtkImageDecomposeFilter
 {
@@ -92,6 +102,7 @@ public:
   // Selects a Euclidean DT algorithm. 
   // 1. Saito
   // 2. Saito-cached 
+  // 3. Felzenszwalb, linear and threaded
   // More algorithms will be added later on. 
   vtkSetMacro(Algorithm, int);
   vtkGetMacro(Algorithm, int);
@@ -99,6 +110,8 @@ public:
     { this->SetAlgorithm(VTK_EDT_SAITO); } 
   void SetAlgorithmToSaitoCached () 
     { this->SetAlgorithm(VTK_EDT_SAITO_CACHED); }   
+  void SetAlgorithmToFelzenszwalb () 
+    { this->SetAlgorithm(VTK_EDT_FELZENSZWALB); }   
 
   virtual int IterativeRequestData(vtkInformation*,
                                    vtkInformationVector**,
@@ -115,6 +128,12 @@ protected:
 
   // Replaces "EnlargeOutputUpdateExtent"
   virtual void AllocateOutputScalars(vtkImageData *outData);
+
+  // Description:
+  // Execute the algorithm of Felzenszwalb and Huttenlocher along the axis
+  // of the current iteration, with the lines split across the threads.
+  void ExecuteFelzenszwalb(vtkImageData *outData, int outExt[6],
+                           double *outPtr);
   
   virtual int IterativeRequestInformation(vtkInformation* in,
                                           vtkInformation* out);
@@ -57,6 +57,19 @@ int vtkImageFFT::IterativeRequestUpdateExtent(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// The multi-axis transform replaces the iterations over the axes.
+int vtkImageFFT::RequestData(vtkInformation* request,
+                             vtkInformationVector** inputVector,
+                             vtkInformationVector* outputVector)
+{
+  if (this->MultiAxisTransform)
+    {
+    return this->RequestMultiAxisData(inputVector, outputVector, 1);
+    }
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
 //----------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
 // is always doubles.
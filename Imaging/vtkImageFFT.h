@@ -22,6 +22,9 @@
 // prime factor of the dimension.  This makes images with prime number dimensions 
 // (i.e. 17x17) much slower to compute.  Multi dimensional (i.e volumes) 
 // FFT's are decomposed so that each axis executes in series.
+// With MultiAxisTransform on, all the axes are transformed in one
+// execution instead, which is faster for any size and much faster for
+// prime sizes (see vtkImageFourierFilter).
 
 
 #ifndef __vtkImageFFT_h
@@ -56,6 +59,9 @@ protected:
                                           vtkInformation* out);
   virtual int IterativeRequestUpdateExtent(vtkInformation* in,
                                            vtkInformation* out);
+  virtual int RequestData(vtkInformation* request,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector);
   
   void ThreadedExecute(vtkImageData *inData, vtkImageData *outData,
                        int outExt[6], int threadId);
@@ -14,10 +14,37 @@
 =========================================================================*/
 #include "vtkImageFourierFilter.h"
 
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkMultiThreader.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
 #include <math.h>
+#include <vtkstd/vector>
 
 vtkCxxRevisionMacro(vtkImageFourierFilter, "$Revision$");
 
+// The number of lines transformed together by the multi-axis transform.
+#define VTK_FOURIER_BLOCK_SIZE 16
+
+//----------------------------------------------------------------------------
+vtkImageFourierFilter::vtkImageFourierFilter()
+{
+  this->MultiAxisTransform = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierFilter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "MultiAxisTransform: "
+     << (this->MultiAxisTransform ? "On" : "Off") << "\n";
+}
+
 
 /*=========================================================================
         Vectors of complex numbers.
@@ -233,3 +260,734 @@ void vtkImageFourierFilter::ExecuteRfft(vtkImageComplex *in,
 }
  
 
+
+/*=========================================================================
+        Multi-axis transform.
+=========================================================================*/
+
+//----------------------------------------------------------------------------
+// A transform of length N, forward (Direction = 1) or reverse (-1) and
+// unscaled, of a block of lines whose real and imaginary parts are stored
+// apart and whose lines are interleaved: element k of line l of a block
+// of 'lanes' lines is re[k*lanes + l] + i*im[k*lanes + l].  The innermost
+// loops run over the lines of the block, so that they can be vectorized.
+// Lengths whose prime factors are at most 13 are transformed with the
+// Stockham autosort algorithm, one stage per factor.  The other lengths
+// use Bluestein's algorithm: a convolution with a chirp, computed with
+// transforms of a power of two length.
+class vtkImageFourierFilterPlan
+{
+public:
+  vtkImageFourierFilterPlan(int n, int direction);
+  ~vtkImageFourierFilterPlan();
+
+  // Description:
+  // The number of doubles of scratch space that Execute() needs.
+  vtkIdType GetWorkSize(int lanes);
+
+  // Description:
+  // Transform a block of lines in place.
+  void Execute(double *re, double *im, int lanes, double *work);
+
+protected:
+  void ExecuteStages(double *re, double *im, int lanes, double *work);
+  void ExecuteBluestein(double *re, double *im, int lanes, double *work);
+
+  int N;
+  int Direction;
+  vtkstd::vector<int> Radices;
+  // the twiddle factors of all the stages, one stage after the other
+  vtkstd::vector<double> TwiddleRe;
+  vtkstd::vector<double> TwiddleIm;
+  // for Bluestein: the length of the convolution, its transforms, the
+  // chirp and the transform of the filter, divided by the length
+  int M;
+  vtkImageFourierFilterPlan *Forward;
+  vtkImageFourierFilterPlan *Reverse;
+  vtkstd::vector<double> ChirpRe;
+  vtkstd::vector<double> ChirpIm;
+  vtkstd::vector<double> FilterRe;
+  vtkstd::vector<double> FilterIm;
+};
+
+//----------------------------------------------------------------------------
+vtkImageFourierFilterPlan::vtkImageFourierFilterPlan(int n, int direction)
+{
+  static const int primes[6] = { 2, 3, 5, 7, 11, 13 };
+  double pi = vtkMath::DoublePi();
+  int i, j, k;
+
+  this->N = n;
+  this->Direction = direction;
+  this->M = 0;
+  this->Forward = 0;
+  this->Reverse = 0;
+
+  // Factor the length, with as many radix 4 stages as possible.
+  int rest = n;
+  while (rest % 4 == 0)
+    {
+    this->Radices.push_back(4);
+    rest /= 4;
+    }
+  for (i = 0; i < 6; i++)
+    {
+    while (rest % primes[i] == 0)
+      {
+      this->Radices.push_back(primes[i]);
+      rest /= primes[i];
+      }
+    }
+
+  if (rest == 1)
+    {
+    // The twiddle factors: a stage of radix p of a sub-transform of
+    // length n multiplies output u of butterfly j by w^(j*u), w being the
+    // n-th root of unity.
+    for (i = 0; i < static_cast<int>(this->Radices.size()); i++)
+      {
+      int p = this->Radices[i];
+      int m = n/p;
+      for (j = 0; j < m; j++)
+        {
+        for (k = 0; k < p; k++)
+          {
+          double angle = -2.0*pi*direction*((j*k) % n)/n;
+          this->TwiddleRe.push_back(cos(angle));
+          this->TwiddleIm.push_back(sin(angle));
+          }
+        }
+      n = m;
+      }
+    return;
+    }
+
+  // Bluestein's algorithm for lengths with larger prime factors: with the
+  // chirp c[k] = exp(-i*pi*direction*k^2/N), the transform is c times the
+  // convolution of x*c with the conjugate of c.
+  n = this->N;
+  this->Radices.clear();
+  this->M = 1;
+  while (this->M < 2*n - 1)
+    {
+    this->M *= 2;
+    }
+  this->Forward = new vtkImageFourierFilterPlan(this->M, 1);
+  this->Reverse = new vtkImageFourierFilterPlan(this->M, -1);
+
+  this->ChirpRe.resize(n);
+  this->ChirpIm.resize(n);
+  for (k = 0; k < n; k++)
+    {
+    // k^2 modulo 2N keeps the angle accurate for long lines
+    double angle = -pi*direction*fmod(static_cast<double>(k)*k, 2.0*n)/n;
+    this->ChirpRe[k] = cos(angle);
+    this->ChirpIm[k] = sin(angle);
+    }
+
+  this->FilterRe.assign(this->M, 0.0);
+  this->FilterIm.assign(this->M, 0.0);
+  for (k = 0; k < n; k++)
+    {
+    this->FilterRe[k] = this->ChirpRe[k];
+    this->FilterIm[k] = -this->ChirpIm[k];
+    if (k > 0)
+      {
+      this->FilterRe[this->M - k] = this->ChirpRe[k];
+      this->FilterIm[this->M - k] = -this->ChirpIm[k];
+      }
+    }
+  vtkstd::vector<double> work(this->Forward->GetWorkSize(1));
+  this->Forward->Execute(&this->FilterRe[0], &this->FilterIm[0], 1, &work[0]);
+  for (k = 0; k < this->M; k++)
+    {
+    this->FilterRe[k] /= this->M;
+    this->FilterIm[k] /= this->M;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkImageFourierFilterPlan::~vtkImageFourierFilterPlan()
+{
+  delete this->Forward;
+  delete this->Reverse;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkImageFourierFilterPlan::GetWorkSize(int lanes)
+{
+  if (this->Forward)
+    {
+    return 2*static_cast<vtkIdType>(this->M)*lanes +
+      this->Forward->GetWorkSize(lanes);
+    }
+  return 2*static_cast<vtkIdType>(this->N)*lanes;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierFilterPlan::Execute(double *re, double *im, int lanes,
+                                        double *work)
+{
+  if (this->Forward)
+    {
+    this->ExecuteBluestein(re, im, lanes, work);
+    }
+  else
+    {
+    this->ExecuteStages(re, im, lanes, work);
+    }
+}
+
+//----------------------------------------------------------------------------
+// One stage of the Stockham algorithm: the m butterflies of radix p of
+// sub-transforms of length m*p.  Input r of butterfly j is x[j + r*m] and
+// its output u goes to y[j*p + u], times the twiddle factor, where each
+// element is a run of s doubles: the lanes times the sub-transforms
+// already done.
+static void vtkImageFourierFilterStage(int p, int m, vtkIdType s,
+                                       int direction,
+                                       const double *twRe,
+                                       const double *twIm,
+                                       const double *xRe, const double *xIm,
+                                       double *yRe, double *yIm)
+{
+  vtkIdType ms = m*s;
+  vtkIdType t;
+  int j, r, u;
+
+  // the p-th roots of unity, for the general butterfly
+  double rootRe[13], rootIm[13];
+  for (r = 0; r < p && p > 4; r++)
+    {
+    double angle = -2.0*vtkMath::DoublePi()*direction*r/p;
+    rootRe[r] = cos(angle);
+    rootIm[r] = sin(angle);
+    }
+
+  for (j = 0; j < m; j++)
+    {
+    const double *wRe = twRe + j*p;
+    const double *wIm = twIm + j*p;
+    const double *aRe = xRe + j*s;
+    const double *aIm = xIm + j*s;
+    double *bRe = yRe + j*p*s;
+    double *bIm = yIm + j*p*s;
+
+    switch (p)
+      {
+      case 2:
+        for (t = 0; t < s; t++)
+          {
+          double dRe = aRe[t] - aRe[t + ms];
+          double dIm = aIm[t] - aIm[t + ms];
+          bRe[t] = aRe[t] + aRe[t + ms];
+          bIm[t] = aIm[t] + aIm[t + ms];
+          bRe[t + s] = dRe*wRe[1] - dIm*wIm[1];
+          bIm[t + s] = dRe*wIm[1] + dIm*wRe[1];
+          }
+        break;
+
+      case 3:
+        {
+        double c = -0.5;
+        double sn = direction*0.5*sqrt(3.0);
+        for (t = 0; t < s; t++)
+          {
+          double sumRe = aRe[t + ms] + aRe[t + 2*ms];
+          double sumIm = aIm[t + ms] + aIm[t + 2*ms];
+          double difRe = sn*(aRe[t + ms] - aRe[t + 2*ms]);
+          double difIm = sn*(aIm[t + ms] - aIm[t + 2*ms]);
+          double baseRe = aRe[t] + c*sumRe;
+          double baseIm = aIm[t] + c*sumIm;
+          // -i*sin(2pi/3) times the difference
+          double b1Re = baseRe + difIm;
+          double b1Im = baseIm - difRe;
+          double b2Re = baseRe - difIm;
+          double b2Im = baseIm + difRe;
+          bRe[t] = aRe[t] + sumRe;
+          bIm[t] = aIm[t] + sumIm;
+          bRe[t + s] = b1Re*wRe[1] - b1Im*wIm[1];
+          bIm[t + s] = b1Re*wIm[1] + b1Im*wRe[1];
+          bRe[t + 2*s] = b2Re*wRe[2] - b2Im*wIm[2];
+          bIm[t + 2*s] = b2Re*wIm[2] + b2Im*wRe[2];
+          }
+        }
+        break;
+
+      case 4:
+        for (t = 0; t < s; t++)
+          {
+          double t0Re = aRe[t] + aRe[t + 2*ms];
+          double t0Im = aIm[t] + aIm[t + 2*ms];
+          double t1Re = aRe[t] - aRe[t + 2*ms];
+          double t1Im = aIm[t] - aIm[t + 2*ms];
+          double t2Re = aRe[t + ms] + aRe[t + 3*ms];
+          double t2Im = aIm[t + ms] + aIm[t + 3*ms];
+          // -i*direction times the difference of the odd inputs
+          double t3Re = direction*(aIm[t + ms] - aIm[t + 3*ms]);
+          double t3Im = -direction*(aRe[t + ms] - aRe[t + 3*ms]);
+          double b1Re = t1Re + t3Re;
+          double b1Im = t1Im + t3Im;
+          double b2Re = t0Re - t2Re;
+          double b2Im = t0Im - t2Im;
+          double b3Re = t1Re - t3Re;
+          double b3Im = t1Im - t3Im;
+          bRe[t] = t0Re + t2Re;
+          bIm[t] = t0Im + t2Im;
+          bRe[t + s] = b1Re*wRe[1] - b1Im*wIm[1];
+          bIm[t + s] = b1Re*wIm[1] + b1Im*wRe[1];
+          bRe[t + 2*s] = b2Re*wRe[2] - b2Im*wIm[2];
+          bIm[t + 2*s] = b2Re*wIm[2] + b2Im*wRe[2];
+          bRe[t + 3*s] = b3Re*wRe[3] - b3Im*wIm[3];
+          bIm[t + 3*s] = b3Re*wIm[3] + b3Im*wRe[3];
+          }
+        break;
+
+      default:
+        for (u = 0; u < p; u++)
+          {
+          double *oRe = bRe + u*s;
+          double *oIm = bIm + u*s;
+          for (t = 0; t < s; t++)
+            {
+            oRe[t] = aRe[t];
+            oIm[t] = aIm[t];
+            }
+          for (r = 1; r < p; r++)
+            {
+            double cRe = rootRe[(r*u) % p];
+            double cIm = rootIm[(r*u) % p];
+            const double *iRe = aRe + r*ms;
+            const double *iIm = aIm + r*ms;
+            for (t = 0; t < s; t++)
+              {
+              oRe[t] += iRe[t]*cRe - iIm[t]*cIm;
+              oIm[t] += iRe[t]*cIm + iIm[t]*cRe;
+              }
+            }
+          if (u > 0)
+            {
+            for (t = 0; t < s; t++)
+              {
+              double vRe = oRe[t];
+              oRe[t] = vRe*wRe[u] - oIm[t]*wIm[u];
+              oIm[t] = vRe*wIm[u] + oIm[t]*wRe[u];
+              }
+            }
+          }
+        break;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierFilterPlan::ExecuteStages(double *re, double *im,
+                                              int lanes, double *work)
+{
+  int numStages = static_cast<int>(this->Radices.size());
+  if (numStages == 0)
+    {
+    return;
+    }
+
+  vtkIdType size = static_cast<vtkIdType>(this->N)*lanes;
+  double *xRe = re;
+  double *xIm = im;
+  double *yRe = work;
+  double *yIm = work + size;
+  const double *twRe = &this->TwiddleRe[0];
+  const double *twIm = &this->TwiddleIm[0];
+  int n = this->N;
+  vtkIdType s = lanes;
+
+  for (int i = 0; i < numStages; i++)
+    {
+    int p = this->Radices[i];
+    vtkImageFourierFilterStage(p, n/p, s, this->Direction, twRe, twIm,
+                               xRe, xIm, yRe, yIm);
+    twRe += n;
+    twIm += n;
+    n /= p;
+    s *= p;
+    double *tmp = xRe; xRe = yRe; yRe = tmp;
+    tmp = xIm; xIm = yIm; yIm = tmp;
+    }
+
+  // the stages alternate between the block and the work space
+  if (xRe != re)
+    {
+    memcpy(re, xRe, size*sizeof(double));
+    memcpy(im, xIm, size*sizeof(double));
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierFilterPlan::ExecuteBluestein(double *re, double *im,
+                                                 int lanes, double *work)
+{
+  int n = this->N;
+  int m = this->M;
+  double *aRe = work;
+  double *aIm = work + static_cast<vtkIdType>(m)*lanes;
+  double *subWork = aIm + static_cast<vtkIdType>(m)*lanes;
+  vtkIdType idx;
+  int k, l;
+
+  // the lines times the chirp, padded with zeros
+  for (k = 0, idx = 0; k < n; k++)
+    {
+    double cRe = this->ChirpRe[k];
+    double cIm = this->ChirpIm[k];
+    for (l = 0; l < lanes; l++, idx++)
+      {
+      aRe[idx] = re[idx]*cRe - im[idx]*cIm;
+      aIm[idx] = re[idx]*cIm + im[idx]*cRe;
+      }
+    }
+  memset(aRe + idx, 0, (static_cast<vtkIdType>(m)*lanes - idx)*sizeof(double));
+  memset(aIm + idx, 0, (static_cast<vtkIdType>(m)*lanes - idx)*sizeof(double));
+
+  // the convolution with the conjugate chirp
+  this->Forward->Execute(aRe, aIm, lanes, subWork);
+  for (k = 0, idx = 0; k < m; k++)
+    {
+    double fRe = this->FilterRe[k];
+    double fIm = this->FilterIm[k];
+    for (l = 0; l < lanes; l++, idx++)
+      {
+      double vRe = aRe[idx];
+      aRe[idx] = vRe*fRe - aIm[idx]*fIm;
+      aIm[idx] = vRe*fIm + aIm[idx]*fRe;
+      }
+    }
+  this->Reverse->Execute(aRe, aIm, lanes, subWork);
+
+  // times the chirp again
+  for (k = 0, idx = 0; k < n; k++)
+    {
+    double cRe = this->ChirpRe[k];
+    double cIm = this->ChirpIm[k];
+    for (l = 0; l < lanes; l++, idx++)
+      {
+      re[idx] = aRe[idx]*cRe - aIm[idx]*cIm;
+      im[idx] = aRe[idx]*cIm + aIm[idx]*cRe;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// The transform of the lines along one axis of the region that the
+// multi-axis transform computes in place.  The first pass reads the input
+// instead of the region.
+struct vtkImageFourierFilterPass
+{
+  vtkImageFourierFilter *Filter;
+  vtkImageFourierFilterPlan *Plan;
+  int Axis;
+  int Dimensionality;
+  int Dimensions[3];
+  // the region: complex doubles with real and imaginary parts interleaved
+  double *Region;
+  vtkIdType RegionIncrements[3];
+  // the input for the first pass, NULL for the other ones
+  void *InPtr;
+  int InScalarType;
+  int InComponents;
+  vtkIdType InIncrements[3];
+  // 1/N for the reverse transform
+  double Scale;
+};
+
+//----------------------------------------------------------------------------
+// Copy numLines lines of n elements, 'inc' apart along the line and
+// 'lineInc' apart from one line to the next, into a block.  Complex lines
+// fill one lane each.  Real lines (numComp == 1) fill the real and the
+// imaginary part of a lane in turn, so that one complex transform does
+// two real ones.  Lanes without a line are zero.
+template <class T>
+void vtkImageFourierFilterGather(const T *inPtr, vtkIdType inc,
+                                 vtkIdType lineInc, int numComp, int n,
+                                 int numLines, int lanes,
+                                 double *re, double *im)
+{
+  int k, l;
+  vtkIdType idx = 0;
+  for (k = 0; k < n; k++)
+    {
+    const T *ptr = inPtr + k*inc;
+    if (numComp == 1)
+      {
+      for (l = 0; l < lanes; l++, idx++)
+        {
+        re[idx] = (2*l < numLines ?
+                   static_cast<double>(ptr[2*l*lineInc]) : 0.0);
+        im[idx] = (2*l + 1 < numLines ?
+                   static_cast<double>(ptr[(2*l + 1)*lineInc]) : 0.0);
+        }
+      }
+    else
+      {
+      for (l = 0; l < lanes; l++, idx++)
+        {
+        if (l < numLines)
+          {
+          re[idx] = static_cast<double>(ptr[l*lineInc]);
+          im[idx] = static_cast<double>(ptr[l*lineInc + 1]);
+          }
+        else
+          {
+          re[idx] = 0.0;
+          im[idx] = 0.0;
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Copy the transformed block back into the region, scaled.  For lanes
+// that hold two real lines x and y, Z = X + iY and the transforms of x
+// and y are separated with X[k] = (Z[k] + conj(Z[N-k]))/2 and
+// Y[k] = (Z[k] - conj(Z[N-k]))/2i.
+static void vtkImageFourierFilterScatter(double *outPtr, vtkIdType inc,
+                                         vtkIdType lineInc, int realPairs,
+                                         int n, int numLines, int lanes,
+                                         double scale,
+                                         const double *re, const double *im)
+{
+  int k, l;
+  for (k = 0; k < n; k++)
+    {
+    double *ptr = outPtr + k*inc;
+    const double *zRe = re + k*lanes;
+    const double *zIm = im + k*lanes;
+    if (realPairs)
+      {
+      const double *wRe = re + ((n - k) % n)*lanes;
+      const double *wIm = im + ((n - k) % n)*lanes;
+      double half = 0.5*scale;
+      for (l = 0; 2*l < numLines; l++)
+        {
+        double *xPtr = ptr + 2*l*lineInc;
+        xPtr[0] = half*(zRe[l] + wRe[l]);
+        xPtr[1] = half*(zIm[l] - wIm[l]);
+        if (2*l + 1 < numLines)
+          {
+          double *yPtr = xPtr + lineInc;
+          yPtr[0] = half*(zIm[l] + wIm[l]);
+          yPtr[1] = half*(wRe[l] - zRe[l]);
+          }
+        }
+      }
+    else
+      {
+      for (l = 0; l < numLines; l++)
+        {
+        ptr[l*lineInc] = scale*zRe[l];
+        ptr[l*lineInc + 1] = scale*zIm[l];
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Each thread transforms a range of the blocks of lines along the axis.
+// A block is made of consecutive lines along the lowest of the other
+// axes, so that it is read and written in runs of contiguous memory.
+VTK_THREAD_RETURN_TYPE vtkImageFourierFilterMultiAxisExecute(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkImageFourierFilterPass *pass =
+    static_cast<vtkImageFourierFilterPass *>(info->UserData);
+  int id = info->ThreadID;
+
+  int axis = pass->Axis;
+  int axis1 = (axis == 0 ? 1 : 0);
+  int axis2 = (axis == 2 ? 1 : 2);
+  int n = pass->Dimensions[axis];
+  int numLines1 = pass->Dimensions[axis1];
+  vtkIdType blocksPerRow =
+    (numLines1 + VTK_FOURIER_BLOCK_SIZE - 1)/VTK_FOURIER_BLOCK_SIZE;
+  vtkIdType numBlocks = blocksPerRow*pass->Dimensions[axis2];
+  vtkIdType firstBlock = numBlocks*id/info->NumberOfThreads;
+  vtkIdType lastBlock = numBlocks*(id + 1)/info->NumberOfThreads;
+
+  int realPairs = (pass->InPtr && pass->InComponents == 1);
+  int lanes = VTK_FOURIER_BLOCK_SIZE/(realPairs ? 2 : 1);
+  vtkIdType blockSize = static_cast<vtkIdType>(n)*lanes;
+  vtkstd::vector<double> buffer(2*blockSize + pass->Plan->GetWorkSize(lanes));
+  double *re = &buffer[0];
+  double *im = re + blockSize;
+  double *work = im + blockSize;
+
+  const vtkIdType *regionInc = pass->RegionIncrements;
+  const vtkIdType *inInc = pass->InIncrements;
+
+  for (vtkIdType block = firstBlock; block < lastBlock; block++)
+    {
+    if (pass->Filter->AbortExecute)
+      {
+      break;
+      }
+    if (id == 0 && (block - firstBlock) % 64 == 0)
+      {
+      pass->Filter->UpdateProgress(
+        (axis + (block - firstBlock)/
+         static_cast<double>(lastBlock - firstBlock))/pass->Dimensionality);
+      }
+
+    vtkIdType idx2 = block/blocksPerRow;
+    int idx1 = static_cast<int>(block % blocksPerRow)*VTK_FOURIER_BLOCK_SIZE;
+    int numLines = numLines1 - idx1;
+    numLines = (numLines < VTK_FOURIER_BLOCK_SIZE ?
+                numLines : VTK_FOURIER_BLOCK_SIZE);
+
+    if (pass->InPtr)
+      {
+      vtkIdType offset = idx1*inInc[axis1] + idx2*inInc[axis2];
+      switch (pass->InScalarType)
+        {
+        vtkTemplateMacro(
+          vtkImageFourierFilterGather(
+            static_cast<VTK_TT *>(pass->InPtr) + offset, inInc[axis],
+            inInc[axis1], pass->InComponents, n, numLines, lanes, re, im));
+        }
+      }
+    else
+      {
+      vtkImageFourierFilterGather(
+        pass->Region + idx1*regionInc[axis1] + idx2*regionInc[axis2],
+        regionInc[axis], regionInc[axis1], 2, n, numLines, lanes, re, im);
+      }
+
+    pass->Plan->Execute(re, im, lanes, work);
+
+    vtkImageFourierFilterScatter(
+      pass->Region + idx1*regionInc[axis1] + idx2*regionInc[axis2],
+      regionInc[axis], regionInc[axis1], realPairs, n, numLines, lanes,
+      pass->Scale, re, im);
+    }
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageFourierFilter::RequestMultiAxisData(
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector,
+  int direction)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkImageData *inData = vtkImageData::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkImageData *outData = vtkImageData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  this->AllocateOutputData(outData, outExt);
+  this->CopyAttributeData(inData, outData, inputVector);
+
+  // this filter expects that the output be complex doubles.
+  if (outData->GetScalarType() != VTK_DOUBLE ||
+      outData->GetNumberOfScalarComponents() != 2)
+    {
+    vtkErrorMacro(<< "Execute: Output must be complex doubles.");
+    return 0;
+    }
+
+  // Input has to have real components at least.
+  int numComp = inData->GetNumberOfScalarComponents();
+  if (numComp < 1)
+    {
+    vtkWarningMacro("No real components");
+    return 0;
+    }
+
+  // The region transformed spans the whole extent along the transformed
+  // axes.  It is the output itself, unless only part of it is requested.
+  int *wExt = inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
+  int ext[6];
+  int idx;
+  memcpy(ext, outExt, 6*sizeof(int));
+  for (idx = 0; idx < this->Dimensionality; idx++)
+    {
+    ext[2*idx] = wExt[2*idx];
+    ext[2*idx + 1] = wExt[2*idx + 1];
+    }
+
+  vtkImageFourierFilterPass pass;
+  for (idx = 0; idx < 3; idx++)
+    {
+    pass.Dimensions[idx] = ext[2*idx + 1] - ext[2*idx] + 1;
+    }
+  vtkIdType regionSize = static_cast<vtkIdType>(pass.Dimensions[0])*
+    pass.Dimensions[1]*pass.Dimensions[2];
+
+  vtkDoubleArray *regionArray = 0;
+  int inPlace = 1;
+  for (idx = 0; idx < 6; idx++)
+    {
+    inPlace = (inPlace && ext[idx] == outExt[idx]);
+    }
+  if (inPlace)
+    {
+    pass.Region = static_cast<double *>(outData->GetScalarPointer());
+    }
+  else
+    {
+    regionArray = vtkDoubleArray::New();
+    regionArray->SetNumberOfComponents(2);
+    regionArray->SetNumberOfTuples(regionSize);
+    pass.Region = regionArray->GetPointer(0);
+    }
+  pass.RegionIncrements[0] = 2;
+  pass.RegionIncrements[1] = 2*pass.Dimensions[0];
+  pass.RegionIncrements[2] = pass.RegionIncrements[1]*pass.Dimensions[1];
+
+  pass.Filter = this;
+  pass.Dimensionality = this->Dimensionality;
+  pass.InPtr = inData->GetScalarPointerForExtent(ext);
+  pass.InScalarType = inData->GetScalarType();
+  pass.InComponents = numComp;
+  inData->GetIncrements(pass.InIncrements);
+
+  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
+  this->Threader->SetUseThreadPool(this->UseThreadPool);
+  this->Threader->SetSingleMethod(vtkImageFourierFilterMultiAxisExecute,
+                                  &pass);
+
+  // One pass per axis, the first one from the input.
+  for (idx = 0; idx < this->Dimensionality && !this->AbortExecute; idx++)
+    {
+    vtkImageFourierFilterPlan plan(pass.Dimensions[idx], direction);
+    pass.Plan = &plan;
+    pass.Axis = idx;
+    pass.Scale = (direction < 0 ? 1.0/pass.Dimensions[idx] : 1.0);
+    this->Threader->SingleMethodExecute();
+    pass.InPtr = 0;
+    }
+
+  if (regionArray)
+    {
+    // copy the requested part of the region
+    double *outPtr = static_cast<double *>(outData->GetScalarPointer());
+    int rowSize = 2*(outExt[1] - outExt[0] + 1);
+    for (int idx2 = outExt[4]; idx2 <= outExt[5]; idx2++)
+      {
+      for (int idx1 = outExt[2]; idx1 <= outExt[3]; idx1++)
+        {
+        memcpy(outPtr, pass.Region + (outExt[0] - ext[0])*2 +
+               (idx1 - ext[2])*pass.RegionIncrements[1] +
+               (idx2 - ext[4])*pass.RegionIncrements[2],
+               rowSize*sizeof(double));
+        outPtr += rowSize;
+        }
+      }
+    regionArray->Delete();
+    }
+
+  return 1;
+}
@@ -18,6 +18,16 @@
 // this superclass is a container for methods that manipulate these structure
 // including fast Fourier transforms.  Complex numbers may become a class.
 // This should really be a helper class.
+//
+// With MultiAxisTransform on, the subclasses transform all the axes in
+// a single execution instead of one axis per iteration: the transforms
+// are done in place in the output, without an intermediate image per
+// axis, and every axis is split across the threads.  Lines are
+// transformed in blocks whose real and imaginary parts are stored apart,
+// with mixed-radix stages for lengths whose prime factors are at most 13
+// and Bluestein's algorithm for the other lengths, so that prime sizes
+// cost about as much as the next power of two.  Real inputs are
+// transformed two lines at a time along the first axis.
 #ifndef __vtkImageFourierFilter_h
 #define __vtkImageFourierFilter_h
 
@@ -87,7 +97,15 @@ class VTK_IMAGING_EXPORT vtkImageFourierFilter : public vtkImageDecomposeFilter
 {
 public:
   vtkTypeRevisionMacro(vtkImageFourierFilter,vtkImageDecomposeFilter);
-  
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Transform all the axes at once, in place in the output, instead of
+  // one axis per iteration.  The output is the same, to within rounding.
+  // Off by default.
+  vtkSetMacro(MultiAxisTransform, int);
+  vtkGetMacro(MultiAxisTransform, int);
+  vtkBooleanMacro(MultiAxisTransform, int);
   
   // public for templated functions of this object
   //BTX
@@ -108,9 +126,18 @@ public:
   //ETX
   
 protected:
-  vtkImageFourierFilter() {};
+  vtkImageFourierFilter();
   ~vtkImageFourierFilter() {};
 
+  int MultiAxisTransform;
+
+  // Description:
+  // Compute the output of the multi-axis transform, forward
+  // (direction = 1) or reverse (direction = -1).
+  int RequestMultiAxisData(vtkInformationVector** inputVector,
+                           vtkInformationVector* outputVector,
+                           int direction);
+
   //BTX
   void ExecuteFftStep2(vtkImageComplex *p_in, vtkImageComplex *p_out, 
                        int N, int bsize, int fb);
@@ -31,6 +31,7 @@ vtkStandardNewMacro(vtkImageMedian3D);
 vtkImageMedian3D::vtkImageMedian3D()
 {
   this->NumberOfElements = 0;
+  this->UseHistogram = 0;
   this->SetKernelSize(1,1,1);
   this->HandleBoundaries = 1;
 }
@@ -46,6 +47,8 @@ void vtkImageMedian3D::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "NumberOfElements: " << this->NumberOfElements << endl;
+  os << indent << "UseHistogram: "
+     << (this->UseHistogram ? "On" : "Off") << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -366,6 +369,307 @@ void vtkImageMedian3DExecute(vtkImageMedian3D *self,
   delete [] Sort;
 }
 
+//-----------------------------------------------------------------------------
+// Add (sign = 1) or remove (sign = -1) the samples of input row y, over
+// slices z0 to z1, to the histograms of the columns.  Each column holds
+// 'stride' counts: the fine bins, then the coarse bins.
+template <class T>
+void vtkImageMedian3DUpdateColumns(unsigned short *columns, int stride,
+                                   int numFine, int shift, int numCols,
+                                   const T *inPtr, vtkIdType inInc0,
+                                   int sign, T minValue)
+{
+  for (int col = 0; col < numCols; col++)
+    {
+    int bin = static_cast<int>(*inPtr) - static_cast<int>(minValue);
+    columns[bin] = static_cast<unsigned short>(columns[bin] + sign);
+    columns[numFine + (bin >> shift)] = static_cast<unsigned short>(
+      columns[numFine + (bin >> shift)] + sign);
+    columns += stride;
+    inPtr += inInc0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Add (sign = 1) or remove (sign = -1) the counts of n bins of a column
+// to the histogram of the neighborhood.
+static inline void vtkImageMedian3DAddBins(int *hist,
+                                           const unsigned short *column,
+                                           int n, int sign)
+{
+  if (sign > 0)
+    {
+    for (int i = 0; i < n; i++)
+      {
+      hist[i] += column[i];
+      }
+    }
+  else
+    {
+    for (int i = 0; i < n; i++)
+      {
+      hist[i] -= column[i];
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// The median with sliding histograms, for 8 and 16 bit integer data.
+// The input columns (samples with the same x) of each row of a tile of
+// the output keep a histogram of the samples of the rows and slices that
+// the neighborhood spans; going to the next row removes and adds one
+// input row per column.  Along the row, the histogram of the neighborhood
+// is the sum of those of the columns that it spans, so going to the next
+// voxel adds one column and removes another.  Only the coarse bins of the
+// neighborhood are kept up to date that way: they give the segment of
+// fine bins that holds the median, and that segment alone is brought up
+// to date from the columns.
+template <class T>
+void vtkImageMedian3DHistogramExecute(vtkImageMedian3D *self,
+                                      vtkImageData *inData, T *inPtr,
+                                      vtkImageData *outData, T *outPtr,
+                                      int outExt[6], int id,
+                                      vtkDataArray *inArray)
+{
+  int *kernelMiddle = self->GetKernelMiddle();
+  int *kernelSize = self->GetKernelSize();
+  int *inExt = inData->GetExtent();
+  int numComp = inArray->GetNumberOfComponents();
+  vtkIdType inInc0, inInc1, inInc2;
+  vtkIdType outInc0, outInc1, outInc2;
+  inData->GetIncrements(inInc0, inInc1, inInc2);
+  outData->GetIncrements(outInc0, outInc1, outInc2);
+  int idx0, idx1, idx2, idxC, i;
+
+  // The input that the neighborhoods of the output extent span.
+  int hoodExt[6];
+  for (i = 0; i < 3; i++)
+    {
+    hoodExt[2*i] = outExt[2*i] - kernelMiddle[i];
+    hoodExt[2*i] = (hoodExt[2*i] > inExt[2*i]) ? hoodExt[2*i] : inExt[2*i];
+    hoodExt[2*i+1] = outExt[2*i+1] - kernelMiddle[i] + kernelSize[i] - 1;
+    hoodExt[2*i+1] = (hoodExt[2*i+1] < inExt[2*i+1]) ?
+      hoodExt[2*i+1] : inExt[2*i+1];
+    }
+
+  // The fine bins span the range of the values there.
+  T minValue = *inPtr;
+  T maxValue = *inPtr;
+  for (idx2 = hoodExt[4]; idx2 <= hoodExt[5]; idx2++)
+    {
+    for (idx1 = hoodExt[2]; idx1 <= hoodExt[3]; idx1++)
+      {
+      T *ptr = inPtr + (hoodExt[0] - inExt[0])*inInc0 +
+        (idx1 - inExt[2])*inInc1 + (idx2 - inExt[4])*inInc2;
+      T *endPtr = ptr + (hoodExt[1] - hoodExt[0] + 1)*inInc0;
+      for (; ptr != endPtr; ptr++)
+        {
+        minValue = (*ptr < minValue) ? *ptr : minValue;
+        maxValue = (*ptr > maxValue) ? *ptr : maxValue;
+        }
+      }
+    }
+  int numValues = static_cast<int>(maxValue) - static_cast<int>(minValue) + 1;
+
+  // A segment of 2^shift fine bins for each coarse bin, at least as many
+  // segments as bins in a segment.
+  int shift = 2;
+  while ((1 << (2*shift)) < numValues)
+    {
+    shift++;
+    }
+  int segment = (1 << shift);
+  int numCoarse = ((numValues - 1) >> shift) + 1;
+  int numFine = (numCoarse << shift);
+  int stride = numFine + numCoarse;
+
+  // The tiles are as wide as the histograms of their columns allow.
+  int maxCols = (1 << 22)/stride;
+  int tileSize = maxCols - kernelSize[0] + 1;
+  tileSize = (tileSize > 16) ? tileSize : 16;
+  maxCols = tileSize + kernelSize[0] - 1;
+  maxCols = (maxCols < hoodExt[1] - hoodExt[0] + 1) ?
+    maxCols : hoodExt[1] - hoodExt[0] + 1;
+  int numTiles = (outExt[1] - outExt[0])/tileSize + 1;
+
+  unsigned short *columns = new unsigned short[maxCols*stride];
+  int *hist = new int[stride];
+  int *coarse = hist + numFine;
+  // the columns that each segment of fine bins of 'hist' sums
+  int *segmentCols = new int[2*numCoarse];
+
+  unsigned long count = 0;
+  unsigned long target = static_cast<unsigned long>(
+    numComp*numTiles*(outExt[5] - outExt[4] + 1)*
+    (outExt[3] - outExt[2] + 1)/50.0);
+  target++;
+
+  for (idxC = 0; idxC < numComp; idxC++)
+    {
+    for (idx2 = outExt[4]; idx2 <= outExt[5]; idx2++)
+      {
+      int hoodMin2 = idx2 - kernelMiddle[2];
+      hoodMin2 = (hoodMin2 > inExt[4]) ? hoodMin2 : inExt[4];
+      int hoodMax2 = idx2 - kernelMiddle[2] + kernelSize[2] - 1;
+      hoodMax2 = (hoodMax2 < inExt[5]) ? hoodMax2 : inExt[5];
+
+      for (int tileMin = outExt[0]; tileMin <= outExt[1];
+           tileMin += tileSize)
+        {
+        int tileMax = tileMin + tileSize - 1;
+        tileMax = (tileMax < outExt[1]) ? tileMax : outExt[1];
+
+        // the input columns of the tile
+        int colMin = tileMin - kernelMiddle[0];
+        colMin = (colMin > inExt[0]) ? colMin : inExt[0];
+        int colMax = tileMax - kernelMiddle[0] + kernelSize[0] - 1;
+        colMax = (colMax < inExt[1]) ? colMax : inExt[1];
+        int numCols = colMax - colMin + 1;
+        T *colPtr = inPtr + (colMin - inExt[0])*inInc0 + idxC;
+
+        memset(columns, 0, numCols*stride*sizeof(unsigned short));
+        // the input rows in the columns
+        int rowMin = inExt[2];
+        int rowMax = inExt[2] - 1;
+
+        for (idx1 = outExt[2]; !self->AbortExecute && idx1 <= outExt[3];
+             idx1++)
+          {
+          if (!id)
+            {
+            if (!(count%target))
+              {
+              self->UpdateProgress(count/(50.0*target));
+              }
+            count++;
+            }
+
+          int hoodMin1 = idx1 - kernelMiddle[1];
+          hoodMin1 = (hoodMin1 > inExt[2]) ? hoodMin1 : inExt[2];
+          int hoodMax1 = idx1 - kernelMiddle[1] + kernelSize[1] - 1;
+          hoodMax1 = (hoodMax1 < inExt[3]) ? hoodMax1 : inExt[3];
+
+          // slide the columns to the rows of this neighborhood
+          for (int row = rowMin; row <= rowMax && row < hoodMin1; row++)
+            {
+            for (int slice = hoodMin2; slice <= hoodMax2; slice++)
+              {
+              vtkImageMedian3DUpdateColumns(
+                columns, stride, numFine, shift, numCols,
+                colPtr + (row - inExt[2])*inInc1 +
+                (slice - inExt[4])*inInc2, inInc0, -1, minValue);
+              }
+            }
+          int row = (rowMax + 1 > hoodMin1) ? rowMax + 1 : hoodMin1;
+          for (; row <= hoodMax1; row++)
+            {
+            for (int slice = hoodMin2; slice <= hoodMax2; slice++)
+              {
+              vtkImageMedian3DUpdateColumns(
+                columns, stride, numFine, shift, numCols,
+                colPtr + (row - inExt[2])*inInc1 +
+                (slice - inExt[4])*inInc2, inInc0, 1, minValue);
+              }
+            }
+          rowMin = hoodMin1;
+          rowMax = hoodMax1;
+          int rowSamples = (hoodMax1 - hoodMin1 + 1)*(hoodMax2 - hoodMin2 + 1);
+
+          // start the row with an empty neighborhood
+          memset(coarse, 0, numCoarse*sizeof(int));
+          for (i = 0; i < numCoarse; i++)
+            {
+            // mark the segment as stale
+            segmentCols[2*i] = 1;
+            segmentCols[2*i+1] = 0;
+            }
+          int hoodMin0 = 0;
+          int hoodMax0 = -1;
+
+          T *outPtr0 = outPtr + (tileMin - outExt[0])*outInc0 +
+            (idx1 - outExt[2])*outInc1 + (idx2 - outExt[4])*outInc2 + idxC;
+          for (idx0 = tileMin; idx0 <= tileMax; idx0++)
+            {
+            // the columns of this neighborhood, relative to colMin
+            int newMin0 = idx0 - kernelMiddle[0];
+            newMin0 = (newMin0 > inExt[0]) ? newMin0 : inExt[0];
+            newMin0 -= colMin;
+            int newMax0 = idx0 - kernelMiddle[0] + kernelSize[0] - 1;
+            newMax0 = (newMax0 < inExt[1]) ? newMax0 : inExt[1];
+            newMax0 -= colMin;
+
+            // slide the coarse bins of the neighborhood
+            int col;
+            for (col = hoodMin0; col <= hoodMax0 && col < newMin0; col++)
+              {
+              vtkImageMedian3DAddBins(coarse, columns + col*stride + numFine,
+                                      numCoarse, -1);
+              }
+            col = (hoodMax0 + 1 > newMin0) ? hoodMax0 + 1 : newMin0;
+            for (; col <= newMax0; col++)
+              {
+              vtkImageMedian3DAddBins(coarse, columns + col*stride + numFine,
+                                      numCoarse, 1);
+              }
+            hoodMin0 = newMin0;
+            hoodMax0 = newMax0;
+
+            // the rank of the median, the lower middle one if the
+            // number of samples is even
+            int rank = ((hoodMax0 - hoodMin0 + 1)*rowSamples - 1)/2;
+
+            // find the segment of the median
+            int sum = 0;
+            int s = 0;
+            while (sum + coarse[s] <= rank)
+              {
+              sum += coarse[s];
+              s++;
+              }
+
+            // bring the fine bins of that segment up to date
+            int *fine = hist + (s << shift);
+            unsigned short *colFine = columns + (s << shift);
+            int *cols = segmentCols + 2*s;
+            if (cols[0] > cols[1] || cols[1] < hoodMin0)
+              {
+              memset(fine, 0, segment*sizeof(int));
+              cols[0] = hoodMin0;
+              cols[1] = hoodMin0 - 1;
+              }
+            for (col = cols[0]; col < hoodMin0; col++)
+              {
+              vtkImageMedian3DAddBins(fine, colFine + col*stride, segment, -1);
+              }
+            for (col = cols[1] + 1; col <= hoodMax0; col++)
+              {
+              vtkImageMedian3DAddBins(fine, colFine + col*stride, segment, 1);
+              }
+            cols[0] = hoodMin0;
+            cols[1] = hoodMax0;
+
+            // find the median within the segment
+            int bin = 0;
+            while (sum + fine[bin] <= rank)
+              {
+              sum += fine[bin];
+              bin++;
+              }
+
+            *outPtr0 = static_cast<T>(static_cast<int>(minValue) +
+                                      (s << shift) + bin);
+            outPtr0 += outInc0;
+            }
+          }
+        }
+      }
+    }
+
+  delete [] segmentCols;
+  delete [] hist;
+  delete [] columns;
+}
+
 //-----------------------------------------------------------------------------
 // This method contains the first switch statement that calls the correct
 // templated function for the input and output region types.
@@ -397,6 +701,50 @@ void vtkImageMedian3D::ThreadedRequestData(
     return;
     }
   
+  // The columns count up to kernelSize[1]*kernelSize[2] samples.
+  if (this->UseHistogram &&
+      this->KernelSize[1]*this->KernelSize[2] <= VTK_UNSIGNED_SHORT_MAX)
+    {
+    switch (inArray->GetDataType())
+      {
+      case VTK_CHAR:
+        vtkImageMedian3DHistogramExecute(this, inData[0][0],
+                                         static_cast<char *>(inPtr),
+                                         outData[0],
+                                         static_cast<char *>(outPtr),
+                                         outExt, id, inArray);
+        return;
+      case VTK_SIGNED_CHAR:
+        vtkImageMedian3DHistogramExecute(this, inData[0][0],
+                                         static_cast<signed char *>(inPtr),
+                                         outData[0],
+                                         static_cast<signed char *>(outPtr),
+                                         outExt, id, inArray);
+        return;
+      case VTK_UNSIGNED_CHAR:
+        vtkImageMedian3DHistogramExecute(this, inData[0][0],
+                                         static_cast<unsigned char *>(inPtr),
+                                         outData[0],
+                                         static_cast<unsigned char *>(outPtr),
+                                         outExt, id, inArray);
+        return;
+      case VTK_SHORT:
+        vtkImageMedian3DHistogramExecute(this, inData[0][0],
+                                         static_cast<short *>(inPtr),
+                                         outData[0],
+                                         static_cast<short *>(outPtr),
+                                         outExt, id, inArray);
+        return;
+      case VTK_UNSIGNED_SHORT:
+        vtkImageMedian3DHistogramExecute(this, inData[0][0],
+                                         static_cast<unsigned short *>(inPtr),
+                                         outData[0],
+                                         static_cast<unsigned short *>(outPtr),
+                                         outExt, id, inArray);
+        return;
+      }
+    }
+
   switch (inArray->GetDataType())
     {
     vtkTemplateMacro(
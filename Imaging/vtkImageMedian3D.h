@@ -19,6 +19,19 @@
 // Neighborhoods can be no more than 3 dimensional.  Setting one
 // axis of the neighborhood kernelSize to 1 changes the filter
 // into a 2D median.  
+//
+// For char, unsigned char, short and unsigned short data, UseHistogram
+// replaces the sort of every neighborhood by sliding histograms of the
+// values (Perreault and Hebert's median filter extended to 3D). The
+// histograms of the columns of the neighborhood are updated once per
+// row, and the median is found from a coarse and a fine level of bins,
+// so that the cost of each output voxel grows only with the size of the
+// kernel along z instead of with its volume: with a 2D kernel in the xy
+// plane it does not depend on the kernel size at all. The number of bins
+// follows the range of the values in the input, and rows are processed
+// in tiles along x to keep the histograms of a thread to a few megabytes.
+// When a neighborhood holds an even number of voxels, as it can at the
+// boundaries, the lower of the two middle values is the median.
 
 
 #ifndef __vtkImageMedian3D_h
@@ -43,11 +56,20 @@ public:
   // Return the number of elements in the median mask
   vtkGetMacro(NumberOfElements,int);
 
+  // Description:
+  // Compute the medians with sliding histograms instead of sorting each
+  // neighborhood, for char, unsigned char, short and unsigned short
+  // data. Other types are always sorted. Off by default.
+  vtkSetMacro(UseHistogram,int);
+  vtkGetMacro(UseHistogram,int);
+  vtkBooleanMacro(UseHistogram,int);
+
 protected:
   vtkImageMedian3D();
   ~vtkImageMedian3D();
 
   int NumberOfElements;
+  int UseHistogram;
 
   void ThreadedRequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkImageReslice.h"
 
+#include "vtkAbstractImageInterpolator.h"
 #include "vtkImageData.h"
 #include "vtkImageStencilData.h"
 #include "vtkInformation.h"
@@ -36,11 +37,20 @@
 #include <float.h>
 #include <math.h>
 
+// SSE2 is part of every x86-64 processor; the 32-bit x86 builds are left
+// out because their vtkResliceFloor() rounds the fraction to 16 bits
+#if defined(__x86_64__) || defined(_M_X64)
+# define VTK_RESLICE_USE_SSE2
+# include <emmintrin.h>
+#endif
+
 vtkCxxRevisionMacro(vtkImageReslice, "$Revision$");
 vtkStandardNewMacro(vtkImageReslice);
 vtkCxxSetObjectMacro(vtkImageReslice, InformationInput, vtkImageData);
 vtkCxxSetObjectMacro(vtkImageReslice,ResliceAxes,vtkMatrix4x4);
 vtkCxxSetObjectMacro(vtkImageReslice,ResliceTransform,vtkAbstractTransform);
+vtkCxxSetObjectMacro(vtkImageReslice,Interpolator,
+                     vtkAbstractImageInterpolator);
 
 //--------------------------------------------------------------------------
 // The 'floor' function on x86 and mips is many times slower than these
@@ -119,6 +129,7 @@ vtkImageReslice::vtkImageReslice()
   this->Mirror = 0; // don't mirror
   this->Border = 1; // apply a border
   this->InterpolationMode = VTK_RESLICE_NEAREST; // no interpolation
+  this->Interpolator = NULL;
   this->Optimization = 1; // turn off when you're paranoid 
 
   // default black background
@@ -151,6 +162,12 @@ vtkImageReslice::vtkImageReslice()
   this->IndexMatrix = NULL;
   this->OptimizedTransform = NULL;
 
+  // only set when the interpolator needs them
+  this->InterpolatorCoefficients = NULL;
+  this->InterpolatorCoefficientsInputMTime = 0;
+  this->InterpolatorCoefficientsMTime = 0;
+  this->InterpolatorCoefficientsWrap = 0;
+
   // set to zero when we completely missed the input extent
   this->HitInputExtent = 1;
 
@@ -163,6 +180,7 @@ vtkImageReslice::~vtkImageReslice()
 {
   this->SetResliceTransform(NULL);
   this->SetResliceAxes(NULL);
+  this->SetInterpolator(NULL);
   if (this->IndexMatrix)
     {
     this->IndexMatrix->Delete();
@@ -171,6 +189,10 @@ vtkImageReslice::~vtkImageReslice()
     {
     this->OptimizedTransform->Delete();
     }
+  if (this->InterpolatorCoefficients)
+    {
+    this->InterpolatorCoefficients->Delete();
+    }
   this->SetInformationInput(NULL);
 }
 
@@ -227,6 +249,7 @@ void vtkImageReslice::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Border: " << (this->Border ? "On\n":"Off\n");
   os << indent << "InterpolationMode: " 
      << this->GetInterpolationModeAsString() << "\n";
+  os << indent << "Interpolator: " << this->Interpolator << "\n";
   os << indent << "Optimization: " << (this->Optimization ? "On\n":"Off\n");
   os << indent << "BackgroundColor: " <<
     this->BackgroundColor[0] << " " << this->BackgroundColor[1] << " " <<
@@ -342,8 +365,8 @@ void vtkImageReslice::GetResliceAxesOrigin(double origin[3])
 }
 
 //----------------------------------------------------------------------------
-// Account for the MTime of the transform and its matrix when determining
-// the MTime of the filter
+// Account for the MTime of the transform and its matrix, and of the
+// interpolator, when determining the MTime of the filter
 unsigned long int vtkImageReslice::GetMTime()
 {
   unsigned long mTime=this->vtkObject::GetMTime();
@@ -365,6 +388,11 @@ unsigned long int vtkImageReslice::GetMTime()
     time = this->ResliceAxes->GetMTime();
     mTime = ( time > mTime ? time : mTime );
     }
+  if ( this->Interpolator != NULL )
+    {
+    time = this->Interpolator->GetMTime();
+    mTime = ( time > mTime ? time : mTime );
+    }
 
   return mTime;
 }
@@ -499,9 +527,14 @@ int vtkImageReslice::RequestUpdateExtent(
       }
 
     // set the extent appropriately according to the interpolation mode 
-    if (this->GetInterpolationMode() != VTK_RESLICE_NEAREST)
+    if (this->Interpolator ||
+        this->GetInterpolationMode() != VTK_RESLICE_NEAREST)
       {
       int extra = (this->GetInterpolationMode() == VTK_RESLICE_CUBIC); 
+      if (this->Interpolator)
+        { // the number of samples the kernel spans past the nearest two
+        extra = this->Interpolator->GetKernelSize()/2 - 1;
+        }
       for (j = 0; j < 3; j++) 
         {
         k = vtkResliceFloor(point[j], f);
@@ -588,6 +621,16 @@ int vtkImageReslice::RequestUpdateExtent(
       }
     }
 
+  // the coefficients of the interpolator depend on the whole input
+  if (this->Interpolator && this->Interpolator->GetRequiresCoefficients() &&
+      this->HitInputExtent)
+    {
+    for (i = 0; i < 6; i++)
+      {
+      inExt[i] = wholeExtent[i];
+      }
+    }
+
   inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt, 6);
 
   // need to set the stencil update extent to the output extent
@@ -1616,194 +1659,897 @@ int vtkTricubicInterpolation(T *&outPtr, const T *inPtr,
   return 1;
 }                   
 
-//--------------------------------------------------------------------------
-// get appropriate interpolation function according to interpolation mode
-// and scalar type
-template<class F>
-void vtkGetResliceInterpFunc(vtkImageReslice *self,
-                             int (**interpolate)(void *&outPtr,
-                                                 const void *inPtr,
-                                                 const int inExt[6],
-                                                 const vtkIdType inInc[3],
-                                                 int numscalars,
-                                                 const F point[3],
-                                                 int mode,
-                                                 const void *background))
+//----------------------------------------------------------------------------
+// The kernel of a vtkAbstractImageInterpolator: its size, its table of
+// weights, and the data it applies to, which are either the input scalars
+// or the coefficients that the interpolator computed from them.
+struct vtkResliceKernel
 {
-  int dataType = self->GetOutput()->GetScalarType();
-  int interpolationMode = self->GetInterpolationMode();
-  
-  switch (interpolationMode)
+  int Size;
+  const double *Table;
+  int TableResolution;
+  const void *Data;
+  int DataIsDouble;
+};
+
+// the interpolation mode that vtkReslicePermuteExecute uses for a kernel
+#define VTK_RESLICE_KERNEL -1
+
+//----------------------------------------------------------------------------
+// Get the weights of the kernel for the offset 'f' by linear interpolation
+// between the two nearest rows of its table.
+template <class F>
+inline void vtkResliceKernelWeights(const vtkResliceKernel *kernel, F f,
+                                    F *weights)
+{
+  F x = f*kernel->TableResolution;
+  int i = static_cast<int>(x);
+  F r = x - i;
+  if (i >= kernel->TableResolution)
+    { // f rounded up to 1
+    i = kernel->TableResolution - 1;
+    r = 1;
+    }
+  int size = kernel->Size;
+  const double *row0 = kernel->Table + i*size;
+  const double *row1 = row0 + size;
+  for (int l = 0; l < size; l++)
     {
-    case VTK_RESLICE_NEAREST:
-      switch (dataType)
-        {
-        vtkTemplateAliasMacro(*((int (**)(VTK_TT *&outPtr, const VTK_TT *inPtr,
-                                     const int inExt[6],
-                                     const vtkIdType inInc[3],
-                                     int numscalars, const F point[3],
-                                     int mode,
-                                     const VTK_TT *background))interpolate) = \
-                         &vtkNearestNeighborInterpolation);
-        default:
-          interpolate = 0;
-        }
-      break;
-    case VTK_RESLICE_LINEAR:
-    case VTK_RESLICE_RESERVED_2:
-      switch (dataType)
-        {
-        vtkTemplateAliasMacro(*((int (**)(VTK_TT *&outPtr, const VTK_TT *inPtr,
-                                     const int inExt[6],
-                                     const vtkIdType inInc[3],
-                                     int numscalars, const F point[3],
-                                     int mode,
-                                     const VTK_TT *background))interpolate) = \
-                         &vtkTrilinearInterpolation);
-        default:
-          interpolate = 0;
-        }
-      break;
-    case VTK_RESLICE_CUBIC:
-      switch (dataType)
-        {
-        vtkTemplateAliasMacro(*((int (**)(VTK_TT *&outPtr, const VTK_TT *inPtr,
-                                     const int inExt[6],
-                                     const vtkIdType inInc[3],
-                                     int numscalars, const F point[3],
-                                     int mode,
-                                     const VTK_TT *background))interpolate) = \
-                         &vtkTricubicInterpolation);
-        default:
-          interpolate = 0;
-        }
-      break;
-    default:
-      interpolate = 0;
+    weights[l] = static_cast<F>((1 - r)*row0[l] + r*row1[l]);
     }
 }
 
-
-//----------------------------------------------------------------------------
-// Some helper functions for 'RequestData'
 //----------------------------------------------------------------------------
-
-//--------------------------------------------------------------------------
-// pixel copy function, templated for different scalar types
-template <class T>
-struct vtkImageResliceSetPixels
+// Limit the index of a sample that the kernel spans to the input extent
+// according to the border mode.
+inline int vtkResliceKernelIndex(int inId, int inExtX, int mode)
 {
-static void Set(void *&outPtrV, const void *inPtrV, int numscalars, int n)
+  if (mode == VTK_RESLICE_WRAP)
+    {
+    return vtkInterpolateWrap(inId, inExtX);
+    }
+  if (mode == VTK_RESLICE_MIRROR)
+    {
+    return vtkInterpolateMirror(inId, inExtX);
+    }
+  // clamp to the edge
+  return (inId < 0 ? 0 : (inId >= inExtX ? inExtX - 1 : inId));
+}
+
+//----------------------------------------------------------------------------
+// Interpolate with the kernel of an interpolator the data 'inPtr', which
+// has the extent and the increments of the input, at the 'point'.
+// A point is inside the input under the same conditions as for trilinear
+// interpolation; the samples that the kernel spans past the edges are
+// those at the edges, or wrapped or mirrored ones.
+template <class F, class C, class T>
+int vtkKernelInterpolationT(T *&outPtr, const C *inPtr,
+                            const int inExt[6], const vtkIdType inInc[3],
+                            int numscalars, const F point[3],
+                            int mode, const T *background,
+                            const vtkResliceKernel *kernel)
 {
-  const T* inPtr = static_cast<const T*>(inPtrV);
-  T* outPtr = static_cast<T*>(outPtrV);
-  for (int i = 0; i < n; i++)
+  vtkIdType factors[3][VTK_INTERPOLATOR_MAX_KERNEL_SIZE];
+  F weights[3][VTK_INTERPOLATOR_MAX_KERNEL_SIZE];
+  int size = kernel->Size;
+  int offset = size/2 - 1;
+  int outside = 0;
+
+  for (int j = 0; j < 3; j++)
     {
-    const T *tmpPtr = inPtr;
-    int m = numscalars;
+    F f;
+    int inId0 = vtkResliceFloor(point[j], f) - inExt[2*j];
+    int inExtJ = inExt[2*j+1] - inExt[2*j] + 1;
+    if (mode != VTK_RESLICE_WRAP && mode != VTK_RESLICE_MIRROR &&
+        (inId0 < 0 || inId0 + (f != 0) >= inExtJ))
+      {
+      outside |= (mode != VTK_RESLICE_BORDER ||
+                  vtkInterpolateBorderCheck(inId0, inId0 + 1, inExtJ, f));
+      }
+    vtkResliceKernelWeights(kernel, f, weights[j]);
+    for (int l = 0; l < size; l++)
+      {
+      factors[j][l] =
+        vtkResliceKernelIndex(inId0 - offset + l, inExtJ, mode)*inInc[j];
+      }
+    }
+
+  if (outside)
+    {
+    if (mode == VTK_RESLICE_NULL)
+      {
+      return 0;
+      }
     do
       {
-      *outPtr++ = *tmpPtr++;
+      *outPtr++ = *background++;
       }
-    while (--m);
+    while (--numscalars);
+    return 0;
     }
-  outPtrV = outPtr;
+
+  do // loop over components
+    {
+    F val = 0;
+    for (int k = 0; k < size; k++)
+      {
+      F fz = weights[2][k];
+      if (fz != 0)
+        {
+        for (int j = 0; j < size; j++)
+          {
+          F fzy = fz*weights[1][j];
+          if (fzy != 0)
+            {
+            const C *tmpPtr = inPtr + factors[2][k] + factors[1][j];
+            F sum = 0;
+            for (int i = 0; i < size; i++)
+              {
+              sum += weights[0][i]*tmpPtr[factors[0][i]];
+              }
+            val += fzy*sum;
+            }
+          }
+        }
+      }
+
+    vtkResliceClamp(val, *outPtr++);
+    inPtr++;
+    }
+  while (--numscalars);
+
+  return 1;
 }
 
-// optimized for 1 scalar components
-static void Set1(void *&outPtrV, const void *inPtrV,
-                          int vtkNotUsed(numscalars), int n)
+// The interpolation function for a kernel gets the vtkResliceKernel in
+// place of the input scalars.
+template <class F, class T>
+int vtkKernelInterpolation(void *&outPtrV, const void *kernelV,
+                           const int inExt[6], const vtkIdType inInc[3],
+                           int numscalars, const F point[3],
+                           int mode, const void *backgroundV)
 {
-  const T* inPtr = static_cast<const T*>(inPtrV);
-  T* outPtr = static_cast<T*>(outPtrV);
-  T val = *inPtr;
-  for (int i = 0; i < n; i++)
+  const vtkResliceKernel *kernel =
+    static_cast<const vtkResliceKernel *>(kernelV);
+  const T *background = static_cast<const T *>(backgroundV);
+  T *outPtr = static_cast<T *>(outPtrV);
+  int rval;
+  if (kernel->DataIsDouble)
     {
-    *outPtr++ = val;
+    rval = vtkKernelInterpolationT(outPtr,
+                                   static_cast<const double *>(kernel->Data),
+                                   inExt, inInc, numscalars, point, mode,
+                                   background, kernel);
+    }
+  else
+    {
+    rval = vtkKernelInterpolationT(outPtr,
+                                   static_cast<const T *>(kernel->Data),
+                                   inExt, inInc, numscalars, point, mode,
+                                   background, kernel);
     }
   outPtrV = outPtr;
+  return rval;
 }
-};
 
-// get a pixel copy function that is appropriate for the data type
-void vtkGetSetPixelsFunc(vtkImageReslice *self,
-                         void (**setpixels)(void *&out, const void *in,
-                                            int numscalars, int n))
+//--------------------------------------------------------------------------
+// Row versions of the interpolation functions: they interpolate a run of
+// output voxels idXmin to idXmax whose sample points inPoint1 + idX*xAxis
+// are known to need no voxel outside of the input extent (see
+// vtkResliceInteriorSpan), so the bounds checks and the call per voxel
+// are gone. The results are the same as those of the per-voxel functions.
+
+// The SSE2 versions do two voxels of a row at a time: the sample points,
+// their floor and the weights are computed in one register, and the sums
+// of the weighted voxels too. The voxels themselves are not contiguous,
+// and are loaded one by one. They return the first voxel that is left
+// for the scalar loop, which is all of them when the points are floats.
+template <class F, class T>
+inline int vtkTrilinearInterpolationRowSSE2(T *&, const T *, const int [6],
+                                            const vtkIdType [3], int,
+                                            const F [4], const F [4],
+                                            int idXmin, int)
 {
-  int dataType = self->GetOutput()->GetScalarType();
-  int numscalars = self->GetOutput()->GetNumberOfScalarComponents();
+  return idXmin;
+}
 
-  switch (numscalars)
+template <class F, class T>
+inline int vtkNearestNeighborInterpolationRowSSE2(T *&, const T *,
+                                                  const int [6],
+                                                  const vtkIdType [3], int,
+                                                  const F [4], const F [4],
+                                                  int idXmin, int)
+{
+  return idXmin;
+}
+
+#ifdef VTK_RESLICE_USE_SSE2
+// the same as vtkResliceFloor() for the two points in x, which must be
+// within the range of an int
+inline __m128i vtkResliceFloorSSE2(__m128d x, __m128d &f)
+{
+  __m128d y = _mm_cvtepi32_pd(_mm_cvttpd_epi32(x));
+  // truncation went up for the negative numbers
+  y = _mm_sub_pd(y, _mm_and_pd(_mm_cmpgt_pd(y, x), _mm_set1_pd(1.0)));
+  f = _mm_sub_pd(x, y);
+  return _mm_cvttpd_epi32(y);
+}
+
+template <class T>
+int vtkTrilinearInterpolationRowSSE2(T *&outPtr, const T *inPtr,
+                                     const int inExt[6],
+                                     const vtkIdType inInc[3],
+                                     int numscalars,
+                                     const double inPoint1[4],
+                                     const double xAxis[4],
+                                     int idXmin, int idXmax)
+{
+  const __m128d one = _mm_set1_pd(1.0);
+  __m128d ids = _mm_set_pd(idXmin + 1, idXmin);
+
+  int idX = idXmin;
+  for (; idX < idXmax; idX += 2)
     {
-    case 1:
-      switch (dataType)
-        {
-        vtkTemplateAliasMacro(
-          *setpixels = &vtkImageResliceSetPixels<VTK_TT>::Set1
-          );
-        default:
-          setpixels = 0;
-        }
-    default:
-      switch (dataType)
+    __m128d fs[3], rs[3];
+    int inId0[3][4];
+    double f[3][2];
+    for (int k = 0; k < 3; k++)
+      {
+      __m128d x = _mm_add_pd(_mm_set1_pd(inPoint1[k]),
+                             _mm_mul_pd(ids, _mm_set1_pd(xAxis[k])));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(inId0[k]),
+                       vtkResliceFloorSSE2(x, fs[k]));
+      _mm_storeu_pd(f[k], fs[k]);
+      rs[k] = _mm_sub_pd(one, fs[k]);
+      }
+    ids = _mm_add_pd(ids, _mm_set1_pd(2.0));
+
+    __m128d ryrz = _mm_mul_pd(rs[1], rs[2]);
+    __m128d fyrz = _mm_mul_pd(fs[1], rs[2]);
+    __m128d ryfz = _mm_mul_pd(rs[1], fs[2]);
+    __m128d fyfz = _mm_mul_pd(fs[1], fs[2]);
+
+    const T *inPtr0[2];
+    const T *inPtr1[2];
+    vtkIdType i00[2], i01[2], i10[2], i11[2];
+    for (int l = 0; l < 2; l++)
+      {
+      int inIdX0 = inId0[0][l] - inExt[0];
+      int inIdY0 = inId0[1][l] - inExt[2];
+      int inIdZ0 = inId0[2][l] - inExt[4];
+
+      vtkIdType factY0 = inIdY0*inInc[1];
+      vtkIdType factY1 = (inIdY0 + (f[1][l] != 0))*inInc[1];
+      vtkIdType factZ0 = inIdZ0*inInc[2];
+      vtkIdType factZ1 = (inIdZ0 + (f[2][l] != 0))*inInc[2];
+
+      i00[l] = factY0 + factZ0;
+      i01[l] = factY0 + factZ1;
+      i10[l] = factY1 + factZ0;
+      i11[l] = factY1 + factZ1;
+
+      inPtr0[l] = inPtr + inIdX0*inInc[0];
+      inPtr1[l] = inPtr + (inIdX0 + (f[0][l] != 0))*inInc[0];
+      }
+
+    for (int c = 0; c < numscalars; c++)
+      {
+      __m128d v0 = _mm_mul_pd(ryrz, _mm_set_pd(inPtr0[1][i00[1]],
+                                               inPtr0[0][i00[0]]));
+      __m128d v1 = _mm_mul_pd(ryrz, _mm_set_pd(inPtr1[1][i00[1]],
+                                               inPtr1[0][i00[0]]));
+      v0 = _mm_add_pd(v0, _mm_mul_pd(ryfz, _mm_set_pd(inPtr0[1][i01[1]],
+                                                      inPtr0[0][i01[0]])));
+      v1 = _mm_add_pd(v1, _mm_mul_pd(ryfz, _mm_set_pd(inPtr1[1][i01[1]],
+                                                      inPtr1[0][i01[0]])));
+      v0 = _mm_add_pd(v0, _mm_mul_pd(fyrz, _mm_set_pd(inPtr0[1][i10[1]],
+                                                      inPtr0[0][i10[0]])));
+      v1 = _mm_add_pd(v1, _mm_mul_pd(fyrz, _mm_set_pd(inPtr1[1][i10[1]],
+                                                      inPtr1[0][i10[0]])));
+      v0 = _mm_add_pd(v0, _mm_mul_pd(fyfz, _mm_set_pd(inPtr0[1][i11[1]],
+                                                      inPtr0[0][i11[0]])));
+      v1 = _mm_add_pd(v1, _mm_mul_pd(fyfz, _mm_set_pd(inPtr1[1][i11[1]],
+                                                      inPtr1[0][i11[0]])));
+
+      double result[2];
+      _mm_storeu_pd(result, _mm_add_pd(_mm_mul_pd(rs[0], v0),
+                                       _mm_mul_pd(fs[0], v1)));
+      vtkResliceRound(result[0], outPtr[c]);
+      vtkResliceRound(result[1], outPtr[numscalars + c]);
+
+      for (int l = 0; l < 2; l++)
         {
-        vtkTemplateAliasMacro(
-          *setpixels = &vtkImageResliceSetPixels<VTK_TT>::Set
-          );
-        default:
-          setpixels = 0;
+        inPtr0[l]++;
+        inPtr1[l]++;
         }
+      }
+    outPtr += 2*numscalars;
     }
+
+  return idX;
 }
 
-//----------------------------------------------------------------------------
-// Convert background color from float to appropriate type
 template <class T>
-void vtkAllocBackgroundPixelT(vtkImageReslice *self,
-                              T **background_ptr, int numComponents)
+int vtkNearestNeighborInterpolationRowSSE2(T *&outPtr, const T *inPtr,
+                                           const int inExt[6],
+                                           const vtkIdType inInc[3],
+                                           int numscalars,
+                                           const double inPoint1[4],
+                                           const double xAxis[4],
+                                           int idXmin, int idXmax)
 {
-  *background_ptr = new T[numComponents];
-  T *background = *background_ptr;
+  const __m128d half = _mm_set1_pd(0.5);
+  __m128d ids = _mm_set_pd(idXmin + 1, idXmin);
 
-  for (int i = 0; i < numComponents; i++)
+  int idX = idXmin;
+  for (; idX < idXmax; idX += 2)
     {
-    if (i < 4)
+    // the same as vtkResliceRound(), the floor of x + 0.5
+    int inId[3][4];
+    for (int k = 0; k < 3; k++)
       {
-      vtkResliceClamp(self->GetBackgroundColor()[i], background[i]);
+      __m128d x = _mm_add_pd(_mm_set1_pd(inPoint1[k]),
+                             _mm_mul_pd(ids, _mm_set1_pd(xAxis[k])));
+      __m128d f;
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(inId[k]),
+                       vtkResliceFloorSSE2(_mm_add_pd(x, half), f));
       }
-    else
+    ids = _mm_add_pd(ids, _mm_set1_pd(2.0));
+
+    for (int l = 0; l < 2; l++)
       {
-      background[i] = 0;
+      const T *tmpPtr = inPtr + ((inId[0][l] - inExt[0])*inInc[0] +
+                                 (inId[1][l] - inExt[2])*inInc[1] +
+                                 (inId[2][l] - inExt[4])*inInc[2]);
+      int m = numscalars;
+      do
+        {
+        *outPtr++ = *tmpPtr++;
+        }
+      while (--m);
       }
     }
+
+  return idX;
 }
+#endif
 
-void vtkAllocBackgroundPixel(vtkImageReslice *self, void **rval, 
-                             int numComponents)
+template <class F, class T>
+void vtkNearestNeighborInterpolationRow(T *&outPtr, const T *inPtr,
+                                        const int inExt[6],
+                                        const vtkIdType inInc[3],
+                                        int numscalars, const F inPoint1[4],
+                                        const F xAxis[4],
+                                        int idXmin, int idXmax)
 {
-  switch (self->GetOutput()->GetScalarType())
+  int idX = vtkNearestNeighborInterpolationRowSSE2(outPtr, inPtr, inExt,
+                                                   inInc, numscalars,
+                                                   inPoint1, xAxis,
+                                                   idXmin, idXmax);
+  for (; idX <= idXmax; idX++)
     {
-    vtkTemplateAliasMacro(vtkAllocBackgroundPixelT(self, (VTK_TT **)rval,
-                                              numComponents));
+    int inIdX0 = vtkResliceRound(inPoint1[0] + idX*xAxis[0]) - inExt[0];
+    int inIdY0 = vtkResliceRound(inPoint1[1] + idX*xAxis[1]) - inExt[2];
+    int inIdZ0 = vtkResliceRound(inPoint1[2] + idX*xAxis[2]) - inExt[4];
+
+    const T *tmpPtr = inPtr + (inIdX0*inInc[0] + inIdY0*inInc[1] +
+                               inIdZ0*inInc[2]);
+    int m = numscalars;
+    do
+      {
+      *outPtr++ = *tmpPtr++;
+      }
+    while (--m);
     }
-}      
+}
 
-void vtkFreeBackgroundPixel(vtkImageReslice *self, void **rval)
+template <class F, class T>
+void vtkTrilinearInterpolationRow(T *&outPtr, const T *inPtr,
+                                  const int inExt[6],
+                                  const vtkIdType inInc[3],
+                                  int numscalars, const F inPoint1[4],
+                                  const F xAxis[4], int idXmin, int idXmax)
 {
-  switch (self->GetOutput()->GetScalarType())
+  int idX = vtkTrilinearInterpolationRowSSE2(outPtr, inPtr, inExt, inInc,
+                                             numscalars, inPoint1, xAxis,
+                                             idXmin, idXmax);
+  for (; idX <= idXmax; idX++)
     {
-    vtkTemplateAliasMacro(delete [] *((VTK_TT **)rval));
-    }
+    F fx, fy, fz;
+    int inIdX0 = vtkResliceFloor(inPoint1[0] + idX*xAxis[0], fx) - inExt[0];
+    int inIdY0 = vtkResliceFloor(inPoint1[1] + idX*xAxis[1], fy) - inExt[2];
+    int inIdZ0 = vtkResliceFloor(inPoint1[2] + idX*xAxis[2], fz) - inExt[4];
+
+    vtkIdType factX0 = inIdX0*inInc[0];
+    vtkIdType factX1 = (inIdX0 + (fx != 0))*inInc[0];
+    vtkIdType factY0 = inIdY0*inInc[1];
+    vtkIdType factY1 = (inIdY0 + (fy != 0))*inInc[1];
+    vtkIdType factZ0 = inIdZ0*inInc[2];
+    vtkIdType factZ1 = (inIdZ0 + (fz != 0))*inInc[2];
+
+    vtkIdType i00 = factY0 + factZ0;
+    vtkIdType i01 = factY0 + factZ1;
+    vtkIdType i10 = factY1 + factZ0;
+    vtkIdType i11 = factY1 + factZ1;
+
+    F rx = 1 - fx;
+    F ry = 1 - fy;
+    F rz = 1 - fz;
+
+    F ryrz = ry*rz;
+    F fyrz = fy*rz;
+    F ryfz = ry*fz;
+    F fyfz = fy*fz;
+
+    const T *inPtr0 = inPtr + factX0;
+    const T *inPtr1 = inPtr + factX1;
 
-  *rval = 0;
-}      
+    int m = numscalars;
+    do
+      {
+      F result = (rx*(ryrz*inPtr0[i00] + ryfz*inPtr0[i01] +
+                      fyrz*inPtr0[i10] + fyfz*inPtr0[i11]) +
+                  fx*(ryrz*inPtr1[i00] + ryfz*inPtr1[i01] +
+                      fyrz*inPtr1[i10] + fyfz*inPtr1[i11]));
 
-//----------------------------------------------------------------------------
-// helper function for clipping of the output with a stencil
-int vtkResliceGetNextExtent(vtkImageStencilData *stencil,
-                            int &r1, int &r2, int rmin, int rmax,
-                            int yIdx, int zIdx, 
-                            void *&outPtr, void *background, 
+      vtkResliceRound(result, *outPtr++);
+      inPtr0++;
+      inPtr1++;
+      }
+    while (--m);
+    }
+}
+
+// the edge handling of tricubic interpolation with a background, which
+// reverts to quadratic or linear interpolation next to the edges
+template <class F, class T>
+void vtkTricubicInterpolationRow(T *&outPtr, const T *inPtr,
+                                 const int inExt[6],
+                                 const vtkIdType inInc[3],
+                                 int numscalars, const F inPoint1[4],
+                                 const F xAxis[4], int idXmin, int idXmax)
+{
+  int inExtX = inExt[1] - inExt[0] + 1;
+  int inExtY = inExt[3] - inExt[2] + 1;
+  int inExtZ = inExt[5] - inExt[4] + 1;
+
+  vtkIdType inIncX = inInc[0];
+  vtkIdType inIncY = inInc[1];
+  vtkIdType inIncZ = inInc[2];
+
+  for (int idX = idXmin; idX <= idXmax; idX++)
+    {
+    F fx, fy, fz;
+    int inIdX0 = vtkResliceFloor(inPoint1[0] + idX*xAxis[0], fx) - inExt[0];
+    int inIdY0 = vtkResliceFloor(inPoint1[1] + idX*xAxis[1], fy) - inExt[2];
+    int inIdZ0 = vtkResliceFloor(inPoint1[2] + idX*xAxis[2], fz) - inExt[4];
+
+    int fxIsNotZero = (fx != 0);
+    int fyIsNotZero = (fy != 0);
+    int fzIsNotZero = (fz != 0);
+
+    int i1 = 1 - (inIdX0 > 0)*fxIsNotZero;
+    int j1 = 1 - (inIdY0 > 0)*fyIsNotZero;
+    int k1 = 1 - (inIdZ0 > 0)*fzIsNotZero;
+
+    int i2 = 1 + (1 + (inIdX0 + 2 < inExtX))*fxIsNotZero;
+    int j2 = 1 + (1 + (inIdY0 + 2 < inExtY))*fyIsNotZero;
+    int k2 = 1 + (1 + (inIdZ0 + 2 < inExtZ))*fzIsNotZero;
+
+    F fX[4], fY[4], fZ[4];
+    vtkTricubicInterpCoeffs(fX, i1, i2, fx);
+    vtkTricubicInterpCoeffs(fY, j1, j2, fy);
+    vtkTricubicInterpCoeffs(fZ, k1, k2, fz);
+
+    vtkIdType factX[4], factY[4], factZ[4];
+    factX[1] = inIdX0*inIncX;
+    factX[0] = factX[1] - inIncX;
+    factX[2] = factX[1] + inIncX;
+    factX[3] = factX[2] + inIncX;
+
+    factY[1] = inIdY0*inIncY;
+    factY[0] = factY[1] - inIncY;
+    factY[2] = factY[1] + inIncY;
+    factY[3] = factY[2] + inIncY;
+
+    factZ[1] = inIdZ0*inIncZ;
+    factZ[0] = factZ[1] - inIncZ;
+    factZ[2] = factZ[1] + inIncZ;
+    factZ[3] = factZ[2] + inIncZ;
+
+    if (i1 > 0)
+      {
+      factX[0] = factX[1];
+      }
+    if (i2 < 3)
+      {
+      factX[3] = factX[1];
+      if (i2 < 2)
+        {
+        factX[2] = factX[1];
+        }
+      }
+
+    const T *inPtr0 = inPtr;
+    int m = numscalars;
+    do // loop over components
+      {
+      F val = 0;
+      int k = k1;
+      do // loop over z
+        {
+        F ifz = fZ[k];
+        vtkIdType factz = factZ[k];
+        int j = j1;
+        do // loop over y
+          {
+          F ify = fY[j];
+          F fzy = ifz*ify;
+          vtkIdType factzy = factz + factY[j];
+          const T *tmpPtr = inPtr0 + factzy;
+          val += fzy*(fX[0]*tmpPtr[factX[0]] +
+                      fX[1]*tmpPtr[factX[1]] +
+                      fX[2]*tmpPtr[factX[2]] +
+                      fX[3]*tmpPtr[factX[3]]);
+          }
+        while (++j <= j2);
+        }
+      while (++k <= k2);
+
+      vtkResliceClamp(val, *outPtr++);
+      inPtr0++;
+      }
+    while (--m);
+    }
+}
+
+//--------------------------------------------------------------------------
+// Check that the interpolation at the sample point inPoint1 + idX*xAxis
+// uses no voxel outside of the input extent.
+template <class F>
+inline int vtkResliceIsInterior(const F inPoint1[4], const F xAxis[4],
+                                int idX, const int inExt[6])
+{
+  for (int k = 0; k < 3; k++)
+    {
+    F f;
+    int inId0 = vtkResliceFloor(inPoint1[k] + idX*xAxis[k], f) - inExt[2*k];
+    if (inId0 < 0 || inId0 + (f != 0) > inExt[2*k+1] - inExt[2*k])
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+// Find the longest run spanMin to spanMax of [idXmin, idXmax] that can be
+// given to a row interpolation function, or return zero if there is none.
+// The position along the row is linear in idX, so the interior voxels are
+// a single run: it is estimated in double precision and its ends are then
+// checked with the arithmetic of the interpolation functions.
+template <class F>
+int vtkResliceInteriorSpan(const F inPoint1[4], const F xAxis[4],
+                           const int inExt[6], int idXmin, int idXmax,
+                           int &spanMin, int &spanMax)
+{
+  double lo = idXmin;
+  double hi = idXmax;
+  for (int k = 0; k < 3 && lo <= hi; k++)
+    {
+    double a = inPoint1[k];
+    double b = xAxis[k];
+    double e0 = inExt[2*k];
+    double e1 = inExt[2*k+1];
+    if (b == 0)
+      {
+      if (a < e0 || a > e1)
+        {
+        return 0;
+        }
+      continue;
+      }
+    double t0 = (e0 - a)/b;
+    double t1 = (e1 - a)/b;
+    if (t0 > t1)
+      {
+      double tmp = t0;
+      t0 = t1;
+      t1 = tmp;
+      }
+    lo = (t0 > lo ? ceil(t0) : lo);
+    hi = (t1 < hi ? floor(t1) : hi);
+    }
+  if (lo > hi)
+    {
+    return 0;
+    }
+
+  spanMin = static_cast<int>(lo);
+  spanMax = static_cast<int>(hi);
+  while (spanMin <= spanMax &&
+         !vtkResliceIsInterior(inPoint1, xAxis, spanMin, inExt))
+    {
+    spanMin++;
+    }
+  while (spanMax >= spanMin &&
+         !vtkResliceIsInterior(inPoint1, xAxis, spanMax, inExt))
+    {
+    spanMax--;
+    }
+  return (spanMin <= spanMax);
+}
+
+//--------------------------------------------------------------------------
+// get appropriate interpolation function according to interpolation mode
+// and scalar type
+template<class F>
+void vtkGetResliceInterpFunc(vtkImageReslice *self,
+                             int (**interpolate)(void *&outPtr,
+                                                 const void *inPtr,
+                                                 const int inExt[6],
+                                                 const vtkIdType inInc[3],
+                                                 int numscalars,
+                                                 const F point[3],
+                                                 int mode,
+                                                 const void *background))
+{
+  int dataType = self->GetOutput()->GetScalarType();
+  int interpolationMode = self->GetInterpolationMode();
+
+  if (self->GetInterpolator())
+    {
+    switch (dataType)
+      {
+      vtkTemplateAliasMacro(*interpolate =
+                            (&vtkKernelInterpolation<F,VTK_TT>));
+      default:
+        *interpolate = 0;
+      }
+    return;
+    }
+  
+  switch (interpolationMode)
+    {
+    case VTK_RESLICE_NEAREST:
+      switch (dataType)
+        {
+        vtkTemplateAliasMacro(*((int (**)(VTK_TT *&outPtr, const VTK_TT *inPtr,
+                                     const int inExt[6],
+                                     const vtkIdType inInc[3],
+                                     int numscalars, const F point[3],
+                                     int mode,
+                                     const VTK_TT *background))interpolate) = \
+                         &vtkNearestNeighborInterpolation);
+        default:
+          interpolate = 0;
+        }
+      break;
+    case VTK_RESLICE_LINEAR:
+    case VTK_RESLICE_RESERVED_2:
+      switch (dataType)
+        {
+        vtkTemplateAliasMacro(*((int (**)(VTK_TT *&outPtr, const VTK_TT *inPtr,
+                                     const int inExt[6],
+                                     const vtkIdType inInc[3],
+                                     int numscalars, const F point[3],
+                                     int mode,
+                                     const VTK_TT *background))interpolate) = \
+                         &vtkTrilinearInterpolation);
+        default:
+          interpolate = 0;
+        }
+      break;
+    case VTK_RESLICE_CUBIC:
+      switch (dataType)
+        {
+        vtkTemplateAliasMacro(*((int (**)(VTK_TT *&outPtr, const VTK_TT *inPtr,
+                                     const int inExt[6],
+                                     const vtkIdType inInc[3],
+                                     int numscalars, const F point[3],
+                                     int mode,
+                                     const VTK_TT *background))interpolate) = \
+                         &vtkTricubicInterpolation);
+        default:
+          interpolate = 0;
+        }
+      break;
+    default:
+      interpolate = 0;
+    }
+}
+
+
+//--------------------------------------------------------------------------
+// get the row interpolation function for the interpolation mode, scalar
+// type and border mode, or NULL if there is none
+template<class F>
+void vtkGetResliceRowInterpFunc(vtkImageReslice *self, int mode,
+                                void (**rowinterp)(void *&outPtr,
+                                                   const void *inPtr,
+                                                   const int inExt[6],
+                                                   const vtkIdType inInc[3],
+                                                   int numscalars,
+                                                   const F inPoint1[4],
+                                                   const F xAxis[4],
+                                                   int idXmin, int idXmax))
+{
+  int dataType = self->GetOutput()->GetScalarType();
+  int interpolationMode = self->GetInterpolationMode();
+
+  *rowinterp = 0;
+  if (self->GetInterpolator())
+    {
+    return;
+    }
+  switch (interpolationMode)
+    {
+    case VTK_RESLICE_NEAREST:
+      switch (dataType)
+        {
+        vtkTemplateAliasMacro(*((void (**)(VTK_TT *&outPtr,
+                                      const VTK_TT *inPtr,
+                                      const int inExt[6],
+                                      const vtkIdType inInc[3],
+                                      int numscalars, const F inPoint1[4],
+                                      const F xAxis[4],
+                                      int idXmin, int idXmax))rowinterp) = \
+                         &vtkNearestNeighborInterpolationRow);
+        }
+      break;
+    case VTK_RESLICE_LINEAR:
+    case VTK_RESLICE_RESERVED_2:
+      switch (dataType)
+        {
+        vtkTemplateAliasMacro(*((void (**)(VTK_TT *&outPtr,
+                                      const VTK_TT *inPtr,
+                                      const int inExt[6],
+                                      const vtkIdType inInc[3],
+                                      int numscalars, const F inPoint1[4],
+                                      const F xAxis[4],
+                                      int idXmin, int idXmax))rowinterp) = \
+                         &vtkTrilinearInterpolationRow);
+        }
+      break;
+    case VTK_RESLICE_CUBIC:
+      // wrap, mirror and border change the weights next to the edges
+      if (mode == VTK_RESLICE_BACKGROUND || mode == VTK_RESLICE_NULL)
+        {
+        switch (dataType)
+          {
+          vtkTemplateAliasMacro(*((void (**)(VTK_TT *&outPtr,
+                                        const VTK_TT *inPtr,
+                                        const int inExt[6],
+                                        const vtkIdType inInc[3],
+                                        int numscalars, const F inPoint1[4],
+                                        const F xAxis[4],
+                                        int idXmin, int idXmax))rowinterp) = \
+                           &vtkTricubicInterpolationRow);
+          }
+        }
+      break;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Some helper functions for 'RequestData'
+//----------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------
+// pixel copy function, templated for different scalar types
+template <class T>
+struct vtkImageResliceSetPixels
+{
+static void Set(void *&outPtrV, const void *inPtrV, int numscalars, int n)
+{
+  const T* inPtr = static_cast<const T*>(inPtrV);
+  T* outPtr = static_cast<T*>(outPtrV);
+  for (int i = 0; i < n; i++)
+    {
+    const T *tmpPtr = inPtr;
+    int m = numscalars;
+    do
+      {
+      *outPtr++ = *tmpPtr++;
+      }
+    while (--m);
+    }
+  outPtrV = outPtr;
+}
+
+// optimized for 1 scalar components
+static void Set1(void *&outPtrV, const void *inPtrV,
+                          int vtkNotUsed(numscalars), int n)
+{
+  const T* inPtr = static_cast<const T*>(inPtrV);
+  T* outPtr = static_cast<T*>(outPtrV);
+  T val = *inPtr;
+  for (int i = 0; i < n; i++)
+    {
+    *outPtr++ = val;
+    }
+  outPtrV = outPtr;
+}
+};
+
+// get a pixel copy function that is appropriate for the data type
+void vtkGetSetPixelsFunc(vtkImageReslice *self,
+                         void (**setpixels)(void *&out, const void *in,
+                                            int numscalars, int n))
+{
+  int dataType = self->GetOutput()->GetScalarType();
+  int numscalars = self->GetOutput()->GetNumberOfScalarComponents();
+
+  switch (numscalars)
+    {
+    case 1:
+      switch (dataType)
+        {
+        vtkTemplateAliasMacro(
+          *setpixels = &vtkImageResliceSetPixels<VTK_TT>::Set1
+          );
+        default:
+          setpixels = 0;
+        }
+    default:
+      switch (dataType)
+        {
+        vtkTemplateAliasMacro(
+          *setpixels = &vtkImageResliceSetPixels<VTK_TT>::Set
+          );
+        default:
+          setpixels = 0;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Convert background color from float to appropriate type
+template <class T>
+void vtkAllocBackgroundPixelT(vtkImageReslice *self,
+                              T **background_ptr, int numComponents)
+{
+  *background_ptr = new T[numComponents];
+  T *background = *background_ptr;
+
+  for (int i = 0; i < numComponents; i++)
+    {
+    if (i < 4)
+      {
+      vtkResliceClamp(self->GetBackgroundColor()[i], background[i]);
+      }
+    else
+      {
+      background[i] = 0;
+      }
+    }
+}
+
+void vtkAllocBackgroundPixel(vtkImageReslice *self, void **rval, 
+                             int numComponents)
+{
+  switch (self->GetOutput()->GetScalarType())
+    {
+    vtkTemplateAliasMacro(vtkAllocBackgroundPixelT(self, (VTK_TT **)rval,
+                                              numComponents));
+    }
+}      
+
+void vtkFreeBackgroundPixel(vtkImageReslice *self, void **rval)
+{
+  switch (self->GetOutput()->GetScalarType())
+    {
+    vtkTemplateAliasMacro(delete [] *((VTK_TT **)rval));
+    }
+
+  *rval = 0;
+}      
+
+//----------------------------------------------------------------------------
+// helper function for clipping of the output with a stencil
+int vtkResliceGetNextExtent(vtkImageStencilData *stencil,
+                            int &r1, int &r2, int rmin, int rmax,
+                            int yIdx, int zIdx, 
+                            void *&outPtr, void *background, 
                             int numscalars,
                             void (*setpixels)(void *&out,
                                               const void *in,
@@ -1906,7 +2652,8 @@ void vtkImageResliceClearExecute(vtkImageReslice *self,
 void vtkImageResliceExecute(vtkImageReslice *self,
                             vtkImageData *inData, void *inPtr,
                             vtkImageData *outData, void *outPtr,
-                            int outExt[6], int id)
+                            int outExt[6], int id,
+                            const vtkResliceKernel *kernel)
 {
   int numscalars;
   int idX, idY, idZ;
@@ -1978,6 +2725,13 @@ void vtkImageResliceExecute(vtkImageReslice *self,
   vtkGetResliceInterpFunc(self, &interpolate);
   vtkGetSetPixelsFunc(self, &setpixels);
 
+  // the interpolation function of a kernel gets it instead of the input
+  const void *interpPtr = inPtr;
+  if (kernel)
+    {
+    interpPtr = kernel;
+    }
+
   // get the stencil
   vtkImageStencilData *stencil = self->GetStencil();
 
@@ -2031,7 +2785,7 @@ void vtkImageResliceExecute(vtkImageReslice *self,
           point[2] = (point[2] - inOrigin[2])*inInvSpacing[2];
 
           // interpolate output voxel from input data set
-          interpolate(outPtr, inPtr, inExt, inInc, numscalars,
+          interpolate(outPtr, interpPtr, inExt, inInc, numscalars,
                       point, mode, background);
           } 
         }
@@ -2081,7 +2835,8 @@ void vtkOptimizedExecute(vtkImageReslice *self,
                          vtkImageData *inData, void *inPtr,
                          vtkImageData *outData, void *outPtr,
                          int outExt[6], int id, F newmat[4][4], 
-                         vtkAbstractTransform *newtrans)
+                         vtkAbstractTransform *newtrans,
+                         const vtkResliceKernel *kernel)
 {
   int i, numscalars;
   int idX, idY, idZ;
@@ -2103,6 +2858,10 @@ void vtkOptimizedExecute(vtkImageReslice *self,
                      const int inExt[6], const vtkIdType inInc[3],
                      int numscalars, const F point[3],
                      int mode, const void *background);
+  void (*rowinterp)(void *&outPtr, const void *inPtr,
+                    const int inExt[6], const vtkIdType inInc[3],
+                    int numscalars, const F inPoint1[4], const F xAxis[4],
+                    int idXmin, int idXmax);
   void (*setpixels)(void *&out, const void *in, int numscalars, int n);
 
   int mode = VTK_RESLICE_BACKGROUND;
@@ -2132,7 +2891,7 @@ void vtkOptimizedExecute(vtkImageReslice *self,
 
   int optimizeNearest = 0;
   if (self->GetInterpolationMode() == VTK_RESLICE_NEAREST &&
-      !(wrap || newtrans || perspective))
+      !(kernel || wrap || newtrans || perspective))
     {
     optimizeNearest = 1;
     }
@@ -2178,6 +2937,21 @@ void vtkOptimizedExecute(vtkImageReslice *self,
   vtkGetResliceInterpFunc(self, &interpolate);
   vtkGetSetPixelsFunc(self, &setpixels);
 
+  // the interpolation function of a kernel gets it instead of the input
+  const void *interpPtr = inPtr;
+  if (kernel)
+    {
+    interpPtr = kernel;
+    }
+
+  // Whole runs of voxels that need no border handling can be interpolated
+  // by a row function when the sample points are linear along the row
+  rowinterp = 0;
+  if (!(newtrans || perspective))
+    {
+    vtkGetResliceRowInterpFunc(self, mode, &rowinterp);
+    }
+
   // get the stencil
   vtkImageStencilData *stencil = self->GetStencil();
 
@@ -2211,10 +2985,28 @@ void vtkOptimizedExecute(vtkImageReslice *self,
                                      outPtr, background, numscalars, 
                                      setpixels, iter))
         {
+        // the interior for linear interpolation is also interior for
+        // nearest-neighbor interpolation, which rounds instead of floors
+        int spanMin, spanMax;
+        if (!rowinterp ||
+            !vtkResliceInteriorSpan(inPoint1, xAxis, inExt, idXmin, idXmax,
+                                    spanMin, spanMax))
+          { // no row to interpolate at once
+          spanMin = idXmax + 1;
+          spanMax = idXmax;
+          }
+
         if (!optimizeNearest)
           {
           for (idX = idXmin; idX <= idXmax; idX++)
             {
+            if (idX == spanMin)
+              { // interpolate the interior of the row at once
+              rowinterp(outPtr, inPtr, inExt, inInc, numscalars,
+                        inPoint1, xAxis, spanMin, spanMax);
+              idX = spanMax;
+              continue;
+              }
             inPoint[0] = inPoint1[0] + idX*xAxis[0];
             inPoint[1] = inPoint1[1] + idX*xAxis[1];
             inPoint[2] = inPoint1[2] + idX*xAxis[2];
@@ -2232,7 +3024,7 @@ void vtkOptimizedExecute(vtkImageReslice *self,
                                        inInvSpacing);
               }
             // call the interpolation function
-            interpolate(outPtr, inPtr, inExt, inInc, numscalars,
+            interpolate(outPtr, interpPtr, inExt, inInc, numscalars,
                         inPoint, mode, background);
             }
           }
@@ -2244,6 +3036,14 @@ void vtkOptimizedExecute(vtkImageReslice *self,
 
           for (int iidX = idXmin; iidX <= idXmax; iidX++)
             {
+            if (iidX == spanMin)
+              { // copy the interior of the row at once
+              rowinterp(outPtr, inPtr, inExt, inInc, numscalars,
+                        inPoint1, xAxis, spanMin, spanMax);
+              iidX = spanMax;
+              continue;
+              }
+
             void *inPtrTmp = background;
 
             inPoint[0] = inPoint1[0] + iidX*xAxis[0];
@@ -2422,78 +3222,263 @@ void vtkPermuteTrilinearSummation(T *&outPtr, const T *inPtr,
     }
   else if (useNearestNeighbor[0] && fy == 0)
     { // only need linear z interpolation
-    for (int i = 0; i < n; i++)
+    for (int i = 0; i < n; i++)
+      {
+      vtkIdType t0 = iX[0];
+      iX += 2;
+          
+      const T *inPtr0 = inPtr + t0; 
+      int m = numscalars;
+      do 
+        {
+        F result = (rz*inPtr0[i00] + fz*inPtr0[i01]);
+        vtkResliceRound(result, *outPtr++);
+        inPtr0++;
+        }
+      while (--m);
+      }
+    }
+  else if (fz == 0)
+    { // bilinear interpolation in x,y
+    for (int i = 0; i < n; i++)
+      {
+      F rx = fX[0];
+      F fx = fX[1];
+      fX += 2;
+
+      vtkIdType t0 = iX[0];
+      vtkIdType t1 = iX[1];
+      iX += 2;
+
+      const T *inPtr0 = inPtr + t0;
+      const T *inPtr1 = inPtr + t1;
+      int m = numscalars;
+      do 
+        {
+        F result = (rx*(ry*inPtr0[i00] + fy*inPtr0[i10]) +
+                    fx*(ry*inPtr1[i00] + fy*inPtr1[i10]));
+
+        vtkResliceRound(result, *outPtr++);
+        inPtr0++;
+        inPtr1++;
+        }
+      while (--m);
+      }
+    }
+  else
+    { // do full trilinear interpolation 
+    for (int i = 0; i < n; i++)
+      {
+      F rx = fX[0];
+      F fx = fX[1];
+      fX += 2;
+       
+      vtkIdType t0 = iX[0];
+      vtkIdType t1 = iX[1];
+      iX += 2;
+
+      const T *inPtr0 = inPtr + t0;
+      const T *inPtr1 = inPtr + t1;
+      int m = numscalars;
+      do 
+        {
+        F result = (rx*(ryrz*inPtr0[i00] + ryfz*inPtr0[i01] +
+                        fyrz*inPtr0[i10] + fyfz*inPtr0[i11]) +
+                    fx*(ryrz*inPtr1[i00] + ryfz*inPtr1[i01] +
+                        fyrz*inPtr1[i10] + fyfz*inPtr1[i11]));
+
+        vtkResliceRound(result, *outPtr++);
+        inPtr0++;
+        inPtr1++;
+        }
+      while (--m);
+      }
+    }
+}
+
+//--------------------------------------------------------------------------
+// SSE2 versions of the bilinear and trilinear loops below, two output
+// voxels at a time like the row kernels of vtkOptimizedExecute. They
+// return the number of voxels done, the rest is left for the scalar loop.
+template <class F, class T>
+inline int vtkPermuteBilinearRowSSE2(T *, const T *, const T *, int,
+                                     const vtkIdType *, const F *, F, F)
+{
+  return 0;
+}
+
+template <class F, class T>
+inline int vtkPermuteTrilinearRowSSE2(T *, const T *, const T *,
+                                      const T *, const T *, int,
+                                      const vtkIdType *, const F *,
+                                      const F [4])
+{
+  return 0;
+}
+
+#ifdef VTK_RESLICE_USE_SSE2
+template <class T>
+int vtkPermuteBilinearRowSSE2(T *outPtr, const T *inPtr00,
+                              const T *inPtr10, int n,
+                              const vtkIdType *iX, const double *fX,
+                              double ry, double fy)
+{
+  const __m128d rys = _mm_set1_pd(ry);
+  const __m128d fys = _mm_set1_pd(fy);
+  int i = 0;
+  for (; i + 1 < n; i += 2)
+    {
+    // the (rx, fx) pairs of the two voxels, and their (t0, t1) offsets
+    const vtkIdType *t = iX + 2*i;
+    __m128d f0 = _mm_loadu_pd(fX + 2*i);
+    __m128d f1 = _mm_loadu_pd(fX + 2*i + 2);
+    __m128d rx = _mm_unpacklo_pd(f0, f1);
+    __m128d fx = _mm_unpackhi_pd(f0, f1);
+
+    __m128d v0 = _mm_mul_pd(rys, _mm_set_pd(inPtr00[t[2]], inPtr00[t[0]]));
+    __m128d v1 = _mm_mul_pd(rys, _mm_set_pd(inPtr00[t[3]], inPtr00[t[1]]));
+    v0 = _mm_add_pd(v0, _mm_mul_pd(fys, _mm_set_pd(inPtr10[t[2]],
+                                                   inPtr10[t[0]])));
+    v1 = _mm_add_pd(v1, _mm_mul_pd(fys, _mm_set_pd(inPtr10[t[3]],
+                                                   inPtr10[t[1]])));
+
+    double result[2];
+    _mm_storeu_pd(result, _mm_add_pd(_mm_mul_pd(rx, v0),
+                                     _mm_mul_pd(fx, v1)));
+    vtkResliceRound(result[0], outPtr[i]);
+    vtkResliceRound(result[1], outPtr[i+1]);
+    }
+  return i;
+}
+
+template <class T>
+int vtkPermuteTrilinearRowSSE2(T *outPtr, const T *inPtr00,
+                               const T *inPtr01, const T *inPtr10,
+                               const T *inPtr11, int n,
+                               const vtkIdType *iX, const double *fX,
+                               const double fYZ[4])
+{
+  const __m128d ryrz = _mm_set1_pd(fYZ[0]);
+  const __m128d ryfz = _mm_set1_pd(fYZ[1]);
+  const __m128d fyrz = _mm_set1_pd(fYZ[2]);
+  const __m128d fyfz = _mm_set1_pd(fYZ[3]);
+  int i = 0;
+  for (; i + 1 < n; i += 2)
+    {
+    const vtkIdType *t = iX + 2*i;
+    __m128d f0 = _mm_loadu_pd(fX + 2*i);
+    __m128d f1 = _mm_loadu_pd(fX + 2*i + 2);
+    __m128d rx = _mm_unpacklo_pd(f0, f1);
+    __m128d fx = _mm_unpackhi_pd(f0, f1);
+
+    __m128d v0 = _mm_mul_pd(ryrz, _mm_set_pd(inPtr00[t[2]], inPtr00[t[0]]));
+    __m128d v1 = _mm_mul_pd(ryrz, _mm_set_pd(inPtr00[t[3]], inPtr00[t[1]]));
+    v0 = _mm_add_pd(v0, _mm_mul_pd(ryfz, _mm_set_pd(inPtr01[t[2]],
+                                                    inPtr01[t[0]])));
+    v1 = _mm_add_pd(v1, _mm_mul_pd(ryfz, _mm_set_pd(inPtr01[t[3]],
+                                                    inPtr01[t[1]])));
+    v0 = _mm_add_pd(v0, _mm_mul_pd(fyrz, _mm_set_pd(inPtr10[t[2]],
+                                                    inPtr10[t[0]])));
+    v1 = _mm_add_pd(v1, _mm_mul_pd(fyrz, _mm_set_pd(inPtr10[t[3]],
+                                                    inPtr10[t[1]])));
+    v0 = _mm_add_pd(v0, _mm_mul_pd(fyfz, _mm_set_pd(inPtr11[t[2]],
+                                                    inPtr11[t[0]])));
+    v1 = _mm_add_pd(v1, _mm_mul_pd(fyfz, _mm_set_pd(inPtr11[t[3]],
+                                                    inPtr11[t[1]])));
+
+    double result[2];
+    _mm_storeu_pd(result, _mm_add_pd(_mm_mul_pd(rx, v0),
+                                     _mm_mul_pd(fx, v1)));
+    vtkResliceRound(result[0], outPtr[i]);
+    vtkResliceRound(result[1], outPtr[i+1]);
+    }
+  return i;
+}
+#endif
+
+//--------------------------------------------------------------------------
+// helper function for linear interpolation of single-component data:
+// without the loop over the components, each case is a plain loop over
+// the row that the compiler can unroll or vectorize
+template<class F, class T>
+void vtkPermuteTrilinearSummation1(T *&outPtr, const T *inPtr,
+                                   int, int n,
+                                   const vtkIdType *iX, const F *fX,
+                                   const vtkIdType *iY, const F *fY,
+                                   const vtkIdType *iZ, const F *fZ,
+                                   const int useNearestNeighbor[3])
+{
+  vtkIdType i00 = iY[0] + iZ[0];
+  vtkIdType i01 = iY[0] + iZ[1];
+  vtkIdType i10 = iY[1] + iZ[0];
+  vtkIdType i11 = iY[1] + iZ[1];
+
+  F ry = fY[0];
+  F fy = fY[1];
+  F rz = fZ[0];
+  F fz = fZ[1];
+
+  F ryrz = ry*rz;
+  F ryfz = ry*fz;
+  F fyrz = fy*rz;
+  F fyfz = fy*fz;
+
+  const T *inPtr00 = inPtr + i00;
+  const T *inPtr01 = inPtr + i01;
+  const T *inPtr10 = inPtr + i10;
+  const T *inPtr11 = inPtr + i11;
+
+  int i;
+  if (useNearestNeighbor[0] && fy == 0 && fz == 0)
+    { // no interpolation needed at all
+    for (i = 0; i < n; i++)
+      {
+      outPtr[i] = inPtr00[iX[2*i]];
+      }
+    }
+  else if (useNearestNeighbor[0] && fy == 0)
+    { // only need linear z interpolation
+    for (i = 0; i < n; i++)
       {
-      vtkIdType t0 = iX[0];
-      iX += 2;
-          
-      const T *inPtr0 = inPtr + t0; 
-      int m = numscalars;
-      do 
-        {
-        F result = (rz*inPtr0[i00] + fz*inPtr0[i01]);
-        vtkResliceRound(result, *outPtr++);
-        inPtr0++;
-        }
-      while (--m);
+      vtkIdType t0 = iX[2*i];
+      F result = (rz*inPtr00[t0] + fz*inPtr01[t0]);
+      vtkResliceRound(result, outPtr[i]);
       }
     }
   else if (fz == 0)
     { // bilinear interpolation in x,y
-    for (int i = 0; i < n; i++)
+    i = vtkPermuteBilinearRowSSE2(outPtr, inPtr00, inPtr10, n, iX, fX,
+                                  ry, fy);
+    for (; i < n; i++)
       {
-      F rx = fX[0];
-      F fx = fX[1];
-      fX += 2;
-
-      vtkIdType t0 = iX[0];
-      vtkIdType t1 = iX[1];
-      iX += 2;
-
-      const T *inPtr0 = inPtr + t0;
-      const T *inPtr1 = inPtr + t1;
-      int m = numscalars;
-      do 
-        {
-        F result = (rx*(ry*inPtr0[i00] + fy*inPtr0[i10]) +
-                    fx*(ry*inPtr1[i00] + fy*inPtr1[i10]));
-
-        vtkResliceRound(result, *outPtr++);
-        inPtr0++;
-        inPtr1++;
-        }
-      while (--m);
+      F rx = fX[2*i];
+      F fx = fX[2*i+1];
+      vtkIdType t0 = iX[2*i];
+      vtkIdType t1 = iX[2*i+1];
+      F result = (rx*(ry*inPtr00[t0] + fy*inPtr10[t0]) +
+                  fx*(ry*inPtr00[t1] + fy*inPtr10[t1]));
+      vtkResliceRound(result, outPtr[i]);
       }
     }
   else
-    { // do full trilinear interpolation 
-    for (int i = 0; i < n; i++)
+    { // do full trilinear interpolation
+    F fYZ[4] = { ryrz, ryfz, fyrz, fyfz };
+    i = vtkPermuteTrilinearRowSSE2(outPtr, inPtr00, inPtr01, inPtr10,
+                                   inPtr11, n, iX, fX, fYZ);
+    for (; i < n; i++)
       {
-      F rx = fX[0];
-      F fx = fX[1];
-      fX += 2;
-       
-      vtkIdType t0 = iX[0];
-      vtkIdType t1 = iX[1];
-      iX += 2;
-
-      const T *inPtr0 = inPtr + t0;
-      const T *inPtr1 = inPtr + t1;
-      int m = numscalars;
-      do 
-        {
-        F result = (rx*(ryrz*inPtr0[i00] + ryfz*inPtr0[i01] +
-                        fyrz*inPtr0[i10] + fyfz*inPtr0[i11]) +
-                    fx*(ryrz*inPtr1[i00] + ryfz*inPtr1[i01] +
-                        fyrz*inPtr1[i10] + fyfz*inPtr1[i11]));
-
-        vtkResliceRound(result, *outPtr++);
-        inPtr0++;
-        inPtr1++;
-        }
-      while (--m);
+      F rx = fX[2*i];
+      F fx = fX[2*i+1];
+      vtkIdType t0 = iX[2*i];
+      vtkIdType t1 = iX[2*i+1];
+      F result = (rx*(ryrz*inPtr00[t0] + ryfz*inPtr01[t0] +
+                      fyrz*inPtr10[t0] + fyfz*inPtr11[t0]) +
+                  fx*(ryrz*inPtr00[t1] + ryfz*inPtr01[t1] +
+                      fyrz*inPtr10[t1] + fyfz*inPtr11[t1]));
+      vtkResliceRound(result, outPtr[i]);
       }
     }
+  outPtr += n;
 }
 
 //--------------------------------------------------------------------------
@@ -2648,17 +3633,35 @@ void vtkGetResliceSummationFunc(vtkImageReslice *self,
       break;
     case VTK_RESLICE_LINEAR:
     case VTK_RESLICE_RESERVED_2:
-      switch (scalarType)
+      if (numScalars == 1)
         {
-        vtkTemplateAliasMacro(*((void (**)(VTK_TT *&out, const VTK_TT *in,
-                                      int numscalars, int n,
-                                      const vtkIdType *iX, const F *fX,
-                                      const vtkIdType *iY, const F *fY,
-                                      const vtkIdType *iZ, const F *fZ,
-                                      const int useNearest[3]))summation) = \
-                         vtkPermuteTrilinearSummation);
-        default:
-          summation = 0;
+        switch (scalarType)
+          {
+          vtkTemplateAliasMacro(*((void (**)(VTK_TT *&out, const VTK_TT *in,
+                                        int numscalars, int n,
+                                        const vtkIdType *iX, const F *fX,
+                                        const vtkIdType *iY, const F *fY,
+                                        const vtkIdType *iZ, const F *fZ,
+                                        const int useNearest[3]))summation) = \
+                           vtkPermuteTrilinearSummation1);
+          default:
+            summation = 0;
+          }
+        }
+      else
+        {
+        switch (scalarType)
+          {
+          vtkTemplateAliasMacro(*((void (**)(VTK_TT *&out, const VTK_TT *in,
+                                        int numscalars, int n,
+                                        const vtkIdType *iX, const F *fX,
+                                        const vtkIdType *iY, const F *fY,
+                                        const vtkIdType *iZ, const F *fZ,
+                                        const int useNearest[3]))summation) = \
+                           vtkPermuteTrilinearSummation);
+          default:
+            summation = 0;
+          }
         }
       break;
     case VTK_RESLICE_CUBIC:
@@ -2680,6 +3683,116 @@ void vtkGetResliceSummationFunc(vtkImageReslice *self,
     }
 }
 
+//----------------------------------------------------------------------------
+// helper function for interpolation with a kernel: the weights and the
+// offsets for y and z are the same along the row, so their products are
+// gathered once, skipping those that are zero
+template<class F, class C, class T>
+void vtkPermuteKernelSummation(T *&outPtr, const C *inPtr,
+                               int numscalars, int n,
+                               const vtkIdType *iX, const F *fX,
+                               const vtkIdType *iY, const F *fY,
+                               const vtkIdType *iZ, const F *fZ,
+                               int size)
+{
+  vtkIdType iZY[VTK_INTERPOLATOR_MAX_KERNEL_SIZE*
+                VTK_INTERPOLATOR_MAX_KERNEL_SIZE];
+  F fZY[VTK_INTERPOLATOR_MAX_KERNEL_SIZE*VTK_INTERPOLATOR_MAX_KERNEL_SIZE];
+  int m = 0;
+  for (int k = 0; k < size; k++)
+    {
+    for (int j = 0; j < size; j++)
+      {
+      F fzy = fZ[k]*fY[j];
+      if (fzy != 0)
+        {
+        iZY[m] = iZ[k] + iY[j];
+        fZY[m] = fzy;
+        m++;
+        }
+      }
+    }
+
+  for (int i = 0; i < n; i++)
+    {
+    const C *inPtr0 = inPtr;
+    int c = numscalars;
+    do
+      { // loop over components
+      F result = 0;
+      for (int l = 0; l < m; l++)
+        {
+        const C *tmpPtr = inPtr0 + iZY[l];
+        F sum = 0;
+        for (int ii = 0; ii < size; ii++)
+          {
+          sum += fX[ii]*tmpPtr[iX[ii]];
+          }
+        result += fZY[l]*sum;
+        }
+
+      vtkResliceClamp(result, *outPtr++);
+      inPtr0++;
+      }
+    while (--c);
+
+    iX += size;
+    fX += size;
+    }
+}
+
+//----------------------------------------------------------------------------
+// get the summation function for a kernel, for the scalar type and the
+// type of the data that the kernel applies to
+template<class F>
+void vtkGetResliceKernelSummationFunc(vtkImageReslice *self,
+                                      const vtkResliceKernel *kernel,
+                                      void (**summation)(void *&out,
+                                                         const void *in,
+                                                         int numscalars,
+                                                         int n,
+                                                         const vtkIdType *iX,
+                                                         const F *fX,
+                                                         const vtkIdType *iY,
+                                                         const F *fY,
+                                                         const vtkIdType *iZ,
+                                                         const F *fZ,
+                                                         int size))
+{
+  int scalarType = self->GetOutput()->GetScalarType();
+
+  if (kernel->DataIsDouble)
+    {
+    switch (scalarType)
+      {
+      vtkTemplateAliasMacro(*((void (**)(VTK_TT *&out, const double *in,
+                                    int numscalars, int n,
+                                    const vtkIdType *iX, const F *fX,
+                                    const vtkIdType *iY, const F *fY,
+                                    const vtkIdType *iZ, const F *fZ,
+                                    int size))summation) = \
+                       vtkPermuteKernelSummation);
+      default:
+        *summation = 0;
+      }
+    }
+  else
+    {
+    switch (scalarType)
+      {
+      vtkTemplateAliasMacro(*((void (**)(VTK_TT *&out, const VTK_TT *in,
+                                    int numscalars, int n,
+                                    const vtkIdType *iX, const F *fX,
+                                    const vtkIdType *iY, const F *fY,
+                                    const vtkIdType *iZ, const F *fZ,
+                                    int size))summation) = \
+                       vtkPermuteKernelSummation);
+      default:
+        *summation = 0;
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 template <class F>
 void vtkPermuteNearestTable(vtkImageReslice *self, const int outExt[6],
@@ -2975,6 +4088,103 @@ void vtkPermuteCubicTable(vtkImageReslice *self, const int outExt[6],
     }
 }
 
+//----------------------------------------------------------------------------
+template <class F>
+void vtkPermuteKernelTable(vtkImageReslice *self,
+                           const vtkResliceKernel *kernel,
+                           const int outExt[6],
+                           const int inExt[6], const vtkIdType inInc[3],
+                           int clipExt[6], vtkIdType **traversal,
+                           F **constants,
+                           int useNearestNeighbor[3], F newmat[4][4])
+{
+  int size = kernel->Size;
+  int offset = size/2 - 1;
+
+  int mode = VTK_RESLICE_BACKGROUND;
+  if (self->GetMirror())
+    {
+    mode = VTK_RESLICE_MIRROR;
+    }
+  else if (self->GetWrap())
+    {
+    mode = VTK_RESLICE_WRAP;
+    }
+  else if (self->GetBorder())
+    {
+    mode = VTK_RESLICE_BORDER;
+    }
+
+  // set up input traversal table for interpolation with the kernel
+  for (int j = 0; j < 3; j++)
+    {
+    int k;
+    for (k = 0; k < 3; k++)
+      { // set k to the element which is nonzero
+      if (newmat[k][j] != 0)
+        {
+        break;
+        }
+      }
+
+    // do the output pixels lie exactly on top of the input pixels?
+    F f1, f2;
+    vtkResliceFloor(newmat[k][j], f1);
+    vtkResliceFloor(newmat[k][3], f2);
+    useNearestNeighbor[j] = (f1 == 0 && f2 == 0);
+
+    int inExtK = inExt[2*k+1] - inExt[2*k] + 1;
+
+    int region = 0;
+    for (int i = outExt[2*j]; i <= outExt[2*j+1]; i++)
+      {
+      F point = newmat[k][3] + i*newmat[k][j];
+      F f;
+      int inId0 = vtkResliceFloor(point, f) - inExt[2*k];
+
+      if (mode == VTK_RESLICE_MIRROR || mode == VTK_RESLICE_WRAP)
+        {
+        region = 1;
+        }
+      else
+        {
+        int outside = (inId0 < 0 || inId0 + (f != 0) >= inExtK);
+        if (outside && mode == VTK_RESLICE_BORDER)
+          {
+          outside = vtkInterpolateBorderCheck(inId0, inId0 + 1, inExtK, f);
+          }
+        if (outside)
+          {
+          if (region == 1)
+            { // leaving the input extent
+            region = 2;
+            clipExt[2*j+1] = i - 1;
+            }
+          }
+        else
+          {
+          if (region == 0)
+            { // entering the input extent
+            region = 1;
+            clipExt[2*j] = i;
+            }
+          }
+        }
+
+      vtkResliceKernelWeights(kernel, f, &constants[j][size*i]);
+      for (int l = 0; l < size; l++)
+        {
+        traversal[j][size*i+l] =
+          vtkResliceKernelIndex(inId0 - offset + l, inExtK, mode)*inInc[k];
+        }
+      }
+    if (region == 0)
+      { // never entered input extent!
+      clipExt[2*j] = clipExt[2*j+1] + 1;
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 // Check to see if we can do nearest-neighbor instead of linear or cubic.  
 // This check only works on permutation+scale+translation matrices.
@@ -3017,7 +4227,8 @@ template <class F>
 void vtkReslicePermuteExecute(vtkImageReslice *self,
                                      vtkImageData *inData, void *inPtr,
                                      vtkImageData *outData, void *outPtr,
-                                     int outExt[6], int id, F newmat[4][4])
+                                     int outExt[6], int id, F newmat[4][4],
+                                     const vtkResliceKernel *kernel)
 {
   vtkIdType outInc[3];
   int scalarSize, numscalars;
@@ -3044,6 +4255,11 @@ void vtkReslicePermuteExecute(vtkImageReslice *self,
     }
 
   int interpolationMode = self->GetInterpolationMode();
+  if (kernel)
+    {
+    interpolationMode = VTK_RESLICE_KERNEL;
+    }
+  // the kernels of interpolators go through the samples too
   if (vtkCanUseNearestNeighbor(newmat, outExt))
     {
     interpolationMode = VTK_RESLICE_NEAREST;
@@ -3063,6 +4279,9 @@ void vtkReslicePermuteExecute(vtkImageReslice *self,
     case VTK_RESLICE_CUBIC:
       step = 4;
       break;
+    case VTK_RESLICE_KERNEL:
+      step = kernel->Size;
+      break;
     }
 
   // allocate the interpolation tables
@@ -3095,6 +4314,11 @@ void vtkReslicePermuteExecute(vtkImageReslice *self,
                            traversal, constants, 
                            useNearestNeighbor, newmat);
       break;
+    case VTK_RESLICE_KERNEL:
+      vtkPermuteKernelTable(self, kernel, outExt, inExt, inInc, clipExt,
+                            traversal, constants,
+                            useNearestNeighbor, newmat);
+      break;
     }
 
   // get type-specific functions
@@ -3103,8 +4327,22 @@ void vtkReslicePermuteExecute(vtkImageReslice *self,
                     const vtkIdType *iY, const F *fY,
                     const vtkIdType *iZ, const F *fZ,
                     const int useNearestNeighbor[3]);
+  void (*kernelsummation)(void *&out, const void *in, int numscalars, int n,
+                          const vtkIdType *iX, const F *fX,
+                          const vtkIdType *iY, const F *fY,
+                          const vtkIdType *iZ, const F *fZ,
+                          int size);
   void (*setpixels)(void *&out, const void *in, int numscalars, int n);
-  vtkGetResliceSummationFunc(self, &summation, interpolationMode);
+  summation = 0;
+  kernelsummation = 0;
+  if (interpolationMode == VTK_RESLICE_KERNEL)
+    {
+    vtkGetResliceKernelSummationFunc(self, kernel, &kernelsummation);
+    }
+  else
+    {
+    vtkGetResliceSummationFunc(self, &summation, interpolationMode);
+    }
   vtkGetSetPixelsFunc(self, &setpixels);
 
   // set color for area outside of input volume extent
@@ -3158,11 +4396,23 @@ void vtkReslicePermuteExecute(vtkImageReslice *self,
           {
           int idX0 = idXmin*step;
 
-          summation(outPtr, inPtr, numscalars, idXmax - idXmin + 1,
-                    &traversal[0][idX0], &constants[0][idX0],
-                    &traversal[1][idY0], &constants[1][idY0],
-                    &traversal[2][idZ0], &constants[2][idZ0],
-                    useNearestNeighbor);
+          if (kernelsummation)
+            {
+            kernelsummation(outPtr, kernel->Data, numscalars,
+                            idXmax - idXmin + 1,
+                            &traversal[0][idX0], &constants[0][idX0],
+                            &traversal[1][idY0], &constants[1][idY0],
+                            &traversal[2][idZ0], &constants[2][idZ0],
+                            step);
+            }
+          else
+            {
+            summation(outPtr, inPtr, numscalars, idXmax - idXmin + 1,
+                      &traversal[0][idX0], &constants[0][idX0],
+                      &traversal[1][idY0], &constants[1][idY0],
+                      &traversal[2][idZ0], &constants[2][idZ0],
+                      useNearestNeighbor);
+            }
           }
 
         // clear pixels to right of input extent
@@ -3345,6 +4595,59 @@ vtkMatrix4x4 *vtkImageReslice::GetIndexMatrix(vtkInformation *inInfo,
   return this->IndexMatrix;
 }
 
+//----------------------------------------------------------------------------
+// Prepare the interpolator before the threads share it: build its table of
+// weights and compute the coefficients that it applies to, unless those of
+// the previous execution still hold.
+int vtkImageReslice::RequestData(vtkInformation *request,
+                                 vtkInformationVector **inputVector,
+                                 vtkInformationVector *outputVector)
+{
+  if (this->Interpolator)
+    {
+    this->Interpolator->GetWeightTable();
+    }
+
+  if (this->Interpolator && this->Interpolator->GetRequiresCoefficients())
+    {
+    vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+    vtkImageData *input = vtkImageData::SafeDownCast(
+      inInfo->Get(vtkDataObject::DATA_OBJECT()));
+    int wrap = (this->Wrap && !this->Mirror);
+    int *ext = input->GetExtent();
+    int *coeffExt = (this->InterpolatorCoefficients ?
+                     this->InterpolatorCoefficients->GetExtent() : 0);
+
+    if (this->HitInputExtent &&
+        (!coeffExt ||
+         input->GetMTime() != this->InterpolatorCoefficientsInputMTime ||
+         this->Interpolator->GetMTime() !=
+           this->InterpolatorCoefficientsMTime ||
+         wrap != this->InterpolatorCoefficientsWrap ||
+         coeffExt[0] != ext[0] || coeffExt[1] != ext[1] ||
+         coeffExt[2] != ext[2] || coeffExt[3] != ext[3] ||
+         coeffExt[4] != ext[4] || coeffExt[5] != ext[5]))
+      {
+      if (!this->InterpolatorCoefficients)
+        {
+        this->InterpolatorCoefficients = vtkImageData::New();
+        }
+      this->Interpolator->ComputeCoefficients(
+        input, this->InterpolatorCoefficients, wrap);
+      this->InterpolatorCoefficientsInputMTime = input->GetMTime();
+      this->InterpolatorCoefficientsMTime = this->Interpolator->GetMTime();
+      this->InterpolatorCoefficientsWrap = wrap;
+      }
+    }
+  else if (this->InterpolatorCoefficients)
+    {
+    this->InterpolatorCoefficients->Delete();
+    this->InterpolatorCoefficients = NULL;
+    }
+
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
 //----------------------------------------------------------------------------
 // This method is passed a input and output region, and executes the filter
 // algorithm to fill the output from the input.
@@ -3395,6 +4698,24 @@ void vtkImageReslice::ThreadedRequestData(
   // Now that we know that we need the input, get the input pointer
   void *inPtr = inData[0][0]->GetScalarPointerForExtent(inExt);
 
+  // the kernel of the interpolator and the data that it applies to
+  vtkResliceKernel kernelInfo;
+  vtkResliceKernel *kernel = NULL;
+  if (this->Interpolator)
+    {
+    kernel = &kernelInfo;
+    kernel->Size = this->Interpolator->GetKernelSize();
+    kernel->Table = this->Interpolator->GetWeightTable();
+    kernel->TableResolution = this->Interpolator->GetWeightTableResolution();
+    kernel->Data = inPtr;
+    kernel->DataIsDouble = (inData[0][0]->GetScalarType() == VTK_DOUBLE);
+    if (this->InterpolatorCoefficients)
+      {
+      kernel->Data = this->InterpolatorCoefficients->GetScalarPointer();
+      kernel->DataIsDouble = 1;
+      }
+    }
+
   if (this->Optimization)
     {
     // change transform matrix so that instead of taking 
@@ -3417,17 +4738,17 @@ void vtkImageReslice::ThreadedRequestData(
     if (vtkIsPermutationMatrix(newmat) && newtrans == NULL)
       {
       vtkReslicePermuteExecute(this, inData[0][0], inPtr, outData[0], outPtr,
-                               outExt, id, newmat);
+                               outExt, id, newmat, kernel);
       }
     else
       {
       vtkOptimizedExecute(this, inData[0][0], inPtr, outData[0], outPtr,
-                          outExt, id, newmat, newtrans);
+                          outExt, id, newmat, newtrans, kernel);
       }
     }
   else
     {
     vtkImageResliceExecute(this, inData[0][0], inPtr, outData[0], outPtr,
-                           outExt, id);
+                           outExt, id, kernel);
     }
 }
@@ -41,10 +41,13 @@
 // You can use both the ResliceAxes and the ResliceTransform at the
 // same time, in order to extract slices from a volume that you have
 // applied a transformation to.
+// <p>4) High-quality resampling with a windowed sinc or a cubic B-spline,
+// by giving a vtkImageSincInterpolator or a vtkImageBSplineInterpolator
+// to SetInterpolator().
 // .SECTION Caveats
 // This filter is very inefficient if the output X dimension is 1.
 // .SECTION see also
-// vtkAbstractTransform vtkMatrix4x4
+// vtkAbstractTransform vtkMatrix4x4 vtkAbstractImageInterpolator
 
 
 #ifndef __vtkImageReslice_h
@@ -60,6 +63,7 @@
 #define VTK_RESLICE_CUBIC 3
 
 class vtkImageData;
+class vtkAbstractImageInterpolator;
 class vtkAbstractTransform;
 class vtkMatrix4x4;
 class vtkImageStencilData;
@@ -206,6 +210,15 @@ public:
     this->SetInterpolationMode(VTK_RESLICE_CUBIC); };
   const char *GetInterpolationModeAsString();
 
+  // Description:
+  // Set an interpolator to use instead of the InterpolationMode, such as
+  // a vtkImageSincInterpolator or a vtkImageBSplineInterpolator (default:
+  // NULL, i.e. use the InterpolationMode). The coefficients that an
+  // interpolator applies to are kept between executions until the input,
+  // the interpolator or the wrap mode change.
+  virtual void SetInterpolator(vtkAbstractImageInterpolator *);
+  vtkGetObjectMacro(Interpolator, vtkAbstractImageInterpolator);
+
   // Description:
   // Turn on and off optimizations (default on, they should only be
   // turned off for testing purposes). 
@@ -262,8 +275,8 @@ public:
   vtkGetMacro(OutputDimensionality, int);
 
   // Description:
-  // When determining the modified time of the filter, 
-  // this check the modified time of the transform and matrix.
+  // When determining the modified time of the filter, this checks the
+  // modified time of the transform, the matrix and the interpolator.
   unsigned long int GetMTime();
 
   // Description:
@@ -309,6 +322,7 @@ protected:
   int Mirror;
   int Border;
   int InterpolationMode;
+  vtkAbstractImageInterpolator *Interpolator;
   int Optimization;
   double BackgroundColor[4];
   double OutputOrigin[3];
@@ -322,11 +336,20 @@ protected:
   vtkMatrix4x4 *IndexMatrix;
   vtkAbstractTransform *OptimizedTransform;
 
+  // the coefficients that the Interpolator applies to, and what they
+  // were computed from
+  vtkImageData *InterpolatorCoefficients;
+  unsigned long InterpolatorCoefficientsInputMTime;
+  unsigned long InterpolatorCoefficientsMTime;
+  int InterpolatorCoefficientsWrap;
+
   void GetAutoCroppedOutputBounds(vtkInformation *inInfo, double bounds[6]);
   virtual int RequestInformation(vtkInformation *, vtkInformationVector **,
                                  vtkInformationVector *);
   virtual int RequestUpdateExtent(vtkInformation *, vtkInformationVector **,
                                   vtkInformationVector *);
+  virtual int RequestData(vtkInformation *, vtkInformationVector **,
+                          vtkInformationVector *);
   virtual void ThreadedRequestData(vtkInformation *request,
                                    vtkInformationVector **inputVector,
                                    vtkInformationVector *outputVector,
@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageSincInterpolator.h"
+
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+
+#include <math.h>
+
+vtkCxxRevisionMacro(vtkImageSincInterpolator, "$Revision$");
+vtkStandardNewMacro(vtkImageSincInterpolator);
+
+//----------------------------------------------------------------------------
+vtkImageSincInterpolator::vtkImageSincInterpolator()
+{
+  this->WindowFunction = VTK_SINC_LANCZOS;
+  this->WindowHalfWidth = 3;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageSincInterpolator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "WindowFunction: "
+     << this->GetWindowFunctionAsString() << "\n";
+  os << indent << "WindowHalfWidth: " << this->WindowHalfWidth << "\n";
+}
+
+//----------------------------------------------------------------------------
+const char *vtkImageSincInterpolator::GetWindowFunctionAsString()
+{
+  switch (this->WindowFunction)
+    {
+    case VTK_SINC_LANCZOS:
+      return "Lanczos";
+    case VTK_SINC_HAMMING:
+      return "Hamming";
+    case VTK_SINC_BLACKMAN:
+      return "Blackman";
+    }
+  return "";
+}
+
+//----------------------------------------------------------------------------
+void vtkImageSincInterpolator::ComputeWeights(double f, double *weights)
+{
+  int m = this->WindowHalfWidth;
+  double pi = vtkMath::DoublePi();
+  double sum = 0.0;
+
+  for (int i = 0; i < 2*m; i++)
+    {
+    // distance from the point to the sample, in samples
+    double x = f + m - 1 - i;
+    double w = 0.0;
+    if (x == 0.0)
+      {
+      w = 1.0;
+      }
+    else if (fabs(x) < m)
+      {
+      double window;
+      double y = pi*x/m;
+      switch (this->WindowFunction)
+        {
+        case VTK_SINC_HAMMING:
+          window = 0.54 + 0.46*cos(y);
+          break;
+        case VTK_SINC_BLACKMAN:
+          window = 0.42 + 0.5*cos(y) + 0.08*cos(2*y);
+          break;
+        default:
+          window = sin(y)/y;
+          break;
+        }
+      w = window*sin(pi*x)/(pi*x);
+      }
+    weights[i] = w;
+    sum += w;
+    }
+
+  for (int j = 0; j < 2*m; j++)
+    {
+    weights[j] /= sum;
+    }
+}
@@ -0,0 +1,78 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImageSincInterpolator - windowed sinc interpolation for vtkImageReslice
+// .SECTION Description
+// vtkImageSincInterpolator interpolates with a sinc function truncated by
+// a window, the Lanczos window by default. The kernel spans WindowHalfWidth
+// samples on each side of the point. Wider kernels keep more of the high
+// frequencies and ring less, but cost more: the number of samples summed
+// for each output voxel grows with the cube of the width. The weights are
+// normalized to sum to one, so constant images stay constant.
+// .SECTION See Also
+// vtkImageReslice vtkAbstractImageInterpolator vtkImageBSplineInterpolator
+
+#ifndef __vtkImageSincInterpolator_h
+#define __vtkImageSincInterpolator_h
+
+#include "vtkAbstractImageInterpolator.h"
+
+#define VTK_SINC_LANCZOS  0
+#define VTK_SINC_HAMMING  1
+#define VTK_SINC_BLACKMAN 2
+
+class VTK_IMAGING_EXPORT vtkImageSincInterpolator :
+  public vtkAbstractImageInterpolator
+{
+public:
+  static vtkImageSincInterpolator *New();
+  vtkTypeRevisionMacro(vtkImageSincInterpolator,
+                       vtkAbstractImageInterpolator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the window that truncates the sinc function (default: Lanczos).
+  vtkSetClampMacro(WindowFunction, int, VTK_SINC_LANCZOS, VTK_SINC_BLACKMAN);
+  vtkGetMacro(WindowFunction, int);
+  void SetWindowFunctionToLanczos() {
+    this->SetWindowFunction(VTK_SINC_LANCZOS); };
+  void SetWindowFunctionToHamming() {
+    this->SetWindowFunction(VTK_SINC_HAMMING); };
+  void SetWindowFunctionToBlackman() {
+    this->SetWindowFunction(VTK_SINC_BLACKMAN); };
+  const char *GetWindowFunctionAsString();
+
+  // Description:
+  // Set the number of samples on each side of the point that the window
+  // spans, from 1 to 8 (default: 3).
+  vtkSetClampMacro(WindowHalfWidth, int, 1,
+                   VTK_INTERPOLATOR_MAX_KERNEL_SIZE/2);
+  vtkGetMacro(WindowHalfWidth, int);
+
+  virtual int GetKernelSize() { return 2*this->WindowHalfWidth; };
+  virtual void ComputeWeights(double f, double *weights);
+
+protected:
+  vtkImageSincInterpolator();
+  ~vtkImageSincInterpolator() {};
+
+  int WindowFunction;
+  int WindowHalfWidth;
+
+private:
+  vtkImageSincInterpolator(const vtkImageSincInterpolator&);  // Not implemented.
+  void operator=(const vtkImageSincInterpolator&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,232 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Render a table of glyphs as instances with vtkGlyphInstanceMapper and
+// as copies with vtkGlyph3D and vtkPolyDataMapper. The two images must
+// match, in one batch or many, and after the input points, the glyph
+// filter and a glyph source change. The bounds of the mapper must
+// contain the copied glyphs.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkConeSource.h"
+#include "vtkDoubleArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkGlyphInstanceMapper.h"
+#include "vtkImageDifference.h"
+#include "vtkMath.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSmartPointer.h"
+#include "vtkWindowToImageFilter.h"
+
+// Render both windows and return the thresholded error between them.
+static double CompareWindows(vtkRenderWindow *copies,
+                             vtkRenderWindow *instances)
+{
+  copies->Render();
+  instances->Render();
+  vtkSmartPointer<vtkWindowToImageFilter> copiesImage =
+    vtkSmartPointer<vtkWindowToImageFilter>::New();
+  copiesImage->SetInput(copies);
+  vtkSmartPointer<vtkWindowToImageFilter> instancesImage =
+    vtkSmartPointer<vtkWindowToImageFilter>::New();
+  instancesImage->SetInput(instances);
+  vtkSmartPointer<vtkImageDifference> diff =
+    vtkSmartPointer<vtkImageDifference>::New();
+  diff->SetInput(copiesImage->GetOutput());
+  diff->SetImage(instancesImage->GetOutput());
+  diff->Update();
+  return diff->GetThresholdedError();
+}
+
+// The bounds of the instances contain the copied glyphs, and exceed them
+// by less than the size of a glyph.
+static int CheckBounds(vtkGlyphInstanceMapper *mapper, vtkPolyData *glyphs)
+{
+  double *bounds = mapper->GetBounds(), glyphBounds[6];
+  glyphs->GetBounds(glyphBounds);
+  for (int j = 0; j < 3; j++)
+    {
+    if (bounds[2*j] > glyphBounds[2*j] + 1.0e-6 ||
+        bounds[2*j+1] < glyphBounds[2*j+1] - 1.0e-6 ||
+        bounds[2*j] < glyphBounds[2*j] - 1.0 ||
+        bounds[2*j+1] > glyphBounds[2*j+1] + 1.0)
+      {
+      cerr << "Wrong bounds along axis " << j << ": " << bounds[2*j] << " "
+           << bounds[2*j+1] << " for glyphs in " << glyphBounds[2*j] << " "
+           << glyphBounds[2*j+1] << "\n";
+      return 0;
+      }
+    }
+  return 1;
+}
+
+int TestGlyphInstanceMapper(int, char *[])
+{
+  const vtkIdType numPts = 300;
+  vtkMath::RandomSeed(4321);
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  vtkSmartPointer<vtkDoubleArray> scalars =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  vtkSmartPointer<vtkDoubleArray> vectors =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  vectors->SetNumberOfComponents(3);
+  vtkIdType i;
+  for (i = 0; i < numPts; i++)
+    {
+    points->InsertNextPoint(vtkMath::Random(-5.0, 5.0),
+                            vtkMath::Random(-5.0, 5.0),
+                            vtkMath::Random(-5.0, 5.0));
+    scalars->InsertNextValue(vtkMath::Random(0.0, 1.0));
+    vectors->InsertNextTuple3(vtkMath::Random(-1.0, 1.0),
+                              vtkMath::Random(-1.0, 1.0),
+                              vtkMath::Random(-1.0, 1.0));
+    }
+  vtkSmartPointer<vtkPolyData> input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+
+  // Two glyphs without normals, so that both paths shade the same way.
+  vtkSmartPointer<vtkConeSource> cone = vtkSmartPointer<vtkConeSource>::New();
+  cone->SetResolution(7);
+  vtkSmartPointer<vtkConeSource> pyramid =
+    vtkSmartPointer<vtkConeSource>::New();
+  pyramid->SetResolution(4);
+  pyramid->SetHeight(1.5);
+
+  vtkSmartPointer<vtkGlyph3D> glyphs[2];
+  vtkSmartPointer<vtkRenderWindow> windows[2];
+  vtkSmartPointer<vtkRenderer> renderers[2];
+  for (int k = 0; k < 2; k++)
+    {
+    glyphs[k] = vtkSmartPointer<vtkGlyph3D>::New();
+    glyphs[k]->SetInput(input);
+    glyphs[k]->SetSourceConnection(0, cone->GetOutputPort());
+    glyphs[k]->SetSourceConnection(1, pyramid->GetOutputPort());
+    glyphs[k]->SetIndexModeToScalar();
+    glyphs[k]->SetScaleModeToScaleByVector();
+    glyphs[k]->SetColorModeToColorByScalar();
+    glyphs[k]->SetScaleFactor(0.3);
+    glyphs[k]->SetRange(0.0, 1.0);
+    glyphs[k]->SetGenerateInstances(k);
+
+    renderers[k] = vtkSmartPointer<vtkRenderer>::New();
+    windows[k] = vtkSmartPointer<vtkRenderWindow>::New();
+    windows[k]->SetSize(300, 300);
+    windows[k]->AddRenderer(renderers[k]);
+    }
+
+  vtkSmartPointer<vtkPolyDataMapper> copyMapper =
+    vtkSmartPointer<vtkPolyDataMapper>::New();
+  copyMapper->SetInputConnection(glyphs[0]->GetOutputPort());
+  vtkSmartPointer<vtkGlyphInstanceMapper> instanceMapper =
+    vtkSmartPointer<vtkGlyphInstanceMapper>::New();
+  instanceMapper->SetInputConnection(glyphs[1]->GetOutputPort());
+  instanceMapper->SetSourceConnection(0, cone->GetOutputPort());
+  instanceMapper->SetSourceConnection(1, pyramid->GetOutputPort());
+
+  vtkSmartPointer<vtkActor> copyActor = vtkSmartPointer<vtkActor>::New();
+  copyActor->SetMapper(copyMapper);
+  renderers[0]->AddActor(copyActor);
+  vtkSmartPointer<vtkActor> instanceActor = vtkSmartPointer<vtkActor>::New();
+  instanceActor->SetMapper(instanceMapper);
+  renderers[1]->AddActor(instanceActor);
+
+  renderers[0]->ResetCamera();
+  renderers[0]->GetActiveCamera()->Azimuth(30.0);
+  renderers[0]->GetActiveCamera()->Elevation(20.0);
+  renderers[0]->GetActiveCamera()->Zoom(0.8);
+  renderers[1]->SetActiveCamera(renderers[0]->GetActiveCamera());
+
+  // All the instances in one batch, then many, kept between renders or
+  // not.
+  const double threshold = 10.0;
+  double error = CompareWindows(windows[0], windows[1]);
+  if (error > threshold ||
+      !CheckBounds(instanceMapper, glyphs[0]->GetOutput()))
+    {
+    cerr << "Single batch differs, error " << error << "\n";
+    return 1;
+    }
+  instanceMapper->SetBatchSize(37);
+  error = CompareWindows(windows[0], windows[1]);
+  if (error > threshold)
+    {
+    cerr << "Batches of 37 instances differ, error " << error << "\n";
+    return 1;
+    }
+  instanceMapper->KeepBatchesOff();
+  error = CompareWindows(windows[0], windows[1]);
+  if (error > threshold)
+    {
+    cerr << "Batches of 37 instances expanded at each render differ, error "
+         << error << "\n";
+    return 1;
+    }
+  instanceMapper->KeepBatchesOn();
+  instanceMapper->SetBatchSize(numPts);
+  error = CompareWindows(windows[0], windows[1]);
+  if (error > threshold)
+    {
+    cerr << "Kept batch differs, error " << error << "\n";
+    return 1;
+    }
+
+  // The kept batch and the bounds follow the changes of the instances.
+  for (int k = 0; k < 2; k++)
+    {
+    glyphs[k]->SetScaleFactor(0.6);
+    }
+  error = CompareWindows(windows[0], windows[1]);
+  if (error > threshold ||
+      !CheckBounds(instanceMapper, glyphs[0]->GetOutput()))
+    {
+    cerr << "Scaled instances differ, error " << error << "\n";
+    return 1;
+    }
+
+  for (i = 0; i < numPts; i++)
+    {
+    double x[3];
+    points->GetPoint(i, x);
+    points->SetPoint(i, x[0] + 1.0, x[1], -x[2]);
+    }
+  points->Modified();
+  error = CompareWindows(windows[0], windows[1]);
+  if (error > threshold ||
+      !CheckBounds(instanceMapper, glyphs[0]->GetOutput()))
+    {
+    cerr << "Moved instances differ, error " << error << "\n";
+    return 1;
+    }
+
+  // And the changes of a glyph.
+  pyramid->SetHeight(3.0);
+  pyramid->SetRadius(0.2);
+  error = CompareWindows(windows[0], windows[1]);
+  if (error > threshold ||
+      !CheckBounds(instanceMapper, glyphs[0]->GetOutput()))
+    {
+    cerr << "Changed glyph differs, error " << error << "\n";
+    return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,587 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkGlyphInstanceMapper.h"
+
+#include "vtkAlgorithmOutput.h"
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkExecutive.h"
+#include "vtkFloatArray.h"
+#include "vtkInformation.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkTransform.h"
+
+#include <vtkstd/vector>
+
+#include <math.h>
+
+vtkCxxRevisionMacro(vtkGlyphInstanceMapper, "$Revision$");
+vtkStandardNewMacro(vtkGlyphInstanceMapper);
+
+class vtkGlyphInstanceMapperInternals
+{
+public:
+  vtkstd::vector<vtkPolyDataMapper*> Mappers;
+
+  // Keep num mappers, each with its own batch.
+  void Resize(size_t num)
+    {
+    while (this->Mappers.size() > num)
+      {
+      this->Mappers.back()->Delete();
+      this->Mappers.pop_back();
+      }
+    while (this->Mappers.size() < num)
+      {
+      vtkPolyData *batch = vtkPolyData::New();
+      vtkPolyDataMapper *mapper = vtkPolyDataMapper::New();
+      mapper->SetInput(batch);
+      batch->Delete();
+      this->Mappers.push_back(mapper);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkGlyphInstanceMapper::vtkGlyphInstanceMapper()
+{
+  this->SetNumberOfInputPorts(2);
+  this->BatchSize = 10000;
+  this->KeepBatches = 1;
+  this->Internal = new vtkGlyphInstanceMapperInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkGlyphInstanceMapper::~vtkGlyphInstanceMapper()
+{
+  this->Internal->Resize(0);
+  delete this->Internal;
+}
+
+//----------------------------------------------------------------------------
+int vtkGlyphInstanceMapper::FillInputPortInformation(int port,
+                                                     vtkInformation *info)
+{
+  if (port == 0)
+    {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+    return 1;
+    }
+  else if (port == 1)
+    {
+    info->Set(vtkAlgorithm::INPUT_IS_REPEATABLE(), 1);
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+    return 1;
+    }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkGlyphInstanceMapper::SetInput(vtkPolyData *input)
+{
+  if(input)
+    {
+    this->SetInputConnection(0, input->GetProducerPort());
+    }
+  else
+    {
+    // Setting a NULL input removes the connection.
+    this->SetInputConnection(0, 0);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkPolyData *vtkGlyphInstanceMapper::GetInput()
+{
+  if (this->GetNumberOfInputConnections(0) < 1)
+    {
+    return 0;
+    }
+  return vtkPolyData::SafeDownCast(
+    this->GetExecutive()->GetInputData(0, 0));
+}
+
+//----------------------------------------------------------------------------
+// Specify a source object at a specified table location.
+void vtkGlyphInstanceMapper::SetSourceConnection(int id,
+                                                 vtkAlgorithmOutput* algOutput)
+{
+  if (id < 0)
+    {
+    vtkErrorMacro("Bad index " << id << " for source.");
+    return;
+    }
+
+  int numConnections = this->GetNumberOfInputConnections(1);
+  if (id < numConnections)
+    {
+    this->SetNthInputConnection(1, id, algOutput);
+    }
+  else if (id == numConnections && algOutput)
+    {
+    this->AddInputConnection(1, algOutput);
+    }
+  else if (algOutput)
+    {
+    vtkWarningMacro("The source id provided is larger than the maximum "
+                    "source id, using " << numConnections << " instead.");
+    this->AddInputConnection(1, algOutput);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Specify a source object at a specified table location.
+void vtkGlyphInstanceMapper::SetSource(int id, vtkPolyData *pd)
+{
+  if (!pd)
+    {
+    vtkErrorMacro("Cannot set NULL source.");
+    return;
+    }
+  this->SetSourceConnection(id, pd->GetProducerPort());
+}
+
+//----------------------------------------------------------------------------
+// Get a pointer to a source object at a specified table location.
+vtkPolyData *vtkGlyphInstanceMapper::GetSource(int id)
+{
+  if ( id < 0 || id >= this->GetNumberOfInputConnections(1) )
+    {
+    return NULL;
+    }
+
+  return vtkPolyData::SafeDownCast(
+    this->GetExecutive()->GetInputData(1, id));
+}
+
+//----------------------------------------------------------------------------
+// Return the glyph of an instance and its index in the table, or NULL if
+// there is none.
+static vtkPolyData *vtkGlyphInstanceMapperGetGlyph(vtkGlyphInstanceMapper *self,
+                                                   vtkDataArray *indices,
+                                                   vtkIdType instance,
+                                                   int &index)
+{
+  index = 0;
+  if (indices)
+    {
+    int numSources = self->GetNumberOfInputConnections(1);
+    index = static_cast<int>(indices->GetComponent(instance, 0));
+    index = (index < 0 ? 0 :
+             (index >= numSources ? (numSources-1) : index));
+    }
+  vtkPolyData *source = self->GetSource(index);
+  if (!source || source->GetNumberOfPoints() < 1)
+    {
+    return NULL;
+    }
+  return source;
+}
+
+//----------------------------------------------------------------------------
+void vtkGlyphInstanceMapper::ExpandInstances(vtkPolyData *input,
+                                             vtkIdType first, vtkIdType last,
+                                             vtkPolyData *batch)
+{
+  vtkPointData *inPD = input->GetPointData();
+  vtkDataArray *transforms = inPD->GetArray("GlyphTransform");
+  vtkDataArray *indices = inPD->GetArray("GlyphIndex");
+  vtkIdType i, j, numPts = 0, numCells = 0;
+  vtkPolyData *source;
+  int index;
+
+  // Normals and texture coordinates are drawn only if all the glyphs
+  // have them.
+  int haveNormals = 1, haveTCoords = 1, numTCoordComps = 0;
+  int numSources = this->GetNumberOfInputConnections(1);
+  for (i = 0; i < numSources; i++)
+    {
+    if ( (source = this->GetSource(static_cast<int>(i))) )
+      {
+      vtkDataArray *tcoords = source->GetPointData()->GetTCoords();
+      haveNormals &= (source->GetPointData()->GetNormals() != NULL);
+      if (!tcoords || (numTCoordComps &&
+                       tcoords->GetNumberOfComponents() != numTCoordComps))
+        {
+        haveTCoords = 0;
+        }
+      else
+        {
+        numTCoordComps = tcoords->GetNumberOfComponents();
+        }
+      }
+    }
+
+  for (i = first; i < last; i++)
+    {
+    if ( (source = vtkGlyphInstanceMapperGetGlyph(this, indices, i, index)) )
+      {
+      numPts += source->GetNumberOfPoints();
+      numCells += source->GetNumberOfCells();
+      }
+    }
+
+  batch->Initialize();
+  vtkPointData *outPD = batch->GetPointData();
+  outPD->CopyFieldOff("GlyphTransform");
+  outPD->CopyFieldOff("GlyphIndex");
+  outPD->CopyNormalsOff();
+  outPD->CopyTCoordsOff();
+  outPD->CopyAllocate(inPD, numPts);
+
+  vtkPoints *newPts = vtkPoints::New();
+  newPts->Allocate(numPts);
+  vtkFloatArray *newNormals = NULL;
+  if (haveNormals)
+    {
+    newNormals = vtkFloatArray::New();
+    newNormals->SetNumberOfComponents(3);
+    newNormals->Allocate(3*numPts);
+    newNormals->SetName("Normals");
+    }
+  vtkFloatArray *newTCoords = NULL;
+  if (haveTCoords)
+    {
+    newTCoords = vtkFloatArray::New();
+    newTCoords->SetNumberOfComponents(numTCoordComps);
+    newTCoords->Allocate(numTCoordComps*numPts);
+    newTCoords->SetName("TCoords");
+    }
+  vtkCellArray *newCells[4];
+  for (j = 0; j < 4; j++)
+    {
+    newCells[j] = vtkCellArray::New();
+    newCells[j]->Allocate(numCells);
+    }
+
+  vtkTransform *trans = vtkTransform::New();
+  double m[9], x[3], elements[16];
+  vtkIdType npts, *pts, offset = 0;
+  for (i = first; i < last; i++)
+    {
+    if ( !(source = vtkGlyphInstanceMapperGetGlyph(this, indices, i, index)) )
+      {
+      continue;
+      }
+
+    // The rotation and scale of the instance, then its translation.
+    transforms->GetTuple(i, m);
+    input->GetPoint(i, x);
+    for (j = 0; j < 3; j++)
+      {
+      elements[4*j] = m[3*j];
+      elements[4*j+1] = m[3*j+1];
+      elements[4*j+2] = m[3*j+2];
+      elements[4*j+3] = x[j];
+      }
+    elements[12] = elements[13] = elements[14] = 0.0;
+    elements[15] = 1.0;
+    trans->SetMatrix(elements);
+
+    vtkIdType numSourcePts = source->GetNumberOfPoints();
+    trans->TransformPoints(source->GetPoints(), newPts);
+    if (newNormals)
+      {
+      trans->TransformNormals(source->GetPointData()->GetNormals(),
+                              newNormals);
+      }
+    if (newTCoords)
+      {
+      vtkDataArray *tcoords = source->GetPointData()->GetTCoords();
+      for (j = 0; j < numSourcePts; j++)
+        {
+        newTCoords->InsertNextTuple(tcoords->GetTuple(j));
+        }
+      }
+    for (j = 0; j < numSourcePts; j++)
+      {
+      outPD->CopyData(inPD, i, offset+j);
+      }
+
+    vtkCellArray *sourceCells[4];
+    sourceCells[0] = source->GetVerts();
+    sourceCells[1] = source->GetLines();
+    sourceCells[2] = source->GetPolys();
+    sourceCells[3] = source->GetStrips();
+    for (int c = 0; c < 4; c++)
+      {
+      for (sourceCells[c]->InitTraversal();
+           sourceCells[c]->GetNextCell(npts, pts); )
+        {
+        newCells[c]->InsertNextCell(static_cast<int>(npts));
+        for (j = 0; j < npts; j++)
+          {
+          newCells[c]->InsertCellPoint(pts[j] + offset);
+          }
+        }
+      }
+    offset += numSourcePts;
+    }
+  trans->Delete();
+
+  batch->SetPoints(newPts);
+  newPts->Delete();
+  if (newNormals)
+    {
+    outPD->SetNormals(newNormals);
+    newNormals->Delete();
+    }
+  if (newTCoords)
+    {
+    outPD->SetTCoords(newTCoords);
+    newTCoords->Delete();
+    }
+  batch->SetVerts(newCells[0]);
+  batch->SetLines(newCells[1]);
+  batch->SetPolys(newCells[2]);
+  batch->SetStrips(newCells[3]);
+  for (j = 0; j < 4; j++)
+    {
+    newCells[j]->Delete();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkGlyphInstanceMapper::Render(vtkRenderer *ren, vtkActor *a)
+{
+  vtkPolyData *input = this->GetInput();
+  if (!input)
+    {
+    vtkErrorMacro("Mapper has no input.");
+    return;
+    }
+  if (!this->Static)
+    {
+    this->Update();
+    }
+  if (!input->GetPointData()->GetArray("GlyphTransform") ||
+      input->GetPointData()->GetArray("GlyphTransform")
+      ->GetNumberOfComponents() != 9)
+    {
+    vtkErrorMacro("The input has no GlyphTransform array.");
+    return;
+    }
+  if (this->GetNumberOfInputConnections(1) < 1)
+    {
+    vtkErrorMacro("No glyph to render.");
+    return;
+    }
+
+  // The batches are kept between renders unless they must be expanded
+  // one after the other in the same scratch polydata.
+  vtkIdType numInstances = input->GetNumberOfPoints();
+  unsigned long mTime = this->GetMTime();
+  if (input->GetMTime() > mTime)
+    {
+    mTime = input->GetMTime();
+    }
+  for (int i = 0; i < this->GetNumberOfInputConnections(1); i++)
+    {
+    vtkPolyData *source = this->GetSource(i);
+    if (source && source->GetMTime() > mTime)
+      {
+      mTime = source->GetMTime();
+      }
+    }
+  vtkIdType numBatches = (numInstances + this->BatchSize - 1) /
+    this->BatchSize;
+  int keep = (this->KeepBatches || numBatches <= 1);
+  this->Internal->Resize(keep ? static_cast<size_t>(numBatches) : 1);
+
+  for (size_t m = 0; m < this->Internal->Mappers.size(); m++)
+    {
+    vtkPolyDataMapper *mapper = this->Internal->Mappers[m];
+    if ( this->ClippingPlanes != mapper->GetClippingPlanes() )
+      {
+      mapper->SetClippingPlanes( this->ClippingPlanes );
+      }
+    mapper->SetLookupTable(this->GetLookupTable());
+    mapper->SetScalarVisibility(this->GetScalarVisibility());
+    mapper->SetUseLookupTableScalarRange(
+      this->GetUseLookupTableScalarRange());
+    mapper->SetScalarRange(this->GetScalarRange());
+    mapper->SetColorMode(this->GetColorMode());
+    mapper->SetInterpolateScalarsBeforeMapping(
+      this->GetInterpolateScalarsBeforeMapping());
+    mapper->SetScalarMode(this->GetScalarMode());
+    if ( this->ScalarMode == VTK_SCALAR_MODE_USE_POINT_FIELD_DATA ||
+         this->ScalarMode == VTK_SCALAR_MODE_USE_CELL_FIELD_DATA )
+      {
+      if ( this->ArrayAccessMode == VTK_GET_ARRAY_BY_ID )
+        {
+        mapper->ColorByArrayComponent(this->ArrayId,ArrayComponent);
+        }
+      else
+        {
+        mapper->ColorByArrayComponent(this->ArrayName,ArrayComponent);
+        }
+      }
+    // Display lists of a batch that changes every render are wasted.
+    mapper->SetImmediateModeRendering(
+      keep ? this->GetImmediateModeRendering() : 1);
+    }
+
+  this->TimeToDraw = 0;
+  if (keep && this->BatchBuildTime.GetMTime() > mTime)
+    {
+    for (size_t m = 0; m < this->Internal->Mappers.size(); m++)
+      {
+      this->Internal->Mappers[m]->Render(ren, a);
+      this->TimeToDraw += this->Internal->Mappers[m]->GetTimeToDraw();
+      }
+    return;
+    }
+
+  for (vtkIdType b = 0; b < numBatches; b++)
+    {
+    vtkPolyDataMapper *mapper = this->Internal->Mappers[keep ? b : 0];
+    vtkIdType first = b * this->BatchSize;
+    vtkIdType last = first + this->BatchSize;
+    this->ExpandInstances(input, first,
+                          (last < numInstances ? last : numInstances),
+                          mapper->GetInput());
+    mapper->Render(ren, a);
+    this->TimeToDraw += mapper->GetTimeToDraw();
+    }
+  if (keep)
+    {
+    this->BatchBuildTime.Modified();
+    }
+  else
+    {
+    // Do not hold on to the last batch.
+    this->Internal->Mappers[0]->GetInput()->Initialize();
+    this->BatchBuildTime = vtkTimeStamp();
+    }
+}
+
+//----------------------------------------------------------------------------
+// The bounds of each glyph are those of its source box once transformed,
+// that is the transformed center plus the extents of the box along the
+// transformed axes.
+void vtkGlyphInstanceMapper::ComputeBounds()
+{
+  vtkMath::UninitializeBounds(this->Bounds);
+  vtkPolyData *input = this->GetInput();
+  vtkDataArray *transforms =
+    input->GetPointData()->GetArray("GlyphTransform");
+  vtkDataArray *indices = input->GetPointData()->GetArray("GlyphIndex");
+  if (!transforms || transforms->GetNumberOfComponents() != 9)
+    {
+    return;
+    }
+
+  int numSources = this->GetNumberOfInputConnections(1);
+  vtkstd::vector<double> sourceBounds(6*numSources);
+  int i, j;
+  for (i = 0; i < numSources; i++)
+    {
+    vtkPolyData *source = this->GetSource(i);
+    if (source)
+      {
+      source->GetBounds(&sourceBounds[6*i]);
+      }
+    }
+
+  double m[9], x[3], center[3], halfSize[3], c, h;
+  int initialized = 0;
+  vtkIdType numInstances = input->GetNumberOfPoints();
+  for (vtkIdType inst = 0; inst < numInstances; inst++)
+    {
+    if (!vtkGlyphInstanceMapperGetGlyph(this, indices, inst, i))
+      {
+      continue;
+      }
+    double *b = &sourceBounds[6*i];
+    for (j = 0; j < 3; j++)
+      {
+      center[j] = 0.5*(b[2*j] + b[2*j+1]);
+      halfSize[j] = 0.5*(b[2*j+1] - b[2*j]);
+      }
+    transforms->GetTuple(inst, m);
+    input->GetPoint(inst, x);
+    for (j = 0; j < 3; j++)
+      {
+      c = x[j] + m[3*j]*center[0] + m[3*j+1]*center[1] + m[3*j+2]*center[2];
+      h = fabs(m[3*j])*halfSize[0] + fabs(m[3*j+1])*halfSize[1] +
+        fabs(m[3*j+2])*halfSize[2];
+      if (!initialized || c - h < this->Bounds[2*j])
+        {
+        this->Bounds[2*j] = c - h;
+        }
+      if (!initialized || c + h > this->Bounds[2*j+1])
+        {
+        this->Bounds[2*j+1] = c + h;
+        }
+      }
+    initialized = 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+double *vtkGlyphInstanceMapper::GetBounds()
+{
+  vtkPolyData *input = this->GetInput();
+  if (!input || this->GetNumberOfInputConnections(1) < 1)
+    {
+    vtkMath::UninitializeBounds(this->Bounds);
+    return this->Bounds;
+    }
+  if (!this->Static)
+    {
+    this->Update();
+    }
+
+  unsigned long mTime = input->GetMTime();
+  for (int i = 0; i < this->GetNumberOfInputConnections(1); i++)
+    {
+    vtkPolyData *source = this->GetSource(i);
+    if (source && source->GetMTime() > mTime)
+      {
+      mTime = source->GetMTime();
+      }
+    }
+  if (mTime > this->BoundsMTime.GetMTime())
+    {
+    this->ComputeBounds();
+    this->BoundsMTime.Modified();
+    }
+  return this->Bounds;
+}
+
+//----------------------------------------------------------------------------
+void vtkGlyphInstanceMapper::ReleaseGraphicsResources(vtkWindow *win)
+{
+  for (size_t m = 0; m < this->Internal->Mappers.size(); m++)
+    {
+    this->Internal->Mappers[m]->ReleaseGraphicsResources(win);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkGlyphInstanceMapper::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Batch Size: " << this->BatchSize << "\n";
+  os << indent << "Keep Batches: " << (this->KeepBatches ? "On\n" : "Off\n");
+  os << indent << "Number Of Sources: "
+     << this->GetNumberOfInputConnections(1) << "\n";
+}
@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    $RCSfile$
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkGlyphInstanceMapper - render glyph instances without copying the glyphs
+// .SECTION Description
+// vtkGlyphInstanceMapper renders the output of vtkGlyph3D with
+// GenerateInstances on: one point per glyph, with the 3x3 matrix that
+// orients and scales the glyph in the point data array "GlyphTransform"
+// and, when a table of glyphs is used, the index into the table in
+// "GlyphIndex". The glyphs are the polygonal data connected to the second
+// input port, with SetSource() or SetSourceConnection().
+//
+// The glyphs are transformed while rendering, BatchSize instances at a
+// time, into polydata drawn by internal vtkPolyDataMapper's. The point
+// data of an instance, and so its scalars, is copied to all the points of
+// its glyph. By default the batches are kept between renders and only
+// rebuilt when the instances, the glyphs or this mapper change, so that a
+// render only draws them (from display lists unless immediate mode
+// rendering is on). With KeepBatches off, every render expands the
+// batches one after the other into one scratch polydata: the memory used
+// is then bounded by the size of a batch, whatever the number of
+// instances, at the cost of transforming all the glyphs at each render.
+//
+// .SECTION See Also
+// vtkGlyph3D vtkPolyDataMapper
+
+#ifndef __vtkGlyphInstanceMapper_h
+#define __vtkGlyphInstanceMapper_h
+
+#include "vtkMapper.h"
+
+class vtkAlgorithmOutput;
+class vtkGlyphInstanceMapperInternals;
+class vtkPolyData;
+
+class VTK_RENDERING_EXPORT vtkGlyphInstanceMapper : public vtkMapper
+{
+public:
+  static vtkGlyphInstanceMapper *New();
+  vtkTypeRevisionMacro(vtkGlyphInstanceMapper, vtkMapper);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Specify the instances to render, typically the output of vtkGlyph3D
+  // with GenerateInstances on.
+  void SetInput(vtkPolyData *input);
+  vtkPolyData *GetInput();
+
+  // Description:
+  // Set the source to use for the glyph. Old style. See SetSourceConnection.
+  void SetSource(vtkPolyData *pd) {this->SetSource(0,pd);};
+
+  // Description:
+  // Specify a source object at a specified table location.
+  // Old style. See SetSourceConnection.
+  void SetSource(int id, vtkPolyData *pd);
+
+  // Description:
+  // Specify a source object at a specified table location. New style.
+  // Source connection is stored in port 1.
+  void SetSourceConnection(int id, vtkAlgorithmOutput* algOutput);
+  void SetSourceConnection(vtkAlgorithmOutput* algOutput)
+    {
+      this->SetSourceConnection(0, algOutput);
+    }
+
+  // Description:
+  // Get a pointer to a source object at a specified table location.
+  vtkPolyData *GetSource(int id=0);
+
+  // Description:
+  // Set/Get the number of instances transformed and drawn at once.
+  // Larger batches need more memory and fewer draw calls. The default
+  // is 10000.
+  vtkSetClampMacro(BatchSize,vtkIdType,1,VTK_LARGE_ID);
+  vtkGetMacro(BatchSize,vtkIdType);
+
+  // Description:
+  // Keep the expanded batches between renders (the default), or expand
+  // them at every render to bound the memory used by a batch. A single
+  // batch is always kept.
+  vtkSetMacro(KeepBatches,int);
+  vtkGetMacro(KeepBatches,int);
+  vtkBooleanMacro(KeepBatches,int);
+
+  // Description:
+  // Standard method for rendering a mapper. This method will be
+  // called by the actor.
+  void Render(vtkRenderer *ren, vtkActor *a);
+
+  // Description:
+  // Return the bounds of the transformed glyphs.
+  double *GetBounds();
+  void GetBounds(double bounds[6]) { this->Superclass::GetBounds( bounds ); };
+
+  // Description:
+  // Release the underlying resources associated with this mapper
+  void ReleaseGraphicsResources(vtkWindow *);
+
+protected:
+  vtkGlyphInstanceMapper();
+  ~vtkGlyphInstanceMapper();
+
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+
+  // Description:
+  // Copy the transformed glyphs of instances [first,last) into batch.
+  void ExpandInstances(vtkPolyData *input, vtkIdType first, vtkIdType last,
+                       vtkPolyData *batch);
+
+  // Description:
+  // Compute the bounds of all the transformed glyphs.
+  void ComputeBounds();
+
+  vtkIdType BatchSize;
+  int KeepBatches;
+
+  // Description:
+  // The mappers drawing the batches, whose inputs are the expanded glyphs.
+  vtkGlyphInstanceMapperInternals *Internal;
+
+  // Description:
+  // Time stamps for the bounds and for the batches kept between renders.
+  vtkTimeStamp BoundsMTime;
+  vtkTimeStamp BatchBuildTime;
+
+private:
+  vtkGlyphInstanceMapper(const vtkGlyphInstanceMapper&);  // Not implemented.
+  void operator=(const vtkGlyphInstanceMapper&);  // Not implemented.
+};
+
+#endif